@@ -231,12 +231,11 @@ void emitAllHHBC(AnalysisResultPtr&& ar) {
 
       auto commitLoop = [&] {
         folly::Optional<Timer> commitTime;
-        // kBatchSize needs to strike a balance between reducing
-        // transaction commit overhead (bigger batches are better), and
-        // limiting the cost incurred by failed commits due to identical
-        // units that require rollback and retry (smaller batches have
-        // less to lose).  Empirical results indicate that a value in
-        // the 2-10 range is reasonable.
+        // kBatchSize trades transaction commit overhead (bigger
+        // batches are better) against how much work is lost if a batch
+        // has to be rolled back and retried unit-by-unit.  Identical
+        // units dedup inside the batch rather than failing it, so
+        // retries are now rare and a moderate batch size suffices.
         static const unsigned kBatchSize = 8;
 
         while (auto ue = s_ueq.pop()) {
@@ -861,6 +861,34 @@ ClassAnalysis analyze_class(const Index& index, Context const ctx) {
     }
   }
 
+  /*
+   * If a private static is initialized by the 86sinit and the fixed point
+   * proved that a single constant is the only value the property ever
+   * holds, fold that constant into the property's initializer, so the
+   * runtime initializes it directly instead of invoking the 86sinit.  (LSB
+   * and LateInit statics are initialized by other paths, and HNI builtins
+   * may mutate private statics from native code, so those are left alone.)
+   */
+  if (!isHNIBuiltin && !is_closure(*ctx.cls) &&
+      find_method(ctx.cls, s_86sinit.get())) {
+    size_t idx = 0;
+    for (auto const& prop : ctx.cls->properties) {
+      if ((prop.attrs & (AttrPrivate | AttrStatic | AttrLSB | AttrLateInit)) ==
+            (AttrPrivate | AttrStatic) &&
+          prop.val.m_type == KindOfUninit) {
+        auto const it = clsAnalysis.privateStatics.find(prop.name);
+        if (it != end(clsAnalysis.privateStatics)) {
+          if (auto const val = tv(it->second)) {
+            if (val->m_type != KindOfUninit) {
+              clsAnalysis.resolvedProps.emplace_back(idx, *val);
+            }
+          }
+        }
+      }
+      ++idx;
+    }
+  }
+
   if (isHNIBuiltin) expand_hni_prop_types(clsAnalysis);
 
   Trace::Bump bumper{Trace::hhbbc, kSystemLibBump,
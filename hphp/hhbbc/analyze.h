@@ -175,6 +175,10 @@ struct ClassAnalysis {
   PropState privateStatics;
   bool anyInterceptable;
 
+  // For static properties initialized by the 86sinit, any whose value the
+  // analysis resolved to a constant, by slot in the class's property table.
+  CompactVector<std::pair<size_t,TypedValue>> resolvedProps;
+
   // Whether this class might have a bad initial value for a property.
   bool badPropInitialValues{false};
 };
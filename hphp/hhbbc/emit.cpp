@@ -24,6 +24,7 @@
 
 #include <folly/gen/Base.h>
 #include <folly/Conv.h>
+#include <folly/Format.h>
 #include <folly/Optional.h>
 #include <folly/Memory.h>
 
@@ -31,12 +32,17 @@
 #include "hphp/hhbbc/class-util.h"
 #include "hphp/hhbbc/func-util.h"
 #include "hphp/hhbbc/index.h"
+#include "hphp/hhbbc/options-util.h"
 #include "hphp/hhbbc/representation.h"
+#include "hphp/hhbbc/type-system.h"
 #include "hphp/hhbbc/unit-util.h"
 
+#include "hphp/zend/zend-string.h"
+
 #include "hphp/runtime/base/repo-auth-type-array.h"
 #include "hphp/runtime/base/repo-auth-type-codec.h"
 #include "hphp/runtime/base/repo-auth-type.h"
+#include "hphp/runtime/base/static-string-table.h"
 #include "hphp/runtime/base/tv-comparisons.h"
 
 #include "hphp/runtime/vm/bytecode.h"
@@ -56,6 +62,7 @@ namespace {
 const StaticString s_empty("");
 const StaticString s_invoke("__invoke");
 const StaticString s_86cinit("86cinit");
+const StaticString s_86sinit("86sinit");
 
 //////////////////////////////////////////////////////////////////////
 
@@ -1454,8 +1461,26 @@ void emit_class(EmitUnitState& state,
     }
   }
 
+  // If every non-LSB, non-LateInit static property initializer was resolved
+  // to a constant during analysis, the 86sinit has nothing left to do and
+  // need not be emitted.  Don't try this for classes whose traits are
+  // expanded at runtime; their trait properties aren't in cls.properties.
+  auto const needs86sinit = [&] {
+    if (!cls.usedTraitNames.empty() && !(cls.attrs & AttrNoExpandTrait)) {
+      return true;
+    }
+    for (auto& prop : cls.properties) {
+      if ((prop.attrs & (AttrStatic | AttrLSB | AttrLateInit)) == AttrStatic &&
+          prop.val.m_type == KindOfUninit) {
+        return true;
+      }
+    }
+    return false;
+  }();
+
   for (auto& m : cls.methods) {
     if (!needs86cinit && m->name == s_86cinit.get()) continue;
+    if (!needs86sinit && m->name == s_86sinit.get()) continue;
     FTRACE(2, "    method: {}\n", m->name->data());
     auto const fe = ue.newMethodEmitter(m->name, pce);
     emit_init_func(*fe, *m);
@@ -1533,6 +1558,74 @@ void emit_typealias(UnitEmitter& ue, const php::TypeAlias& alias) {
 
 //////////////////////////////////////////////////////////////////////
 
+/*
+ * Hash of everything other units may have assumed about this unit
+ * during whole-program analysis: the names, signatures, and attributes
+ * of its top-level entities, plus the fixpoint return types the Index
+ * handed out for its functions and methods.  A patched unit whose
+ * contract hash matches the deployed repo's could not have changed any
+ * fact another unit's optimized bytecode depends on, so it's a
+ * candidate for splicing into the repo without rerunning hhbbc.  A
+ * differing hash means a full build is required.
+ */
+std::string unit_contract_hash(const Index& index, const php::Unit& unit) {
+  std::string contract;
+
+  auto const tcName = [] (const TypeConstraint& tc) {
+    return tc.typeName() ? tc.typeName()->data() : "";
+  };
+
+  auto const addFunc = [&] (const php::Func& f) {
+    folly::format(&contract, "func {} attrs={:x} ret={} rty={}\n",
+                  f.name->data(), static_cast<uint32_t>(f.attrs),
+                  tcName(f.retTypeConstraint),
+                  show(index.lookup_return_type_raw(&f)));
+    for (auto const& p : f.params) {
+      folly::format(&contract, " param tc={} byref={} inout={} variadic={}\n",
+                    tcName(p.typeConstraint),
+                    p.byRef, p.inout, p.isVariadic);
+    }
+  };
+
+  for (auto const& f : unit.funcs) addFunc(*f);
+
+  for (auto const& c : unit.classes) {
+    folly::format(&contract, "class {} attrs={:x} parent={}\n",
+                  c->name->data(), static_cast<uint32_t>(c->attrs),
+                  c->parentName ? c->parentName->data() : "");
+    for (auto const iface : c->interfaceNames) {
+      folly::format(&contract, " implements {}\n", iface->data());
+    }
+    for (auto const& m : c->methods) addFunc(*m);
+    for (auto const& prop : c->properties) {
+      folly::format(&contract, " prop {} attrs={:x} tc={} val={}\n",
+                    prop.name->data(), static_cast<uint32_t>(prop.attrs),
+                    tcName(prop.typeConstraint),
+                    prop.val.m_type == KindOfUninit
+                      ? "uninit" : show(from_cell(prop.val)));
+    }
+    for (auto const& cns : c->constants) {
+      folly::format(&contract, " const {} val={}\n",
+                    cns.name->data(),
+                    cns.val && cns.val->m_type != KindOfUninit
+                      ? show(from_cell(*cns.val)) : "dynamic");
+    }
+  }
+
+  for (auto const& ta : unit.typeAliases) {
+    folly::format(&contract, "alias {} type={} nullable={}\n",
+                  ta->name->data(), ta->value->data(), ta->nullable);
+  }
+  for (auto const& ca : unit.classAliases) {
+    folly::format(&contract, "classalias {} {}\n",
+                  ca.first->data(), ca.second->data());
+  }
+
+  return string_md5(contract);
+}
+
+//////////////////////////////////////////////////////////////////////
+
 }
 
 std::unique_ptr<UnitEmitter> emit_unit(const Index& index,
@@ -1552,20 +1645,42 @@ std::unique_ptr<UnitEmitter> emit_unit(const Index& index,
   ue->m_useStrictTypesForBuiltins = unit.useStrictTypesForBuiltins;
   ue->m_metaData = unit.metaData;
 
+  // Record the unit's analysis contract so tooling can tell whether a
+  // patched version of this unit could be spliced into the repo without
+  // a whole-program rebuild.  See unit_contract_hash for what's covered.
+  ue->m_metaData[makeStaticString("__hhbbc.ContractHash")] =
+    make_tv<KindOfPersistentString>(
+      makeStaticString(unit_contract_hash(index, unit)));
+
   EmitUnitState state { index, &unit };
   state.classOffsets.resize(unit.classes.size(), kInvalidOffset);
 
   emit_pseudomain(state, *ue, unit);
 
-  std::vector<FuncEmitter*> top_fes;
   /*
    * Top level funcs are always defined when the unit is loaded, and
-   * don't have a DefFunc bytecode. Process them up front.
+   * don't have a DefFunc bytecode. Process them up front, with any
+   * functions a production profile flagged as hot first, so the hot
+   * bytecode in a unit packs together.  All top-level funcs are defined
+   * unconditionally at merge time, so their relative order isn't
+   * observable.
    */
-  for (size_t id = 0; id < unit.funcs.size(); ++id) {
-    auto const f = unit.funcs[id].get();
-    assertx(f != unit.pseudomain.get());
-    if (!f->top) continue;
+  std::vector<php::Func*> top_funcs;
+  for (auto const& f : unit.funcs) {
+    assertx(f.get() != unit.pseudomain.get());
+    if (f->top) top_funcs.push_back(f.get());
+  }
+  if (!options.ProfileHotFunctions.empty()) {
+    std::stable_partition(
+      begin(top_funcs), end(top_funcs),
+      [&] (const php::Func* f) {
+        return method_map_contains(options.ProfileHotFunctions, nullptr, f);
+      }
+    );
+  }
+
+  std::vector<FuncEmitter*> top_fes;
+  for (auto const f : top_funcs) {
     auto const fe = new FuncEmitter(*ue, -1, -1, f->name);
     top_fes.push_back(fe);
     emit_func(state, *ue, fe, *f);
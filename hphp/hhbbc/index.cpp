@@ -923,6 +923,23 @@ std::string show(const Func& f) {
 
 using IfaceSlotMap = hphp_hash_map<const php::Class*, Slot>;
 
+/*
+ * The whole-program view the analysis passes query.  Everything in here
+ * refers into the php::Program by raw pointer, and the derived tables
+ * (ClassInfo hierarchies, FuncFamilies, the return-type and public-static
+ * maps) are built up in-process and mutated under the refine_* calls.
+ *
+ * That representation is why the Index is a single-machine structure: it
+ * has no serialized form, and the facts it hands out are pointers into
+ * these tables rather than values.  Sharding analysis across machines
+ * would mean replacing those pointer identities with stable keys (name +
+ * unit hash), giving each fact a value encoding, and versioning the
+ * dependency maps so shards could exchange refinement deltas between
+ * rounds -- effectively a second, wire-format Index.  Until someone does
+ * that, peak memory here scales with the whole program, and the practical
+ * levers are the per-table CompactVectors and interning, not
+ * distribution.
+ */
 struct Index::IndexData {
   IndexData() = default;
   IndexData(const IndexData&) = delete;
@@ -5042,6 +5059,20 @@ void Index::refine_class_constants(
   find_deps(*m_data, ctx.func, Dep::ClsConst, deps);
 }
 
+void Index::refine_static_prop_initializers(
+  const php::Class* cls,
+  const CompactVector<std::pair<size_t, TypedValue>>& resolved) {
+  auto& props = const_cast<php::Class*>(cls)->properties;
+  for (auto const& p : resolved) {
+    assertx(p.first < props.size());
+    auto& prop = props[p.first];
+    assertx((prop.attrs & (AttrPrivate | AttrStatic)) ==
+            (AttrPrivate | AttrStatic));
+    assertx(prop.val.m_type == KindOfUninit);
+    prop.val = p.second;
+  }
+}
+
 void Index::refine_constants(const FuncAnalysisResult& fa,
                              DependencyContextSet& deps) {
   auto const func = fa.ctx.func;
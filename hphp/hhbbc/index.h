@@ -824,6 +824,15 @@ struct Index {
     const CompactVector<std::pair<size_t, TypedValue>>& resolved,
     DependencyContextSet& deps);
 
+  /*
+   * Fold initial values resolved from a class's 86sinit into its static
+   * property table.  This only makes an already-inferred fact visible in
+   * the emitted initializer, so it doesn't invalidate any dependencies.
+   */
+  void refine_static_prop_initializers(
+    const php::Class* cls,
+    const CompactVector<std::pair<size_t, TypedValue>>& resolved);
+
   /*
    * Refine the types of the constants defined by a function, based on
    * a round of analysis.
@@ -413,6 +413,15 @@ void in(ISS& env, const bc::FCallBuiltin& op) {
 
 bool can_emit_builtin(const php::Func* func,
                       int numArgs, bool hasUnpack) {
+  /*
+   * Builtins with inout parameters can't use FCallBuiltin: the opcode
+   * pushes exactly one cell, while inout signatures return their written-
+   * back arguments as extra stack values.  Methods can't either, since the
+   * opcode's only callee immediate is a NamedEntity func Id and the runtime
+   * has no context to pass.  Both would need a wider calling convention,
+   * not just laxer eligibility here; until then heavily-used builtins like
+   * preg_match pay for a full ActRec on every call.
+   */
   if (func->attrs & (AttrInterceptable | AttrNoFCallBuiltin |
                      AttrTakesInOutParams) ||
       func->cls ||
@@ -30,6 +30,7 @@
 #include "hphp/runtime/base/tv-comparisons.h"
 #include "hphp/runtime/base/tv-conversions.h"
 #include "hphp/runtime/base/type-structure.h"
+#include "hphp/runtime/base/type-structure-helpers.h"
 #include "hphp/runtime/base/type-structure-helpers-defs.h"
 #include "hphp/runtime/vm/runtime.h"
 #include "hphp/runtime/vm/unit-util.h"
@@ -2533,8 +2534,40 @@ void in(ISS& env, const bc::AsTypeStructC& op) {
 void in(ISS& env, const bc::CombineAndResolveTypeStruct& op) {
   // TODO(T31677864): implement real optimizations
   assertx(op.arg1 > 0);
-  auto valid = true;
   auto const requiredTSType = RuntimeOption::EvalHackArrDVArrs ? TDict : TDArr;
+
+  /*
+   * A single type structure that can't depend on the calling context
+   * resolves the same way at build time as it will on every request, so
+   * resolve it now and turn the instruction into a constant.  We bail on
+   * any exception rather than fold an error.  typeStructureCouldBeNonStatic
+   * is the same test the interpreter uses to decide whether it needs the
+   * frame's context for the resolution.
+   */
+  if (op.arg1 == 1) {
+    if (auto const ts = tv(topC(env))) {
+      if (isValidTSType(*ts, false) &&
+          !typeStructureCouldBeNonStatic(ArrNR{ts->m_data.parr}.asArray())) {
+        auto const resolved = eval_cell(
+          [&] {
+            bool persistent = true;
+            auto r = TypeStructure::resolve(
+              ArrNR{ts->m_data.parr}.asArray(),
+              nullptr, nullptr, req::vector<Array>{}, persistent
+            );
+            return make_array_like_tv(r.detach());
+          }
+        );
+        if (resolved && tv(*resolved)) {
+          constprop(env);
+          popC(env);
+          return push(env, *resolved);
+        }
+      }
+    }
+  }
+
+  auto valid = true;
   for (int i = 0; i < op.arg1; ++i) {
     auto const t = popC(env);
     valid &= t.subtypeOf(requiredTSType);
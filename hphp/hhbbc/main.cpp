@@ -23,6 +23,7 @@
 #include <cstdint>
 #include <algorithm>
 #include <exception>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -102,6 +103,7 @@ void parse_options(int argc, char** argv) {
   std::vector<std::string> interceptable_fns;
   std::vector<std::string> trace_fns;
   std::vector<std::string> trace_bcs;
+  std::vector<std::string> hot_fns;
   bool no_logging = false;
   bool no_cores = false;
 
@@ -141,6 +143,10 @@ void parse_options(int argc, char** argv) {
     ("trace-bytecode",
       po::value(&trace_bcs)->composing(),
       "Add a bytecode to trace (for debugging)")
+    ("hot-func",
+      po::value(&hot_fns)->composing(),
+      "Add a function (or Cls::meth) from a production profile; hot "
+      "functions are emitted ahead of the rest of their unit")
     ("hack-compiler-extract-path",
       po::value(&hack_compiler_extract_path)->default_value(""),
       "hack compiler extract path")
@@ -222,6 +228,7 @@ void parse_options(int argc, char** argv) {
 
   options.TraceFunctions = make_method_map(trace_fns);
   options.TraceBytecodes = make_bytecode_map(trace_bcs);
+  options.ProfileHotFunctions = make_method_map(hot_fns);
 
   logging = !no_logging;
 }
@@ -315,8 +322,39 @@ void write_units(UnitEmitterQueue& ueq) {
   open_repo(output_repo);
   SCOPE_EXIT { Repo::shutdown(); };
 
+  /*
+   * Pipeline the writes: a few encoder threads pull UnitEmitters off the
+   * queue and serialize their scalar arrays (the CPU-heavy part of a
+   * commit), while this thread stays the single sqlite writer, grouping
+   * units into batched transactions.  That overlaps encoding with the
+   * repo I/O instead of doing both serially here.
+   */
+  UnitEmitterQueue encoded;
+  std::vector<std::thread> encoders;
+  auto const numEncoders = std::max(size_t{1}, parallel::num_threads / 2);
+  for (auto i = size_t{0}; i < numEncoders; ++i) {
+    encoders.push_back(std::thread([&] {
+      hphp_thread_init();
+      hphp_session_init(Treadmill::SessionKind::HHBBC);
+      SCOPE_EXIT {
+        hphp_context_exit();
+        hphp_session_exit();
+        hphp_thread_exit();
+      };
+      while (auto ue = ueq.pop()) {
+        ue->preserializeArrays();
+        encoded.push(std::move(ue));
+      }
+    }));
+  }
+  std::thread closer([&] {
+    for (auto& t : encoders) t.join();
+    encoded.push(nullptr);
+  });
+  SCOPE_EXIT { closer.join(); };
+
   std::vector<std::unique_ptr<UnitEmitter>> ues;
-  while (auto ue = ueq.pop()) {
+  while (auto ue = encoded.pop()) {
     if (!timer) timer.emplace("writing output repo");
     ues.push_back(std::move(ue));
     if (ues.size() == 8) {
@@ -55,6 +55,14 @@ struct Options {
    */
   OpcodeSet TraceBytecodes;
 
+  /*
+   * Functions (or Cls::meth pairs) observed hot in production profiles.
+   * Never required for correctness: when provided, emit places these
+   * functions' bytecode ahead of their unit's other top-level functions
+   * so a unit's hot bytecode packs together.
+   */
+  MethodMap ProfileHotFunctions;
+
   //////////////////////////////////////////////////////////////////////
 
   /*
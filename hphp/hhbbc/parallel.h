@@ -26,6 +26,7 @@
 #include <atomic>
 #include <algorithm>
 #include <exception>
+#include <utility>
 
 #include <folly/ScopeGuard.h>
 
@@ -47,6 +48,29 @@ extern size_t work_chunk;
 
 //////////////////////////////////////////////////////////////////////
 
+namespace detail {
+
+/*
+ * Claim the next batch of work, sized by how much is left: full chunks
+ * while there's plenty, shrinking toward single items near the end so the
+ * last batches can't strand a straggler thread with a large chunk while
+ * the other cores sit idle.  Returns a [start, stop) range; the range is
+ * empty once the work is exhausted.
+ */
+inline std::pair<size_t,size_t> claim_batch(std::atomic<size_t>& index,
+                                            size_t total) {
+  auto const claimed = std::min(index.load(std::memory_order_relaxed), total);
+  auto const guided  = std::max((total - claimed) / (num_threads * 4),
+                                size_t{1});
+  auto const chunk   = std::min(work_chunk, guided);
+  auto const start   = index.fetch_add(chunk);
+  return { start, std::min(start + chunk, total) };
+}
+
+}
+
+//////////////////////////////////////////////////////////////////////
+
 /*
  * Call a function on each element of `inputs', in parallel.
  *
@@ -71,10 +95,9 @@ void for_each(const std::vector<Item>& inputs, Func func) {
         };
 
         for (;;) {
-          auto start = index.fetch_add(work_chunk);
-          auto const stop = std::min(start + work_chunk, inputs.size());
-          if (start >= stop) break;
-          for (auto i = start; i != stop; ++i) func(inputs[i]);
+          auto const batch = detail::claim_batch(index, inputs.size());
+          if (batch.first >= batch.second) break;
+          for (auto i = batch.first; i != batch.second; ++i) func(inputs[i]);
         }
       } catch (const std::exception& e) {
         std::fprintf(stderr,
@@ -122,13 +145,12 @@ auto map(Items&& inputs, Func func) -> std::vector<decltype(func(inputs[0]))> {
         };
 
         for (;;) {
-          auto start = index.fetch_add(work_chunk);
-          auto const stop = std::min(start + work_chunk, inputs.size());
-          if (start >= stop) break;
+          auto const batch = detail::claim_batch(index, inputs.size());
+          if (batch.first >= batch.second) break;
 
           std::transform(
-            begin(inputs) + start, begin(inputs) + stop,
-            retMem + start,
+            begin(inputs) + batch.first, begin(inputs) + batch.second,
+            retMem + batch.first,
             func
           );
         }
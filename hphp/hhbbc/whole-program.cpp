@@ -276,6 +276,18 @@ WorkItem work_item_for(DependencyContext d, AnalyzeMode mode) {
  * Repeat until the work list is empty.
  *
  */
+/*
+ * Note on incremental builds: the round-based scheduling below is already
+ * incremental *within* a build -- after round 0, only contexts whose
+ * dependencies (return types, constants, class facts) were refined get
+ * re-queued, via the DependencyContextSet each refine_* call fills in.
+ * Reusing results *across* builds would additionally require persisting
+ * the Index and every FuncAnalysis keyed by an input-identity hash, plus
+ * recording which index facts each analysis read, so that a changed unit
+ * invalidates exactly its transitive readers.  Nothing serializes the
+ * Index today (it's full of interned pointers into php::Program), so that
+ * is a separate project; don't assume dropping a unit in is cheap.
+ */
 void analyze_iteratively(Index& index, php::Program& program,
                          AnalyzeMode mode) {
   trace_time tracer(mode == AnalyzeMode::ConstPass ?
@@ -293,9 +305,30 @@ void analyze_iteratively(Index& index, php::Program& program,
     }
   };
 
+  /*
+   * Schedule the biggest work items first, so the long-tail giants start
+   * while the rest of the round's work can still backfill the other
+   * threads.  Block count is a crude but cheap proxy for interp cost.
+   * stable_sort keeps ties in program order, so the schedule (and any
+   * timing-independent output) stays deterministic.
+   */
+  auto const schedule = [] (std::vector<WorkItem>& work) {
+    auto const cost = [] (const WorkItem& wi) -> size_t {
+      if (wi.type == WorkType::Func) return wi.ctx.func->blocks.size();
+      auto ret = size_t{0};
+      for (auto const& m : wi.ctx.cls->methods) ret += m->blocks.size();
+      return ret;
+    };
+    std::stable_sort(
+      begin(work), end(work),
+      [&] (const WorkItem& a, const WorkItem& b) { return cost(a) > cost(b); }
+    );
+  };
+
   auto work = initial_work(program, mode);
   while (!work.empty()) {
-    auto const results = [&] {
+    schedule(work);
+    auto results = [&] {
       trace_time trace(
         "analyzing",
         folly::format("round {} -- {} work items", round, work.size()).str()
@@ -365,6 +398,10 @@ void analyze_iteratively(Index& index, php::Program& program,
                                    ca.privateProperties);
         index.refine_private_statics(ca.ctx.cls,
                                      ca.privateStatics);
+        if (ca.resolvedProps.size()) {
+          index.refine_static_prop_initializers(ca.ctx.cls,
+                                                ca.resolvedProps);
+        }
         index.refine_bad_initial_prop_values(ca.ctx.cls,
                                              ca.badPropInitialValues,
                                              deps);
@@ -382,6 +419,10 @@ void analyze_iteratively(Index& index, php::Program& program,
         update_class(result->cls);
         break;
       }
+      // Release each result as soon as it has been applied; the analysis
+      // states for a whole round add up, and holding them all while the
+      // index tables grow during the update sets the peak for the round.
+      result = folly::none;
     }
 
     index.update_class_aliases();
@@ -0,0 +1,110 @@
+/*
+   +----------------------------------------------------------------------+
+   | HipHop for PHP                                                       |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 2010-present Facebook, Inc. (http://www.facebook.com)  |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 3.01 of the PHP license,      |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.php.net/license/3_01.txt                                  |
+   | If you did not receive a copy of the PHP license and are unable to   |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@php.net so we can mail you a copy immediately.               |
+   +----------------------------------------------------------------------+
+*/
+
+#include "hphp/runtime/base/alloc-site-profiler.h"
+
+#include "hphp/util/hash.h"
+#include "hphp/util/hash-map.h"
+#include "hphp/util/stack-trace.h"
+
+#include <folly/Format.h>
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+namespace HPHP { namespace AllocSiteProfiler {
+///////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+// Frames to capture per sample, after dropping the profiler and
+// memory-manager internals at the top of the stack.
+constexpr int kMaxFrames = 16;
+constexpr int kSkipFrames = 3;
+
+struct Site {
+  uint64_t samples{0};
+  uint64_t bytes{0};
+  int numFrames{0};
+  void* frames[kMaxFrames];
+};
+
+// Process-wide aggregate.  Sampling keeps the arrival rate low enough
+// that a single mutex is not a bottleneck.
+std::mutex s_lock;
+hphp_hash_map<uint64_t, Site> s_sites;
+
+uint64_t hashFrames(void* const* frames, int n) {
+  uint64_t h = 0;
+  for (int i = 0; i < n; ++i) {
+    h = hash_int64_pair(h, reinterpret_cast<int64_t>(frames[i]));
+  }
+  return h;
+}
+
+}
+
+void logSample(size_t bytes) {
+  void* frames[kSkipFrames + kMaxFrames];
+  auto const captured =
+    StackTraceBase::CaptureFramePointers(frames, kSkipFrames + kMaxFrames);
+  if (captured <= kSkipFrames) return;
+  auto const begin = frames + kSkipFrames;
+  auto const n = captured - kSkipFrames;
+  auto const key = hashFrames(begin, n);
+
+  std::lock_guard<std::mutex> guard(s_lock);
+  auto& site = s_sites[key];
+  if (!site.samples) {
+    site.numFrames = n;
+    std::copy(begin, begin + n, site.frames);
+  }
+  ++site.samples;
+  site.bytes += bytes;
+}
+
+std::string report(int top) {
+  std::vector<Site> sites;
+  {
+    std::lock_guard<std::mutex> guard(s_lock);
+    sites.reserve(s_sites.size());
+    for (auto const& kv : s_sites) sites.push_back(kv.second);
+  }
+  std::sort(sites.begin(), sites.end(),
+            [] (const Site& a, const Site& b) { return a.bytes > b.bytes; });
+  if (top > 0 && sites.size() > size_t(top)) sites.resize(top);
+
+  std::string out;
+  folly::format(&out, "{} allocation sites\n\n", sites.size());
+  for (auto const& site : sites) {
+    folly::format(&out, "samples {} bytes {}\n", site.samples, site.bytes);
+    for (int i = 0; i < site.numFrames; ++i) {
+      auto const frame = StackTrace::Translate(site.frames[i]);
+      folly::format(&out, "  #{} {}\n", i, frame->toString());
+    }
+    out += "\n";
+  }
+  return out;
+}
+
+void reset() {
+  std::lock_guard<std::mutex> guard(s_lock);
+  s_sites.clear();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+}}
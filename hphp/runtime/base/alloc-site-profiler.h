@@ -0,0 +1,63 @@
+/*
+   +----------------------------------------------------------------------+
+   | HipHop for PHP                                                       |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 2010-present Facebook, Inc. (http://www.facebook.com)  |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 3.01 of the PHP license,      |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.php.net/license/3_01.txt                                  |
+   | If you did not receive a copy of the PHP license and are unable to   |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@php.net so we can mail you a copy immediately.               |
+   +----------------------------------------------------------------------+
+*/
+
+#ifndef incl_HPHP_ALLOC_SITE_PROFILER_H_
+#define incl_HPHP_ALLOC_SITE_PROFILER_H_
+
+#include <cstddef>
+#include <string>
+
+namespace HPHP { namespace AllocSiteProfiler {
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+ * Sampled allocation-site profiler.  Complements objprof: objprof
+ * surveys what is alive, this records who allocated.
+ *
+ * When Eval.ProfileAllocSampleBytes = N is set, the memory manager's
+ * allocation-debt mechanism interrupts the small-alloc fast path after
+ * every N bytes of request allocation (the same trick the GC trigger
+ * uses, so the fast path itself is untouched), and the slow path calls
+ * logSample().  Each sample captures a frame-pointer backtrace and
+ * aggregates it by call site; a sample stands in for roughly N bytes,
+ * so attributed bytes are comparable between sites without being exact.
+ *
+ * The aggregate is queryable over the admin server as /prof-alloc and
+ * resettable as /prof-alloc-reset.
+ */
+
+/*
+ * Record one sample at the current native call stack, representing
+ * `bytes' of attributed allocation.  Called from the allocation slow
+ * path; must stay cheap and allocation-free above the sample map.
+ */
+void logSample(size_t bytes);
+
+/*
+ * Render the `top' heaviest sites by attributed bytes, with translated
+ * frames, for the admin server.
+ */
+std::string report(int top);
+
+/*
+ * Drop all accumulated samples.
+ */
+void reset();
+
+///////////////////////////////////////////////////////////////////////////////
+}}
+
+#endif
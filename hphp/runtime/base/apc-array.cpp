@@ -15,7 +15,12 @@
 */
 #include "hphp/runtime/base/apc-array.h"
 
+#include <utility>
+
 #include <folly/Bits.h>
+#include <folly/Hash.h>
+#include <folly/ScopeGuard.h>
+#include <tbb/concurrent_unordered_set.h>
 
 #include "hphp/runtime/base/apc-handle.h"
 #include "hphp/runtime/base/data-walker.h"
@@ -26,6 +31,7 @@
 #include "hphp/runtime/base/apc-local-array.h"
 #include "hphp/runtime/base/apc-local-array-defs.h"
 #include "hphp/runtime/base/array-iterator.h"
+#include "hphp/runtime/base/tv-variant.h"
 #include "hphp/runtime/ext/apc/ext_apc.h"
 
 namespace HPHP {
@@ -41,6 +47,152 @@ size_t getMemSize(DataWalker::PointerMap* seenArrs) {
   return total;
 }
 
+//////////////////////////////////////////////////////////////////////
+
+/*
+ * Content-hash dedup cache for flat, scalar-only uncounted PHP arrays,
+ * enabled by Server.APC.DedupUncounted.  Storing identical "config-shaped"
+ * arrays under many distinct APC keys otherwise materializes one uncounted
+ * copy per key; with the cache they all collapse onto the first copy via
+ * uncountedIncRef().  Arrays holding non-scalar values don't participate:
+ * their inner arrays are already shared within a single store by the
+ * DataWalker seen map, and keeping the cache flat keeps probes cheap.
+ * Each cached array holds one reference owned by the cache and is never
+ * evicted, like the static array table behind ArrayData::GetScalarArray.
+ */
+
+__thread std::pair<const ArrayData*, size_t> s_cachedDedupHash;
+
+struct UncountedDedupHash {
+  size_t operator()(const ArrayData* ad) const { return hash(ad); }
+  size_t operator()(const ArrayData* ad1, const ArrayData* ad2) const {
+    return equal(ad1, ad2);
+  }
+  size_t hash(const ArrayData* ad) const {
+    if (ad == s_cachedDedupHash.first) return s_cachedDedupHash.second;
+    size_t h;
+    DEBUG_ONLY auto const flat = raw_hash(ad, &h);
+    assertx(flat);
+    return h;
+  }
+  /*
+   * Hash dvarray-ness, keys, and scalar values.  Returns false, leaving
+   * *out unusable, if the array holds a non-scalar value; such arrays
+   * must not enter the cache.
+   */
+  static bool raw_hash(const ArrayData* ad, size_t* out) {
+    auto ret = uint64_t{ad->dvArray()};
+    auto flat = true;
+    IterateKV(
+      ad,
+      [&](Cell k, TypedValue v) {
+        ret = isStringType(k.m_type)
+          ? folly::hash::hash_combine(ret, true, k.m_data.pstr->hash())
+          : folly::hash::hash_combine(ret, false, k.m_data.num);
+        auto const c = tvToCell(&v);
+        switch (c->m_type) {
+          case KindOfUninit:
+          case KindOfNull:
+            ret = folly::hash::hash_combine(ret, int(c->m_type));
+            return false;
+          case KindOfBoolean:
+          case KindOfInt64:
+          case KindOfDouble:
+            ret = folly::hash::hash_combine(ret, int(c->m_type),
+                                            c->m_data.num);
+            return false;
+          case KindOfPersistentString:
+          case KindOfString:
+            // The two string types compare equal, so hash them alike.
+            ret = folly::hash::hash_combine(ret, int(KindOfString),
+                                            c->m_data.pstr->hash());
+            return false;
+          default:
+            flat = false;
+            return true;
+        }
+      }
+    );
+    *out = ret;
+    return flat;
+  }
+  bool equal(const ArrayData* ad1, const ArrayData* ad2) const {
+    if (ad1 == ad2) return true;
+    if (ad1->size() != ad2->size()) return false;
+    if (!ArrayData::dvArrayEqual(ad1, ad2)) return false;
+
+    auto const check = [] (const TypedValue& tv1, const TypedValue& tv2) {
+      auto const c1 = tvToCell(&tv1);
+      auto const c2 = tvToCell(&tv2);
+      if (isStringType(c1->m_type)) {
+        return isStringType(c2->m_type) &&
+               c1->m_data.pstr->same(c2->m_data.pstr);
+      }
+      if (c1->m_type != c2->m_type) return false;
+      switch (c1->m_type) {
+        case KindOfUninit:
+        case KindOfNull:
+          return true;
+        case KindOfBoolean:
+        case KindOfInt64:
+        case KindOfDouble:
+          return c1->m_data.num == c2->m_data.num;
+        default:
+          // Non-scalars never match; flat arrays can't carry them anyway.
+          return false;
+      }
+    };
+
+    bool equal = true;
+    ArrayIter iter2{ad2};
+    IterateKV(
+      ad1,
+      [&](Cell k, TypedValue v) {
+        if (!check(k, *iter2.first().asTypedValue()) ||
+            !check(v, iter2.secondVal())) {
+          equal = false;
+          return true;
+        }
+        ++iter2;
+        return false;
+      }
+    );
+    return equal;
+  }
+};
+
+using UncountedDedupMap = tbb::concurrent_unordered_set<ArrayData*,
+                                                        UncountedDedupHash,
+                                                        UncountedDedupHash>;
+UncountedDedupMap s_uncountedDedupMap;
+
+/*
+ * Return a cached uncounted array with the same contents as the (counted)
+ * array, with a reference transferred to the caller, or nullptr if the
+ * array isn't dedupable or has no cached twin.
+ */
+ArrayData* dedupUncountedLookup(const ArrayData* array) {
+  size_t h;
+  if (!UncountedDedupHash::raw_hash(array, &h)) return nullptr;
+  s_cachedDedupHash = {array, h};
+  SCOPE_EXIT { s_cachedDedupHash.first = nullptr; };
+  auto const it = s_uncountedDedupMap.find(const_cast<ArrayData*>(array));
+  if (it == s_uncountedDedupMap.end()) return nullptr;
+  return (*it)->uncountedIncRef() ? *it : nullptr;
+}
+
+void dedupUncountedInsert(ArrayData* data) {
+  size_t h;
+  if (!UncountedDedupHash::raw_hash(data, &h)) return;
+  if (!data->uncountedIncRef()) return;
+  s_cachedDedupHash = {data, h};
+  SCOPE_EXIT { s_cachedDedupHash.first = nullptr; };
+  if (!s_uncountedDedupMap.insert(data).second) {
+    // Lost a race with an identical array; drop the cache's reference.
+    data->uncountedDecRef();
+  }
+}
+
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -227,17 +379,25 @@ APCHandle* APCArray::MakeUncountedArray(
     DataWalker::PointerMap* m) {
   assertx(apcExtension::UseUncounted);
   assertx(array->isPHPArray());
-  auto const value = [&] {
-    if (array->isPacked()) {
-      auto const data = PackedArray::MakeUncounted(array, true, m);
+  if (apcExtension::DedupUncounted) {
+    if (auto const data = dedupUncountedLookup(array)) {
+      assertx(data->hasApcTv());
       auto const mem = reinterpret_cast<APCTypedValue*>(data) - 1;
-      return new(mem) APCTypedValue(APCTypedValue::UncountedArr{}, data);
+      auto const value =
+        new(mem) APCTypedValue(APCTypedValue::UncountedArr{}, data);
+      return value->getHandle();
+    }
+  }
+  auto const data = [&] {
+    if (array->isPacked()) {
+      return PackedArray::MakeUncounted(array, true, m);
     }
     assertx(array->isMixed());
-    auto const data = MixedArray::MakeUncounted(array, true, m);
-    auto const mem = reinterpret_cast<APCTypedValue*>(data) - 1;
-    return new(mem) APCTypedValue(APCTypedValue::UncountedArr{}, data);
+    return MixedArray::MakeUncounted(array, true, m);
   }();
+  if (apcExtension::DedupUncounted) dedupUncountedInsert(data);
+  auto const mem = reinterpret_cast<APCTypedValue*>(data) - 1;
+  auto const value = new(mem) APCTypedValue(APCTypedValue::UncountedArr{}, data);
   return value->getHandle();
 }
 
@@ -24,6 +24,7 @@
 #include "hphp/runtime/base/apc-stats.h"
 #include "hphp/runtime/base/builtin-functions.h"
 #include "hphp/runtime/base/runtime-option.h"
+#include "hphp/runtime/base/string-data.h"
 #include "hphp/runtime/ext/apc/ext_apc.h"
 #include "hphp/runtime/server/server-stats.h"
 
@@ -52,8 +53,12 @@ void APCFileStorage::enable(const std::string& prefix, size_t chunkSize) {
   m_state = StorageState::Open;
 }
 
-char* APCFileStorage::put(const char* data, uint32_t len) {
-  const uint32_t totalLen = len + PaddingSize;
+// Reserve space for an entry with a payload of `len' bytes (including the
+// hash/len header and trailing '\0'), and return a pointer to the entry
+// header.  Entries are kept 8-byte aligned so payloads can hold in-place
+// objects; the zero-filled pad bytes are skipped by hashCheck().
+char* APCFileStorage::reserve(uint32_t len) {
+  const uint32_t totalLen = (len + PaddingSize + 7) & ~7u;
   if (m_state != StorageState::Open || totalLen > m_chunkSize) {
     return nullptr;
   }
@@ -90,7 +95,12 @@ char* APCFileStorage::put(const char* data, uint32_t len) {
   } while(true);
 
   auto const chunkIndex = current >> 32;
-  char* base = m_chunks[chunkIndex] + static_cast<uint32_t>(current);
+  return m_chunks[chunkIndex] + static_cast<uint32_t>(current);
+}
+
+char* APCFileStorage::put(const char* data, uint32_t len) {
+  char* base = reserve(len);
+  if (base == nullptr) return nullptr;
   uint64_t h = hash_string_cs_unsafe(data, len);
   *(uint64_t*)base = h | (static_cast<uint64_t>(len) << 32);
   base += sizeof(uint64_t);
@@ -99,6 +109,23 @@ char* APCFileStorage::put(const char* data, uint32_t len) {
   return static_cast<char*>(memcpy(base, data, len));
 }
 
+StringData* APCFileStorage::putString(folly::StringPiece str) {
+  static_assert(alignof(StringData) <= alignof(uint64_t),
+                "entry payloads are only 8-byte aligned");
+  if (str.size() > StringData::MaxSize) return nullptr;
+  auto const len = static_cast<uint32_t>(str.size() + kStringOverhead);
+  char* base = reserve(len);
+  if (base == nullptr) return nullptr;
+  auto const payload = base + sizeof(uint64_t);
+  auto const sd = StringData::MakeStaticAt(str, payload);
+  // Hash the payload only after the StringData is fully formed, so that
+  // hashCheck() sees a stable image of the entry.
+  uint64_t h = hash_string_cs_unsafe(payload, len);
+  *(uint64_t*)base = h | (static_cast<uint64_t>(len) << 32);
+  assertx(payload[len] == '\0');         // Should already be 0 after mmap.
+  return sd;
+}
+
 void APCFileStorage::seal() {
   std::lock_guard<std::mutex> lock(m_lock);
   if (m_state == StorageState::Sealed || m_chunks.empty()) {
@@ -174,6 +201,9 @@ bool APCFileStorage::hashCheck() {
         return false;
       }
       current++;
+      // Entries are 8-byte aligned; skip the zero-filled pad bytes.
+      current = reinterpret_cast<char*>(
+        (reinterpret_cast<uintptr_t>(current) + 7) & ~uintptr_t{7});
     }
   }
   return true;
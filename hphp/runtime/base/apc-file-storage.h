@@ -22,12 +22,16 @@
 #include <mutex>
 #include <vector>
 
+#include <folly/Range.h>
+
 #include "hphp/util/hash.h"
 
 namespace HPHP {
 
 //////////////////////////////////////////////////////////////////////
 
+struct StringData;
+
 /*
  * To save memory, hhvm puts portions of primed APC data in a file-backed mmap
  * that we can madvise away after an initial warmup period.
@@ -46,6 +50,13 @@ struct APCFileStorage {
 
   void enable(const std::string& prefix, size_t chunkSize);
   char *put(const char *data, uint32_t len);
+  /*
+   * Construct a fully-formed static StringData holding `str' directly inside
+   * the mapping, so fetches can bind it with no copy.  Must be called before
+   * seal() makes the chunks read-only.  Returns nullptr if the storage isn't
+   * open (the caller should fall back to putting serialized data).
+   */
+  StringData* putString(folly::StringPiece str);
   void seal();
   void adviseOut();
   bool hashCheck();
@@ -54,6 +65,7 @@ struct APCFileStorage {
 
 private:
   bool addFile();
+  char* reserve(uint32_t len);
 
 private:
   // [32-bit chunk index]:[32-bit offset]
@@ -167,32 +167,32 @@ Variant APCHandle::toLocalHelper() const {
         StringData::MakeProxy(APCString::fromHandle(this))
       );
     case APCKind::SerializedArray: {
-      auto const serArr = APCString::fromHandle(this)->getStringData();
-      auto const v = apc_unserialize(serArr->data(), serArr->size());
+      auto const serArr = APCString::fromHandle(this)->toLocalString();
+      auto const v = apc_unserialize(serArr.data(), serArr.size());
       assertx(v.isPHPArray());
       return v;
     }
     case APCKind::SerializedVec: {
-      auto const serVec = APCString::fromHandle(this)->getStringData();
-      auto const v = apc_unserialize(serVec->data(), serVec->size());
+      auto const serVec = APCString::fromHandle(this)->toLocalString();
+      auto const v = apc_unserialize(serVec.data(), serVec.size());
       assertx(v.isVecArray());
       return v;
     }
     case APCKind::SerializedDict: {
-      auto const serDict = APCString::fromHandle(this)->getStringData();
-      auto const v = apc_unserialize(serDict->data(), serDict->size());
+      auto const serDict = APCString::fromHandle(this)->toLocalString();
+      auto const v = apc_unserialize(serDict.data(), serDict.size());
       assertx(v.isDict());
       return v;
     }
     case APCKind::SerializedShape: {
-      auto const serShape = APCString::fromHandle(this)->getStringData();
-      auto const v = apc_unserialize(serShape->data(), serShape->size());
+      auto const serShape = APCString::fromHandle(this)->toLocalString();
+      auto const v = apc_unserialize(serShape.data(), serShape.size());
       assertx(v.isShape());
       return v;
     }
     case APCKind::SerializedKeyset: {
-      auto const serKeyset = APCString::fromHandle(this)->getStringData();
-      auto const v = apc_unserialize(serKeyset->data(), serKeyset->size());
+      auto const serKeyset = APCString::fromHandle(this)->toLocalString();
+      auto const v = apc_unserialize(serKeyset.data(), serKeyset.size());
       assertx(v.isKeyset());
       return v;
     }
@@ -228,8 +228,8 @@ Variant APCHandle::toLocalHelper() const {
         APCArray::fromHandle(this)->toLocalKeyset()
       );
     case APCKind::SerializedObject: {
-      auto const serObj = APCString::fromHandle(this)->getStringData();
-      return apc_unserialize(serObj->data(), serObj->size());
+      auto const serObj = APCString::fromHandle(this)->toLocalString();
+      return apc_unserialize(serObj.data(), serObj.size());
     }
     case APCKind::SharedCollection:
       return APCCollection::fromHandle(this)->createObject();
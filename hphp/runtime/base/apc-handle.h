@@ -235,13 +235,33 @@ struct APCHandle {
     assertx(m_kind == APCKind::SerializedObject ||
            m_kind == APCKind::SharedObject ||
            m_kind == APCKind::SharedCollection);
-    return m_obj_attempted.load(std::memory_order_relaxed);
+    return m_flags.load(std::memory_order_relaxed) & kObjAttempted;
   }
   void setObjAttempted() {
     assertx(m_kind == APCKind::SerializedObject ||
            m_kind == APCKind::SharedObject ||
            m_kind == APCKind::SharedCollection);
-    m_obj_attempted.store(true, std::memory_order_relaxed);
+    m_flags.fetch_or(kObjAttempted, std::memory_order_relaxed);
+  }
+
+  /*
+   * If true, this APCHandle is an APCString whose payload is stored
+   * zstd-compressed and has to be decompressed on fetch; see
+   * APCString::toLocalString(). Only the Serialized* kinds are ever
+   * compressed. The flag is set before the handle is published and never
+   * changes afterwards.
+   */
+  bool isCompressed() const {
+    return m_flags.load(std::memory_order_relaxed) & kCompressed;
+  }
+  void setCompressed() {
+    assertx(m_kind == APCKind::SerializedArray ||
+           m_kind == APCKind::SerializedVec ||
+           m_kind == APCKind::SerializedDict ||
+           m_kind == APCKind::SerializedShape ||
+           m_kind == APCKind::SerializedKeyset ||
+           m_kind == APCKind::SerializedObject);
+    m_flags.fetch_or(kCompressed, std::memory_order_relaxed);
   }
 
   /*
@@ -290,10 +310,14 @@ private:
   void atomicDecRef() const;
   void deleteShared();
 
+private:
+  static constexpr uint8_t kObjAttempted = 1u << 0;
+  static constexpr uint8_t kCompressed   = 1u << 1;
+
 private:
   const DataType m_type;
   const APCKind m_kind;
-  std::atomic<uint8_t> m_obj_attempted{false};
+  std::atomic<uint8_t> m_flags{0};
   DEBUG_ONLY std::atomic<uint8_t> m_unref_root_count{0};
   mutable std::atomic<uint32_t> m_count{1};
 };
@@ -29,10 +29,9 @@ inline APCLocalArray::APCLocalArray(const APCArray* source)
   , m_arr(source)
 {
   m_size = m_arr->size();
+  m_cacheInited = false;
   source->reference();
   tl_heap->addApcArray(this);
-  memset(localCache(), static_cast<data_type_t>(KindOfUninit),
-         m_size * sizeof(TypedValue));
   assertx(hasExactlyOneRef());
 }
 
@@ -65,8 +64,23 @@ inline TypedValue* APCLocalArray::localCache() const {
   );
 }
 
+inline TypedValue* APCLocalArray::ensureLocalCache() const {
+  auto const cache = localCache();
+  if (UNLIKELY(!m_cacheInited)) {
+    // Deferred from construction: a fetch that never reads an element
+    // (or reads a few out of a huge array) shouldn't pay for zeroing
+    // the whole cache.
+    memset(cache, static_cast<data_type_t>(KindOfUninit),
+           m_size * sizeof(TypedValue));
+    m_cacheInited = true;
+  }
+  return cache;
+}
+
 inline void APCLocalArray::scan(type_scan::Scanner& scanner) const {
-  scanner.scan(*localCache(), m_size * sizeof(TypedValue));
+  if (m_cacheInited) {
+    scanner.scan(*localCache(), m_size * sizeof(TypedValue));
+  }
 }
 
 //////////////////////////////////////////////////////////////////////
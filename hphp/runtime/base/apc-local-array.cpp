@@ -63,10 +63,12 @@ bool APCLocalArray::checkInvariants(const ArrayData* ad) {
   assertx(ad->isNotDVArray());
   assertx(ad->checkCount());
   DEBUG_ONLY auto const local = static_cast<const APCLocalArray*>(ad);
-  DEBUG_ONLY auto p = local->localCache();
-  for (auto end = p + local->getSize(); p < end; ++p) {
-    // Elements in the local cache must not be KindOfRef.
-    assertx(cellIsPlausible(*p));
+  if (local->m_cacheInited) {
+    DEBUG_ONLY auto p = local->localCache();
+    for (auto end = p + local->getSize(); p < end; ++p) {
+      // Elements in the local cache must not be KindOfRef.
+      assertx(cellIsPlausible(*p));
+    }
   }
   return true;
 }
@@ -85,7 +87,7 @@ tv_rval APCLocalArray::GetValueRef(const ArrayData* adIn,
                                               ssize_t pos) {
   auto const ad = asApcArray(adIn);
   assertx(unsigned(pos) < ad->getSize());
-  auto const elms = ad->localCache();
+  auto const elms = ad->ensureLocalCache();
   auto const tv = &elms[pos];
   if (tv->m_type != KindOfUninit) return tv;
   auto const sv = ad->m_arr->getValue(pos);
@@ -100,8 +102,10 @@ void APCLocalArray::Release(ArrayData* ad) {
   auto const a = asApcArray(ad);
   auto size = a->heapSize();
 
-  for (auto tv = a->localCache(), end = tv + a->m_size; tv < end; ++tv) {
-    tvDecRefGen(tv);
+  if (a->m_cacheInited) {
+    for (auto tv = a->localCache(), end = tv + a->m_size; tv < end; ++tv) {
+      tvDecRefGen(tv);
+    }
   }
   a->m_arr->unreference();
   tl_heap->removeApcArray(a);
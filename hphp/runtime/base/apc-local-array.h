@@ -165,10 +165,12 @@ private:
   Variant getKey(ssize_t pos) const;
   void sweep();
   TypedValue* localCache() const;
+  TypedValue* ensureLocalCache() const;
 
 private:
   const APCArray* m_arr;
   unsigned m_sweep_index;
+  mutable bool m_cacheInited;
   friend struct MemoryManager; // access to m_sweep_index
 };
 
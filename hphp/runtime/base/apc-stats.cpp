@@ -28,6 +28,9 @@
 
 #include "hphp/util/trace.h"
 
+#include <algorithm>
+#include <vector>
+
 
 namespace HPHP {
 
@@ -242,7 +245,8 @@ APCStats::APCStats() : m_valueSize(nullptr)
                      , m_livePrimedEntries(nullptr)
                      , m_uncountedEntries(nullptr)
                      , m_uncountedBlocks(nullptr)
-                     , m_detailedStats(nullptr) {
+                     , m_detailedStats(nullptr)
+                     , m_keyStats(nullptr) {
   m_valueSize = ServiceData::createCounter("apc.value_size.sum");
   m_keySize = ServiceData::createCounter("apc.key_size.sum");
   m_inFileSize = ServiceData::createCounter("apc.in_file_size.sum");
@@ -259,10 +263,14 @@ APCStats::APCStats() : m_valueSize(nullptr)
   if (RuntimeOption::EnableAPCStats) {
     m_detailedStats = new APCDetailedStats();
   }
+  if (apcExtension::KeyStatsPrefixLen > 0) {
+    m_keyStats = new APCKeyStats();
+  }
 }
 
 APCStats::~APCStats() {
   if (m_detailedStats) delete m_detailedStats;
+  if (m_keyStats) delete m_keyStats;
 }
 
 std::string APCStats::getStatsInfo() const {
@@ -659,4 +667,103 @@ void APCDetailedStats::removeType(const APCHandle* handle) {
 
 ///////////////////////////////////////////////////////////////////////////////
 
+APCKeyStats::APCKeyStats()
+  : m_capacity(std::max(apcExtension::KeyStatsSize, 1)) {
+  m_trackedPrefixes = ServiceData::createCounter("apc.key_stats.prefixes");
+  m_evictions = ServiceData::createCounter("apc.key_stats.evictions");
+  m_hits = ServiceData::createCounter("apc.key_stats.hits");
+  m_misses = ServiceData::createCounter("apc.key_stats.misses");
+}
+
+std::string APCKeyStats::prefixOf(const StringData* key) {
+  auto const data = key->data();
+  auto const limit = std::min<size_t>(key->size(),
+                                      apcExtension::KeyStatsPrefixLen);
+  size_t len = 0;
+  while (len < limit && !(data[len] >= '0' && data[len] <= '9')) len++;
+  return std::string(data, len);
+}
+
+APCKeyStats::Entry& APCKeyStats::entryFor(const StringData* key) {
+  auto prefix = prefixOf(key);
+  auto it = m_entries.find(prefix);
+  if (it != m_entries.end()) return it->second;
+  if (m_entries.size() < m_capacity) {
+    m_trackedPrefixes->increment();
+    return m_entries.emplace(std::move(prefix), Entry{}).first->second;
+  }
+  // The sketch is full: recycle the least-accessed prefix and let the
+  // newcomer inherit its access count as an upper error bound.
+  auto min = m_entries.begin();
+  for (auto cur = std::next(min); cur != m_entries.end(); ++cur) {
+    if (cur->second.accesses < min->second.accesses) min = cur;
+  }
+  Entry fresh;
+  fresh.accesses = min->second.accesses;
+  fresh.error = min->second.accesses;
+  m_entries.erase(min);
+  m_evictions->increment();
+  return m_entries.emplace(std::move(prefix), fresh).first->second;
+}
+
+void APCKeyStats::recordAccess(const StringData* key, bool hit) {
+  if (hit) {
+    m_hits->increment();
+  } else {
+    m_misses->increment();
+  }
+  std::lock_guard<std::mutex> l(m_mutex);
+  auto& entry = entryFor(key);
+  entry.accesses++;
+  if (hit) {
+    entry.hits++;
+  } else {
+    entry.misses++;
+  }
+}
+
+void APCKeyStats::recordStore(const StringData* key, size_t size, int64_t ttl) {
+  std::lock_guard<std::mutex> l(m_mutex);
+  auto& entry = entryFor(key);
+  entry.accesses++;
+  entry.stores++;
+  entry.storedBytes += size;
+  if (entry.maxSize < (int64_t)size) entry.maxSize = size;
+  entry.lastTTL = ttl;
+}
+
+std::string APCKeyStats::getStatsInfo() const {
+  std::vector<std::pair<std::string, Entry>> entries;
+  {
+    std::lock_guard<std::mutex> l(m_mutex);
+    entries.assign(m_entries.begin(), m_entries.end());
+  }
+  std::sort(entries.begin(), entries.end(),
+            [](const std::pair<std::string, Entry>& a,
+               const std::pair<std::string, Entry>& b) {
+              return a.second.accesses > b.second.accesses;
+            });
+  std::string info("APC key stats: ");
+  info += std::to_string(entries.size()) + " prefixes, " +
+          std::to_string(m_evictions->getValue()) + " evictions\n" +
+          "prefix accesses error hits misses stores stored_bytes "
+          "max_size last_ttl\n";
+  for (auto const& pair : entries) {
+    auto const& e = pair.second;
+    info += (pair.first.empty() ? "<empty>" : pair.first) +
+            " " + std::to_string(e.accesses) +
+            " " + std::to_string(e.error) +
+            " " + std::to_string(e.hits) +
+            " " + std::to_string(e.misses) +
+            " " + std::to_string(e.stores) +
+            " " + std::to_string(e.storedBytes) +
+            " " + std::to_string(e.maxSize) +
+            " " + std::to_string(e.lastTTL) +
+            "\n";
+  }
+  return info;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 }
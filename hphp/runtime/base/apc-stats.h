@@ -20,6 +20,10 @@
 #include "hphp/runtime/base/apc-string.h"
 #include "hphp/util/service-data.h"
 
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
 namespace HPHP {
 
 struct APCHandle;
@@ -153,6 +157,63 @@ private:
   ServiceData::ExportedCounter* m_expValues;
 };
 
+/*
+ * Per-key-prefix hit/miss/size/TTL stats, enabled by setting
+ * Server.APC.KeyStats.PrefixLen > 0. Keys are grouped by a prefix (the key
+ * truncated at the first decimal digit or at PrefixLen characters, whichever
+ * comes first), so "user:1234" and "user:99" land in the same bucket.
+ *
+ * Cardinality is bounded with a space-saving sketch: at most
+ * Server.APC.KeyStats.Size prefixes are tracked, and when the table is full
+ * the least-accessed prefix is recycled for the newcomer, which inherits its
+ * access count as an error bound. The hottest and biggest prefixes are
+ * therefore accurate even when the key space is not.
+ *
+ * Every get and store takes a global lock when this is enabled, so it is a
+ * diagnostic tool, not something to leave on in steady state.
+ */
+struct APCKeyStats {
+  APCKeyStats();
+
+  // Return a formatted table of the tracked prefixes, hottest first.
+  std::string getStatsInfo() const;
+
+  // A lookup for a key completed; 'hit' tells whether it found a value.
+  void recordAccess(const StringData* key, bool hit);
+  // A value of 'size' bytes was stored for a key with time-to-live 'ttl'.
+  void recordStore(const StringData* key, size_t size, int64_t ttl);
+
+private:
+  struct Entry {
+    int64_t accesses{0};  // hits + misses + stores; the space-saving weight
+    int64_t error{0};     // accesses inherited from an evicted prefix
+    int64_t hits{0};
+    int64_t misses{0};
+    int64_t stores{0};
+    int64_t storedBytes{0};
+    int64_t maxSize{0};
+    int64_t lastTTL{0};
+  };
+
+  static std::string prefixOf(const StringData* key);
+  // Find or create the entry for the key's prefix. Requires m_mutex.
+  Entry& entryFor(const StringData* key);
+
+private:
+  const size_t m_capacity;
+  mutable std::mutex m_mutex;
+  std::unordered_map<std::string, Entry> m_entries;
+
+  // Number of prefixes currently tracked
+  ServiceData::ExportedCounter* m_trackedPrefixes;
+  // Number of prefixes recycled by the space-saving sketch
+  ServiceData::ExportedCounter* m_evictions;
+  // Overall lookups that found a value
+  ServiceData::ExportedCounter* m_hits;
+  // Overall lookups that missed
+  ServiceData::ExportedCounter* m_misses;
+};
+
 /*
  * Class that wraps the ODS counters and offers a simple API to
  * update the counters.
@@ -281,6 +342,10 @@ struct APCStats {
     m_pendingDeleteSize->addValue(-size);
   }
 
+  // Per-key-prefix stats, or nullptr unless Server.APC.KeyStats.PrefixLen
+  // is set
+  APCKeyStats* keyStats() const { return m_keyStats; }
+
 private:
   static std::unique_ptr<APCStats> s_apcStats;
 
@@ -319,6 +384,8 @@ private:
 
   // detailed info
   APCDetailedStats* m_detailedStats;
+  // per-key-prefix info
+  APCKeyStats* m_keyStats;
 
 };
 
@@ -15,11 +15,19 @@
 */
 #include "hphp/runtime/base/apc-string.h"
 
+#include "hphp/runtime/ext/apc/ext_apc.h"
+#include "hphp/util/zstd.h"
+
 namespace HPHP {
 ///////////////////////////////////////////////////////////////////////////////
 
 APCHandle::Pair
 APCString::MakeSharedString(APCKind kind, StringData* data) {
+  if (UNLIKELY(apcExtension::CompressionLevel != 0) &&
+      kind != APCKind::SharedString &&
+      data->size() >= apcExtension::CompressionThreshold) {
+    if (auto const pair = MakeCompressed(kind, data)) return pair;
+  }
   auto const len    = static_cast<uint32_t>(data->size());
   auto const size   = len + 1 + sizeof(APCString);
   auto const mem    = uncounted_malloc(size);
@@ -47,5 +55,64 @@ APCString::MakeSharedString(APCKind kind, StringData* data) {
   return {&apcStr->m_handle, size};
 }
 
+/*
+ * Try to store the payload as a single zstd frame. Returns a null pair if
+ * compression fails or does not shrink the data, in which case the caller
+ * falls back to the plain representation.
+ */
+APCHandle::Pair
+APCString::MakeCompressed(APCKind kind, StringData* data) {
+  size_t len = data->size();
+  ZstdCompressor compressor(apcExtension::CompressionLevel);
+  auto const compressed = std::unique_ptr<const char[]>(
+    compressor.compress(data->data(), len, true));
+  if (!compressed || len >= static_cast<size_t>(data->size())) {
+    return {nullptr, 0};
+  }
+
+  auto const size   = len + 1 + sizeof(APCString);
+  auto const mem    = uncounted_malloc(size);
+  auto apcStr       = new (mem) APCString(kind);
+
+  auto const chars  = reinterpret_cast<char*>(apcStr + 1);
+#ifndef NO_M_DATA
+  apcStr->m_str.m_data = chars;
+#endif
+  apcStr->m_str.initHeader(HeaderKind::String, UncountedValue);
+  apcStr->m_str.m_len = len;
+
+  memcpy(chars, compressed.get(), len);
+  chars[len] = 0;
+  // The hash of the compressed bytes is meaningless, but preCompute keeps
+  // the StringData invariants (m_hash != 0) that checkSane expects.
+  apcStr->m_str.preCompute();
+  apcStr->m_handle.setCompressed();
+
+  assertx(apcStr->m_str.isUncounted());
+  assertx(apcStr->m_str.isFlat());
+  assertx(apcStr->m_str.checkSane());
+  return {&apcStr->m_handle, size};
+}
+
+String APCString::toLocalString() const {
+  if (LIKELY(!m_handle.isCompressed())) {
+    return String{const_cast<StringData*>(&m_str)};
+  }
+  auto const src = m_str.data();
+  auto const srcLen = static_cast<size_t>(m_str.size());
+  auto const origLen = ZSTD_getFrameContentSize(src, srcLen);
+  // Single-shot ZSTD_compress always records the content size in the frame.
+  always_assert(origLen != ZSTD_CONTENTSIZE_UNKNOWN &&
+                origLen != ZSTD_CONTENTSIZE_ERROR);
+  assertx(origLen <= StringData::MaxSize);
+  String out(static_cast<size_t>(origLen), ReserveString);
+  auto const ret = ZSTD_decompress(out.mutableData(), origLen, src, srcLen);
+  always_assert_flog(!ZSTD_isError(ret) && ret == origLen,
+                     "zstd decompression of an APC value failed: {}",
+                     ZSTD_isError(ret) ? ZSTD_getErrorName(ret) : "short read");
+  out.setSize(static_cast<int>(origLen));
+  return out;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 }
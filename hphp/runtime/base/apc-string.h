@@ -28,6 +28,12 @@ namespace HPHP {
  * APCString holds the data to create a PHP string from APC.
  * This object only covers KindOfString. KindOfPersistentString are handled
  * via APCTypedValue.
+ *
+ * The payload of the Serialized* kinds may be stored zstd-compressed when
+ * Server.APC.Compression.Level is set and the string clears the size
+ * threshold; such entries carry APCHandle::isCompressed() and are
+ * decompressed on fetch by toLocalString(). SharedString is never
+ * compressed since it is handed out as a zero-copy proxy string.
  */
 struct APCString {
 
@@ -109,8 +115,16 @@ struct APCString {
     return &m_str;
   }
 
+  /*
+   * Return the original payload, decompressing it into a request-local
+   * string if this entry was stored compressed. Uncompressed entries hand
+   * back the shared StringData without copying.
+   */
+  String toLocalString() const;
+
 private:
   static APCHandle::Pair MakeSharedString(APCKind, StringData*);
+  static APCHandle::Pair MakeCompressed(APCKind, StringData*);
   explicit APCString(APCKind kind) : m_handle(kind) {}
   ~APCString() {}
   APCString(const APCString&) = delete;
@@ -601,6 +601,16 @@ struct PackedPHPArrayInitBase : PackedArrayInitBase<TArray, KindOfArray> {
     return append(*v.asTypedValue());
   }
 
+  /*
+   * Append a span of cells in one step; see PackedArray::AppendN.
+   */
+  PackedPHPArrayInitBase& appendN(const Cell* vals, uint32_t n) {
+    this->performOp([&]{
+      return PackedArray::AppendN(this->m_arr, vals, n, false);
+    });
+    return *this;
+  }
+
   PackedPHPArrayInitBase& appendRef(Variant& v) {
     this->performOp([&]{
       return PackedArray::AppendRef(this->m_arr, LV(v), false);
@@ -636,6 +646,16 @@ struct VecArrayInit : PackedArrayInitBase<detail::VecArray, KindOfVec> {
   VecArrayInit& append(const Variant& v) {
     return append(*v.asTypedValue());
   }
+
+  /*
+   * Append a span of cells in one step; see PackedArray::AppendN.
+   */
+  VecArrayInit& appendN(const Cell* vals, uint32_t n) {
+    performOp([&]{
+      return PackedArray::AppendN(m_arr, vals, n, false);
+    });
+    return *this;
+  }
 };
 
 ///////////////////////////////////////////////////////////////////////////////
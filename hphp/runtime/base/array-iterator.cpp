@@ -1364,6 +1364,7 @@ int64_t iter_next_mixed_impl(Iter* it,
       return 0;
     }
   } while (UNLIKELY(arr->isTombstone(pos)));
+  arr->prefetchArrayElm(pos + 1);
 
   if (isRefcountedType(valOut->m_type)) {
     if (UNLIKELY(valOut->m_data.pcnt->decWillRelease())) {
@@ -28,6 +28,8 @@
 
 #include <folly/ScopeGuard.h>
 
+#include <algorithm>
+
 namespace HPHP {
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -304,6 +306,10 @@ void PackedArray::Sort(ArrayData* ad, int sort_flags, bool ascending) {
   a->m_pos = 0;
   auto data_begin = packedData(ad);
   auto data_end = data_begin + a->m_size;
+  if (flav == IntegerSort &&
+      (sort_flags == SORT_REGULAR || sort_flags == SORT_NUMERIC)) {
+    return sortIntPackedElms(data_begin, a->m_size, ascending);
+  }
   CALL_SORT(TVAccessor);
 }
 
@@ -377,6 +383,61 @@ bool SetArray::Uksort(ArrayData* ad, const Variant& cmp_function) {
   return true;
 }
 
+namespace {
+
+/*
+ * Specialized kernel for packed arrays where preSort() proved every element
+ * is KindOfInt64 and the requested order is plain numeric. The TV headers
+ * are all identical, so only the payloads need to move: extract them, sort
+ * with LSD radix above the cutoff (std::sort below it, where radix setup
+ * costs more than it saves), and store back.
+ */
+constexpr uint32_t kIntSortRadixCutoff = 1024;
+
+void sortIntPackedElms(TypedValue* data, uint32_t n, bool ascending) {
+  auto keys = req::make_raw_array_uninit<uint64_t>(n);
+  SCOPE_EXIT { req::free(keys); };
+  for (uint32_t i = 0; i < n; ++i) {
+    // Bias by 2^63 so unsigned radix order matches signed value order.
+    keys[i] = uint64_t(data[i].m_data.num) + (1ull << 63);
+  }
+  if (n < kIntSortRadixCutoff) {
+    std::sort(keys, keys + n);
+  } else {
+    auto tmp = req::make_raw_array_uninit<uint64_t>(n);
+    SCOPE_EXIT { req::free(tmp); };
+    auto src = keys;
+    auto dst = tmp;
+    for (uint32_t shift = 0; shift < 64; shift += 8) {
+      uint32_t count[257] = {};
+      for (uint32_t i = 0; i < n; ++i) {
+        ++count[((src[i] >> shift) & 0xff) + 1];
+      }
+      // Skip digits where every key falls in one bucket (common for the
+      // high bytes of small integers).
+      auto const first = (src[0] >> shift) & 0xff;
+      if (count[first + 1] - count[first] == n) continue;
+      for (uint32_t b = 0; b < 256; ++b) count[b + 1] += count[b];
+      for (uint32_t i = 0; i < n; ++i) {
+        dst[count[(src[i] >> shift) & 0xff]++] = src[i];
+      }
+      std::swap(src, dst);
+    }
+    if (src != keys) memcpy(keys, src, n * sizeof(uint64_t));
+  }
+  if (ascending) {
+    for (uint32_t i = 0; i < n; ++i) {
+      data[i].m_data.num = int64_t(keys[i] - (1ull << 63));
+    }
+  } else {
+    for (uint32_t i = 0; i < n; ++i) {
+      data[i].m_data.num = int64_t(keys[n - 1 - i] - (1ull << 63));
+    }
+  }
+}
+
+}
+
 SortFlavor PackedArray::preSort(ArrayData* ad) {
   assertx(checkInvariants(ad));
   auto const data = packedData(ad);
@@ -16,17 +16,23 @@
 #include "hphp/runtime/base/autoload-handler.h"
 
 #include <algorithm>
+#include <memory>
+#include <mutex>
 
 #include "hphp/runtime/base/array-init.h"
+#include "hphp/runtime/base/array-iterator.h"
 #include "hphp/runtime/base/builtin-functions.h"
 #include "hphp/runtime/ext/string/ext_string.h"
 #include "hphp/runtime/base/type-string.h"
 #include "hphp/runtime/base/tv-refcount.h"
 #include "hphp/runtime/base/container-functions.h"
 #include "hphp/runtime/base/unit-cache.h"
+#include "hphp/runtime/vm/fixed-string-map.h"
 #include "hphp/runtime/vm/unit.h"
 #include "hphp/runtime/vm/unit-util.h"
 #include "hphp/runtime/vm/vm-regs.h"
+#include "hphp/util/functional.h"
+#include "hphp/util/hash-map.h"
 
 namespace HPHP {
 
@@ -51,6 +57,122 @@ using CufIterPtr = req::unique_ptr<CufIter>;
 
 //////////////////////////////////////////////////////////////////////
 
+/*
+ * Process-wide cache of key filters for static autoload maps.  In repo
+ * mode the map handed to HH\autoload_set_paths() each request is the same
+ * static array the repo build produced, so the filter is built once and
+ * shared across requests and threads.  Entries are never freed; there are
+ * only as many as there are distinct static maps.
+ */
+std::mutex s_keyFilterLock;
+hphp_hash_map<const ArrayData*,
+              std::unique_ptr<AutoloadHandler::KeyFilter>,
+              pointer_hash<ArrayData>> s_keyFilters;
+
+const AutoloadHandler::KeyFilter* getKeyFilter(const ArrayData* map) {
+  std::lock_guard<std::mutex> g(s_keyFilterLock);
+  auto& filter = s_keyFilters[map];
+  if (!filter) {
+    filter = std::make_unique<AutoloadHandler::KeyFilter>();
+    for (auto const& kind :
+           { s_class, s_function, s_constant, s_type }) {
+      auto const sub = map->get(kind.get()).unboxed();
+      if (!isArrayType(sub.type()) && !isDictType(sub.type())) continue;
+      auto const kindHash = kind.get()->hash();
+      IterateKVNoInc(
+        sub.val().parr,
+        [&] (Cell k, TypedValue /*v*/) {
+          if (isStringType(k.m_type)) {
+            filter->insertHash(
+              hash_int64_pair(kindHash, k.m_data.pstr->hash()));
+          }
+        }
+      );
+    }
+  }
+  return filter.get();
+}
+
+//////////////////////////////////////////////////////////////////////
+
+}
+
+struct AutoloadHandler::CompiledMap {
+  // One table per kind, in the order of the loop in getCompiledMap().
+  // Keys and values are the map's own static strings; lookups match the
+  // interpretation of the array form, where the query name has already
+  // been lowercased for the case-insensitive kinds and keys that are not
+  // in canonical form are simply unreachable.
+  FixedStringMap<StringData*, true> tables[4];
+
+  /*
+   * Returns the file for `name' under `kind', or nullptr.  The tables
+   * cover every string-keyed entry of the map, so nullptr is a
+   * definitive miss.
+   */
+  StringData* lookup(const String& kind, const StringData* name) const {
+    auto const kindSd = kind.get();
+    auto const idx =
+      kindSd == s_class.get()    ? 0 :
+      kindSd == s_function.get() ? 1 :
+      kindSd == s_constant.get() ? 2 :
+      kindSd == s_type.get()     ? 3 : -1;
+    if (idx < 0) return nullptr;
+    auto const file = tables[idx].find(name);
+    return file ? *file : nullptr;
+  }
+};
+
+namespace {
+
+/*
+ * Process-wide cache of compiled autoload maps, sharing the lifetime
+ * rules of s_keyFilters above.
+ */
+std::mutex s_compiledMapLock;
+hphp_hash_map<const ArrayData*,
+              std::unique_ptr<AutoloadHandler::CompiledMap>,
+              pointer_hash<ArrayData>> s_compiledMaps;
+
+const AutoloadHandler::CompiledMap* getCompiledMap(const ArrayData* map) {
+  std::lock_guard<std::mutex> g(s_compiledMapLock);
+  auto& compiled = s_compiledMaps[map];
+  if (!compiled) {
+    compiled = std::make_unique<AutoloadHandler::CompiledMap>();
+    auto idx = 0;
+    for (auto const& kind :
+           { s_class, s_function, s_constant, s_type }) {
+      auto& table = compiled->tables[idx++];
+      auto const sub = map->get(kind.get()).unboxed();
+      if (!isArrayType(sub.type()) && !isDictType(sub.type())) {
+        table.init(0);
+        continue;
+      }
+      // Non-string keys can never match a name, and non-string files are
+      // treated as misses by the lookup path, so both compile to absence.
+      auto num = 0;
+      IterateKVNoInc(
+        sub.val().parr,
+        [&] (Cell k, TypedValue v) {
+          if (isStringType(k.m_type) && isStringType(v.m_type)) ++num;
+        }
+      );
+      table.init(num);
+      IterateKVNoInc(
+        sub.val().parr,
+        [&] (Cell k, TypedValue v) {
+          if (isStringType(k.m_type) && isStringType(v.m_type)) {
+            table.add(k.m_data.pstr, v.m_data.pstr);
+          }
+        }
+      );
+    }
+  }
+  return compiled.get();
+}
+
+//////////////////////////////////////////////////////////////////////
+
 Variant invoke_for_autoload(const String& function, const Variant& params) {
   Func* func = Unit::loadFunc(function.get());
   if (func && (isContainer(params) || params.isNull())) {
@@ -140,6 +262,8 @@ void AutoloadHandler::requestInit() {
 void AutoloadHandler::requestShutdown() {
   m_map.reset();
   m_map_root.reset();
+  m_mapKeys = nullptr;
+  m_compiledMap = nullptr;
   m_loading.reset();
   m_handlers_valid = false;
   // m_spl_stack_inited will be re-initialized by the next requestInit
@@ -149,6 +273,16 @@ void AutoloadHandler::requestShutdown() {
 bool AutoloadHandler::setMap(const Array& map, const String& root) {
   this->m_map = map;
   this->m_map_root = root;
+  // Only a static array is immutable and identity-cacheable.  For a
+  // dynamically built map, skip the filter and the compiled form rather
+  // than pay to rebuild them every request.
+  if (map.get()->isStatic()) {
+    m_mapKeys = getKeyFilter(map.get());
+    m_compiledMap = getCompiledMap(map.get());
+  } else {
+    m_mapKeys = nullptr;
+    m_compiledMap = nullptr;
+  }
   return true;
 }
 
@@ -240,15 +374,29 @@ AutoloadHandler::loadFromMapImpl(const String& clsName,
   assertx(!m_map.isNull());
   // Always normalize name before autoloading
   const String& name = normalizeNS(clsName);
-  auto const type_map = m_map.get()->get(kind).unboxed();
-  if (!isArrayType(type_map.type()) && !isDictType(type_map.type())) {
+  // The filter covers every key the map defines, so a miss proves the
+  // probe below cannot succeed.  StringData hashes are case-insensitive,
+  // which makes testing before the strtolower() below sound.
+  if (m_mapKeys &&
+      !m_mapKeys->testHash(hash_int64_pair(kind.get()->hash(),
+                                           name.get()->hash()))) {
     return Failure;
   }
   String canonicalName = toLower ? HHVM_FN(strtolower)(name) : name;
-  auto const file = type_map.val().parr->get(canonicalName).unboxed();
+  StringData* file = nullptr;
+  if (m_compiledMap) {
+    file = m_compiledMap->lookup(kind, canonicalName.get());
+  } else {
+    auto const type_map = m_map.get()->get(kind).unboxed();
+    if (!isArrayType(type_map.type()) && !isDictType(type_map.type())) {
+      return Failure;
+    }
+    auto const entry = type_map.val().parr->get(canonicalName).unboxed();
+    if (isStringType(entry.type())) file = entry.val().pstr;
+  }
   bool ok = false;
-  if (isStringType(file.type())) {
-    String fName{file.val().pstr};
+  if (file) {
+    String fName{file};
     if (fName.get()->data()[0] != '/') {
       if (!m_map_root.empty()) {
         fName = m_map_root + fName;
@@ -24,6 +24,7 @@
 #include "hphp/runtime/base/type-variant.h"
 #include "hphp/runtime/base/type-array.h"
 #include "hphp/runtime/base/rds-local.h"
+#include "hphp/util/bloom-filter.h"
 
 namespace HPHP {
 
@@ -98,6 +99,23 @@ public:
   bool setMap(const Array& map, const String& root);
   DECLARE_STATIC_REQUEST_LOCAL(AutoloadHandler, s_instance);
 
+  /**
+   * Bloom filter over an autoload map's keys; entries are hashed with
+   * hash_int64_pair(kind hash, name hash).  A miss proves the map does
+   * not define the name, so repeated probes for undefined names (e.g.
+   * class_exists() feature detection) skip the map lookup entirely.
+   */
+  using KeyFilter = BloomFilter<8 * 1024 * 1024>;
+
+  /**
+   * A static autoload map compiled into native tables: one FixedStringMap
+   * per kind, keyed on the map's own (canonical) names with the mapped
+   * file as the value.  Like KeyFilter instances, compiled maps are built
+   * once per distinct static array and shared process-wide, so lookups
+   * never touch the underlying PHP array.
+   */
+  struct CompiledMap;
+
 private:
   /**
    * This method may return Success or Failure.
@@ -147,6 +165,12 @@ private:
 private:
   Array m_map;
   String m_map_root;
+  /* Shared, process-lived filter over m_map's keys; null when m_map is
+   * not a static array. */
+  const KeyFilter* m_mapKeys{nullptr};
+  /* Shared, process-lived compiled form of m_map; null when m_map is not
+   * a static array. */
+  const CompiledMap* m_compiledMap{nullptr};
   bool m_spl_stack_inited{false};
   union {
     req::deque<HandlerBundle> m_handlers;
@@ -20,9 +20,14 @@
 #include "hphp/runtime/base/apc-handle-defs.h"
 #include "hphp/runtime/base/apc-object.h"
 #include "hphp/runtime/base/apc-stats.h"
+#include "hphp/runtime/base/apc-string.h"
+#include "hphp/runtime/base/apc-typed-value.h"
+#include "hphp/runtime/base/array-init.h"
+#include "hphp/runtime/base/array-iterator.h"
 #include "hphp/runtime/base/variable-serializer.h"
 #include "hphp/runtime/base/variable-unserializer.h"
 #include "hphp/runtime/ext/apc/ext_apc.h"
+#include "hphp/runtime/ext/apc/snapshot-builder.h"
 #include "hphp/runtime/ext/apc/snapshot.h"
 #include "hphp/runtime/vm/treadmill.h"
 
@@ -35,6 +40,7 @@
 #include <string>
 #include <vector>
 
+#include <folly/Bits.h>
 #include <folly/Format.h>
 #include <folly/Random.h>
 
@@ -80,6 +86,8 @@ void StoreValue::set(APCHandle* v, int64_t ttl) {
   mtime = time(nullptr);
   if (c_time == 0)  c_time = mtime;
   expire = ttl ? mtime + ttl : 0;
+  // A fresh value re-arms the stale-refresh window (see getStale()).
+  refreshClaimed.store(0, std::memory_order_relaxed);
 }
 
 bool StoreValue::expired() const {
@@ -399,8 +407,154 @@ bool HotCache::clearValueIdx(Idx idx) {
 
 //////////////////////////////////////////////////////////////////////
 
+/*
+ * Wait-free overlay over the primed portion of the keyspace.
+ *
+ * Priming happens once, before the server takes traffic, and in most
+ * deployments the primed keys are never written again.  Once primeDone()
+ * has sealed the store, we freeze those keys into a fixed open-addressed
+ * table that 'get' consults before taking m_lock or a table accessor, so
+ * fetching a primed key costs a hash and a couple of probes, with no
+ * locking at all.
+ *
+ * Only values that can be handed out without touching a reference count
+ * are ever published here: the singleton kinds and the uncounted types,
+ * the same rule as HotCache::supportedKind.  Everything else keeps a null
+ * slot and falls through to the locked path.  Entries primed in serialized
+ * form get their slot armed when they are first promoted to an in-memory
+ * value (see 'unserialize').
+ *
+ * readOnly is advisory, not enforced, so a primed key can still be
+ * overwritten or erased; when that happens the slot is cleared from under
+ * the store's per-entry lock and stays empty for good.  A reader racing
+ * such a clear may still return the old value, which is indistinguishable
+ * from the read having happened slightly earlier; the value itself stays
+ * alive for any request in flight because uncounted handles are only
+ * freed via the treadmill.
+ *
+ * Slots are written during the single-threaded build, by 'arm' and by the
+ * invalidation paths; the key array itself is immutable once built.
+ */
+struct PrimedKeyIndex {
+  /*
+   * Build the table from the (key, handle) pairs present at the end of
+   * priming; 'handle' may be null for entries still in serialized form.
+   * Must be called at most once, before any concurrent access.
+   */
+  void build(const std::vector<std::pair<const char*, APCHandle*>>& entries);
+
+  /*
+   * If 'key' has an armed slot, set 'value' and return true.  Wait-free.
+   * Armed slots never have a TTL, so there is no expiration to check.
+   */
+  bool get(const StringData* key, Variant& value) const {
+    if (!m_table) return false;
+    auto const slot = find(key->data(), key->size(), key->hash());
+    if (!slot) return false;
+    auto const handle = slot->value.load(std::memory_order_acquire);
+    if (!handle) return false;
+    value = handle->toLocal();
+    return true;
+  }
+
+  /*
+   * Consistent with 'get', only less output.
+   */
+  bool hasValue(const StringData* key) const {
+    if (!m_table) return false;
+    auto const slot = find(key->data(), key->size(), key->hash());
+    return slot && slot->value.load(std::memory_order_acquire) != nullptr;
+  }
+
+  /*
+   * Publish the handle a primed key was just promoted to (serialized ->
+   * in-memory, under the entry's lock).  No-op unless the key was primed
+   * and the kind is safe to serve (see above).
+   */
+  void arm(const StringData* key, APCHandle* handle) {
+    if (!m_table || !supportedKind(handle)) return;
+    if (auto const slot = find(key->data(), key->size(), key->hash())) {
+      slot->value.store(handle, std::memory_order_release);
+    }
+  }
+
+  /*
+   * Hide 'key' for good.  Must be called, before the old handle is
+   * unreferenced, by anything that overwrites or erases an entry that may
+   * be in the index; the caller's Map accessor orders it against 'arm'.
+   */
+  void invalidate(const char* key) {
+    if (!m_table) return;
+    auto const len = strlen(key);
+    if (auto const slot = find(key, len, StringData::hash(key, len))) {
+      slot->value.store(nullptr, std::memory_order_release);
+    }
+  }
+
+  /*
+   * Hide every key; for clear().
+   */
+  void invalidateAll() {
+    if (!m_table) return;
+    for (size_t i = 0; i <= m_mask; ++i) {
+      m_table[i].value.store(nullptr, std::memory_order_release);
+    }
+  }
+
+ private:
+  struct Slot {
+    const char* key{nullptr};  // Owned; never freed.
+    std::atomic<APCHandle*> value{nullptr};
+  };
+
+  static bool supportedKind(const APCHandle* h) {
+    return h->isSingletonKind() || h->isUncounted();
+  }
+
+  Slot* find(const char* data, size_t len, strhash_t hash) const {
+    auto idx = static_cast<size_t>(hash) & m_mask;
+    while (true) {
+      auto& slot = m_table[idx];
+      if (slot.key == nullptr) return nullptr;
+      if (memcmp(slot.key, data, len) == 0 && slot.key[len] == '\0') {
+        return const_cast<Slot*>(&slot);
+      }
+      idx = (idx + 1) & m_mask;
+    }
+  }
+
+  size_t m_mask{0};
+  std::unique_ptr<Slot[]> m_table;
+};
+PrimedKeyIndex s_primedIndex;
+
+void PrimedKeyIndex::build(
+    const std::vector<std::pair<const char*, APCHandle*>>& entries) {
+  assertx(!m_table);
+  if (entries.empty()) return;
+  // Cap the load factor at 50% so probe chains stay short.
+  auto const capacity = folly::nextPowTwo(entries.size() * 2);
+  m_mask = capacity - 1;
+  m_table = std::make_unique<Slot[]>(capacity);
+  for (auto const& entry : entries) {
+    auto const len = strlen(entry.first);
+    auto idx = static_cast<size_t>(StringData::hash(entry.first, len)) & m_mask;
+    while (m_table[idx].key != nullptr) idx = (idx + 1) & m_mask;
+    auto& slot = m_table[idx];
+    auto const copy = static_cast<char*>(apc_malloc(len + 1));
+    memcpy(copy, entry.first, len + 1);
+    slot.key = copy;
+    if (entry.second && supportedKind(entry.second)) {
+      slot.value.store(entry.second, std::memory_order_relaxed);
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////
+
 bool ConcurrentTableSharedStore::clear() {
   SharedMutex::WriteHolder l(m_lock);
+  if (m_primedIndexed) s_primedIndex.invalidateAll();
   for (Map::iterator iter = m_vars.begin(); iter != m_vars.end();
        ++iter) {
     s_hotCache.clearValue(iter->second);
@@ -447,6 +601,7 @@ bool ConcurrentTableSharedStore::eraseImpl(const char* key,
 
   auto& storeVal = acc->second;
   bool wasCached = s_hotCache.clearValue(storeVal);
+  if (m_primedIndexed) s_primedIndex.invalidate(acc->first);
 
   if (auto const var = storeVal.data().left()) {
     APCStats::getAPCStats().removeAPCValue(storeVal.dataSize, var,
@@ -508,21 +663,26 @@ void ConcurrentTableSharedStore::purgeExpired() {
   time_t now = time(nullptr);
   int64_t oldestLive = apcExtension::UseUncounted ?
       HPHP::Treadmill::getOldestStartTime() : 0;
+  // Drain (at most PurgeRate entries of) a single shard per purge
+  // event, round-robin, so no request stalls on a store-wide pass.
+  auto& expQueue =
+    m_expQueues[m_nextExpQueue.fetch_add(1, std::memory_order_relaxed) &
+                (kNumExpQueues - 1)];
   ExpirationPair tmp;
   int i = 0;
   while (apcExtension::PurgeRate < 0 || i < apcExtension::PurgeRate) {
-    if (!m_expQueue.try_pop(tmp)) {
+    if (!expQueue.try_pop(tmp)) {
       break;
     }
     if (tmp.second > now) {
-      m_expQueue.push(tmp);
+      expQueue.push(tmp);
       break;
     }
     if (UNLIKELY(tmp.first ==
                  intptr_t(apcExtension::FileStorageFlagKey.c_str()))) {
       adviseOut();
       tmp.second = time(nullptr) + apcExtension::FileStorageAdviseOutPeriod;
-      m_expQueue.push(tmp);
+      expQueue.push(tmp);
       continue;
     }
     ExpMap::accessor acc;
@@ -595,6 +755,9 @@ APCHandle* ConcurrentTableSharedStore::unserialize(const String& key,
     sval->dataSize = pair.size;
     sval->setHandle(pair.handle);  // Publish unserialized value (see 'get').
     APCStats::getAPCStats().addAPCValue(pair.handle, pair.size, true);
+    // Serialized entries only exist as a result of priming, so the promoted
+    // value can now serve lock-free fetches (if its kind is eligible).
+    if (m_primedIndexed) s_primedIndex.arm(key.get(), pair.handle);
     return pair.handle;
   } catch (ResourceExceededException&) {
     throw;
@@ -606,12 +769,77 @@ APCHandle* ConcurrentTableSharedStore::unserialize(const String& key,
 }
 
 bool ConcurrentTableSharedStore::get(const String& keyStr, Variant& value) {
+  bool needsRefresh;
+  return getImpl(keyStr, value, 0, needsRefresh);
+}
+
+bool ConcurrentTableSharedStore::getStale(const String& keyStr, Variant& value,
+                                          int64_t grace, bool& needsRefresh) {
+  return getImpl(keyStr, value, grace, needsRefresh);
+}
+
+Array ConcurrentTableSharedStore::getBulk(const Array& keys) {
+  ArrayInit init(keys.size(), ArrayInit::Map{});
+  SharedMutex::ReadHolder l(m_lock);
+  for (ArrayIter iter(keys); iter; ++iter) {
+    auto const strKey = iter.second().toString();
+    FTRACE(3, "Bulk get {}\n", strKey.get()->data());
+    Variant v;
+    bool needsRefresh;
+    HotCache::Idx hotIdx = StoreValue::kHotCacheUnknown;
+    auto const found = s_hotCache.get(strKey.get(), v, hotIdx) ||
+                       (m_primedIndexed && s_primedIndex.get(strKey.get(), v)) ||
+                       getLocked(strKey, v, 0, needsRefresh, hotIdx);
+    if (found) {
+      init.set(strKey, v);
+    }
+    if (auto const keyStats = APCStats::getAPCStats().keyStats()) {
+      keyStats->recordAccess(strKey.get(), found);
+    }
+  }
+  return init.toArray();
+}
+
+bool ConcurrentTableSharedStore::getImpl(const String& keyStr, Variant& value,
+                                         int64_t grace, bool& needsRefresh) {
   FTRACE(3, "Get {}\n", keyStr.get()->data());
-  HotCache::Idx hotIdx;
-  if (s_hotCache.get(keyStr.get(), value, hotIdx)) return true;
+  needsRefresh = false;
+  // The hot cache knows nothing about expiration times, so grace-window
+  // lookups always go to the primary table.
+  HotCache::Idx hotIdx = StoreValue::kHotCacheUnknown;
+  auto const keyStats = APCStats::getAPCStats().keyStats();
+  if (grace <= 0 && s_hotCache.get(keyStr.get(), value, hotIdx)) {
+    if (UNLIKELY(keyStats != nullptr)) {
+      keyStats->recordAccess(keyStr.get(), true);
+    }
+    return true;
+  }
+  // Armed index slots never carry a TTL, so unlike the hot cache this path
+  // is valid for grace-window lookups too (needsRefresh stays false).
+  if (m_primedIndexed && s_primedIndex.get(keyStr.get(), value)) {
+    if (UNLIKELY(keyStats != nullptr)) {
+      keyStats->recordAccess(keyStr.get(), true);
+    }
+    return true;
+  }
+  SharedMutex::ReadHolder l(m_lock);
+  auto const found = getLocked(keyStr, value, grace, needsRefresh, hotIdx);
+  if (UNLIKELY(keyStats != nullptr)) {
+    keyStats->recordAccess(keyStr.get(), found);
+  }
+  return found;
+}
+
+/*
+ * The body of a lookup; the caller must hold m_lock in shared mode.
+ */
+bool ConcurrentTableSharedStore::getLocked(const String& keyStr,
+                                           Variant& value,
+                                           int64_t grace,
+                                           bool& needsRefresh,
+                                           HotCache::Idx hotIdx) {
   const StoreValue *sval;
   APCHandle *svar = nullptr;
-  SharedMutex::ReadHolder l(m_lock);
   bool expired = false;
   bool promoteObj = false;
   auto tag = tagStringData(keyStr.get());
@@ -657,6 +885,13 @@ bool ConcurrentTableSharedStore::get(const String& keyStr, Variant& value) {
         promoteObj = true;
       }
       value = sval->toLocal();
+      if (grace > 0 && sval->c_time != 0 && sval->expire != 0 &&
+          time(nullptr) >= int64_t(sval->expire) - grace) {
+        // Within the grace window: let exactly one caller claim the refresh.
+        uint8_t unclaimed = 0;
+        needsRefresh = sval->refreshClaimed.compare_exchange_strong(
+          unclaimed, 1, std::memory_order_relaxed);
+      }
       if (!promoteObj) {
         /*
          * Successful slow-case lookup => add value to cache (if key and kind
@@ -755,6 +990,7 @@ bool ConcurrentTableSharedStore::cas(const String& key, int64_t old,
 
 bool ConcurrentTableSharedStore::exists(const String& keyStr) {
   if (s_hotCache.hasValue(keyStr.get())) return true;
+  if (m_primedIndexed && s_primedIndex.hasValue(keyStr.get())) return true;
   const StoreValue *sval;
   SharedMutex::ReadHolder l(m_lock);
   bool expired = false;
@@ -851,11 +1087,29 @@ bool ConcurrentTableSharedStore::storeImpl(const String& key,
                                            int64_t ttl,
                                            bool overwrite,
                                            bool limit_ttl) {
+  bool stored;
+  {
+    SharedMutex::ReadHolder l(m_lock);
+    stored = storeLocked(key, value, ttl, overwrite, limit_ttl);
+  }
+  if (stored && apcExtension::ExpireOnSets) {
+    purgeExpired();
+  }
+
+  return stored;
+}
+
+/*
+ * The body of a store; the caller must hold m_lock in shared mode.
+ */
+bool ConcurrentTableSharedStore::storeLocked(const String& key,
+                                             const Variant& value,
+                                             int64_t ttl,
+                                             bool overwrite,
+                                             bool limit_ttl) {
   StoreValue *sval;
   auto keyLen = key.size();
   char* const kcp = strdup(key.data());
-  {
-  SharedMutex::ReadHolder l(m_lock);
   bool present;
   time_t expiry = 0;
   bool overwritePrime = false;
@@ -874,6 +1128,8 @@ bool ConcurrentTableSharedStore::storeImpl(const String& key,
        * 'get' will soon update the entry with the new value.
        */
       s_hotCache.clearValue(*sval);
+      // A primed key being overwritten drops out of the index for good.
+      if (m_primedIndexed) s_primedIndex.invalidate(acc->first);
       sval->data().match(
         [&] (APCHandle* handle) {
           current = handle;
@@ -918,20 +1174,31 @@ bool ConcurrentTableSharedStore::storeImpl(const String& key,
 
     sval->set(svar.handle, adjustedTtl);
     sval->dataSize = svar.size;
+    if (auto const keyStats = APCStats::getAPCStats().keyStats()) {
+      keyStats->recordStore(key.get(), svar.size, adjustedTtl);
+    }
     expiry = sval->expire;
     if (expiry) {
       auto ikey = intptr_t(acc->first);
       if (m_expMap.insert({ ikey, 0 })) {
-        m_expQueue.push({ ikey, expiry });
+        expQueueFor(ikey).push({ ikey, expiry });
       }
     }
   }
-  }  // m_lock
+
+  return true;
+}
+
+void ConcurrentTableSharedStore::setBulk(const Array& items, int64_t ttl) {
+  {
+    SharedMutex::ReadHolder l(m_lock);
+    for (ArrayIter iter(items); iter; ++iter) {
+      storeLocked(iter.first().toString(), iter.second(), ttl, true, true);
+    }
+  }
   if (apcExtension::ExpireOnSets) {
     purgeExpired();
   }
-
-  return true;
 }
 
 void ConcurrentTableSharedStore::prime(std::vector<KeyValuePair>&& vars) {
@@ -949,6 +1216,7 @@ void ConcurrentTableSharedStore::prime(std::vector<KeyValuePair>&& vars) {
 
       // We're going to overwrite what was there.
       auto& sval = acc->second;
+      if (m_primedIndexed) s_primedIndex.invalidate(acc->first);
       sval.data().match(
         [&] (APCHandle* handle) {
           handle->unreferenceRoot(sval.dataSize);
@@ -983,6 +1251,20 @@ bool ConcurrentTableSharedStore::constructPrime(const String& v,
     // StaticString for non-object should consume limited amount of space,
     // not worth going through the file storage
 
+    if (!serialized) {
+      // Construct the string as a fully-formed static StringData inside the
+      // file-backed mapping, so fetches bind pointers into the mapping with
+      // no copy and no unserialization step.  The string is immutable once
+      // the storage is sealed, and is never freed (the chunks live for the
+      // lifetime of the process).
+      if (auto const sd = s_apc_file_storage.putString(v.get()->slice())) {
+        auto const value = new APCTypedValue(APCTypedValue::StaticStr{}, sd);
+        item.value = value->getHandle();
+        item.sSize = sizeof(APCTypedValue);
+        return true;
+      }
+    }
+
     // TODO: currently we double serialize string for uniform handling later,
     // hopefully the unserialize won't be called often. We could further
     // optimize by storing more type info.
@@ -1028,13 +1310,28 @@ void ConcurrentTableSharedStore::primeDone() {
     s_apc_file_storage.seal();
     s_apc_file_storage.hashCheck();
   }
+  if (!m_primedIndexed) {
+    // Freeze the primed keyspace into the wait-free overlay (see
+    // PrimedKeyIndex above).  Entries still in serialized form keep a null
+    // slot for now; they are armed when first promoted in unserialize().
+    std::vector<std::pair<const char*, APCHandle*>> primed;
+    primed.reserve(m_vars.size());
+    for (Map::iterator iter = m_vars.begin(); iter != m_vars.end(); ++iter) {
+      // Only entries with c_time == 0 came from priming.
+      if (iter->second.c_time != 0) continue;
+      primed.emplace_back(iter->first, iter->second.data().left());
+    }
+    FTRACE(1, "Indexing {} primed keys\n", primed.size());
+    s_primedIndex.build(primed);
+    m_primedIndexed = true;
+  }
   // Schedule the adviseOut instead of doing it immediately, so that the
   // initial accesses to the primed keys are not too bad. Still, for
   // the keys in file, a deserialization from memory is required on first
   // access.
   ExpirationPair p(intptr_t(apcExtension::FileStorageFlagKey.c_str()),
                    time(nullptr) + apcExtension::FileStorageAdviseOutPeriod);
-  m_expQueue.push(p);
+  expQueueFor(p.first).push(p);
 
   for (auto iter = apcExtension::CompletionKeys.begin();
        iter != apcExtension::CompletionKeys.end(); ++iter) {
@@ -1076,6 +1373,76 @@ void ConcurrentTableSharedStore::adviseOut() {
   }
 }
 
+void ConcurrentTableSharedStore::exportSnapshot(SnapshotBuilder& snap) {
+  SharedMutex::WriteHolder l(m_lock);
+  for (Map::iterator iter = m_vars.begin(); iter != m_vars.end(); ++iter) {
+    auto& sval = iter->second;
+    if (sval.expired()) continue;
+    // The snapshot format has no expiration, so TTL'd entries are skipped.
+    if (sval.c_time != 0 && sval.expire != 0) continue;
+    KeyValuePair item;
+    item.key = iter->first;
+    item.readOnly = sval.readOnly;
+
+    if (auto const sAddr = sval.data().right()) {
+      // Still in serialized form (from priming); pass the bytes through
+      // untouched. The serialized-object tag travels in the sign of sSize.
+      // The bytes live in the file storage or a previous snapshot mapping,
+      // both of which are never deallocated, so the pointer stays valid
+      // after the lock is dropped.
+      item.sAddr = sAddr;
+      item.sSize = sval.dataSize;
+      if (sval.isSerializedObj()) {
+        snap.addObject(String{}, item);
+      } else {
+        snap.addString(String{}, item);
+      }
+      continue;
+    }
+
+    auto const handle = sval.data().left();
+    item.value = handle;
+    try {
+      switch (handle->kind()) {
+        case APCKind::Uninit:
+        case APCKind::Null:
+          snap.addNull(item);
+          break;
+        case APCKind::Bool:
+          if (handle->toLocal().toBoolean()) {
+            snap.addTrue(item);
+          } else {
+            snap.addFalse(item);
+          }
+          break;
+        case APCKind::Int:
+          snap.addInt(handle->toLocal().toInt64(), item);
+          break;
+        case APCKind::StaticString:
+        case APCKind::UncountedString:
+        case APCKind::SharedString:
+          snap.addString(handle->toLocal().toString(), item);
+          break;
+        case APCKind::SerializedObject:
+          // Already in the serialized format constructPrime() expects.
+          snap.addObject(APCString::fromHandle(handle)->toLocalString(),
+                         item);
+          break;
+        default: {
+          // Everything else round-trips through the standard serializer,
+          // matching what the loader does for kSnapOther entries.
+          auto const v = handle->toLocal();
+          snap.addOther(internal_serialize(v), item);
+          break;
+        }
+      }
+    } catch (const Exception& e) {
+      Logger::Warning("Skipping APC entry %s in snapshot: %s",
+                      iter->first, e.getMessage().c_str());
+    }
+  }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // debugging and info/stats support
 
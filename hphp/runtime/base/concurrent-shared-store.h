@@ -29,6 +29,7 @@
 #include <tbb/concurrent_priority_queue.h>
 
 #include "hphp/util/either.h"
+#include "hphp/util/hash.h"
 #include "hphp/util/smalllocks.h"
 
 #include "hphp/runtime/base/apc-handle.h"
@@ -42,6 +43,8 @@ namespace HPHP {
 
 //////////////////////////////////////////////////////////////////////
 
+struct SnapshotBuilder;
+
 /*
  * This is the in-APC representation of a value, in ConcurrentTableSharedStore.
  */
@@ -65,6 +68,8 @@ struct StoreValue {
   {
     hotIndex.store(o.hotIndex.load(std::memory_order_relaxed),
                    std::memory_order_relaxed);
+    refreshClaimed.store(o.refreshClaimed.load(std::memory_order_relaxed),
+                         std::memory_order_relaxed);
   }
 
   HandleOrSerial data() const {
@@ -129,7 +134,10 @@ struct StoreValue {
   mutable std::atomic<HotCacheIdx> hotIndex{kHotCacheUnknown};
   APCKind kind;  // Only valid if data is an APCHandle*.
   bool readOnly{false}; // Set for primed entries that will never change.
-  char padding[10];  // Make APCMap nodes cache-line sized (it static_asserts).
+  // Set once a getStale() caller has claimed the refresh of this entry;
+  // cleared when a new value is stored.  See getStale().
+  mutable std::atomic<uint8_t> refreshClaimed{0};
+  char padding[9];  // Make APCMap nodes cache-line sized (it static_asserts).
   uint32_t c_time{0}; // Creation time; 0 for primed values
   uint32_t mtime{0}; // Modification time
 };
@@ -225,6 +233,26 @@ struct ConcurrentTableSharedStore {
    */
   bool get(const String& key, Variant& value);
 
+  /*
+   * Like get(), but with a stale-while-revalidate grace window: if the value
+   * is present and within `grace' seconds of its expiration, it is still
+   * returned, and exactly one caller across all threads observes
+   * `needsRefresh' set to true until a new value is stored for the key.
+   * That caller is expected to recompute and store the value; everyone else
+   * keeps being served the stale one, so a hot key never produces a
+   * thundering herd of misses when its TTL runs out.
+   */
+  bool getStale(const String& key, Variant& value, int64_t grace,
+                bool& needsRefresh);
+
+  /*
+   * Look up many keys while acquiring the store's global lock only once.
+   * Returns a map from key to value holding only the keys that were present
+   * and unexpired; the caller is expected to have validated that every
+   * element of `keys' is a string.
+   */
+  Array getBulk(const Array& keys);
+
   /*
    * Add a value to the store if no (unexpired) value with this key is already
    * present.
@@ -245,6 +273,13 @@ struct ConcurrentTableSharedStore {
    */
   void set(const String& key, const Variant& val, int64_t ttl);
 
+  /*
+   * Set many key/value pairs while acquiring the store's global lock only
+   * once, with the same per-entry semantics as set().  The caller is
+   * expected to have validated that every key in `items' is a string.
+   */
+  void setBulk(const Array& items, int64_t ttl);
+
   /*
    * Set the value for `key' to `val', without any TTL, even if it wasn't
    * a primed key.
@@ -303,6 +338,14 @@ struct ConcurrentTableSharedStore {
   bool primeFromSnapshot(const char* filename);
   // Evict any file-backed APC values from OS page cache.
   void adviseOut();
+  /*
+   * Add the current keyspace to 'snap', in the format the priming pipeline
+   * produces, so the result can be loaded back with primeFromSnapshot() on
+   * the next startup. Entries with a TTL are skipped, as the snapshot
+   * format has no expiration. Holds the global lock exclusively for the
+   * whole walk, so this is as expensive as a full dump.
+   */
+  void exportSnapshot(SnapshotBuilder& snap);
 
   /*
    * Debugging.  Dump information about the table to an output stream.
@@ -403,7 +446,11 @@ private:
 
 private:
   bool eraseImpl(const char*, bool, int64_t, ExpMap::accessor* expAcc);
+  bool getImpl(const String&, Variant&, int64_t grace, bool& needsRefresh);
+  bool getLocked(const String&, Variant&, int64_t grace, bool& needsRefresh,
+                 StoreValue::HotCacheIdx hotIdx);
   bool storeImpl(const String&, const Variant&, int64_t, bool, bool);
+  bool storeLocked(const String&, const Variant&, int64_t, bool, bool);
   void purgeExpired();
   bool handlePromoteObj(const String&, APCHandle*, const Variant&);
   APCHandle* unserialize(const String&, StoreValue*);
@@ -414,8 +461,8 @@ private:
   Map m_vars;
   folly::SharedMutex m_lock;
   /*
-   * m_expQueue is a queue of keys to be expired. We purge items from
-   * it every n (configurable) apc_stores.
+   * m_expQueues holds the keys to be expired, sharded by key address.
+   * We purge items from one shard every n (configurable) apc_stores.
    *
    * We can't (easily) remove items from m_expQueue, so if we add a
    * new entry every time an item is updated we could end up with a
@@ -445,10 +492,33 @@ private:
    * the new key; but thats fine - if the key really has expired, it
    * will be purged, and if not, nothing will happen.
    */
-  tbb::concurrent_priority_queue<ExpirationPair,
-                                 ExpirationCompare> m_expQueue;
+  using ExpQueue = tbb::concurrent_priority_queue<ExpirationPair,
+                                                  ExpirationCompare>;
+
+  /*
+   * The expiration queue is sharded by key address so write-heavy
+   * traffic doesn't serialize on a single priority queue, and so each
+   * purge pass only ever drains one shard.  Must be a power of two.
+   */
+  static constexpr unsigned kNumExpQueues = 16;
+
+  ExpQueue& expQueueFor(intptr_t key) {
+    return m_expQueues[hash_int64(key) & (kNumExpQueues - 1)];
+  }
+
+  ExpQueue m_expQueues[kNumExpQueues];
   ExpMap m_expMap;
   std::atomic<uint64_t> m_purgeCounter{0};
+  std::atomic<uint64_t> m_nextExpQueue{0};
+
+  /*
+   * True once primeDone() has frozen this store's primed keys into the
+   * wait-free lookup overlay (see PrimedKeyIndex in the .cpp file).  The
+   * overlay is process-global, so stores that were never primed (e.g. the
+   * per-uid quarantined CLI stores) must leave it alone; every use site is
+   * gated on this flag.
+   */
+  bool m_primedIndexed{false};
 
   std::unique_ptr<SnapshotLoader> m_snapshotLoader;
 };
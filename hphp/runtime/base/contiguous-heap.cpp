@@ -0,0 +1,122 @@
+/*
+   +----------------------------------------------------------------------+
+   | HipHop for PHP                                                       |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 2010-present Facebook, Inc. (http://www.facebook.com)  |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 3.01 of the PHP license,      |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.php.net/license/3_01.txt                                  |
+   | If you did not receive a copy of the PHP license and are unable to   |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@php.net so we can mail you a copy immediately.               |
+   +----------------------------------------------------------------------+
+*/
+#include "hphp/runtime/base/memory-manager.h"
+#include "hphp/runtime/base/memory-manager-defs.h"
+#include "hphp/runtime/base/runtime-option.h"
+#include "hphp/util/trace.h"
+
+#include <folly/portability/SysMman.h>
+
+namespace HPHP {
+
+TRACE_SET_MOD(mm);
+
+namespace {
+// Region alignment; 1GB so the kernel can use PUD-level mappings when the
+// hardware and THP settings allow, and 2M slabs stay hugepage-aligned.
+constexpr size_t kRegionAlign = 1ull << 30;
+}
+
+void ContiguousHeap::threadInit() {
+  auto const reserve = RuntimeOption::EvalContiguousHeapReserveMb << 20;
+  if (!reserve) {
+    // Region disabled; behave exactly like SparseHeap, including slab pooling.
+    SparseHeap::threadInit();
+    return;
+  }
+  // Reserve address space with enough slack to trim to kRegionAlign; pages
+  // are committed lazily on first touch thanks to MAP_NORESERVE.
+  auto const padded = reserve + kRegionAlign;
+  auto const raw = mmap(nullptr, padded, PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+  if (raw == MAP_FAILED) {
+    SparseHeap::threadInit();
+    return;
+  }
+  auto const base = reinterpret_cast<char*>(
+    (uintptr_t(raw) + kRegionAlign - 1) & ~(kRegionAlign - 1)
+  );
+  if (base != raw) {
+    munmap(raw, base - static_cast<char*>(raw));
+  }
+  auto const tail = static_cast<char*>(raw) + padded - (base + reserve);
+  if (tail) {
+    munmap(base + reserve, tail);
+  }
+#ifdef MADV_HUGEPAGE
+  madvise(base, reserve, MADV_HUGEPAGE);
+#endif
+  m_base = m_front = base;
+  m_end = base + reserve;
+  TRACE(1, "heap-id %lu ContiguousHeap-init: base %p size %lu\n",
+        tl_heap_id, static_cast<void*>(base), reserve);
+}
+
+ContiguousHeap::~ContiguousHeap() {
+  reset();
+  if (m_base) {
+    munmap(m_base, m_end - m_base);
+    m_base = m_front = m_end = nullptr;
+  }
+}
+
+HeapObject* ContiguousHeap::allocSlab(MemoryUsageStats& stats) {
+  if (UNLIKELY(!m_base || m_front == m_end)) {
+    // No region, or it is exhausted; fall back to discrete slabs.
+    return SparseHeap::allocSlab(stats);
+  }
+  auto const slab = m_front;
+  m_front += kSlabSize;
+  m_bigs.insert(reinterpret_cast<HeapObject*>(slab), kSlabSize);
+  stats.mmap_volume += kSlabSize;
+  stats.mmap_cap += kSlabSize;
+  stats.peakCap = std::max(stats.peakCap, stats.capacity());
+  // Region slabs are carved in address order, so just extend the range.
+  if (!m_slab_range.size) {
+    m_slab_range = {slab, kSlabSize};
+  } else {
+    auto const min = std::min(m_slab_range.ptr, static_cast<void*>(slab));
+    auto const max = std::max(slab + kSlabSize,
+                              (char*)m_slab_range.ptr + m_slab_range.size);
+    m_slab_range = {min, size_t(max - static_cast<char*>(min))};
+  }
+  return reinterpret_cast<HeapObject*>(slab);
+}
+
+void ContiguousHeap::reset() {
+  TRACE(1, "heap-id %lu ContiguousHeap-reset: region_slabs %lu\n",
+        tl_heap_id, size_t(m_front - m_base) >> kLgSlabSize);
+  // Drop region-carved slabs from the tracking map before SparseHeap::reset()
+  // frees the remaining malloc'd blocks.
+  for (auto p = m_base; p < m_front; p += kSlabSize) {
+    m_bigs.erase(reinterpret_cast<HeapObject*>(p));
+  }
+  SparseHeap::reset();
+  if (m_base) {
+    // Return dirty pages to the kernel on the Purger's decay curve instead
+    // of unmapping; the reservation itself persists across requests.
+    m_purger.purge(m_base, m_front);
+    m_front = m_base;
+  }
+}
+
+void ContiguousHeap::flush() {
+  assertx(empty());
+  SparseHeap::flush();
+  if (m_base) m_purger.flush(m_base);
+}
+
+}
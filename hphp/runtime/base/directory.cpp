@@ -17,6 +17,7 @@
 #include "hphp/runtime/base/directory.h"
 
 #include "hphp/runtime/base/array-init.h"
+#include "hphp/runtime/base/comparisons.h"
 
 #include "hphp/runtime/ext/std/ext_std_file.h"
 #include "hphp/runtime/base/file.h"
@@ -59,6 +60,17 @@ Array Directory::getMetaData() {
 
 ///////////////////////////////////////////////////////////////////////////////
 
+int64_t Directory::readMany(int64_t limit, std::vector<String>& names) {
+  int64_t appended = 0;
+  while (limit < 0 || appended < limit) {
+    auto name = read();
+    if (same(name, false)) break;
+    names.push_back(name.toString());
+    ++appended;
+  }
+  return appended;
+}
+
 PlainDirectory::PlainDirectory(int fd) {
   m_dir = ::fdopendir(fd);
 }
@@ -88,6 +100,18 @@ Variant PlainDirectory::read() {
   return String(entry.d_name, CopyString);
 }
 
+int64_t PlainDirectory::readMany(int64_t limit, std::vector<String>& names) {
+  int64_t appended = 0;
+  struct dirent entry;
+  struct dirent *result;
+  while (limit < 0 || appended < limit) {
+    if (readdir_r(m_dir, &entry, &result) != 0 || !result) break;
+    names.emplace_back(entry.d_name, CopyString);
+    ++appended;
+  }
+  return appended;
+}
+
 void PlainDirectory::rewind() {
   ::rewinddir(m_dir);
 }
@@ -34,6 +34,11 @@ struct Variant;
 struct Directory : SweepableResourceData {
   virtual void close() = 0;
   virtual Variant read() = 0;
+  // Append up to `limit' entries (limit < 0 means all remaining) to
+  // `names' and return the number appended. The base implementation just
+  // loops read(); PlainDirectory overrides it to drain the directory
+  // without a virtual call and a Variant round-trip per entry.
+  virtual int64_t readMany(int64_t limit, std::vector<String>& names);
   virtual void rewind() = 0;
   virtual Array getMetaData();
   virtual bool isEof() const {
@@ -59,6 +64,7 @@ struct PlainDirectory : Directory {
 
   void close() override;
   Variant read() override;
+  int64_t readMany(int64_t limit, std::vector<String>& names) override;
   void rewind() override;
   bool isValid() const;
 
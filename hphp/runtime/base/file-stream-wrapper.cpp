@@ -19,6 +19,7 @@
 #include "hphp/runtime/base/runtime-error.h"
 #include "hphp/runtime/base/plain-file.h"
 #include "hphp/runtime/base/directory.h"
+#include "hphp/runtime/base/stat-cache.h"
 #include "hphp/runtime/server/static-content-cache.h"
 #include "hphp/runtime/base/file-util.h"
 #include "hphp/runtime/base/string-util.h"
@@ -87,6 +88,46 @@ FileStreamWrapper::open(const String& filename, const String& mode, int options,
   return file;
 }
 
+/*
+ * Whether wrapper-level stat and existence probes may be served from the
+ * process-wide StatCache.  Template engines can issue thousands of
+ * existence probes per request; on NFS-backed sandboxes each one is a
+ * network round trip unless it's answered from memory.  The cache picks
+ * up external modifications from inotify at request boundaries; the
+ * mutating operations below invalidate their own paths inline.
+ */
+static bool useStatCache() {
+  return RuntimeOption::ServerStatCache &&
+         RuntimeOption::ServerStatCacheForStreams;
+}
+
+int FileStreamWrapper::access(const String& path, int mode) {
+  auto const translated = File::TranslatePath(path);
+  // Only existence checks can be answered from the stat cache; permission
+  // checks depend on the caller's credentials.
+  if (mode == F_OK && useStatCache()) {
+    struct stat buf;
+    return StatCache::stat(translated.toCppString(), &buf);
+  }
+  return ::access(translated.data(), mode);
+}
+
+int FileStreamWrapper::stat(const String& path, struct stat* buf) {
+  auto const translated = File::TranslatePath(path);
+  if (useStatCache()) {
+    return StatCache::stat(translated.toCppString(), buf);
+  }
+  return ::stat(translated.data(), buf);
+}
+
+int FileStreamWrapper::lstat(const String& path, struct stat* buf) {
+  auto const translated = File::TranslatePath(path);
+  if (useStatCache()) {
+    return StatCache::lstat(translated.toCppString(), buf);
+  }
+  return ::lstat(translated.data(), buf);
+}
+
 req::ptr<Directory> FileStreamWrapper::opendir(const String& path) {
   auto tpath = File::TranslatePath(path);
   if (File::IsVirtualDirectory(tpath)) {
@@ -102,7 +143,8 @@ req::ptr<Directory> FileStreamWrapper::opendir(const String& path) {
 }
 
 int FileStreamWrapper::unlink(const String& path) {
-  int ret = ::unlink(File::TranslatePath(path).data());
+  auto const translated = File::TranslatePath(path);
+  int ret = ::unlink(translated.data());
   if (ret != 0) {
     raise_warning(
       "%s(%s): %s",
@@ -110,27 +152,49 @@ int FileStreamWrapper::unlink(const String& path) {
       path.c_str(),
       folly::errnoStr(errno).c_str()
     );
+  } else {
+    StatCache::invalidatePath(translated.toCppString());
   }
   return ret;
 }
 
 int FileStreamWrapper::rename(const String& oldname, const String& newname) {
+  auto const oldPath = File::TranslatePath(oldname);
+  auto const newPath = File::TranslatePath(newname);
   int ret =
     RuntimeOption::UseDirectCopy ?
-      FileUtil::directRename(File::TranslatePath(oldname).data(),
-                             File::TranslatePath(newname).data())
+      FileUtil::directRename(oldPath.data(), newPath.data())
                                  :
-      FileUtil::rename(File::TranslatePath(oldname).data(),
-                       File::TranslatePath(newname).data());
+      FileUtil::rename(oldPath.data(), newPath.data());
+  if (ret == 0) {
+    StatCache::invalidatePath(oldPath.toCppString());
+    StatCache::invalidatePath(newPath.toCppString());
+  }
   return ret;
 }
 
 int FileStreamWrapper::mkdir(const String& path, int mode, int options) {
   if (options & k_STREAM_MKDIR_RECURSIVE) {
     ERROR_RAISE_WARNING(mkdir_recursive(path, mode));
+    if (ret == 0) {
+      StatCache::invalidatePath(File::TranslatePath(path).toCppString());
+    }
     return ret;
   }
-  ERROR_RAISE_WARNING(::mkdir(File::TranslatePath(path).data(), mode));
+  auto const translated = File::TranslatePath(path);
+  ERROR_RAISE_WARNING(::mkdir(translated.data(), mode));
+  if (ret == 0) {
+    StatCache::invalidatePath(translated.toCppString());
+  }
+  return ret;
+}
+
+int FileStreamWrapper::rmdir(const String& path, int /*options*/) {
+  auto const translated = File::TranslatePath(path);
+  ERROR_RAISE_WARNING(::rmdir(translated.data()));
+  if (ret == 0) {
+    StatCache::invalidatePath(translated.toCppString());
+  }
   return ret;
 }
 
@@ -46,22 +46,13 @@ struct FileStreamWrapper final : Stream::Wrapper {
                                          const String& mode);
   req::ptr<File> open(const String& filename, const String& mode, int options,
                       const req::ptr<StreamContext>& context) override;
-  int access(const String& path, int mode) override {
-    return ::access(File::TranslatePath(path).data(), mode);
-  }
-  int stat(const String& path, struct stat* buf) override {
-    return ::stat(File::TranslatePath(path).data(), buf);
-  }
-  int lstat(const String& path, struct stat* buf) override {
-    return ::lstat(File::TranslatePath(path).data(), buf);
-  }
+  int access(const String& path, int mode) override;
+  int stat(const String& path, struct stat* buf) override;
+  int lstat(const String& path, struct stat* buf) override;
   int unlink(const String& path) override;
   int rename(const String& oldname, const String& newname) override;
   int mkdir(const String& path, int mode, int options) override;
-  int rmdir(const String& path, int /*options*/) override {
-    ERROR_RAISE_WARNING(::rmdir(File::TranslatePath(path).data()));
-    return ret;
-  }
+  int rmdir(const String& path, int options) override;
   bool isNormalFileStream() const override { return true; }
 
   req::ptr<Directory> opendir(const String& path) override;
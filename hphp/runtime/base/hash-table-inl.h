@@ -16,6 +16,10 @@
 
 #include "hphp/util/portability.h"
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 namespace HPHP {
 
 namespace array {
@@ -373,6 +377,39 @@ typename std::conditional<
   auto elms = data();
   auto hash = hashTab();
 
+#ifdef __SSE2__
+  // Small arrays: the whole hash vector is at most 16 int32 slots, so load
+  // it four slots per instruction and test the valid lanes directly instead
+  // of walking the probe sequence. Keys are unique, so visiting candidates
+  // out of probe order cannot change the result for read-only find types;
+  // inserts still need the probe-order empty slot and take the loop below.
+  if ((type == FindType::Lookup || type == FindType::Exists) && mask <= 15) {
+    static_assert(SmallHashSize == 4, "");
+    for (uint64_t off = 0; off <= mask; off += 4) {
+      auto const slots =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(hash + off));
+      // validPos() == non-negative; Empty/Tombstone have the sign bit set.
+      auto valid = ~_mm_movemask_ps(_mm_castsi128_ps(slots)) & 0xf;
+      while (valid) {
+        auto const i = __builtin_ctz(valid);
+        valid &= valid - 1;
+        auto const pos = hash[off + i];
+        assertx(validPos(pos) && pos < capacity());
+        if (hit(elms[pos])) {
+          return std::get<static_cast<int>(type)>(
+            std::make_tuple(int32_t(pos), true, Inserter(nullptr),
+                            Inserter(nullptr), int32_t(pos))
+          );
+        }
+      }
+    }
+    return std::get<static_cast<int>(type)>(
+      std::make_tuple(int32_t(Empty), false, Inserter(nullptr),
+                      Inserter(nullptr), int32_t(Empty))
+    );
+  }
+#endif
+
   for (uint64_t probe = (uint32_t)h0 & mask, i = 1;; ++i) {
     auto const ei = &hash[probe];
     int32_t pos = *ei;
@@ -238,6 +238,16 @@ public:
               UnsignedRefCount(count);
   }
 
+  // The complete 8-byte word that initHeader_16() would store, for code
+  // (e.g. the JIT's inline allocation path) that initializes a header
+  // with a single raw store.
+  static uint64_t buildHeader(HeaderKind kind, RefCount count,
+                              uint16_t aux16) {
+    return uint64_t(kind)  << (8 * offsetof(HeapObject, m_kind)) |
+           uint64_t(aux16) << (8 * offsetof(HeapObject, m_aux16)) |
+           UnsignedRefCount(count);
+  }
+
   static constexpr size_t kind_offset() {
     return offsetof(HeapObject, m_kind);
   }
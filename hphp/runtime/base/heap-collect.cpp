@@ -13,7 +13,6 @@
    | license@php.net so we can mail you a copy immediately.               |
    +----------------------------------------------------------------------+
 */
-#include "hphp/runtime/base/apc-gc-manager.h"
 #include "hphp/runtime/base/mixed-array-defs.h"
 #include "hphp/runtime/base/memory-manager-defs.h"
 #include "hphp/runtime/base/heap-scan.h"
@@ -39,6 +38,10 @@
 #include <iterator>
 #include <vector>
 
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
 namespace HPHP {
 TRACE_SET_MOD(gc);
 
@@ -88,36 +91,38 @@ constexpr auto MaxMark = GCBits(3);
  *
  * Experimental options
  *
- * Eval.GCForAPC - enable whole-process APC collection. See APCGCManager.
- * Eval.GCForAPCTrigger - trigger threshold; see APCGCManager.
- *
  * Eval.TwoPhaseGC - perform tracing in two phases, the second of which
  * must only encounter exactly-scanned pointers, to enable object copying.
+ *
+ * Eval.GCIncremental - amortize collection work across the request by
+ * triggering bounded collections at surprise-flag checkpoints after a
+ * fraction of the normal growth delta, instead of one large collection.
+ * Eval.GCIncrementalSlices - number of slices the growth delta is split
+ * into when GCIncremental is enabled.
  */
 
 /*
  * Collector state needed during a single whole-heap mark-sweep collection.
  */
 struct Collector {
-  explicit Collector(HeapImpl& heap, APCGCManager* apcgc, GCBits mark_version)
-    : heap_(heap), mark_version_{mark_version}, apcgc_(apcgc)
+  explicit Collector(HeapImpl& heap, GCBits mark_version)
+    : heap_(heap), mark_version_{mark_version}
   {}
-  template<bool apcgc> void collect();
+  void collect();
   void init();
   void sweep();
-  template<bool apcgc> void traceAll();
-  template<bool apcgc> void traceConservative();
-  template<bool apcgc> void traceExact();
+  void traceAll();
+  void traceConservative();
+  void traceExact();
 
   // mark ambiguous pointers in the range [start,start+len)
-  template<bool apcgc>
   void conservativeScan(const void* start, size_t len);
 
   bool marked(const HeapObject* h) {
     return h->marks() == mark_version_;
   }
-  template<bool apcgc> void checkedEnqueue(const void* p);
-  template<bool apcgc> void exactEnqueue(const void* p);
+  void checkedEnqueue(const void* p);
+  void exactEnqueue(const void* p);
   HeapObject* find(const void*);
 
   size_t slab_index(const void* h) {
@@ -140,7 +145,6 @@ struct Collector {
   boost::dynamic_bitset<> slab_map_; // 1 bit per 2M
   type_scan::Scanner type_scanner_;
   std::vector<const HeapObject*> cwork_, xwork_;
-  APCGCManager* const apcgc_;
 };
 
 HeapObject* Collector::find(const void* ptr) {
@@ -215,7 +219,6 @@ bool willScanConservative(const HeapObject* h) {
          );
 }
 
-template <bool apcgc>
 void Collector::checkedEnqueue(const void* p) {
   if (auto h = find(p)) {
     // enqueue h the first time. If it's an object with no pointers (eg String),
@@ -229,9 +232,6 @@ void Collector::checkedEnqueue(const void* p) {
       max_worklist_ = std::max(max_worklist_, cwork_.size() + xwork_.size());
       assertx(checkEnqueuedKind(h));
     }
-  } else if (apcgc) {
-    // If p doesn't belong to any APC data, APCGCManager won't do anything
-    apcgc_->mark(p);
   }
 }
 
@@ -245,7 +245,6 @@ void Collector::checkedEnqueue(const void* p) {
 // owns it, will scan it using the container's iterator api; OR
 // * p could be a stale pointer of any interesting type, that randomly
 // is pointing to recycled memory. ignoring it is actually desireable.
-template <bool apcgc>
 void Collector::exactEnqueue(const void* p) {
   if (auto h = find(p)) {
     auto old = h->marks();
@@ -256,23 +255,48 @@ void Collector::exactEnqueue(const void* p) {
       max_worklist_ = std::max(max_worklist_, xwork_.size());
       assertx(checkEnqueuedKind(h));
     }
-  } else if (apcgc) {
-    // If p doesn't belong to any APC data, APCGCManager won't do anything
-    apcgc_->mark(p);
   }
 }
 
 // mark ambigous pointers in the range [start,start+len). If the start or
 // end is a partial word, don't scan that word.
-template <bool apcgc>
 void FOLLY_DISABLE_ADDRESS_SANITIZER
 Collector::conservativeScan(const void* start, size_t len) {
   constexpr uintptr_t M{7}; // word size - 1
   auto s = (char**)((uintptr_t(start) + M) & ~M); // round up
   auto e = (char**)((uintptr_t(start) + len) & ~M); // round down
   cscanned_ += uintptr_t(e) - uintptr_t(s);
+#ifdef __AVX2__
+  // Vectorized prefilter: range-check four candidate words at a time against
+  // the bounds of all heap memory (slabs plus big objects) and only take the
+  // per-word path when at least one lane might be a heap pointer.
+  // Heap addresses fit in 48 bits, so after masking off the upper 16 bits
+  // (DiscriminatedPtr tags etc.) signed 64-bit comparison is safe.
+  {
+    auto lo = uintptr_t(slabs_range_.ptr);
+    auto hi = uintptr_t(slabs_range_.ptr) + slabs_range_.size;
+    auto const span = ptrs_.span();
+    if (span.second != 0) {
+      lo = std::min(lo, uintptr_t(span.first));
+      hi = std::max(hi, uintptr_t(span.first) + span.second);
+    }
+    auto const vtag = _mm256_set1_epi64x(-1ULL >> 16);
+    auto const vlo = _mm256_set1_epi64x(lo);
+    auto const vhi = _mm256_set1_epi64x(hi - 1);
+    for (; s + 4 <= e; s += 4) {
+      auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s));
+      v = _mm256_and_si256(v, vtag);
+      auto const out = _mm256_or_si256(_mm256_cmpgt_epi64(vlo, v),
+                                       _mm256_cmpgt_epi64(v, vhi));
+      if (LIKELY(_mm256_movemask_epi8(out) == -1)) continue;
+      for (size_t i = 0; i < 4; i++) {
+        checkedEnqueue((void*)(uintptr_t(s[i]) & (-1ULL >> 16)));
+      }
+    }
+  }
+#endif
   for (; s < e; s++) {
-    checkedEnqueue<apcgc>(
+    checkedEnqueue(
       // Mask off the upper 16-bits to handle things like
       // DiscriminatedPtr which stores things up there.
       (void*)(uintptr_t(*s) & (-1ULL >> 16))
@@ -352,24 +376,23 @@ NEVER_INLINE void Collector::init() {
 //    expect to have found all pointers to them. Any other objects allocated
 //    this way are treated similarly.
 
-template <bool apcgc> void Collector::collect() {
+void Collector::collect() {
   init();
   if (type_scan::hasNonConservative() && RuntimeOption::EvalTwoPhaseGC) {
-    traceConservative<apcgc>();
-    traceExact<apcgc>();
+    traceConservative();
+    traceExact();
   } else {
-    traceAll<apcgc>();
+    traceAll();
   }
   sweep();
 }
 
 // Phase 1: Scan only conservative or mixed conservative/exact roots, plus any
 // malloc'd heap objects that are themselves fully conservatively scanned.
-template <bool apcgc>
 NEVER_INLINE void Collector::traceConservative() {
   auto finish = [&] {
     for (auto r : type_scanner_.m_conservative) {
-      conservativeScan<apcgc>(r.first, r.second);
+      conservativeScan(r.first, r.second);
     }
     type_scanner_.m_conservative.clear();
     // Accumulate m_addrs until traceExact()
@@ -398,13 +421,12 @@ NEVER_INLINE void Collector::traceConservative() {
 // of the heap, which is expected to be fully exactly-scannable. Assert if
 // any conservatively-scanned regions are found in this phase. Any unmarked
 // objects found in this phase may be safely copied.
-template <bool apcgc>
 NEVER_INLINE void Collector::traceExact() {
   auto finish = [&] {
     assertx(cwork_.empty() && type_scanner_.m_conservative.empty());
     for (auto addr : type_scanner_.m_addrs) {
       xscanned_ += sizeof(*addr);
-      exactEnqueue<apcgc>(*addr);
+      exactEnqueue(*addr);
     }
     type_scanner_.m_addrs.clear();
     // Accumulate m_weak until sweep()
@@ -429,16 +451,15 @@ NEVER_INLINE void Collector::traceExact() {
 }
 
 // Scan all roots & heap in one pass
-template <bool apcgc>
 NEVER_INLINE void Collector::traceAll() {
   auto finish = [&] {
     for (auto r : type_scanner_.m_conservative) {
-      conservativeScan<apcgc>(r.first, r.second);
+      conservativeScan(r.first, r.second);
     }
     type_scanner_.m_conservative.clear();
     for (auto addr : type_scanner_.m_addrs) {
       xscanned_ += sizeof(*addr);
-      checkedEnqueue<apcgc>(*addr);
+      checkedEnqueue(*addr);
     }
     type_scanner_.m_addrs.clear();
     // Accumulate m_weak until sweep()
@@ -537,11 +558,6 @@ NEVER_INLINE void Collector::sweep() {
         }
       });
     });
-  if (apcgc_) {
-    // This should be removed after global GC API is provided
-    // Currently we do this to sweeping only when script mode
-    apcgc_->sweep();
-  }
 }
 
 thread_local bool t_eager_gc{false};
@@ -646,15 +662,7 @@ void collectImpl(HeapImpl& heap, const char* phase, GCBits& mark_version) {
   if (t_eager_gc && RuntimeOption::EvalFilterGCPoints) {
     t_eager_gc = false;
     auto pc = vmpc();
-    if (t_surprise_filter.test(pc)) {
-      if (RuntimeOption::EvalGCForAPC) {
-        if (!APCGCManager::getInstance().excessedGCTriggerBar()) {
-          return;
-        }
-      } else {
-        return;
-      }
-    }
+    if (t_surprise_filter.test(pc)) return;
     t_surprise_filter.insert(pc);
     TRACE(2, "eager gc %s at %p\n", phase, pc);
     phase = "eager";
@@ -667,16 +675,8 @@ void collectImpl(HeapImpl& heap, const char* phase, GCBits& mark_version) {
   t_pre_stats = tl_heap->getStatsCopy(); // don't check or trigger OOM
   mark_version = (mark_version == MaxMark) ? MinMark :
                  GCBits(uint8_t(mark_version) + 1);
-  Collector collector(
-    heap,
-    RuntimeOption::EvalGCForAPC ? &APCGCManager::getInstance() : nullptr,
-    mark_version
-  );
-  if (RuntimeOption::EvalGCForAPC) {
-    collector.collect<true>();
-  } else {
-    collector.collect<false>();
-  }
+  Collector collector(heap, mark_version);
+  collector.collect();
   if (Trace::moduleEnabledRelease(Trace::gc, 1)) {
     traceCollection(collector);
   }
@@ -742,6 +742,16 @@ void MemoryManager::updateNextGc() {
   int64_t delta = clearance > std::numeric_limits<int64_t>::max() ?
     0 : clearance * RuntimeOption::EvalGCTriggerPct;
   delta = std::max(delta, RuntimeOption::EvalGCMinTrigger);
+  if (RuntimeOption::EvalGCIncremental) {
+    // Incremental mode: instead of letting the heap grow by the full delta
+    // and paying for one large collection, arm the PendingGCFlag after a
+    // fraction of the growth so each pause covers a bounded slice of newly
+    // allocated memory. The per-slice floor keeps us from thrashing on
+    // tiny collections.
+    auto const slices =
+      std::max(RuntimeOption::EvalGCIncrementalSlices, 1u);
+    delta = std::max(delta / slices, RuntimeOption::EvalGCMinTrigger / slices);
+  }
   m_nextGC = stats.mmUsage() + delta;
   updateMMDebt();
 }
@@ -115,6 +115,128 @@ std::vector<int> makeParentTree(const HeapGraph& g) {
   return parents;
 }
 
+// Classic Lengauer-Tarjan with path compression, on the flow graph formed
+// by adding a virtual super-root (id == nodes.size()) with an edge to
+// every root node. O((V+E) log V); only node ids and sizes are touched.
+DominatorTree makeDominatorTree(const HeapGraph& g) {
+  auto const n = int(g.nodes.size());
+  auto const root = n; // virtual super-root
+
+  std::vector<int> dfnum(n + 1, -1), parent(n + 1, -1), vertex;
+  vertex.reserve(n + 1);
+
+  // Iterative DFS from the super-root, assigning dfs numbers and
+  // spanning-tree parents. The semi-dominator lemma needs a real dfs
+  // tree, so simulate recursion with resumable (node, next-ptr) frames
+  // rather than a plain discovery stack.
+  {
+    struct Frame { int node; int ptr; size_t rootIdx; };
+    std::vector<Frame> stack;
+    auto const discover = [&](int v, int p) {
+      dfnum[v] = vertex.size();
+      vertex.push_back(v);
+      parent[v] = p;
+    };
+    discover(root, -1);
+    stack.push_back(Frame{root, -1, 0});
+    while (!stack.empty()) {
+      auto& f = stack.back();
+      auto next = -1;
+      if (f.node == root) {
+        while (f.rootIdx < g.root_nodes.size()) {
+          auto const w = g.root_nodes[f.rootIdx++];
+          if (dfnum[w] == -1) { next = w; break; }
+        }
+      } else {
+        while (f.ptr != -1) {
+          auto const w = g.ptrs[f.ptr].to;
+          f.ptr = g.ptrs[f.ptr].next_out;
+          if (dfnum[w] == -1) { next = w; break; }
+        }
+      }
+      if (next == -1) {
+        stack.pop_back();
+        continue;
+      }
+      discover(next, f.node);
+      stack.push_back(Frame{next, g.nodes[next].first_out, 0});
+    }
+  }
+
+  std::vector<int> semi(dfnum), idom(n + 1, -1), ancestor(n + 1, -1),
+                   label(n + 1);
+  for (int v = 0; v <= n; ++v) label[v] = v;
+  std::vector<std::vector<int>> bucket(n + 1);
+
+  // EVAL with iterative path compression.
+  auto const eval = [&](int v) {
+    if (ancestor[v] == -1) return label[v];
+    std::vector<int> path;
+    auto u = v;
+    while (ancestor[ancestor[u]] != -1) {
+      path.push_back(u);
+      u = ancestor[u];
+    }
+    while (!path.empty()) {
+      auto const w = path.back();
+      path.pop_back();
+      if (semi[label[ancestor[w]]] < semi[label[w]]) {
+        label[w] = label[ancestor[w]];
+      }
+      ancestor[w] = ancestor[ancestor[w]];
+    }
+    return label[v];
+  };
+
+  for (auto i = int(vertex.size()) - 1; i >= 1; --i) {
+    auto const w = vertex[i];
+    g.eachPred(w, [&](const HeapGraph::Ptr& ptr) {
+      auto const v = ptr.from == -1 ? root : ptr.from;
+      if (dfnum[v] == -1) return; // unreachable predecessor
+      auto const u = eval(v);
+      if (semi[u] < semi[w]) semi[w] = semi[u];
+    });
+    if (g.nodes[w].is_root) {
+      // The virtual super-root edge is not in the in-ptr lists; account
+      // for it directly.
+      if (semi[root] < semi[w]) semi[w] = semi[root];
+    }
+    bucket[vertex[semi[w]]].push_back(w);
+    ancestor[w] = parent[w]; // LINK
+    for (auto v : bucket[parent[w]]) {
+      auto const u = eval(v);
+      idom[v] = semi[u] < semi[v] ? u : parent[w];
+    }
+    bucket[parent[w]].clear();
+  }
+  for (size_t i = 1; i < vertex.size(); ++i) {
+    auto const w = vertex[i];
+    if (idom[w] != vertex[semi[w]]) idom[w] = idom[idom[w]];
+  }
+
+  DominatorTree tree;
+  tree.idom.resize(n, -1);
+  for (int v = 0; v < n; ++v) {
+    tree.idom[v] = idom[v] == root ? -1 : idom[v];
+  }
+  vertex.erase(vertex.begin()); // drop the super-root
+  tree.order = std::move(vertex);
+  return tree;
+}
+
+std::vector<size_t> computeRetainedSizes(const HeapGraph& g,
+                                         const DominatorTree& tree) {
+  std::vector<size_t> retained(g.nodes.size(), 0);
+  for (auto v : tree.order) retained[v] = g.nodes[v].size;
+  // Dominators appear before dominatees in `order', so one reverse pass
+  // folds every subtree into its immediate dominator.
+  for (auto it = tree.order.rbegin(); it != tree.order.rend(); ++it) {
+    auto const d = tree.idom[*it];
+    if (d != -1) retained[d] += retained[*it];
+  }
+  return retained;
+}
+
 // parse the heap to find valid objects and initialize metadata, then
 // add edges for every known root pointer and every known obj->obj ptr.
 HeapGraph makeHeapGraph(bool include_free) {
@@ -121,6 +121,27 @@ void printHeapReport(const HeapGraph&, const char* phase);
 // why the node is reachable. parent[k] == -1 for unreachable nodes.
 std::vector<int> makeParentTree(const HeapGraph&);
 
+// Immediate-dominator tree of the reachable part of the graph, with a
+// virtual super-root above all root nodes so the multi-rooted heap
+// becomes a single-rooted flow graph. idom[k] == -1 means node k is
+// unreachable or dominated only by the root set; otherwise idom[k] is
+// the unique node every root-to-k path must pass through last.
+// `order' lists the reachable nodes with dominators before dominatees,
+// which is the order retained-size accumulation wants.
+// Only the graph structure is read, never the node pointers, so this is
+// safe to run on a captured graph after the heap has moved on.
+struct DominatorTree {
+  std::vector<int> idom;
+  std::vector<int> order;
+};
+DominatorTree makeDominatorTree(const HeapGraph&);
+
+// Fold each node's size up the dominator tree: retained[k] is the
+// number of bytes that would become unreachable if node k went away.
+// Unreachable nodes retain 0.
+std::vector<size_t> computeRetainedSizes(const HeapGraph&,
+                                         const DominatorTree&);
+
 // integrity check pointers and refcounts
 bool checkPointers(const HeapGraph& g, const char* phase);
 
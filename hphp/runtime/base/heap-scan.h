@@ -216,8 +216,16 @@ inline void c_Awaitable::scan(type_scan::Scanner& scanner) const {
 }
 
 inline void ObjectData::scan(type_scan::Scanner& scanner) const {
-  auto props = propVec();
-  scanner.scan(*props, m_cls->numDeclProperties() * sizeof(*props));
+  // Declared props are a plain TypedValue vector; walk them inline rather
+  // than dispatching through the generated scanner table, since plain
+  // objects with small prop counts dominate most heaps.
+  auto prop = propVec();
+  for (auto const end = prop + m_cls->numDeclProperties(); prop < end;
+       ++prop) {
+    if (isRefcountedType(prop->m_type)) {
+      scanner.m_addrs.emplace_back((const void**)&prop->m_data.pcnt);
+    }
+  }
   if (getAttribute(HasDynPropArr)) {
     // nb: dynamic property arrays are in ExecutionContext::dynPropTable,
     // which is not marked as a root. Scan the entry pair, so both the key
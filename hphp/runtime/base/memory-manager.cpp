@@ -19,6 +19,7 @@
 #include <cstdint>
 #include <limits>
 
+#include "hphp/runtime/base/alloc-site-profiler.h"
 #include "hphp/runtime/base/builtin-functions.h"
 #include "hphp/runtime/base/exceptions.h"
 #include "hphp/runtime/base/ini-setting.h"
@@ -35,6 +36,7 @@
 #include "hphp/util/logger.h"
 #include "hphp/util/process.h"
 #include "hphp/util/ptr-map.h"
+#include "hphp/util/service-data.h"
 #include "hphp/util/struct-log.h"
 #include "hphp/util/timer.h"
 #include "hphp/util/trace.h"
@@ -319,7 +321,12 @@ void MemoryManager::recordStats(StructuredLogEntry& entry) {
  */
 void MemoryManager::updateMMDebt() {
   auto const delta = static_cast<uint64_t>(m_nextGC) - m_stats.mmUsage();
-  auto const new_debt = delta > std::numeric_limits<int64_t>::max() ? 0 : delta;
+  auto new_debt = delta > std::numeric_limits<int64_t>::max() ? 0 : delta;
+  // Allocation-site sampling rides the same fast-path interruption as the
+  // GC trigger: capping the debt at the sampling interval makes the slow
+  // path run at least once per interval without touching the fast path.
+  auto const sample = RuntimeOption::EvalProfileAllocSampleBytes;
+  if (UNLIKELY(sample != 0) && new_debt > sample) new_debt = sample;
   m_stats.mm_uallocated += new_debt - m_stats.mm_udebt;
   m_stats.mm_udebt = new_debt;
 }
@@ -351,11 +358,25 @@ void MemoryManager::sweep() {
     }
   } while (!m_sweepables.empty());
 
+  // Drain trivial sweeps in one flat pass; Sweepable::sweep() above may have
+  // appended more, and entries unregistered mid-request have a null fn.
+  DEBUG_ONLY size_t num_trivial = 0;
+  for (size_t i = 0; i < m_trivial_sweeps.size(); ++i) {
+    auto const& entry = m_trivial_sweeps[i];
+    if (entry.fn) {
+      num_trivial++;
+      entry.fn(entry.data);
+    }
+  }
+  m_trivial_sweeps.clear();
+
   DEBUG_ONLY auto napcs = m_apc_arrays.size();
-  FTRACE(1, "heap-id {} sweep: sweepable {} native {} apc array {}\n",
+  FTRACE(1, "heap-id {} sweep: sweepable {} native {} trivial {} "
+         "apc array {}\n",
          tl_heap_id,
          num_sweepables,
          num_natives,
+         num_trivial,
          napcs);
 
   // decref apc arrays referenced by this request.  This must happen here
@@ -371,6 +392,31 @@ void MemoryManager::sweep() {
   if (debug) checkHeap("after MM::sweep");
 }
 
+void MemoryManager::setRequestTag(const std::string& tag) {
+  m_requestTag = tag;
+}
+
+void MemoryManager::publishRequestStats() {
+  auto const reset = [&] {
+    m_requestTag.clear();
+    m_slabAllocs = m_bigAllocs = 0;
+  };
+  if (m_requestTag.empty()) return reset();
+  auto const prefix = "mem.request." + m_requestTag;
+  static const std::vector<ServiceData::StatsType> exportTypes{
+    ServiceData::StatsType::AVG
+  };
+  ServiceData::createTimeSeries(prefix + ".peak-usage", exportTypes)
+    ->addValue(m_stats.peakUsage);
+  ServiceData::createTimeSeries(prefix + ".total-alloc", exportTypes)
+    ->addValue(m_stats.totalAlloc);
+  ServiceData::createTimeSeries(prefix + ".slabs", exportTypes)
+    ->addValue(m_slabAllocs);
+  ServiceData::createTimeSeries(prefix + ".bigs", exportTypes)
+    ->addValue(m_bigAllocs);
+  reset();
+}
+
 void MemoryManager::resetAllocator() {
   assertx(m_natives.empty() && m_sweepables.empty() && tl_sweeping);
   // decref apc strings referenced by this request
@@ -380,14 +426,16 @@ void MemoryManager::resetAllocator() {
   // free the heap
   m_heap.reset();
 
-  // zero out freelists
+  // zero out freelists and let refill magazines re-adapt to the next request
   for (auto& list : m_freelists) list.head = nullptr;
+  m_magShift.fill(0);
   m_front = m_limit = 0;
   tl_sweeping = false;
   m_exiting = false;
   if (StructuredLog::coinflip(RuntimeOption::TotalAllocSampleF)) {
     publishStats("total", totalSmallAllocs, RuntimeOption::TotalAllocSampleF);
   }
+  publishRequestStats();
   resetAllStats();
   setGCEnabled(RuntimeOption::EvalEnableGC);
   resetGC();
@@ -749,6 +797,7 @@ void splitTail(FreelistArray& freelists, void* tail, size_t tailBytes,
  */
 NEVER_INLINE void* MemoryManager::newSlab(size_t nbytes) {
   refreshStats();
+  ++m_slabAllocs;
   if (m_front < m_limit) {
     storeTail(m_freelists, m_front, (char*)m_limit - (char*)m_front,
               Slab::fromPtr(m_front));
@@ -805,7 +854,9 @@ inline void* MemoryManager::slabAlloc(size_t nbytes, size_t index) {
     slab = Slab::fromPtr(ptr);
   }
   // Preallocate more of the same in order to amortize entry into this method.
-  auto split_bytes = kContigTab[index] - nbytes;
+  // The batch grows geometrically (see m_magShift) for size classes that keep
+  // exhausting their freelist within this request.
+  auto split_bytes = (kContigTab[index] << m_magShift[index]) - nbytes;
   auto avail = uintptr_t(m_limit) - uintptr_t(m_front);
   if (UNLIKELY(split_bytes > avail)) {
     split_bytes = avail - avail % nbytes; // Expensive division.
@@ -822,6 +873,9 @@ inline void* MemoryManager::slabAlloc(size_t nbytes, size_t index) {
 
 NEVER_INLINE
 void* MemoryManager::mallocSmallIndexSlow(size_t bytes, size_t index) {
+  if (UNLIKELY(RuntimeOption::EvalProfileAllocSampleBytes != 0)) {
+    AllocSiteProfiler::logSample(RuntimeOption::EvalProfileAllocSampleBytes);
+  }
   checkGC();
   updateMMDebt();
   return mallocSmallIndexTail(bytes, index);
@@ -830,6 +884,11 @@ void* MemoryManager::mallocSmallIndexSlow(size_t bytes, size_t index) {
 void* MemoryManager::mallocSmallSizeSlow(size_t nbytes, size_t index) {
   assertx(nbytes == sizeIndex2Size(index));
   assertx(!m_freelists[index].head); // freelist[index] is empty
+  // This size class just ran dry; widen its refill magazine so the next
+  // batch carved from a slab is larger.
+  if (m_magShift[index] < RuntimeOption::EvalSmallAllocMagazineMaxShift) {
+    ++m_magShift[index];
+  }
   size_t contigInd = kContigIndexTab[index];
   for (auto i = contigInd; i < kNumSmallSizes; ++i) {
     FTRACE(4, "MemoryManager::mallocSmallSizeSlow({}, {}): contigMin={}, "
@@ -843,8 +902,11 @@ void* MemoryManager::mallocSmallSizeSlow(size_t nbytes, size_t index) {
                 nbytes, index, kContigTab[index], contigInd, i,
                 sizeIndex2Size(i), p);
       // Split tail into preallocations and store them back into freelists.
-      splitTail(m_freelists, (char*)p + nbytes, sizeIndex2Size(i) - nbytes,
-                kContigTab[index] - nbytes, nbytes, index, Slab::fromPtr(p));
+      auto const tail_bytes = sizeIndex2Size(i) - nbytes;
+      auto const mag_bytes = (kContigTab[index] << m_magShift[index]) - nbytes;
+      splitTail(m_freelists, (char*)p + nbytes, tail_bytes,
+                std::min(mag_bytes, tail_bytes - tail_bytes % nbytes),
+                nbytes, index, Slab::fromPtr(p));
       return p;
     }
   }
@@ -865,6 +927,7 @@ inline void MemoryManager::updateBigStats() {
 NEVER_INLINE
 void* MemoryManager::mallocBigSize(size_t bytes, bool zero) {
   if (debug) tl_heap->requestEagerGC();
+  ++m_bigAllocs;
   auto ptr = m_heap.allocBig(bytes, zero, m_stats);
   updateBigStats();
   checkGC();
@@ -1028,6 +1091,20 @@ void MemoryManager::removeNativeObject(NativeNode* node) {
   last->sweep_index = index;
 }
 
+uint32_t MemoryManager::registerTrivialSweep(void* data, TrivialSweepFn fn) {
+  assertx(fn);
+  m_trivial_sweeps.push_back({data, fn});
+  return m_trivial_sweeps.size() - 1;
+}
+
+void MemoryManager::unregisterTrivialSweep(uint32_t index) {
+  assertx(index < m_trivial_sweeps.size());
+  assertx(m_trivial_sweeps[index].fn);
+  // Indices are handed out to callers, so invalidate in place rather than
+  // swapping with the back the way m_natives does.
+  m_trivial_sweeps[index].fn = nullptr;
+}
+
 void MemoryManager::addApcArray(APCLocalArray* a) {
   a->m_sweep_index = m_apc_arrays.size();
   m_apc_arrays.push_back(a);
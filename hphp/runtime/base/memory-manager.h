@@ -39,6 +39,7 @@
 #include "hphp/runtime/base/runtime-option.h"
 #include "hphp/runtime/base/sweepable.h"
 #include "hphp/runtime/base/header-kind.h"
+#include "hphp/runtime/base/purger.h"
 #include "hphp/runtime/base/req-malloc.h"
 #include "hphp/runtime/base/req-ptr.h"
 #include "hphp/runtime/base/slab-manager.h"
@@ -554,7 +555,37 @@ struct SparseHeap {
   SlabManager* m_slabManager{nullptr};
 };
 
+/*
+ * Heap that carves slabs sequentially from one large reserved region per
+ * thread, so request heaps stay dense enough for the kernel to back them
+ * with huge pages. At reset() the dirty pages are handed back with
+ * madvise(MADV_DONTNEED) via Purger, rather than unmapped, so repeated
+ * requests reuse the same (already TLB-warm) mapping. Big blocks and any
+ * slabs past the reservation are delegated to SparseHeap.
+ *
+ * Selected as HeapImpl by building with -DHHVM_CONTIGUOUS_HEAP.
+ */
+struct ContiguousHeap : SparseHeap {
+  ~ContiguousHeap();
+
+  HeapObject* allocSlab(MemoryUsageStats& stats);
+
+  void threadInit();
+  void reset();
+  void flush();
+
+ private:
+  char* m_base{nullptr};   // 1GB-aligned start of the reserved region
+  char* m_front{nullptr};  // next slab to carve
+  char* m_end{nullptr};    // end of the reserved region
+  Purger m_purger;
+};
+
+#ifdef HHVM_CONTIGUOUS_HEAP
+using HeapImpl = ContiguousHeap;
+#else
 using HeapImpl = SparseHeap;
+#endif
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -866,6 +897,19 @@ struct MemoryManager {
   void addApcArray(APCLocalArray*);
   void removeApcArray(APCLocalArray*);
   void addSweepable(Sweepable*);
+
+  /*
+   * Registration for trivial sweeps: cleanup that is just "call fn(data)"
+   * with no ordering or re-registration concerns. Entries are drained in one
+   * flat pass at the end of sweep(), with no list unlinking or virtual
+   * dispatch, so objects whose teardown merely frees a malloc'd block should
+   * prefer this over deriving from Sweepable. registerTrivialSweep() returns
+   * an index to pass to unregisterTrivialSweep() if cleanup happens early
+   * (e.g. in a destructor that runs mid-request).
+   */
+  using TrivialSweepFn = void (*)(void*);
+  uint32_t registerTrivialSweep(void* data, TrivialSweepFn fn);
+  void unregisterTrivialSweep(uint32_t index);
   template<class Fn> void sweepApcArrays(Fn fn);
   template<class Fn> void sweepApcStrings(Fn fn);
 
@@ -944,6 +988,21 @@ struct MemoryManager {
   };
   using FreelistArray = std::array<FreeList,kNumSmallSizes>;
 
+  /*
+   * Offsets into the MemoryManager of the allocation-debt counter and of
+   * a size class's freelist head, for the JIT's inline allocation path
+   * (see cgNewInstanceRaw).
+   */
+  static ptrdiff_t debtOffset() {
+    return offsetof(MemoryManager, m_stats) +
+           offsetof(MemoryUsageStats, mm_udebt);
+  }
+  static ptrdiff_t freelistHeadOffset(size_t index) {
+    assertx(index < kNumSmallSizes);
+    return offsetof(MemoryManager, m_freelists) +
+           index * sizeof(FreeList) + offsetof(FreeList, head);
+  }
+
   /*
    * beginQuarantine() swaps out the normal freelists. endQuarantine()
    * fills everything freed with holes, then restores the original freelists.
@@ -984,6 +1043,16 @@ private:
   void publishStats(const char* name, const std::vector<int64_t> &stats,
       uint32_t sampleRate);
 
+  /*
+   * Tag the current request (e.g. with a normalized endpoint name) so its
+   * end-of-request allocation stats are exported as ServiceData time series
+   * keyed "mem.request.<tag>.*": peak usage, total allocation volume, slab
+   * count and big-alloc count. An empty tag (the default) disables the
+   * export; the tag is cleared when the request resets. Callers own tag
+   * cardinality -- use a bounded set of endpoint names, not raw URLs.
+   */
+  void setRequestTag(const std::string& tag);
+
   /////////////////////////////////////////////////////////////////////////////
 
 private:
@@ -1008,6 +1077,7 @@ private:
   void requestEagerGC();
   void resetEagerGC();
   void checkGC();
+  void publishRequestStats();
 
   /////////////////////////////////////////////////////////////////////////////
 
@@ -1019,6 +1089,12 @@ private:
   void* m_front{nullptr};
   void* m_limit{nullptr};
   FreelistArray m_freelists;
+  // Per-size-class magazine shift: each time a size class's freelist runs
+  // dry within a request, the contiguous batch carved for it by slabAlloc()
+  // doubles (bounded by EvalSmallAllocMagazineMaxShift), so allocation-heavy
+  // classes refill in bulk instead of re-entering the slow path once per
+  // kContigTab-sized batch. Reset at the end of each request.
+  std::array<uint8_t,kNumSmallSizes> m_magShift{};
   StringDataNode m_strings; // in-place node is head of circular list
   std::vector<APCLocalArray*> m_apc_arrays;
   int64_t m_nextGC{kNoNextGC}; // request gc when heap usage reaches this size
@@ -1027,6 +1103,11 @@ private:
   HeapImpl m_heap;
   std::vector<NativeNode*> m_natives;
   SweepableList m_sweepables;
+  struct TrivialSweep {
+    void* data;
+    TrivialSweepFn fn; // nullptr when unregistered
+  };
+  std::vector<TrivialSweep> m_trivial_sweeps;
 
   mutable std::vector<req::root_handle*> m_root_handles;
 
@@ -1038,6 +1119,12 @@ private:
   bool m_enableStatsSync{false};
   GCBits m_mark_version{GCBits(0)};
 
+  // per-request tag and counters for the ServiceData export; see
+  // setRequestTag().
+  std::string m_requestTag;
+  uint64_t m_slabAllocs{0};
+  uint64_t m_bigAllocs{0};
+
   ReqProfContext m_profctx;
   static std::atomic<ReqProfContext*> s_trigger;
 
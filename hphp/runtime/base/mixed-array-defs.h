@@ -38,8 +38,18 @@ namespace HPHP {
 
 inline void MixedArray::scan(type_scan::Scanner& scanner) const {
   if (isZombie()) return;
-  auto data = this->data();
-  scanner.scan(*data, m_used * sizeof(*data));
+  // Walk the Elms inline (mirroring Elm's TYPE_SCAN_CUSTOM body) rather than
+  // dispatching through the generated scanner table; mixed arrays are one of
+  // the hottest layouts during marking.
+  auto elm = data();
+  for (auto const end = elm + m_used; elm < end; ++elm) {
+    if (elm->hasStrKey()) {
+      scanner.m_addrs.emplace_back((const void**)&elm->skey);
+    }
+    if (isRefcountedType(elm->data.m_type)) {
+      scanner.m_addrs.emplace_back((const void**)&elm->data.m_data.pcnt);
+    }
+  }
 }
 
 ALWAYS_INLINE
@@ -105,6 +115,17 @@ void MixedArray::getArrayElm(ssize_t pos, TypedValue* valOut) const {
   cellDup(*cur, *valOut);
 }
 
+ALWAYS_INLINE
+void MixedArray::prefetchArrayElm(ssize_t pos) const {
+  // Iteration walks the Elm vector linearly, and at 24 bytes per Elm the
+  // next element often starts in a cache line the current read didn't touch.
+  // Pull it in while the caller copies out the current value so foreach
+  // keeps streaming instead of stalling on every other element.
+  if (size_t(pos) < m_used) {
+    __builtin_prefetch(data() + pos, 0, 2); // HINT_T1 on x64
+  }
+}
+
 ALWAYS_INLINE
 const TypedValue* MixedArray::getArrayElmPtr(ssize_t pos) const {
   assertx(validPos(pos));
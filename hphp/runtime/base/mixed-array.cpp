@@ -43,10 +43,15 @@
 #include "hphp/util/trace.h"
 
 #include <folly/CPortability.h>
+#include <folly/Hash.h>
+#include <folly/SharedMutex.h>
 #include <folly/portability/Constexpr.h>
 
 #include <algorithm>
+#include <memory>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "hphp/runtime/base/mixed-array-defs.h"
 #include "hphp/runtime/base/packed-array-defs.h"
@@ -219,6 +224,77 @@ ArrayData* MixedArray::MakeReserveLike(const ArrayData* other,
 }
 
 ALWAYS_INLINE
+namespace {
+
+/*
+ * Shared layout descriptors for struct-like arrays.  MakeStructImpl is
+ * reached from NewStructArray-style sites with the same static-string key
+ * set on every execution, so the position table it builds by probing is
+ * identical every time.  Cache one immutable descriptor per key set and
+ * stamp its precomputed table over the fresh array on a hit, turning the
+ * per-key findForNewInsert probe loop into constant-offset stores.  The
+ * cache is insert-only and bounded; descriptors are small (the position
+ * table plus a copy of the key pointers) and live for the process.
+ */
+struct StructLayout {
+  uint32_t size;
+  uint32_t scale;
+  std::unique_ptr<const StringData*[]> keys;
+  std::unique_ptr<int32_t[]> table;
+};
+
+folly::SharedMutex s_structLayoutLock;
+std::unordered_map<uint64_t,
+                   std::vector<std::unique_ptr<StructLayout>>> s_structLayouts;
+constexpr size_t kMaxStructLayouts = 1 << 16;
+size_t s_numStructLayouts = 0;  // guarded by s_structLayoutLock
+
+uint64_t hashKeySet(uint32_t size, const StringData* const* keys) {
+  // Static strings have stable addresses, so the pointers identify the set.
+  return folly::hash::hash_range(keys, keys + size, uint64_t{size});
+}
+
+bool sameKeySet(const StructLayout& l, uint32_t size,
+                const StringData* const* keys) {
+  return l.size == size &&
+         !memcmp(l.keys.get(), keys, size * sizeof(StringData*));
+}
+
+const StructLayout* lookupStructLayout(uint64_t h, uint32_t size,
+                                       const StringData* const* keys) {
+  folly::SharedMutex::ReadHolder guard{s_structLayoutLock};
+  auto const it = s_structLayouts.find(h);
+  if (it == s_structLayouts.end()) return nullptr;
+  for (auto const& l : it->second) {
+    if (sameKeySet(*l, size, keys)) return l.get();
+  }
+  return nullptr;
+}
+
+void insertStructLayout(uint64_t h, uint32_t size,
+                        const StringData* const* keys,
+                        uint32_t scale, const int32_t* table) {
+  auto const tableSize = MixedArray::HashSize(scale);
+  auto layout = std::make_unique<StructLayout>();
+  layout->size = size;
+  layout->scale = scale;
+  layout->keys = std::make_unique<const StringData*[]>(size);
+  memcpy(layout->keys.get(), keys, size * sizeof(StringData*));
+  layout->table = std::make_unique<int32_t[]>(tableSize);
+  memcpy(layout->table.get(), table, tableSize * sizeof(int32_t));
+
+  folly::SharedMutex::WriteHolder guard{s_structLayoutLock};
+  if (s_numStructLayouts >= kMaxStructLayouts) return;
+  auto& layouts = s_structLayouts[h];
+  for (auto const& l : layouts) {
+    if (sameKeySet(*l, size, keys)) return;
+  }
+  layouts.emplace_back(std::move(layout));
+  ++s_numStructLayouts;
+}
+
+}
+
 MixedArray* MixedArray::MakeStructImpl(uint32_t size,
                                        const StringData* const* keys,
                                        const TypedValue* values,
@@ -247,16 +323,33 @@ MixedArray* MixedArray::MakeStructImpl(uint32_t size,
   // Append values by moving -- Caller assumes we update refcount.
   // Values are in reverse order since they come from the stack, which
   // grows down.
-  for (uint32_t i = 0; i < size; i++) {
-    assertx(keys[i]->isStatic());
-    auto k = keys[i];
-    auto h = k->hash();
-    data[i].setStaticKey(const_cast<StringData*>(k), h);
-    const auto& tv = values[size - i - 1];
-    data[i].data.m_data = tv.m_data;
-    data[i].data.m_type = tv.m_type;
-    auto ei = ad->findForNewInsert(table, mask, h);
-    *ei = i;
+  auto const kh = hashKeySet(size, keys);
+  if (auto const layout = lookupStructLayout(kh, size, keys)) {
+    // Same key set as a previous struct: reuse its position table and
+    // skip the probing entirely.
+    assertx(layout->scale == scale);
+    memcpy(table, layout->table.get(), HashSize(scale) * sizeof(int32_t));
+    for (uint32_t i = 0; i < size; i++) {
+      assertx(keys[i]->isStatic());
+      auto k = keys[i];
+      data[i].setStaticKey(const_cast<StringData*>(k), k->hash());
+      const auto& tv = values[size - i - 1];
+      data[i].data.m_data = tv.m_data;
+      data[i].data.m_type = tv.m_type;
+    }
+  } else {
+    for (uint32_t i = 0; i < size; i++) {
+      assertx(keys[i]->isStatic());
+      auto k = keys[i];
+      auto h = k->hash();
+      data[i].setStaticKey(const_cast<StringData*>(k), h);
+      const auto& tv = values[size - i - 1];
+      data[i].data.m_data = tv.m_data;
+      data[i].data.m_type = tv.m_type;
+      auto ei = ad->findForNewInsert(table, mask, h);
+      *ei = i;
+    }
+    insertStructLayout(kh, size, keys, scale, table);
   }
 
   assertx(ad->m_size == size);
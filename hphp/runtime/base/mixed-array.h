@@ -390,9 +390,6 @@ public:
   static void Renumber(ArrayData*);
   static void OnSetEvalScalar(ArrayData*);
   static void Release(ArrayData*);
-  // Recursively register {allocation, rootAPCHandle} with APCGCManager
-  static void RegisterUncountedAllocations(ArrayData* ad,
-                                           APCHandle* rootAPCHandle);
   static void ReleaseUncounted(ArrayData*);
   static constexpr auto ValidMArrayIter = &ArrayCommon::ValidMArrayIter;
   static bool AdvanceMArrayIter(ArrayData*, MArrayIter& fp);
@@ -629,6 +626,10 @@ public:
   void dupArrayElmWithRef(ssize_t pos, TypedValue* valOut,
     TypedValue* keyOut) const;
 
+  // Issue a prefetch for the Elm at the given pos, if it's in range.  Used
+  // by the iteration helpers to hide the latency of walking the Elm vector.
+  void prefetchArrayElm(ssize_t pos) const;
+
   const TypedValue* getArrayElmPtr(ssize_t pos) const;
   TypedValue getArrayElmKey(ssize_t pos) const;
 
@@ -165,7 +165,8 @@ struct ObjectData : Countable, type_scan::MarkCollectable<ObjectData> {
     return sizeof(m_aux16);
   }
 
- private:
+  // Public so the JIT's inline allocation path can assign o_id with the
+  // same ++os_max_id the constructors use (see cgNewInstanceRaw).
   static __thread uint32_t os_max_id;
 
  public:
@@ -556,6 +557,9 @@ struct ObjectData : Countable, type_scan::MarkCollectable<ObjectData> {
   static constexpr ptrdiff_t getVMClassOffset() {
     return offsetof(ObjectData, m_cls);
   }
+  static constexpr ptrdiff_t getIdOffset() {
+    return offsetof(ObjectData, o_id);
+  }
   const char* classname_cstr() const;
 
 private:
@@ -124,8 +124,15 @@ uint8_t PackedArray::sizeClass(const ArrayData* ad) {
 
 inline void PackedArray::scan(const ArrayData* a, type_scan::Scanner& scanner) {
   assertx(checkInvariants(a));
-  auto data = packedData(a);
-  scanner.scan(*data, a->getSize() * sizeof(*data));
+  // Walk the TypedValues inline rather than dispatching through the generated
+  // scanner table; packed arrays are one of the hottest layouts during
+  // marking.
+  auto elm = packedData(a);
+  for (auto const end = elm + a->getSize(); elm < end; ++elm) {
+    if (isRefcountedType(elm->m_type)) {
+      scanner.m_addrs.emplace_back((const void**)&elm->m_data.pcnt);
+    }
+  }
 }
 
 template <class F, bool inc>
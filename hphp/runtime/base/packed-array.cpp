@@ -370,6 +370,47 @@ ArrayData* PackedArray::Copy(const ArrayData* adIn) {
   return ad;
 }
 
+ArrayData* PackedArray::Slice(const ArrayData* adIn, uint32_t offset,
+                              uint32_t len) {
+  assertx(checkInvariants(adIn));
+  assertx(offset <= adIn->m_size);
+  assertx(len > 0 && len <= adIn->m_size - offset);
+
+  auto const sizeIndex = capacityToSizeIndex(len);
+  auto ad = static_cast<ArrayData*>(tl_heap->objMallocIndex(sizeIndex));
+  ad->initHeader_16(
+    HeaderKind::Packed,
+    OneReference,
+    packSizeIndexAndAuxBits(sizeIndex, 0)
+  );
+  ad->m_sizeAndPos = len; // pos=0
+
+  // Bulk-copy the range, then fix up refcounts; see CopyPackedHelper.
+  auto const dst = packedData(ad);
+  memcpy16_inline(dst, packedData(adIn) + offset,
+                  size_t(len) * sizeof(TypedValue));
+  for (auto elm = dst, end = dst + len; elm < end; ++elm) {
+    if (UNLIKELY(isRefType(elm->m_type))) {
+      assertx(!adIn->isVecArray());
+      auto ref = elm->m_data.pref;
+      // See also tvDupWithRef()
+      if (!ref->isReferenced() && ref->cell()->m_data.parr != adIn) {
+        cellDup(*ref->cell(), *elm);
+        continue;
+      }
+    }
+    tvIncRefGen(*elm);
+  }
+
+  assertx(ad->kind() == kPackedKind);
+  assertx(ad->isNotDVArray());
+  assertx(ad->m_size == len);
+  assertx(ad->m_pos == 0);
+  assertx(ad->hasExactlyOneRef());
+  assertx(checkInvariants(ad));
+  return ad;
+}
+
 ArrayData* PackedArray::CopyStatic(const ArrayData* adIn) {
   assertx(checkInvariants(adIn));
 
@@ -1164,6 +1205,43 @@ ArrayData* PackedArray::Append(ArrayData* adIn, Cell v, bool copy) {
   return ad;
 }
 
+ArrayData* PackedArray::AppendN(ArrayData* adIn, const Cell* vals, uint32_t n,
+                                bool copy) {
+  assertx(checkInvariants(adIn));
+  if (n == 0) return adIn;
+  if (debug) {
+    for (uint32_t i = 0; i < n; ++i) {
+      assertx(vals[i].m_type != KindOfUninit);
+    }
+  }
+  auto ad = adIn;
+  auto copying = copy;
+  while (n > 0) {
+    if (ad->m_size == capacity(ad)) {
+      ad = Grow(ad, copying);
+      if (UNLIKELY(!ad)) return nullptr;
+      copying = false;
+    } else if (copying) {
+      ad = Copy(ad);
+      copying = false;
+    }
+    auto const chunk = std::min(n, capacity(ad) - ad->m_size);
+    auto const data = packedData(ad) + ad->m_size;
+    // Bulk-copy the cells, then bump refcounts in a second pass; for
+    // homogeneous non-refcounted spans the second loop is branch-predicted
+    // away entirely.
+    memcpy(data, vals, chunk * sizeof(Cell));
+    for (uint32_t i = 0; i < chunk; ++i) {
+      tvIncRefGen(data[i]);
+    }
+    ad->m_size += chunk;
+    vals += chunk;
+    n -= chunk;
+  }
+  assertx(checkInvariants(ad));
+  return ad;
+}
+
 ArrayData* PackedArray::AppendRef(ArrayData* adIn, tv_lval v, bool copy) {
   assertx(checkInvariants(adIn));
   assertx(adIn->isPacked());
@@ -64,9 +64,6 @@ struct PackedArray final : type_scan::MarkCollectable<PackedArray> {
                 "Size index must fit into 8-bits");
 
   static void Release(ArrayData*);
-  // Recursively register {allocation, rootAPCHandle} with APCGCManager
-  static void RegisterUncountedAllocations(ArrayData* ad,
-                                           APCHandle* rootAPCHandle);
   static void ReleaseUncounted(ArrayData*);
   static tv_rval NvGetInt(const ArrayData*, int64_t ki);
   static constexpr auto NvTryGetInt = &NvGetInt;
@@ -131,6 +128,12 @@ struct PackedArray final : type_scan::MarkCollectable<PackedArray> {
   static bool AdvanceMArrayIter(ArrayData*, MArrayIter& fp);
   static ArrayData* Copy(const ArrayData* ad);
   static ArrayData* CopyStatic(const ArrayData*);
+  /*
+   * Copy [offset, offset+len) of a packed-layout array into a new packed
+   * PHP array with one bulk copy and one refcount pass. len must be
+   * non-zero. Used by array_slice instead of per-element iteration.
+   */
+  static ArrayData* Slice(const ArrayData*, uint32_t offset, uint32_t len);
   static ArrayData* EscalateForSort(ArrayData*, SortFunction);
   static void Ksort(ArrayData*, int, bool);
   static void Sort(ArrayData*, int, bool);
@@ -139,6 +142,14 @@ struct PackedArray final : type_scan::MarkCollectable<PackedArray> {
   static bool Usort(ArrayData*, const Variant&);
   static bool Uasort(ArrayData*, const Variant&);
   static ArrayData* Append(ArrayData*, Cell v, bool copy);
+  /*
+   * Append a contiguous span of cells with one capacity/COW check per
+   * growth step, a bulk copy, and a single refcount pass, instead of
+   * one-at-a-time Append calls. Works on both packed and vec kinds.
+   * Returns nullptr if the result would exceed MaxSizeIndex, like Grow.
+   */
+  static ArrayData* AppendN(ArrayData*, const Cell* vals, uint32_t n,
+                            bool copy);
   static ArrayData* AppendRef(ArrayData*, tv_lval v, bool copy);
   static ArrayData* AppendWithRef(ArrayData*, TypedValue v, bool copy);
   static ArrayData* PlusEq(ArrayData*, const ArrayData* elems);
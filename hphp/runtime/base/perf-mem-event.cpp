@@ -24,6 +24,8 @@
 #include "hphp/runtime/base/memory-manager-defs.h"
 #include "hphp/runtime/base/mixed-array.h"
 #include "hphp/runtime/base/packed-array.h"
+#include "hphp/runtime/base/rds.h"
+#include "hphp/runtime/base/runtime-option.h"
 #include "hphp/runtime/base/string-data.h"
 #include "hphp/runtime/base/typed-value.h"
 #include "hphp/runtime/vm/class.h"
@@ -47,6 +49,9 @@
 
 #include <boost/algorithm/string/predicate.hpp>
 
+#include <atomic>
+#include <string>
+
 #include <folly/ScopeGuard.h>
 #ifdef FACEBOOK
 #include <folly/experimental/symbolizer/Symbolizer.h>
@@ -374,6 +379,95 @@ bool record_vm_stack_mem_event(const void* /*addr*/,
   return true;
 }
 
+/*
+ * Update `record' for an `addr' in the thread-local RDS range.
+ */
+bool record_rds_mem_event(const void* addr, StructuredLogEntry& record) {
+  record.setStr("location", "rds");
+  record.setInt("offset", uintptr_t(addr) - uintptr_t(rds::tl_base));
+  return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+ * Coarse memory regions for the periodic summary, mirroring the
+ * "location" values in the per-sample records.
+ */
+enum class MemRegion : uint8_t {
+  JitCode,
+  Rds,
+  LowMem,
+  Uncounted,
+  RequestHeap,
+  CppStack,
+  VMStack,
+  Unknown,
+};
+constexpr auto kNumMemRegions = uint8_t(MemRegion::Unknown) + 1;
+
+constexpr const char* kMemRegionNames[kNumMemRegions] = {
+  "jit_code",
+  "rds",
+  "low_mem",
+  "uncounted",
+  "request_heap",
+  "cpp_stack",
+  "vm_stack",
+  "unknown",
+};
+
+/*
+ * Cumulative per-region counters, shared by all sampling threads.  The
+ * summary entries report running totals; consumers diff consecutive
+ * entries per host to get rates, which sidesteps reset races.
+ */
+struct RegionCounters {
+  std::atomic<uint64_t> samples{0};
+  std::atomic<uint64_t> misses{0};
+  std::atomic<uint64_t> weight{0};
+};
+RegionCounters s_mem_regions[kNumMemRegions];
+std::atomic<uint64_t> s_mem_samples{0};
+
+/*
+ * Publish one struct-log entry with every region's running totals.  The
+ * weight of a load sample is its access latency in core cycles, so
+ * sorting regions by weight is the miss-cost leaderboard.
+ */
+void publish_mem_region_summary() {
+  auto record = StructuredLogEntry{};
+  record.setInt("version", kVersion);
+  for (uint8_t i = 0; i < kNumMemRegions; ++i) {
+    auto const name = std::string{kMemRegionNames[i]};
+    auto const& ctrs = s_mem_regions[i];
+    record.setInt(name + "_samples",
+                  ctrs.samples.load(std::memory_order_relaxed));
+    record.setInt(name + "_misses",
+                  ctrs.misses.load(std::memory_order_relaxed));
+    record.setInt(name + "_weight",
+                  ctrs.weight.load(std::memory_order_relaxed));
+  }
+  FTRACE(1, "perf_mem_event summary: {}\n", show(record).c_str());
+  StructuredLog::log("hhvm_mem_access_summary", record);
+}
+
+void update_mem_region_counters(MemRegion region,
+                                const perf_event_sample* sample,
+                                const perf_event_data_src_info& info) {
+  auto& ctrs = s_mem_regions[uint8_t(region)];
+  ctrs.samples.fetch_add(1, std::memory_order_relaxed);
+  if (!info.mem_hit) ctrs.misses.fetch_add(1, std::memory_order_relaxed);
+  ctrs.weight.fetch_add(sample->tail()->weight, std::memory_order_relaxed);
+
+  auto const period = RuntimeOption::EvalPerfMemEventSummaryPeriod;
+  if (period != 0 &&
+      s_mem_samples.fetch_add(1, std::memory_order_relaxed) % period ==
+        period - 1) {
+    publish_mem_region_summary();
+  }
+}
+
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -406,7 +500,9 @@ void record_perf_mem_event(PerfEvent kind, const perf_event_sample* sample) {
   record.setInt("snoop_hitm", info.snoop_hitm);
   record.setInt("locked", info.locked);
   record.setInt("tlb_hit", info.tlb_hit);
+  record.setInt("weight", sample->tail()->weight);
 
+  auto region = MemRegion::Unknown;
   auto const should_log = [&] {
     auto const tca = reinterpret_cast<TCA>(const_cast<void*>(addr));
 
@@ -414,19 +510,30 @@ void record_perf_mem_event(PerfEvent kind, const perf_event_sample* sample) {
       return false;
     }
     if (jit::mcgen::initialized() && jit::tc::code().isValidCodeAddress(tca)) {
+      region = MemRegion::JitCode;
       return record_tc_mem_event(tca, record);
     }
+    if (rds::tl_base &&
+        uintptr_t(addr) - uintptr_t(rds::tl_base) <
+          RuntimeOption::EvalJitTargetCacheSize) {
+      region = MemRegion::Rds;
+      return record_rds_mem_event(addr, record);
+    }
     if (uintptr_t(addr) <= 0xffffffff) {
+      region = MemRegion::LowMem;
       return record_low_mem_event(addr, record);
     }
     if (uintptr_t(addr) - s_stackLimit < s_stackSize) {
+      region = MemRegion::CppStack;
       return record_cpp_stack_mem_event(addr, record);
     }
     if (isValidVMStackAddress(addr)) {
+      region = MemRegion::VMStack;
       return record_vm_stack_mem_event(addr, record);
     }
 
     if (auto const thing = tl_heap->find(addr)) {
+      region = MemRegion::RequestHeap;
       if (UNLIKELY(thing->kind() != HeaderKind::Slab)) {
         return record_request_heap_mem_event(addr, thing, record);
       }
@@ -435,14 +542,29 @@ void record_perf_mem_event(PerfEvent kind, const perf_event_sample* sample) {
       return record_request_heap_mem_event(addr, obj ? obj : slab, record);
     }
     if (tl_heap->contains(const_cast<void*>(addr))) {
+      region = MemRegion::RequestHeap;
       record.setStr("location", "request_heap");
       return true;
     }
 
+#ifdef USE_JEMALLOC_EXTENT_HOOKS
+    // Below kUncountedMaxAddr but above low memory: APC uncounted data
+    // and other huge-arena allocations.
+    if (uintptr_t(addr) < kUncountedMaxAddr) {
+      region = MemRegion::Uncounted;
+      record.setStr("location", "uncounted");
+      return true;
+    }
+#endif
+
     record.setStr("location", "(unknown)");
     return true;
   }();
 
+  if (addr != nullptr) {
+    update_mem_region_counters(region, sample, info);
+  }
+
   if (should_log) {
     // Symbolize the callchain for the event.
     auto const st = StackTrace(
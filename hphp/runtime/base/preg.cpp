@@ -73,6 +73,7 @@ PCREglobals::PCREglobals() {
 
 PCREglobals::~PCREglobals() {
   pcre_jit_stack_free(jit_stack);
+  free(offsets_scratch);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -406,11 +407,13 @@ void PCRECache::reinit(CacheKind kind) {
       m_expire = time(nullptr) + RuntimeOption::EvalPCREExpireInterval;
       break;
     case CacheKind::Lru:
-      m_lruCache.reset(new LRUCache(RuntimeOption::EvalPCRETableSize));
+      m_lruCache.reset(new LRUCache(RuntimeOption::EvalPCRETableSize,
+                                    RuntimeOption::EvalPCRECacheBudgetBytes));
       break;
     case CacheKind::Scalable:
       m_scalableCache.reset(
-        new ScalableCache(RuntimeOption::EvalPCRETableSize));
+        new ScalableCache(RuntimeOption::EvalPCRETableSize, 0,
+                          RuntimeOption::EvalPCRECacheBudgetBytes));
       break;
   }
 }
@@ -464,6 +467,34 @@ void PCRECache::clearStatic() {
    });
 }
 
+/*
+ * Estimate the memory retained by a cache entry, for charging against
+ * Eval.PCRECacheBudgetBytes. The compiled pattern and its JITed code
+ * dominate; the struct itself and the key are noise by comparison but are
+ * included so even trivial patterns have a non-zero cost.
+ */
+static size_t pcre_entry_cost(const pcre_cache_entry* ent,
+                              const StringData* regex) {
+  size_t cost = sizeof(pcre_cache_entry) + regex->size();
+  size_t size = 0;
+  if (pcre_fullinfo(ent->re, ent->extra, PCRE_INFO_SIZE, &size) == 0) {
+    cost += size;
+  }
+  if (ent->extra) {
+    size = 0;
+    if (pcre_fullinfo(ent->re, ent->extra, PCRE_INFO_STUDYSIZE, &size) == 0) {
+      cost += size;
+    }
+    if (ent->extra->executable_jit != nullptr) {
+      size = 0;
+      if (pcre_fullinfo(ent->re, ent->extra, PCRE_INFO_JITSIZE, &size) == 0) {
+        cost += size;
+      }
+    }
+  }
+  return cost;
+}
+
 void PCRECache::insert(
   Accessor& accessor,
   const StringData* regex,
@@ -502,10 +533,12 @@ void PCRECache::insert(
         }
         // Pointer ownership is shared between container and caller
         accessor = EntryPtr(ent);
+        auto const cost = RuntimeOption::EvalPCRECacheBudgetBytes != 0
+          ? pcre_entry_cost(ent, regex) : 1;
         if (m_kind == CacheKind::Lru) {
-          m_lruCache->insert(*keyCache, accessor.entryPtr());
+          m_lruCache->insert(*keyCache, accessor.entryPtr(), cost);
         } else {
-          m_scalableCache->insert(*keyCache, accessor.entryPtr());
+          m_scalableCache->insert(*keyCache, accessor.entryPtr(), cost);
         }
       }
       break;
@@ -553,6 +586,35 @@ size_t PCRECache::size() const {
 ///////////////////////////////////////////////////////////////////////////////
 // Public interface and helper functions
 
+static bool
+pcre_get_compiled_regex_cache(PCRECache::Accessor& accessor,
+                              const StringData* regex);
+
+/*
+ * Compile every pattern listed in the given file (one per line, the same
+ * format the /dump-pcre-cache admin command writes) into the cache, so a
+ * freshly booted server serves its steady-state pattern set without
+ * taking compile or insert paths on live requests.
+ */
+static void pcre_precompile_from_file(const std::string& filename) {
+  std::ifstream in(filename);
+  if (!in.good()) {
+    Logger::Warning("Unable to read Eval.PCREPrecompileFile %s",
+                    filename.c_str());
+    return;
+  }
+  int count = 0;
+  std::string line;
+  while (std::getline(in, line)) {
+    if (line.empty()) continue;
+    String pattern(line.c_str(), line.size(), CopyString);
+    PCRECache::Accessor accessor;
+    if (pcre_get_compiled_regex_cache(accessor, pattern.get())) ++count;
+  }
+  Logger::Info("Precompiled %d PCRE patterns from %s",
+               count, filename.c_str());
+}
+
 void pcre_reinit() {
   PCRECache::CacheKind kind;
   if (RuntimeOption::EvalPCRECacheType == "static") {
@@ -567,6 +629,10 @@ void pcre_reinit() {
     kind = PCRECache::CacheKind::Scalable;
   }
   s_pcreCache.reinit(kind);
+
+  if (!RuntimeOption::EvalPCREPrecompileFile.empty()) {
+    pcre_precompile_from_file(RuntimeOption::EvalPCREPrecompileFile);
+  }
 }
 
 void pcre_init() {
@@ -597,6 +663,29 @@ private:
 };
 
 typedef FreeHelperImpl<true> SmartFreeHelper;
+
+/*
+ * Releases an offsets array obtained from create_offset_array(): hands the
+ * per-thread workspace back, or frees the request-heap fallback.
+ */
+struct OffsetFreeHelper {
+  explicit OffsetFreeHelper(int* p) : p(p) {}
+  ~OffsetFreeHelper() {
+    auto& globals = *tl_pcre_globals;
+    if (LIKELY(p == globals.offsets_scratch)) {
+      assertx(globals.offsets_scratch_busy);
+      globals.offsets_scratch_busy = false;
+    } else {
+      req::free(p);
+    }
+  }
+
+  OffsetFreeHelper(const OffsetFreeHelper&) = delete;
+  OffsetFreeHelper& operator=(const OffsetFreeHelper&) = delete;
+
+private:
+  int* p;
+};
 }
 
 static void init_local_extra(pcre_extra* local, pcre_extra* shared) {
@@ -906,8 +995,25 @@ pcre_get_compiled_regex_cache(PCRECache::Accessor& accessor,
 
 static int* create_offset_array(const pcre_cache_entry* pce,
                                 int& size_offsets) {
-  /* Allocate memory for the offsets array */
   size_offsets = pce->num_subpats * 3;
+  /* Reuse the per-thread workspace when it's available; nested calls
+     (e.g. a preg_replace_callback callback invoking preg_match while the
+     outer offsets are still live) fall back to a request-heap
+     allocation, released by OffsetFreeHelper either way. */
+  auto& globals = *tl_pcre_globals;
+  if (LIKELY(!globals.offsets_scratch_busy)) {
+    if (globals.offsets_scratch_size < (uint32_t)size_offsets) {
+      free(globals.offsets_scratch);
+      globals.offsets_scratch =
+        (int*)malloc(size_offsets * sizeof(int));
+      globals.offsets_scratch_size =
+        globals.offsets_scratch ? size_offsets : 0;
+    }
+    if (globals.offsets_scratch) {
+      globals.offsets_scratch_busy = true;
+      return globals.offsets_scratch;
+    }
+  }
   return (int *)req::malloc_noptrs(size_offsets * sizeof(int));
 }
 
@@ -1012,7 +1118,7 @@ Variant preg_grep(const String& pattern, const Array& input, int flags /* = 0 */
   if (offsets == nullptr) {
     return false;
   }
-  SmartFreeHelper freer(offsets);
+  OffsetFreeHelper freer(offsets);
 
   const bool hackArrOutput = flags & PREG_FB_HACK_ARRAYS;
 
@@ -1124,7 +1230,7 @@ static Variant preg_match_impl(const StringData* pattern,
 
   int size_offsets = 0;
   int* offsets = create_offset_array(pce, size_offsets);
-  SmartFreeHelper offsetsFreer(offsets);
+  OffsetFreeHelper offsetsFreer(offsets);
   int num_subpats = size_offsets / 3;
   if (offsets == nullptr) {
     return false;
@@ -1471,7 +1577,7 @@ static Variant php_pcre_replace(const String& pattern, const String& subject,
 
   int size_offsets;
   int* offsets = create_offset_array(pce, size_offsets);
-  SmartFreeHelper offsetsFreer(offsets);
+  OffsetFreeHelper offsetsFreer(offsets);
   if (offsets == nullptr) {
     return false;
   }
@@ -1825,7 +1931,7 @@ Variant preg_split(const String& pattern, const String& subject,
 
   int size_offsets = 0;
   int* offsets = create_offset_array(pce, size_offsets);
-  SmartFreeHelper offsetsFreer(offsets);
+  OffsetFreeHelper offsetsFreer(offsets);
   if (offsets == nullptr) {
     return false;
   }
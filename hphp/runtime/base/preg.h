@@ -91,6 +91,11 @@ struct PCREglobals {
   int64_t preg_backtrace_limit;
   int64_t preg_recursion_limit;
   pcre_jit_stack* jit_stack;
+  // Reusable per-match offsets workspace; like jit_stack it persists
+  // across requests. See create_offset_array() in preg.cpp.
+  int* offsets_scratch{nullptr};
+  uint32_t offsets_scratch_size{0};  // capacity in ints
+  bool offsets_scratch_busy{false};
 };
 
 ///////////////////////////////////////////////////////////////////////////////
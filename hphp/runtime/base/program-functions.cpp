@@ -62,10 +62,12 @@
 #include "hphp/runtime/server/http-server.h"
 #include "hphp/runtime/server/log-writer.h"
 #include "hphp/runtime/server/pagelet-server.h"
+#include "hphp/runtime/server/replay-bench.h"
 #include "hphp/runtime/server/replay-transport.h"
 #include "hphp/runtime/server/rpc-request-handler.h"
 #include "hphp/runtime/server/server-note.h"
 #include "hphp/runtime/server/server-stats.h"
+#include "hphp/runtime/server/takeover-agent.h"
 #include "hphp/runtime/server/warmup-request-handler.h"
 #include "hphp/runtime/server/xbox-server.h"
 #include "hphp/runtime/vm/debug/debug.h"
@@ -90,6 +92,7 @@
 #include "hphp/util/embedded-data.h"
 #include "hphp/util/hardware-counter.h"
 #include "hphp/util/hphp-config.h"
+#include "hphp/util/hugetlb.h"
 #include "hphp/util/kernel-version.h"
 #ifndef _MSC_VER
 #include "hphp/util/light-process.h"
@@ -747,6 +750,12 @@ init_command_line_globals(int argc, char** argv, char** envp,
     RID().setTimeout(RuntimeOption::RequestTimeoutSeconds);
   }
 
+  if (RuntimeOption::RequestCPUTimeoutSeconds) {
+    // The CPU budget runs on the thread CPU clock, so time blocked in IO
+    // or async waits doesn't count against it.
+    RID().setCPUTimeout(RuntimeOption::RequestCPUTimeoutSeconds);
+  }
+
   if (RuntimeOption::XenonForceAlwaysOn) {
     Xenon::getInstance().surpriseAll();
   }
@@ -802,7 +811,7 @@ const void* __hot_end = nullptr;
 
 static void
 NEVER_INLINE AT_END_OF_TEXT ALIGN_HUGE_PAGE __attribute__((__optimize__("2")))
-hugifyText(char* from, char* to) {
+hugifyText(char* from, char* to, bool tryHugetlb) {
 #if !FOLLY_SANITIZE && defined MADV_HUGEPAGE
   if (from > to || (to - from) < sizeof(uint64_t)) {
     // This shouldn't happen if HHVM is behaving correctly (I think),
@@ -819,14 +828,38 @@ hugifyText(char* from, char* to) {
   // This maps out a portion of our executable
   // We need to be very careful about what we do
   // until we replace the original code
-  mmap(from, sz,
-       PROT_READ | PROT_WRITE | PROT_EXEC,
-       MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED,
-       -1, 0);
-  // This is in glibc, which isn't a problem, except for
-  // the trampoline code in .plt, which we dealt with
-  // in the linker script
-  madvise(from, sz, MADV_HUGEPAGE);
+  bool onHugetlb = false;
+#ifdef MAP_HUGETLB
+#ifndef MAP_HUGE_2MB
+#define MAP_HUGE_2MB (21 << 26)
+#endif
+  if (tryHugetlb) {
+    // Prefer reserved hugetlb pages, which stay huge for the life of the
+    // process, unlike transparent huge pages, which the kernel may later
+    // split or fail to assemble.  The caller checked that enough pages were
+    // reserved before mapping anything out; in here we may only call into
+    // glibc.  `from' and `to' are both 2M-aligned.
+    if (mmap(from, sz,
+             PROT_READ | PROT_WRITE | PROT_EXEC,
+             MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED |
+             MAP_HUGETLB | MAP_HUGE_2MB,
+             -1, 0) != MAP_FAILED) {
+      // Fault the pages in before writing to them; if the reservation cannot
+      // actually be satisfied we would SIGBUS in wordcpy() below.
+      onHugetlb = mlock(from, sz) == 0;
+    }
+  }
+#endif
+  if (!onHugetlb) {
+    mmap(from, sz,
+         PROT_READ | PROT_WRITE | PROT_EXEC,
+         MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED,
+         -1, 0);
+    // This is in glibc, which isn't a problem, except for
+    // the trampoline code in .plt, which we dealt with
+    // in the linker script
+    madvise(from, sz, MADV_HUGEPAGE);
+  }
   // Don't use memcpy because its probably one of the
   // functions thats been mapped out.
   // Needs the attribute((optimize("2")) to prevent
@@ -837,8 +870,9 @@ hugifyText(char* from, char* to) {
   mlock(from, to - from);
   Debug::DebugInfo::setPidMapOverlay(from, to);
   std::stringstream ss;
-  ss << "Mapped text section onto huge pages from " <<
-      std::hex << (uint64_t*)from << " to " << (uint64_t*)to;
+  ss << "Mapped text section onto "
+     << (onHugetlb ? "reserved" : "transparent") << " huge pages from "
+     << std::hex << (uint64_t*)from << " to " << (uint64_t*)to;
   Logger::Info(ss.str());
 #endif
 }
@@ -946,8 +980,14 @@ static void pagein_self(void) {
             to = from + maxHugeHotTextBytes;
           }
           if (to <= (void*)hugifyText || hugifyTextEnd < from) {
+            // Decide whether hugifyText() should use reserved hugetlb pages
+            // before it maps the range out; after that point it may only
+            // call into glibc, so the sysfs probe has to happen here.
+            auto const nHugePages = (to - from) / hugePageBytes;
+            auto const tryHugetlb =
+              get_huge2m_info(-1).free_hugepages >= (int)nHugePages;
             mapped_huge = true;
-            hugifyText(from, to);
+            hugifyText(from, to, tryHugetlb);
           }
         }
         if (!RuntimeOption::LockCodeMemory) {
@@ -964,7 +1004,8 @@ static void pagein_self(void) {
  * config load.  Returns false upon unrecognized mode.
  */
 static bool set_execution_mode(folly::StringPiece mode) {
-  if (mode == "daemon" || mode == "server" || mode == "replay") {
+  if (mode == "daemon" || mode == "server" || mode == "replay" ||
+      mode == "replay-bench") {
     RuntimeOption::ServerMode = true;
     Logger::Escape = true;
     return true;
@@ -1152,6 +1193,14 @@ static int start_server(const std::string &username, int xhprof) {
     profileWarmupEnd();
   }
 
+  if (!RuntimeOption::ServerWarmupClasses.empty()) {
+    HttpServer::CheckMemAndWait();
+    BootStats::Block timer("Preloading Classes", true);
+    profileWarmupStart();
+    preloadClasses();
+    profileWarmupEnd();
+  }
+
   // If we have any warmup requests, replay them before listening for
   // real connections
   {
@@ -1467,7 +1516,7 @@ static int execute_program_impl(int argc, char** argv) {
     ("repo-schema", "display the repository schema id")
     ("mode,m", value<std::string>(&po.mode)->default_value("run"),
      "run | debug (d) | vsdebug | server (s) | daemon | replay | "
-     "translate (t) | verify")
+     "replay-bench | translate (t) | verify")
     ("interactive,a", "Shortcut for --mode debug") // -a is from PHP5
     ("config,c", value<std::vector<std::string>>(&po.config)->composing(),
      "load specified config file")
@@ -2148,6 +2197,14 @@ static int execute_program_impl(int argc, char** argv) {
     return 0;
   }
 
+  if (po.mode == "replay-bench" && !po.args.empty()) {
+    RuntimeOption::RecordInput = false;
+    set_execution_mode("server");
+    // --count is the number of passes over the corpus; one pass is rarely
+    // enough to see the JIT mature.
+    return runReplayBench(po.args, po.count);
+  }
+
   if (po.mode == "translate" && !po.args.empty()) {
     printf("%s", translate_stack(po.args[0].c_str()).c_str());
     return 0;
@@ -2441,6 +2498,16 @@ void hphp_process_init() {
       if (RuntimeOption::ServerExecutionMode()) {
         Logger::FInfo("JitDeserializeFrom: {}",
                       RuntimeOption::EvalJitSerdesFile);
+        // When taking over from a running server, ask it to refresh the
+        // serialized profile first, so we inherit its current jit
+        // profile instead of whatever file the deploy left on disk.
+        if (!RuntimeOption::TakeoverFilename.empty() &&
+            TakeoverAgent::requestProfile(RuntimeOption::TakeoverFilename,
+                                          std::chrono::seconds(10))) {
+          Logger::FInfo("JitDeserialize: old server refreshed {}",
+                        RuntimeOption::EvalJitSerdesFile);
+          BootStats::mark("takeover::requestProfile");
+        }
       }
       auto const numWorkers = RuntimeOption::EvalJitWorkerThreadsForSerdes ?
         RuntimeOption::EvalJitWorkerThreadsForSerdes : Process::GetCPUCount();
@@ -2832,8 +2899,8 @@ void hphp_session_exit(Transport* transport) {
                                        true /*psp*/);
     if (entry) {
       entry->setInt("response_code", transport->getResponseCode());
-      StructuredLog::log("hhvm_request_perf", *entry);
-      transport->resetStructuredLogEntry();
+      StructuredLog::logDeferred("hhvm_request_perf",
+                                 transport->releaseStructuredLogEntry());
     }
   }
 }
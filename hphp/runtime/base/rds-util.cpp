@@ -59,6 +59,13 @@ bindStaticMemoCache(const Func* func) {
   );
 }
 
+Link<MemoInlineCache, rds::Mode::Normal>
+bindStaticMemoInlineCache(const Func* func) {
+  return bind<MemoInlineCache,Mode::Normal>(
+    StaticMemoInlineCache { func->getFuncId() }
+  );
+}
+
 Link<MemoCacheBase*, rds::Mode::Normal>
 attachStaticMemoCache(const Func* func) {
   return attach<MemoCacheBase*,Mode::Normal>(
@@ -94,6 +101,26 @@ attachLSBMemoCache(const Class* cls, const Func* func) {
   );
 }
 
+void unbindFuncCaches(const Func* func) {
+  auto const funcId = func->getFuncId();
+
+  auto const detach = [] (Symbol sym, auto link) {
+    if (link.bound()) unbind(sym, link.handle());
+  };
+
+  for (auto const& sv : func->staticVars()) {
+    auto const sym = StaticLocal { funcId, sv.name };
+    detach(sym, attach<StaticLocalData,Mode::Normal>(sym));
+  }
+  if (func->isMemoizeWrapper()) {
+    detach(StaticMemoValue { funcId }, attachStaticMemoValue(func));
+    detach(StaticMemoCache { funcId }, attachStaticMemoCache(func));
+    detach(StaticMemoInlineCache { funcId },
+           attach<MemoInlineCache,Mode::Normal>(
+             StaticMemoInlineCache { funcId }));
+  }
+}
+
 //////////////////////////////////////////////////////////////////////
 
 }}
@@ -63,6 +63,22 @@ bindStaticMemoValue(const Func*);
 Link<MemoCacheBase*, rds::Mode::Normal>
 bindStaticMemoCache(const Func*);
 
+/*
+ * Single-entry inline cache consulted by the JIT before the shared memo cache
+ * for static memoize wrappers with one int key (see Eval.JitMemoInlineCache).
+ * The value is a borrowed copy of the corresponding entry in the shared
+ * cache, which owns the reference; both live in normal RDS, so they're
+ * discarded together at the end of the request.
+ */
+struct MemoInlineCache {
+  TypedValue key;
+  TypedValue value;
+  static size_t key_offset() { return offsetof(MemoInlineCache, key); }
+  static size_t value_offset() { return offsetof(MemoInlineCache, value); }
+};
+Link<MemoInlineCache, rds::Mode::Normal>
+bindStaticMemoInlineCache(const Func*);
+
 Link<Cell, rds::Mode::Normal>
 attachStaticMemoValue(const Func*);
 
@@ -81,6 +97,14 @@ attachLSBMemoValue(const Class*, const Func*);
 Link<MemoCacheBase*, rds::Mode::Normal>
 attachLSBMemoCache(const Class*, const Func*);
 
+/*
+ * Unbind all the FuncId-keyed caches of `func' (static locals and
+ * static memoize caches), recycling their RDS space.  Called when a
+ * Func is destroyed so that sandbox-mode reloads don't slowly leak
+ * RDS space as files are changed.
+ */
+void unbindFuncCaches(const Func*);
+
 //////////////////////////////////////////////////////////////////////
 
 }}
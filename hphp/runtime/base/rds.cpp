@@ -15,13 +15,16 @@
 */
 #include "hphp/runtime/base/rds.h"
 
+#include <algorithm>
 #include <atomic>
 #include <cassert>
 #include <cstdio>
 #include <mutex>
 #include <vector>
 
+#include <folly/AtomicHashMap.h>
 #include <folly/Bits.h>
+#include <folly/Format.h>
 #include <folly/Hash.h>
 #include <folly/portability/SysMman.h>
 #include <folly/sorted_vector_types.h>
@@ -72,6 +75,9 @@ struct SymbolKind : boost::static_visitor<std::string> {
   std::string operator()(SPropCache /*k*/) const { return "SPropCache"; }
   std::string operator()(StaticMemoValue) const { return "StaticMemoValue"; }
   std::string operator()(StaticMemoCache) const { return "StaticMemoCache"; }
+  std::string operator()(StaticMemoInlineCache) const {
+    return "StaticMemoInlineCache";
+  }
   std::string operator()(LSBMemoValue) const { return "LSBMemoValue"; }
   std::string operator()(LSBMemoCache) const { return "LSBMemoCache"; }
 };
@@ -119,6 +125,10 @@ struct SymbolRep : boost::static_visitor<std::string> {
     auto const func = Func::fromFuncId(k.funcId);
     return func->fullName()->toCppString();
   }
+  std::string operator()(StaticMemoInlineCache k) const {
+    auto const func = Func::fromFuncId(k.funcId);
+    return func->fullName()->toCppString();
+  }
 
   std::string operator()(LSBMemoValue k) const {
     auto const clsName = k.cls->name()->toCppString();
@@ -181,6 +191,10 @@ struct SymbolEq : boost::static_visitor<bool> {
     return k1.funcId == k2.funcId;
   }
 
+  bool operator()(StaticMemoInlineCache k1, StaticMemoInlineCache k2) const {
+    return k1.funcId == k2.funcId;
+  }
+
   bool operator()(LSBMemoValue k1, LSBMemoValue k2) const {
     return k1.cls == k2.cls && k1.funcId == k2.funcId;
   }
@@ -229,6 +243,9 @@ struct SymbolHash : boost::static_visitor<size_t> {
   size_t operator()(StaticMemoCache k) const {
     return std::hash<FuncId>()(k.funcId);
   }
+  size_t operator()(StaticMemoInlineCache k) const {
+    return std::hash<FuncId>()(k.funcId);
+  }
 
   size_t operator()(LSBMemoValue k) const {
     return folly::hash::hash_combine(
@@ -267,6 +284,10 @@ LinkTable s_linkTable;
 using RevLinkTable = tbb::concurrent_hash_map<Handle,Symbol>;
 RevLinkTable s_handleTable;
 
+// Profile-weighted access counts per handle, populated by recordAccess()
+// when Eval.ProfileRDSHeat is set.
+folly::AtomicHashMap<uint32_t,std::atomic<uint64_t>> s_heatCounters{32768};
+
 //////////////////////////////////////////////////////////////////////
 
 /*
@@ -370,6 +391,10 @@ NEVER_INLINE void addNewPersistentChunk(size_t size) {
   assertx(size > 0 && size < kMaxHandle && size % 4096 == 0);
   auto const raw = static_cast<char*>(low_malloc(size));
   auto const addr = reinterpret_cast<uintptr_t>(raw);
+  // Persistent RDS is written during init and then read by every request
+  // thread, so spread it across the NUMA nodes rather than leaving it all on
+  // whichever node first touched it.
+  numa_interleave(raw, size);
   memset(raw, 0, size);
 #if !RDS_FIXED_PERSISTENT_BASE
   // This is only called once in processInit() if we don't have a persistent
@@ -585,8 +610,44 @@ void bindOnLinkImpl(std::atomic<Handle>& handle,
 
 void unbind(Symbol key, Handle handle) {
   Guard g(s_allocMutex);
+  uint32_t size = 0;
+  {
+    LinkTable::const_accessor acc;
+    if (s_linkTable.find(acc, key)) {
+      assertx(acc->second.handle == handle);
+      size = acc->second.size;
+    }
+  }
   s_linkTable.erase(key);
   s_handleTable.erase(handle);
+  if (size == 0) return;
+
+  // In-flight requests (and the code the JIT emitted for them) may still
+  // access the handle, so delay recycling the space until they've all
+  // drained.  We don't bother tracking free space in the local section
+  // (see the comment on the free lists above).
+  if (!isPersistentHandle(handle) && !isNormalHandle(handle)) return;
+  Treadmill::enqueue([handle, size] {
+    Guard g(s_allocMutex);
+    if (isPersistentHandle(handle)) {
+      addFreeBlock(s_persistent_free_lists, handle, size);
+      s_persistent_usage -= size;
+      return;
+    }
+    // Neutralize any type-scan descriptor covering the space before
+    // recycling it, so the heap scanner doesn't visit a future allocation
+    // with this symbol's type.  tbb::concurrent_vector never moves its
+    // elements, so writing the size in place is safe with respect to
+    // concurrent iteration; reuse of the space is serialized behind
+    // s_allocMutex, after the descriptor is dead.
+    for (auto& desc : s_normal_alloc_descs) {
+      if (desc.handle == handle) desc.size = 0;
+    }
+    // The space we own includes the gen-number prefix (any alignment
+    // padding beyond it was returned to the free lists by alloc()).
+    addFreeBlock(s_normal_free_lists, genNumberHandleFrom(handle),
+                 size + sizeof(GenNumber));
+  });
 }
 
 using namespace detail;
@@ -891,6 +952,47 @@ void recordRds(Handle h, size_t size, const Symbol& sym) {
   }
 }
 
+void recordAccess(Handle h, uint64_t weight) {
+  auto const pair = s_heatCounters.emplace(h, weight);
+  if (!pair.second) {
+    pair.first->second.fetch_add(weight, std::memory_order_relaxed);
+  }
+}
+
+std::string dumpHeatProfile() {
+  struct Row {
+    Handle handle;
+    uint64_t weight;
+    std::string name;
+  };
+  std::vector<Row> rows;
+  for (auto const& elm : s_heatCounters) {
+    auto const handle = Handle(elm.first);
+    auto name = [&] () -> std::string {
+      if (auto const sym = reverseLink(handle)) {
+        return folly::sformat("{}:{}",
+                              boost::apply_visitor(SymbolKind(), *sym),
+                              boost::apply_visitor(SymbolRep(), *sym));
+      }
+      return "<unknown>";
+    }();
+    rows.push_back(
+      Row{handle, elm.second.load(std::memory_order_relaxed), std::move(name)}
+    );
+  }
+  std::sort(rows.begin(), rows.end(),
+            [] (const Row& a, const Row& b) { return a.weight > b.weight; });
+
+  std::string ret;
+  folly::format(&ret, "{:>10} {:>8} {:>16}  {}\n",
+                "handle", "line", "weight", "symbol");
+  for (auto const& row : rows) {
+    folly::format(&ret, "{:>10} {:>8} {:>16}  {}\n",
+                  row.handle, row.handle / 64, row.weight, row.name);
+  }
+  return ret;
+}
+
 std::vector<void*> allTLBases() {
   Guard g(s_tlBaseListLock);
   return s_tlBaseList;
@@ -48,6 +48,7 @@ struct StringData;
 struct Class;
 
 namespace jit {
+struct ArgValueProfile;
 struct ArrayKindProfile;
 struct ArrayOffsetProfile;
 struct CallTargetProfile;
@@ -55,6 +56,8 @@ struct ClsCnsProfile;
 struct DecRefProfile;
 struct IncRefProfile;
 struct MethProfile;
+struct MethTargetProfile;
+struct PropClassProfile;
 struct SwitchProfile;
 struct TypeProfile;
 struct ReleaseVVProfile;
@@ -226,6 +229,7 @@ struct SPropCache { LowPtr<const Class> cls;
 
 struct StaticMemoValue { FuncId funcId; };
 struct StaticMemoCache { FuncId funcId; };
+struct StaticMemoInlineCache { FuncId funcId; };
 
 struct LSBMemoValue {
   LowPtr<const Class> cls;
@@ -242,6 +246,7 @@ using Symbol = boost::variant< StaticLocal
                              , ClsConstant
                              , StaticMethod
                              , StaticMethodF
+                             , Profile<jit::ArgValueProfile>
                              , Profile<jit::ArrayKindProfile>
                              , Profile<jit::ArrayOffsetProfile>
                              , Profile<jit::CallTargetProfile>
@@ -249,12 +254,15 @@ using Symbol = boost::variant< StaticLocal
                              , Profile<jit::DecRefProfile>
                              , Profile<jit::IncRefProfile>
                              , Profile<jit::MethProfile>
+                             , Profile<jit::MethTargetProfile>
+                             , Profile<jit::PropClassProfile>
                              , Profile<jit::ReleaseVVProfile>
                              , Profile<jit::SwitchProfile>
                              , Profile<jit::TypeProfile>
                              , SPropCache
                              , StaticMemoValue
                              , StaticMemoCache
+                             , StaticMemoInlineCache
                              , LSBMemoValue
                              , LSBMemoCache
                              >;
@@ -498,8 +506,10 @@ template<class T, Mode M, size_t Align = alignof(T)>
 Link<T,M> bind(Symbol key, size_t extraSize = 0);
 
 /*
- * Remove a bound link from RDS metadata. The actual space in RDS is
- * not reclaimed.
+ * Remove a bound link from RDS metadata.  The space is returned to the
+ * free lists for reuse by later allocations once the treadmill drains
+ * every request that might still access the handle (except in the
+ * local section, where free space isn't tracked).
  */
 void unbind(Symbol, Handle);
 
@@ -641,6 +651,18 @@ void recordRds(Handle h, size_t size, const Symbol& sym);
 
 void visitSymbols(std::function<void(const Symbol&,Handle,uint32_t)> fun);
 
+/*
+ * Heat accounting for RDS handles (see Eval.ProfileRDSHeat).
+ *
+ * recordAccess() adds `weight' to the counter for `h'; the JIT calls it for
+ * every RDS access in an optimized translation, weighted by the profile count
+ * of the accessing block.  dumpHeatProfile() renders the accumulated
+ * counters, hottest first, resolving handles back to their symbols where
+ * possible.
+ */
+void recordAccess(Handle h, uint64_t weight);
+std::string dumpHeatProfile();
+
 /*
  * Return a list of all the tl_bases for any threads that are using RDS
  */
@@ -0,0 +1,150 @@
+/*
+   +----------------------------------------------------------------------+
+   | HipHop for PHP                                                       |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 2010-present Facebook, Inc. (http://www.facebook.com)  |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 3.01 of the PHP license,      |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.php.net/license/3_01.txt                                  |
+   | If you did not receive a copy of the PHP license and are unable to   |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@php.net so we can mail you a copy immediately.               |
+   +----------------------------------------------------------------------+
+*/
+
+#ifndef incl_HPHP_RUNTIME_BASE_REQ_ARENA_H_
+#define incl_HPHP_RUNTIME_BASE_REQ_ARENA_H_
+
+#include "hphp/runtime/base/req-malloc.h"
+#include "hphp/util/assertions.h"
+
+#include <atomic>
+#include <cstddef>
+
+namespace HPHP { namespace req {
+
+//////////////////////////////////////////////////////////////////////
+
+/*
+ * Request-lifetime bump allocator for container backing storage.
+ *
+ * Chunks are drawn from the request heap via malloc_untyped(), so anything
+ * stored in them is conservatively scanned by the GC and the memory returns
+ * to the heap wholesale at request end. deallocate() is deliberately a
+ * no-op, which makes geometric container growth cheap: the abandoned buffer
+ * costs nothing to free and is reclaimed with the request (or by the GC,
+ * once nothing points at its chunk).
+ *
+ * Use with ArenaAllocator below:
+ *
+ *   req::Arena arena;
+ *   std::vector<int,req::ArenaAllocator<int>> v{
+ *     req::ArenaAllocator<int>{&arena}
+ *   };
+ */
+struct Arena {
+  static constexpr size_t kChunkBytes = 4096;
+  static constexpr size_t kAlign = 16;
+
+  void* alloc(size_t nbytes) {
+    nbytes = (nbytes + kAlign - 1) & ~(kAlign - 1);
+    if (UNLIKELY(nbytes > m_avail)) return allocSlow(nbytes);
+    auto const p = m_frontier;
+    m_frontier += nbytes;
+    m_avail -= nbytes;
+    return p;
+  }
+
+ private:
+  void* allocSlow(size_t nbytes) {
+    if (nbytes >= kChunkBytes / 2) {
+      // Large enough to deserve its own block; leave the current chunk
+      // alone so small allocations keep filling it.
+      return req::malloc_untyped(nbytes);
+    }
+    m_frontier = static_cast<char*>(req::malloc_untyped(kChunkBytes));
+    m_avail = kChunkBytes - nbytes;
+    auto const p = m_frontier;
+    m_frontier += nbytes;
+    return p;
+  }
+
+  char* m_frontier{nullptr};
+  size_t m_avail{0};
+};
+
+/*
+ * Minimal std-compatible allocator over a req::Arena. The arena must
+ * outlive every container bound to it.
+ */
+template<class T>
+struct ArenaAllocator {
+  using value_type = T;
+
+  explicit ArenaAllocator(Arena* arena) noexcept : m_arena(arena) {
+    assertx(arena);
+  }
+  template<class U>
+  /* implicit */ ArenaAllocator(const ArenaAllocator<U>& other) noexcept
+    : m_arena(other.arena())
+  {}
+
+  T* allocate(size_t n) {
+    return static_cast<T*>(m_arena->alloc(n * sizeof(T)));
+  }
+  void deallocate(T*, size_t) noexcept {
+    // Freed wholesale with the arena's chunks at request end.
+  }
+
+  Arena* arena() const { return m_arena; }
+
+  template<class U>
+  bool operator==(const ArenaAllocator<U>& other) const {
+    return m_arena == other.arena();
+  }
+  template<class U>
+  bool operator!=(const ArenaAllocator<U>& other) const {
+    return !(*this == other);
+  }
+
+ private:
+  Arena* m_arena;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+/*
+ * Process-lifetime record of the largest size a container call site has
+ * reached, so hot sizes learned in one request can seed reserve() in the
+ * next and skip the rehash/regrow ladder:
+ *
+ *   static req::CapacityProfile s_prof;
+ *   req::hash_map<...> m;
+ *   m.reserve(s_prof.hint());
+ *   ...
+ *   s_prof.observe(m.size());
+ *
+ * Thread-safe; updates are relaxed since a hint that lags by a request is
+ * harmless.
+ */
+struct CapacityProfile {
+  size_t hint() const {
+    return m_max.load(std::memory_order_relaxed);
+  }
+  void observe(size_t n) {
+    auto cur = m_max.load(std::memory_order_relaxed);
+    while (n > cur &&
+           !m_max.compare_exchange_weak(cur, n, std::memory_order_relaxed)) {
+    }
+  }
+ private:
+  std::atomic<size_t> m_max{0};
+};
+
+//////////////////////////////////////////////////////////////////////
+
+}}
+
+#endif
@@ -20,6 +20,8 @@
 #include "hphp/util/alloc.h"
 #include "hphp/util/type-scan.h"
 
+#include <type_traits>
+
 /*
  * req::malloc api for request-scoped memory
  *
@@ -118,6 +120,16 @@ template<class T> void destroy_raw(T* p);
 template<class T> T* make_raw_array(size_t count);
 template<class T> void destroy_raw_array(T* t, size_t count);
 
+/*
+ * Allocate an array without running constructors or zeroing anything: for
+ * trivially-default-constructible element types whose contents the caller
+ * immediately overwrites, so concat/copy-heavy paths don't pay a memset for
+ * bytes that are about to be stored over. The element type is still visible
+ * to the type scanner, so the caller must fully initialize the array before
+ * anything that can reach a GC safepoint (i.e. before any allocation).
+ */
+template<class T> T* make_raw_array_uninit(size_t count);
+
 /*
  * Allocate an array of objects, memset to 0. Does *not* run any constructors.
  */
@@ -258,6 +270,14 @@ template<class T> T* make_raw_array(size_t count) {
   return ret;
 }
 
+template<class T> T* make_raw_array_uninit(size_t count) {
+  static_assert(std::is_trivially_default_constructible<T>::value,
+                "make_raw_array_uninit is only for trivial element types");
+  return static_cast<T*>(
+    req::malloc(count * sizeof(T), type_scan::getIndexForMalloc<T>())
+  );
+}
+
 template<class T>
 void destroy_raw_array(T* t, size_t count) {
   size_t i = count;
@@ -185,20 +185,43 @@ RequestTimer::RequestTimer(RequestInjectionData* data, clockid_t clockType)
     , m_clockType(clockType)
     , m_hasTimer(false)
     , m_timerActive(false)
+    , m_wheelTimer([] (void* t) { static_cast<RequestTimer*>(t)->onTimeout(); },
+                   this)
 {}
 
 RequestTimer::~RequestTimer() {
+  if (useTimerWheel()) {
+    TimerWheel::get().disarm(m_wheelTimer);
+  }
   if (m_hasTimer) {
     timer_delete(m_timerId);
   }
 }
 
+bool RequestTimer::useTimerWheel() const {
+  return RuntimeOption::EvalRequestTimerWheel &&
+    m_clockType == CLOCK_REALTIME;
+}
+
 /*
  * NB: this function must be nothrow when `seconds' is zero.  RPCRequestHandler
  * makes use of this.
  */
 void RequestTimer::setTimeout(int seconds) {
   m_timeoutSeconds = seconds > 0 ? seconds : 0;
+  if (useTimerWheel()) {
+    // The wheel's deadline thread runs onTimeout() with our shard's lock
+    // held, so once disarm() returns there is no pending callback to
+    // race with -- the same guarantee the signal dance below provides.
+    if (m_timeoutSeconds) {
+      m_timerActive.store(true, std::memory_order_relaxed);
+      TimerWheel::get().arm(m_wheelTimer, m_timeoutSeconds);
+    } else {
+      TimerWheel::get().disarm(m_wheelTimer);
+      m_timerActive.store(false, std::memory_order_relaxed);
+    }
+    return;
+  }
   if (!m_hasTimer) {
     if (!m_timeoutSeconds) {
       // we don't have a timer, and we don't have a timeout
@@ -246,6 +269,14 @@ void RequestTimer::setTimeout(int seconds) {
 }
 
 int RequestTimer::getRemainingTime() const {
+  if (useTimerWheel()) {
+    if (m_timerActive.load(std::memory_order_acquire)) {
+      if (auto const remaining = TimerWheel::get().remaining(m_wheelTimer)) {
+        return remaining;
+      }
+    }
+    return m_timeoutSeconds;
+  }
   if (m_hasTimer) {
     itimerspec ts;
     if (!timer_gettime(m_timerId, &ts)) {
@@ -23,6 +23,8 @@
 #include "hphp/runtime/vm/async-flow-stepper.h"
 #include "hphp/runtime/vm/pc-filter.h"
 
+#include "hphp/util/timer-wheel.h"
+
 #include <atomic>
 #include <cassert>
 #include <cinttypes>
@@ -80,8 +82,15 @@ private:
   /* Whether we've created our timer yet. */
   bool m_hasTimer{false};
 
-  /* Set true when we activate a timer, cleared when the signal handler runs. */
+  /* Set true when we activate a timer, cleared when the signal handler (or
+   * the timer wheel's deadline thread) runs. */
   std::atomic<bool> m_timerActive{false};
+
+  /* Whether this timer is driven by the process-wide TimerWheel rather
+   * than a POSIX timer.  Only wall-clock timers can be; CPU-time deadlines
+   * still need a per-thread timer on CLOCK_THREAD_CPUTIME_ID. */
+  bool useTimerWheel() const;
+  TimerWheel::Timer m_wheelTimer;
 #endif
 };
 
@@ -40,6 +40,7 @@
 #include "hphp/util/hphp-config.h"
 #include "hphp/util/text-util.h"
 #include "hphp/util/network.h"
+#include "hphp/util/boot-stats.h"
 #include "hphp/util/hardware-counter.h"
 #include "hphp/util/logger.h"
 #include "hphp/util/stack-trace.h"
@@ -122,6 +123,7 @@ uint32_t RuntimeOption::EvalInitialStaticStringTableSize =
 uint32_t RuntimeOption::EvalInitialNamedEntityTableSize = 30000;
 JitSerdesMode RuntimeOption::EvalJitSerdesMode{};
 int RuntimeOption::ProfDataTTLHours = 24;
+bool RuntimeOption::ProfDataBytecodeMatching = false;
 std::string RuntimeOption::EvalJitSerdesFile;
 
 std::map<std::string, ErrorLogFileData> RuntimeOption::ErrorLogs = {
@@ -158,6 +160,7 @@ int64_t RuntimeOption::SerializationSizeLimit = StringData::MaxSize;
 
 std::string RuntimeOption::AccessLogDefaultFormat = "%h %l %u %t \"%r\" %>s %b";
 std::map<std::string, AccessLogFileData> RuntimeOption::AccessLogs;
+bool RuntimeOption::AsyncAccessLog = false;
 
 std::string RuntimeOption::AdminLogFormat = "%h %t %s %U";
 std::string RuntimeOption::AdminLogFile;
@@ -184,10 +187,16 @@ int RuntimeOption::ServerWarmupThrottleThreadCount = 0;
 int RuntimeOption::ServerThreadDropCacheTimeoutSeconds = 0;
 int RuntimeOption::ServerThreadJobLIFOSwitchThreshold = INT_MAX;
 int RuntimeOption::ServerThreadJobMaxQueuingMilliSeconds = -1;
+std::string RuntimeOption::ServerQueuingBudgetHeader;
+std::string RuntimeOption::ServerRequestPriorityHeader;
+bool RuntimeOption::ServerCoalesceDuplicateGets = false;
+int RuntimeOption::ServerChunkedEgressBackpressureSeconds = 0;
+int RuntimeOption::ServerReadyJitMaturityThreshold = 0;
 bool RuntimeOption::AlwaysDecodePostDataDefault = true;
 bool RuntimeOption::ServerThreadDropStack = false;
 bool RuntimeOption::ServerHttpSafeMode = false;
 bool RuntimeOption::ServerStatCache = false;
+bool RuntimeOption::ServerStatCacheForStreams = false;
 bool RuntimeOption::ServerFixPathInfo = false;
 bool RuntimeOption::ServerAddVaryEncoding = true;
 bool RuntimeOption::ServerLogSettingsOnStartup = false;
@@ -195,6 +204,7 @@ bool RuntimeOption::ServerForkEnabled = true;
 bool RuntimeOption::ServerForkLogging = false;
 bool RuntimeOption::ServerWarmupConcurrently = false;
 std::vector<std::string> RuntimeOption::ServerWarmupRequests;
+std::vector<std::string> RuntimeOption::ServerWarmupClasses;
 std::string RuntimeOption::ServerCleanupRequest;
 int RuntimeOption::ServerInternalWarmupThreads = 0;
 boost::container::flat_set<std::string>
@@ -206,9 +216,11 @@ int RuntimeOption::PageletServerThreadDropCacheTimeoutSeconds = 0;
 int RuntimeOption::PageletServerQueueLimit = 0;
 bool RuntimeOption::PageletServerThreadDropStack = false;
 int RuntimeOption::RequestTimeoutSeconds = 0;
+int RuntimeOption::RequestCPUTimeoutSeconds = 0;
 int RuntimeOption::PspTimeoutSeconds = 0;
 int RuntimeOption::PspCpuTimeoutSeconds = 0;
 int64_t RuntimeOption::MaxRequestAgeFactor = 0;
+int64_t RuntimeOption::TreadmillLagBudgetSeconds = 0;
 int64_t RuntimeOption::RequestMemoryMaxBytes =
   std::numeric_limits<int64_t>::max();
 int64_t RuntimeOption::RequestMemoryOOMKillBytes =
@@ -278,6 +290,10 @@ std::string RuntimeOption::SSLCertificateFile;
 std::string RuntimeOption::SSLCertificateKeyFile;
 std::string RuntimeOption::SSLCertificateDir;
 std::string RuntimeOption::SSLTicketSeedFile;
+bool RuntimeOption::SSLSessionCache = false;
+int RuntimeOption::SSLSessionCacheSize = 20480;
+int RuntimeOption::SSLSessionLifetimeSeconds = 7200;
+std::string RuntimeOption::SSLSessionContextId = "hhvm";
 bool RuntimeOption::TLSDisableTLS1_2 = false;
 std::string RuntimeOption::TLSClientCipherSpec;
 bool RuntimeOption::EnableSSLWithPlainText = false;
@@ -697,8 +713,12 @@ bool RuntimeOption::RepoDebugInfo = true;
 // Missing: RuntimeOption::RepoAuthoritative's physical location is
 // perf-sensitive.
 bool RuntimeOption::RepoPreload;
+int32_t RuntimeOption::RepoPreloadThreads = 0;
+int64_t RuntimeOption::RepoPreloadLimit = 0;
 int64_t RuntimeOption::RepoLocalReadaheadRate = 0;
 bool RuntimeOption::RepoLocalReadaheadConcurrent = false;
+int64_t RuntimeOption::RepoMmapSize = 0;
+bool RuntimeOption::RepoLitstrLazyLoad = false;
 
 bool RuntimeOption::HHProfEnabled = false;
 bool RuntimeOption::HHProfActive = false;
@@ -763,6 +783,7 @@ int RuntimeOption::Fb303ServerPoolThreads = 1;
 double RuntimeOption::XenonPeriodSeconds = 0.0;
 uint32_t RuntimeOption::XenonRequestFreq = 1;
 bool RuntimeOption::XenonForceAlwaysOn = false;
+uint32_t RuntimeOption::XenonSampleBudgetPerSecond = 0;
 bool RuntimeOption::TrackPerUnitMemory = false;
 
 std::map<std::string, std::string> RuntimeOption::CustomSettings;
@@ -1104,6 +1125,7 @@ void RuntimeOption::Load(
                  config, "Log.ForceErrorReportingLevel", 0);
     Config::Bind(AccessLogDefaultFormat, ini, config,
                  "Log.AccessLogDefaultFormat", "%h %l %u %t \"%r\" %>s %b");
+    Config::Bind(AsyncAccessLog, ini, config, "Log.AsyncAccessLog", false);
 
     auto parseLogs = [] (const Hdf &config, const IniSetting::Map& ini,
                          const std::string &name,
@@ -1307,10 +1329,15 @@ void RuntimeOption::Load(
     Config::Bind(RepoAuthoritative, ini, config, "Repo.Authoritative",
                  RepoAuthoritative);
     Config::Bind(RepoPreload, ini, config, "Repo.Preload", false);
+    Config::Bind(RepoPreloadThreads, ini, config, "Repo.PreloadThreads", 0);
+    Config::Bind(RepoPreloadLimit, ini, config, "Repo.PreloadLimit", 0);
     Config::Bind(RepoLocalReadaheadRate, ini, config,
                  "Repo.LocalReadaheadRate", 0);
     Config::Bind(RepoLocalReadaheadConcurrent, ini, config,
                  "Repo.LocalReadaheadConcurrent", false);
+    Config::Bind(RepoMmapSize, ini, config, "Repo.MmapSize", 0);
+    Config::Bind(RepoLitstrLazyLoad, ini, config, "Repo.LitstrLazyLoad",
+                 false);
   }
 
   if (use_jemalloc) {
@@ -1377,6 +1404,9 @@ void RuntimeOption::Load(
                  "Eval.DumpPreciseProfData", couldDump);
     Config::Bind(ProfDataTTLHours, ini, config,
                  "Eval.ProfDataTTLHours", ProfDataTTLHours);
+    Config::Bind(ProfDataBytecodeMatching, ini, config,
+                 "Eval.ProfDataBytecodeMatching",
+                 ProfDataBytecodeMatching);
 
     if (EnableHipHopSyntax) {
       // If EnableHipHopSyntax is true, it forces EnableXHP to true
@@ -1431,7 +1461,8 @@ void RuntimeOption::Load(
                           false,
                           EvalProfileHWExcludeKernel,
                           EvalProfileHWFastReads,
-                          EvalProfileHWExportInterval);
+                          EvalProfileHWExportInterval,
+                          EvalProfileHWGroupedEvents);
 
     Config::Bind(EnableIntrinsicsExtension, ini,
                  config, "Eval.EnableIntrinsicsExtension",
@@ -1667,9 +1698,21 @@ void RuntimeOption::Load(
                  ServerThreadJobLIFOSwitchThreshold);
     Config::Bind(ServerThreadJobMaxQueuingMilliSeconds, ini, config,
                  "Server.ThreadJobMaxQueuingMilliSeconds", -1);
+    Config::Bind(ServerQueuingBudgetHeader, ini, config,
+                 "Server.QueuingBudgetHeader", "");
+    Config::Bind(ServerRequestPriorityHeader, ini, config,
+                 "Server.RequestPriorityHeader", "");
+    Config::Bind(ServerCoalesceDuplicateGets, ini, config,
+                 "Server.CoalesceDuplicateGets", false);
+    Config::Bind(ServerChunkedEgressBackpressureSeconds, ini, config,
+                 "Server.ChunkedEgressBackpressureSeconds", 0);
+    Config::Bind(ServerReadyJitMaturityThreshold, ini, config,
+                 "Server.ReadyJitMaturityThreshold", 0);
     Config::Bind(ServerThreadDropStack, ini, config, "Server.ThreadDropStack");
     Config::Bind(ServerHttpSafeMode, ini, config, "Server.HttpSafeMode");
     Config::Bind(ServerStatCache, ini, config, "Server.StatCache", false);
+    Config::Bind(ServerStatCacheForStreams, ini, config,
+                 "Server.StatCacheStreams", false);
     Config::Bind(ServerFixPathInfo, ini, config, "Server.FixPathInfo", false);
     Config::Bind(ServerAddVaryEncoding, ini, config, "Server.AddVaryEncoding",
                  ServerAddVaryEncoding);
@@ -1682,6 +1725,7 @@ void RuntimeOption::Load(
     Config::Bind(ServerWarmupConcurrently, ini, config,
                  "Server.WarmupConcurrently", false);
     Config::Bind(ServerWarmupRequests, ini, config, "Server.WarmupRequests");
+    Config::Bind(ServerWarmupClasses, ini, config, "Server.WarmupClasses");
     Config::Bind(ServerCleanupRequest, ini, config, "Server.CleanupRequest");
     Config::Bind(ServerInternalWarmupThreads, ini, config,
                  "Server.InternalWarmupThreads", 0);  // 0 = skip
@@ -1692,8 +1736,12 @@ void RuntimeOption::Load(
 
     Config::Bind(RequestTimeoutSeconds, ini, config,
                  "Server.RequestTimeoutSeconds", 0);
+    Config::Bind(RequestCPUTimeoutSeconds, ini, config,
+                 "Server.RequestCPUTimeoutSeconds", 0);
     Config::Bind(MaxRequestAgeFactor, ini, config, "Server.MaxRequestAgeFactor",
                  0);
+    Config::Bind(TreadmillLagBudgetSeconds, ini, config,
+                 "Server.TreadmillLagBudgetSeconds", 0);
     Config::Bind(PspTimeoutSeconds, ini, config, "Server.PspTimeoutSeconds", 0);
     Config::Bind(PspCpuTimeoutSeconds, ini, config,
                  "Server.PspCpuTimeoutSeconds", 0);
@@ -1785,6 +1833,14 @@ void RuntimeOption::Load(
                  "Server.SSLCertificateKeyFile");
     Config::Bind(SSLCertificateDir, ini, config, "Server.SSLCertificateDir");
     Config::Bind(SSLTicketSeedFile, ini, config, "Server.SSLTicketSeedFile");
+    Config::Bind(SSLSessionCache, ini, config, "Server.SSLSessionCache",
+                 false);
+    Config::Bind(SSLSessionCacheSize, ini, config,
+                 "Server.SSLSessionCacheSize", 20480);
+    Config::Bind(SSLSessionLifetimeSeconds, ini, config,
+                 "Server.SSLSessionLifetimeSeconds", 7200);
+    Config::Bind(SSLSessionContextId, ini, config,
+                 "Server.SSLSessionContextId", "hhvm");
     Config::Bind(TLSDisableTLS1_2, ini, config, "Server.TLSDisableTLS1_2",
                  false);
     Config::Bind(TLSClientCipherSpec, ini, config,
@@ -2030,6 +2086,9 @@ void RuntimeOption::Load(
 
     Config::Bind(NativeStackTrace, ini, config, "Debug.NativeStackTrace");
     StackTrace::Enabled = NativeStackTrace;
+    Config::Bind(StackTrace::UseFramePointers, ini, config,
+                 "Debug.StackTraceFramePointers",
+                 StackTrace::UseFramePointers);
     Config::Bind(ServerErrorMessage, ini, config, "Debug.ServerErrorMessage");
     Config::Bind(RecordInput, ini, config, "Debug.RecordInput");
     Config::Bind(ClearInputOnSuccess, ini, config, "Debug.ClearInputOnSuccess",
@@ -2090,6 +2149,8 @@ void RuntimeOption::Load(
                  "Stats.ProfilerMaxTraceBuffer", 0);
     Config::Bind(TrackPerUnitMemory, ini, config,
                  "Stats.TrackPerUnitMemory", false);
+    Config::Bind(BootStats::ProfileFile, ini, config,
+                 "Stats.BootProfileFile", BootStats::ProfileFile);
   }
   {
     Config::Bind(ServerVariables, ini, config, "ServerVariables");
@@ -2150,6 +2211,8 @@ void RuntimeOption::Load(
     Config::Bind(XenonPeriodSeconds, ini, config, "Xenon.Period", 0.0);
     Config::Bind(XenonRequestFreq, ini, config, "Xenon.RequestFreq", 1);
     Config::Bind(XenonForceAlwaysOn, ini, config, "Xenon.ForceAlwaysOn", false);
+    Config::Bind(XenonSampleBudgetPerSecond, ini, config,
+                 "Xenon.SampleBudgetPerSecond", 0);
   }
   {
     // We directly read zend.assertions here, so that we can get its INI value
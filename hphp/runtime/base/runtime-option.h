@@ -134,6 +134,9 @@ struct RuntimeOption {
 
   static std::string AccessLogDefaultFormat;
   static std::map<std::string, AccessLogFileData> AccessLogs;
+  // Queue formatted access log lines for a per-writer flush thread that
+  // writes them in batches, instead of writing on the request thread.
+  static bool AsyncAccessLog;
 
   static std::string AdminLogFormat;
   static std::string AdminLogFile;
@@ -163,10 +166,39 @@ struct RuntimeOption {
   static int ServerThreadDropCacheTimeoutSeconds;
   static int ServerThreadJobLIFOSwitchThreshold;
   static int ServerThreadJobMaxQueuingMilliSeconds;
+  // Name of a request header carrying the request's queuing budget in
+  // milliseconds.  When set, a request queued longer than its budget is
+  // failed with a 503 instead of being executed.  Empty disables.
+  static std::string ServerQueuingBudgetHeader;
+  // Name of a request header carrying the request's priority as a
+  // non-negative integer (0 = lowest, the default for requests without
+  // the header).  When set and the host health monitor degrades, the
+  // lowest priorities are shed with a 503 before the box tips over:
+  // Cautious sheds priority 0, NoMore priorities <= 1, BackOff
+  // priorities <= 2.  Empty disables shedding.
+  static std::string ServerRequestPriorityHeader;
+  // Coalesce identical in-flight GET requests: duplicates park on the
+  // request already executing and replay its response instead of running
+  // the page again.  Only requests without credentials participate.
+  static bool ServerCoalesceDuplicateGets;
+  // When positive, a worker thread streaming a chunked response waits up
+  // to this many seconds (per chunk) while the client isn't draining the
+  // response, instead of buffering the rest of the response in memory.
+  // Zero disables the backpressure.
+  static int ServerChunkedEgressBackpressureSeconds;
+  // Minimum jit.maturity (0-100) before /check-ready reports the server
+  // ready and before warmup stops throttling the worker pool.  Zero
+  // leaves readiness and warmup gated on request counts alone.
+  static int ServerReadyJitMaturityThreshold;
   static bool AlwaysDecodePostDataDefault;
   static bool ServerThreadDropStack;
   static bool ServerHttpSafeMode;
   static bool ServerStatCache;
+  // Serve stream-wrapper stat/exists probes from the stat cache as well.
+  // Only effective together with Server.StatCache; mutating operations
+  // through the wrapper invalidate their paths inline, everything else is
+  // picked up from inotify at request boundaries.
+  static bool ServerStatCacheForStreams;
   static bool ServerFixPathInfo;
   static bool ServerAddVaryEncoding;
   static bool ServerLogSettingsOnStartup;
@@ -174,6 +206,7 @@ struct RuntimeOption {
   static bool ServerForkLogging;
   static bool ServerWarmupConcurrently;
   static std::vector<std::string> ServerWarmupRequests;
+  static std::vector<std::string> ServerWarmupClasses;
   static std::string ServerCleanupRequest;
   static int ServerInternalWarmupThreads;
   static boost::container::flat_set<std::string> ServerHighPriorityEndPoints;
@@ -185,9 +218,17 @@ struct RuntimeOption {
   static bool PageletServerThreadDropStack;
 
   static int RequestTimeoutSeconds;
+  // Default per-request CPU budget, in seconds of thread CPU time.  Unlike
+  // RequestTimeoutSeconds this doesn't advance while a request is blocked
+  // in IO or async waits, so it throttles CPU hogs without killing
+  // well-behaved slow-IO requests.  0 disables.
+  static int RequestCPUTimeoutSeconds;
   static int PspTimeoutSeconds;
   static int PspCpuTimeoutSeconds;
   static int64_t MaxRequestAgeFactor;
+  // Time out (rather than abort) the oldest in-flight request once it has
+  // been pinning the treadmill for this many seconds.  0 disables.
+  static int64_t TreadmillLagBudgetSeconds;
   static int64_t RequestMemoryMaxBytes;
   // Threshold for aborting when host is low on memory.
   static int64_t RequestMemoryOOMKillBytes;
@@ -275,6 +316,14 @@ struct RuntimeOption {
   static std::string SSLCertificateKeyFile;
   static std::string SSLCertificateDir;
   static std::string SSLTicketSeedFile;
+  // TLS session resumption.  Ticket resumption spans every process that
+  // reads the same SSLTicketSeedFile; the session-ID cache covers
+  // ticketless clients.  Siblings advertise SSLSessionContextId so clients
+  // treat them as one resumption domain.
+  static bool SSLSessionCache;
+  static int SSLSessionCacheSize;
+  static int SSLSessionLifetimeSeconds;
+  static std::string SSLSessionContextId;
   static bool TLSDisableTLS1_2;
   static std::string TLSClientCipherSpec;
   static bool EnableSSLWithPlainText;
@@ -456,6 +505,7 @@ struct RuntimeOption {
   static uint32_t EvalInitialNamedEntityTableSize;
   static JitSerdesMode EvalJitSerdesMode;
   static int ProfDataTTLHours;
+  static bool ProfDataBytecodeMatching;
   static std::string EvalJitSerdesFile;
   static bool DumpPreciseProfData;
 
@@ -587,6 +637,17 @@ struct RuntimeOption {
   F(int, JitThreads,                   4)                               \
   F(int, JitWorkerThreads,             Process::GetCPUCount() / 2)      \
   F(int, JitWorkerThreadsForSerdes,    0)                               \
+  F(int, JitWorkerThreadsNice,         0)                               \
+  /* When retranslateAll is forced at startup (i.e. after deserializing
+   * profile data), wait for it to finish before serving requests, so a
+   * freshly booted server runs optimized translations from its first
+   * request. */                                                        \
+  F(bool, JitRetranslateAllBlocking,   false)                           \
+  F(bool, JitBackgroundRetranslateOpt, false)                           \
+  /* During retranslateAll, functions with at least this many regions
+   * have each region translated as its own worker job instead of
+   * serially within the function's job.  0 disables the splitting. */  \
+  F(uint32_t, JitParallelRegionThreshold, 8)                            \
   F(int, JitWorkerArenas,              Process::GetCPUCount() / 4)      \
   F(bool, JitDesProfDataAfterRetranslateAll, true)                      \
   F(int, JitLdimmqSpan,                8)                               \
@@ -716,29 +777,96 @@ struct RuntimeOption {
   F(bool, PerfDataMap,                 false)                           \
   F(bool, KeepPerfPidMap,              false)                           \
   F(int32_t, PerfRelocate,             0)                               \
+  /* Relocate the hottest translations into code.hot every this many
+   * seconds, in the order given by a fresh round of perf samples.
+   * Requires Eval.PerfRelocate; 0 disables the periodic pass. */       \
+  F(uint32_t, PerfRelocateInterval,    0)                               \
+  /* How long each periodic relocation pass samples with perf. */      \
+  F(uint32_t, PerfRelocateSampleTime,  20)                              \
+  /* Kick a live relocation pass when the interior free space of the
+   * TC's code blocks exceeds this percentage of their used bytes.
+   * Only does anything with Eval.EnableReusableTC, since nothing else
+   * creates holes; 0 disables the check. */                            \
+  F(uint32_t, TCFragmentationRelocateThreshold, 0)                      \
   F(uint32_t, ThreadTCMainBufferSize,  6 << 20)                         \
   F(uint32_t, ThreadTCColdBufferSize,  6 << 20)                         \
   F(uint32_t, ThreadTCFrozenBufferSize,4 << 20)                         \
   F(uint32_t, ThreadTCDataBufferSize,  256 << 10)                       \
   F(uint32_t, JitTargetCacheSize,      64 << 20)                        \
   F(uint32_t, HHBCArenaChunkSize,      10 << 20)                        \
+  /* Back the HHBC arena's chunks with transparent huge pages, so the  \
+   * interpreter's bytecode fetches take fewer TLB misses during       \
+   * warmup.  Repo preloading fills the arena hottest-units-first, so  \
+   * the hot bytecode ends up packed together in the first chunks. */  \
+  F(bool, HHBCArenaHugePages,          hugePagesSoundNice())            \
   F(bool, ProfileBC,                   false)                           \
   F(bool, ProfileHeapAcrossRequests,   false)                           \
   F(bool, ProfileHWEnable,             true)                            \
   F(string, ProfileHWEvents,           std::string(""))                 \
   F(bool, ProfileHWExcludeKernel,      false)                           \
   F(bool, ProfileHWFastReads,          false)                           \
+  /* Also open cycles, instructions, cache-misses and branch-misses as  \
+   * one kernel perf event group, scheduled and read out together, so   \
+   * per-request ratios between them (notably IPC) are coherent.  The   \
+   * members export under "grp-" names. */                              \
+  F(bool, ProfileHWGroupedEvents,      false)                           \
   F(bool, ProfileHWStructLog,          false)                           \
   F(int32_t, ProfileHWExportInterval,  30)                              \
+  /* Sample one native allocation site per this many bytes of request \
+   * allocation, aggregated process-wide and queryable over the admin \
+   * server as /prof-alloc.  0 disables sampling. */                   \
+  F(uint64_t, ProfileAllocSampleBytes, 0)                               \
+  /* Accumulate a profile-weighted access count per RDS symbol while   \
+   * emitting optimized translations.  The resulting heat report is    \
+   * available through the vm-rds-heat admin command. */               \
+  F(bool, ProfileRDSHeat,              false)                           \
   F(bool, JitAlwaysInterpOne,          false)                           \
+  /* Before executing each interpreted instruction, decode the         \
+   * following instruction's opcode and prefetch its handler, so the   \
+   * dispatch target is warm by the time the current handler's tail    \
+   * jump executes.  Only affects the computed-goto dispatch loop. */  \
+  F(bool, InterpHandlerPrefetch,       false)                           \
   F(int32_t, JitNopInterval,           0)                               \
   F(uint32_t, JitMaxTranslations,      10)                              \
   F(uint32_t, JitMaxProfileTranslations, 30)                            \
   F(uint32_t, JitTraceletGuardsLimit,  5)                               \
   F(uint64_t, JitGlobalTranslationLimit, -1)                            \
   F(int64_t, JitMaxRequestTranslationTime, -1)                          \
+  /* Maximum total wall-clock time, in microseconds, to spend JIT-     \
+   * compiling any single function.  Once a function exhausts its      \
+   * budget, further Live and Optimize translations of it are refused, \
+   * so it runs interpreted or in its Profile translations instead of  \
+   * eating more compile time.  A value of 0 disables the budget.  The \
+   * per-function ledger can be inspected with the vm-compile-costs    \
+   * admin command. */                                                 \
+  F(int64_t, JitMaxFuncCompileTime,    0)                               \
   F(uint32_t, JitMaxRegionInstrs,      1347)                            \
+  /* If nonzero, prologues for functions whose bytecode is at most     \
+   * this many bytes, makes no calls, and contains no backward control \
+   * flow skip the surprise-flag check normally made on function       \
+   * entry.  Such functions run for a bounded amount of time, so any   \
+   * pending surprise is still delivered promptly at the caller's own  \
+   * checks.  Functions compiled this way do not fire function-entry   \
+   * surprise hooks (e.g. setprofile), so this should only be enabled  \
+   * on servers that never use them.  0 disables the elision. */       \
+  F(uint32_t, JitLeafSurpriseCheckMaxSize, 0)                           \
+  /* Emit the MemoryManager small-allocation fast path (debt check and  \
+   * freelist pop) inline for NewInstanceRaw, instead of always         \
+   * calling the C++ allocator helper.  Covers closures and plain       \
+   * objects with default attributes and no memo slots; the slow path   \
+   * (empty freelist, or allocation debt exhausted and a GC check due)  \
+   * still calls out.  Disabled in debug builds, where the helper's     \
+   * assertions and eager-GC hooks are wanted. */                       \
+  F(bool, JitInlineObjAlloc,           true)                            \
   F(uint32_t, JitProfileInterpRequests, kDefaultProfileInterpRequests)  \
+  /* When > 1, only every Nth eligible request during the profiling     \
+   * window runs as an interpreted profiling request; the others run    \
+   * jitted at full speed.  JitProfileInterpRequests counts the         \
+   * requests actually profiled, so the profile sees the same number    \
+   * of requests, spread across N times as many total requests.  This   \
+   * trades a longer profiling window for much less tail latency while  \
+   * it is open.  1 profiles every request, as before. */               \
+  F(uint32_t, JitProfileRequestStride, 1)                               \
   F(uint32_t, JitMaxAwaitAllUnroll,    8)                               \
   F(bool, JitProfileWarmupRequests,    false)                           \
   F(uint32_t, NumSingleJitRequests,    nsjrDefault())                   \
@@ -769,7 +897,16 @@ struct RuntimeOption {
   F(uint32_t, JitWarmupRateSeconds,    64)                              \
   F(uint32_t, JitWriteLeaseExpiration, 1500) /* in microseconds */      \
   F(int, JitRetargetJumps,             1)                               \
+  /* In optimized translations, emit bind{jmp,jcc} exits against the
+   * target SrcKey's anchor translation when it already has a SrcRec,
+   * instead of materializing a private service-request stub in
+   * frozen. */                                                         \
+  F(bool, JitLazyBindStubs,            false)                           \
   F(bool, HHIRLICM,                    false)                           \
+  /* In optimized translations, drop profile-derived type guards that
+   * merely narrow a type the unit has already proven, e.g. an HHBBC
+   * return type asserted after a call. */                              \
+  F(bool, HHIRSkipProvenTypeGuards,    false)                           \
   F(bool, HHIRSimplification,          true)                            \
   F(bool, HHIRGenOpts,                 true)                            \
   F(bool, HHIRRefcountOpts,            true)                            \
@@ -785,6 +922,18 @@ struct RuntimeOption {
   F(bool, HHIRInlineFrameOpts,         true)                            \
   F(bool, HHIRPartialInlineFrameOpts,  true)                            \
   F(bool, HHIRInlineSingletons,        true)                            \
+  /* Number of leading call arguments to value-profile at FCall sites. \
+   * When profiling shows that a callsite always passes the same Bool  \
+   * or Int literal for one of them, optimized translations that       \
+   * inline the callee guard on that value and propagate it as a       \
+   * constant into the inlined body, folding branches and dead         \
+   * parameter checks.  0 disables the specialization. */              \
+  F(uint32_t, JitSpecializeInlinedArgs, 0)                              \
+  /* Emit a single-entry inline cache in front of the shared memo     \
+   * cache for static memoize wrappers taking one int key: a (key,    \
+   * value) slot in RDS checked with two compares before falling back \
+   * to the hashed lookup. */                                          \
+  F(bool, JitMemoInlineCache,          false)                           \
   F(std::string, InlineRegionMode,     "both")                          \
   F(bool, HHIRGenerateAsserts,         false)                           \
   F(bool, HHIRDeadCodeElim,            true)                            \
@@ -800,6 +949,10 @@ struct RuntimeOption {
   F(bool, HHIREnablePreColoring,       true)                            \
   F(bool, HHIREnableCoalescing,        true)                            \
   F(bool, HHIRAllocSIMDRegs,           true)                            \
+  /* Prefer caller-saved registers for intervals they fully cover,
+   * keeping callee-saved registers free for values that live across
+   * native calls. */                                                   \
+  F(bool, JitXlsPreferCallerSaved,     false)                           \
   F(bool, HHIRStressSpill,             false)                           \
   /* Region compiler flags */                                           \
   F(string,   JitRegionSelector,       regionSelectorDefault())         \
@@ -817,21 +970,41 @@ struct RuntimeOption {
   F(uint32_t, JitPGOUnlikelyDecRefSurvivePercent, 5)                    \
   F(uint32_t, JitPGOUnlikelyDecRefDecrementPercent, 5)                  \
   F(uint32_t, JitPGOReleaseVVMinPercent, 8)                             \
+  /* If nonzero, profile the base class at property accesses whose
+   * class isn't statically known, and specialize optimized
+   * translations on the predicted class (with an inline generic
+   * fallback) when it accounts for at least this percentage of the
+   * profiled samples.  0 disables the prediction. */                   \
+  F(uint32_t, JitPGOPropSlotMinPercent, 0)                              \
   F(bool,     JitPGOArrayGetStress,    false)                           \
   F(double,   JitPGOMinBlockCountPercent, 0.05)                         \
   F(double,   JitPGOMinArcProbability, 0.0)                             \
+  /* If nonzero, when selecting a callee region for inlining, skip
+   * blocks whose profile weight is below this percentage of the
+   * callee's entry weight, inlining just the hot path and leaving the
+   * cold remainder to side-exit. */                                    \
+  F(double,   JitPGOInlineMinBlockCountPercent, 0.0)                    \
   F(uint32_t, JitPGOMaxFuncSizeDupBody, 80)                             \
   F(uint32_t, JitPGORelaxPercent,      100)                             \
   F(uint32_t, JitPGORelaxUncountedToGenPercent, 20)                     \
   F(uint32_t, JitPGORelaxCountedToGenPercent, 75)                       \
   F(uint32_t, JitPGOBindCallThreshold, 50)                              \
   F(double,   JitPGOPushedFuncThreshold, 99.9)                          \
+  /* Minimum percentage of a method call site's profiled receivers that
+   * a chain of exact class checks has to cover before we emit it. */   \
+  F(double,   JitPGOPolyMethodThreshold, 98.0)                          \
   F(bool,     JitPGODumpCallGraph,     false)                           \
   F(bool,     JitPGORacyProfiling,     false)                           \
   F(uint64_t, FuncCountHint,           10000)                           \
   F(uint64_t, PGOFuncCountHint,        1000)                            \
   F(uint32_t, HotFuncCount,            4100)                            \
   F(bool, RegionRelaxGuards,           true)                            \
+  /* If nonzero, once a SrcKey has serviced this many REQ_RETRANSLATEs
+   * (i.e. every translation in its chain failed a guard that many
+   * times), form its subsequent retranslations with relaxed guards,
+   * additionally widening specialized guards.  0 disables the
+   * feedback. */                                                       \
+  F(uint32_t, JitGuardFailureRelaxThreshold, 0)                         \
   /* DumpBytecode =1 dumps user php, =2 dumps systemlib & user php */   \
   F(int32_t, DumpBytecode,             0)                               \
   /* DumpHhas =1 dumps user php, =2 dumps systemlib & user php */       \
@@ -856,6 +1029,16 @@ struct RuntimeOption {
   F(bool, LowStaticArrays,             true)                            \
   F(int64_t, HeapPurgeWindowSize,      5 * 1000000)                     \
   F(uint64_t, HeapPurgeThreshold,      128 * 1024 * 1024)               \
+  /* Max doublings of the per-size-class refill batch carved by the */  \
+  /* small allocator's slow path; 0 disables magazine growth. */        \
+  F(uint32_t, SmallAllocMagazineMaxShift, 3)                            \
+  /* Max malloc'd slabs kept mapped in the process-global recycle */    \
+  /* cache across requests; 0 disables recycling. */                    \
+  F(uint32_t, SlabRecycleCount,        0)                               \
+  /* Per-thread slab region reserved by ContiguousHeap (MB); 0 falls */ \
+  /* back to discrete slab allocation. Only used when HHVM is built */  \
+  /* with HHVM_CONTIGUOUS_HEAP. */                                      \
+  F(uint64_t, ContiguousHeapReserveMb,  4096)                           \
   /* GC Options: See heap-collect.cpp for more details */               \
   F(bool, EagerGC,                     eagerGcDefault())                \
   F(bool, FilterGCPoints,              true)                            \
@@ -863,9 +1046,9 @@ struct RuntimeOption {
   F(uint32_t, GCSampleRate,            0)                               \
   F(int64_t, GCMinTrigger,             64L<<20)                         \
   F(double, GCTriggerPct,              0.5)                             \
-  F(bool, GCForAPC,                    false)                           \
-  F(int64_t, GCForAPCTrigger,          1024*1024*1024)                  \
   F(bool, TwoPhaseGC,                  false)                           \
+  F(bool, GCIncremental,               false)                           \
+  F(uint32_t, GCIncrementalSlices,     4)                               \
   F(bool, EnableGC,                    enableGcDefault())               \
   /* End of GC Options */                                               \
   F(bool, RaiseMissingThis,            !EnableHipHopSyntax)             \
@@ -895,7 +1078,21 @@ struct RuntimeOption {
   F(bool, DisableSomeRepoAuthNotices,  true)                            \
   F(uint32_t, PCRETableSize, kPCREInitialTableSize)                     \
   F(uint64_t, PCREExpireInterval, 2 * 60 * 60)                          \
+  /* Byte budget for the lru/scalable pcre caches (0 = unlimited);      \
+   * entries are charged their compiled (and JITed) pattern size and    \
+   * evicted LRU-first when the budget is exceeded. */                  \
+  F(uint64_t, PCRECacheBudgetBytes, 0)                                  \
   F(string, PCRECacheType, std::string("static"))                       \
+  /* File of patterns (one per line, the /dump-pcre-cache admin dump    \
+   * format) compiled into the cache at server start. */                \
+  F(string, PCREPrecompileFile, std::string(""))                        \
+  /* Max number of parsed XML documents shared across requests by       \
+   * DOMDocument::load(); 0 disables the cache. */                      \
+  F(uint32_t, DOMDocumentCacheSize, 0)                                  \
+  /* Trust pushed invalidations (HH\watchman_invalidate_unit) instead   \
+   * of revalidating cached units by stat on every lookup. Non-repo     \
+   * mode only. */                                                      \
+  F(bool, UnitCacheWatchmanInvalidation, false)                         \
   F(bool, EnableCompactBacktrace, true)                                 \
   F(bool, EnableNuma, ServerExecutionMode())                            \
   F(bool, EnableNumaLocal, ServerExecutionMode())                       \
@@ -989,6 +1186,9 @@ struct RuntimeOption {
   F(std::string, UseRemoteUnixServer, "no")                             \
   F(std::string, UnixServerPath, "")                                    \
   F(uint32_t, UnixServerWorkers, Process::GetCPUCount())                \
+  /* Spawn all CLI server workers at startup so short command bursts    \
+   * don't pay thread and VM context creation per invocation. */        \
+  F(bool, UnixServerPrewarmWorkers, false)                              \
   F(bool, UnixServerQuarantineApc, false)                               \
   F(bool, UnixServerQuarantineUnits, false)                             \
   F(bool, UnixServerVerifyExeAccess, false)                             \
@@ -999,6 +1199,10 @@ struct RuntimeOption {
                                             std::vector<std::string>()) \
   /* Options for testing */                                             \
   F(bool, TrashFillOnRequestExit, false)                                \
+  /* Drive wall-clock request timeouts from the shared timer wheel      \
+   * instead of a per-thread POSIX timer, trading one timer syscall     \
+   * per request for a couple of atomic ops. */                         \
+  F(bool, RequestTimerWheel, false)                                     \
   /******************                                                   \
    | ARM   Options. |                                                   \
    *****************/                                                   \
@@ -1026,8 +1230,19 @@ struct RuntimeOption {
    * kept low to avoid the risk of collecting a sample while we're      \
    * processing a previous sample. */                                   \
   F(uint32_t, PerfMemEventSampleFreq, 80)                               \
+  /* Publish a per-region summary of perf-mem-event samples (sample    \
+   * counts, miss counts, total access-latency weight) to the struct   \
+   * log every this many samples.  0 disables the summary. */          \
+  F(uint32_t, PerfMemEventSummaryPeriod, 1024)                          \
   /* Sampling frequency for TC branch profiling. */                     \
   F(uint32_t, ProfBranchSampleFreq, 0)                                  \
+  /* Keep in-process counters for the branches sampled by               \
+   * ProfBranchSampleFreq, and use them to weight arcs whose weights    \
+   * could not be inferred during profile-guided code layout.  This     \
+   * also extends branch sampling to profiling translations, so that    \
+   * the measured weights are available by the time the optimized       \
+   * translations are laid out.  Requires ProfBranchSampleFreq. */      \
+  F(bool, ProfBranchGuidedLayout, false)                                \
   /* Sampling frequency for profiling packed array accesses. */         \
   F(uint32_t, ProfPackedArraySampleFreq, 0)                             \
   /* */
@@ -1062,8 +1277,20 @@ public:
   static bool RepoDebugInfo;
   static bool RepoAuthoritative;
   static bool RepoPreload;
+  // Number of threads used by Repo.Preload; 0 means one per core.
+  static int32_t RepoPreloadThreads;
+  // Maximum number of units Repo.Preload will load, hottest first; 0 means
+  // no limit.
+  static int64_t RepoPreloadLimit;
   static int64_t RepoLocalReadaheadRate;
   static bool RepoLocalReadaheadConcurrent;
+  // If nonzero, read repo databases through a memory map of up to this many
+  // bytes instead of read(2); 0 disables.
+  static int64_t RepoMmapSize;
+  // If true, only size the global litstr table during startup and fault
+  // individual litstrs in from the repo on first use, instead of interning
+  // them all up front.
+  static bool RepoLitstrLazyLoad;
 
   // pprof/hhprof options
   static bool HHProfEnabled;
@@ -1133,6 +1360,9 @@ public:
   static double XenonPeriodSeconds;
   static uint32_t XenonRequestFreq;
   static bool XenonForceAlwaysOn;
+  // When non-zero, caps process-wide Xenon samples per second; over-budget
+  // samples are dropped and request selection backs off. Timer mode only.
+  static uint32_t XenonSampleBudgetPerSecond;
 };
 static_assert(sizeof(RuntimeOption) == 1, "no instance variables");
 
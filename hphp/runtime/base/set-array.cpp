@@ -397,6 +397,63 @@ Cell SetArray::getElm(ssize_t ei) const {
 
 //////////////////////////////////////////////////////////////////////
 
+ArrayData* SetArray::Intersect(const ArrayData* adl, const ArrayData* adr) {
+  auto const lhs = asSet(adl);
+  auto const rhs = asSet(adr);
+  if (lhs->m_size == 0 || rhs->m_size == 0) {
+    return staticEmptyKeysetArray();
+  }
+  auto const ad = asSet(MakeReserveSet(std::min(lhs->m_size, rhs->m_size)));
+  auto const elms = lhs->data();
+  auto const used = lhs->m_used;
+  auto const rtable = rhs->hashTab();
+  auto const rmask = rhs->mask();
+  for (uint32_t i = 0; i < used; ++i) {
+    auto const& e = elms[i];
+    if (UNLIKELY(e.isInvalid())) continue;
+    // Probe a few elements ahead so the dependent loads on rhs's buckets
+    // overlap with this iteration's compare-and-insert work.
+    if (i + 4 < used && !elms[i + 4].isInvalid()) {
+      __builtin_prefetch(&rtable[elms[i + 4].hash() & rmask], 0, 2);
+    }
+    if (!validPos(rhs->findElm(e))) continue;
+    if (e.hasIntKey()) {
+      ad->insert(e.intKey(), e.hash());
+    } else {
+      ad->insert(e.strKey(), e.hash());
+    }
+  }
+  return ad;
+}
+
+ArrayData* SetArray::Union(const ArrayData* adl, const ArrayData* adr) {
+  auto const lhs = asSet(adl);
+  auto const rhs = asSet(adr);
+  if (lhs->m_size == 0 && rhs->m_size == 0) {
+    return staticEmptyKeysetArray();
+  }
+  auto const ad = asSet(MakeReserveSet(lhs->m_size + rhs->m_size));
+  auto const copyFrom = [&] (const SetArray* src) {
+    auto const elms = src->data();
+    auto const used = src->m_used;
+    for (uint32_t i = 0; i < used; ++i) {
+      auto const& e = elms[i];
+      if (UNLIKELY(e.isInvalid())) continue;
+      // insert() is a no-op when the key is already present.
+      if (e.hasIntKey()) {
+        ad->insert(e.intKey(), e.hash());
+      } else {
+        ad->insert(e.strKey(), e.hash());
+      }
+    }
+  };
+  copyFrom(lhs);
+  copyFrom(rhs);
+  return ad;
+}
+
+//////////////////////////////////////////////////////////////////////
+
 NEVER_INLINE
 SetArray* SetArray::grow(bool copy) {
   assertx(m_size > 0);
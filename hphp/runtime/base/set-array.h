@@ -190,11 +190,6 @@ public:
 
   static void Release(ArrayData*);
   static void ReleaseUncounted(ArrayData*);
-  /*
-   * Recursively register {allocation, rootAPCHandle} with APCGCManager
-   */
-  static void RegisterUncountedAllocations(ArrayData* ad,
-                                           APCHandle* rootAPCHandle);
 
   /*
    * Safe downcast helpers.
@@ -210,6 +205,16 @@ public:
   static ArrayData* AddToSet(ArrayData*, int64_t, bool);
   static ArrayData* AddToSet(ArrayData*, StringData*, bool);
 
+  /*
+   * Native set algebra on two keysets.  Both return a new keyset with a
+   * reference transferred to the caller; element order follows the left
+   * operand (Union appends the right operand's new elements).  The kernels
+   * walk one array's element vector and probe the other array's hash table
+   * with the hashes already stored in each element, so no key is rehashed.
+   */
+  static ArrayData* Intersect(const ArrayData*, const ArrayData*);
+  static ArrayData* Union(const ArrayData*, const ArrayData*);
+
 private:
   static bool ClearElms(Elm* elms, uint32_t count);
 
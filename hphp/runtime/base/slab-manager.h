@@ -96,6 +96,19 @@ struct TaggedSlabList {
   // Divide a preallocated piece of memory into slabs and add to the list.
   NEVER_INLINE void addRange(void* ptr, std::size_t size);
 
+  // Try to pop a slab off the list; returns a null TaggedSlabPtr when empty.
+  TaggedSlabPtr tryAlloc() {
+    while (auto currHead = m_head.load(std::memory_order_acquire)) {
+      auto const ptr = reinterpret_cast<AtomicTaggedSlabPtr*>(currHead.ptr());
+      auto next = ptr->load(std::memory_order_acquire);
+      if (m_head.compare_exchange_weak(currHead, next,
+                                       std::memory_order_release)) {
+        return currHead;
+      }
+    }
+    return nullptr;
+  }
+
  protected:
   AtomicTaggedSlabPtr m_head;
 };
@@ -112,18 +125,6 @@ struct SlabManager : TaggedSlabList {
     return s_slabManagers[node];
   }
 
-  TaggedSlabPtr tryAlloc() {
-    while (auto currHead = m_head.load(std::memory_order_acquire)) {
-      auto const ptr =reinterpret_cast<AtomicTaggedSlabPtr*>(currHead.ptr());
-      auto next = ptr->load(std::memory_order_acquire);
-      if (m_head.compare_exchange_weak(currHead, next,
-                                       std::memory_order_release)) {
-        return currHead;
-      }
-    }
-    return nullptr;
-  }
-
   // Push everything in a local TaggedSlabList starting with `newHead` and
   // ending with `localTail` to this global list.  The linking on the local list
   // should be performed before this call. This is intended for returning
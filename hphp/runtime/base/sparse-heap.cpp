@@ -23,6 +23,21 @@ namespace HPHP {
 
 TRACE_SET_MOD(mm);
 
+namespace {
+
+/*
+ * Process-global cache of malloc'd slabs retained across requests, so a
+ * burst of large requests does not re-fault pages the previous burst just
+ * released. Bounded by Eval.SlabRecycleCount slabs; the count check is
+ * racy by design, so the bound is approximate under contention.
+ */
+struct SlabCache : TaggedSlabList {
+  std::atomic<size_t> count{0};
+};
+SlabCache s_slabCache;
+
+}
+
 void SparseHeap::threadInit() {
   m_slabManager = SlabManager::get(s_numaNode);
 }
@@ -61,7 +76,15 @@ void SparseHeap::reset() {
   }
   m_pooled_slabs.clear();
   m_hugeBytes = 0;
+  auto const recycleMax = RuntimeOption::EvalSlabRecycleCount;
   m_bigs.iterate([&](HeapObject* h, size_t size) {
+    if (recycleMax > 0 && size == kSlabSize &&
+        h->kind() == HeaderKind::Slab &&
+        s_slabCache.count.load(std::memory_order_relaxed) < recycleMax) {
+      s_slabCache.count.fetch_add(1, std::memory_order_relaxed);
+      s_slabCache.push_front(h, 0);
+      return;
+    }
     do_free(h, size);
   });
   m_bigs.clear();
@@ -100,6 +123,13 @@ HeapObject* SparseHeap::allocSlab(MemoryUsageStats& stats) {
       return finish(slab.ptr());
     }
   }
+  if (auto cached = s_slabCache.tryAlloc()) {
+    s_slabCache.count.fetch_sub(1, std::memory_order_relaxed);
+    m_bigs.insert((HeapObject*)cached.ptr(), kSlabSize);
+    stats.malloc_cap += kSlabSize;
+    stats.peakCap = std::max(stats.peakCap, stats.capacity());
+    return finish(cached.ptr());
+  }
 #ifdef USE_JEMALLOC
   void* slab = mallocx(kSlabSize, MALLOCX_ALIGN(kSlabAlign));
   auto usable = sallocx(slab, 0);
@@ -937,5 +937,29 @@ std::string StatCache::realpath(const char* path) {
   return s_sc.realpathImpl(path);
 }
 
+void StatCache::invalidatePath(const std::string& path) {
+  if (!RuntimeOption::ServerStatCache) return;
+  s_sc.invalidatePathImpl(path);
+}
+
+void StatCache::invalidatePathImpl(const std::string& path) {
+  NodePtr p;
+  {
+    NameNodeMap::const_accessor acc;
+    if (m_path2Node.find(acc, path)) {
+      p = acc->second;
+    }
+  }
+  if (p) p->touch();
+  p = nullptr;
+  {
+    NameNodeMap::const_accessor acc;
+    if (m_lpath2Node.find(acc, path)) {
+      p = acc->second;
+    }
+  }
+  if (p) p->touch();
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 }
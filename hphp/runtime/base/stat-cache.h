@@ -100,6 +100,9 @@ struct StatCache {
   static int lstat(const std::string& path, struct stat* buf);
   static std::string readlink(const std::string& path);
   static std::string realpath(const char* path);
+  // Invalidate any cached state for a path this process just mutated,
+  // rather than waiting for the inotify notification to come back around.
+  static void invalidatePath(const std::string& path);
 
  private:
   bool init();
@@ -117,6 +120,7 @@ struct StatCache {
   time_t lastRefresh();
   int statImpl(const std::string& path, struct stat* buf);
   int lstatImpl(const std::string& path, struct stat* buf);
+  void invalidatePathImpl(const std::string& path);
   std::string readlinkImpl(const std::string& path);
   std::string realpathImpl(const char* path);
 
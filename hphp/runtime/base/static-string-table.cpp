@@ -135,14 +135,26 @@ struct EmbeddedStringMap {
   bool inited;
 };
 
-EmbeddedStringMap s_stringDataMap;
+// Shard the table by hash so concurrent interning (most visibly the
+// warmup storm when many units load at once) doesn't contend on one
+// map's head array and submap-growth lock.  Must be a power of two.
+constexpr uint32_t kNumStringTableShards = 8;
+
+EmbeddedStringMap s_stringDataMap[kNumStringTableShards];
+
+// Shard on upper hash bits; AHM derives its probe sequence from the
+// lower ones.
+ALWAYS_INLINE EmbeddedStringMap& shardFor(strhash_t h) {
+  return s_stringDataMap[(uint32_t(h) >> 24) & (kNumStringTableShards - 1)];
+}
 
 // If a string is static it better be the one in the table.
 DEBUG_ONLY bool checkStaticStr(const StringData* s) {
   assertx(s->isStatic());
-  assertx(s_stringDataMap);
-  auto DEBUG_ONLY const it = s_stringDataMap->find(s);
-  assertx(it != s_stringDataMap->end());
+  auto& map = shardFor(s->hash());
+  assertx(map);
+  auto DEBUG_ONLY const it = map->find(s);
+  assertx(it != map->end());
   assertx(to_sdata(it->first) == s);
   return true;
 }
@@ -159,7 +171,8 @@ StringData** precompute_chars() {
 
 StringData* insertStaticString(StringData* sd) {
   assertx(sd->isStatic());
-  auto pair = s_stringDataMap->insert(
+  auto& map = shardFor(sd->hash());
+  auto pair = map->insert(
     safe_cast<StrInternKey>(reinterpret_cast<uintptr_t>(sd)),
     rds::Link<TypedValue, rds::Mode::NonLocal>{}
   );
@@ -174,7 +187,7 @@ StringData* insertStaticString(StringData* sd) {
       data_map::register_start(sd);
     }
     static std::atomic<bool> signaled{false};
-    checkAHMSubMaps(*s_stringDataMap, "static string table", signaled);
+    checkAHMSubMaps(*map, "static string table", signaled);
   }
   assertx(to_sdata(pair.first->first) != nullptr);
 
@@ -186,14 +199,17 @@ inline StringData* insertStaticStringSlice(folly::StringPiece slice) {
 }
 
 void create_string_data_map() {
-  always_assert(!s_stringDataMap);
+  always_assert(!s_stringDataMap[0]);
   StringDataMap::Config config;
   config.growthFactor = 1;
   config.entryCountThreadCacheSize = 10;
   MemoryStats::GetInstance()->ResetStaticStringSize();
 
-  s_stringDataMap.emplace(RuntimeOption::EvalInitialStaticStringTableSize,
-                          config);
+  auto const sizePerShard =
+    RuntimeOption::EvalInitialStaticStringTableSize / kNumStringTableShards + 1;
+  for (auto& shard : s_stringDataMap) {
+    shard.emplace(sizePerShard, config);
+  }
   insertStaticString(StringData::MakeEmpty());
 }
 
@@ -204,8 +220,12 @@ void create_string_data_map() {
 StringData** precomputed_chars = precompute_chars();
 
 size_t makeStaticStringCount() {
-  if (!s_stringDataMap) return 0;
-  return s_stringDataMap->size();
+  if (!s_stringDataMap[0]) return 0;
+  size_t count = 0;
+  for (auto& shard : s_stringDataMap) {
+    count += shard->size();
+  }
+  return count;
 }
 
 StringData* makeStaticString(const StringData* str) {
@@ -213,25 +233,28 @@ StringData* makeStaticString(const StringData* str) {
     assertx(checkStaticStr(str));
     return const_cast<StringData*>(str);
   }
-  auto const it = s_stringDataMap->find(str);
-  if (it != s_stringDataMap->end()) {
+  auto& map = shardFor(str->hash());
+  auto const it = map->find(str);
+  if (it != map->end()) {
     return const_cast<StringData*>(to_sdata(it->first));
   }
   return insertStaticStringSlice(str->slice());
 }
 
 StringData* makeStaticString(folly::StringPiece slice) {
-  auto const it = s_stringDataMap->find(slice);
-  if (it != s_stringDataMap->end()) {
+  auto& map = shardFor(StringData::hash(slice.data(), slice.size()));
+  auto const it = map->find(slice);
+  if (it != map->end()) {
     return const_cast<StringData*>(to_sdata(it->first));
   }
   return insertStaticStringSlice(slice);
 }
 
 StringData* lookupStaticString(const StringData *str) {
-  assertx(s_stringDataMap && !str->isStatic());
-  auto const it = s_stringDataMap->find(str);
-  if (it != s_stringDataMap->end()) {
+  assertx(s_stringDataMap[0] && !str->isStatic());
+  auto& map = shardFor(str->hash());
+  auto const it = map->find(str);
+  if (it != map->end()) {
     return const_cast<StringData*>(to_sdata(it->first));
   }
   return nullptr;
@@ -263,23 +286,24 @@ StringData* makeStaticString(char c) {
 
 StringData* makeStaticStringSafe(const char* str, size_t len) {
   assertx(len <= StringData::MaxSize);
-  if (UNLIKELY(!s_stringDataMap)) {
+  if (UNLIKELY(!s_stringDataMap[0])) {
     create_string_data_map();
   }
   return makeStaticString(str, len);
 }
 
 StringData* makeStaticStringSafe(const char* str) {
-  if (UNLIKELY(!s_stringDataMap)) {
+  if (UNLIKELY(!s_stringDataMap[0])) {
     create_string_data_map();
   }
   return makeStaticString(str);
 }
 
 bool bindPersistentCns(const StringData* cnsName, const Cell& value) {
-  assertx(s_stringDataMap);
-  auto const it = s_stringDataMap->find(cnsName);
-  assertx(it != s_stringDataMap->end());
+  auto& map = shardFor(cnsName->hash());
+  assertx(map);
+  auto const it = map->find(cnsName);
+  assertx(it != map->end());
   it->second.bind(
     [&] {
       auto const handle =
@@ -294,9 +318,10 @@ bool bindPersistentCns(const StringData* cnsName, const Cell& value) {
 }
 
 rds::Handle lookupCnsHandle(const StringData* cnsName) {
-  assertx(s_stringDataMap);
-  auto const it = s_stringDataMap->find(cnsName);
-  if (it != s_stringDataMap->end()) {
+  auto& map = shardFor(cnsName->hash());
+  assertx(map);
+  auto const it = map->find(cnsName);
+  if (it != map->end()) {
     return it->second.maybeHandle();
   }
   return rds::kUninitHandle;
@@ -311,8 +336,9 @@ rds::Handle makeCnsHandle(const StringData* cnsName) {
     // the request local rds::s_constants instead.
     return rds::kUninitHandle;
   }
-  auto const it = s_stringDataMap->find(cnsName);
-  assertx(it != s_stringDataMap->end());
+  auto& map = shardFor(cnsName->hash());
+  auto const it = map->find(cnsName);
+  assertx(it != map->end());
   if (!it->second.bound()) {
     it->second.bind<kTVSimdAlign>(rds::Mode::Normal);
 
@@ -323,12 +349,13 @@ rds::Handle makeCnsHandle(const StringData* cnsName) {
 }
 
 std::vector<StringData*> lookupDefinedStaticStrings() {
-  assertx(s_stringDataMap);
+  assertx(s_stringDataMap[0]);
   std::vector<StringData*> ret;
 
-  for (auto it = s_stringDataMap->begin();
-       it != s_stringDataMap->end(); ++it) {
-    ret.push_back(const_cast<StringData*>(to_sdata(it->first)));
+  for (auto& shard : s_stringDataMap) {
+    for (auto it = shard->begin(); it != shard->end(); ++it) {
+      ret.push_back(const_cast<StringData*>(to_sdata(it->first)));
+    }
   }
 
   return ret;
@@ -339,12 +366,12 @@ const StaticString s_user("user");
 const StaticString s_Core("Core");
 
 Array lookupDefinedConstants(bool categorize /*= false */) {
-  assertx(s_stringDataMap);
+  assertx(s_stringDataMap[0]);
   Array usr(rds::s_constants());
   Array sys;
 
-  for (auto it = s_stringDataMap->begin();
-       it != s_stringDataMap->end(); ++it) {
+  for (auto& shard : s_stringDataMap) {
+  for (auto it = shard->begin(); it != shard->end(); ++it) {
     if (it->second.bound()) {
       if (!it->second.isInit()) continue;
 
@@ -366,6 +393,7 @@ Array lookupDefinedConstants(bool categorize /*= false */) {
       }
     }
   }
+  }
 
   if (categorize) {
     Array ret;
@@ -378,12 +406,13 @@ Array lookupDefinedConstants(bool categorize /*= false */) {
 }
 
 size_t countStaticStringConstants() {
-  if (!s_stringDataMap) return 0;
+  if (!s_stringDataMap[0]) return 0;
   size_t count = 0;
-  for (auto it = s_stringDataMap->begin();
-       it != s_stringDataMap->end(); ++it) {
-    if (it->second.bound()) {
-      ++count;
+  for (auto& shard : s_stringDataMap) {
+    for (auto it = shard->begin(); it != shard->end(); ++it) {
+      if (it->second.bound()) {
+        ++count;
+      }
     }
   }
   return count;
@@ -392,18 +421,20 @@ size_t countStaticStringConstants() {
 void refineStaticStringTableSize() {
   if (RuntimeOption::EvalInitialStaticStringTableSize ==
       kDefaultInitialStaticStringTableSize ||
-      !s_stringDataMap) {
+      !s_stringDataMap[0]) {
     return;
   }
 
-  std::vector<StringDataMap::value_type>
-    oldStringTable(s_stringDataMap->begin(), s_stringDataMap->end());
-
-  s_stringDataMap.clear();
+  std::vector<StringDataMap::value_type> oldStringTable;
+  oldStringTable.reserve(makeStaticStringCount());
+  for (auto& shard : s_stringDataMap) {
+    oldStringTable.insert(oldStringTable.end(), shard->begin(), shard->end());
+    shard.clear();
+  }
   create_string_data_map();
 
   for (auto& kv : oldStringTable) {
-    s_stringDataMap->insert(kv.first, kv.second);
+    shardFor(to_sdata(kv.first)->hash())->insert(kv.first, kv.second);
   }
 }
 
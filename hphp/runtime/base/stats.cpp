@@ -38,6 +38,20 @@ const char* g_counterNames[] = {
 };
 __thread uint64_t tl_counters[kNumStatCounters];
 
+// Counts of adjacent bytecode pairs executed by the interpreter, indexed by
+// prev * Op_count + cur.  Allocated lazily since it's only populated at
+// stats trace level 3.
+static __thread uint64_t* tl_instrPairs = nullptr;
+
+void incInstrPair(Op prev, Op cur) {
+  if (UNLIKELY(tl_instrPairs == nullptr)) {
+    tl_instrPairs = static_cast<uint64_t*>(
+      calloc(size_t(Op_count) * Op_count, sizeof(uint64_t))
+    );
+  }
+  ++tl_instrPairs[size_t(prev) * Op_count + size_t(cur)];
+}
+
 typedef hphp_const_char_map<hphp_const_char_map<uint64_t>> StatGroupMap;
 __thread StatGroupMap* tl_stat_groups = nullptr;
 
@@ -61,6 +75,25 @@ void dump() {
 #undef STAT
 #undef O
 
+  if (tl_instrPairs) {
+    std::vector<std::pair<size_t,uint64_t>> pairs;
+    auto const n = size_t(Op_count) * Op_count;
+    for (size_t i = 0; i < n; ++i) {
+      if (tl_instrPairs[i]) pairs.emplace_back(i, tl_instrPairs[i]);
+    }
+    std::sort(pairs.begin(), pairs.end(),
+              [] (const std::pair<size_t,uint64_t>& a,
+                  const std::pair<size_t,uint64_t>& b) {
+                return a.second > b.second;
+              });
+    for (auto const& p : pairs) {
+      TRACE(0, "STAT InstrPair %s;%s %15" PRIu64 "\n",
+            opcodeToName(Op(p.first / Op_count)),
+            opcodeToName(Op(p.first % Op_count)),
+            p.second);
+    }
+  }
+
   typedef std::pair<const char*, uint64_t> StatPair;
   for (auto const& group : *tl_stat_groups) {
     std::string stats;
@@ -105,6 +138,10 @@ void clear() {
   if (!enabledAny()) return;
   ++epoch;
   memset(&tl_counters[0], 0, sizeof(tl_counters));
+  if (tl_instrPairs) {
+    memset(tl_instrPairs, 0,
+           size_t(Op_count) * Op_count * sizeof(uint64_t));
+  }
 
   assertx(tl_stat_groups);
   delete tl_stat_groups;
@@ -103,6 +103,10 @@ inline bool enableInstrCount() {
   return Trace::moduleEnabled(Trace::stats, 2);
 }
 
+inline bool enableInstrPairCount() {
+  return Trace::moduleEnabled(Trace::stats, 3);
+}
+
 inline void inc(StatCounter stat, int n = 1) {
   if (enabled()) {
     tl_counters[stat] += n;
@@ -113,6 +117,13 @@ inline StatCounter opToTranslStat(Op opc) {
   return StatCounter(STATS_PER_OPCODE * size_t(opc));
 }
 
+/*
+ * Count an executed pair of adjacent bytecodes in the interpreter.  The
+ * resulting table, dumped with the rest of the stats, is the input for
+ * deciding which bytecode sequences would be worth fusing.
+ */
+void incInstrPair(Op prev, Op cur);
+
 extern void init();
 extern void dump();
 extern void clear();
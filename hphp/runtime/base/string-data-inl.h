@@ -157,6 +157,9 @@ inline strhash_t StringData::hash() const {
 
 inline bool StringData::same(const StringData* s) const {
   assertx(s);
+  // Interned strings (literals, array keys, enum-like values) compare
+  // against themselves all the time; skip the byte compare entirely.
+  if (this == s) return true;
   if (m_len != s->m_len) return false;
   // The underlying buffer and its length are 8-byte aligned, ensured by
   // StringData layout, req::malloc, or malloc. So compare words.
@@ -167,6 +170,7 @@ inline bool StringData::same(const StringData* s) const {
 
 inline bool StringData::isame(const StringData* s) const {
   assertx(s);
+  if (this == s) return true;
   if (m_len != s->m_len) return false;
   return bstrcaseeq(data(), s->data(), m_len);
 }
@@ -109,6 +109,31 @@ StringData* StringData::MakeStatic(folly::StringPiece sl) {
   return MakeShared<true>(sl);
 }
 
+StringData* StringData::MakeStaticAt(folly::StringPiece sl, void* mem) {
+  if (UNLIKELY(sl.size() > StringData::MaxSize)) {
+    raiseStringLengthExceededError(sl.size());
+  }
+  assertx(reinterpret_cast<uintptr_t>(mem) % alignof(StringData) == 0);
+
+  auto const sd = static_cast<StringData*>(mem);
+  auto const data = reinterpret_cast<char*>(sd + 1);
+
+#ifndef NO_M_DATA
+  sd->m_data = data;
+#endif
+  sd->initHeader(HeaderKind::String, StaticValue);
+  sd->m_len = sl.size();
+
+  data[sl.size()] = 0;
+  memcpy(data, sl.data(), sl.size());
+  sd->preCompute();                     // get m_hash right
+
+  assertx(sd->isFlat());
+  assertx(sd->isStatic());
+  assertx(sd->checkSane());
+  return sd;
+}
+
 StringData* StringData::MakeUncounted(folly::StringPiece sl) {
   if (APCStats::IsCreated()) {
     APCStats::getAPCStats().addAPCUncountedBlock();
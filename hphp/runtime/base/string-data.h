@@ -159,6 +159,15 @@ struct StringData final : MaybeCountable,
    */
   static StringData* MakeUncounted(folly::StringPiece);
 
+  /*
+   * Like MakeStatic, but constructs the string in caller-provided memory,
+   * which must be at least sl.size() + kStringOverhead bytes and aligned
+   * for StringData.  The resulting string is never freed; the caller owns
+   * the backing storage.  Used by APCFileStorage to build primed strings
+   * directly inside its file-backed mapping.
+   */
+  static StringData* MakeStaticAt(folly::StringPiece sl, void* mem);
+
   /*
    * Same as MakeStatic but initializes the empty string in aligned storage.
    * This should be called by the static string table initialization code.
@@ -209,12 +218,6 @@ struct StringData final : MaybeCountable,
    */
   static void ReleaseUncounted(const StringData*);
 
-  /*
-   * root is the address of the top-level APCHandle which contains this string
-   * register {allocation, root} with APCGCManager
-   */
-  void registerUncountedAllocation(APCHandle* rootAPCHandle);
-
   /*
    * Reference-counting related.
    */
@@ -46,6 +46,23 @@ StringHolder& StringHolder::operator=(StringHolder&& o) {
   return *this;
 }
 
+std::unique_ptr<folly::IOBuf> StringHolder::detach() {
+  if (m_type == Type::IOBuf) {
+    m_len = m_output ? m_output->length() : 0;
+    m_data = nullptr;
+    return std::move(m_output);
+  }
+  if (m_type == Type::StrFree && m_data) {
+    // IOBuf's default free function pairs with the malloc the compressors
+    // used to allocate this buffer.
+    auto buf = folly::IOBuf::takeOwnership(
+      const_cast<char*>(m_data), m_len);
+    m_data = nullptr;
+    return buf;
+  }
+  return nullptr;
+}
+
 void StringHolder::set(folly::IOBuf *output) {
   m_output = std::unique_ptr<folly::IOBuf>(output);
   m_type = Type::IOBuf;
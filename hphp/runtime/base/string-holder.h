@@ -43,6 +43,14 @@ struct StringHolder {
   /* Set data source */
   void set(folly::IOBuf *output);
 
+  /*
+   * Relinquish ownership of the underlying buffer as an IOBuf, without
+   * copying.  Returns nullptr if the holder doesn't own its data (the
+   * StrNoFree case); the caller must then copy before the holder's
+   * creator frees the buffer.  size() remains valid after detaching.
+   */
+  std::unique_ptr<folly::IOBuf> detach();
+
   uint32_t size() const;
   const char* data() const;
 
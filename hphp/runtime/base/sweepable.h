@@ -29,6 +29,11 @@ namespace HPHP {
  * every request, MemoryManager::sweep() called each Sweepable::sweep()
  * method, allowing objects to clean up resources that are not othewise
  * owned by the current request, for example malloc'd-memory or file handles.
+ *
+ * Sweepable carries two list pointers and a virtual sweep(); if the cleanup
+ * is just "call fn(data)" with no ordering concerns, prefer
+ * MemoryManager::registerTrivialSweep(), which drains all such entries in
+ * one flat pass at the end of sweep().
  */
 struct Sweepable {
   Sweepable(const Sweepable&) = delete;
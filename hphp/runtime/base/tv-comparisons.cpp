@@ -593,6 +593,20 @@ typename Op::RetType cellRelOp(Op op, Cell c1, Cell c2) {
   assertx(cellIsPlausible(c1));
   assertx(cellIsPlausible(c2));
 
+  // Num-vs-num and str-vs-str dominate sort- and dedup-heavy code, so take
+  // them straight to the primitive op instead of through the double type
+  // dispatch below.  Each case matches what the generic dispatch would do
+  // for that pair.
+  if (c1.m_type == KindOfInt64) {
+    if (c2.m_type == KindOfInt64)  return op(c1.m_data.num, c2.m_data.num);
+    if (c2.m_type == KindOfDouble) return op(c1.m_data.num, c2.m_data.dbl);
+  } else if (c1.m_type == KindOfDouble) {
+    if (c2.m_type == KindOfDouble) return op(c1.m_data.dbl, c2.m_data.dbl);
+    if (c2.m_type == KindOfInt64)  return op(c1.m_data.dbl, c2.m_data.num);
+  } else if (isStringType(c1.m_type) && isStringType(c2.m_type)) {
+    return op(c1.m_data.pstr, c2.m_data.pstr);
+  }
+
   switch (c2.m_type) {
   case KindOfUninit:
   case KindOfNull:
@@ -35,8 +35,10 @@
 #include "hphp/runtime/vm/runtime-compiler.h"
 #include "hphp/runtime/vm/treadmill.h"
 #include "hphp/runtime/vm/type-profile.h"
+#include "hphp/runtime/vm/unit.h"
 
 #include "hphp/util/assertions.h"
+#include "hphp/util/logger.h"
 #include "hphp/util/mutex.h"
 #include "hphp/util/process.h"
 #include "hphp/util/rank.h"
@@ -273,8 +275,13 @@ bool isChanged(copy_ptr<CachedUnitWithFree> cachedUnit, const struct stat* s) {
   // successfully stat'd the file, but then it was gone by the time we tried to
   // open() it.
   if (!s) return false;
-  return !cachedUnit ||
-         cachedUnit->cu.unit == nullptr ||
+  if (!cachedUnit || cachedUnit->cu.unit == nullptr) return true;
+  // With Watchman-driven invalidation the stat data is ignored; a cached
+  // unit stays valid until invalidateUnit() retires it.
+  if (RuntimeOption::EvalUnitCacheWatchmanInvalidation) {
+    return stressUnitCache();
+  }
+  return
 #ifdef _MSC_VER
          cachedUnit->mtime - s->st_mtime < 0 ||
 #else
@@ -779,6 +786,74 @@ size_t numLoadedUnits() {
   return s_nonRepoUnitCache.size();
 }
 
+size_t pruneStaleUnits() {
+  always_assert(!RuntimeOption::RepoAuthoritative);
+  size_t pruned = 0;
+
+  // Collect the stale paths first; updating entries while iterating the
+  // concurrent map isn't safe.
+  std::vector<const StringData*> stale;
+  for (auto const& elm : s_nonRepoUnitCache) {
+    auto const cached = elm.second.cachedUnit.copy();
+    if (!cached || !cached->cu.unit) continue;
+    struct stat s;
+    if (StatCache::stat(elm.first->data(), &s) != 0) {
+      stale.push_back(elm.first);
+    }
+  }
+
+  for (auto const path : stale) {
+    NonRepoUnitCache::const_accessor acc;
+    if (!s_nonRepoUnitCache.find(acc, path)) continue;
+    auto& cachedUnit = acc->second.cachedUnit;
+    cachedUnit.lock_for_update();
+    // Re-check under the lock: the file may have reappeared and been
+    // reloaded since we stat'd it.
+    struct stat s;
+    if (StatCache::stat(path->data(), &s) == 0) {
+      cachedUnit.unlock();
+      continue;
+    }
+    // Leave the (tiny) map entry in place rather than erasing it, which
+    // could race with a concurrent lookup repopulating it.  The unit
+    // itself is freed once the treadmill drains any request that may
+    // still be running its code.
+    auto old = cachedUnit.update_and_unlock(copy_ptr<CachedUnitWithFree>{});
+    if (old) {
+      ++pruned;
+      Treadmill::enqueue([unit_to_delete = std::move(old)] () {});
+    }
+  }
+  return pruned;
+}
+
+bool invalidateUnit(const StringData* path) {
+  always_assert(!RuntimeOption::RepoAuthoritative);
+  auto const spath = makeStaticString(path);
+
+  bool retired = false;
+  auto const retire = [&] (NonRepoUnitCache& cache) {
+    NonRepoUnitCache::const_accessor acc;
+    if (!cache.find(acc, spath)) return;
+    auto& cachedUnit = acc->second.cachedUnit;
+    cachedUnit.lock_for_update();
+    // As in pruneStaleUnits(), leave the map entry in place and retire the
+    // unit through the treadmill so requests still running its code are
+    // unaffected.
+    auto old = cachedUnit.update_and_unlock(copy_ptr<CachedUnitWithFree>{});
+    if (old) {
+      retired = true;
+      Treadmill::enqueue([unit_to_delete = std::move(old)] () {});
+    }
+  };
+
+  retire(s_nonRepoUnitCache);
+  for (auto const& entry : s_perUserUnitCaches) {
+    retire(*entry.second);
+  }
+  return retired;
+}
+
 std::vector<Unit*> loadedUnitsRepoAuth() {
   always_assert(RuntimeOption::RepoAuthoritative);
   std::vector<Unit*> units;
@@ -889,8 +964,17 @@ void preloadRepo() {
   }
   if (!units.size()) return;
 
+  // enumerateUnits() returns units hottest-first (ordered by the repo's
+  // preload ranking), so a limit keeps the hottest prefix.
+  auto const limit = RuntimeOption::RepoPreloadLimit;
+  if (limit > 0 && units.size() > size_t(limit)) {
+    units.resize(limit);
+  }
+
   std::vector<std::thread> workers;
-  auto numWorkers = Process::GetCPUCount();
+  auto numWorkers = RuntimeOption::RepoPreloadThreads > 0
+    ? RuntimeOption::RepoPreloadThreads
+    : Process::GetCPUCount();
   // Compute a batch size that causes each thread to process approximately 16
   // batches.  Even if the batches are somewhat imbalanced in what they contain,
   // the straggler workers are very unlikey to take more than 10% longer than
@@ -929,6 +1013,40 @@ void preloadRepo() {
   }
 }
 
+void preloadClasses() {
+  auto const& names = RuntimeOption::ServerWarmupClasses;
+  if (names.empty()) return;
+
+  // Class loading is recursive: loading a class pulls in its parent,
+  // interfaces, and used traits first, so the configured list doesn't need to
+  // be in dependency order.  Classes that qualify for persistent definitions
+  // get defined into persistent RDS here, so their link and init work happens
+  // once per process rather than once per request on every cold RDS; any
+  // classes that don't qualify are still merged per request as usual.
+  std::thread([&] {
+    ProfileNonVMThread nonVM;
+    hphp_thread_init();
+    hphp_session_init(Treadmill::SessionKind::PreloadRepo);
+
+    for (auto const& name : names) {
+      try {
+        if (!Unit::loadClass(String(name).get())) {
+          Logger::FWarning("Server.WarmupClasses: unable to load {}", name);
+        }
+      } catch (...) {
+        // An uncatchable error from an init sequence shouldn't take the
+        // server down during warmup; the class will get another chance to
+        // load per request.
+        Logger::FWarning("Server.WarmupClasses: error loading {}", name);
+      }
+    }
+
+    hphp_context_exit();
+    hphp_session_exit();
+    hphp_thread_exit();
+  }).join();
+}
+
 void clearUnitCacheForExit() {
   s_nonRepoUnitCache.clear();
   s_repoUnitCache.clear();
@@ -79,6 +79,31 @@ std::string mangleUnitMd5(const std::string& fileMd5);
  */
 size_t numLoadedUnits();
 
+/*
+ * Walk the non-repo unit cache and retire the units of files that no
+ * longer exist on disk, so week-long sandbox processes don't
+ * accumulate them forever.  (Units of files that merely changed are
+ * already retired when the new version is loaded.)  The retired units
+ * and their translations are reclaimed through the treadmill.  Returns
+ * the number of units retired.  Exported for the admin request
+ * handler.
+ *
+ * Precondition: !RepoAuthoritative
+ */
+size_t pruneStaleUnits();
+
+/*
+ * Retire the cached unit for `path' (the resolved, absolute path of a
+ * source file) so the next lookup reloads it from disk.  Used by external
+ * change notification (a Watchman subscription calling
+ * HH\watchman_invalidate_unit) together with the
+ * Eval.UnitCacheWatchmanInvalidation option, which turns off per-lookup
+ * stat-based revalidation.  Returns true if a cached unit was retired.
+ *
+ * Precondition: !RepoAuthoritative
+ */
+bool invalidateUnit(const StringData* path);
+
 /*
  * Return a std::vector of all the units currently loaded. Must be
  * called from a single threaded context (wrt other unit-cache functions).
@@ -106,6 +131,15 @@ String resolveVmInclude(StringData* path,
 
 void preloadRepo();
 
+/*
+ * Load the classes listed in Server.WarmupClasses, so that any which qualify
+ * for persistent definitions are linked and initialized once at server start
+ * rather than per request.  Runs in its own warmup session; dependencies
+ * (parents, interfaces, traits) are loaded recursively, so the list need not
+ * be dependency ordered.
+ */
+void preloadClasses();
+
 /*
  * Needed to avoid order of destruction issues. Destroying the unit
  * caches destroys the units, which destroys the classes, which tries
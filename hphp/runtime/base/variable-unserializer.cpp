@@ -19,6 +19,7 @@
 #include <utility>
 
 #include <folly/Conv.h>
+#include <folly/Portability.h>
 #include <folly/Range.h>
 #include <folly/lang/Launder.h>
 
@@ -382,27 +383,57 @@ Variant VariableUnserializer::unserialize() {
 }
 
 namespace {
-std::pair<int64_t,const char*> hh_strtoll_base10(const char* p) {
-  int64_t x = 0;
+
+// True iff all eight bytes of chunk are ASCII digits.
+ALWAYS_INLINE bool allDigits8(uint64_t chunk) {
+  return (((chunk & 0xf0f0f0f0f0f0f0f0ull) |
+           (((chunk + 0x0606060606060606ull) & 0xf0f0f0f0f0f0f0f0ull) >> 4)) ==
+          0x3333333333333333ull);
+}
+
+// SWAR conversion of eight ASCII digits (first digit in the low byte) to
+// their numeric value: fold adjacent digits into 2-, 4-, then 8-digit
+// groups with one multiply per level.
+ALWAYS_INLINE uint32_t convertDigits8(uint64_t chunk) {
+  chunk -= 0x3030303030303030ull;
+  chunk = ((chunk * ((10ull << 8) + 1)) >> 8) & 0x00ff00ff00ff00ffull;
+  chunk = ((chunk * ((100ull << 16) + 1)) >> 16) & 0x0000ffff0000ffffull;
+  return uint32_t((chunk * ((10000ull << 32) + 1)) >> 32);
+}
+
+std::pair<int64_t,const char*> hh_strtoll_base10(const char* p,
+                                                 const char* const end) {
+  uint64_t x = 0;
   bool neg = false;
-  if (*p == '-') {
+  if (p < end && *p == '-') {
     neg = true;
     ++p;
   }
-  while (*p >= '0' && *p <= '9') {
-    x = (x * 10) + ('0' - *p);
-    ++p;
+  // Take digits eight at a time while the run provably continues.  The
+  // declared lengths of large strings and arrays are the interesting case;
+  // one- and two-digit counts fall straight through to the byte loop.
+  if (folly::kIsLittleEndian) {
+    while (p + 8 <= end) {
+      uint64_t chunk;
+      memcpy(&chunk, p, 8);
+      if (!allDigits8(chunk)) break;
+      x = x * 100000000 + convertDigits8(chunk);
+      p += 8;
+    }
   }
-  if (!neg) {
-    x = -x;
+  while (p < end && *p >= '0' && *p <= '9') {
+    x = x * 10 + uint64_t(*p - '0');
+    ++p;
   }
-  return std::pair<int64_t,const char*>(x, p);
+  auto const res = neg ? -int64_t(x) : int64_t(x);
+  return std::pair<int64_t,const char*>(res, p);
 }
+
 }
 
 int64_t VariableUnserializer::readInt() {
   check();
-  auto r = hh_strtoll_base10(m_buf);
+  auto r = hh_strtoll_base10(m_buf, m_end);
   m_buf = r.second;
   return r.first;
 }
@@ -727,8 +758,8 @@ static bool match(const char*& cur,
 }
 
 ALWAYS_INLINE
-static int64_t read64(const char*& cur) {
-  auto p = hh_strtoll_base10(cur);
+static int64_t read64(const char*& cur, const char* const end) {
+  auto p = hh_strtoll_base10(cur, end);
   cur = p.second;
   return p.first;
 }
@@ -740,7 +771,7 @@ static int64_t read64(const char*& cur) {
 ALWAYS_INLINE
 bool readInt64(const char*& cur, const char* const end, int64_t& out) {
   if (!match(cur, "i:", end)) return false;
-  out = read64(cur);
+  out = read64(cur, end);
   return match(cur, ";", end);
 }
 
@@ -752,7 +783,7 @@ ALWAYS_INLINE
 static StringData* readStringData(const char*& cur, const char* const end,
                                   int maxLen) {
   if (!match(cur, "s:", end)) return nullptr;
-  auto len = read64(cur);
+  auto len = read64(cur, end);
   if (len < 0 || len >= maxLen) return nullptr;
   if (!match(cur, ":\"", end)) return nullptr;
   auto const slice = folly::StringPiece(cur, len);
@@ -855,6 +886,12 @@ void VariableUnserializer::unserializeVariant(
   case 's':
     {
       String v = unserializeString();
+      // A string in key position is about to be hashed for the table
+      // insert; computing it here, while the bytes we just copied are
+      // still in cache, also warms m_hash for later uses of the key.
+      if (mode == UnserializeMode::Key) {
+        v.get()->hash();
+      }
       tvMove(make_tv<KindOfString>(v.detach()), self);
       if (!endOfBuffer()) {
         // Semicolon *should* always be required,
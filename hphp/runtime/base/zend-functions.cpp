@@ -158,7 +158,9 @@ DataType is_numeric_string(const char *str, int length, int64_t *lval,
       }
     }
     if (lval) {
-      *lval = (base == 10 ? fast_strtoll_base10(str)
+      // ptr is one past the digit run, so the bounded (SWAR) flavor
+      // can chew the digits eight at a time.
+      *lval = (base == 10 ? fast_strtoll_base10(str, ptr)
                           : strtoll(str, nullptr, base));
     }
     return KindOfInt64;
@@ -164,6 +164,11 @@ void apcExtension::moduleLoad(const IniSetting::Map& ini, Hdf config) {
   Config::Bind(HotLoadFactor, ini, config, "Server.APC.HotLoadFactor", 0.5);
   Config::Bind(HotKeyAllocLow, ini, config, "Server.APC.HotKeyAllocLow", false);
   Config::Bind(HotMapAllocLow, ini, config, "Server.APC.HotMapAllocLow", false);
+  // Per-key-prefix stats; 0 leaves them off, which is the right choice
+  // outside of a debugging session since they lock on every APC operation.
+  Config::Bind(KeyStatsPrefixLen, ini, config, "Server.APC.KeyStats.PrefixLen",
+               0);
+  Config::Bind(KeyStatsSize, ini, config, "Server.APC.KeyStats.Size", 512);
 
   // Loads .so PrimeLibrary, writes snapshot output to this file, then exits.
   Config::Bind(PrimeLibraryUpgradeDest, ini, config,
@@ -191,6 +196,13 @@ void apcExtension::moduleLoad(const IniSetting::Map& ini, Hdf config) {
 
   Config::Bind(NoTTLPrefix, ini, config, "Server.APC.NoTTLPrefix");
 
+  // Store serialized values of at least Threshold bytes zstd-compressed,
+  // trading fetch CPU for shared-memory footprint. 0 disables compression.
+  Config::Bind(CompressionLevel, ini, config, "Server.APC.Compression.Level",
+               0);
+  Config::Bind(CompressionThreshold, ini, config,
+               "Server.APC.Compression.Threshold", 4096);
+
 #ifdef NO_M_DATA
   Config::Bind(UseUncounted, ini, config, "Server.APC.MemModelTreadmill", true);
 #else
@@ -199,6 +211,8 @@ void apcExtension::moduleLoad(const IniSetting::Map& ini, Hdf config) {
 #endif
   Config::Bind(ShareUncounted, ini, config, "Server.APC.ShareUncounted", true);
   if (!UseUncounted && ShareUncounted) ShareUncounted = false;
+  Config::Bind(DedupUncounted, ini, config, "Server.APC.DedupUncounted", false);
+  if (!UseUncounted && DedupUncounted) DedupUncounted = false;
 
   IniSetting::Bind(this, IniSetting::PHP_INI_SYSTEM, "apc.enabled", &Enable);
   IniSetting::Bind(this, IniSetting::PHP_INI_SYSTEM, "apc.stat",
@@ -250,6 +264,9 @@ void apcExtension::moduleInit() {
   HHVM_FE(apc_store);
   HHVM_FE(apc_store_as_primed_do_not_use);
   HHVM_FE(apc_fetch);
+  HHVM_FE(apc_fetch_stale);
+  HHVM_FE(apc_fetch_bulk);
+  HHVM_FE(apc_store_bulk);
   HHVM_FE(apc_delete);
   HHVM_FE(apc_clear_cache);
   HHVM_FE(apc_inc);
@@ -292,6 +309,10 @@ double apcExtension::HotLoadFactor = 0.5;
 std::vector<std::string> apcExtension::HotPrefix;
 bool apcExtension::HotKeyAllocLow = false;
 bool apcExtension::HotMapAllocLow = false;
+int apcExtension::KeyStatsPrefixLen = 0;
+int apcExtension::KeyStatsSize = 512;
+int apcExtension::CompressionLevel = 0;
+int apcExtension::CompressionThreshold = 4096;
 std::string apcExtension::PrimeLibraryUpgradeDest;
 bool apcExtension::UseFileStorage = false;
 int64_t apcExtension::FileStorageChunkSize = int64_t(1LL << 29);
@@ -306,6 +327,7 @@ bool apcExtension::UseUncounted = true;
 bool apcExtension::UseUncounted = false;
 #endif
 bool apcExtension::ShareUncounted = true;
+bool apcExtension::DedupUncounted = false;
 bool apcExtension::Stat = true;
 // Different from zend default but matches what we've been returning for years
 bool apcExtension::EnableCLI = true;
@@ -423,6 +445,56 @@ TypedValue HHVM_FUNCTION(apc_fetch, const Variant& key, VRefParam success) {
   return tvReturn(std::move(v));
 }
 
+TypedValue HHVM_FUNCTION(apc_fetch_stale,
+                         const String& key,
+                         int64_t grace_ttl,
+                         VRefParam success,
+                         VRefParam stale) {
+  if (!apcExtension::Enable) {
+    success.assignIfRef(false);
+    stale.assignIfRef(false);
+    return make_tv<KindOfBoolean>(false);
+  }
+
+  Variant v;
+  bool needsRefresh = false;
+  if (apc_store().getStale(key, v, grace_ttl, needsRefresh)) {
+    success.assignIfRef(true);
+  } else {
+    success.assignIfRef(false);
+    v = false;
+  }
+  stale.assignIfRef(needsRefresh);
+  return tvReturn(std::move(v));
+}
+
+TypedValue HHVM_FUNCTION(apc_fetch_bulk, const Array& keys) {
+  if (!apcExtension::Enable) return make_tv<KindOfBoolean>(false);
+
+  for (ArrayIter iter(keys); iter; ++iter) {
+    if (!iter.second().isString()) {
+      throw_invalid_argument("apc key: (not a string)");
+      return make_tv<KindOfBoolean>(false);
+    }
+  }
+  return tvReturn(apc_store().getBulk(keys));
+}
+
+bool HHVM_FUNCTION(apc_store_bulk,
+                   const Array& values,
+                   int64_t ttl /* = 0 */) {
+  if (!apcExtension::Enable) return false;
+
+  for (ArrayIter iter(values); iter; ++iter) {
+    if (!iter.first().isString()) {
+      throw_invalid_argument("apc key: (not a string)");
+      return false;
+    }
+  }
+  apc_store().setBulk(values, ttl);
+  return true;
+}
+
 Variant HHVM_FUNCTION(apc_delete,
                       const Variant& key) {
   if (!apcExtension::Enable) return false;
@@ -681,7 +753,7 @@ void apc_load(int thread) {
 
   apc_store().primeDone();
   if (!upgradeDest.empty()) {
-    s_snapshotBuilder.writeToFile(upgradeDest);
+    if (!s_snapshotBuilder.writeToFile(upgradeDest)) exit(1);
   }
 
   // We've copied all the data out, so close it out.
@@ -1144,6 +1216,12 @@ bool apc_dump_prefix(const char *filename,
   return true;
 }
 
+bool apc_dump_snapshot(const char *filename) {
+  SnapshotBuilder snap;
+  apc_store().exportSnapshot(snap);
+  return snap.writeToFile(filename);
+}
+
 bool apc_get_random_entries(std::ostream &out, uint32_t count) {
   apc_store().dumpRandomKeys(out, count);
   return true;
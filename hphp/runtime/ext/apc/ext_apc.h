@@ -54,6 +54,8 @@ struct apcExtension final : Extension {
   static double HotLoadFactor;
   static bool HotKeyAllocLow;
   static bool HotMapAllocLow;
+  static int KeyStatsPrefixLen;
+  static int KeyStatsSize;
   static std::string PrimeLibraryUpgradeDest;
   static bool UseFileStorage;
   static int64_t FileStorageChunkSize;
@@ -62,8 +64,11 @@ struct apcExtension final : Extension {
   static std::string FileStorageFlagKey;
   static bool FileStorageKeepFileLinked;
   static std::vector<std::string> NoTTLPrefix;
+  static int CompressionLevel;
+  static int CompressionThreshold;
   static bool UseUncounted;
   static bool ShareUncounted;
+  static bool DedupUncounted;
   static bool Stat;
   static bool EnableCLI;
 
@@ -89,6 +94,16 @@ bool HHVM_FUNCTION(apc_store_as_primed_do_not_use,
 TypedValue HHVM_FUNCTION(apc_fetch,
                          const Variant& key,
                          VRefParam success = uninit_null());
+TypedValue HHVM_FUNCTION(apc_fetch_stale,
+                         const String& key,
+                         int64_t grace_ttl,
+                         VRefParam success = uninit_null(),
+                         VRefParam stale = uninit_null());
+TypedValue HHVM_FUNCTION(apc_fetch_bulk,
+                         const Array& keys);
+bool HHVM_FUNCTION(apc_store_bulk,
+                   const Array& values,
+                   int64_t ttl = 0);
 Variant HHVM_FUNCTION(apc_delete,
                       const Variant& key);
 bool HHVM_FUNCTION(apc_clear_cache,
@@ -193,6 +208,9 @@ bool apc_dump(const char *filename, bool keyOnly, bool metaDump);
 bool apc_dump_prefix(const char *filename,
                      const std::string &prefix,
                      uint32_t count);
+// Write the current keyspace to a snapshot file that can be loaded on the
+// next startup by pointing Server.APC.PrimeLibrary at it.
+bool apc_dump_snapshot(const char *filename);
 size_t get_const_map_size();
 bool apc_get_random_entries(std::ostream &out, uint32_t count);
 
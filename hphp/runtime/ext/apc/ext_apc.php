@@ -85,6 +85,56 @@ function apc_store_as_primed_do_not_use(string $key,
 function apc_fetch(mixed $key,
                    mixed &$success = null): mixed;
 
+/**
+ * Fetches a stored variable, tolerating entries that are about to expire.
+ * If the entry is within $grace_ttl seconds of its expiration it is still
+ * returned, and exactly one caller (across all requests) sees $stale set to
+ * TRUE until a new value is stored for the key.  That caller is expected to
+ * recompute the value and apc_store() it; other callers keep getting the
+ * stale value, avoiding a thundering herd when a hot key expires.
+ *
+ * @param string $key - The key used to store the value.
+ * @param int $grace_ttl - Width of the pre-expiry grace window, in seconds.
+ * @param mixed $success - Set to TRUE in success and FALSE in failure.
+ * @param mixed $stale - Set to TRUE if this caller should refresh the entry.
+ *
+ * @return mixed - The stored variable on success; FALSE on failure.
+ *
+ */
+<<__Native>>
+function apc_fetch_stale(string $key,
+                         int $grace_ttl,
+                         mixed &$success = null,
+                         mixed &$stale = null): mixed;
+
+/**
+ * Fetches many stored variables while entering the cache only once, which
+ * is noticeably cheaper than calling apc_fetch() per key when warming up a
+ * request from tens or hundreds of keys.
+ *
+ * @param array $keys - The keys used to store the values.
+ *
+ * @return mixed - An array mapping each key that was present to its value;
+ *   keys that were missing or expired are absent.  FALSE on failure.
+ *
+ */
+<<__Native>>
+function apc_fetch_bulk(array $keys): mixed;
+
+/**
+ * Stores many key/value pairs while entering the cache only once.  Each
+ * entry behaves as if stored with apc_store($key, $value, $ttl).
+ *
+ * @param array $values - An array mapping keys to the values to store.
+ * @param int $ttl - Time to live, applied to every entry.
+ *
+ * @return bool - Returns TRUE on success or FALSE on failure.
+ *
+ */
+<<__Native>>
+function apc_store_bulk(array $values,
+                        int $ttl = 0): bool;
+
 /**
  * Removes a stored variable from the cache.
  *
@@ -76,7 +76,8 @@ struct SnapshotBuilder {
     add(kSnapOther, v, item);
   }
 
-  void writeToFile(const std::string& filename);
+  // Returns false if the file could not be opened for writing.
+  bool writeToFile(const std::string& filename);
 
  private:
   void add(StringBasedType type, const String& v, KeyValuePair item) {
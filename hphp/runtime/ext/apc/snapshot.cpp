@@ -48,11 +48,11 @@ namespace HPHP {
 
 TRACE_SET_MOD(apc);
 
-void SnapshotBuilder::writeToFile(const std::string& filename) {
+bool SnapshotBuilder::writeToFile(const std::string& filename) {
   m_file = fopen(filename.c_str(), "w+");
   if (!m_file) {
     Logger::Error("Failed to open snapshot file %s", filename.c_str());
-    exit(1);
+    return false;
   }
   // Invalid header for now, to avoid truncated output due to errors looking
   // valid (and to allow computing diskOffset while serializing).
@@ -79,6 +79,7 @@ void SnapshotBuilder::writeToFile(const std::string& filename) {
   writeRaw(SnapshotHeader::makeValid(diskOffset, totalSize));
   fclose(m_file);
   m_file = nullptr;
+  return true;
 }
 
 bool SnapshotLoader::tryInitializeFromFile(const char* filename) {
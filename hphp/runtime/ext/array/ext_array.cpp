@@ -28,8 +28,10 @@
 #include "hphp/runtime/base/datatype.h"
 #include "hphp/runtime/base/double-to-int64.h"
 #include "hphp/runtime/base/mixed-array.h"
+#include "hphp/runtime/base/packed-array-defs.h"
 #include "hphp/runtime/base/rds-local.h"
 #include "hphp/runtime/base/request-event-handler.h"
+#include "hphp/runtime/base/set-array.h"
 #include "hphp/runtime/base/sort-flags.h"
 #include "hphp/runtime/base/thread-info.h"
 #include "hphp/runtime/base/tv-refcount.h"
@@ -48,6 +50,10 @@
 
 #include <vector>
 
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
 namespace HPHP {
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -396,6 +402,17 @@ Variant array_keys_helper(const Variant& input,
   }
 
   if (LIKELY(!search_value.isInitialized())) {
+    // Packed-layout keys are the identity range [0, size), so build the
+    // result directly rather than driving an iterator over the input.
+    if (isArrayLikeType(cell_input.m_type) &&
+        cell_input.m_data.parr->hasPackedLayout()) {
+      auto const size = int64_t{cell_input.m_data.parr->getSize()};
+      PackedArrayInit ai(size);
+      for (int64_t i = 0; i < size; ++i) {
+        ai.append(make_tv<KindOfInt64>(i));
+      }
+      return ai.toVariant();
+    }
     PackedArrayInit ai(getContainerSize(cell_input));
     for (ArrayIter iter(cell_input); iter; ++iter) {
       ai.append(iter.first());
@@ -988,6 +1005,15 @@ TypedValue HHVM_FUNCTION(array_slice,
     return tvReturn(cell_input.m_data.pobj->toArray());
   }
 
+  // Partial slice of a packed-layout array: bulk-copy the range instead of
+  // walking it element by element.
+  if ((offset == 0 || !preserve_keys) &&
+      isArrayLikeType(cell_input.m_type) &&
+      cell_input.m_data.parr->hasPackedLayout()) {
+    return tvReturn(Array::attach(
+      PackedArray::Slice(cell_input.m_data.parr, offset, len)));
+  }
+
   int pos = 0;
   ArrayIter iter(cell_input);
   for (; pos < offset && iter; ++pos, ++iter) {}
@@ -1569,10 +1595,57 @@ Variant HHVM_FUNCTION(end,
   );
 }
 
+namespace {
+
+/*
+ * Strict search for an int needle in a packed array is a pure 64-bit memory
+ * scan: an element matches iff its value qword equals the needle and its
+ * type is KindOfInt64.  Sweep the value qwords four TypedValues at a time
+ * and only drop to a scalar walk (which also checks types) once a qword
+ * matches.  Returns the matching index, or -1.
+ */
+ssize_t packedSearchInt(const ArrayData* ad, int64_t needle) {
+  assertx(ad->hasPackedLayout());
+  auto const data = packedData(ad);
+  auto const size = ssize_t{ad->getSize()};
+  ssize_t i = 0;
+#ifdef __AVX2__
+  auto const vneedle = _mm256_set1_epi64x(needle);
+  for (; i + 4 <= size; i += 4) {
+    auto const v0 = _mm256_loadu_si256(
+      reinterpret_cast<const __m256i*>(data + i));
+    auto const v1 = _mm256_loadu_si256(
+      reinterpret_cast<const __m256i*>(data + i + 2));
+    // Each 32-byte load covers two TypedValues; the value qwords sit in
+    // lanes 0 and 2, the type words in lanes 1 and 3.
+    auto const m0 = _mm256_movemask_epi8(_mm256_cmpeq_epi64(v0, vneedle));
+    auto const m1 = _mm256_movemask_epi8(_mm256_cmpeq_epi64(v1, vneedle));
+    if (LIKELY(((m0 | m1) & 0x00ff00ff) == 0)) continue;
+    break;
+  }
+#endif
+  for (; i < size; ++i) {
+    auto const tv = data + i;
+    if (tv->m_type == KindOfInt64 && tv->m_data.num == needle) return i;
+  }
+  return -1;
+}
+
+}
+
 bool HHVM_FUNCTION(in_array,
                    const Variant& needle,
                    const Variant& haystack,
                    bool strict /* = false */) {
+  if (strict) {
+    auto const hay = haystack.toCell();
+    auto const ncell = needle.toCell();
+    if (ncell->m_type == KindOfInt64 &&
+        isArrayLikeType(hay->m_type) &&
+        hay->m_data.parr->hasPackedLayout()) {
+      return packedSearchInt(hay->m_data.parr, ncell->m_data.num) >= 0;
+    }
+  }
   bool ret = false;
   auto ok = strict ?
     IterateV(*haystack.toCell(),
@@ -1606,6 +1679,18 @@ bool HHVM_FUNCTION(in_array,
 Variant array_search(const Variant& needle,
                      const Variant& haystack,
                      bool strict /* = false */) {
+  if (strict) {
+    auto const hay = haystack.toCell();
+    auto const ncell = needle.toCell();
+    if (ncell->m_type == KindOfInt64 &&
+        isArrayLikeType(hay->m_type) &&
+        hay->m_data.parr->hasPackedLayout()) {
+      // Packed arrays are keyed 0..size-1, so the match index is the key.
+      auto const pos = packedSearchInt(hay->m_data.parr, ncell->m_data.num);
+      if (pos >= 0) return pos;
+      return false;
+    }
+  }
   Variant ret = false;
   auto ok = strict ?
     IterateKV(*haystack.toCell(),
@@ -2035,7 +2120,7 @@ static inline TypedValue* makeContainerListHelper(const Variant& a,
   assertx(0 <= smallestPos);
   assertx(smallestPos < count);
   // Allocate a TypedValue array and copy 'a' and the contents of 'argv'
-  TypedValue* containers = req::make_raw_array<TypedValue>(count);
+  TypedValue* containers = req::make_raw_array_uninit<TypedValue>(count);
   tvCopy(*a.toCell(), containers[0]);
   int pos = 1;
   for (ArrayIter argvIter(argv); argvIter; ++argvIter, ++pos) {
@@ -2936,6 +3021,30 @@ Array HHVM_FUNCTION(HH_keyset, const Variant& input) {
   return input.toKeyset();
 }
 
+// HH\\keyset_intersect
+Array HHVM_FUNCTION(HH_keyset_intersect,
+                    const Variant& lhs,
+                    const Variant& rhs) {
+  if (!lhs.isKeyset() || !rhs.isKeyset()) {
+    SystemLib::throwInvalidArgumentExceptionObject(
+      "keyset_intersect() expects keyset arguments");
+  }
+  return Array::attach(
+    SetArray::Intersect(lhs.getArrayData(), rhs.getArrayData()));
+}
+
+// HH\\keyset_union
+Array HHVM_FUNCTION(HH_keyset_union,
+                    const Variant& lhs,
+                    const Variant& rhs) {
+  if (!lhs.isKeyset() || !rhs.isKeyset()) {
+    SystemLib::throwInvalidArgumentExceptionObject(
+      "keyset_union() expects keyset arguments");
+  }
+  return Array::attach(
+    SetArray::Union(lhs.getArrayData(), rhs.getArrayData()));
+}
+
 // HH\\vec
 Array HHVM_FUNCTION(HH_vec, const Variant& input) {
   return input.toVecArray();
@@ -3184,6 +3293,8 @@ struct ArrayExtension final : Extension {
     HHVM_FALIAS(HH\\dict, HH_dict);
     HHVM_FALIAS(HH\\vec, HH_vec);
     HHVM_FALIAS(HH\\keyset, HH_keyset);
+    HHVM_FALIAS(HH\\keyset_intersect, HH_keyset_intersect);
+    HHVM_FALIAS(HH\\keyset_union, HH_keyset_union);
     HHVM_FALIAS(HH\\varray, HH_varray);
     HHVM_FALIAS(HH\\darray, HH_darray);
     HHVM_FALIAS(HH\\array_key_cast, HH_array_key_cast);
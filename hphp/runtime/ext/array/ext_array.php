@@ -1497,6 +1497,31 @@ namespace HH {
       $arr,
   ): keyset;
 
+  /**
+   * keyset_intersect() returns a keyset containing the elements of the first
+   * keyset that are also present in the second, in the first keyset's order.
+   *
+   * @param keyset $lhs
+   * @param keyset $rhs
+   *
+   * @return keyset
+   */
+  <<__Native, __IsFoldable, __Rx>>
+  function keyset_intersect(mixed $lhs, mixed $rhs): keyset;
+
+  /**
+   * keyset_union() returns a keyset containing the elements of both
+   * keysets: the first keyset's elements in order, followed by the second
+   * keyset's elements that were not already present.
+   *
+   * @param keyset $lhs
+   * @param keyset $rhs
+   *
+   * @return keyset
+   */
+  <<__Native, __IsFoldable, __Rx>>
+  function keyset_union(mixed $lhs, mixed $rhs): keyset;
+
   <<__Native, __IsFoldable, __Rx, __AtMostRxAsArgs>>
   function varray(
     <<__OnlyRxIfImpl(\HH\Rx\KeyedTraversable::class), __MaybeMutable>>mixed
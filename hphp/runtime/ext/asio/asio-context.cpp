@@ -92,6 +92,7 @@ void AsioContext::exit(context_idx_t ctx_idx) {
 
   exitContextVector(ctx_idx, m_runnableQueue);
   exitContextVector(ctx_idx, m_fastRunnableQueue);
+  exitContextVector(ctx_idx, m_runnableQueueLow);
 
   for (auto& it : m_priorityQueueDefault) {
     exitContextQueue(ctx_idx, it.second);
@@ -104,6 +105,28 @@ void AsioContext::exit(context_idx_t ctx_idx) {
   exitContextVector(ctx_idx, m_externalThreadEvents);
 }
 
+void AsioContext::schedule(c_ResumableWaitHandle* wait_handle) {
+  auto const session = AsioSession::Get();
+  if (UNLIKELY(session->hasResumePriorities()) &&
+      session->getResumePriority(wait_handle) > 0) {
+    m_runnableQueueLow.push_back(wait_handle);
+  } else {
+    m_runnableQueue.push_back(wait_handle);
+  }
+}
+
+void AsioContext::scheduleFast(c_AsyncFunctionWaitHandle* wait_handle) {
+  auto const session = AsioSession::Get();
+  if (UNLIKELY(session->hasResumePriorities()) &&
+      session->getResumePriority(wait_handle) > 0) {
+    // Background work forfeits the fast-resume path; it must not jump
+    // ahead of default-priority resumptions.
+    m_runnableQueueLow.push_back(wait_handle);
+  } else {
+    m_fastRunnableQueue.push_back(wait_handle);
+  }
+}
+
 void AsioContext::schedule(c_RescheduleWaitHandle* wait_handle, uint32_t queue,
                            int64_t priority) {
   assertx(queue == QUEUE_DEFAULT || queue == QUEUE_NO_PENDING_IO);
@@ -192,6 +215,21 @@ void AsioContext::runUntil(c_WaitableWaitHandle* wait_handle) {
       continue;
     }
 
+    // Run background-priority resumptions only once the default lanes are
+    // drained, so bulk background awaitables can't starve the request's
+    // critical path.
+    if (!m_runnableQueueLow.empty()) {
+      auto wh = m_runnableQueueLow.back();
+      m_runnableQueueLow.pop_back();
+      if (wh->getState() != c_ResumableWaitHandle::STATE_READY) {
+        // may happen if wh was scheduled in multiple contexts
+        decRefObj(wh);
+      } else {
+        wh->resume();
+      }
+      continue;
+    }
+
     // Run default priority queue once.
     if (runSingle(m_priorityQueueDefault)) {
       continue;
@@ -205,6 +243,7 @@ void AsioContext::runUntil(c_WaitableWaitHandle* wait_handle) {
       // check if onIOWaitEnter callback unblocked any wait handles
       if (LIKELY(m_runnableQueue.empty() &&
                  m_fastRunnableQueue.empty() &&
+                 m_runnableQueueLow.empty() &&
                  !m_externalThreadEvents.empty() &&
                  !ete_queue->hasReceived() &&
                  m_priorityQueueDefault.empty())) {
@@ -232,6 +271,7 @@ void AsioContext::runUntil(c_WaitableWaitHandle* wait_handle) {
       // check if onIOWaitEnter callback unblocked any wait handles
       if (LIKELY(m_runnableQueue.empty() &&
                  m_fastRunnableQueue.empty() &&
+                 m_runnableQueueLow.empty() &&
                  m_externalThreadEvents.empty() &&
                  m_priorityQueueDefault.empty() &&
                  !m_sleepEvents.empty())) {
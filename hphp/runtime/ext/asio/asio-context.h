@@ -44,12 +44,8 @@ struct AsioContext final {
 
   ActRec* getSavedFP() const { return m_savedFP; }
 
-  void schedule(c_ResumableWaitHandle* wait_handle) {
-    m_runnableQueue.push_back(wait_handle);
-  }
-  void scheduleFast(c_AsyncFunctionWaitHandle* wait_handle) {
-    m_fastRunnableQueue.push_back(wait_handle);
-  }
+  void schedule(c_ResumableWaitHandle* wait_handle);
+  void scheduleFast(c_AsyncFunctionWaitHandle* wait_handle);
   void schedule(c_RescheduleWaitHandle* wait_handle, uint32_t queue,
                 int64_t priority);
 
@@ -94,6 +90,11 @@ private:
   // stack of AsyncFunctionWaitHandles ready for immediate execution
   req::vector<c_AsyncFunctionWaitHandle*> m_fastRunnableQueue;
 
+  // stack of ResumableWaitHandles annotated as background priority; run
+  // only once the default lanes are drained (see
+  // AsioSession::setResumePriority)
+  req::vector<c_ResumableWaitHandle*> m_runnableQueueLow;
+
   // queue of RescheduleWaitHandles scheduled in default mode
   reschedule_priority_queue_t m_priorityQueueDefault;
 
@@ -379,5 +379,31 @@ c_SleepWaitHandle* AsioSession::nextSleepEvent() {
   return m_sleepEvents.front();
 }
 
+int64_t AsioSession::getResumePriority(
+  c_WaitableWaitHandle* waitHandle
+) const {
+  auto const it = m_resumePriorities.find(waitHandle);
+  return it == m_resumePriorities.end() ? 0 : it->second;
+}
+
+void AsioSession::setResumePriority(c_WaitableWaitHandle* waitHandle,
+                                    int64_t priority) {
+  assertx(priority > 0);
+  auto const result = m_resumePriorities.emplace(waitHandle, priority);
+  if (result.second) {
+    // Pin the wait handle, so its address can't be reused for another
+    // wait handle while the annotation is in effect.
+    waitHandle->incRefCount();
+  } else {
+    result.first->second = priority;
+  }
+}
+
+void AsioSession::clearResumePriority(c_WaitableWaitHandle* waitHandle) {
+  if (m_resumePriorities.erase(waitHandle)) {
+    decRefObj(waitHandle);
+  }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 }
@@ -19,6 +19,7 @@
 #define incl_HPHP_EXT_ASIO_SESSION_H_
 
 #include "hphp/runtime/ext/extension.h"
+#include "hphp/runtime/base/req-hash-map.h"
 #include "hphp/runtime/base/thread-info.h"
 #include "hphp/runtime/ext/asio/asio-context.h"
 #include "hphp/runtime/ext/asio/asio-external-thread-event-queue.h"
@@ -154,6 +155,16 @@ struct AsioSession final {
   void onSleepCreate(c_SleepWaitHandle* waitHandle);
   void onSleepSuccess(c_SleepWaitHandle* waitHandle, int64_t finish_time);
 
+  // Resumption priority lanes (see AsioContext::schedule).  Wait handles
+  // annotated with a priority greater than zero are resumed from the
+  // background lane, only once the default lanes are drained.  The
+  // annotation holds a reference to the wait handle until the priority is
+  // reset to zero or the request ends.
+  bool hasResumePriorities() const { return !m_resumePriorities.empty(); }
+  int64_t getResumePriority(c_WaitableWaitHandle* waitHandle) const;
+  void setResumePriority(c_WaitableWaitHandle* waitHandle, int64_t priority);
+  void clearResumePriority(c_WaitableWaitHandle* waitHandle);
+
 private:
   AsioSession();
   friend AsioSession* req::make_raw<AsioSession>();
@@ -163,6 +174,7 @@ private:
   req::vector<AsioContext*> m_contexts;
   req::vector<c_SleepWaitHandle*> m_sleepEvents;
   AsioExternalThreadEventQueue m_externalThreadEventQueue;
+  req::fast_map<c_WaitableWaitHandle*, int64_t> m_resumePriorities;
 
   Object m_abruptInterruptException;
   Object m_onIOWaitEnter;
@@ -62,6 +62,17 @@ abstract class Awaitable {
    */
   <<__Native>>
   final public function getName(): string;
+
+  /* Set the scheduler lane for resumptions of this awaitable. Priorities
+   * greater than zero put resumptions in the background lane, which only
+   * runs once all default-priority work in the request is drained; zero
+   * restores the default lane. The annotation keeps the wait handle alive
+   * until the priority is reset or the request ends.
+   * @param int $priority - Zero for the default lane, greater than zero
+   * for the background lane
+   */
+  <<__HipHopSpecific, __Native>>
+  final public function setResumePriority(int $priority): void;
 }
 
 /* A wait handle that is always finished
@@ -78,6 +78,22 @@ String HHVM_METHOD(Awaitable, getName) {
   return static_cast<c_WaitableWaitHandle*>(obj)->getName();
 }
 
+void HHVM_METHOD(Awaitable, setResumePriority, int64_t priority) {
+  if (priority < 0) {
+    SystemLib::throwInvalidArgumentExceptionObject(
+      "Expected priority to be a non-negative integer");
+  }
+  auto obj = wait_handle<c_Awaitable>(this_);
+  if (obj->isFinished()) return;
+  assertx(obj->instanceof(c_WaitableWaitHandle::classof()));
+  auto wh = static_cast<c_WaitableWaitHandle*>(obj);
+  if (priority == 0) {
+    AsioSession::Get()->clearResumePriority(wh);
+  } else {
+    AsioSession::Get()->setResumePriority(wh, priority);
+  }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 size_t asio_object_size(const ObjectData* od) {
@@ -117,6 +133,7 @@ void AsioExtension::initWaitHandle() {
   WH_ME(isSucceeded);
   WH_ME(isFailed);
   WH_ME(getName);
+  WH_ME(setResumePriority);
 #undef WH_ME
 }
 
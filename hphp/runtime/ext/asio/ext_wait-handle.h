@@ -35,6 +35,7 @@ bool HHVM_METHOD(Awaitable, isFinished);
 bool HHVM_METHOD(Awaitable, isSucceeded);
 bool HHVM_METHOD(Awaitable, isFailed);
 String HHVM_METHOD(Awaitable, getName);
+void HHVM_METHOD(Awaitable, setResumePriority, int64_t priority);
 
 /**
  * A wait handle is an object that describes operation that is potentially
@@ -18,8 +18,12 @@
 
 #include <algorithm>
 #include <memory>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 
+#include <folly/Format.h>
+
 #include <squangle/mysql_client/AsyncHelpers.h>
 #include <squangle/mysql_client/ClientPool.h>
 
@@ -474,7 +478,33 @@ const StaticString s_per_key_connection_limit("per_key_connection_limit"),
     s_pool_connection_limit("pool_connection_limit"),
     s_idle_timeout_micros("idle_timeout_micros"),
     s_age_timeout_micros("age_timeout_micros"),
-    s_expiration_policy("expiration_policy");
+    s_expiration_policy("expiration_policy"),
+    s_shared("shared"),
+    s_per_request_connection_limit("per_request_connection_limit");
+
+namespace {
+// Process-global pools for the `shared` option, keyed by the serialized
+// pool options.  A shared pool (and the warmed-up connections parked in
+// it, owned by the shared client's event base) survives requests, so
+// later requests skip connect+TLS+handshake entirely.  Idle- and
+// age-based eviction keeps running between requests since the pool's
+// expiration timer lives on the client's event base, not the request.
+std::mutex s_sharedPoolsLock;
+std::unordered_map<std::string, std::shared_ptr<am::AsyncConnectionPool>>
+    s_sharedPools;
+
+std::shared_ptr<am::AsyncConnectionPool> getSharedPool(
+    const std::string& key, const am::PoolOptions& pool_options) {
+  std::lock_guard<std::mutex> guard(s_sharedPoolsLock);
+  auto it = s_sharedPools.find(key);
+  if (it != s_sharedPools.end()) {
+    return it->second;
+  }
+  auto pool = am::AsyncConnectionPool::makePool(getClient(), pool_options);
+  s_sharedPools.emplace(key, pool);
+  return pool;
+}
+}
 
 static void
 HHVM_METHOD(AsyncMysqlConnectionPool, __construct, const Array& options) {
@@ -501,13 +531,39 @@ HHVM_METHOD(AsyncMysqlConnectionPool, __construct, const Array& options) {
                                   ? am::ExpirationPolicy::IdleTime
                                   : am::ExpirationPolicy::Age);
   }
+  if (options.exists(s_per_request_connection_limit)) {
+    data->m_perRequestLimit =
+        options[s_per_request_connection_limit].toInt64();
+  }
+  if (options.exists(s_shared) && options[s_shared].toBoolean()) {
+    data->m_shared = true;
+    auto const key = folly::sformat(
+        "{}:{}:{}:{}:{}",
+        options.exists(s_per_key_connection_limit)
+            ? options[s_per_key_connection_limit].toInt64() : -1,
+        options.exists(s_pool_connection_limit)
+            ? options[s_pool_connection_limit].toInt64() : -1,
+        options.exists(s_idle_timeout_micros)
+            ? options[s_idle_timeout_micros].toInt64() : -1,
+        options.exists(s_age_timeout_micros)
+            ? options[s_age_timeout_micros].toInt64() : -1,
+        options.exists(s_expiration_policy)
+            ? options[s_expiration_policy].toString().toCppString() : "");
+    data->m_async_pool = getSharedPool(key, pool_options);
+    return;
+  }
   data->m_async_pool =
       am::AsyncConnectionPool::makePool(getClient(), pool_options);
 }
 
 void AsyncMysqlConnectionPool::sweep() {
   if (m_async_pool) {
-    m_async_pool->shutdown();
+    // Shared pools outlive the request; only drop this request's
+    // reference.  The global map keeps the pool and its parked
+    // connections alive.
+    if (!m_shared) {
+      m_async_pool->shutdown();
+    }
     m_async_pool.reset();
   }
 }
@@ -556,6 +612,11 @@ static Object HHVM_METHOD(
     int64_t timeout_micros,
     const String& extra_key) {
   auto* data = Native::data<AsyncMysqlConnectionPool>(this_);
+  if (data->m_perRequestLimit > 0 &&
+      ++data->m_requestCheckouts > data->m_perRequestLimit) {
+    SystemLib::throwInvalidArgumentExceptionObject(
+        "AsyncMysqlConnectionPool: per_request_connection_limit exceeded");
+  }
   auto op = data->m_async_pool->beginConnection(
       static_cast<std::string>(host),
       port,
@@ -585,6 +646,11 @@ static Object HHVM_METHOD(
     const Object& asyncMysqlConnOpts,
     const String& extra_key) {
   auto* data = Native::data<AsyncMysqlConnectionPool>(this_);
+  if (data->m_perRequestLimit > 0 &&
+      ++data->m_requestCheckouts > data->m_perRequestLimit) {
+    SystemLib::throwInvalidArgumentExceptionObject(
+        "AsyncMysqlConnectionPool: per_request_connection_limit exceeded");
+  }
   auto op = data->m_async_pool->beginConnection(
       static_cast<std::string>(host),
       port,
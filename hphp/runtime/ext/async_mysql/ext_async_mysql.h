@@ -49,6 +49,13 @@ struct AsyncMysqlConnectionPool {
   void sweep();
 
   std::shared_ptr<am::AsyncConnectionPool> m_async_pool;
+  // Shared pools are process-global and survive the request; sweep() only
+  // drops this request's reference instead of shutting the pool down.
+  bool m_shared{false};
+  // Max connection checkouts by a single request from a shared pool
+  // (0 = unlimited).
+  int64_t m_perRequestLimit{0};
+  int64_t m_requestCheckouts{0};
   static const StaticString s_className;
 
   AsyncMysqlConnectionPool(const AsyncMysqlConnectionPool&) = delete;
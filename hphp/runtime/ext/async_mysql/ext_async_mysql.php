@@ -244,6 +244,18 @@ class AsyncMysqlConnectionPool {
    *                        specifies whether connections in the pool will be
    *                        destroyed based on how long it sits idle or total
    *                        age in the pool. The default is `'Age'`.
+   * - `shared`: A `bool`. When `true`, the pool is shared server-wide and
+   *             survives the current request: connections stay parked on
+   *             the client event base between requests, so later requests
+   *             skip the connect and handshake cost. Pools are shared
+   *             between all requests constructing them with the same
+   *             options. Idle and age eviction keep running between
+   *             requests. The default is `false`.
+   * - `per_request_connection_limit`: The maximum number of connections a
+   *                                   single request may check out of the
+   *                                   pool; further `connect()` calls
+   *                                   throw. `0`, the default, means no
+   *                                   limit.
    *
    * @param $pool_options - The `array` of options for the connection pool.
    *                        The key to each array element is an option listed
@@ -358,6 +358,17 @@ void BaseVector::addAllImpl(const Variant& t) {
 }
 
 int64_t BaseVector::linearSearch(const Variant& search_value) {
+  // Int needles only compare `same' to int elements, so scan the raw
+  // cells instead of taking the generic cross-type dispatch per element.
+  if (search_value.isInteger()) {
+    auto const needle = search_value.asInt64Val();
+    for (auto elm = data(), end = elm + m_size; elm < end; ++elm) {
+      if (elm->m_type == KindOfInt64 && elm->m_data.num == needle) {
+        return elm - data();
+      }
+    }
+    return -1;
+  }
   for (auto elm = data(), end = elm + m_size; elm < end; ++elm) {
     if (same(search_value, tvAsCVarRef(elm))) {
       return elm - data();
@@ -31,6 +31,12 @@ CURL* PooledCurlHandle::useHandle() {
     m_numUsages = 0;
   }
 
+  // curl_easy_reset() between uses clears CURLOPT_SHARE (but not the data
+  // held by the share itself), so re-attach on every lease
+  if (auto share = CurlHandlePool::sharedState()) {
+    curl_easy_setopt(m_handle, CURLOPT_SHARE, share);
+  }
+
   m_numUsages++;
   return m_handle;
 }
@@ -108,5 +114,41 @@ void CurlHandlePool::store(PooledCurlHandle* handle) {
 ReadWriteMutex CurlHandlePool::namedPoolsMutex;
 std::map<std::string, CurlHandlePoolPtr> CurlHandlePool::namedPools;
 
+bool CurlHandlePool::dnsShareEnabled = true;
+
+namespace {
+// Pooled handles are used concurrently from worker threads, so the share
+// handle needs the libcurl locking callbacks; one mutex per lockable
+// data kind keeps contention on the DNS cache and SSL session cache
+// independent.
+Mutex s_sharedStateLocks[CURL_LOCK_DATA_LAST];
+
+void shared_state_lock(CURL* /*handle*/, curl_lock_data data,
+                       curl_lock_access /*access*/, void* /*userptr*/) {
+  s_sharedStateLocks[data].lock();
+}
+
+void shared_state_unlock(CURL* /*handle*/, curl_lock_data data,
+                         void* /*userptr*/) {
+  s_sharedStateLocks[data].unlock();
+}
+}
+
+CURLSH* CurlHandlePool::sharedState() {
+  if (!dnsShareEnabled) return nullptr;
+  static CURLSH* share = [] {
+    CURLSH* sh = curl_share_init();
+    if (sh == nullptr) return sh;
+    curl_share_setopt(sh, CURLSHOPT_LOCKFUNC, shared_state_lock);
+    curl_share_setopt(sh, CURLSHOPT_UNLOCKFUNC, shared_state_unlock);
+    curl_share_setopt(sh, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+    curl_share_setopt(sh, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+    // never cleaned up; the share must outlive every pooled handle and
+    // pools themselves live for the life of the process
+    return sh;
+  }();
+  return share;
+}
+
 /////////////////////////////////////////////////////////////////////////////
 }
@@ -57,6 +57,16 @@ struct CurlHandlePool {
   static ReadWriteMutex namedPoolsMutex;
   static std::map<std::string, CurlHandlePoolPtr> namedPools;
 
+  /* A process-wide CURLSH handle attached to every pooled curl handle,
+   * sharing the DNS cache and SSL session ids across all pools and worker
+   * threads. Individual pooled handles already cache resolves over their
+   * own lifetimes; the share handle makes a resolve (or TLS handshake)
+   * done by any handle visible to all of them. Returns nullptr if sharing
+   * is disabled via the curl.poolDnsShare ini setting.
+   */
+  static CURLSH* sharedState();
+  static bool dnsShareEnabled;
+
 private:
   std::stack<PooledCurlHandle*> m_handleStack;
   Mutex m_mutex;
@@ -724,6 +724,7 @@ bool HHVM_FUNCTION(curl_share_setopt, const Resource& sh,
 ///////////////////////////////////////////////////////////////////////////////
 
 static int  s_sizeVal, s_connGetTimeoutVal, s_reuseLimitVal;
+static bool s_poolDnsShare;
 static std::string s_namedPools;
 
 struct CurlExtension final : Extension {
@@ -1541,6 +1542,10 @@ struct CurlExtension final : Extension {
     Extension* ext = ExtensionRegistry::get("curl");
     assertx(ext);
 
+    IniSetting::Bind(ext, IniSetting::PHP_INI_SYSTEM, "curl.poolDnsShare",
+      "1", &s_poolDnsShare);
+    CurlHandlePool::dnsShareEnabled = s_poolDnsShare;
+
     IniSetting::Bind(ext, IniSetting::PHP_INI_SYSTEM, "curl.namedPools",
       "", &s_namedPools);
     if (s_namedPools.length() > 0) {
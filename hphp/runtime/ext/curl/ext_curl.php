@@ -135,7 +135,9 @@ function curl_init(?string $url = null): mixed;
 /**
  * Initialize a cURL session using a pooled curl handle. When this resource
  * is garbage collected, the curl handle will be saved for reuse later.
- * Pooled curl handles persist between requests.
+ * Pooled curl handles persist between requests, keeping connections open
+ * and sharing a process-wide DNS and SSL session cache (unless disabled
+ * via the 'curl.poolDnsShare' ini setting).
  *
  * @deprecated Use HH\curl_init_pooled instead
  * @param string $poolName - The name of the connection pool to use.
@@ -428,7 +430,9 @@ namespace HH {
 /**
  * Initialize a cURL session using a pooled curl handle. When this resource
  * is garbage collected, the curl handle will be saved for reuse later.
- * Pooled curl handles persist between requests.
+ * Pooled curl handles persist between requests, keeping connections open
+ * and sharing a process-wide DNS and SSL session cache (unless disabled
+ * via the 'curl.poolDnsShare' ini setting).
  *
  * @param string $poolName - The name of the connection pool to use.
  *  Named connection pools are initialized via the 'curl.namedPools' ini
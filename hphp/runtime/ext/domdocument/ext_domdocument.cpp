@@ -18,12 +18,14 @@
 #include "hphp/runtime/ext/domdocument/ext_domdocument.h"
 
 #include <map>
+#include <sys/stat.h>
 
 #include "hphp/runtime/base/actrec-args.h"
 #include "hphp/runtime/base/builtin-functions.h"
 #include "hphp/runtime/base/file.h"
 #include "hphp/runtime/base/file-util.h"
 #include "hphp/runtime/base/runtime-error.h"
+#include "hphp/runtime/base/runtime-option.h"
 #include "hphp/runtime/ext/simplexml/ext_simplexml.h"
 #include "hphp/runtime/ext/std/ext_std_classobj.h"
 #include "hphp/runtime/ext/std/ext_std_errorfunc.h"
@@ -35,6 +37,7 @@
 #include "hphp/system/systemlib.h"
 #include "hphp/util/functional.h"
 #include "hphp/util/hash-set.h"
+#include "hphp/util/lock.h"
 #include "hphp/util/string-vsnprintf.h"
 
 #define DOM_XMLNS_NAMESPACE                             \
@@ -690,6 +693,70 @@ static xmlNsPtr dom_get_ns(xmlNodePtr nodep, const char *uri, int *errorcode,
   return nsptr;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// Shared parsed-document cache.
+//
+// XML-config-heavy workloads load the same files over and over. When
+// Eval.DOMDocumentCacheSize is nonzero, documents parsed from a plain file
+// are kept in a process-wide cache keyed by path and parse options, and
+// subsequent loads are served with xmlCopyDoc instead of a full reparse.
+// The cached masters are never handed out or mutated, and entries are
+// revalidated against the file's mtime and size on every hit. Copies do
+// not carry the parser's ID table, so getElementById() on a cached load
+// only finds ids in documents without DTD-declared ID attributes; the
+// cache is off by default.
+
+namespace {
+
+struct CachedXmlDoc {
+  xmlDocPtr doc;
+  time_t mtime;
+  off_t size;
+};
+
+ReadWriteMutex s_domDocCacheLock;
+std::map<std::string, CachedXmlDoc> s_domDocCache;
+
+std::string dom_doc_cache_key(const String& path, int options) {
+  return std::string(path.data(), path.size()) + ':' + std::to_string(options);
+}
+
+xmlDocPtr dom_document_cache_lookup(const String& path, int options) {
+  struct stat sb;
+  if (::stat(path.data(), &sb) != 0) return nullptr;
+  ReadLock lock(s_domDocCacheLock);
+  auto const it = s_domDocCache.find(dom_doc_cache_key(path, options));
+  if (it == s_domDocCache.end()) return nullptr;
+  auto const& entry = it->second;
+  if (entry.mtime != sb.st_mtime || entry.size != sb.st_size) return nullptr;
+  // Copy under the read lock so eviction can't free the master while we
+  // are still walking it.
+  return xmlCopyDoc(entry.doc, /* recursive */ 1);
+}
+
+void dom_document_cache_insert(const String& path, int options, xmlDocPtr doc) {
+  struct stat sb;
+  if (::stat(path.data(), &sb) != 0) return;
+  auto const master = xmlCopyDoc(doc, /* recursive */ 1);
+  if (!master) return;
+  WriteLock lock(s_domDocCacheLock);
+  auto key = dom_doc_cache_key(path, options);
+  auto const it = s_domDocCache.find(key);
+  if (it != s_domDocCache.end()) {
+    xmlFreeDoc(it->second.doc);
+    it->second = CachedXmlDoc{master, sb.st_mtime, sb.st_size};
+    return;
+  }
+  if (s_domDocCache.size() >= RuntimeOption::EvalDOMDocumentCacheSize) {
+    xmlFreeDoc(master);
+    return;
+  }
+  s_domDocCache.emplace(std::move(key),
+                        CachedXmlDoc{master, sb.st_mtime, sb.st_size});
+}
+
+}
+
 static xmlDocPtr dom_document_parser(DOMNode* domnode, bool isFile,
                                      const String& source,
                                      int options) {
@@ -706,11 +773,30 @@ static xmlDocPtr dom_document_parser(DOMNode* domnode, bool isFile,
   substitute_ent = domdoc->m_substituteentities;
   recover = domdoc->m_recover;
 
+  if (validate && ! (options & XML_PARSE_DTDVALID)) {
+    options |= XML_PARSE_DTDVALID;
+  }
+  if (resolve_externals && ! (options & XML_PARSE_DTDATTR)) {
+    options |= XML_PARSE_DTDATTR;
+  }
+  if (substitute_ent && ! (options & XML_PARSE_NOENT)) {
+    options |= XML_PARSE_NOENT;
+  }
+  if (keep_blanks == 0 && ! (options & XML_PARSE_NOBLANKS)) {
+    options |= XML_PARSE_NOBLANKS;
+  }
+
   req::ptr<File> stream;
+  String file_dest;
 
   if (isFile) {
-    String file_dest = libxml_get_valid_file_path(source);
+    file_dest = libxml_get_valid_file_path(source);
     if (!file_dest.empty()) {
+      if (RuntimeOption::EvalDOMDocumentCacheSize > 0 && !recover) {
+        if (auto const cached = dom_document_cache_lookup(file_dest, options)) {
+          return cached;
+        }
+      }
       // This is considerably more verbose than just using
       // xmlCreateFileParserCtxt, but it allows us to bypass the external
       // entity loading path, which is locked down by default for security
@@ -754,18 +840,6 @@ static xmlDocPtr dom_document_parser(DOMNode* domnode, bool isFile,
     ctxt->sax->warning = php_libxml_ctx_warning;
   }
 
-  if (validate && ! (options & XML_PARSE_DTDVALID)) {
-    options |= XML_PARSE_DTDVALID;
-  }
-  if (resolve_externals && ! (options & XML_PARSE_DTDATTR)) {
-    options |= XML_PARSE_DTDATTR;
-  }
-  if (substitute_ent && ! (options & XML_PARSE_NOENT)) {
-    options |= XML_PARSE_NOENT;
-  }
-  if (keep_blanks == 0 && ! (options & XML_PARSE_NOBLANKS)) {
-    options |= XML_PARSE_NOBLANKS;
-  }
   xmlCtxtUseOptions(ctxt, options);
 
   ctxt->recovery = recover;
@@ -793,6 +867,11 @@ static xmlDocPtr dom_document_parser(DOMNode* domnode, bool isFile,
         }
       }
     }
+    if (ret && isFile && !file_dest.empty() && !recover &&
+        RuntimeOption::EvalDOMDocumentCacheSize > 0 &&
+        ctxt->wellFormed && ctxt->valid) {
+      dom_document_cache_insert(file_dest, options, ret);
+    }
   } else {
     ret = nullptr;
     xmlFreeDoc(ctxt->myDoc);
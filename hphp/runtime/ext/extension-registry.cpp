@@ -2,8 +2,11 @@
 
 #include <sstream>
 
+#include <folly/Format.h>
+
 #include "hphp/runtime/base/file-util.h"
 #include "hphp/runtime/base/runtime-option.h"
+#include "hphp/util/boot-stats.h"
 #include "hphp/runtime/vm/litstr-table.h"
 #include "hphp/runtime/version.h"
 #include "hphp/system/systemlib.h"
@@ -235,6 +238,9 @@ void moduleInit() {
   SystemLib::s_inited = false;
   assertx(s_sorted);
   for (auto& ext : s_ordered) {
+    BootStats::Block timer(
+      folly::sformat("moduleInit:{}", ext->getName()),
+      RuntimeOption::ServerExecutionMode());
     ext->moduleInit();
   }
   s_initialized = true;
@@ -375,6 +375,120 @@ static bool fb_compact_serialize_is_list(const Array& arr, int64_t& index_limit)
 static int fb_compact_serialize_variant(
   StringBuffer& sd, const Variant& var, int depth);
 
+/*
+ * Exact number of bytes the encoders below will produce, so the output
+ * buffer can be reserved in a single allocation instead of doubling its
+ * way up to multi-MB blobs. The sizing pass reads only headers and
+ * scalars, never the string payloads it sizes. If it ever drifts from
+ * the encoders, StringBuffer still grows on demand, so a mismatch costs
+ * performance, not correctness.
+ */
+static size_t fb_compact_serialize_int64_size(int64_t val) {
+  if (val >= 0 && (uint64_t)val <= kInt7Mask) return 1;
+  if (val >= 0 && (uint64_t)val <= kInt13Mask) return 2;
+  if (val == (int64_t)(int16_t)val) return 1 + 2;
+  if (val >= 0 && (uint64_t)val <= kInt20Mask) return 3;
+  if (val == (int64_t)(int32_t)val) return 1 + 4;
+  if (val >= 0 && (uint64_t)val <= kInt54Mask) return 7;
+  return 1 + 8;
+}
+
+static size_t fb_compact_serialize_string_size(const StringData* str) {
+  size_t len = str->size();
+  if (len == 0) return 1;
+  if (len == 1) return 1 + 1;
+  return 1 + fb_compact_serialize_int64_size(len) + len;
+}
+
+static size_t fb_compact_serialize_variant_size(const Variant& var,
+                                                int depth) {
+  if (depth > 256) return 0;
+
+  switch (var.getType()) {
+    case KindOfUninit:
+    case KindOfNull:
+    case KindOfBoolean:
+      return 1;
+
+    case KindOfInt64:
+      return fb_compact_serialize_int64_size(var.toInt64());
+
+    case KindOfDouble:
+      return 1 + 8;
+
+    case KindOfPersistentString:
+    case KindOfString:
+      return fb_compact_serialize_string_size(var.getStringData());
+
+    case KindOfPersistentVec:
+    case KindOfVec: {
+      size_t size = 2;  // LIST_MAP + STOP
+      PackedArray::IterateV(
+        var.getArrayData(),
+        [&](TypedValue v) {
+          size += fb_compact_serialize_variant_size(VarNR(v), depth + 1);
+        }
+      );
+      return size;
+    }
+
+    case KindOfPersistentKeyset:
+    case KindOfKeyset: {
+      size_t size = 2;  // MAP + STOP
+      SetArray::Iterate(
+        SetArray::asSet(var.getArrayData()),
+        [&](TypedValue v) {
+          if (isStringType(v.m_type)) {
+            size += 2 * fb_compact_serialize_string_size(v.m_data.pstr);
+          } else {
+            size += 2 * fb_compact_serialize_int64_size(v.m_data.num);
+          }
+        }
+      );
+      return size;
+    }
+
+    case KindOfPersistentDict:
+    case KindOfDict:
+    case KindOfPersistentShape:
+    case KindOfShape:
+    case KindOfPersistentArray:
+    case KindOfArray: {
+      Array arr = var.toArray();
+      int64_t index_limit;
+      if (arr->isPHPArray() &&
+          fb_compact_serialize_is_list(arr, index_limit)) {
+        size_t size = 2;  // LIST_MAP + STOP
+        for (int64_t i = 0; i < index_limit; ++i) {
+          size += arr.exists(i) ?
+            fb_compact_serialize_variant_size(arr[i], depth + 1) :
+            1;  // SKIP
+        }
+        return size;
+      }
+      size_t size = 2;  // MAP + STOP
+      IterateKV(
+        arr.get(),
+        [&](Cell k, TypedValue v) {
+          size += isStringType(k.m_type) ?
+            fb_compact_serialize_string_size(k.m_data.pstr) :
+            fb_compact_serialize_int64_size(k.m_data.num);
+          size += fb_compact_serialize_variant_size(VarNR(v), depth + 1);
+        }
+      );
+      return size;
+    }
+
+    case KindOfObject:
+    case KindOfResource:
+    case KindOfRef:
+    case KindOfFunc:
+    case KindOfClass:
+      return 1;  // NULL; the encoder warns and aborts anyway
+  }
+  not_reached();
+}
+
 static void fb_compact_serialize_array_as_list_map(
     StringBuffer& sb, const Array& arr, int64_t index_limit, int depth) {
   fb_compact_serialize_code(sb, FB_CS_LIST_MAP);
@@ -555,7 +669,9 @@ String fb_compact_serialize(const Variant& thing) {
     }
   }
 
-  StringBuffer sb;
+  auto const size = std::min<size_t>(
+    fb_compact_serialize_variant_size(thing, 0), StringData::MaxSize);
+  StringBuffer sb(size);
   if (fb_compact_serialize_variant(sb, thing, 0)) {
     return String();
   }
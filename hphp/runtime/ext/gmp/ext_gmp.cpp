@@ -17,6 +17,7 @@
 
 #include "ext_gmp.h"
 
+#include <cstdint>
 #include <cstdlib>
 #include <float.h>
 
@@ -49,6 +50,54 @@ static Object mpzToGMPObject(mpz_t gmpData) {
 }
 
 
+static Object int64ToGMPObject(int64_t num) {
+  Object ret(GMP::allocObject());
+
+  auto data = Native::data<GMPData>(ret);
+  data->setGMPInt64(num);
+
+  return ret;
+}
+
+
+// Fast-path operand fetch: succeeds iff the value is already a machine
+// integer (int/bool) or a GMP object whose value fits in a signed long,
+// without initializing any temporary libgmp state. Strings and doubles
+// take the general mpz path so their conversion rules and warnings stay
+// unchanged.
+static bool variantToInt64Fast(const Variant& data, int64_t& num) {
+  switch (data.getType()) {
+
+  case KindOfInt64:
+  case KindOfBoolean:
+    num = data.toInt64();
+    return true;
+
+  case KindOfObject: {
+    Object gmpObject = data.toObject();
+    if (!gmpObject.instanceof(s_GMP_GMP)) {
+      return false;
+    }
+
+    auto gmpObjectData = Native::data<GMPData>(gmpObject);
+    if (!gmpObjectData) {
+      return false;
+    }
+
+    auto& gmpData = gmpObjectData->getGMPMpz();
+    if (!mpz_fits_slong_p(gmpData)) {
+      return false;
+    }
+    num = mpz_get_si(gmpData);
+    return true;
+  }
+
+  default:
+    return false;
+  }
+}
+
+
 static bool setMpzFromString(mpz_t gmpData,
                              const String& stringInput,
                              int64_t base) {
@@ -176,6 +225,11 @@ static bool variantToGMPData(const char* const fnCaller,
 // extension functions
 static Variant HHVM_FUNCTION(gmp_abs,
                              const Variant& data) {
+  int64_t num;
+  if (variantToInt64Fast(data, num) && num != INT64_MIN) {
+    return int64ToGMPObject(num < 0 ? -num : num);
+  }
+
   mpz_t gmpReturn, gmpData;
 
   if (!variantToGMPData("gmp_abs", gmpData, data)) {
@@ -197,6 +251,12 @@ static Variant HHVM_FUNCTION(gmp_abs,
 static Variant HHVM_FUNCTION(gmp_add,
                              const Variant& dataA,
                              const Variant& dataB) {
+  int64_t numA, numB, numReturn;
+  if (variantToInt64Fast(dataA, numA) && variantToInt64Fast(dataB, numB) &&
+      !__builtin_add_overflow(numA, numB, &numReturn)) {
+    return int64ToGMPObject(numReturn);
+  }
+
   mpz_t gmpDataA, gmpDataB, gmpReturn;
 
   if (!variantToGMPData("gmp_add", gmpDataA, dataA)) {
@@ -274,6 +334,11 @@ static void HHVM_FUNCTION(gmp_clrbit,
 static Variant HHVM_FUNCTION(gmp_cmp,
                              const Variant& dataA,
                              const Variant& dataB) {
+  int64_t numA, numB;
+  if (variantToInt64Fast(dataA, numA) && variantToInt64Fast(dataB, numB)) {
+    return (int64_t)(numA > numB) - (int64_t)(numA < numB);
+  }
+
   mpz_t gmpDataA, gmpDataB;
 
   if (!variantToGMPData("gmp_cmp", gmpDataA, dataA)) {
@@ -661,6 +726,10 @@ static Variant HHVM_FUNCTION(gmp_init,
 
 static int64_t HHVM_FUNCTION(gmp_intval,
                              const Variant& data) {
+  if (data.isInteger()) {
+    return data.toInt64();
+  }
+
   mpz_t gmpData;
 
   if (data.isArray()
@@ -792,6 +861,12 @@ static Variant HHVM_FUNCTION(gmp_mod,
 static Variant HHVM_FUNCTION(gmp_mul,
                              const Variant& dataA,
                              const Variant& dataB) {
+  int64_t numA, numB, numReturn;
+  if (variantToInt64Fast(dataA, numA) && variantToInt64Fast(dataB, numB) &&
+      !__builtin_mul_overflow(numA, numB, &numReturn)) {
+    return int64ToGMPObject(numReturn);
+  }
+
   mpz_t gmpDataA, gmpDataB, gmpReturn;
 
   if (!variantToGMPData("gmp_mul", gmpDataA, dataA)) {
@@ -817,6 +892,11 @@ static Variant HHVM_FUNCTION(gmp_mul,
 
 static Variant HHVM_FUNCTION(gmp_neg,
                              const Variant& data) {
+  int64_t num;
+  if (variantToInt64Fast(data, num) && num != INT64_MIN) {
+    return int64ToGMPObject(-num);
+  }
+
   mpz_t gmpReturn, gmpData;
 
   if (!variantToGMPData("gmp_neg", gmpData, data)) {
@@ -1241,6 +1321,12 @@ static Variant HHVM_FUNCTION(gmp_strval,
 static Variant HHVM_FUNCTION(gmp_sub,
                              const Variant& dataA,
                              const Variant& dataB) {
+  int64_t numA, numB, numReturn;
+  if (variantToInt64Fast(dataA, numA) && variantToInt64Fast(dataB, numB) &&
+      !__builtin_sub_overflow(numA, numB, &numReturn)) {
+    return int64ToGMPObject(numReturn);
+  }
+
   mpz_t gmpDataA, gmpDataB, gmpReturn;
 
   if (!variantToGMPData("gmp_sub", gmpDataA, dataA)) {
@@ -1399,6 +1485,16 @@ void GMPData::setGMPMpz(const mpz_t data) {
    }
 }
 
+
+void GMPData::setGMPInt64(int64_t num) {
+   if (m_isInit) {
+     mpz_set_si(m_gmpMpz, num);
+   } else {
+     m_isInit = true;
+     mpz_init_set_si(m_gmpMpz, num);
+   }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // extension
 struct GMPExtension final : Extension {
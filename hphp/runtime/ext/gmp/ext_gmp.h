@@ -97,6 +97,7 @@ struct GMPData {
 
   void           close();
   void           setGMPMpz(const mpz_t data);
+  void           setGMPInt64(int64_t num);
   mpz_t&         getGMPMpz() { return m_gmpMpz; }
 
 private:
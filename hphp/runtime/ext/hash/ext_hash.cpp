@@ -18,6 +18,8 @@
 #include "hphp/runtime/ext/hash/ext_hash.h"
 #include <algorithm>
 #include <memory>
+#include <folly/ScopeGuard.h>
+#include "hphp/runtime/base/array-iterator.h"
 #include "hphp/runtime/base/comparisons.h"
 #include "hphp/runtime/ext/std/ext_std_file.h"
 #include "hphp/runtime/ext/string/ext_string.h"
@@ -52,6 +54,7 @@ static struct HashExtension final : Extension {
   void moduleInit() override {
     HHVM_FE(hash);
     HHVM_FE(hash_algos);
+    HHVM_FE(hash_batch);
     HHVM_FE(hash_file);
     HHVM_FE(hash_final);
     HHVM_FE(hash_init);
@@ -222,14 +225,28 @@ Array HHVM_FUNCTION(hash_algos) {
 }
 
 static HashEnginePtr php_hash_fetch_ops(const String& algo) {
-  HashEngineMap::const_iterator iter =
-    HashEngines.find(HHVM_FN(strtolower)(algo).data());
+  // Algorithm names are almost always passed lowercase already; avoid
+  // materializing a lowered copy in that case.
+  bool is_lower = true;
+  for (int i = 0; i < algo.size(); ++i) {
+    if (isupper((unsigned char)algo.data()[i])) {
+      is_lower = false;
+      break;
+    }
+  }
+  HashEngineMap::const_iterator iter = is_lower
+    ? HashEngines.find(algo.data())
+    : HashEngines.find(HHVM_FN(strtolower)(algo).data());
   if (iter == HashEngines.end()) {
     return HashEnginePtr();
   }
   return iter->second;
 }
 
+// Large enough for every engine's context (the biggest are haval/snefru
+// at a few hundred bytes); bigger contexts fall back to malloc.
+constexpr size_t kStackHashContextSize = 1024;
+
 static Variant php_hash_do_hash(const String& algo, const String& data,
                                 bool isfilename,
                                 bool raw_output) {
@@ -246,7 +263,9 @@ static Variant php_hash_do_hash(const String& algo, const String& data,
     }
   }
 
-  void *context = malloc(ops->context_size);
+  char stack_context[kStackHashContextSize];
+  void *context = LIKELY(ops->context_size <= sizeof(stack_context))
+    ? stack_context : malloc(ops->context_size);
   ops->hash_init(context);
 
   if (isfilename) {
@@ -263,7 +282,7 @@ static Variant php_hash_do_hash(const String& algo, const String& data,
   String raw = String(ops->digest_size, ReserveString);
   char *digest = raw.mutableData();
   ops->hash_final((unsigned char *)digest, context);
-  free(context);
+  if (context != stack_context) free(context);
 
   raw.setSize(ops->digest_size);
   if (raw_output) {
@@ -277,6 +296,35 @@ Variant HHVM_FUNCTION(hash, const String& algo, const String& data,
   return php_hash_do_hash(algo, data, false, raw_output);
 }
 
+Variant HHVM_FUNCTION(hash_batch, const String& algo, const Array& inputs,
+                                  bool raw_output /* = false */) {
+  HashEnginePtr ops = php_hash_fetch_ops(algo);
+  if (!ops) {
+    raise_warning("Unknown hashing algorithm: %s", algo.data());
+    return false;
+  }
+
+  // One engine lookup and one context serve every input, so small-string
+  // batches pay only the digest itself per element.
+  char stack_context[kStackHashContextSize];
+  void *context = LIKELY(ops->context_size <= sizeof(stack_context))
+    ? stack_context : malloc(ops->context_size);
+  SCOPE_EXIT { if (context != stack_context) free(context); };
+
+  Array ret = Array::Create();
+  for (ArrayIter iter(inputs); iter; ++iter) {
+    const String data = iter.second().toString();
+    ops->hash_init(context);
+    ops->hash_update(context, (unsigned char *)data.data(), data.size());
+    String raw = String(ops->digest_size, ReserveString);
+    ops->hash_final((unsigned char *)raw.mutableData(), context);
+    raw.setSize(ops->digest_size);
+    ret.set(iter.first(),
+            raw_output ? Variant(raw) : Variant(HHVM_FN(bin2hex)(raw)));
+  }
+  return ret;
+}
+
 Variant HHVM_FUNCTION(hash_file, const String& algo, const String& filename,
                                  bool raw_output /* = false */) {
   if (filename.size() != strlen(filename.data())) {
@@ -28,6 +28,8 @@ constexpr int64_t k_HASH_HMAC = 1;
 Variant HHVM_FUNCTION(hash, const String& algo, const String& data,
                             bool raw_output = false);
 Array HHVM_FUNCTION(hash_algos);
+Variant HHVM_FUNCTION(hash_batch, const String& algo, const Array& inputs,
+                                  bool raw_output = false);
 Variant HHVM_FUNCTION(hash_init, const String& algo, int64_t options = 0,
                                  const String& key = null_string);
 Variant HHVM_FUNCTION(hash_file, const String& algo, const String& filename,
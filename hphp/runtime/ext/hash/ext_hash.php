@@ -19,6 +19,26 @@
 function hash(string $algo, string $data,
               bool $raw_output = false): mixed;
 
+/**
+ * hash_batch() - HHVM specific.
+ *
+ * Hashes every element of an array with a single engine lookup and
+ * hash context, amortizing the per-call overhead of hash() when
+ * digesting many small strings.
+ *
+ * @param string $algo     - Name of selected hashing algorithm
+ *                           (i.e. "md5", "sha256", "haval160,4", etc..)
+ * @param array $inputs    - Messages to be hashed; keys are preserved.
+ * @param bool $raw_output - When set to TRUE, outputs raw binary data.
+ *                           FALSE outputs lowercase hexits.
+ *
+ * @return array - The calculated message digests, keyed like $inputs.
+ *                 On error, FALSE is returned.
+ */
+<<__Native, __HipHopSpecific, __IsFoldable, __Rx>>
+function hash_batch(string $algo, array $inputs,
+                    bool $raw_output = false): mixed;
+
 /**
  * hash_algos() - http://php.net/function.hash-algos
  *
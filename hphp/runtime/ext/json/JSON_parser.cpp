@@ -34,6 +34,10 @@ SOFTWARE.
 
 #include <vector>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 #include "hphp/runtime/base/builtin-functions.h"
 #include "hphp/runtime/base/collections.h"
 #include "hphp/runtime/base/string-buffer.h"
@@ -347,6 +351,7 @@ struct SimpleParser {
  private:
   SimpleParser(const char* input, int length, TypedValue* buffer)
       : p(input),
+        end(input + length),
         top(buffer),
         array_depth(-kMaxArrayDepth) /* Start negative to simplify check. */ {
     assertx(input[length] == 0);  // Parser relies on sentinel to avoid checks.
@@ -422,6 +427,37 @@ struct SimpleParser {
   bool parseString() {
     int len = 0;
     auto const charTop = reinterpret_cast<signed char*>(top);
+#ifdef __SSE2__
+    /*
+     * Scan 16 bytes at a time, bulk-copying clean runs onto the stack and
+     * stopping at the first quote, escape, or control/non-ASCII byte (the
+     * signed compare against ' ' catches both, as in the scalar loop).
+     */
+    while (p + 16 <= end) {
+      auto const v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+      auto const stop =
+        _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\"')),
+        _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\\')),
+        _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\'')),
+                     _mm_cmplt_epi8(v, _mm_set1_epi8(' ')))));
+      auto const mask = _mm_movemask_epi8(stop);
+      if (mask == 0) {
+        memcpy(charTop + len, p, 16);
+        len += 16;
+        p += 16;
+        continue;
+      }
+      auto const run = __builtin_ctz(mask);
+      memcpy(charTop + len, p, run);
+      len += run;
+      p += run;
+      if (*p != '\"') return false;  // Escape or control char: unsupported.
+      ++p;
+      pushStringData(StringData::Make(
+        reinterpret_cast<char*>(charTop), len, CopyString));
+      return true;
+    }
+#endif
     for (signed char ch = *p++; ch != '\"'; ch = *p++) {
       charTop[len++] = ch;
       // Signed char means less than ' ' also catches non-ASCII.
@@ -558,6 +594,7 @@ struct SimpleParser {
   }
 
   const char* p;
+  const char* end;
   TypedValue* top;
   int array_depth;
 };
@@ -802,7 +839,7 @@ static void json_create_zval(Variant &z, UncheckedBuffer &buf, DataType type,
           z = copy_and_clear(buf);
         }
       } else {
-        z = fast_strtoll_base10(buf.data());
+        z = fast_strtoll_base10(buf.data(), buf.data() + buf.size());
       }
       return;
     }
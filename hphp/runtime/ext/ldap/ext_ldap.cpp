@@ -1085,7 +1085,7 @@ bool HHVM_FUNCTION(ldap_modify_batch,
           /* fill it */
           ldap_mods[i]->mod_bvalues[j]->bv_len = modval.size();
           ldap_mods[i]->mod_bvalues[j]->bv_val =
-            req::make_raw_array<char>(modval.size());
+            req::make_raw_array_uninit<char>(modval.size());
           memcpy(ldap_mods[i]->mod_bvalues[j]->bv_val, modval.data(),
                  modval.size());
         }
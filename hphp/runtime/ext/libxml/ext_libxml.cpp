@@ -24,6 +24,7 @@
 #include "hphp/runtime/base/request-event-handler.h"
 #include "hphp/runtime/base/root-map.h"
 #include "hphp/runtime/base/stream-wrapper-registry.h"
+#include "hphp/runtime/base/string-buffer.h"
 #include "hphp/runtime/base/string-util.h"
 #include "hphp/runtime/base/zend-url.h"
 #include "hphp/runtime/ext/std/ext_std_file.h"
@@ -253,6 +254,45 @@ int libxml_streams_IO_nop_close(void* /*context*/) {
   return 0;
 }
 
+static int libxml_dump_IO_write(void* context, const char* buffer, int len) {
+  static_cast<StringBuffer*>(context)->append(buffer, len);
+  return len;
+}
+
+/*
+ * Serialize directly into a request-local String via an xmlOutputBuffer.
+ * This avoids the malloc'd intermediate buffer that the
+ * xmlDocDumpMemory-family APIs allocate, plus the CopyString memcpy (and
+ * xmlFree) callers would then need to turn it into a String.
+ */
+String libxml_dump_doc_to_string(xmlDocPtr doc,
+                                 const char* encoding /* = nullptr */) {
+  StringBuffer sb;
+  xmlOutputBufferPtr outbuf = xmlOutputBufferCreateIO(
+    libxml_dump_IO_write, libxml_streams_IO_nop_close, &sb, nullptr);
+  if (outbuf == nullptr) {
+    return String();
+  }
+  // Closes outbuf regardless of success.
+  if (xmlSaveFormatFileTo(outbuf, doc, encoding, 0) < 0) {
+    return String();
+  }
+  return sb.detach();
+}
+
+String libxml_dump_node_to_string(xmlDocPtr doc, xmlNodePtr node,
+                                  const char* encoding /* = nullptr */) {
+  StringBuffer sb;
+  xmlOutputBufferPtr outbuf = xmlOutputBufferCreateIO(
+    libxml_dump_IO_write, libxml_streams_IO_nop_close, &sb, nullptr);
+  if (outbuf == nullptr) {
+    return String();
+  }
+  xmlNodeDumpOutput(outbuf, doc, node, 0, 0, encoding);
+  xmlOutputBufferClose(outbuf);
+  return sb.detach();
+}
+
 static xmlExternalEntityLoader s_default_entity_loader = nullptr;
 
 /*
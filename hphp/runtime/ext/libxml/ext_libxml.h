@@ -30,6 +30,15 @@ void libxml_add_error(const std::string& msg);
 String libxml_get_valid_file_path(const String& source);
 String libxml_get_valid_file_path(const char* source);
 
+/*
+ * Serialize a document (or a node's subtree) straight into a request-local
+ * String, bypassing the malloc'd scratch buffer of xmlDocDumpMemory and the
+ * copy out of it. Returns a null String on failure.
+ */
+String libxml_dump_doc_to_string(xmlDocPtr doc, const char* encoding = nullptr);
+String libxml_dump_node_to_string(xmlDocPtr doc, xmlNodePtr node,
+                                  const char* encoding = nullptr);
+
 int libxml_streams_IO_read(void* context, char* buffer, int len);
 int libxml_streams_IO_write(void* context, const char* buffer, int len);
 int libxml_streams_IO_close(void* context);
@@ -31,6 +31,10 @@
 
 #include <map>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 extern "C" {
 #include <mbfl/mbfl_convert.h>
 #include <mbfl/mbfilter.h>
@@ -2556,9 +2560,21 @@ Variant HHVM_FUNCTION(mb_stristr,
   return false;
 }
 
+static bool isUtf8(const Variant& encoding);
+static bool containsNonAscii(folly::StringPiece s);
+
 Variant HHVM_FUNCTION(mb_strlen,
                       const String& str,
                       const Variant& opt_encoding) {
+  /* Fast-case for ASCII under UTF-8: one character per byte, so the length
+     is just the byte count and the multibyte machinery can be skipped. */
+  if ((isUtf8(opt_encoding) ||
+       (opt_encoding.isNull() &&
+        MBSTRG(current_internal_encoding)->no_encoding ==
+          mbfl_no_encoding_utf8)) &&
+      !containsNonAscii(str.slice())) {
+    return str.size();
+  }
   const String encoding = convertArg(opt_encoding);
 
   mbfl_string string;
@@ -2900,27 +2916,73 @@ static bool isUtf8(const Variant& encoding) {
   return encoding.getStringDataOrNull() == s_utf_8.get();
 }
 
+/**
+ * Return true if the byte sequence contains any byte >= 128 (thus non-ASCII).
+ * On SSE2 the scan runs 16 bytes at a time; the high bit of each byte falls
+ * directly out of _mm_movemask_epi8.
+ */
+ALWAYS_INLINE
+static bool containsNonAscii(folly::StringPiece s) {
+  auto p = reinterpret_cast<const unsigned char*>(s.data());
+  auto const end = p + s.size();
+#ifdef __SSE2__
+  for (; p + 16 <= end; p += 16) {
+    auto const block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    if (_mm_movemask_epi8(block)) return true;
+  }
+#endif
+  for (; p < end; ++p) {
+    if (*p >= 128) return true;
+  }
+  return false;
+}
+
 /**
  * Given a byte sequence, return
  *    0 if it contains bytes >= 128 (thus non-ASCII), else
- *   -1 if it contains any upper-case character ('A'-'Z'), else
- *    1 (and thus is a lower-case ASCII string).
+ *   -1 if it contains any character in [rangeLo..rangeHi], else
+ *    1 (and thus is ASCII with no character in that range).
  */
 ALWAYS_INLINE
-static int isUtf8AsciiLower(folly::StringPiece s) {
-  const auto bytelen = s.size();
+static int isUtf8AsciiOutsideRange(folly::StringPiece s,
+                                   char rangeLo, char rangeHi) {
   bool caseOK = true;
-  for (uint32_t i = 0; i < bytelen; ++i) {
-    uint8_t byte = s[i];
+  auto p = reinterpret_cast<const unsigned char*>(s.data());
+  auto const end = p + s.size();
+#ifdef __SSE2__
+  auto const below = _mm_set1_epi8(rangeLo - 1);
+  auto const above = _mm_set1_epi8(rangeHi + 1);
+  for (; p + 16 <= end; p += 16) {
+    auto const block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    if (_mm_movemask_epi8(block)) return 0;
+    /* All bytes are < 128 here, so signed comparisons are safe. */
+    auto const inRange = _mm_and_si128(_mm_cmpgt_epi8(block, below),
+                                       _mm_cmplt_epi8(block, above));
+    if (_mm_movemask_epi8(inRange)) caseOK = false;
+  }
+#endif
+  for (; p < end; ++p) {
+    uint8_t byte = *p;
     if (byte >= 128) {
       return 0;
-    } else if (byte <= 'Z' && byte >= 'A') {
+    } else if (byte >= rangeLo && byte <= rangeHi) {
       caseOK = false;
     }
   }
   return caseOK ? 1 : -1;
 }
 
+/**
+ * Given a byte sequence, return
+ *    0 if it contains bytes >= 128 (thus non-ASCII), else
+ *   -1 if it contains any upper-case character ('A'-'Z'), else
+ *    1 (and thus is a lower-case ASCII string).
+ */
+ALWAYS_INLINE
+static int isUtf8AsciiLower(folly::StringPiece s) {
+  return isUtf8AsciiOutsideRange(s, 'A', 'Z');
+}
+
 /**
  * Return a string containing the lower-case of a given ASCII string.
  */
@@ -2942,17 +3004,7 @@ static StringData* asciiToLower(const StringData* s) {
 /* Like isUtf8AsciiLower, but with upper/lower swapped. */
 ALWAYS_INLINE
 static int isUtf8AsciiUpper(folly::StringPiece s) {
-  const auto bytelen = s.size();
-  bool caseOK = true;
-  for (uint32_t i = 0; i < bytelen; ++i) {
-    uint8_t byte = s[i];
-    if (byte >= 128) {
-      return 0;
-    } else if (byte >= 'a' && byte <= 'z') {
-      caseOK = false;
-    }
-  }
-  return caseOK ? 1 : -1;
+  return isUtf8AsciiOutsideRange(s, 'a', 'z');
 }
 
 /* Like asciiToLower, but with upper/lower swapped. */
@@ -3046,6 +3098,14 @@ Variant HHVM_FUNCTION(mb_strtoupper,
 Variant HHVM_FUNCTION(mb_strwidth,
                       const String& str,
                       const Variant& opt_encoding) {
+  /* Fast-case for ASCII under UTF-8: every ASCII character has width 1. */
+  if ((isUtf8(opt_encoding) ||
+       (opt_encoding.isNull() &&
+        MBSTRG(current_internal_encoding)->no_encoding ==
+          mbfl_no_encoding_utf8)) &&
+      !containsNonAscii(str.slice())) {
+    return str.size();
+  }
   const String encoding = convertArg(opt_encoding);
 
   mbfl_string string;
@@ -205,30 +205,35 @@ struct MemcachedData {
       uint32_t maxLength;
       int status;
 
-      /* new-style */
+      /* new-style; the uncompressed length is known up front, so
+         decompress straight into the request-heap string — one allocation
+         per value, no intermediate buffer */
       if ((flags & MEMC_VAL_COMPRESSION_FASTLZ ||
            flags & MEMC_VAL_COMPRESSION_ZLIB)
           && payloadLength > sizeof(uint32_t)) {
         memcpy(&maxLength, payload, sizeof(uint32_t));
         if (maxLength < std::numeric_limits<uint32_t>::max()) {
-          buffer.resize(maxLength + 1);
           payloadLength -= sizeof(uint32_t);
           payload += sizeof(uint32_t);
+          decompPayload = String(maxLength, ReserveString);
+          auto decompData = decompPayload.mutableData();
           bufferSize = maxLength;
 
           if (flags & MEMC_VAL_COMPRESSION_FASTLZ) {
             bufferSize = fastlz_decompress(payload, payloadLength,
-                                           buffer.data(), maxLength);
+                                           decompData, maxLength);
             done = (bufferSize > 0);
           } else if (flags & MEMC_VAL_COMPRESSION_ZLIB) {
-            status = uncompress((Bytef *)buffer.data(), &bufferSize,
+            status = uncompress((Bytef *)decompData, &bufferSize,
                                 (const Bytef *)payload, (uLong)payloadLength);
             done = (status == Z_OK);
           }
+          if (done) decompPayload.setSize(bufferSize);
         }
       }
 
-      /* old-style */
+      /* old-style; the length is unknown, so grow a scratch buffer until
+         the value fits, then copy it out */
       if (!done) {
         for (int factor = 1; factor <= 16; ++factor) {
           if (payloadLength >=
@@ -246,13 +251,14 @@ struct MemcachedData {
             break;
           }
         }
+        if (!done) {
+          raise_warning("could not uncompress value");
+          return false;
+        }
+        decompPayload =
+          String::attach(StringData::Make(buffer.data(), bufferSize,
+                                          CopyString));
       }
-      if (!done) {
-        raise_warning("could not uncompress value");
-        return false;
-      }
-      decompPayload =
-        String::attach(StringData::Make(buffer.data(), bufferSize, CopyString));
     } else {
       decompPayload =
         String::attach(StringData::Make(payload, payloadLength, CopyString));
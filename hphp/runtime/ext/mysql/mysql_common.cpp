@@ -1699,7 +1699,11 @@ Variant php_mysql_fetch_hash(const Resource& result, int result_type) {
       ret.set(i, data);
     }
     if (result_type & PHP_MYSQL_ASSOC) {
-      ret.set(String(mysql_field->name, CopyString), data);
+      // Use the result's cached field names so the key StringData (and
+      // its hash, after the first row) is shared across every row of
+      // the result set rather than rebuilt per fetch.
+      auto const info = res->getFieldInfo(i);
+      ret.set(info ? info->name : String(mysql_field->name, CopyString), data);
     }
   }
   return ret;
@@ -33,7 +33,9 @@
  */
 
 #include <array>
+#include <cstdio>
 #include <set>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 #include <boost/dynamic_bitset.hpp>
@@ -443,6 +445,71 @@ std::vector<int> toBoundIntVector(const Array& arr, int64_t max) {
   return result;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// Dominator dump
+
+// Everything the background dump thread needs, copied out of the
+// request before it is spawned: the graph structure (node pointers are
+// already nullified in a captured graph), a name per node, and the
+// destination path. Nothing here refers back to request memory.
+struct DominatorDump {
+  HeapGraph graph;
+  std::vector<uint32_t> nameIds; // per node, into names
+  std::vector<std::string> names;
+  std::string path;
+};
+
+// Runs on a detached background thread: the O((V+E) log V) dominator
+// computation and the file write both happen here, so the owning
+// request only pays for the copy in heapgraph_dominator_dump().
+void writeDominatorDump(std::unique_ptr<DominatorDump> dump) {
+  auto const tree = makeDominatorTree(dump->graph);
+  auto const retained = computeRetainedSizes(dump->graph, tree);
+  auto const numNodes = dump->graph.nodes.size();
+  auto const numNames = dump->names.size();
+
+  // Retained-size rollups: for each name, how many reachable nodes and
+  // how many retained bytes. Nested nodes of the same name each count,
+  // so rollups over-attribute shared substructure; that is the usual
+  // convention for per-class retained sizes.
+  std::vector<uint64_t> rollupNodes(numNames, 0), rollupBytes(numNames, 0);
+  for (auto v : tree.order) {
+    rollupNodes[dump->nameIds[v]] += 1;
+    rollupBytes[dump->nameIds[v]] += retained[v];
+  }
+
+  auto const file = fopen(dump->path.c_str(), "wb");
+  if (!file) return;
+  auto const u32 = [&](uint32_t v) { fwrite(&v, sizeof v, 1, file); };
+  auto const u64 = [&](uint64_t v) { fwrite(&v, sizeof v, 1, file); };
+
+  // Format (little-endian, version in the magic):
+  //   "HHGDOM01"
+  //   u32 node count, u32 name count
+  //   names:   u32 length + bytes, per name
+  //   nodes:   u32 idom (0xffffffff if none), u32 name id,
+  //            u64 self size, u64 retained size, per node
+  //   rollups: u64 node count, u64 retained bytes, per name
+  fwrite("HHGDOM01", 8, 1, file);
+  u32(numNodes);
+  u32(numNames);
+  for (auto const& name : dump->names) {
+    u32(name.size());
+    fwrite(name.data(), 1, name.size(), file);
+  }
+  for (size_t v = 0; v < numNodes; ++v) {
+    u32(tree.idom[v] == -1 ? 0xffffffffu : uint32_t(tree.idom[v]));
+    u32(dump->nameIds[v]);
+    u64(dump->graph.nodes[v].size);
+    u64(retained[v]);
+  }
+  for (size_t i = 0; i < numNames; ++i) {
+    u64(rollupNodes[i]);
+    u64(rollupBytes[i]);
+  }
+  fclose(file);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Exports
 
@@ -638,6 +705,54 @@ Array HHVM_FUNCTION(heapgraph_stats, const Resource& resource) {
   return result;
 }
 
+bool HHVM_FUNCTION(heapgraph_dominator_dump,
+                   const Resource& resource,
+                   const String& path) {
+  auto hgptr = get_valid_heapgraph_context_resource(resource, __FUNCTION__);
+  if (!hgptr) return false;
+
+  // Copy the graph and resolve every node to a name while the request
+  // (and the Class/type-scan structures the names come from) is still
+  // alive; the expensive analysis then runs off-request.
+  auto dump = std::make_unique<DominatorDump>();
+  dump->graph = hgptr->hg;
+  dump->path = path.toCppString();
+
+  std::unordered_map<std::string, uint32_t> ids;
+  auto const nameId = [&](std::string name) {
+    auto const it = ids.find(name);
+    if (it != ids.end()) return it->second;
+    auto const id = uint32_t(dump->names.size());
+    dump->names.push_back(std::move(name));
+    ids.emplace(dump->names.back(), id);
+    return id;
+  };
+
+  auto const n = hgptr->hg.nodes.size();
+  dump->nameIds.reserve(n);
+  for (size_t i = 0; i < n; ++i) {
+    auto const& node = hgptr->hg.nodes[i];
+    auto const& cnode = hgptr->cnodes[i];
+    std::string name;
+    if (node.is_root) {
+      name = "(root)";
+    } else if (cnode.heap_object.cls) {
+      name = cnode.heap_object.cls->name()->toCppString();
+    } else if (type_scan::hasNonConservative() &&
+               node.tyindex > type_scan::kIndexUnknownNoPtrs) {
+      name = type_scan::getName(node.tyindex);
+    } else {
+      name = header_names[int(cnode.heap_object.kind)];
+    }
+    dump->nameIds.push_back(nameId(std::move(name)));
+  }
+
+  std::thread([] (DominatorDump* d) {
+    writeDominatorDump(std::unique_ptr<DominatorDump>(d));
+  }, dump.release()).detach();
+  return true;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Extension
 
@@ -659,6 +774,7 @@ struct heapgraphExtension final : Extension {
     HHVM_FALIAS(HH\\heapgraph_node_in_edges, heapgraph_node_in_edges);
     HHVM_FALIAS(HH\\heapgraph_dfs_nodes, heapgraph_dfs_nodes);
     HHVM_FALIAS(HH\\heapgraph_dfs_edges, heapgraph_dfs_edges);
+    HHVM_FALIAS(HH\\heapgraph_dominator_dump, heapgraph_dominator_dump);
 
     loadSystemlib();
   }
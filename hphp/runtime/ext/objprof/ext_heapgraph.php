@@ -213,4 +213,22 @@ function heapgraph_node_out_edges(
   int $index
 ): varray<darray<string, mixed>>;
 
+/**
+ * Compute the dominator tree of the captured heap graph with retained
+ * sizes and per-class/type rollups, and write it to $path in a binary
+ * format for offline analysis. The analysis and the write run on a
+ * background thread; the calling request only pays for copying the
+ * graph structure out of the resource.
+ *
+ * @param resource $heapgraph - The resource obtained with heapgraph_create
+ * @param string $path - Destination file
+ *
+ * @return bool - Whether the dump was scheduled
+ */
+<<__Native>>
+function heapgraph_dominator_dump(
+  resource $heapgraph,
+  string $path,
+): bool;
+
 }
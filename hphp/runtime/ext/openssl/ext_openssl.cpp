@@ -2426,6 +2426,58 @@ Variant HHVM_FUNCTION(openssl_verify, const String& data,
   return err;
 }
 
+Variant HHVM_FUNCTION(openssl_verify_batch, const Array& data_sig_pairs,
+                                            const Variant& pub_key_id,
+                     const Variant& signature_alg /* = k_OPENSSL_ALGO_SHA1 */) {
+  const EVP_MD *mdtype = nullptr;
+
+  if (signature_alg.isInteger()) {
+    mdtype = php_openssl_get_evp_md_from_algo(signature_alg.toInt64Val());
+  } else if (signature_alg.isString()) {
+    mdtype = EVP_get_digestbyname(signature_alg.toString().data());
+  }
+
+  if (!mdtype) {
+    raise_warning("Unknown signature algorithm.");
+    return false;
+  }
+
+  auto okey = Key::Get(pub_key_id, true);
+  if (!okey) {
+    raise_warning("supplied key param cannot be coerced into a public key");
+    return false;
+  }
+
+  // The key coercion and digest lookup above are done once for the whole
+  // batch, and a single context is re-initialized per pair (EVP_VerifyInit
+  // resets it), which is where the savings over per-pair openssl_verify()
+  // calls come from.
+  EVP_MD_CTX *md_ctx = EVP_MD_CTX_new();
+  SCOPE_EXIT {
+    EVP_MD_CTX_free(md_ctx);
+  };
+
+  Array ret = Array::Create();
+  for (ArrayIter iter(data_sig_pairs); iter; ++iter) {
+    Array pair = iter.second().toArray();
+    if (pair.size() != 2 || !pair.exists(0) || !pair.exists(1)) {
+      raise_warning("openssl_verify_batch(): each element must be an "
+                    "array of [data, signature]");
+      ret.set(iter.first(), -1);
+      continue;
+    }
+    const String data = pair[0].toString();
+    const String signature = pair[1].toString();
+
+    EVP_VerifyInit(md_ctx, mdtype);
+    EVP_VerifyUpdate(md_ctx, (unsigned char*)data.data(), data.size());
+    int err = EVP_VerifyFinal(md_ctx, (unsigned char *)signature.data(),
+                              signature.size(), okey->m_key);
+    ret.set(iter.first(), err);
+  }
+  return ret;
+}
+
 bool HHVM_FUNCTION(openssl_x509_check_private_key, const Variant& cert,
                                                    const Variant& key) {
   auto ocert = Certificate::Get(cert);
@@ -3434,6 +3486,7 @@ struct opensslExtension final : Extension {
     HHVM_FE(openssl_seal);
     HHVM_FE(openssl_sign);
     HHVM_FE(openssl_verify);
+    HHVM_FE(openssl_verify_batch);
     HHVM_FE(openssl_x509_check_private_key);
     HHVM_FE(openssl_x509_checkpurpose);
     HHVM_FE(openssl_x509_export_to_file);
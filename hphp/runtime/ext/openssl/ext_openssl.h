@@ -187,6 +187,9 @@ Variant HHVM_FUNCTION(openssl_verify, const String& data,
                                       const String& signature,
                                       const Variant& pub_key_id,
                      const Variant& signature_alg = OPENSSL_ALGO_SHA1);
+Variant HHVM_FUNCTION(openssl_verify_batch, const Array& data_sig_pairs,
+                                            const Variant& pub_key_id,
+                     const Variant& signature_alg = OPENSSL_ALGO_SHA1);
 bool HHVM_FUNCTION(openssl_x509_check_private_key, const Variant& cert,
                                                    const Variant& key);
 Variant HHVM_FUNCTION(openssl_x509_checkpurpose, const Variant& x509cert,
@@ -541,6 +541,23 @@ function openssl_verify(string $data,
                         mixed $pub_key_id,
                         mixed $signature_alg = OPENSSL_ALGO_SHA1): mixed;
 
+/* openssl_verify_batch() verifies many (data, signature) pairs against the
+ * same public key, doing the key coercion and algorithm lookup once for the
+ * whole batch. HHVM specific.
+ * @param array $data_sig_pairs - Array of two-element arrays, each holding
+ * the data and its signature.
+ * @param mixed $pub_key_id
+ * @param mixed $signature_alg - For more information see the list of
+ * Signature Algorithms.
+ * @return mixed - Array keyed like the input where each entry is 1 if the
+ * signature is correct, 0 if it is incorrect, and -1 on error; or FALSE if
+ * the key or algorithm is invalid.
+ */
+<<__Native, __HipHopSpecific>>
+function openssl_verify_batch(array $data_sig_pairs,
+                              mixed $pub_key_id,
+                              mixed $signature_alg = OPENSSL_ALGO_SHA1): mixed;
+
 /* Checks whether the given key is the private key that corresponds to cert.
  * @param mixed $cert - The certificate.
  * @param mixed $key - The private key.
@@ -0,0 +1,6 @@
+HHVM_DEFINE_EXTENSION("priorityqueue" REQUIRED
+  SOURCES
+    ext_priorityqueue.cpp
+  SYSTEMLIB
+    ext_priorityqueue.php
+)
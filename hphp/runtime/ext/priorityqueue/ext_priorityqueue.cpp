@@ -0,0 +1,158 @@
+/*
+   +----------------------------------------------------------------------+
+   | HipHop for PHP                                                       |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 2010-present Facebook, Inc. (http://www.facebook.com)  |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 3.01 of the PHP license,      |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.php.net/license/3_01.txt                                  |
+   | If you did not receive a copy of the PHP license and are unable to   |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@php.net so we can mail you a copy immediately.               |
+   +----------------------------------------------------------------------+
+*/
+
+#include "hphp/runtime/base/req-containers.h"
+#include "hphp/runtime/base/type-variant.h"
+#include "hphp/runtime/ext/extension.h"
+#include "hphp/runtime/vm/native-data.h"
+#include "hphp/system/systemlib.h"
+
+#include <utility>
+
+namespace HPHP {
+
+const StaticString s_PriorityQueueData("PriorityQueueData");
+
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+ * Backing store for HH\PriorityQueue: a binary max-heap over contiguous
+ * nodes with machine-integer priorities, so ordering never goes through a
+ * Variant comparison or a PHP-level compare() callback the way SplHeap
+ * does.  Equal priorities extract in insertion order via the `order'
+ * sequence number.
+ */
+struct PriorityQueueData final {
+  struct Node {
+    int64_t priority;
+    uint64_t order;
+    Variant value;
+  };
+
+  bool higher(const Node& a, const Node& b) const {
+    if (a.priority != b.priority) return a.priority > b.priority;
+    return a.order < b.order;
+  }
+
+  void siftUp(size_t i) {
+    while (i > 0) {
+      auto const parent = (i - 1) / 2;
+      if (!higher(m_heap[i], m_heap[parent])) break;
+      std::swap(m_heap[i], m_heap[parent]);
+      i = parent;
+    }
+  }
+
+  void siftDown(size_t i) {
+    auto const size = m_heap.size();
+    while (true) {
+      auto best = i;
+      auto const l = 2 * i + 1;
+      auto const r = l + 1;
+      if (l < size && higher(m_heap[l], m_heap[best])) best = l;
+      if (r < size && higher(m_heap[r], m_heap[best])) best = r;
+      if (best == i) break;
+      std::swap(m_heap[i], m_heap[best]);
+      i = best;
+    }
+  }
+
+  req::vector<Node> m_heap;
+  uint64_t m_nextOrder{0};
+};
+
+namespace {
+
+void HHVM_METHOD(PriorityQueue, insert, const Variant& value,
+                 int64_t priority) {
+  auto data = Native::data<PriorityQueueData>(this_);
+  data->m_heap.emplace_back(
+    PriorityQueueData::Node{priority, data->m_nextOrder++, value});
+  data->siftUp(data->m_heap.size() - 1);
+}
+
+Variant HHVM_METHOD(PriorityQueue, extract) {
+  auto data = Native::data<PriorityQueueData>(this_);
+  auto& heap = data->m_heap;
+  if (heap.empty()) {
+    SystemLib::throwInvalidOperationExceptionObject(
+      "Cannot extract from an empty PriorityQueue");
+  }
+  Variant ret = std::move(heap.front().value);
+  if (heap.size() > 1) {
+    heap.front() = std::move(heap.back());
+  }
+  heap.pop_back();
+  if (!heap.empty()) data->siftDown(0);
+  return ret;
+}
+
+Variant HHVM_METHOD(PriorityQueue, top) {
+  auto data = Native::data<PriorityQueueData>(this_);
+  if (data->m_heap.empty()) {
+    SystemLib::throwInvalidOperationExceptionObject(
+      "Cannot get the top of an empty PriorityQueue");
+  }
+  return data->m_heap.front().value;
+}
+
+int64_t HHVM_METHOD(PriorityQueue, topPriority) {
+  auto data = Native::data<PriorityQueueData>(this_);
+  if (data->m_heap.empty()) {
+    SystemLib::throwInvalidOperationExceptionObject(
+      "Cannot get the top of an empty PriorityQueue");
+  }
+  return data->m_heap.front().priority;
+}
+
+int64_t HHVM_METHOD(PriorityQueue, count) {
+  return Native::data<PriorityQueueData>(this_)->m_heap.size();
+}
+
+void HHVM_METHOD(PriorityQueue, clear) {
+  auto data = Native::data<PriorityQueueData>(this_);
+  data->m_heap.clear();
+  data->m_nextOrder = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Extension
+
+struct PriorityQueueExtension final : Extension {
+  PriorityQueueExtension() : Extension("priorityqueue") {}
+  void moduleInit() override {
+    HHVM_NAMED_ME(HH\\PriorityQueue, insert,
+                  HHVM_MN(PriorityQueue, insert));
+    HHVM_NAMED_ME(HH\\PriorityQueue, extract,
+                  HHVM_MN(PriorityQueue, extract));
+    HHVM_NAMED_ME(HH\\PriorityQueue, top,
+                  HHVM_MN(PriorityQueue, top));
+    HHVM_NAMED_ME(HH\\PriorityQueue, topPriority,
+                  HHVM_MN(PriorityQueue, topPriority));
+    HHVM_NAMED_ME(HH\\PriorityQueue, count,
+                  HHVM_MN(PriorityQueue, count));
+    HHVM_NAMED_ME(HH\\PriorityQueue, clear,
+                  HHVM_MN(PriorityQueue, clear));
+
+    Native::registerNativeDataInfo<PriorityQueueData>(
+      s_PriorityQueueData.get());
+
+    loadSystemlib("priorityqueue");
+  }
+} s_priorityqueue_extension;
+
+} // anonymous namespace
+} // namespace HPHP
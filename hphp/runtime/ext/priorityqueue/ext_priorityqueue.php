@@ -0,0 +1,59 @@
+<?hh
+
+namespace HH {
+
+/**
+ * A max-priority queue over (value, int priority) pairs, backed by a
+ * contiguous native heap with inlined integer comparisons. Unlike
+ * SplPriorityQueue, ordering never calls back into PHP, so insert and
+ * extract stay O(log n) machine-word comparisons. Entries with equal
+ * priority are extracted in insertion order.
+ */
+<<__NativeData("PriorityQueueData")>>
+final class PriorityQueue implements \Countable {
+
+  /**
+   * Insert a value with the given priority.
+   */
+  <<__Native>>
+  public function insert(mixed $value, int $priority): void;
+
+  /**
+   * Remove and return the value with the highest priority.
+   * Throws InvalidOperationException if the queue is empty.
+   */
+  <<__Native>>
+  public function extract(): mixed;
+
+  /**
+   * Return the value with the highest priority without removing it.
+   * Throws InvalidOperationException if the queue is empty.
+   */
+  <<__Native>>
+  public function top(): mixed;
+
+  /**
+   * Return the priority of the top entry.
+   * Throws InvalidOperationException if the queue is empty.
+   */
+  <<__Native>>
+  public function topPriority(): int;
+
+  /**
+   * Return the number of entries in the queue.
+   */
+  <<__Native>>
+  public function count(): int;
+
+  public function isEmpty(): bool {
+    return $this->count() === 0;
+  }
+
+  /**
+   * Remove all entries.
+   */
+  <<__Native>>
+  public function clear(): void;
+}
+
+} // namespace HH
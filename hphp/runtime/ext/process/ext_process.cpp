@@ -65,7 +65,7 @@ namespace HPHP {
 static char** build_envp(const Array& envs, req::vector<String> &senvs) {
   auto const size = envs.size();
   if (!size) return nullptr;
-  auto envp = req::make_raw_array<char*>(size + 1);
+  auto envp = req::make_raw_array_uninit<char*>(size + 1);
   size_t i = 0;
   for (ArrayIter iter(envs); iter; ++iter, ++i) {
     StringBuffer nvpair;
@@ -214,7 +214,7 @@ void HHVM_FUNCTION(pcntl_exec,
   // build argument list
   req::vector<String> sargs; // holding those char *
   auto const size = args.size();
-  auto argv = req::make_raw_array<char*>(size + 2);
+  auto argv = req::make_raw_array_uninit<char*>(size + 2);
   argv[0] = (char*)path.data();
   int i = 1;
   if (size) {
@@ -52,6 +52,7 @@ static struct ServerExtension final : Extension {
     HHVM_FE(xbox_task_start);
     HHVM_FE(xbox_task_status);
     HHVM_FE(xbox_task_result);
+    HHVM_FE(xbox_task_partial_result);
     HHVM_FE(xbox_process_call_message);
     HHVM_FE(xbox_get_thread_timeout);
     HHVM_FE(xbox_set_thread_timeout);
@@ -195,6 +196,19 @@ int64_t HHVM_FUNCTION(xbox_task_result,
   return XboxServer::TaskResult(task, timeout_ms, ret.getVariantOrNull());
 }
 
+String HHVM_FUNCTION(xbox_task_partial_result,
+                     const Resource& task,
+                     int64_t offset,
+                     VRefParam done,
+                     VRefParam code) {
+  bool rdone;
+  int rcode;
+  String response = XboxServer::TaskPartialResult(task, offset, rdone, rcode);
+  done.assignIfRef(rdone);
+  code.assignIfRef(rcode);
+  return response;
+}
+
 Variant HHVM_FUNCTION(xbox_process_call_message,
                       const String& msg) {
   Variant v =
@@ -65,6 +65,11 @@ int64_t HHVM_FUNCTION(xbox_task_result,
                       const Resource& task,
                       int64_t timeout_ms,
                       VRefParam ret);
+String HHVM_FUNCTION(xbox_task_partial_result,
+                     const Resource& task,
+                     int64_t offset,
+                     VRefParam done,
+                     VRefParam code);
 Variant HHVM_FUNCTION(xbox_process_call_message,
                       const String& msg);
 int64_t HHVM_FUNCTION(xbox_get_thread_timeout);
@@ -164,6 +164,27 @@ function xbox_task_status(resource $task): bool;
 <<__HipHopSpecific, __Native>>
 function xbox_task_result(resource $task, int $timeout_ms, mixed &$ret): int;
 
+/**
+ * Gets the raw response bytes an xbox task has produced so far, starting at
+ *   an offset, without blocking for completion. Pass the number of bytes
+ *   already consumed to receive only new data.
+ *
+ * @param resource $task - The xbox task object created by xbox_task_start().
+ * @param int $offset - How many leading response bytes to skip.
+ * @param mixed $done - Set to whether the task has finished.
+ * @param mixed $code - Set to the response code once the task has finished,
+ *   0 before then.
+ *
+ * @return string - The response bytes after $offset; the empty string when
+ *   no new data is available yet.
+ *
+ */
+<<__HipHopSpecific, __Native>>
+function xbox_task_partial_result(resource $task,
+                                  int $offset,
+                                  mixed &$done,
+                                  mixed &$code): string;
+
 /**
  * This function is invoked by the xbox facility to start an xbox call task.
  *   This function is not intended to be called directly by user code.
@@ -1430,39 +1430,17 @@ static Variant HHVM_METHOD(SimpleXMLElement, asXML,
   if (node) {
     xmlDocPtr doc = data->docp();
     if (node->parent && (XML_DOCUMENT_NODE == node->parent->type)) {
-      xmlChar* strval;
-      int strval_len;
-      xmlDocDumpMemoryEnc(doc, &strval, &strval_len,
-                          (const char*)doc->encoding);
-      if (!strval) {
+      String ret = libxml_dump_doc_to_string(doc, (const char*)doc->encoding);
+      if (ret.isNull()) {
         return false;
       }
-      String ret = String((char*)strval);
-      xmlFree(strval);
       return ret;
     } else {
-      /* Should we be passing encoding information instead of nullptr? */
-      outbuf = xmlAllocOutputBuffer(nullptr);
-
-      if (outbuf == nullptr) {
-        return false;
-      }
-
-      xmlNodeDumpOutput(outbuf, doc, node, 0, 0,
-                        (const char*)doc->encoding);
-      xmlOutputBufferFlush(outbuf);
-
-      char* str = nullptr;
-#ifdef LIBXML2_NEW_BUFFER
-      str = (char*)xmlOutputBufferGetContent(outbuf);
-#else
-      str = (char*)outbuf->buffer->content;
-#endif
-      if (!str) {
+      String ret = libxml_dump_node_to_string(doc, node,
+                                              (const char*)doc->encoding);
+      if (ret.isNull()) {
         return false;
       }
-      String ret = String(str);
-      xmlOutputBufferClose(outbuf);
       return ret;
     }
   } else {
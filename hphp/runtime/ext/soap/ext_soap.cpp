@@ -30,6 +30,7 @@
 #include "hphp/runtime/server/http-protocol.h"
 #include "hphp/runtime/ext/soap/soap.h"
 #include "hphp/runtime/ext/soap/packet.h"
+#include "hphp/runtime/ext/libxml/ext_libxml.h"
 #include "hphp/runtime/base/string-util.h"
 #include "hphp/runtime/ext/zlib/ext_zlib.h"
 #include "hphp/runtime/ext/std/ext_std_network.h"
@@ -499,19 +500,18 @@ static bool do_request(ObjectData* obj_client, xmlDoc *request,
                        const char *location, const char *action, int version,
                        bool one_way, Variant &response) {
   SoapClient *client = Native::data<SoapClient>(obj_client);
-  char *buf; int buf_size;
-  xmlDocDumpMemory(request, (xmlChar**)&buf, &buf_size);
-  if (!buf) {
+  String request_str = libxml_dump_doc_to_string(request);
+  if (request_str.isNull()) {
     client->m_soap_fault =
       create_soap_fault("HTTP", "Error build soap request");
     return false;
   }
 
   if (client->m_trace) {
-    client->m_last_request = String((char*)buf, buf_size, CopyString);
+    client->m_last_request = request_str;
   }
   response = obj_client->o_invoke_few_args(s___dorequest, 5,
-                                           String(buf, buf_size, CopyString),
+                                           request_str,
                                            String(location, CopyString),
                                            String(action, CopyString),
                                            version, one_way);
@@ -1839,11 +1839,9 @@ static void send_soap_server_fault(
 
   HHVM_FN(ob_end_clean)(); // dump all buffered output
 
-  xmlChar *buf; int size;
-  xmlDocDumpMemory(doc_return, &buf, &size);
-  if (buf) {
-    g_context->write(String((const char *)buf, size, CopyString));
-    xmlFree(buf);
+  String response_str = libxml_dump_doc_to_string(doc_return);
+  if (!response_str.isNull()) {
+    g_context->write(response_str);
   }
   xmlFreeDoc(doc_return);
 }
@@ -2336,18 +2334,13 @@ void HHVM_METHOD(SoapServer, handle,
   }
 
   // 9. XML response
-  xmlChar *buf; int size;
-  xmlDocDumpMemory(doc_return, &buf, &size);
+  String response_str = libxml_dump_doc_to_string(doc_return);
   xmlFreeDoc(doc_return);
-  if (buf == nullptr || size == 0) {
-    if (buf) xmlFree(buf);
+  if (response_str.isNull() || response_str.empty()) {
     throw SoapException("Dump memory failed");
   }
   output_xml_header(soap_version);
-  if (buf) {
-    g_context->write(String((char*)buf, size, CopyString));
-    xmlFree(buf);
-  }
+  g_context->write(response_str);
 }
 
 void HHVM_METHOD(SoapServer, setpersistence,
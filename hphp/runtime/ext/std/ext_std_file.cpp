@@ -193,7 +193,15 @@ static int accessSyscall(
         return -1;
       }
     }
-    return ::access(File::TranslatePathWithFileCache(path).data(), mode);
+    auto const translated = File::TranslatePathWithFileCache(path);
+    // Existence probes can be answered from the stat cache; permission
+    // checks still go to the kernel.
+    if (mode == F_OK && RuntimeOption::ServerStatCache &&
+        RuntimeOption::ServerStatCacheForStreams) {
+      struct stat s;
+      return StatCache::stat(translated.toCppString(), &s);
+    }
+    return ::access(translated.data(), mode);
   }
   return w->access(uri_or_path, mode);
 }
@@ -233,7 +241,12 @@ static int statSyscall(
 
   auto properPath = w->isNormalFileStream() ? path.substr(pathIndex) : path;
   if (canUseFileCache) {
-    return ::stat(File::TranslatePathWithFileCache(properPath).data(), buf);
+    auto const translated = File::TranslatePathWithFileCache(properPath);
+    if (RuntimeOption::ServerStatCache &&
+        RuntimeOption::ServerStatCacheForStreams) {
+      return StatCache::stat(translated.toCppString(), buf);
+    }
+    return ::stat(translated.data(), buf);
   }
   return w->stat(properPath, buf);
 }
@@ -2050,6 +2063,25 @@ Variant HHVM_FUNCTION(readdir,
   return dir->read();
 }
 
+Variant HHVM_FUNCTION(readdir_bulk,
+                      const Variant& dir_handle /* = null */,
+                      int64_t limit /* = -1 */) {
+  const Resource& res_dir_handle = dir_handle.isNull()
+                                 ? null_resource
+                                 : dir_handle.toResource();
+  auto dir = get_dir(res_dir_handle);
+  if (!dir) {
+    return false;
+  }
+  std::vector<String> names;
+  dir->readMany(limit, names);
+  Array ret = Array::Create();
+  for (auto& name : names) {
+    ret.append(name);
+  }
+  return ret;
+}
+
 void HHVM_FUNCTION(rewinddir,
                    const Variant& dir_handle /* = null */) {
   const Resource& res_dir_handle = dir_handle.isNull()
@@ -2079,13 +2111,7 @@ HHVM_FUNCTION(scandir, const String& directory, bool descending /* = false */,
   }
 
   std::vector<String> names;
-  while (true) {
-    auto name = dir->read();
-    if (same(name, false)) {
-      break;
-    }
-    names.push_back(name.toString());
-  }
+  dir->readMany(-1, names);
   dir->close();
 
   if (descending) {
@@ -2261,6 +2287,7 @@ void StandardExtension::initFile() {
   HHVM_FE(opendir);
   HHVM_FE(readdir);
   HHVM_FE(rewinddir);
+  HHVM_FE(readdir_bulk);
   HHVM_FE(scandir);
   HHVM_FE(closedir);
 
@@ -332,6 +332,9 @@ Variant HHVM_FUNCTION(dir,
 Variant HHVM_FUNCTION(opendir,
                       const String& path,
                       const Variant& context = uninit_null());
+Variant HHVM_FUNCTION(readdir_bulk,
+                      const Variant& dir_handle = uninit_variant,
+                      int64_t limit = -1);
 Variant HHVM_FUNCTION(readdir,
                       const Variant& dir_handle = uninit_variant);
 void HHVM_FUNCTION(rewinddir,
@@ -1430,6 +1430,25 @@ function opendir(string $path, mixed $context = null): mixed;
 <<__Native>>
 function readdir(?resource $dir_handle = null): mixed;
 
+/**
+ * Reads many directory entries at once. HHVM specific: drains up to limit
+ *   entries (or the whole directory when limit is negative) from a handle
+ *   opened with opendir() in one native call, avoiding the per-entry
+ *   overhead of looping readdir() for very large directories.
+ *
+ * @param resource $dir_handle - The directory handle resource previously
+ *   opened with opendir(). If the directory handle is not specified, the last
+ *   link opened by opendir() is assumed.
+ * @param int $limit - Maximum number of entries to read; negative reads all
+ *   remaining entries.
+ *
+ * @return mixed - Returns an array of entry names in directory order (an
+ *   empty array once the directory is exhausted), or FALSE on failure.
+ *
+ */
+<<__Native>>
+function readdir_bulk(?resource $dir_handle = null, int $limit = -1): mixed;
+
 /**
  * Resets the directory stream indicated by dir_handle to the beginning of the
  *   directory.
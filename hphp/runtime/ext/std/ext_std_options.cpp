@@ -1074,6 +1074,14 @@ static void HHVM_FUNCTION(set_time_limit, int64_t seconds) {
   }
 }
 
+static int64_t HHVM_FUNCTION(hphp_get_remaining_time) {
+  return ThreadInfo::s_threadInfo->m_reqInjectionData.getRemainingTime();
+}
+
+static int64_t HHVM_FUNCTION(hphp_get_remaining_cpu_time) {
+  return ThreadInfo::s_threadInfo->m_reqInjectionData.getRemainingCPUTime();
+}
+
 String HHVM_FUNCTION(sys_get_temp_dir) {
 #ifdef WIN32
   char buf[PATH_MAX];
@@ -1339,6 +1347,8 @@ void StandardExtension::initOptions() {
   HHVM_FE(phpversion);
   HHVM_FE(putenv);
   HHVM_FE(set_time_limit);
+  HHVM_FE(hphp_get_remaining_time);
+  HHVM_FE(hphp_get_remaining_cpu_time);
   HHVM_FE(sys_get_temp_dir);
   HHVM_FE(zend_version);
   HHVM_FE(version_compare);
@@ -390,6 +390,20 @@ function magic_quotes_runtime(mixed $new_setting): bool {
 <<__Native>>
 function set_time_limit(int $seconds): void;
 
+/* Returns the number of wall-clock seconds remaining before the request hits
+ * its time limit, or 0 if no limit is set.
+ */
+<<__HipHopSpecific, __Native>>
+function hphp_get_remaining_time(): int;
+
+/* Returns the number of CPU seconds remaining in the request's CPU budget, or
+ * 0 if no CPU budget is set.  The CPU clock does not advance while the
+ * request is blocked in IO or async waits, so this reflects actual CPU burn
+ * rather than elapsed time.
+ */
+<<__HipHopSpecific, __Native>>
+function hphp_get_remaining_cpu_time(): int;
+
 /* Returns the path of the directory PHP stores temporary files in by default.
  */
 <<__Native>>
@@ -50,6 +50,10 @@
 #include <folly/Unicode.h>
 #include <locale.h>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 namespace HPHP {
 
 static Mutex s_mutex;
@@ -421,14 +425,58 @@ String HHVM_FUNCTION(strrev,
   return ret;
 }
 
+/*
+ * Case-conversion kernel: while the input stays ASCII, convert sixteen
+ * bytes at a time; from the first non-ASCII byte on, defer to the
+ * locale-aware ctype routine for the rest of the string.
+ */
+template <bool ToLower, class Op> ALWAYS_INLINE
+String stringCaseConvert(const String& str, Op op) {
+  auto const len = str.size();
+  if (len == 0) return str;
+
+  String ret(len, ReserveString);
+  auto const slice = str.slice();
+  auto src = slice.begin();
+  auto const end = slice.end();
+  char* dst = ret.mutableData();
+
+#ifdef __SSE2__
+  auto const lo = _mm_set1_epi8((ToLower ? 'A' : 'a') - 1);
+  auto const hi = _mm_set1_epi8((ToLower ? 'Z' : 'z') + 1);
+  auto const delta = _mm_set1_epi8(0x20);
+  while (src + 16 <= end) {
+    auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+    // High bit set anywhere means non-ASCII: let the scalar loop and the
+    // locale sort it out.
+    if (_mm_movemask_epi8(v) != 0) break;
+    // All bytes are 0..127 here, so signed compares give the letter range.
+    auto const letters = _mm_and_si128(_mm_cmpgt_epi8(v, lo),
+                                       _mm_cmpgt_epi8(hi, v));
+    auto const adj = _mm_and_si128(letters, delta);
+    v = ToLower ? _mm_add_epi8(v, adj) : _mm_sub_epi8(v, adj);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), v);
+    src += 16;
+    dst += 16;
+  }
+#endif
+
+  for (; src != end; ++src, ++dst) {
+    *dst = op(*src);
+  }
+
+  ret.setSize(len);
+  return ret;
+}
+
 String HHVM_FUNCTION(strtolower,
                      const String& str) {
-  return stringForEachFast(str, tolower);
+  return stringCaseConvert<true>(str, tolower);
 }
 
 String HHVM_FUNCTION(strtoupper,
                      const String& str) {
-  return stringForEachFast(str, toupper);
+  return stringCaseConvert<false>(str, toupper);
 }
 
 template <class OpTo, class OpIs> ALWAYS_INLINE
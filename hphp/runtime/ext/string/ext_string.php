@@ -1178,7 +1178,7 @@ function money_format(string $format, float $number): mixed;
  * @return string - A formatted version of number.
  *
  */
-<<__Native>>
+<<__IsFoldable, __Native>>
 function number_format(float $number,
                        int $decimals = 0,
                        mixed $dec_point = ".",
@@ -1123,6 +1123,13 @@ struct CompactReader {
       uint64_t result = 0;
       uint8_t shift = 0;
 
+      // Common case: the whole varint is sitting in the transport's read
+      // buffer and can be decoded in one pass.
+      if (LIKELY(transport.tryReadVarintFast(&result))) {
+        return result;
+      }
+      result = 0;
+
       while (true) {
         uint8_t byte = readUByte();
         result |= (uint64_t)(byte & 0x7f) << shift;
@@ -244,6 +244,29 @@ struct PHPInputTransport {
     return c;
   }
 
+  // Decode a varint straight out of the read buffer, avoiding the
+  // per-byte readBytes() copy/branch chain. Returns false without
+  // consuming anything if the varint does not terminate within the
+  // buffered bytes (buffer boundary, or malformed input of 10+
+  // continuation bytes); the caller's byte-at-a-time path handles
+  // refills and error reporting.
+  bool tryReadVarintFast(uint64_t* out) {
+    auto p = reinterpret_cast<const uint8_t*>(buffer_ptr);
+    size_t avail = buffer_used < 10 ? buffer_used : 10;
+    uint64_t result = 0;
+    for (size_t i = 0; i < avail; i++) {
+      uint64_t byte = p[i];
+      result |= (byte & 0x7f) << (7 * i);
+      if (!(byte & 0x80)) {
+        buffer_ptr += i + 1;
+        buffer_used -= i + 1;
+        *out = result;
+        return true;
+      }
+    }
+    return false;
+  }
+
   int16_t readI16() {
     int16_t c;
     readBytes(&c, 2);
@@ -113,6 +113,9 @@ void Debugger::setClientConnected(
     // to grab a lock on the request init path in the case where this extension
     // is enabled, but not in use by any client.
     m_clientConnected.store(connected, std::memory_order_release);
+    if (connected) {
+      m_everClientConnected.store(true, std::memory_order_release);
+    }
 
     VSDebugLogger::Log(
       VSDebugLogger::LogLevelInfo,
@@ -565,12 +568,21 @@ void Debugger::sendThreadEventMessage(
 }
 
 void Debugger::requestInit() {
-  Lock lock(m_lock);
-
   m_totalRequestCount++;
 
+  // Don't pay for the global lock (or for attaching to the thread) if no
+  // debugger client is connected. This is the common case on hosts that
+  // keep the extension enabled just in case; requests started while a
+  // client is in the middle of connecting are picked up by the
+  // ExecutePerThread pass in setClientConnected.
   if (!clientConnected()) {
-    // Don't pay for attaching to the thread if no debugger client is connected.
+    return;
+  }
+
+  Lock lock(m_lock);
+
+  if (!clientConnected()) {
+    // Raced with the client disconnecting.
     return;
   }
 
@@ -848,6 +860,12 @@ RequestInfo* Debugger::attachToRequest(ThreadInfo* ti) {
 }
 
 void Debugger::requestShutdown() {
+  // If no client has ever connected to this process, this request cannot
+  // have been attached to and there is nothing to clean up.
+  if (!m_everClientConnected.load(std::memory_order_acquire)) {
+    return;
+  }
+
   auto const threadInfo = &TI();
   RequestInfo* requestInfo = nullptr;
   request_id_t threadId = -1;
@@ -637,6 +637,12 @@ private:
   // actually in used due to no connected debugger clients.
   std::atomic<bool> m_clientConnected {false};
 
+  // Set the first time a client ever connects to this process and never
+  // cleared. Until this is set, no request can have been attached to, so
+  // per-request paths have nothing to clean up and can skip the global
+  // lock entirely.
+  std::atomic<bool> m_everClientConnected {false};
+
   // This flag indicates if there is a connected debugger client, and the
   // client is fully initialized. If true, it is okay to send the client
   // thread events.
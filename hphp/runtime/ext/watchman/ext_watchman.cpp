@@ -45,6 +45,7 @@
 #include "hphp/runtime/base/builtin-functions.h"
 #include "hphp/runtime/base/execution-context.h"
 #include "hphp/runtime/base/program-functions.h"
+#include "hphp/runtime/base/runtime-option.h"
 #include "hphp/runtime/base/tv-refcount.h"
 #include "hphp/runtime/base/unit-cache.h"
 #include "hphp/runtime/ext/asio/asio-external-thread-event.h"
@@ -780,10 +781,21 @@ Object HHVM_FUNCTION(HH_watchman_unsubscribe, const String& _name) {
   }
 }
 
+// (PHP entry-point) Retire the cached unit for a changed file. Meant to be
+// called from a subscription callback with the paths Watchman reported, in
+// concert with Eval.UnitCacheWatchmanInvalidation which disables stat-based
+// revalidation of cached units.
+bool HHVM_FUNCTION(HH_watchman_invalidate_unit, const String& path) {
+  if (RuntimeOption::RepoAuthoritative) {
+    return false;
+  }
+  return invalidateUnit(path.get());
+}
+
 struct WatchmanExtension final : Extension {
   // See ext_watchman.php for details of version bumps.
   // (INIT entry-point) no need for a lock
-  WatchmanExtension() : Extension("watchman", "1") { };
+  WatchmanExtension() : Extension("watchman", "2") { };
 
   // (INIT entry-point) no need for a lock
   void moduleInit() override {
@@ -793,6 +805,7 @@ struct WatchmanExtension final : Extension {
       HHVM_FALIAS(HH\\watchman_check_sub, HH_watchman_check_sub);
       HHVM_FALIAS(HH\\watchman_sync_sub, HH_watchman_sync_sub);
       HHVM_FALIAS(HH\\watchman_unsubscribe, HH_watchman_unsubscribe);
+      HHVM_FALIAS(HH\\watchman_invalidate_unit, HH_watchman_invalidate_unit);
 
       loadSystemlib();
     }
@@ -116,9 +116,20 @@ function watchman_sync_sub(
 <<__Native>>
 function watchman_unsubscribe(string $sub_name): Awaitable<string>;
 
+/* Retire the cached unit for the given source file so the next request that
+ * includes it reloads it from disk. Intended to be called from a
+ * subscription callback with the files Watchman reported changed, paired
+ * with the Eval.UnitCacheWatchmanInvalidation runtime option which stops
+ * the unit cache from re-stat()ing files on every lookup. Returns true if a
+ * cached unit was retired. Always returns false in repo-authoritative mode.
+ */
+<<__Native>>
+function watchman_invalidate_unit(string $path): bool;
+
 /**
  * This should be bumped with every non-backwards compatible API change.
  * 1 => first version
+ * 2 => added watchman_invalidate_unit()
  */
 function ext_watchman_version(): int {
   return (int)\phpversion("watchman");
@@ -247,11 +247,65 @@ void Xenon::onTimer() {
 // passed to ExecutePerThread.
 void Xenon::surpriseAll() {
   TRACE(1, "Xenon::surpriseAll\n");
+  refillSampleTokens();
   ThreadInfo::ExecutePerThread(
     [] (ThreadInfo* t) { t->m_reqInjectionData.setFlag(XenonSignalFlag); }
   );
 }
 
+// Called once per timer period, before threads are surprised.
+void Xenon::refillSampleTokens() {
+  auto const budget = RuntimeOption::XenonSampleBudgetPerSecond;
+  if (budget == 0) return;
+  auto const refill = std::max<int64_t>(
+    1, (int64_t)(budget * RuntimeOption::XenonPeriodSeconds));
+  auto const cap = refill * 2;  // allow a modest burst
+  auto cur = m_sampleTokens.load(std::memory_order_relaxed);
+  int64_t next;
+  do {
+    next = std::min<int64_t>(cur + refill, cap);
+  } while (!m_sampleTokens.compare_exchange_weak(cur, next,
+                                                 std::memory_order_relaxed));
+  // Comfortably within budget again: recover selection probability.
+  if (next == cap) {
+    auto shift = m_freqShift.load(std::memory_order_relaxed);
+    if (shift > 0) {
+      m_freqShift.compare_exchange_strong(shift, shift - 1,
+                                          std::memory_order_relaxed);
+    }
+  }
+}
+
+bool Xenon::tryConsumeSampleToken() {
+  if (RuntimeOption::XenonSampleBudgetPerSecond == 0 ||
+      RuntimeOption::XenonForceAlwaysOn) {
+    return true;
+  }
+  auto cur = m_sampleTokens.load(std::memory_order_relaxed);
+  while (cur > 0) {
+    if (m_sampleTokens.compare_exchange_weak(cur, cur - 1,
+                                             std::memory_order_relaxed)) {
+      return true;
+    }
+  }
+  // Over budget: drop this sample and back off future request selection.
+  auto shift = m_freqShift.load(std::memory_order_relaxed);
+  if (shift < kMaxFreqShift) {
+    m_freqShift.compare_exchange_strong(shift, shift + 1,
+                                        std::memory_order_relaxed);
+  }
+  incrementMissedSampleCount(1);
+  return false;
+}
+
+uint32_t Xenon::effectiveRequestFreq() const {
+  auto const freq = RuntimeOption::XenonRequestFreq;
+  if (RuntimeOption::XenonSampleBudgetPerSecond == 0 || freq == 0) {
+    return freq;
+  }
+  return freq << m_freqShift.load(std::memory_order_relaxed);
+}
+
 bool Xenon::getIsProfiledRequest() {
   return s_xenonData->getIsProfiledRequest();
 }
@@ -287,6 +341,7 @@ Array XenonRequestLocalData::createResponse() {
 void XenonRequestLocalData::log(Xenon::SampleType t,
                                 c_WaitableWaitHandle* wh) {
   if (!m_isProfiledRequest) return;
+  if (!Xenon::getInstance().tryConsumeSampleToken()) return;
 
   TRACE(1, "XenonRequestLocalData::log\n");
   time_t now = time(nullptr);
@@ -316,7 +371,7 @@ void XenonRequestLocalData::requestInit() {
     clearSurpriseFlag(XenonSignalFlag);
   }
 
-  uint32_t freq = RuntimeOption::XenonRequestFreq;
+  uint32_t freq = Xenon::getInstance().effectiveRequestFreq();
   m_isProfiledRequest = (freq > 0 && folly::Random::rand32(freq) == 0);
 }
 
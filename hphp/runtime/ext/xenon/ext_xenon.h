@@ -129,9 +129,24 @@ struct Xenon final {
   void onTimer();
   bool getIsProfiledRequest();
 
+  // Adaptive sampling (Xenon.SampleBudgetPerSecond > 0): a token bucket
+  // refilled every timer period caps the process-wide sample rate, and the
+  // per-request selection probability backs off multiplicatively while the
+  // bucket runs dry, recovering once it refills to the burst cap. Expensive
+  // requests drain more tokens, so they bias selection downward without any
+  // per-request bookkeeping. No effect in always-on mode (no timer ticks).
+  bool tryConsumeSampleToken();
+  uint32_t effectiveRequestFreq() const;
+
+  static constexpr uint32_t kMaxFreqShift = 10;
+
   bool      m_stopping;
  private:
+  void refillSampleTokens();
+
   std::atomic<int64_t> m_missedSampleCount;
+  std::atomic<int64_t> m_sampleTokens{0};
+  std::atomic<uint32_t> m_freqShift{0};
   sem_t     m_timerTriggered;
 #if !defined(__APPLE__) && !defined(_MSC_VER)
   pthread_t m_triggerThread;
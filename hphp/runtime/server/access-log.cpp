@@ -192,6 +192,86 @@ FILE* LogWriter::getOutputFile() const {
   return outfile;
 }
 
+LogWriter::~LogWriter() {
+  stopFlushThread();
+}
+
+void LogWriter::flush() {
+  if (!async()) return;
+  std::vector<std::string> batch;
+  {
+    std::lock_guard<std::mutex> guard(m_queueLock);
+    batch.swap(m_queue);
+  }
+  writeBatch(batch);
+}
+
+void LogWriter::outputLine(std::string&& line) {
+  if (async()) {
+    {
+      std::lock_guard<std::mutex> guard(m_queueLock);
+      m_queue.emplace_back(std::move(line));
+    }
+    m_queueCV.notify_one();
+    return;
+  }
+  auto out = getOutputFile();
+  if (!out) return;
+  int nbytes = fwrite(line.data(), 1, line.size(), out);
+  fflush(out);
+  if (!m_isPipeOutput) {
+    recordWriteAndMaybeDropCaches(out, nbytes);
+  }
+}
+
+void LogWriter::startFlushThread() {
+  if (!RuntimeOption::AsyncAccessLog) return;
+  // The THREADLOCAL channel resolves its output file per request thread
+  // and cannot be drained from another thread.
+  if (m_channel == LogChannel::THREADLOCAL) return;
+  m_flushThread = std::thread([this] { flushLoop(); });
+}
+
+void LogWriter::stopFlushThread() {
+  if (!m_flushThread.joinable()) return;
+  {
+    std::lock_guard<std::mutex> guard(m_queueLock);
+    m_stopFlusher = true;
+  }
+  m_queueCV.notify_one();
+  m_flushThread.join();
+}
+
+void LogWriter::flushLoop() {
+  std::vector<std::string> batch;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(m_queueLock);
+      m_queueCV.wait(lock, [this] {
+        return m_stopFlusher || !m_queue.empty();
+      });
+      if (m_queue.empty() && m_stopFlusher) return;
+      batch.swap(m_queue);
+    }
+    writeBatch(batch);
+    batch.clear();
+  }
+}
+
+void LogWriter::writeBatch(const std::vector<std::string>& batch) {
+  if (batch.empty()) return;
+  auto out = getOutputFile();
+  if (!out) return;
+  size_t nbytes = 0;
+  for (auto const& line : batch) {
+    nbytes += fwrite(line.data(), 1, line.size(), out);
+  }
+  fflush(out);
+  if (!m_isPipeOutput) {
+    recordWriteAndMaybeDropCaches(out, nbytes);
+  }
+}
+
 void LogWriter::recordWriteAndMaybeDropCaches(FILE* out, int bytes) {
   switch (m_channel) {
     case LogChannel::THREADLOCAL:
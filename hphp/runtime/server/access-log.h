@@ -25,6 +25,11 @@
 #include "hphp/util/cronolog.h"
 #include "hphp/util/log-file-flusher.h"
 
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 
 namespace HPHP {
 ///////////////////////////////////////////////////////////////////////////////
@@ -91,20 +96,48 @@ struct LogWriter {
   explicit LogWriter(LogChannel chan)
     : m_channel(chan)
   {}
-  virtual ~LogWriter() {};
+  virtual ~LogWriter();
   virtual void init(const std::string& username,
                     AccessLog::GetThreadDataFunc fn) = 0;
   virtual void write(Transport* transport, const VirtualHost* vhost) = 0;
-  virtual void flush() {}
+  virtual void flush();
 protected:
   const LogChannel m_channel;
   FILE* m_filelog{nullptr};
   std::unique_ptr<Cronolog> m_cronolog;
   AccessLog::GetThreadDataFunc m_threadDataFn{nullptr};
   LogFileFlusher m_flusher;
+  bool m_isPipeOutput{false};
 protected:
   FILE* getOutputFile() const;
   void recordWriteAndMaybeDropCaches(FILE* out, int bytes);
+
+  // Whether this writer queues lines for its flush thread.
+  bool async() const { return m_flushThread.joinable(); }
+
+  // Hand off a fully formatted line for output. When Log.AsyncAccessLog is
+  // set and the writer has a process-wide output channel, the line is
+  // queued for the flush thread, which writes batches off the request
+  // thread; otherwise it is written inline.
+  void outputLine(std::string&& line);
+
+  // Start the flush thread when asynchronous logging applies to this
+  // writer; concrete writers call this at the end of init().
+  void startFlushThread();
+
+  // Drain the queue and join the flush thread. Concrete writers must call
+  // this before closing their output files.
+  void stopFlushThread();
+
+private:
+  void writeBatch(const std::vector<std::string>& batch);
+  void flushLoop();
+
+  std::thread m_flushThread;
+  std::mutex m_queueLock;
+  std::condition_variable m_queueCV;
+  std::vector<std::string> m_queue;
+  bool m_stopFlusher{false};
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -16,8 +16,10 @@
 
 #include "hphp/runtime/server/admin-request-handler.h"
 
+#include "hphp/runtime/base/alloc-site-profiler.h"
 #include "hphp/runtime/base/apc-file-storage.h"
 #include "hphp/runtime/base/apc-stats.h"
+#include "hphp/runtime/base/array-init.h"
 #include "hphp/runtime/base/datetime.h"
 #include "hphp/runtime/base/hhprof.h"
 #include "hphp/runtime/base/http-client.h"
@@ -27,9 +29,11 @@
 #include "hphp/runtime/base/preg.h"
 #include "hphp/runtime/base/program-functions.h"
 #include "hphp/runtime/base/rds.h"
+#include "hphp/runtime/base/request-event-handler.h"
 #include "hphp/runtime/base/runtime-option.h"
 #include "hphp/runtime/base/timestamp.h"
 #include "hphp/runtime/base/unit-cache.h"
+#include "hphp/runtime/base/variable-serializer.h"
 
 #include "hphp/runtime/vm/debug/debug.h"
 #include "hphp/runtime/vm/jit/cg-meta.h"
@@ -42,10 +46,12 @@
 #include "hphp/runtime/vm/jit/tc.h"
 #include "hphp/runtime/vm/named-entity.h"
 #include "hphp/runtime/vm/repo.h"
+#include "hphp/runtime/vm/ringbuffer-print.h"
 #include "hphp/runtime/vm/treadmill.h"
 #include "hphp/runtime/vm/type-profile.h"
 
 #include "hphp/runtime/ext/apc/ext_apc.h"
+#include "hphp/runtime/ext/hotprofiler/ext_hotprofiler.h"
 #include "hphp/runtime/ext/json/ext_json.h"
 #include "hphp/runtime/ext/xenon/ext_xenon.h"
 
@@ -74,13 +80,16 @@
 #endif
 
 #include <folly/Conv.h>
+#include <folly/FileUtil.h>
 #include <folly/Random.h>
+#include <folly/portability/Fcntl.h>
 #include <folly/portability/Unistd.h>
 
 #include <cstdio>
 #include <fstream>
 #include <string>
 #include <sstream>
+#include <thread>
 #include <iomanip>
 
 #if defined(FACEBOOK) || defined(HAVE_LIBSODIUM)
@@ -218,6 +227,96 @@ InitFiniNode s_traceRequestStart([]() {
 } // namespace
 #endif // HPHP_TRACE
 
+namespace {
+/*
+ * Task to profile a total of 'count' requests whose URL contain 'url' with
+ * the hierarchical hotprofiler (with per-frame memory tracking), writing one
+ * self-contained JSON trace file per request under 'dir'.
+ *
+ * Modeled on TraceTask above: armed from the admin port, grabbed by the
+ * first request thread whose URL matches, and handed back until the count
+ * is used up.  Unprofiled requests pay a single atomic load at request
+ * start; the profiler itself rides the normal EventHook path.
+ */
+struct ProfileTask {
+  const std::string url;
+  const std::string dir;
+  int64_t count;
+};
+std::atomic<ProfileTask*> s_profileTask{nullptr}; // Task up for grabs.
+
+const StaticString
+  s_prof_url("url"),
+  s_prof_time("time"),
+  s_prof_profile("profile");
+
+/*
+ * Serializes the profile at request shutdown and writes it out on a
+ * detached thread, off the request's critical path.  Shuts down at a lower
+ * priority than ProfilerFactory (0), i.e. earlier, while the profiler and
+ * the request heap are still alive.
+ */
+struct ProfileTaskCollector final : RequestEventHandler {
+  void requestInit() override { active = false; }
+  void requestShutdown() override {
+    if (!active) return;
+    active = false;
+    auto const stats = s_profiler_factory->stop();
+    if (stats.isNull()) return;
+    auto const trace = make_map_array(
+      s_prof_url, String(g_context->getRequestUrl()),
+      s_prof_time, (int64_t)time(nullptr),
+      s_prof_profile, stats
+    );
+    VariableSerializer vs(VariableSerializer::Type::JSON);
+    String json = vs.serializeValue(VarNR(trace), false);
+    std::string data(json.data(), json.size());
+    static std::atomic<uint64_t> s_seq{0};
+    auto path = folly::sformat("{}/hotprofile.{}.{}.json",
+                               dir.empty() ? "/tmp" : dir,
+                               (int64_t)getpid(),
+                               s_seq.fetch_add(1, std::memory_order_relaxed));
+    std::thread([path = std::move(path), data = std::move(data)] {
+      auto fd = ::open(path.c_str(), O_CREAT | O_WRONLY | O_TRUNC, 0644);
+      if (fd < 0) {
+        Logger::Error("profile-request: cannot write %s", path.c_str());
+        return;
+      }
+      folly::writeFull(fd, data.data(), data.size());
+      ::close(fd);
+      Logger::Info("profile-request: wrote %s", path.c_str());
+    }).detach();
+  }
+  int priority() const override { return -10; }
+  bool active{false};
+  std::string dir;
+};
+IMPLEMENT_STATIC_REQUEST_LOCAL(ProfileTaskCollector, s_profile_collector);
+
+InitFiniNode s_profileRequestStart([]() {
+  if (!s_profileTask.load(std::memory_order_acquire)) return;
+  auto const task = s_profileTask.exchange(nullptr, std::memory_order_acq_rel);
+  if (!task) return; // We lost the race; nothing to do.
+  const std::string url = g_context->getRequestUrl();
+  if (url.find(task->url) == std::string::npos) {
+    // URL mismatch; hand task back (and discard any unlikely colliding task).
+    delete s_profileTask.exchange(task, std::memory_order_acq_rel);
+    return;
+  }
+  if (s_profiler_factory->start(ProfilerKind::Hierarchical,
+                                NoTrackBuiltins | TrackMemory)) {
+    s_profile_collector->active = true;
+    s_profile_collector->dir = task->dir;
+  }
+  if (--task->count > 0) {
+    delete s_profileTask.exchange(task, std::memory_order_acq_rel);
+  } else {
+    delete task;
+  }
+}, InitFiniNode::When::RequestStart, "profile-request");
+
+} // namespace
+
 void AdminRequestHandler::logToAccessLog(Transport* transport) {
   GetAccessLog().onNewRequest();
   GetAccessLog().log(transport, nullptr);
@@ -276,6 +375,8 @@ void AdminRequestHandler::handleRequest(Transport *transport) {
         "/check-queued:    how many http requests are queued waiting to be\n"
         "                  handled\n"
         "/check-health:    return json containing basic load/usage stats\n"
+        "/check-ready:     200 once JIT maturity passes the configured\n"
+        "                  threshold, 503 while still warming up\n"
         "/check-ev:        how many http requests are active by libevent\n"
         "/check-pl-load:   how many pagelet threads are actively handling\n"
         "                  requests\n"
@@ -284,6 +385,8 @@ void AdminRequestHandler::handleRequest(Transport *transport) {
         "/check-sql:       report SQL table statistics\n"
         "/check-sat        how many satellite threads are actively handling\n"
         "                  requests and queued waiting to be handled\n"
+        "/perf-snapshot:   one JSON document sampling load, TC, RDS,\n"
+        "                  memory, APC and service-data counters\n"
         "/status.xml:      show server status in XML\n"
         "/status.json:     show server status in JSON\n"
         "/status.html:     show server status in HTML\n"
@@ -329,8 +432,13 @@ void AdminRequestHandler::handleRequest(Transport *transport) {
         "    prefix        required, the prefix to dump\n"
         "    count         optional, the number of keys to dump, default 1\n"
         "/dump-apc-info:   show basic APC stats\n"
+        "/dump-apc-key-stats: show per-key-prefix APC stats; requires\n"
+        "                  Server.APC.KeyStats.PrefixLen to be set\n"
         "/dump-apc-meta:   dump meta information for all objects in APC to\n"
         "                  /tmp/apc_dump_meta\n"
+        "/dump-apc-snapshot: write the current APC keyspace to\n"
+        "                  /tmp/apc_snapshot, loadable on the next startup\n"
+        "                  via Server.APC.PrimeLibrary\n"
         "/advise-out-apc:  forcibly madvise out APC prime data\n"
         "/random-apc:      dump the key and size of a random APC entry\n"
         "    count         number of entries to return\n"
@@ -352,6 +460,11 @@ void AdminRequestHandler::handleRequest(Transport *transport) {
         "    count         optional, total requests to trace (default: 1)\n"
         "    url           optional, trace only if URL contains \'url\'\n"
 #endif
+        "/profile-request: profile next request(s) with the hotprofiler,\n"
+        "                  writing one JSON trace file per request\n"
+        "    count         optional, total requests to profile (default: 1)\n"
+        "    url           optional, profile only if URL contains \'url\'\n"
+        "    dir           optional, output directory (default: /tmp)\n"
 #ifdef GOOGLE_CPU_PROFILER
         "/prof-cpu-on:     turn on CPU profiler\n"
         "/prof-cpu-off:    turn off CPU profiler\n"
@@ -359,11 +472,24 @@ void AdminRequestHandler::handleRequest(Transport *transport) {
 #ifdef EXECUTION_PROFILER
         "/prof-exe:        returns sampled execution profile\n"
 #endif
+        "/prof-alloc:      returns sampled allocation-site profile\n"
+        "    top           optional, sites to return (default: 100)\n"
+        "/prof-alloc-reset:\n"
+        "                  drop accumulated allocation samples\n"
         "/vm-tcspace:      show space used by translator caches\n"
         "/vm-tcaddr:       show addresses of translation cache sections\n"
         "/vm-dump-tc:      dump translation cache to /tmp/tc_dump_a and\n"
         "                  /tmp/tc_dump_astub\n"
+        "/vm-dump-rb:      dump the trace ring buffer's most recent\n"
+        "                  entries; optional params: count (default 1000),\n"
+        "                  thread (restrict to one thread id)\n"
         "/vm-namedentities:show size of the NamedEntityTable\n"
+        "/vm-compile-costs:show JIT compile cost per function, ranked by\n"
+        "                  wall-clock time, with profile execution weights\n"
+        "/vm-rds-heat:     show profile-weighted access counts per RDS\n"
+        "                  symbol (requires Eval.ProfileRDSHeat)\n"
+        "/vm-prune-units:  retire cached units whose files no longer\n"
+        "                  exist (sandbox/CLI server mode only)\n"
         "/proxy:           set up request proxy\n"
         "    origin        URL to proxy requests to\n"
         "    percentage    percentage of requests to proxy\n"
@@ -561,6 +687,16 @@ void AdminRequestHandler::handleRequest(Transport *transport) {
       break;
     }
 #endif
+    if (cmd == "profile-request") {
+      // Just discard any existing task.
+      delete s_profileTask.exchange(
+        new ProfileTask{transport->getParam("url"),
+                        transport->getParam("dir"),
+                        std::max(transport->getInt64Param("count"), 1ll)},
+        std::memory_order_acq_rel);
+      transport->sendString("OK\n");
+      break;
+    }
     if (cmd == "build-id") {
       transport->sendString(RuntimeOption::BuildId, 200);
       break;
@@ -593,6 +729,9 @@ void AdminRequestHandler::handleRequest(Transport *transport) {
         handleCheckRequest(cmd, transport)) {
       break;
     }
+    if (cmd == "perf-snapshot" && handlePerfSnapshotRequest(transport)) {
+      break;
+    }
     if (strncmp(cmd.c_str(), "status", 6) == 0 &&
         handleStatusRequest(cmd, transport)) {
       break;
@@ -1047,6 +1186,17 @@ bool AdminRequestHandler::handleCheckRequest(const std::string &cmd,
     transport->sendString(folly::to<string>(count));
     return true;
   }
+  if (cmd == "check-ready") {
+    // Readiness gate for load balancers: report ready only once the JIT
+    // has matured past the configured threshold, instead of relying on a
+    // fixed warmup request count.
+    auto const maturity =
+      ServiceData::createCounter("jit.maturity")->getValue();
+    auto const ready =
+      maturity >= RuntimeOption::ServerReadyJitMaturityThreshold;
+    transport->sendString(folly::to<string>(maturity), ready ? 200 : 503);
+    return true;
+  }
   if (cmd == "check-health") {
     std::stringstream out;
     bool first = true;
@@ -1081,6 +1231,8 @@ bool AdminRequestHandler::handleCheckRequest(const std::string &cmd,
     appendStat("static-strings", makeStaticStringCount());
     appendStat("request-count", requestCount());
     appendStat("single-jit-requests", singleJitRequestCount());
+    appendStat("jit-maturity",
+               ServiceData::createCounter("jit.maturity")->getValue());
 
     /*
      * We're only using globalProfData() here because admin requests don't call
@@ -1152,6 +1304,109 @@ bool AdminRequestHandler::handleCheckRequest(const std::string &cmd,
   return false;
 }
 
+/*
+ * One JSON document sampling the stats that matter when diagnosing a hot
+ * box, so tooling can diff a single endpoint across time and hosts
+ * instead of stitching together status.json, memory.json and the various
+ * check-* outputs.  Keys are meant to be stable: add stats rather than
+ * renaming them.
+ */
+bool AdminRequestHandler::handlePerfSnapshotRequest(Transport *transport) {
+  std::stringstream out;
+  bool first = true;
+  auto const appendStat = [&](folly::StringPiece name, int64_t value) {
+    out << folly::format("{}  \"{}\":{}\n", first ? "" : " ,", name, value);
+    first = false;
+  };
+  auto const beginSection = [&](folly::StringPiece name) {
+    out << folly::format(" ,\"{}\":{{\n", name);
+    first = true;
+  };
+  auto const endSection = [&] { out << " }\n"; };
+
+  out << "{\n";
+  out << folly::format(" \"time\":{}\n", (int64_t)time(nullptr));
+
+  beginSection("load");
+  {
+    HPHP::Server* server = HttpServer::Server->getPageServer();
+    appendStat("active-workers", server->getActiveWorker());
+    appendStat("queued", server->getQueuedJobs());
+    appendStat("pagelet-active-workers", PageletServer::GetActiveWorker());
+    appendStat("pagelet-queued", PageletServer::GetQueuedJobs());
+    appendStat("treadmill-age-oldest-sec", Treadmill::getAgeOldestRequest());
+    appendStat("request-count", requestCount());
+    appendStat("jit-maturity",
+               ServiceData::createCounter("jit.maturity")->getValue());
+  }
+  endSection();
+
+  beginSection("tc");
+  {
+    auto const memInfos = jit::tc::getTCMemoryUsage();
+    for (auto const& info : memInfos) {
+      appendStat(folly::sformat("{}-used", info.name), info.used);
+      if (RuntimeOption::EvalEnableReusableTC) {
+        appendStat(folly::sformat("{}-allocs", info.name), info.allocs);
+        appendStat(folly::sformat("{}-frees", info.name), info.frees);
+        appendStat(folly::sformat("{}-free-size", info.name), info.free_size);
+      }
+    }
+    appendStat("hhbc-size", g_hhbc_size->getSum());
+    appendStat("catch-traces", jit::numCatchTraces());
+    appendStat("fixups", jit::FixupMap::size());
+  }
+  endSection();
+
+  beginSection("rds");
+  {
+    appendStat("used", rds::usedBytes());
+    appendStat("local", rds::usedLocalBytes());
+    appendStat("persistent", rds::usedPersistentBytes());
+  }
+  endSection();
+
+  beginSection("memory");
+  {
+    appendStat("process-rss-mb", Process::GetMemUsageMb());
+    MemInfo meminfo;
+    if (Process::GetMemoryInfo(meminfo) && meminfo.valid()) {
+      appendStat("host-free-mb", meminfo.freeMb);
+      appendStat("host-cached-mb", meminfo.cachedMb);
+      appendStat("host-available-mb", meminfo.availableMb);
+    }
+    appendStat("static-strings", makeStaticStringCount());
+    appendStat("units", numLoadedUnits());
+    appendStat("funcs", Func::nextFuncId());
+  }
+  endSection();
+
+  beginSection("apc");
+  {
+    std::map<const StringData*, int64_t> stats;
+    APCStats::getAPCStats().collectStats(stats);
+    for (auto const& stat : stats) {
+      appendStat(stat.first->slice(), stat.second);
+    }
+  }
+  endSection();
+
+  beginSection("counters");
+  {
+    std::map<std::string, int64_t> counters;
+    ServiceData::exportAll(counters);
+    for (auto const& counter : counters) {
+      appendStat(counter.first, counter.second);
+    }
+  }
+  endSection();
+
+  out << "}\n";
+  transport->replaceHeader("Content-Type", "application/json");
+  transport->sendString(out.str());
+  return true;
+}
+
 bool AdminRequestHandler::handleStatusRequest(const std::string &cmd,
                                               Transport *transport) {
   if (cmd == "status.xml") {
@@ -1278,6 +1533,21 @@ bool AdminRequestHandler::handleProfileRequest(const std::string &cmd,
 
     return true;
   }
+  if (cmd == "prof-alloc") {
+    if (!RuntimeOption::EvalProfileAllocSampleBytes) {
+      transport->sendString("Eval.ProfileAllocSampleBytes is not set\n");
+      return true;
+    }
+    auto top = transport->getIntParam("top");
+    if (top <= 0) top = 100;
+    transport->sendString(AllocSiteProfiler::report(top));
+    return true;
+  }
+  if (cmd == "prof-alloc-reset") {
+    AllocSiteProfiler::reset();
+    transport->sendString("OK\n");
+    return true;
+  }
 #ifdef GOOGLE_CPU_PROFILER
   if (handleCPUProfilerRequest(cmd, transport)) {
     return true;
@@ -1415,6 +1685,23 @@ bool AdminRequestHandler::handleVMRequest(const std::string &cmd,
     transport->sendString(result.str());
     return true;
   }
+  if (cmd == "vm-compile-costs") {
+    transport->sendString(jit::tc::reportFuncCompileCosts());
+    return true;
+  }
+  if (cmd == "vm-rds-heat") {
+    transport->sendString(rds::dumpHeatProfile());
+    return true;
+  }
+  if (cmd == "vm-prune-units") {
+    if (RuntimeOption::RepoAuthoritative) {
+      transport->sendString("Not supported in RepoAuthoritative mode");
+    } else {
+      transport->sendString(
+        folly::to<std::string>(pruneStaleUnits()) + " units pruned");
+    }
+    return true;
+  }
   if (cmd == "vm-dump-tc") {
     if (jit::tc::dump()) {
       transport->sendString("Done");
@@ -1423,6 +1710,20 @@ bool AdminRequestHandler::handleVMRequest(const std::string &cmd,
     }
     return true;
   }
+  if (cmd == "vm-dump-rb") {
+    auto const countStr = transport->getParam("count");
+    auto const count = countStr.empty() ? 1000 : folly::to<int>(countStr);
+    auto const threadStr = transport->getParam("thread");
+    auto const thread =
+      threadStr.empty() ? 0 : folly::to<uint32_t>(threadStr);
+    auto dump = Trace::dumpRingBufferToString(count, thread);
+    if (dump.empty()) {
+      dump = "Ring buffer is empty; enable the `ringbuffer' trace module "
+             "or TRACE_RB statements to populate it\n";
+    }
+    transport->sendString(dump);
+    return true;
+  }
   return false;
 }
 
@@ -1491,6 +1792,31 @@ bool AdminRequestHandler::handleDumpCacheRequest(const std::string &cmd,
     transport->sendString(APCStats::getAPCStats().getStatsInfo());
     return true;
   }
+  if (cmd == "dump-apc-snapshot") {
+    if (!apcExtension::Enable) {
+      transport->sendString("No APC\n");
+      return true;
+    }
+    if (apc_dump_snapshot("/tmp/apc_snapshot")) {
+      transport->sendString("Done");
+    } else {
+      transport->sendString("Failed to write snapshot\n");
+    }
+    return true;
+  }
+  if (cmd == "dump-apc-key-stats") {
+    if (!apcExtension::Enable) {
+      transport->sendString("No APC\n");
+      return true;
+    }
+    if (auto const keyStats = APCStats::getAPCStats().keyStats()) {
+      transport->sendString(keyStats->getStatsInfo());
+    } else {
+      transport->sendString(
+        "Set Server.APC.KeyStats.PrefixLen to enable APC key stats\n");
+    }
+    return true;
+  }
   if (cmd == "dump-apc-meta") {
     if (!apcExtension::Enable) {
       transport->sendString("No APC\n");
@@ -38,6 +38,7 @@ public:
 
 private:
   bool handleCheckRequest  (const std::string &cmd, Transport *transport);
+  bool handlePerfSnapshotRequest(Transport *transport);
   bool handleStatusRequest (const std::string &cmd, Transport *transport);
   bool handleMemoryRequest (const std::string &cmd, Transport *transport);
   bool handleStatsRequest  (const std::string &cmd, Transport *transport);
@@ -558,6 +558,14 @@ void CLIServer::start() {
 
   m_dispatcher->start();
 
+  if (RuntimeOption::EvalUnixServerPrewarmWorkers) {
+    // CLI workers are demand-spawned by default, so a burst of short
+    // commands pays thread and VM context creation per connection. Spawn
+    // the full complement now; idle workers still drop their caches per
+    // Server.ThreadDropCacheTimeoutSeconds.
+    m_dispatcher->startAllWorkers();
+  }
+
   m_mainThread = std::thread([&] {
     m_ev = folly::EventBaseManager::get()->getEventBase();
 
@@ -190,13 +190,13 @@ void FastCGISession::timeoutExpired() noexcept {
 void FastCGISession::describe(std::ostream& os) const {
   os << "[peerAddr: " << m_peerAddr
      << ", localAddr: " << m_localAddr
-     << ", request_id: " << m_requestId
+     << ", active_requests: " << m_requests.size()
      << "]";
 }
 
 bool FastCGISession::isBusy() const {
   // We are busy whenever we are actively serving a request
-  return m_requestId != 0;
+  return !m_requests.empty();
 }
 
 void FastCGISession::notifyPendingShutdown() {
@@ -204,7 +204,7 @@ void FastCGISession::notifyPendingShutdown() {
 }
 
 void FastCGISession::closeWhenIdle() {
-  if (!m_requestId) {
+  if (m_requests.empty()) {
     m_sock->close();   // Flush any pending writes and close, calling close()
                        // will immediately call readEOF and prevent any further
                        // attempts to write data.
@@ -214,7 +214,7 @@ void FastCGISession::closeWhenIdle() {
     // ourselves. Instead we return immediately.
     return;
   }
-  m_keepConn = false; // will shutdown when request completes
+  m_keepConn = false; // will shutdown when the last request completes
 }
 
 void FastCGISession::dropConnection() {
@@ -338,33 +338,38 @@ void FastCGISession::writeSuccess() noexcept {
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void FastCGISession::onStdOut(std::unique_ptr<IOBuf> chain) {
+void FastCGISession::onStdOut(uint16_t requestId,
+                              std::unique_ptr<IOBuf> chain) {
   // FastCGITransport doesn't run in the same event base. Calling into internal
   // functions here is unsafe from other threads so we enqueue the work for the
   // event base.
-  m_eventBase->runInEventBaseThread([this, chain = std::move(chain)]() mutable {
-    writeStream(fcgi::STDOUT, std::move(chain));
+  m_eventBase->runInEventBaseThread([this, requestId,
+                                     chain = std::move(chain)]() mutable {
+    auto const it = m_requests.find(requestId);
+    if (it == m_requests.end() || it->second.aborted) {
+      // The request was aborted; swallow any further output
+      return;
+    }
+    writeStream(fcgi::STDOUT, requestId, std::move(chain));
   });
 }
 
-void FastCGISession::onComplete() {
+void FastCGISession::onComplete(uint16_t requestId) {
   // FastCGITransport doesn't run in the same event base. Calling into internal
   // functions here is unsafe from other threads so we enqueue the work for the
   // event base.
-  m_eventBase->runInEventBaseThread([&] {
-    if (!m_aborting && !m_shutdown) {
-      // If we're aborting we already wrote the end request. If we're shutting
-      // down the socket is closed.
-      writeEndRequest(m_requestId, 0, fcgi::REQUEST_COMPLETE);
+  m_eventBase->runInEventBaseThread([this, requestId] {
+    auto const it = m_requests.find(requestId);
+    assertx(it != m_requests.end());
+    if (it != m_requests.end()) {
+      if (!it->second.aborted && !m_shutdown) {
+        // If the request was aborted we already wrote the end request. If
+        // we're shutting down the socket is closed.
+        writeEndRequest(requestId, 0, fcgi::REQUEST_COMPLETE);
+      }
+      m_requests.erase(it);
     }
 
-    // Reset state
-    m_requestId = 0;
-    m_paramsReader.reset();
-    m_headersComplete = false;
-    m_bodyComplete = false;
-    m_transport.reset();
-
     --m_eventCount; // pending onComplete() received
 
     // Check if we were waiting to shutdown
@@ -374,30 +379,43 @@ void FastCGISession::onComplete() {
     }
 
     // Check if we were the last request on this channel
-    if (!m_keepConn) {
-      shutdown();
-      return; // cannot continue execution after deleting self
+    if (m_requests.empty()) {
+      if (!m_keepConn) {
+        shutdown();
+        return; // cannot continue execution after deleting self
+      }
+
+      // Clear the persistence flag
+      m_keepConn = false;
     }
-
-    // Clear the persistence flag
-    m_keepConn = false;
   });
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void FastCGISession::ioStop() noexcept {
-  if (m_transport) {
-    // We set m_shutdown here because if the transport reenters and attempts
+  if (!m_requests.empty()) {
+    // We set m_shutdown here because if a transport reenters and attempts
     // to write we will put the socket in a very bad state and fail all in
     // flight data.
     m_shutdown = true;
 
-    // If the headers have not been fully received we never started the
-    // transport and exiting without receiving an onComplete is safe.
-    if (m_headersComplete) {
-      m_bodyComplete = true;
-      m_transport->onBodyComplete();
+    for (auto it = m_requests.begin(); it != m_requests.end();) {
+      auto& state = it->second;
+      if (state.headersComplete) {
+        // The job is running; mark ingress complete so the VM doesn't
+        // deadlock waiting for POST data, and keep the entry around until
+        // its onComplete() arrives.
+        if (!state.bodyComplete) {
+          state.bodyComplete = true;
+          state.transport->onBodyComplete();
+        }
+        ++it;
+      } else {
+        // If the headers have not been fully received we never started the
+        // transport and dropping it without receiving an onComplete is safe.
+        it = m_requests.erase(it);
+      }
     }
   }
 
@@ -443,14 +461,9 @@ void FastCGISession::onRecordImpl(const fcgi::begin_record* rec) {
     return;
   }
 
-  if (m_requestId) {
-    if (m_requestId == rec->requestId) {
-      // Malformed stream
-      dropConnection();
-      return;
-    }
-    // Already have an active connection
-    writeEndRequest(rec->requestId, 0, fcgi::CANT_MULTIPLEX_CONN);
+  if (m_requests.count(rec->requestId)) {
+    // Malformed stream; the webserver reused an id that is still in flight
+    dropConnection();
     return;
   }
 
@@ -462,9 +475,8 @@ void FastCGISession::onRecordImpl(const fcgi::begin_record* rec) {
 
   // Until the job actually starts once we receive the headers we don't need
   // to register a pending onComplete()
-  m_requestId = rec->requestId;
-  m_transport = std::make_shared<FastCGITransport>(this);
-  m_paramsReader.reset();
+  auto& state = m_requests[rec->requestId];
+  state.transport = std::make_shared<FastCGITransport>(this, rec->requestId);
 
   // Determine if the server needs us to keep the channel open after the
   // request completes.
@@ -472,75 +484,97 @@ void FastCGISession::onRecordImpl(const fcgi::begin_record* rec) {
 }
 
 void FastCGISession::onRecordImpl(const fcgi::abort_record* rec) {
-  if (!m_requestId || rec->requestId != m_requestId) {
+  auto const it = m_requests.find(rec->requestId);
+  if (rec->requestId == 0 || it == m_requests.end()) {
     // Garbage record
     dropConnection();
     return;
   }
 
-  writeEndRequest(m_requestId, 1, fcgi::REQUEST_COMPLETE);
-  m_aborting = true; // don't try to write REQUEST_COMPLETE again
+  writeEndRequest(rec->requestId, 1, fcgi::REQUEST_COMPLETE);
 
-  // There may still be a pending eventCount from an onComplete call from the
-  // open tranport. We can't clear it here as there is no way to abort the
-  // transport and we need to be around to receive any data it may try to send
-  shutdown();
+  auto& state = it->second;
+  if (!state.headersComplete) {
+    // The job never started; there is no pending onComplete() so the entry
+    // can be dropped immediately. Other streams on the connection are
+    // unaffected.
+    m_requests.erase(it);
+    return;
+  }
+
+  // There is no way to abort the running transport; mark the stream aborted
+  // so that further output is swallowed and REQUEST_COMPLETE isn't written
+  // again, then wait for its onComplete(). Mark ingress complete so the VM
+  // doesn't block waiting for POST data that will never arrive.
+  state.aborted = true;
+  if (!state.bodyComplete) {
+    state.bodyComplete = true;
+    state.transport->onBodyComplete();
+  }
 }
 
 void FastCGISession::onStream(const fcgi::params_record* rec,
                               const IOBuf* chain) {
-  if (!m_requestId || rec->requestId != m_requestId || m_headersComplete) {
+  auto const it = m_requests.find(rec->requestId);
+  if (rec->requestId == 0 || it == m_requests.end() ||
+      it->second.headersComplete) {
     // Garbage record
     dropConnection();
     return;
   }
+  auto& state = it->second;
 
   Cursor cur(chain);
   std::unique_ptr<IOBuf> segment;
   cur.skip(sizeof(fcgi::record));
 
   cur.cloneAtMost(segment, rec->contentLength);
-  if (!m_paramsReader.consume(std::move(segment))) {
-    // Malformed stream
+  if (!state.paramsReader.consume(std::move(segment))) {
+    // Malformed stream; dropping the connection may already have torn down
+    // the request table so don't touch state again
     dropConnection();
+    return;
   }
 
-  while (m_paramsReader.ready()) {
+  while (state.paramsReader.ready()) {
     std::unique_ptr<IOBuf> key, val;
 
-    std::tie(key, val) = m_paramsReader.readNext();
-    m_transport->onHeader(std::move(key), std::move(val));
+    std::tie(key, val) = state.paramsReader.readNext();
+    state.transport->onHeader(std::move(key), std::move(val));
   }
 
-  if (m_paramsReader.done()) {
+  if (state.paramsReader.done()) {
     // If we've started shutting down then don't start the transport job.
     if (m_shutdown) {
       return;
     }
 
-    m_headersComplete = true;
-    m_transport->onHeadersComplete();
+    state.headersComplete = true;
+    state.transport->onHeadersComplete();
 
     // Now that the job is running we need to wait for a call to onComplete()
     ++m_eventCount;
 
     // This enqueue call would be safe from any thread because as the
     // JobQueueDispatcher is synchronized
-    m_dispatcher.enqueue(std::make_shared<FastCGIJob>(m_transport));
+    m_dispatcher.enqueue(std::make_shared<FastCGIJob>(state.transport));
   }
 }
 
 void FastCGISession::onStream(const fcgi::stdin_record* rec,
                               const IOBuf* chain) {
-  if (!m_requestId || rec->requestId != m_requestId || m_bodyComplete) {
+  auto const it = m_requests.find(rec->requestId);
+  if (rec->requestId == 0 || it == m_requests.end() ||
+      it->second.bodyComplete) {
     // Garbage record
     dropConnection();
     return;
   }
+  auto& state = it->second;
 
   if (!rec->contentLength) {
-    m_bodyComplete = true;
-    m_transport->onBodyComplete();
+    state.bodyComplete = true;
+    state.transport->onBodyComplete();
     return;
   }
 
@@ -549,13 +583,13 @@ void FastCGISession::onStream(const fcgi::stdin_record* rec,
   cur.skip(sizeof(fcgi::record));
 
   cur.cloneAtMost(segment, rec->contentLength);
-  m_transport->onBody(std::move(segment));
+  state.transport->onBody(std::move(segment));
 }
 
 void FastCGISession::onStream(const fcgi::values_record* rec,
                               const IOBuf* chain) {
-  if (m_requestId != 0) {
-    // Garbage record
+  if (rec->requestId != 0) {
+    // Garbage record; GET_VALUES is a management stream
     dropConnection();
     return;
   }
@@ -595,8 +629,8 @@ void FastCGISession::writeCapability(const std::string& key) {
   } else if (key == k_getValueMaxRequestsKey) {
     value = std::to_string(m_dispatcher.getTargetNumWorkers());
   } else if (key == k_getValueMultiplexConnsKey) {
-    // multiplexed connections are not implemented
-    value = "0";
+    // requests are multiplexed onto connections by stream id
+    value = "1";
   } else {
     // No-op we are supposed to ignore the keys that we
     // don't understand.
@@ -675,6 +709,7 @@ void FastCGISession::writeUnknownType(fcgi::Type record_type) {
 }
 
 void FastCGISession::writeStream(fcgi::Type type,
+                                 uint16_t request_id,
                                  std::unique_ptr<IOBuf> stream_chain) {
   assertx(type == fcgi::STDOUT || type == fcgi::STDERR);
   if (stream_chain == nullptr) {
@@ -695,7 +730,7 @@ void FastCGISession::writeStream(fcgi::Type type,
     auto rec = reinterpret_cast<fcgi::record*>(appender.writableData());
     rec->version = fcgi::Version::Current;
     rec->type = type;
-    rec->requestId = m_requestId;
+    rec->requestId = request_id;
     rec->contentLength = len;
     rec->paddingLength = pad;
 
@@ -27,6 +27,8 @@
 #include <folly/io/async/AsyncSocket.h>
 #include <wangle/acceptor/ManagedConnection.h>
 
+#include <unordered_map>
+
 namespace HPHP {
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -117,7 +119,9 @@ private:
 /*
  * FastCGISession tracks the state of an active connection with a FastCGI
  * webserver. The session is alive for as long as the connection remains open,
- * or any unfinished transports exist, and can serve a single request at a time.
+ * or any unfinished transports exist. Requests are multiplexed on the
+ * connection as described by the FastCGI spec: each stream record carries the
+ * request id it belongs to and multiple transports may be in flight at once.
  *
  * Sessions decode and encode FastCGI records to facilitate communication
  * between the webserver and the FastCGITransport (which in turn is responsible
@@ -220,8 +224,8 @@ public:
   //
   // NB: FastCGITransport runs in its own thread and these callbacks need to
   //     explicitly place their work onto the event base thread!
-  void onStdOut(std::unique_ptr<folly::IOBuf> chain);
-  void onComplete();
+  void onStdOut(uint16_t requestId, std::unique_ptr<folly::IOBuf> chain);
+  void onComplete(uint16_t requestId);
 
 private:
   //////////////////////////////////////////////////////////////////////////////
@@ -311,6 +315,7 @@ private:
 
   // Write stream records
   void writeStream(fcgi::Type record_type,
+                   uint16_t request_id,
                    std::unique_ptr<folly::IOBuf> stream_chain);
 
   // Construct a new IOBuf containing a single record entry
@@ -357,55 +362,60 @@ private:
 
   folly::IOBufQueue m_readBuf; // buffer for async socket reads
 
-  uint16_t m_requestId{0}; // the request active on the stream; 0 if no request
   bool m_keepConn{false};  // the webserver asked us to remain open after the
                            // current request completes
   bool m_shutdown{false};  // indicates that we should terminate once pending
                            // writes complete
-  bool m_aborting{false};  // waiting for a transport to finish after a call
-                           // to FCGI_ABORT_REQUEST
 
-  // Key-value stream data readers
-  fcgi::KVParser m_paramsReader; // state machine for FCGI_PARAMS
-  fcgi::KVParser m_capReader;    // state machine for FCGI_GET_VALUES
+  // Key-value stream data reader for FCGI_GET_VALUES (management stream)
+  fcgi::KVParser m_capReader;
 
   // Event count is the number of pending writes that have not called the
   // writeSuccess() or writeError() callbacks yet, plus one if we have not
   // yet received a readEOF(). Additionally we consider a pending call to
-  // onComplete() from a currently open transport a pending event as the
+  // onComplete() from each currently open transport a pending event as the
   // transport may try to call us to write data until it completes.
   size_t m_eventCount{0};
 
   //////////////////////////////////////////////////////////////////////////////
-  // Request data- transport and flags
+  // Request data- per-request transports and flags
   //
-  // Transport information pertaining to a single request currently executing.
-  // Once m_headersComplete is set the request is enqueued in the VM and will
-  // run until onComplete() is called. the eventCount must be incremented once
-  // headers are complete to reflect this.
+  // Transport information pertaining to each request currently executing,
+  // keyed by the non-zero request id the webserver chose for its stream.
+  // Once headersComplete is set a request is enqueued in the VM and will run
+  // until onComplete() is called for its id. the eventCount must be
+  // incremented once headers are complete to reflect this.
   //
   // If thie socket shuts down before the entirety of the POST data arrives the
-  // onBodyComplete callback on the transport must be invoked to notify it that
-  // no further data will arrive; otherwise it will deadlock.
+  // onBodyComplete callback on each started transport must be invoked to
+  // notify it that no further data will arrive; otherwise it will deadlock.
 
   // The transport is created by the session, however, once it begins its
   // execution the VM will also own a copy. Once it's made its final
-  // call to onComplete, or if we terminate before enqueuing it, we can reset
-  // our pointer; It cannot be freed unilaterally if we have begun execution of
+  // call to onComplete, or if we terminate before enqueuing it, we can drop
+  // our entry; It cannot be freed unilaterally if we have begun execution of
   // the VM (hence the shared_ptr).
   //
   // Even though no further calls to the session will be made by the transport
   // after onComplete the runtime will continue to access it to log the request
   // and extract other post-completion data. The server/vm will release their
   // shared_ptr when such cleanup is complete.
-  std::shared_ptr<FastCGITransport> m_transport;
-
-  // Need to guard against passing data from these streams back to the
-  // transport after they have been marked as complete. This is particularly
-  // true of headers, if we complete them twice we may try to re-enqueue the
-  // same php request in the vm.
-  bool m_headersComplete{false}; // indicates execution has started
-  bool m_bodyComplete{false};    // indicates no further data for the request
+  //
+  // The completion flags guard against passing data from these streams back
+  // to the transport after they have been marked as complete. This is
+  // particularly true of headers, if we complete them twice we may try to
+  // re-enqueue the same php request in the vm.
+  struct RequestState {
+    std::shared_ptr<FastCGITransport> transport;
+    fcgi::KVParser paramsReader;   // state machine for FCGI_PARAMS
+    bool headersComplete{false};   // indicates execution has started
+    bool bodyComplete{false};      // indicates no further data for the request
+    bool aborted{false};           // FCGI_ABORT_REQUEST received; the end
+                                   // record was already written and any
+                                   // further output must be swallowed
+  };
+
+  std::unordered_map<uint16_t, RequestState> m_requests;
 };
 
 ///////////////////////////////////////////////////////////////////////////////
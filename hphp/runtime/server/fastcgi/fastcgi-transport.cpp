@@ -177,7 +177,8 @@ void FastCGITransport::sendImpl(const void* data, int size, int code,
   }
 
   m_txBuf.append(data, size);
-  m_session->onStdOut(m_txBuf.move()); // session will handle locking
+  // session will handle locking
+  m_session->onStdOut(m_requestId, m_txBuf.move());
 
   if (eom) {
     onSendEndImpl();
@@ -194,7 +195,7 @@ void FastCGITransport::onSendEndImpl() {
   m_sendEnded = true;
   // NB: onSendEnd() is only sent when the VM is finished with the transport.
   //     at this point we are free to do whatever we'd like with the transport.
-  m_session->onComplete();
+  m_session->onComplete(m_requestId);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
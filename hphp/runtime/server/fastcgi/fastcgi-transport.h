@@ -109,7 +109,10 @@ const StaticString s_fastcgi("fastcgi");
  * onSendEndImpl()        onComplete()        None (may destroy)   R/W
  */
 struct FastCGITransport final : Transport, private Synchronizable {
-  explicit FastCGITransport(FastCGISession* session) : m_session(session) {}
+  FastCGITransport(FastCGISession* session, uint16_t requestId)
+    : m_session(session)
+    , m_requestId(requestId)
+  {}
   ~FastCGITransport() override {}
 
   ///////////////////////////////////////////////////////////////////////////
@@ -256,8 +259,11 @@ private:
   // onSendEndImpl() callback is triggered we are free to reset ourselves for
   // another request.
 
-  // Session for communicating with the webserver
+  // Session for communicating with the webserver, and the id of the request
+  // stream we occupy on it; requests are multiplexed per connection so all
+  // egress must be tagged with the id.
   FastCGISession* m_session;
+  uint16_t m_requestId;
 
   // POST request data
   // NB: m_bodyQueue is the only field session can write while the request is
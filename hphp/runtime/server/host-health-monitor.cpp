@@ -16,20 +16,32 @@
 
 #include "hphp/runtime/server/host-health-monitor.h"
 
+#include <chrono>
+#include <mutex>
+
 #include <folly/Singleton.h>
 #include <folly/system/ThreadName.h>
 
 #include "hphp/runtime/base/init-fini-node.h"
+#include "hphp/runtime/base/runtime-option.h"
 #include "hphp/runtime/ext/extension.h"
+#include "hphp/runtime/server/http-server.h"
+#include "hphp/runtime/vm/jit/tc.h"
 #include "hphp/util/compatibility.h"
 #include "hphp/util/health-monitor-types.h"
 #include "hphp/util/logger.h"
+#include "hphp/util/process.h"
+#include "hphp/util/service-data.h"
 
 namespace HPHP {
 
 namespace {
 bool Enabled;
 int32_t UpdateFreq;
+bool ProactiveShedding;
+int32_t ShedLookAheadSeconds;
+int32_t QueueBacklogPerWorker;
+int32_t TCGrowthMbPerSec;
 
 struct HostHealthMonitorExtension final : public Extension {
   HostHealthMonitorExtension() : Extension("hosthealthmonitor", "1.0") {}
@@ -39,11 +51,129 @@ struct HostHealthMonitorExtension final : public Extension {
                  "HealthMonitor.EnableHealthMonitor", true);
     Config::Bind(UpdateFreq, ini, globalConfig,
                  "HealthMonitor.UpdateFreq", 1000 /* miliseconds */);
+    Config::Bind(ProactiveShedding, ini, globalConfig,
+                 "HealthMonitor.ProactiveShedding", false);
+    Config::Bind(ShedLookAheadSeconds, ini, globalConfig,
+                 "HealthMonitor.ShedLookAheadSeconds", 10);
+    Config::Bind(QueueBacklogPerWorker, ini, globalConfig,
+                 "HealthMonitor.QueueBacklogPerWorker", 4);
+    Config::Bind(TCGrowthMbPerSec, ini, globalConfig,
+                 "HealthMonitor.TCGrowthMbPerSec", 4);
   }
 } s_host_health_monitor_extension;
 
 folly::Singleton<HostHealthMonitor> s_health_monitor;
 
+/*
+ * Tracks the per-second growth rate of a sampled value.  The rate is
+ * smoothed over successive samples so a single noisy reading doesn't flip
+ * the health level back and forth.
+ */
+struct GrowthTracker {
+  double update(double value) {
+    auto const now = std::chrono::steady_clock::now();
+    if (m_lastTime.time_since_epoch().count() != 0) {
+      std::chrono::duration<double> dt = now - m_lastTime;
+      if (dt.count() > 0) {
+        auto const inst = (value - m_lastValue) / dt.count();
+        m_rate = (m_rate + inst) / 2;
+      }
+    }
+    m_lastValue = value;
+    m_lastTime = now;
+    return m_rate;
+  }
+
+ private:
+  double m_lastValue{0};
+  double m_rate{0};
+  std::chrono::steady_clock::time_point m_lastTime{};
+};
+
+/*
+ * Backlog on the page server's job queue.  The backlog itself is a lagging
+ * signal; its slope is not.  A queue that is on track to exceed a few jobs
+ * per worker within the look-ahead window is about to turn into queue
+ * timeouts, so we go Cautious while it is still short and NoMore once it
+ * actually gets there.
+ */
+struct QueueBacklogMetric final : IHealthMonitorMetric {
+  bool enabled() override { return ProactiveShedding; }
+  HealthLevel evaluate() override {
+    if (!HttpServer::Server) return HealthLevel::Bold;
+    auto const server = HttpServer::Server->getPageServer();
+    if (!server) return HealthLevel::Bold;
+    auto const queued = server->getQueuedJobs();
+    auto const workers = std::max(server->getMaxThreadCount(), size_t{1});
+    auto const limit = static_cast<double>(QueueBacklogPerWorker) * workers;
+    auto const rate = m_growth.update(queued);
+    if (queued >= limit) return HealthLevel::NoMore;
+    if (rate > 0 && queued + rate * ShedLookAheadSeconds >= limit) {
+      return HealthLevel::Cautious;
+    }
+    return HealthLevel::Bold;
+  }
+
+ private:
+  GrowthTracker m_growth;
+};
+
+/*
+ * Process memory growth.  RSS covers the request heaps in aggregate along
+ * with everything else in the process, which is what the kernel actually
+ * judges us on.  Free memory already below the critical line is an
+ * emergency; free memory projected to cross it within the look-ahead
+ * window is the case early shedding can still save.
+ */
+struct MemoryGrowthMetric final : IHealthMonitorMetric {
+  bool enabled() override { return ProactiveShedding; }
+  HealthLevel evaluate() override {
+    MemInfo mem;
+    if (!Process::GetMemoryInfo(mem)) return HealthLevel::Bold;
+    auto const criticalMb = RuntimeOption::ServerCriticalFreeMb;
+    if (mem.freeMb < criticalMb) return HealthLevel::BackOff;
+    auto const rate = m_growth.update(Process::GetMemUsageMb());
+    if (rate <= 0) return HealthLevel::Bold;
+    auto const projectedFreeMb = mem.freeMb - rate * ShedLookAheadSeconds;
+    if (projectedFreeMb < criticalMb) return HealthLevel::NoMore;
+    if (projectedFreeMb < criticalMb * 2) return HealthLevel::Cautious;
+    return HealthLevel::Bold;
+  }
+
+ private:
+  GrowthTracker m_growth;
+};
+
+/*
+ * Translation cache growth.  Once the JIT is mature the TC should be
+ * essentially static; a sustained burst of new translations means requests
+ * are exiting the cached code en masse and burning CPU on retranslation.
+ * Warmup is excluded by gating on jit maturity.
+ */
+struct TCGrowthMetric final : IHealthMonitorMetric {
+  bool enabled() override { return ProactiveShedding; }
+  HealthLevel evaluate() override {
+    static auto jitMaturityCounter = ServiceData::createCounter("jit.maturity");
+    if (!jitMaturityCounter || jitMaturityCounter->getValue() < 100) {
+      return HealthLevel::Bold;
+    }
+    size_t usedBytes = 0;
+    for (auto const& usage : jit::tc::getUsageInfo()) {
+      // `global' covers the code blocks and data section; the remaining
+      // entries are RDS, whose usage is request-driven rather than
+      // translation-driven.
+      if (usage.global) usedBytes += usage.used;
+    }
+    auto const rateMb = m_growth.update(usedBytes / (1024.0 * 1024.0));
+    if (rateMb >= TCGrowthMbPerSec * 4) return HealthLevel::NoMore;
+    if (rateMb >= TCGrowthMbPerSec) return HealthLevel::Cautious;
+    return HealthLevel::Bold;
+  }
+
+ private:
+  GrowthTracker m_growth;
+};
+
 }
 
 void HostHealthMonitor::addMetric(IHealthMonitorMetric* metric) {
@@ -61,6 +191,20 @@ void HostHealthMonitor::start() {
   if (UpdateFreq < 10) UpdateFreq = 10;
   if (UpdateFreq > 10000) UpdateFreq = 10000;
 
+  if (ProactiveShedding) {
+    // Built-in predictive metrics.  Additional metrics can be plugged in
+    // through IHealthMonitorMetric::registerSelf().
+    static QueueBacklogMetric s_queueBacklog;
+    static MemoryGrowthMetric s_memoryGrowth;
+    static TCGrowthMetric s_tcGrowth;
+    static std::once_flag s_registered;
+    std::call_once(s_registered, [] {
+      s_queueBacklog.registerSelf();
+      s_memoryGrowth.registerSelf();
+      s_tcGrowth.registerSelf();
+    });
+  }
+
   m_monitor_thread = std::make_unique<std::thread>([] {
     folly::setThreadName("HostHealthMonitor");
     folly::Singleton<HostHealthMonitor>::try_get()->monitor();
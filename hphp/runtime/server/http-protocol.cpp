@@ -1008,16 +1008,23 @@ bool HttpProtocol::ProxyRequest(Transport *transport, bool force,
   }
 
   size_t size = 0;
-  const char *data = nullptr;
+  const void *data = nullptr;
+  bool needDelete = false;
   if (transport->getMethod() == Transport::Method::POST) {
-    data = (const char *)transport->getPostData(size);
+    data = transport->getPostData(size);
+    if (data && size) {
+      needDelete = read_all_post_data(transport, data, size);
+    }
   }
 
   req::vector<String> responseHeaders;
   HttpClient http;
   code = http.request(transport->getMethodName(),
-                      url.c_str(), data, size, response, &requestHeaders,
-                      &responseHeaders);
+                      url.c_str(), (const char*)data, size, response,
+                      &requestHeaders, &responseHeaders);
+  if (needDelete) {
+    free((void*)data);
+  }
 
   if (code == 0) {
     if (!force) return false; // so we can retry
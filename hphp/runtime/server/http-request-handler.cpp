@@ -15,9 +15,16 @@
 */
 #include "hphp/runtime/server/http-request-handler.h"
 
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+#include <folly/Conv.h>
+
 #include "hphp/runtime/base/datetime.h"
 #include "hphp/runtime/base/execution-context.h"
 #include "hphp/runtime/base/hhprof.h"
@@ -32,6 +39,7 @@
 #include "hphp/runtime/server/access-log.h"
 #include "hphp/runtime/server/files-match.h"
 #include "hphp/runtime/server/http-protocol.h"
+#include "hphp/runtime/server/http-server.h"
 #include "hphp/runtime/server/request-uri.h"
 #include "hphp/runtime/server/server-stats.h"
 #include "hphp/runtime/server/source-root-info.h"
@@ -115,6 +123,89 @@ void setProxyOriginPercentage(const std::string& origin, int percentage) {
 
 ///////////////////////////////////////////////////////////////////////////////
 
+/*
+ * A GET request being executed on behalf of itself and any identical
+ * requests that arrive while it is running.  The leader publishes its
+ * response here; followers replay it instead of executing the page again.
+ * This is stampede protection: a cache-flush event can otherwise put
+ * hundreds of copies of the same expensive request on one host at once.
+ */
+struct CoalescedRequest {
+  // Leader-side: record the response and wake the followers.
+  void publish(Transport* transport, const char* data, int len) {
+    std::lock_guard<std::mutex> g(m_mutex);
+    m_code = transport->getResponseCode();
+    transport->getResponseHeaders(m_headers);
+    m_body.assign(data, len);
+    m_published = true;
+    m_done = true;
+    m_cv.notify_all();
+  }
+
+  // Leader-side: wake the followers without a response, so they execute
+  // the request themselves.  Harmless after publish().
+  void abandon() {
+    std::lock_guard<std::mutex> g(m_mutex);
+    m_done = true;
+    m_cv.notify_all();
+  }
+
+  // Follower-side: wait for the leader and replay its response.  Returns
+  // false if no response was published in time.
+  bool replay(Transport* transport, int maxWaitSeconds) {
+    std::unique_lock<std::mutex> g(m_mutex);
+    m_cv.wait_for(g, std::chrono::seconds(maxWaitSeconds),
+                  [this] { return m_done; });
+    if (!m_published) return false;
+    for (auto const& header : m_headers) {
+      // Never replay cookies; coalescing skips requests carrying
+      // credentials, but the executed page may still set one.
+      if (strcasecmp(header.first.c_str(), "Set-Cookie") == 0) continue;
+      for (auto const& value : header.second) {
+        transport->addHeader(header.first.c_str(), value.c_str());
+      }
+    }
+    transport->sendRaw(m_body.data(), static_cast<int>(m_body.size()), m_code);
+    transport->onSendEnd();
+    return true;
+  }
+
+ private:
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  bool m_done{false};
+  bool m_published{false};
+  int m_code{0};
+  std::string m_body;
+  HeaderMap m_headers;
+};
+
+namespace {
+
+std::mutex s_inflightGetsLock;
+std::unordered_map<std::string, std::shared_ptr<CoalescedRequest>>
+  s_inflightGets;
+
+// Join the in-flight request for `key', creating it if absent.  Sets
+// `leader' iff the caller is first and must execute and publish.
+std::shared_ptr<CoalescedRequest> joinInflightGet(const std::string& key,
+                                                  bool& leader) {
+  std::lock_guard<std::mutex> g(s_inflightGetsLock);
+  auto& entry = s_inflightGets[key];
+  leader = !entry;
+  if (leader) entry = std::make_shared<CoalescedRequest>();
+  return entry;
+}
+
+void leaveInflightGet(const std::string& key) {
+  std::lock_guard<std::mutex> g(s_inflightGetsLock);
+  s_inflightGets.erase(key);
+}
+
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 THREAD_LOCAL(AccessLog::ThreadData, HttpRequestHandler::s_accessLogThreadData);
 
 AccessLog HttpRequestHandler::s_accessLog(
@@ -124,7 +215,13 @@ HttpRequestHandler::HttpRequestHandler(int timeout)
     : RequestHandler(timeout), m_pathTranslation(true)
     , m_requestTimedOutOnQueue(ServiceData::createTimeSeries(
                                  "requests_timed_out_on_queue",
-                                 {ServiceData::StatsType::COUNT})) { }
+                                 {ServiceData::StatsType::COUNT}))
+    , m_requestShedOnHealth(ServiceData::createTimeSeries(
+                              "requests_shed_on_health",
+                              {ServiceData::StatsType::COUNT}))
+    , m_requestRejectedOnVhostQuota(ServiceData::createTimeSeries(
+                                      "requests_rejected_on_vhost_quota",
+                                      {ServiceData::StatsType::COUNT})) { }
 
 void HttpRequestHandler::sendStaticContent(Transport *transport,
                                            const char *data, int len,
@@ -253,6 +350,22 @@ void HttpRequestHandler::handleRequest(Transport *transport) {
     return;
   }
 
+  // Per-vhost worker quota: when this tenant already occupies its share of
+  // the worker pool, reject instead of letting a burst on one vhost starve
+  // the rest.
+  if (!vhost->acquireWorker()) {
+    transport->sendString("Service Unavailable", 503);
+    transport->onSendEnd();
+    m_requestRejectedOnVhostQuota->addValue(1);
+    return;
+  }
+  SCOPE_EXIT { vhost->releaseWorker(); };
+
+  // Optionally confine this request to the vhost's CPU set, so a noisy
+  // tenant contends for its own cores rather than the whole box.
+  vhost->pinWorker();
+  SCOPE_EXIT { VirtualHost::unpinWorker(); };
+
   // don't serve the request if it's been sitting in queue for longer than our
   // allowed request timeout.
   int requestTimeoutSeconds =
@@ -270,6 +383,36 @@ void HttpRequestHandler::handleRequest(Transport *transport) {
     }
   }
 
+  // When the host health monitor projects trouble, shed the lowest-priority
+  // requests first, while the box is still healthy enough to serve the rest.
+  // A request's priority comes from the configured header (absent or
+  // unparsable means lowest); the health level sets the cutoff below which
+  // requests are rejected.
+  if (!RuntimeOption::ServerRequestPriorityHeader.empty() &&
+      HttpServer::Server) {
+    if (auto const server = HttpServer::Server->getPageServer()) {
+      auto const level = server->getHealthLevel();
+      if (level > HealthLevel::Moderate) {
+        int64_t priority = 0;
+        auto const value = transport->getHeader(
+          RuntimeOption::ServerRequestPriorityHeader.c_str());
+        if (!value.empty()) {
+          if (auto const parsed = folly::tryTo<int64_t>(value)) {
+            priority = *parsed;
+          }
+        }
+        auto const cutoff = static_cast<int>(level) -
+                            static_cast<int>(HealthLevel::Moderate);
+        if (priority < cutoff) {
+          transport->sendString("Service Unavailable", 503);
+          transport->onSendEnd();
+          m_requestShedOnHealth->addValue(1);
+          return;
+        }
+      }
+    }
+  }
+
   ServerStats::StartRequest(transport->getCommand().c_str(),
                             transport->getRemoteHost(),
                             vhost->getName().c_str());
@@ -356,6 +499,45 @@ void HttpRequestHandler::handleRequest(Transport *transport) {
     return;
   }
 
+  // Coalesce identical in-flight GETs: duplicates park on the request
+  // already executing and replay its response instead of running the page
+  // again.  Only requests without credentials participate, since anything
+  // authenticated may get a personalized response.
+  std::string coalesceKey;
+  if (RuntimeOption::ServerCoalesceDuplicateGets &&
+      transport->getMethod() == Transport::Method::GET &&
+      transport->getHeader("Cookie").empty() &&
+      transport->getHeader("Authorization").empty()) {
+    coalesceKey = folly::to<std::string>(
+      transport->getHeader("Host"), ':', transport->getUrl());
+    bool leader = false;
+    auto const entry = joinInflightGet(coalesceKey, leader);
+    if (leader) {
+      m_coalesced = entry;
+    } else {
+      int maxWait = requestTimeoutSeconds > 0
+        ? requestTimeoutSeconds
+        : RuntimeOption::ConnectionTimeoutSeconds;
+      if (maxWait <= 0) maxWait = 50;
+      if (entry->replay(transport, maxWait)) {
+        ServerStats::LogPage(path, transport->getResponseCode());
+        return;
+      }
+      // The leader didn't produce a replayable response (it errored out,
+      // or timed out); fall through and execute normally.
+    }
+  }
+  SCOPE_EXIT {
+    if (m_coalesced) {
+      // Erase before waking so late arrivals start a fresh leader instead
+      // of joining a finished entry; abandon() wakes any followers even if
+      // we errored out before publishing.
+      leaveInflightGet(coalesceKey);
+      m_coalesced->abandon();
+      m_coalesced.reset();
+    }
+  };
+
   // record request for debugging purpose
   std::string tmpfile = HttpProtocol::RecordRequest(transport);
 
@@ -467,6 +649,11 @@ bool HttpRequestHandler::executePHPRequest(Transport *transport,
     String content = context->obDetachContents();
     transport->sendRaw(content.data(), content.size());
     code = transport->getResponseCode();
+    if (m_coalesced) {
+      // Hand the uncompressed buffer to any coalesced duplicates; each
+      // follower's transport compresses for its own client.
+      m_coalesced->publish(transport, content.data(), content.size());
+    }
   } else if (error) {
     code = 500;
 
@@ -529,8 +716,10 @@ bool HttpRequestHandler::executePHPRequest(Transport *transport,
                                      entry,
                                      false /*psp*/);
   if (entry) {
-    StructuredLog::log("hhvm_request_perf", *entry);
-    transport->resetStructuredLogEntry();
+    // Hand the entry to the drainer; serializing it and running the sink
+    // are not worth a request thread's time.
+    StructuredLog::logDeferred("hhvm_request_perf",
+                               transport->releaseStructuredLogEntry());
   }
 
   // If we have registered post-send shutdown functions, end the request before
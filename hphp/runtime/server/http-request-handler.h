@@ -42,6 +42,8 @@ void setProxyOriginPercentage(const std::string& origin, int percentage);
 
 ///////////////////////////////////////////////////////////////////////////////
 
+struct CoalescedRequest;
+
 struct HttpRequestHandler : RequestHandler {
   static AccessLog &GetAccessLog() { return s_accessLog; }
 
@@ -61,7 +63,11 @@ public:
 private:
   bool m_pathTranslation;
   ServiceData::ExportedTimeSeries* m_requestTimedOutOnQueue;
+  ServiceData::ExportedTimeSeries* m_requestShedOnHealth;
+  ServiceData::ExportedTimeSeries* m_requestRejectedOnVhostQuota;
   folly::Optional<SourceRootInfo> m_sourceRootInfo;
+  // set while this handler leads a group of coalesced identical GETs
+  std::shared_ptr<CoalescedRequest> m_coalesced;
 
   bool handleFileRequest(Transport *transport, const String& translated,
                          const std::string& path, const char* ext);
@@ -27,6 +27,7 @@
 #include "hphp/runtime/debugger/debugger.h"
 #include "hphp/runtime/ext/apc/ext_apc.h"
 #include "hphp/runtime/server/admin-request-handler.h"
+#include "hphp/runtime/server/host-health-monitor.h"
 #include "hphp/runtime/server/http-request-handler.h"
 #include "hphp/runtime/server/replay-transport.h"
 #include "hphp/runtime/server/server-stats.h"
@@ -37,6 +38,7 @@
 
 #include "hphp/util/alloc.h"
 #include "hphp/util/boot-stats.h"
+#include "hphp/util/compatibility.h"
 #include "hphp/util/light-process.h"
 #include "hphp/util/logger.h"
 #include "hphp/util/process.h"
@@ -116,6 +118,10 @@ HttpServer::HttpServer()
   m_pageServer->addTakeoverListener(this);
   m_pageServer->addServerEventListener(this);
 
+  // The page server tracks host health so request handlers can shed
+  // low-priority traffic as the box degrades.
+  getSingleton<HostHealthMonitor>()->subscribe(m_pageServer.get());
+
   if (startingThreadCount != RuntimeOption::ServerThreadCount) {
     auto handlerFactory = std::make_shared<WarmupRequestHandlerFactory>(
       m_pageServer.get(),
@@ -358,6 +364,8 @@ void HttpServer::runOrExitProcess() {
                      e.what()));
   }
 
+  getSingleton<HostHealthMonitor>()->start();
+
   {
     BootStats::mark("servers started");
     Logger::Info("all servers started");
@@ -423,6 +431,10 @@ void HttpServer::runOrExitProcess() {
     }
   }
 
+  // Resets the health level to Bold so draining isn't throttled by a
+  // stale status.
+  getSingleton<HostHealthMonitor>()->stop();
+
   if (RuntimeOption::ServerPort) {
     Logger::Info("stopping page server");
     m_pageServer->stop();
@@ -52,6 +52,9 @@ std::string FieldGenerator::escapeData(const char* s, int len) {
 }
 
 ClassicWriter::~ClassicWriter() {
+  // The flush thread writes to our output file; it must be gone before the
+  // file is closed.
+  stopFlushThread();
   if (m_channel == LogChannel::REGULAR) {
     if (m_logdata.file[0] == '|') {
       pclose(m_filelog);
@@ -84,6 +87,7 @@ void ClassicWriter::init(const std::string& username,
     if (m_logdata.file[0] == '|') {
       std::string plog = m_logdata.file.substr(1);
       m_filelog = popen(plog.c_str(), "w");
+      m_isPipeOutput = true;
     } else {
       m_filelog = fopen(m_logdata.file.c_str(), "a");
     }
@@ -91,11 +95,13 @@ void ClassicWriter::init(const std::string& username,
       Logger::Error("Couldn't open access log file %s", m_logdata.file.c_str());
     }
   }
+  startFlushThread();
 }
 
 void ClassicWriter::write(Transport* transport, const VirtualHost* vhost) {
-  auto outfile = getOutputFile();
-  if (!outfile) return;
+  // In async mode the flush thread resolves the output file; don't bother
+  // formatting here if there will be nowhere to write inline.
+  if (!async() && !getOutputFile()) return;
   char c;
   std::ostringstream out;
   const auto* format = m_logdata.format.c_str();
@@ -125,13 +131,7 @@ void ClassicWriter::write(Transport* transport, const VirtualHost* vhost) {
   }
   out << std::endl;
 
-  auto str = out.str();
-  int nbytes = fwrite(str.data(), 1, str.size(), outfile);
-  fflush(outfile);
-
-  if (m_channel != LogChannel::REGULAR || m_logdata.file[0] != '|') {
-    recordWriteAndMaybeDropCaches(outfile, nbytes);
-  }
+  outputLine(out.str());
 }
 
 const std::string ClassicWriter::handle = "__classic";
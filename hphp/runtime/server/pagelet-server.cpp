@@ -378,9 +378,13 @@ void PageletServer::Restart() {
          RuntimeOption::PageletServerThreadDropCacheTimeoutSeconds,
          RuntimeOption::PageletServerThreadDropStack,
          nullptr);
+      s_dispatcher->setThreadGroup("pagelet-worker");
       s_dispatcher->setHugePageConfig(
         RuntimeOption::PageletServerHugeThreadCount,
         RuntimeOption::ServerHugeStackKb);
+      // The pagelets of one page fan out from a single web thread; waking
+      // workers on that thread's numa node keeps them together.
+      s_dispatcher->setGroupAffinity(true);
       auto monitor = getSingleton<HostHealthMonitor>();
       monitor->subscribe(s_dispatcher);
     }
@@ -33,6 +33,7 @@
 #include "hphp/util/compatibility.h"
 #include "hphp/util/process.h"
 
+#include <folly/Conv.h>
 #include <folly/portability/Unistd.h>
 #include <proxygen/lib/http/codec/HTTP2Constants.h>
 
@@ -171,6 +172,7 @@ ProxygenServer::ProxygenServer(
                    options.m_initThreads,
                    options.m_hugeStackKb,
                    options.m_extraKb) {
+  m_dispatcher.setThreadGroup("http-worker");
   if (options.m_loop_sample_rate > 0) {
     m_worker.getEventBase()->setObserver(
       std::make_shared<ProxygenEventBaseObserver>(options.m_loop_sample_rate));
@@ -674,6 +676,24 @@ int ProxygenServer::getLibEventConnectionCount() {
   return conns;
 }
 
+namespace {
+// Apply the TLS resumption settings shared by every SSL context we hand to
+// the acceptors.  Ticket-based resumption is the mechanism that actually
+// spans processes: every HHVM process on the host reads the same
+// SSLTicketSeedFile, so a ticket minted by one sibling decrypts in any
+// other.  The session-ID cache only covers ticketless clients and lives in
+// process memory; its size and lifetime come from the acceptor's
+// sslCacheOptions.  A common session context id tells clients that the
+// siblings form one resumption domain.
+void configureSessionResumption(wangle::SSLContextConfig& cfg) {
+  cfg.sessionTicketEnabled = !RuntimeOption::SSLTicketSeedFile.empty();
+  cfg.sessionCacheEnabled = RuntimeOption::SSLSessionCache;
+  if (!RuntimeOption::SSLSessionContextId.empty()) {
+    cfg.sessionContext = RuntimeOption::SSLSessionContextId;
+  }
+}
+}
+
 bool ProxygenServer::initialCertHandler(const std::string& /*server_name*/,
                                         const std::string& key_file,
                                         const std::string& cert_file,
@@ -694,6 +714,7 @@ bool ProxygenServer::initialCertHandler(const std::string& /*server_name*/,
       std::begin(RuntimeOption::ServerNextProtocols),
       std::end(RuntimeOption::ServerNextProtocols)
     });
+    configureSessionResumption(sslCtxConfig);
     if (m_httpsConfig.isSSL()) {
       m_httpsConfig.sslContextConfigs.emplace_back(sslCtxConfig);
     }
@@ -738,6 +759,7 @@ bool ProxygenServer::dynamicCertHandler(const std::string& /*server_name*/,
       std::begin(RuntimeOption::ServerNextProtocols),
       std::end(RuntimeOption::ServerNextProtocols)
     });
+    configureSessionResumption(sslCtxConfig);
     if (m_httpsAcceptor) {
       m_httpsAcceptor->addSSLContextConfig(sslCtxConfig);
     }
@@ -784,6 +806,14 @@ bool ProxygenServer::enableSSL(int port) {
 
   m_httpsConfig.bindAddress = address;
   m_httpsConfig.strictSSL = false;
+  if (RuntimeOption::SSLSessionCache) {
+    m_httpsConfig.sslCacheOptions.sslCacheTimeout =
+      std::chrono::seconds(RuntimeOption::SSLSessionLifetimeSeconds);
+    m_httpsConfig.sslCacheOptions.maxSSLCacheSize =
+      RuntimeOption::SSLSessionCacheSize;
+    m_httpsConfig.sslCacheOptions.sslCacheFlushSize =
+      RuntimeOption::SSLSessionCacheSize / 10;
+  }
   m_httpsConfig.sslContextConfigs.emplace_back(createContextConfig());
   m_https = true;
   return true;
@@ -791,6 +821,14 @@ bool ProxygenServer::enableSSL(int port) {
 
 bool ProxygenServer::enableSSLWithPlainText() {
   m_httpConfig.strictSSL = false;
+  if (RuntimeOption::SSLSessionCache) {
+    m_httpConfig.sslCacheOptions.sslCacheTimeout =
+      std::chrono::seconds(RuntimeOption::SSLSessionLifetimeSeconds);
+    m_httpConfig.sslCacheOptions.maxSSLCacheSize =
+      RuntimeOption::SSLSessionCacheSize;
+    m_httpConfig.sslCacheOptions.sslCacheFlushSize =
+      RuntimeOption::SSLSessionCacheSize / 10;
+  }
   m_httpConfig.sslContextConfigs.emplace_back(createContextConfig());
   m_httpConfig.allowInsecureConnectionsOnSecureServer = true;
   return true;
@@ -820,6 +858,7 @@ wangle::SSLContextConfig ProxygenServer::createContextConfig() {
   } else {
     Logger::Error("Invalid certificate file or key file");
   }
+  configureSessionResumption(cfg);
   return cfg;
 }
 
@@ -843,7 +882,21 @@ void ProxygenServer::onRequest(std::shared_ptr<ProxygenTransport> transport) {
       " and priority=" << priority;
     m_enqueuedCount++;
     transport->setEnqueued();
-    m_dispatcher.enqueue(std::make_shared<ProxygenJob>(transport), priority);
+    // The transport may carry a queuing budget for this request.  A job
+    // that waits past its budget is handed to its worker as expired and
+    // aborted with a 503 instead of being executed.
+    int maxQueuingMs = -1;
+    auto const& budgetHeader = RuntimeOption::ServerQueuingBudgetHeader;
+    if (!budgetHeader.empty()) {
+      auto const value = transport->getHeader(budgetHeader.c_str());
+      if (!value.empty()) {
+        if (auto const budget = folly::tryTo<int>(value)) {
+          maxQueuingMs = *budget;
+        }
+      }
+    }
+    m_dispatcher.enqueue(std::make_shared<ProxygenJob>(transport), priority,
+                         maxQueuingMs);
   } else {
     // VM is shutdown
     transport->abort();
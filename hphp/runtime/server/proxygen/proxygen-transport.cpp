@@ -342,9 +342,10 @@ void ProxygenTransport::onEOM() noexcept {
       return;
     }
     if (!m_bodyData.empty()) {
-      // TODO: let's remove gratuitous mallocs and copies please
-      m_currentBodyBuf = m_bodyData.move();
-      m_currentBodyBuf->coalesce();
+      // Hand out the buffered body one IOBuf extent at a time instead of
+      // coalescing the chain into a contiguous copy; consumers pull the
+      // remaining extents through getMorePostData().
+      m_currentBodyBuf = m_bodyData.pop_front();
       m_firstBody = true;
       VLOG(4) << *m_clientTxn << "m_currentBodyBuf.length=" <<
         m_currentBodyBuf->length();
@@ -399,7 +400,7 @@ const void *ProxygenTransport::getPostData(size_t &size) {
 bool ProxygenTransport::hasMorePostData() {
   if (bufferRequest()) {
     CHECK(m_clientComplete);
-    return false;
+    return !m_bodyData.empty();
   }
   Lock lock(this);
   // We have more post data if a) there's some in the queue or b) the client
@@ -412,9 +413,18 @@ bool ProxygenTransport::hasMorePostData() {
 
 const void *ProxygenTransport::getMorePostData(size_t &size) {
   if (bufferRequest()) {
+    // The whole body arrived before the request was dispatched; no
+    // locking or waiting is needed, just walk the remaining extents.
     CHECK(m_clientComplete);
-    size = 0;
-    return nullptr;
+    if (m_bodyData.empty()) {
+      size = 0;
+      return nullptr;
+    }
+    m_firstBody = false;
+    m_currentBodyBuf = m_bodyData.pop_front();
+    CHECK(m_currentBodyBuf && m_currentBodyBuf->length() > 0);
+    size = m_currentBodyBuf->length();
+    return m_currentBodyBuf->data();
   }
 
   // proxygen will send onTimeout if we don't receive data in this much time
@@ -551,6 +561,19 @@ void ProxygenTransport::sendErrorResponse(uint32_t code) noexcept {
   m_clientTxn->sendEOM();
 }
 
+void ProxygenTransport::onEgressPaused() noexcept {
+  VLOG(4) << *m_clientTxn << "egress paused";
+  Lock lock(this);
+  m_egressPaused = true;
+}
+
+void ProxygenTransport::onEgressResumed() noexcept {
+  VLOG(4) << *m_clientTxn << "egress resumed";
+  Lock lock(this);
+  m_egressPaused = false;
+  notify();
+}
+
 void ProxygenTransport::onError(const HTTPException& err) noexcept {
   Logger::Error("HPHP transport error: %s", err.describe().c_str());
 
@@ -671,6 +694,12 @@ void ProxygenTransport::messageAvailable(ResponseMessage&& message) noexcept {
 void ProxygenTransport::sendImpl(const void *data, int size, int code,
                                  bool chunked, bool eom) {
   assertx(data);
+  sendBufferedImpl(size > 0 ? folly::IOBuf::copyBuffer(data, size) : nullptr,
+                   code, chunked, eom);
+}
+
+void ProxygenTransport::sendBufferedImpl(std::unique_ptr<folly::IOBuf> chunk,
+                                         int code, bool chunked, bool eom) {
   assertx(!m_sendStarted || chunked);
   if (m_sendEnded) {
     // This should never happen, but when it does we have to bail out,
@@ -681,6 +710,21 @@ void ProxygenTransport::sendImpl(const void *data, int size, int code,
     return;
   }
 
+  if (chunked && RuntimeOption::ServerChunkedEgressBackpressureSeconds > 0) {
+    // When proxygen has paused egress because the client isn't draining
+    // the response, hold the worker thread here instead of queuing the
+    // rest of the response in memory.  Bound each wait so a stalled
+    // client degrades back to buffering rather than wedging the request.
+    Lock lock(this);
+    while (m_egressPaused && !m_egressError) {
+      VLOG(4) << "egress paused, waiting before sending more";
+      if (!wait(RuntimeOption::ServerChunkedEgressBackpressureSeconds)) {
+        break;
+      }
+    }
+  }
+
+  auto const size = chunk ? chunk->computeChainDataLength() : 0;
   VLOG(4) << "sendImpl called with data size=" << size << ", code=" << code
           << ", chunked=" << chunked << ", eom=" << eom;
   eom |= !chunked;
@@ -706,13 +750,13 @@ void ProxygenTransport::sendImpl(const void *data, int size, int code,
     m_server->putResponseMessage(
       ResponseMessage(shared_from_this(),
                       ResponseMessage::Type::HEADERS, 0,
-                      chunked, data, size, eom));
+                      chunked, std::move(chunk), eom));
     m_sendStarted = true;
   } else {
     m_server->putResponseMessage(
       ResponseMessage(shared_from_this(),
                       ResponseMessage::Type::BODY, 0,
-                      chunked, data, size, eom));
+                      chunked, std::move(chunk), eom));
   }
 
   if (eom) {
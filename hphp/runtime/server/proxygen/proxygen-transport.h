@@ -62,6 +62,20 @@ struct ResponseMessage {
       }
     };
 
+  explicit ResponseMessage(std::shared_ptr<ProxygenTransport> transport,
+                           Type t, uint64_t pushId, bool chunked,
+                           std::unique_ptr<folly::IOBuf> chunk, bool eom)
+    : m_transport(transport),
+      m_type(t),
+      m_pushId(pushId),
+      m_chunked(chunked),
+      m_chunk(std::move(chunk)),
+      m_eom(eom) {
+    if (m_chunk && m_chunk->computeChainDataLength() == 0) {
+      m_chunk.reset();
+    }
+  };
+
   ResponseMessage(ResponseMessage&& m) noexcept
   : m_transport(std::move(m.m_transport)),
     m_type(m.m_type),
@@ -184,6 +198,14 @@ struct ProxygenTransport final
   void sendImpl(const void *data, int size, int code,
                 bool chunked, bool eom) override;
 
+  /**
+   * The buffered flavor: takes ownership of chunk rather than copying it
+   * into the ResponseMessage.
+   */
+  bool supportsBufferedSendImpl() const override { return true; }
+  void sendBufferedImpl(std::unique_ptr<folly::IOBuf> chunk, int code,
+                        bool chunked, bool eom) override;
+
   /**
    * Override to implement more send end logic.
    */
@@ -274,9 +296,9 @@ struct ProxygenTransport final
   // the POST path
   void onError(const proxygen::HTTPException& error) noexcept override;
 
-  void onEgressPaused() noexcept override { }
+  void onEgressPaused() noexcept override;
 
-  void onEgressResumed() noexcept override { }
+  void onEgressResumed() noexcept override;
 
   void messageAvailable(ResponseMessage&& message) noexcept;
 
@@ -343,6 +365,11 @@ struct ProxygenTransport final
   folly::IOBufQueue m_bodyData{folly::IOBufQueue::cacheChainLength()};
   bool m_clientComplete{false};
 
+  // True while proxygen has paused egress because the client isn't
+  // draining the response.  Protected by the lock; a worker thread
+  // streaming a chunked response waits on it in sendBufferedImpl.
+  bool m_egressPaused{false};
+
   bool m_firstBody{false};
   bool m_enqueued{false};
   // Set to true when sending a partial post back to
@@ -0,0 +1,106 @@
+/*
+   +----------------------------------------------------------------------+
+   | HipHop for PHP                                                       |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 2010-present Facebook, Inc. (http://www.facebook.com)  |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 3.01 of the PHP license,      |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.php.net/license/3_01.txt                                  |
+   | If you did not receive a copy of the PHP license and are unable to   |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@php.net so we can mail you a copy immediately.               |
+   +----------------------------------------------------------------------+
+*/
+
+#include "hphp/runtime/server/replay-bench.h"
+
+#include "hphp/runtime/base/memory-manager.h"
+#include "hphp/runtime/server/http-request-handler.h"
+#include "hphp/runtime/server/http-server.h"
+#include "hphp/runtime/server/replay-transport.h"
+#include "hphp/util/service-data.h"
+#include "hphp/util/timer.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <map>
+
+namespace HPHP {
+///////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+int64_t percentile(const std::vector<int64_t>& sorted, double p) {
+  if (sorted.empty()) return 0;
+  return sorted[size_t(p * (sorted.size() - 1))];
+}
+
+int64_t jitMaturity() {
+  auto const value = ServiceData::exportCounterByKey("jit.maturity");
+  return value ? *value : 0;
+}
+
+// The per-request MM stats accumulate in timeseries under the request
+// tag we set before each replayed request; dump whatever was exported.
+void printMemStats() {
+  std::map<std::string, int64_t> stats;
+  ServiceData::exportAll(stats);
+  const std::string prefix = "mem.request.replay.";
+  printf("\nmemory-manager stats (averaged across all replayed requests):\n");
+  for (auto const& kv : stats) {
+    if (kv.first.compare(0, prefix.size(), prefix) != 0) continue;
+    printf("  %-48s %12" PRId64 "\n", kv.first.c_str(), kv.second);
+  }
+}
+
+}
+
+int runReplayBench(const std::vector<std::string>& files, int passes) {
+  HttpServer server; // so we initialize the runtime the way server mode does
+  HttpRequestHandler handler(0);
+
+  printf("replaying %zu requests x %d passes\n\n", files.size(), passes);
+  printf("%4s %12s %12s %12s %12s %12s %9s\n",
+         "pass", "p50(us)", "p90(us)", "p99(us)", "max(us)", "avg(us)",
+         "jit.mat");
+
+  for (auto pass = 0; pass < passes; ++pass) {
+    std::vector<int64_t> latencies;
+    latencies.reserve(files.size());
+    int64_t total = 0;
+    for (auto const& file : files) {
+      ReplayTransport rt;
+      rt.replayInput(file.c_str());
+      tl_heap.getCheck();
+      tl_heap->setRequestTag("replay");
+      auto const start = gettime_ns(CLOCK_MONOTONIC);
+      handler.run(&rt);
+      auto const us = (gettime_ns(CLOCK_MONOTONIC) - start) / 1000;
+      latencies.push_back(us);
+      total += us;
+    }
+    std::sort(latencies.begin(), latencies.end());
+    // The maturity counter after each pass traces the JIT warmup curve:
+    // latency percentiles are only comparable between builds at similar
+    // maturity.
+    printf("%4d %12" PRId64 " %12" PRId64 " %12" PRId64 " %12" PRId64
+           " %12" PRId64 " %8" PRId64 "%%\n",
+           pass + 1,
+           percentile(latencies, 0.5),
+           percentile(latencies, 0.9),
+           percentile(latencies, 0.99),
+           latencies.empty() ? 0 : latencies.back(),
+           latencies.empty() ? 0 : total / int64_t(latencies.size()),
+           jitMaturity());
+    fflush(stdout);
+  }
+
+  printMemStats();
+  return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+}
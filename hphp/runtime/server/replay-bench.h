@@ -0,0 +1,46 @@
+/*
+   +----------------------------------------------------------------------+
+   | HipHop for PHP                                                       |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 2010-present Facebook, Inc. (http://www.facebook.com)  |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 3.01 of the PHP license,      |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.php.net/license/3_01.txt                                  |
+   | If you did not receive a copy of the PHP license and are unable to   |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@php.net so we can mail you a copy immediately.               |
+   +----------------------------------------------------------------------+
+*/
+
+#ifndef incl_HPHP_REPLAY_BENCH_H_
+#define incl_HPHP_REPLAY_BENCH_H_
+
+#include <string>
+#include <vector>
+
+namespace HPHP {
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+ * Benchmark sibling of ReplayTransport's replay mode: feed a corpus of
+ * captured requests (files recorded by ReplayTransport::recordInput())
+ * through the full HttpRequestHandler pipeline in-process, `passes'
+ * times over.  No network is involved, so results on one dev box are
+ * stable enough to bisect runtime regressions.
+ *
+ * Each pass reports wall-time latency percentiles and the jit.maturity
+ * counter, so the pass-over-pass progression shows the JIT warming up;
+ * memory-manager per-request stats are aggregated under the "replay"
+ * request tag and dumped at the end.
+ *
+ * Invoked via `hhvm -m replay-bench <capture files>'; the caller has
+ * already set server execution mode.  Returns a process exit status.
+ */
+int runReplayBench(const std::vector<std::string>& files, int passes);
+
+///////////////////////////////////////////////////////////////////////////////
+}
+
+#endif // incl_HPHP_REPLAY_BENCH_H_
@@ -16,8 +16,10 @@
 
 #include "hphp/runtime/server/takeover-agent.h"
 #include "hphp/util/logger.h"
+#include "hphp/runtime/base/runtime-option.h"
 #include "hphp/runtime/base/string-util.h"
 #include "hphp/runtime/ext/string/ext_string.h"
+#include "hphp/runtime/vm/jit/prof-data-serialize.h"
 #include <folly/String.h>
 #ifndef _MSC_VER
 #include <afdt.h>
@@ -53,6 +55,9 @@
 #define C_TERM_OK  "\x05"
 #define C_TERM_BAD "\x06"
 #define C_UNKNOWN  "\x07"
+#define C_PROF_REQ "\x08"
+#define C_PROF_OK  "\x09"
+#define C_PROF_BAD "\x0a"
 
 namespace HPHP {
 
@@ -94,7 +99,9 @@ TakeoverAgent::TakeoverAgent(const std::string &fname)
 const StaticString
   s_ver_C_FD_REQ(P_VERSION C_FD_REQ),
   s_ver_C_TERM_REQ(P_VERSION C_TERM_REQ),
-  s_ver_C_TERM_OK(P_VERSION C_TERM_OK);
+  s_ver_C_TERM_OK(P_VERSION C_TERM_OK),
+  s_ver_C_PROF_REQ(P_VERSION C_PROF_REQ),
+  s_ver_C_PROF_OK(P_VERSION C_PROF_OK);
 
 int TakeoverAgent::afdtRequest(String request, String* response) {
 #ifdef _MSC_VER
@@ -132,6 +139,26 @@ int TakeoverAgent::afdtRequest(String request, String* response) {
     }
     Logger::Info("takeover: notification complete");
     return -1;
+  } else if (request == s_ver_C_PROF_REQ) {
+    // The taking-over process wants our current jit profile.  Serialize
+    // it to the shared Eval.JitSerdesFile; serialization writes a partial
+    // file and renames it into place, so a reader never sees a torn file.
+    Logger::Info("takeover: request is a jit profile request");
+    *response = P_VERSION C_PROF_BAD;
+    if (RuntimeOption::RepoAuthoritative &&
+        !RuntimeOption::EvalJitSerdesFile.empty()) {
+      auto const errMsg =
+        jit::serializeProfData(RuntimeOption::EvalJitSerdesFile);
+      if (errMsg.empty()) {
+        Logger::FInfo("takeover: serialized jit profile to {}",
+                      RuntimeOption::EvalJitSerdesFile);
+        *response = P_VERSION C_PROF_OK;
+      } else {
+        Logger::FError("takeover: jit profile serialization failed: {}",
+                       errMsg);
+      }
+    }
+    return -1;
   } else {
     Logger::Error("takeover: request is unrecognized");
     *response = P_VERSION C_UNKNOWN;
@@ -140,6 +167,35 @@ int TakeoverAgent::afdtRequest(String request, String* response) {
 #endif
 }
 
+bool TakeoverAgent::requestProfile(const std::string& transferFname,
+                                   std::chrono::seconds timeoutSec) {
+#ifdef _MSC_VER
+  return false;
+#else
+  uint8_t prof_request[3] = P_VERSION C_PROF_REQ;
+  uint8_t prof_response[3] = {0,0,0};
+  uint32_t response_len = sizeof(prof_response);
+  int should_not_receive_fd;
+  afdt_error_t err = AFDT_ERROR_T_INIT;
+  struct timeval timeout = { (long)timeoutSec.count(), 0 };
+  int ret = afdt_sync_client(transferFname.c_str(),
+                             prof_request,
+                             sizeof(prof_request) - 1,
+                             prof_response,
+                             &response_len,
+                             &should_not_receive_fd,
+                             &timeout,
+                             &err);
+  if (ret < 0) {
+    // No old server is listening, or it predates the profile request;
+    // fall back to whatever is already on disk.
+    return false;
+  }
+  String resp((const char*)prof_response, response_len, CopyString);
+  return resp == s_ver_C_PROF_OK;
+#endif
+}
+
 int TakeoverAgent::setupFdServer(event_base *eventBase, int sock,
                                  Callback *callback) {
 #ifdef _MSC_VER
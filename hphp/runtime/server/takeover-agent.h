@@ -67,6 +67,14 @@ struct TakeoverAgent {
   // instruct the old server to shutdown
   void requestShutdown();
 
+  // Ask the old server (if any is listening on the transfer socket) to
+  // serialize its current jit profile to Eval.JitSerdesFile, so a
+  // taking-over process can deserialize it instead of starting with a
+  // cold or stale profile.  Returns true if the old server confirmed the
+  // file was written.
+  static bool requestProfile(const std::string& transferFname,
+                             std::chrono::seconds timeout);
+
   // setup a server to listen for takeover requests
   int setupFdServer(event_base *eventBase, int sock, Callback *callback);
 
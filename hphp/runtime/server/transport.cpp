@@ -195,7 +195,18 @@ void Transport::parsePostParams() {
       // Post data may be binary, but if parsePostParams() is called, any
       // wellformed data cannot have embedded NULs. If it does, we simply
       // truncate it.
-      m_postData = strndup(data, size);
+      if (hasMorePostData()) {
+        // The body spans multiple buffers; assemble it before parsing.
+        std::string body(data, size);
+        do {
+          size_t delta = 0;
+          auto const extra = (const char*)getMorePostData(delta);
+          if (delta) body.append(extra, delta);
+        } while (hasMorePostData());
+        m_postData = strndup(body.data(), body.size());
+      } else {
+        m_postData = strndup(data, size);
+      }
       parseQuery(m_postData, m_postParams);
     }
     m_postDataParsed = true;
@@ -850,7 +861,7 @@ void Transport::sendRawInternal(const char *data, int size,
 
   m_responseSize += response.size();
   ServerStats::SetThreadMode(ServerStats::ThreadMode::Writing);
-  sendImpl(response.data(), response.size(), m_responseCode, chunked, false);
+  sendResponse(std::move(response), m_responseCode, chunked, false);
   ServerStats::SetThreadMode(ServerStats::ThreadMode::Processing);
 
   ServerStats::LogBytes(size);
@@ -860,12 +871,30 @@ void Transport::sendRawInternal(const char *data, int size,
   }
 }
 
+void Transport::sendResponse(StringHolder&& response, int code, bool chunked,
+                             bool eom) {
+  if (supportsBufferedSendImpl()) {
+    // Hand the buffer itself to the transport; compressed output is
+    // malloc'd and owned by the holder, so this avoids re-copying it.
+    auto const size = response.size();
+    auto chunk = response.detach();
+    if (!chunk && size > 0) {
+      // The holder was only borrowing the data (e.g. compression
+      // disabled); it may not outlive the send, so copy after all.
+      chunk = folly::IOBuf::copyBuffer(response.data(), size);
+    }
+    sendBufferedImpl(std::move(chunk), code, chunked, eom);
+    return;
+  }
+  sendImpl(response.data(), response.size(), code, chunked, eom);
+}
+
 void Transport::onSendEnd() {
   bool eomSent = false;
   if (m_chunkedEncoding) {
     assertx(m_headerSent);
     StringHolder response = compressResponse("", 0, true);
-    sendImpl(response.data(), response.size(), m_responseCode, true, true);
+    sendResponse(std::move(response), m_responseCode, true, true);
     eomSent = true;
   } else if (!m_headerSent) {
     sendRawInternal("", 0);
@@ -950,6 +979,10 @@ StructuredLogEntry* Transport::createStructuredLogEntry() {
   return m_structLogEntry.get();
 }
 
+std::unique_ptr<StructuredLogEntry> Transport::releaseStructuredLogEntry() {
+  return std::move(m_structLogEntry);
+}
+
 StructuredLogEntry* Transport::getStructuredLogEntry() {
   return m_structLogEntry.get();
 }
@@ -132,6 +132,9 @@ public:
 
   StructuredLogEntry* createStructuredLogEntry();
   StructuredLogEntry* getStructuredLogEntry();
+  // Hand the entry off, e.g. to StructuredLog::logDeferred(); leaves the
+  // transport without an entry, as after resetStructuredLogEntry().
+  std::unique_ptr<StructuredLogEntry> releaseStructuredLogEntry();
   void resetStructuredLogEntry();
 
   ///////////////////////////////////////////////////////////////////////////
@@ -268,6 +271,19 @@ public:
   virtual void sendImpl(const void *data, int size, int code,
                         bool chunked, bool eom) = 0;
 
+  /**
+   * Subclasses that can take ownership of response buffers override
+   * this pair, letting sendRaw() hand off compressed output without the
+   * copy the (data, size) flavor requires.  chunk may be nullptr for a
+   * headers-only send.
+   */
+  virtual bool supportsBufferedSendImpl() const { return false; }
+  virtual void sendBufferedImpl(std::unique_ptr<folly::IOBuf> /*chunk*/,
+                                int /*code*/, bool /*chunked*/,
+                                bool /*eom*/) {
+    always_assert(false);
+  }
+
   /**
    * Override to implement more send end logic.
    */
@@ -519,6 +535,7 @@ protected:
 
 private:
   StringHolder compressResponse(const char *data, int size, bool last);
+  void sendResponse(StringHolder&& response, int code, bool chunked, bool eom);
   void prepareHeaders(bool precompressed, bool chunked,
     const StringHolder &response, const StringHolder& orig_response);
 };
@@ -18,6 +18,14 @@
 
 #include <stdexcept>
 
+#include <folly/Conv.h>
+#include <folly/String.h>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
 #include "hphp/runtime/base/comparisons.h"
 #include "hphp/runtime/base/config.h"
 #include "hphp/runtime/base/execution-context.h"
@@ -184,6 +192,36 @@ void VirtualHost::initRuntimeOption(const IniSetting::Map& ini, const Hdf& vh) {
   m_runtimeOption.maxPostSize = maxPostSize;
   m_runtimeOption.uploadMaxFileSize = uploadMaxFileSize;
   m_runtimeOption.serializationSizeLimit = serializationSizeLimit;
+  m_runtimeOption.maxWorkers =
+    Config::GetInt32(ini, vh, "overwrite.Server.MaxWorkers", -1, false);
+
+  // CPU list in the usual taskset format, e.g. "0-3,8,10-11".
+  auto const cpuSet =
+    Config::GetString(ini, vh, "overwrite.Server.CPUSet", "", false);
+  if (!cpuSet.empty()) {
+    std::vector<std::string> ranges;
+    folly::split(',', cpuSet, ranges, true);
+    for (auto const& range : ranges) {
+      int first = -1;
+      int last = -1;
+      auto const dash = range.find('-');
+      if (dash == std::string::npos) {
+        first = last = folly::tryTo<int>(range).value_or(-1);
+      } else {
+        first = folly::tryTo<int>(range.substr(0, dash)).value_or(-1);
+        last = folly::tryTo<int>(range.substr(dash + 1)).value_or(-1);
+      }
+      if (first < 0 || last < first) {
+        Logger::Warning("Malformed CPU set `%s' for virtual host %s",
+                        cpuSet.c_str(), m_name.c_str());
+        m_runtimeOption.workerCpus.clear();
+        break;
+      }
+      for (int cpu = first; cpu <= last; ++cpu) {
+        m_runtimeOption.workerCpus.push_back(cpu);
+      }
+    }
+  }
 
   m_documentRoot = RuntimeOption::SourceRoot + m_pathTranslation;
   if (m_documentRoot.length() > 1 &&
@@ -209,6 +247,61 @@ int VirtualHost::getRequestTimeoutSeconds(int defaultTimeout) const {
     defaultTimeout : m_runtimeOption.requestTimeoutSeconds;
 }
 
+bool VirtualHost::acquireWorker() const {
+  auto const limit = m_runtimeOption.maxWorkers;
+  if (limit < 0) return true;
+  auto cur = m_activeWorkers.load(std::memory_order_relaxed);
+  do {
+    if (cur >= limit) return false;
+  } while (!m_activeWorkers.compare_exchange_weak(cur, cur + 1,
+                                                  std::memory_order_relaxed));
+  return true;
+}
+
+void VirtualHost::releaseWorker() const {
+  if (m_runtimeOption.maxWorkers < 0) return;
+  m_activeWorkers.fetch_sub(1, std::memory_order_relaxed);
+}
+
+#ifdef __linux__
+namespace {
+// The affinity a worker thread had before a vhost pinned it, so
+// unpinWorker() can put it back.
+thread_local cpu_set_t t_savedAffinity;
+thread_local bool t_affinityPinned = false;
+}
+#endif
+
+bool VirtualHost::pinWorker() const {
+#ifdef __linux__
+  auto const& cpus = m_runtimeOption.workerCpus;
+  if (cpus.empty()) return false;
+  if (pthread_getaffinity_np(pthread_self(), sizeof(t_savedAffinity),
+                             &t_savedAffinity) != 0) {
+    return false;
+  }
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (auto const cpu : cpus) CPU_SET(cpu, &set);
+  if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0) {
+    return false;
+  }
+  t_affinityPinned = true;
+  return true;
+#else
+  return false;
+#endif
+}
+
+void VirtualHost::unpinWorker() {
+#ifdef __linux__
+  if (!t_affinityPinned) return;
+  pthread_setaffinity_np(pthread_self(), sizeof(t_savedAffinity),
+                         &t_savedAffinity);
+  t_affinityPinned = false;
+#endif
+}
+
 VirtualHost::VirtualHost() : m_disabled(false) {
   IniSetting::Map ini = IniSetting::Map::object;
   Hdf empty;
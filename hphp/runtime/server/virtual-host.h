@@ -17,6 +17,8 @@
 #ifndef incl_HPHP_VIRTUAL_HOST_H_
 #define incl_HPHP_VIRTUAL_HOST_H_
 
+#include <atomic>
+
 #include "hphp/util/hdf.h"
 #include "hphp/runtime/server/ip-block-map.h"
 #include "hphp/runtime/base/ini-setting.h"
@@ -49,6 +51,24 @@ public:
   int getRequestTimeoutSeconds(int defaultTimeout) const;
   int64_t getMaxPostSize() const;
 
+  /*
+   * Per-vhost worker quota.  acquireWorker() returns false when this
+   * vhost already has overwrite.Server.MaxWorkers requests executing;
+   * every successful acquire must be paired with releaseWorker().  A
+   * quota of -1 (the default) admits everything.
+   */
+  bool acquireWorker() const;
+  void releaseWorker() const;
+
+  /*
+   * Pin the calling worker thread to this vhost's CPU set
+   * (overwrite.Server.CPUSet) for the duration of a request.  Returns
+   * true iff the thread was pinned; unpinWorker() restores the thread's
+   * previous affinity and is a no-op if the thread isn't pinned.
+   */
+  bool pinWorker() const;
+  static void unpinWorker();
+
   const std::string &getName() const { return m_name;}
   const std::string &getPathTranslation() const { return m_pathTranslation;}
   const std::string &getDocumentRoot() const { return m_documentRoot;}
@@ -113,6 +133,8 @@ private:
     int64_t uploadMaxFileSize = -1;
     std::vector<std::string> allowedDirectories;
     int64_t serializationSizeLimit = StringData::MaxSize;
+    int maxWorkers = -1;           // max concurrent requests, -1 unlimited
+    std::vector<int> workerCpus;   // CPUs to pin workers to, empty disables
   };
 
   void initRuntimeOption(const IniSetting::Map& ini, const Hdf& overwrite);
@@ -134,6 +156,9 @@ private:
   std::vector<QueryStringFilter> m_queryStringFilters;
 
   VhostRuntimeOption m_runtimeOption;
+
+  // requests currently executing for this vhost, bounded by maxWorkers
+  mutable std::atomic<int> m_activeWorkers{0};
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -22,6 +22,7 @@
 #include "hphp/runtime/server/replay-transport.h"
 
 #include "hphp/util/boot-stats.h"
+#include "hphp/util/service-data.h"
 #include "hphp/util/timer.h"
 
 #include <folly/Range.h>
@@ -66,6 +67,20 @@ void WarmupRequestHandlerFactory::bumpReqCount() {
   // Bump the request count.  When we hit m_warmupReqThreshold,
   // add additional threads to the server.
   auto const oldReqNum = m_reqNumber.fetch_add(1, std::memory_order_relaxed);
+  auto const maturityThreshold = RuntimeOption::ServerReadyJitMaturityThreshold;
+  if (maturityThreshold > 0 && oldReqNum < m_warmupReqThreshold) {
+    // Code maturity can end the warmup period early: there is no point
+    // throttling the worker pool once enough optimized code has been
+    // emitted.
+    auto const maturity =
+      ServiceData::createCounter("jit.maturity")->getValue();
+    if (maturity >= maturityThreshold &&
+        !m_maturitySaturated.exchange(true, std::memory_order_relaxed)) {
+      Logger::FInfo("JIT maturity {} passed threshold {}; "
+                    "saturating worker threads", maturity, maturityThreshold);
+      m_server->saturateWorkers();
+    }
+  }
   if (oldReqNum != m_warmupReqThreshold) {
     return;
   }
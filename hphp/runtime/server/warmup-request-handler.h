@@ -66,6 +66,9 @@ struct WarmupRequestHandlerFactory
 
 private:
   std::atomic<uint32_t> m_reqNumber;
+  // Set once the worker pool has been saturated because JIT maturity
+  // crossed Server.ReadyJitMaturityThreshold before the request count did.
+  std::atomic<bool> m_maturitySaturated{false};
   uint32_t const m_warmupReqThreshold;
   int m_timeout;
   // The server owns this object so will by definition outlive us
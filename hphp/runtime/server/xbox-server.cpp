@@ -59,9 +59,13 @@ std::string XboxTransport::getHeader(const char *name) {
 
 void XboxTransport::sendImpl(const void* data, int size, int code,
                              bool /*chunked*/, bool eom) {
-  m_response.append((const char*)data, size);
-  if (code) {
-    m_code = code;
+  {
+    // The caller may be reading partial results concurrently
+    Lock lock(this);
+    m_response.append((const char*)data, size);
+    if (code) {
+      m_code = code;
+    }
   }
   if (eom) {
     onSendEndImpl();
@@ -103,6 +107,17 @@ String XboxTransport::getResults(int &code, int timeout_ms /* = 0 */) {
   return response;
 }
 
+String XboxTransport::getPartialResults(int64_t offset, bool &done, int &code) {
+  Lock lock(this);
+  done = m_done;
+  code = m_done ? m_code : 0;
+  if (offset < 0 || (size_t)offset >= m_response.size()) {
+    return empty_string();
+  }
+  return String(m_response.c_str() + offset, m_response.size() - offset,
+                CopyString);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 static THREAD_LOCAL(std::shared_ptr<XboxServerInfo>, s_xbox_server_info);
@@ -125,21 +140,25 @@ struct XboxWorker
 {
   virtual void doJob(XboxTransport *job) {
     try {
-      // If this job or the previous job that ran on this thread have
-      // a custom initial document, make sure we do a reset
+      // The request handler (and the warm request context it caches) is
+      // kept alive across jobs; tasks of the same type reuse it. If this
+      // job's initial document differs from the previous job's we force a
+      // reset so state from the old document doesn't leak into the new one.
       string reqInitDoc = job->getHeader("ReqInitDoc");
+      bool needReset = reqInitDoc != *s_xbox_prev_req_init_doc;
       *s_xbox_prev_req_init_doc = reqInitDoc;
 
       job->onRequestStart(job->getStartTimer());
-      createRequestHandler()->run(job);
-      destroyRequestHandler();
+      auto handler = createRequestHandler();
+      if (needReset) handler->setReset();
+      handler->run(job);
       job->decRefCount();
     } catch (...) {
       Logger::Error("RpcRequestHandler leaked exceptions");
     }
   }
 private:
-  RequestHandler *createRequestHandler() {
+  RPCRequestHandler *createRequestHandler() {
     if (!*s_xbox_server_info) {
       *s_xbox_server_info = std::make_shared<XboxServerInfo>();
     }
@@ -150,12 +169,6 @@ private:
     return s_xbox_request_handler.get();
   }
 
-  void destroyRequestHandler() {
-    if (!s_xbox_request_handler.isNull()) {
-      s_xbox_request_handler.destroy();
-    }
-  }
-
   virtual void onThreadExit() {
     if (!s_xbox_request_handler.isNull()) {
       s_xbox_request_handler.destroy();
@@ -180,6 +193,7 @@ void XboxServer::Restart() {
          RuntimeOption::ServerThreadDropCacheTimeoutSeconds,
          RuntimeOption::ServerThreadDropStack,
          nullptr);
+      s_dispatcher->setThreadGroup("xbox-worker");
     }
     if (RuntimeOption::XboxServerLogInfo) {
       Logger::Info("xbox server started");
@@ -465,6 +479,11 @@ int XboxServer::TaskResult(XboxTransport *job, int timeout_ms, Variant *ret) {
   return code;
 }
 
+String XboxServer::TaskPartialResult(const Resource& task, int64_t offset,
+                                     bool &done, int &code) {
+  return cast<XboxTask>(task)->getJob()->getPartialResults(offset, done, code);
+}
+
 std::shared_ptr<XboxServerInfo> XboxServer::GetServerInfo() {
   return *s_xbox_server_info;
 }
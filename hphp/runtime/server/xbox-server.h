@@ -60,6 +60,8 @@ public:
   static bool TaskStatus(const Resource& task);
   static int TaskResult(const Resource& task, int timeout_ms, Variant *ret);
   static int TaskResult(XboxTransport* const job, int timeout_ms, Variant *ret);
+  static String TaskPartialResult(const Resource& task, int64_t offset,
+                                  bool &done, int &code);
 
   /**
    * Gets the ServerInfo and RequestHandler for the current xbox worker thread.
@@ -150,6 +152,13 @@ struct XboxTransport final : Transport, Synchronizable {
   bool isDone() { return m_done; }
   String getResults(int &code, int timeout_ms = 0);
 
+  /**
+   * Get whatever response bytes the task has produced so far, starting at
+   * offset, without blocking for completion. done and code report whether
+   * the task has finished and, if so, its response code (0 otherwise).
+   */
+  String getPartialResults(int64_t offset, bool &done, int &code);
+
   void setHost(const std::string &host) { m_host = host;}
   void setAsioEvent(ServerTaskEvent<XboxServer, XboxTransport> *event) {
     m_event = event;
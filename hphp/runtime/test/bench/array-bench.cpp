@@ -0,0 +1,109 @@
+/*
+   +----------------------------------------------------------------------+
+   | HipHop for PHP                                                       |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 2010-present Facebook, Inc. (http://www.facebook.com)  |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 3.01 of the PHP license,      |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.php.net/license/3_01.txt                                  |
+   | If you did not receive a copy of the PHP license and are unable to   |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@php.net so we can mail you a copy immediately.               |
+   +----------------------------------------------------------------------+
+*/
+
+#include "hphp/runtime/test/bench/bench.h"
+
+#include "hphp/runtime/base/array-data.h"
+#include "hphp/runtime/base/array-init.h"
+#include "hphp/runtime/base/array-iterator.h"
+#include "hphp/runtime/base/static-string-table.h"
+#include "hphp/runtime/base/type-array.h"
+
+#include <string>
+#include <vector>
+
+namespace HPHP {
+///////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+constexpr int64_t kNumKeys = 1024;
+
+// Shared string keys, interned once so key creation stays out of the
+// measured region.
+StringData* stringKey(int64_t i) {
+  static std::vector<StringData*> keys = [] {
+    std::vector<StringData*> v;
+    for (int64_t k = 0; k < kNumKeys; ++k) {
+      v.push_back(makeStaticString("key" + std::to_string(k)));
+    }
+    return v;
+  }();
+  return keys[i];
+}
+
+Array makeIntKeyed() {
+  Array arr = Array::Create();
+  for (int64_t i = 0; i < kNumKeys; ++i) arr.set(i, i);
+  return arr;
+}
+
+Array makeStringKeyed() {
+  Array arr = Array::Create();
+  for (int64_t i = 0; i < kNumKeys; ++i) {
+    arr.set(String(stringKey(i)), i);
+  }
+  return arr;
+}
+
+}
+
+BENCHMARK(mixed_array_insert_int_keys) {
+  for (uint64_t i = 0; i < iters; ++i) {
+    auto const arr = makeIntKeyed();
+    bench::doNotOptimize(arr.size());
+  }
+}
+
+BENCHMARK(mixed_array_insert_string_keys) {
+  // Interning happens on the first call; population is the steady state.
+  stringKey(0);
+  for (uint64_t i = 0; i < iters; ++i) {
+    auto const arr = makeStringKeyed();
+    bench::doNotOptimize(arr.size());
+  }
+}
+
+BENCHMARK(mixed_array_lookup_int_keys) {
+  auto const arr = makeIntKeyed();
+  for (uint64_t i = 0; i < iters; ++i) {
+    auto const v = arr.rvalAt(int64_t(i % kNumKeys));
+    bench::doNotOptimize(v);
+  }
+}
+
+BENCHMARK(mixed_array_lookup_string_keys) {
+  auto const arr = makeStringKeyed();
+  for (uint64_t i = 0; i < iters; ++i) {
+    auto const v = arr.rvalAt(
+      String(stringKey(i % kNumKeys)));
+    bench::doNotOptimize(v);
+  }
+}
+
+BENCHMARK(mixed_array_iterate) {
+  auto const arr = makeIntKeyed();
+  for (uint64_t i = 0; i < iters; ++i) {
+    int64_t sum = 0;
+    IterateKVNoInc(arr.get(), [&] (Cell k, TypedValue v) {
+      sum += v.m_data.num;
+    });
+    bench::doNotOptimize(sum);
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+}
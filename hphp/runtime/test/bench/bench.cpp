@@ -0,0 +1,141 @@
+/*
+   +----------------------------------------------------------------------+
+   | HipHop for PHP                                                       |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 2010-present Facebook, Inc. (http://www.facebook.com)  |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 3.01 of the PHP license,      |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.php.net/license/3_01.txt                                  |
+   | If you did not receive a copy of the PHP license and are unable to   |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@php.net so we can mail you a copy immediately.               |
+   +----------------------------------------------------------------------+
+*/
+
+#include "hphp/runtime/test/bench/bench.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace HPHP { namespace bench {
+///////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+struct Benchmark {
+  const char* name;
+  BenchFn fn;
+};
+
+std::vector<Benchmark>& registry() {
+  // Function-local so registration from static initializers is safe
+  // regardless of link order.
+  static std::vector<Benchmark> benchmarks;
+  return benchmarks;
+}
+
+int64_t nowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+int64_t timeRun(BenchFn fn, uint64_t iters) {
+  auto const start = nowNs();
+  fn(iters);
+  return nowNs() - start;
+}
+
+// Run each benchmark long enough to be measurable, and repeat to shed
+// scheduler noise.
+constexpr int64_t kMinRunNs = 100 * 1000 * 1000;
+constexpr int kNumRuns = 3;
+
+struct Result {
+  const char* name;
+  uint64_t iters;
+  double nsPerIter;
+};
+
+Result run(const Benchmark& bench) {
+  // Double the iteration count until one run takes at least kMinRunNs.
+  uint64_t iters = 1;
+  auto elapsed = timeRun(bench.fn, iters);
+  while (elapsed < kMinRunNs) {
+    iters *= 2;
+    elapsed = timeRun(bench.fn, iters);
+  }
+
+  // Best-of-N: the minimum is the run with the least interference.
+  auto best = elapsed;
+  for (auto i = 1; i < kNumRuns; ++i) {
+    auto const t = timeRun(bench.fn, iters);
+    if (t < best) best = t;
+  }
+  return Result { bench.name, iters, double(best) / iters };
+}
+
+void writeJson(const char* path, const std::vector<Result>& results) {
+  auto const file = fopen(path, "w");
+  if (!file) {
+    fprintf(stderr, "bench: cannot open %s for writing\n", path);
+    return;
+  }
+  // One record per benchmark with a stable key order, so results from
+  // two commits diff cleanly.
+  fprintf(file, "{\"benchmarks\":[");
+  auto first = true;
+  for (auto const& r : results) {
+    fprintf(file, "%s\n  {\"name\":\"%s\",\"iters\":%llu,\"ns_per_iter\":%.3f}",
+            first ? "" : ",", r.name,
+            static_cast<unsigned long long>(r.iters), r.nsPerIter);
+    first = false;
+  }
+  fprintf(file, "\n]}\n");
+  fclose(file);
+}
+
+}
+
+Registrar::Registrar(const char* name, BenchFn fn) {
+  registry().push_back(Benchmark { name, fn });
+}
+
+int runBenchmarks(int argc, char** argv) {
+  std::string filter;
+  std::string jsonPath;
+  for (auto i = 1; i < argc; ++i) {
+    if (!strncmp(argv[i], "--bench_filter=", 15)) {
+      filter = argv[i] + 15;
+    } else if (!strncmp(argv[i], "--bench_json=", 13)) {
+      jsonPath = argv[i] + 13;
+    } else {
+      fprintf(stderr, "bench: unknown flag %s\n", argv[i]);
+      return 1;
+    }
+  }
+
+  std::vector<Result> results;
+  for (auto const& bench : registry()) {
+    if (!filter.empty() && !strstr(bench.name, filter.c_str())) continue;
+    auto const r = run(bench);
+    printf("%-48s %12.2f ns/iter %14.0f iters/s\n",
+           r.name, r.nsPerIter, 1e9 / r.nsPerIter);
+    fflush(stdout);
+    results.push_back(r);
+  }
+
+  if (results.empty()) {
+    fprintf(stderr, "bench: no benchmarks matched\n");
+    return 1;
+  }
+  if (!jsonPath.empty()) writeJson(jsonPath.c_str(), results);
+  return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+}}
@@ -0,0 +1,73 @@
+/*
+   +----------------------------------------------------------------------+
+   | HipHop for PHP                                                       |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 2010-present Facebook, Inc. (http://www.facebook.com)  |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 3.01 of the PHP license,      |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.php.net/license/3_01.txt                                  |
+   | If you did not receive a copy of the PHP license and are unable to   |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@php.net so we can mail you a copy immediately.               |
+   +----------------------------------------------------------------------+
+*/
+
+#ifndef incl_HPHP_RUNTIME_TEST_BENCH_H_
+#define incl_HPHP_RUNTIME_TEST_BENCH_H_
+
+#include <cstdint>
+
+namespace HPHP { namespace bench {
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+ * A minimal microbenchmark harness in the spirit of folly::Benchmark,
+ * for runtime primitives that need the full HHVM process (and a request
+ * context) around them.
+ *
+ * Each BENCHMARK body receives an iteration count and must perform the
+ * measured operation that many times.  The runner calibrates the count
+ * so each benchmark runs long enough to measure, takes the best of
+ * several runs to shed scheduler noise, and reports nanoseconds per
+ * iteration.
+ *
+ * hphp_runtime_bench flags:
+ *   --bench_filter=<substring>   only run benchmarks whose name matches
+ *   --bench_json=<path>          also write results as JSON, one record
+ *                                per benchmark, for A/B diffing between
+ *                                commits
+ */
+
+using BenchFn = void (*)(uint64_t iters);
+
+struct Registrar {
+  Registrar(const char* name, BenchFn fn);
+};
+
+/*
+ * Keep `value' (and everything it depends on) alive past the optimizer,
+ * without the cost of a store to a volatile.
+ */
+template<class T>
+inline void doNotOptimize(const T& value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/*
+ * Run every registered benchmark, honoring the flags above.  Returns a
+ * suitable exit status.
+ */
+int runBenchmarks(int argc, char** argv);
+
+///////////////////////////////////////////////////////////////////////////////
+}}
+
+#define BENCHMARK(name)                                       \
+  static void bench_impl_##name(uint64_t iters);              \
+  static ::HPHP::bench::Registrar                             \
+    s_bench_reg_##name(#name, bench_impl_##name);             \
+  static void bench_impl_##name(uint64_t iters)
+
+#endif
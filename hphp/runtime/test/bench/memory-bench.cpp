@@ -0,0 +1,69 @@
+/*
+   +----------------------------------------------------------------------+
+   | HipHop for PHP                                                       |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 2010-present Facebook, Inc. (http://www.facebook.com)  |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 3.01 of the PHP license,      |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.php.net/license/3_01.txt                                  |
+   | If you did not receive a copy of the PHP license and are unable to   |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@php.net so we can mail you a copy immediately.               |
+   +----------------------------------------------------------------------+
+*/
+
+#include "hphp/runtime/test/bench/bench.h"
+
+#include "hphp/runtime/base/memory-manager.h"
+
+namespace HPHP {
+///////////////////////////////////////////////////////////////////////////////
+
+BENCHMARK(mm_alloc_free_small) {
+  // LIFO small allocation: the size-class free-list fast path.
+  for (uint64_t i = 0; i < iters; ++i) {
+    auto const p = req::malloc_noptrs(64);
+    bench::doNotOptimize(p);
+    req::free(p);
+  }
+}
+
+BENCHMARK(mm_alloc_free_small_batched) {
+  // FIFO in batches: allocate a window before freeing any of it, the way
+  // request data structures usually behave.
+  constexpr int kBatch = 256;
+  void* ptrs[kBatch];
+  for (uint64_t i = 0; i < iters; ++i) {
+    for (auto j = 0; j < kBatch; ++j) {
+      ptrs[j] = req::malloc_noptrs(64);
+    }
+    for (auto j = 0; j < kBatch; ++j) {
+      req::free(ptrs[j]);
+    }
+  }
+}
+
+BENCHMARK(mm_alloc_free_mixed_sizes) {
+  // Walk the small size classes so no single free list stays hot.
+  static constexpr size_t kSizes[] = { 16, 32, 48, 64, 96, 128, 256, 1024 };
+  constexpr auto kNumSizes = sizeof(kSizes) / sizeof(kSizes[0]);
+  for (uint64_t i = 0; i < iters; ++i) {
+    auto const p = req::malloc_noptrs(kSizes[i % kNumSizes]);
+    bench::doNotOptimize(p);
+    req::free(p);
+  }
+}
+
+BENCHMARK(mm_alloc_free_big) {
+  // Past kMaxSmallSize the allocation goes to the big heap.
+  for (uint64_t i = 0; i < iters; ++i) {
+    auto const p = req::malloc_noptrs(kMaxSmallSize + 1);
+    bench::doNotOptimize(p);
+    req::free(p);
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+}
@@ -0,0 +1,78 @@
+/*
+   +----------------------------------------------------------------------+
+   | HipHop for PHP                                                       |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 2010-present Facebook, Inc. (http://www.facebook.com)  |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 3.01 of the PHP license,      |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.php.net/license/3_01.txt                                  |
+   | If you did not receive a copy of the PHP license and are unable to   |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@php.net so we can mail you a copy immediately.               |
+   +----------------------------------------------------------------------+
+*/
+
+#include "hphp/runtime/test/bench/bench.h"
+
+#include "hphp/runtime/base/array-init.h"
+#include "hphp/runtime/base/builtin-functions.h"
+#include "hphp/runtime/base/type-array.h"
+#include "hphp/runtime/base/type-string.h"
+#include "hphp/runtime/base/type-variant.h"
+#include "hphp/runtime/base/variable-serializer.h"
+#include "hphp/runtime/base/variable-unserializer.h"
+
+#include <string>
+
+namespace HPHP {
+///////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+// A shape typical of memcache/APC payloads: a map of scalars with a
+// nested list.
+Variant makePayload() {
+  Array inner = Array::Create();
+  for (int64_t i = 0; i < 64; ++i) inner.append(i);
+
+  Array arr = Array::Create();
+  arr.set(String("id"), 123456789);
+  arr.set(String("name"), String("some moderately long string value here"));
+  arr.set(String("score"), 3.14159);
+  arr.set(String("flag"), true);
+  arr.set(String("items"), inner);
+  return Variant(arr);
+}
+
+}
+
+BENCHMARK(serialize_array) {
+  auto const payload = makePayload();
+  for (uint64_t i = 0; i < iters; ++i) {
+    auto const s = f_serialize(payload);
+    bench::doNotOptimize(s.size());
+  }
+}
+
+BENCHMARK(unserialize_array) {
+  auto const serialized = f_serialize(makePayload());
+  for (uint64_t i = 0; i < iters; ++i) {
+    auto const v = unserialize_from_string(
+      serialized, VariableUnserializer::Type::Serialize);
+    bench::doNotOptimize(v.isArray());
+  }
+}
+
+BENCHMARK(serialize_roundtrip) {
+  auto const payload = makePayload();
+  for (uint64_t i = 0; i < iters; ++i) {
+    auto const v = unserialize_from_string(
+      f_serialize(payload), VariableUnserializer::Type::Serialize);
+    bench::doNotOptimize(v.isArray());
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+}
@@ -0,0 +1,74 @@
+/*
+   +----------------------------------------------------------------------+
+   | HipHop for PHP                                                       |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 2010-present Facebook, Inc. (http://www.facebook.com)  |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 3.01 of the PHP license,      |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.php.net/license/3_01.txt                                  |
+   | If you did not receive a copy of the PHP license and are unable to   |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@php.net so we can mail you a copy immediately.               |
+   +----------------------------------------------------------------------+
+*/
+
+#include "hphp/runtime/test/bench/bench.h"
+
+#include "hphp/runtime/base/static-string-table.h"
+#include "hphp/runtime/base/string-data.h"
+#include "hphp/runtime/base/type-string.h"
+#include "hphp/util/hash.h"
+
+#include <string>
+
+namespace HPHP {
+///////////////////////////////////////////////////////////////////////////////
+
+BENCHMARK(string_data_concat_small) {
+  auto const lhs = makeStaticString("hello, ");
+  auto const rhs = makeStaticString("world");
+  for (uint64_t i = 0; i < iters; ++i) {
+    auto const sd = StringData::Make(lhs, rhs);
+    bench::doNotOptimize(sd->size());
+    decRefStr(sd);
+  }
+}
+
+BENCHMARK(string_data_concat_large) {
+  String lhs(std::string(4096, 'a'));
+  String rhs(std::string(4096, 'b'));
+  for (uint64_t i = 0; i < iters; ++i) {
+    auto const sd = StringData::Make(lhs.get(), rhs.get());
+    bench::doNotOptimize(sd->size());
+    decRefStr(sd);
+  }
+}
+
+BENCHMARK(string_data_hash_cached) {
+  // Static strings hash once and cache the result; this is the path most
+  // runtime lookups see.
+  auto const sd = makeStaticString("SomeTypicalClassName");
+  sd->hash();
+  for (uint64_t i = 0; i < iters; ++i) {
+    bench::doNotOptimize(sd->hash());
+  }
+}
+
+BENCHMARK(string_hash_compute_short) {
+  constexpr char key[] = "SomeTypicalClassName";
+  for (uint64_t i = 0; i < iters; ++i) {
+    bench::doNotOptimize(hash_string_i(key, sizeof(key) - 1));
+  }
+}
+
+BENCHMARK(string_hash_compute_long) {
+  const std::string key(1024, 'x');
+  for (uint64_t i = 0; i < iters; ++i) {
+    bench::doNotOptimize(hash_string_i(key.data(), key.size()));
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+}
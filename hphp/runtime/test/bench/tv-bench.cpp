@@ -0,0 +1,80 @@
+/*
+   +----------------------------------------------------------------------+
+   | HipHop for PHP                                                       |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 2010-present Facebook, Inc. (http://www.facebook.com)  |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 3.01 of the PHP license,      |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.php.net/license/3_01.txt                                  |
+   | If you did not receive a copy of the PHP license and are unable to   |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@php.net so we can mail you a copy immediately.               |
+   +----------------------------------------------------------------------+
+*/
+
+#include "hphp/runtime/test/bench/bench.h"
+
+#include "hphp/runtime/base/static-string-table.h"
+#include "hphp/runtime/base/tv-comparisons.h"
+#include "hphp/runtime/base/typed-value.h"
+
+namespace HPHP {
+///////////////////////////////////////////////////////////////////////////////
+
+BENCHMARK(cell_compare_int_int) {
+  auto const lhs = make_tv<KindOfInt64>(42);
+  auto const rhs = make_tv<KindOfInt64>(43);
+  for (uint64_t i = 0; i < iters; ++i) {
+    bench::doNotOptimize(cellCompare(lhs, rhs));
+  }
+}
+
+BENCHMARK(cell_compare_int_double) {
+  // Mixed-type comparisons take the conversion path.
+  auto const lhs = make_tv<KindOfInt64>(42);
+  auto const rhs = make_tv<KindOfDouble>(42.5);
+  for (uint64_t i = 0; i < iters; ++i) {
+    bench::doNotOptimize(cellCompare(lhs, rhs));
+  }
+}
+
+BENCHMARK(cell_compare_str_str_same) {
+  auto const s = makeStaticString("a-moderately-long-string-value");
+  auto const lhs = make_tv<KindOfPersistentString>(s);
+  auto const rhs = make_tv<KindOfPersistentString>(s);
+  for (uint64_t i = 0; i < iters; ++i) {
+    bench::doNotOptimize(cellCompare(lhs, rhs));
+  }
+}
+
+BENCHMARK(cell_compare_str_str_distinct) {
+  auto const lhs = make_tv<KindOfPersistentString>(
+    makeStaticString("a-moderately-long-string-value"));
+  auto const rhs = make_tv<KindOfPersistentString>(
+    makeStaticString("a-moderately-long-string-walue"));
+  for (uint64_t i = 0; i < iters; ++i) {
+    bench::doNotOptimize(cellCompare(lhs, rhs));
+  }
+}
+
+BENCHMARK(cell_compare_str_int) {
+  // Numeric-string comparison crosses types and parses the string.
+  auto const lhs = make_tv<KindOfPersistentString>(makeStaticString("12345"));
+  auto const rhs = make_tv<KindOfInt64>(12345);
+  for (uint64_t i = 0; i < iters; ++i) {
+    bench::doNotOptimize(cellCompare(lhs, rhs));
+  }
+}
+
+BENCHMARK(tv_same_int_int) {
+  auto const lhs = make_tv<KindOfInt64>(42);
+  auto const rhs = make_tv<KindOfInt64>(42);
+  for (uint64_t i = 0; i < iters; ++i) {
+    bench::doNotOptimize(tvSame(lhs, rhs));
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+}
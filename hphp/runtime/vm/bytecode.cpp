@@ -17,6 +17,7 @@
 #include "hphp/runtime/vm/bytecode.h"
 
 #include <algorithm>
+#include <array>
 #include <string>
 #include <vector>
 #include <sstream>
@@ -2202,12 +2203,12 @@ template <typename F>
 ArrayData* newStructArrayImpl(imm_array<int32_t> ids, F f) {
   auto const n = ids.size;
   assertx(n > 0 && n <= ArrayData::MaxElemsOnStack);
-  req::vector<const StringData*> names;
-  names.reserve(n);
+  // The key count is bounded by MaxElemsOnStack, so gather the names into a
+  // C stack buffer rather than allocating a req::vector per execution.
+  std::array<const StringData*, ArrayData::MaxElemsOnStack> names;
   auto unit = vmfp()->m_func->unit();
   for (size_t i = 0; i < n; ++i) {
-    auto name = unit->lookupLitstrId(ids[i]);
-    names.push_back(name);
+    names[i] = unit->lookupLitstrId(ids[i]);
   }
 
   // This constructor moves values, no inc/decref is necessary.
@@ -7533,16 +7534,31 @@ TCA dispatchImpl() {
     optab = optabCover;
   }
   DEBUGGER_ATTACHED_ONLY(optab = optabDbg);
+  auto const prefetchHandlers = RuntimeOption::EvalInterpHandlerPrefetch;
 #endif
 
   bool isCtlFlow = false;
   TCA retAddr = nullptr;
   Op op;
+  Op prevOp = Op::Nop;
+  bool hasPrevOp = false;
 
 #ifdef _MSC_VER
 # define DISPATCH_ACTUAL() goto DispatchSwitch
+# define PREFETCH_NEXT_HANDLER(name) do {} while (0)
 #else
 # define DISPATCH_ACTUAL() goto *optab[size_t(op)]
+/*
+ * For instructions that fall through, peek at the next instruction's opcode
+ * and prefetch its handler while the current handler does its work, so the
+ * tail dispatch's indirect jump lands on warm code (see
+ * Eval.InterpHandlerPrefetch).
+ */
+# define PREFETCH_NEXT_HANDLER(name)                                    \
+    if (prefetchHandlers && !instrIsControlFlow(Op::name)) {            \
+      __builtin_prefetch(optab[size_t(peek_op(opPC + instrLen(opPC)))], \
+                         0, 3);                                         \
+    }
 #endif
 
 #define DISPATCH() do {                                                 \
@@ -7554,6 +7570,11 @@ TCA dispatchImpl() {
     }                                                                   \
     opPC = pc;                                                          \
     op = decode_op(pc);                                                 \
+    if (UNLIKELY(Stats::enableInstrPairCount())) {                      \
+      if (hasPrevOp) Stats::incInstrPair(prevOp, op);                   \
+      prevOp = op;                                                      \
+      hasPrevOp = true;                                                 \
+    }                                                                   \
     COND_STACKTRACE("dispatch:                    ");                   \
     FTRACE(1, "dispatch: {}: {}\n", pcOff(),                            \
            instrToString(opPC, vmfp()->m_func->unit()));                \
@@ -7577,6 +7598,7 @@ TCA dispatchImpl() {
     if (breakOnCtlFlow && Stats::enableInstrCount()) {        \
       Stats::inc(Stats::Instr_InterpBB##name);                \
     }                                                         \
+    PREFETCH_NEXT_HANDLER(name);                              \
     retAddr = iopWrap##name(pc);                              \
     vmpc() = pc;                                              \
     if (breakOnCtlFlow) {                                     \
@@ -7623,6 +7645,7 @@ DispatchSwitch:
 #undef O
 #undef DISPATCH
 #undef DISPATCH_ACTUAL
+#undef PREFETCH_NEXT_HANDLER
 #undef OPCODE_DBG_BODY
 #undef OPCODE_COVER_BODY
 #undef OPCODE_MAIN_BODY
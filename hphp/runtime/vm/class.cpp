@@ -3286,6 +3286,18 @@ void Class::setInterfaces() {
   checkInterfaceMethods();
 }
 
+/*
+ * Build this class's dense interface-method dispatch tables.
+ *
+ * In repo-authoritative builds HHBBC assigns every interface a global vtable
+ * slot (compute_iface_vtables() colors a conflict graph so that no two
+ * interfaces implemented by the same class share a slot, most-implemented
+ * first).  Each instantiable class then carries m_vtableVec, indexed by those
+ * slots, where each entry points at a flat Func* table indexed by the
+ * interface's method slot.  This is what makes interface calls cost two
+ * dependent loads in the JIT: InstanceOfIfaceVtable checks the slot and
+ * LdIfaceMethod fetches the Func, with no per-call lookupMethod() probe.
+ */
 void Class::setInterfaceVtables() {
   // We only need to set interface vtables for classes that can be instantiated
   // and implement more than 0 interfaces.
@@ -206,6 +206,14 @@ inline bool isDebuggerAttachedProcess() {
   return DebuggerHook::s_numAttached > 0;
 }
 
+// Zero cost when detached: until a hook attaches, translations contain no
+// debugger checks at all.  Attaching blacklists funcs with breakpoints for
+// retranslation and routes their existing SrcRecs through a debugger guard
+// (tc::addDbgGuards), so the runtime price of debugging is only ever paid
+// by processes a debugger has actually attached to.  Keep it that way: any
+// new hook check must either live behind a surprise flag or be materialized
+// in the TC on attach, never emitted up front.
+
 ////////////////////////////////////////////////////////////////////////////////
 // Hooks
 // Called by the VM at various points during program execution while
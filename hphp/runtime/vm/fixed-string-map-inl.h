@@ -58,6 +58,10 @@ void FixedStringMap<V,CaseSensitive,E>::init(int num, uint32_t numExtraBytes) {
     capac *= 2;
   }
   TRACE_MOD(Trace::runtime, 1, "FixedStringMap::init: %d -> %d\n", num, capac);
+#ifdef HHVM_TRACK_CONTAINER_STATS
+  ContainerStats::record("fixed_string_map.size", num);
+  ContainerStats::record("fixed_string_map.capacity", capac);
+#endif
   assertx(!m_table);
   auto const allocSize = capac * sizeof(Elm) + numExtraBytes;
   auto ptr = vm_malloc(allocSize);
@@ -88,6 +92,22 @@ template<class V, bool CaseSensitive, class E>
 NEVER_INLINE
 V* FixedStringMap<V,CaseSensitive,E>::find(const StringData* sd) const {
   Elm* elm = &m_table[-1 - int32_t(sd->hash() & m_mask)];
+#ifdef HHVM_TRACK_CONTAINER_STATS
+  unsigned numProbes = 0;
+  for(;;) {
+    ++numProbes;
+    assertx(numProbes <= m_mask + 1);
+    if (UNLIKELY(nullptr == elm->sd)) {
+      ContainerStats::record("fixed_string_map.probes", numProbes);
+      return nullptr;
+    }
+    if (FSM::strEqual<CaseSensitive>(elm->sd, sd)) {
+      ContainerStats::record("fixed_string_map.probes", numProbes);
+      return &elm->data;
+    }
+    if (UNLIKELY(++elm == m_table)) elm -= m_mask + 1;
+  }
+#else
   UNUSED unsigned numProbes = 0;
   for(;;) {
     assertx(numProbes++ < m_mask + 1);
@@ -95,6 +115,7 @@ V* FixedStringMap<V,CaseSensitive,E>::find(const StringData* sd) const {
     if (FSM::strEqual<CaseSensitive>(elm->sd, sd)) return &elm->data;
     if (UNLIKELY(++elm == m_table)) elm -= m_mask + 1;
   }
+#endif
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -26,6 +26,10 @@
 #include "hphp/util/functional.h"
 #include "hphp/util/hash-map.h"
 
+#ifdef HHVM_TRACK_CONTAINER_STATS
+#include "hphp/util/container-stats.h"
+#endif
+
 namespace HPHP {
 
 //////////////////////////////////////////////////////////////////////
@@ -22,6 +22,7 @@
 #include "hphp/runtime/base/execution-context.h"
 #include "hphp/runtime/base/init-fini-node.h"
 #include "hphp/runtime/base/intercept.h"
+#include "hphp/runtime/base/rds-util.h"
 #include "hphp/runtime/base/runtime-option.h"
 #include "hphp/runtime/base/static-string-table.h"
 #include "hphp/runtime/base/string-data.h"
@@ -141,6 +142,9 @@ void Func::destroy(Func* func) {
       jit::tc::reclaimFunction(func);
     }
 
+    // Recycle the RDS space for the func's static locals and memo caches.
+    rds::unbindFuncCaches(func);
+
     DEBUG_ONLY auto oldVal = s_funcVec.exchange(func->m_funcId, nullptr);
     assertx(oldVal == func);
     func->m_funcId = InvalidFuncId;
@@ -172,6 +176,8 @@ void Func::freeClone() {
   }
 
   if (m_funcId != InvalidFuncId) {
+    rds::unbindFuncCaches(this);
+
     DEBUG_ONLY auto oldVal = s_funcVec.exchange(m_funcId, nullptr);
     assertx(oldVal == this);
     m_funcId = InvalidFuncId;
@@ -170,8 +170,8 @@ void init() {
                   return a.second > b.second;
                 });
 
-      // Next, initialize s_instanceBitsMap with the top 127 most checked
-      // classes. Bit 0 is reserved as an 'initialized' flag
+      // Next, initialize s_instanceBitsMap with the top kNumInstanceBits - 1
+      // most checked classes. Bit 0 is reserved as an 'initialized' flag
       unsigned i = 1;
       uint64_t accum = 0;
       for (auto& item : counts) {
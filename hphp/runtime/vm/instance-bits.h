@@ -46,7 +46,13 @@ namespace HPHP { namespace InstanceBits {
 
 //////////////////////////////////////////////////////////////////////
 
-using BitSet = std::bitset<128>;
+/*
+ * The width of the per-Class bitmap. Widening it costs sizeof(BitSet) bytes
+ * per Class but lets more of the hot classes and interfaces from profiling be
+ * checked with a single test instruction; checks are emitted as a byte
+ * test via getMask(), so the width doesn't affect the generated code.
+ */
+using BitSet = std::bitset<256>;
 
 /*
  * Synchronization primitives used to atomically execute code relative to
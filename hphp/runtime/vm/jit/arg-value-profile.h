@@ -0,0 +1,99 @@
+/*
+   +----------------------------------------------------------------------+
+   | HipHop for PHP                                                       |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 2010-present Facebook, Inc. (http://www.facebook.com)  |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 3.01 of the PHP license,      |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.php.net/license/3_01.txt                                  |
+   | If you did not receive a copy of the PHP license and are unable to   |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@php.net so we can mail you a copy immediately.               |
+   +----------------------------------------------------------------------+
+*/
+
+#ifndef incl_HPHP_JIT_ARG_VALUE_PROFILE_H_
+#define incl_HPHP_JIT_ARG_VALUE_PROFILE_H_
+
+#include "hphp/runtime/base/datatype.h"
+#include "hphp/runtime/base/typed-value.h"
+
+#include "hphp/util/type-scan.h"
+
+#include <folly/Format.h>
+
+#include <string>
+
+namespace HPHP { namespace jit {
+
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+ * ArgValueProfile records whether a call argument is always the same literal
+ * value at a given callsite, so that optimized translations can propagate the
+ * constant into inlined callees (see Eval.JitSpecializeInlinedArgs).
+ *
+ * Only Bool and Int values are tracked, since those are the ones whose
+ * equality can be checked with a single compare; observing any other type, or
+ * more than one distinct value, makes the profile polymorphic.
+ */
+struct ArgValueProfile {
+  std::string toString() const {
+    if (!m_sampled) return "none";
+    if (m_polymorphic) return "polymorphic";
+    return folly::sformat("{}:{}", tname(m_type), m_value);
+  }
+
+  void report(TypedValue tv) {
+    if (m_polymorphic) return;
+    if (tv.m_type != KindOfBoolean && tv.m_type != KindOfInt64) {
+      m_polymorphic = true;
+      return;
+    }
+    if (!m_sampled) {
+      m_sampled = true;
+      m_type = tv.m_type;
+      m_value = tv.m_data.num;
+      return;
+    }
+    if (m_type != tv.m_type || m_value != tv.m_data.num) {
+      m_polymorphic = true;
+    }
+  }
+
+  static void reduce(ArgValueProfile& a, const ArgValueProfile& b) {
+    if (!b.m_sampled) return;
+    if (!a.m_sampled) {
+      a = b;
+      return;
+    }
+    if (b.m_polymorphic || a.m_type != b.m_type || a.m_value != b.m_value) {
+      a.m_polymorphic = true;
+    }
+  }
+
+  /*
+   * Whether every sample was the same value.
+   */
+  bool monomorphic() const { return m_sampled && !m_polymorphic; }
+
+  DataType type() const { return m_type; }
+  int64_t value() const { return m_value; }
+
+private:
+  int64_t m_value;
+  DataType m_type;
+  bool m_sampled;
+  bool m_polymorphic;
+
+  // In RDS, but can't contain pointers to request-allocated data.
+  TYPE_SCAN_IGNORE_ALL;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+}}
+
+#endif
@@ -52,6 +52,48 @@ InlineFrameVec s_inlineFrames{4096,IFrame{}};
 
 constexpr uint32_t kInvalidCatchTrace = 0x0;
 
+/*
+ * Small direct-mapped thread-local cache in front of `s_catchTraceMap'.  The
+ * unwinder probes the map once per TC frame it unwinds through, and the hot
+ * throw-catch paths keep asking about the same few call sites, so remember
+ * recent hits here before going to the shared TreadHashMap.
+ *
+ * Entries only change value when a catch trace is recorded over reused code or
+ * erased, so a global epoch, bumped on those writes, suffices to invalidate
+ * the per-thread caches.  Negative lookups are not cached: a later
+ * process_only() may insert a new entry without bumping the epoch.
+ */
+constexpr size_t kCatchCacheSize = 1024; // slots; must be a power of two
+constexpr uint32_t kNoCachedOffset = ~0u;
+
+struct CachedCatchTrace {
+  uint32_t offset;
+  uint32_t value;
+};
+
+std::atomic<uint64_t> s_catchCacheEpoch{1};
+__thread uint64_t tl_catchCacheEpoch;
+__thread CachedCatchTrace tl_catchCache[kCatchCacheSize];
+
+uint32_t* findCatchTraceEntry(uint32_t offset) {
+  auto const epoch = s_catchCacheEpoch.load(std::memory_order_acquire);
+  if (UNLIKELY(tl_catchCacheEpoch != epoch)) {
+    for (size_t i = 0; i < kCatchCacheSize; ++i) {
+      tl_catchCache[i].offset = kNoCachedOffset;
+    }
+    tl_catchCacheEpoch = epoch;
+  }
+
+  auto& slot = tl_catchCache[(offset >> 2) & (kCatchCacheSize - 1)];
+  if (slot.offset != offset) {
+    auto const found = s_catchTraceMap.find(offset);
+    if (!found) return nullptr;
+    slot.offset = offset;
+    slot.value = *found;
+  }
+  return &slot.value;
+}
+
 IFrameID insertFrames(const std::vector<IFrame>& frames) {
   auto const start = s_nextFrameKey.fetch_add(frames.size());
   s_inlineFrames.ensureSize(start + frames.size());
@@ -127,11 +169,12 @@ size_t numCatchTraces() {
 void eraseCatchTrace(CTCA addr) {
   if (auto ct = s_catchTraceMap.find(tc::addrToOffset(addr))) {
     *ct = kInvalidCatchTrace;
+    s_catchCacheEpoch.fetch_add(1, std::memory_order_release);
   }
 }
 
 folly::Optional<TCA> getCatchTrace(CTCA ip) {
-  auto const found = s_catchTraceMap.find(tc::addrToOffset(ip));
+  auto const found = findCatchTraceEntry(tc::addrToOffset(ip));
   if (found && *found != kInvalidCatchTrace) return tc::offsetToAddr(*found);
   return folly::none;
 }
@@ -200,15 +243,21 @@ void CGMeta::process_only(
   inlineFrames.clear();
   inlineStacks.clear();
 
+  auto overwroteCatch = false;
   for (auto const& ct : catches) {
     auto const key = tc::addrToOffset(ct.first);
     auto const val = tc::addrToOffset(ct.second);
     if (auto pos = s_catchTraceMap.find(key)) {
       *pos = val;
+      overwroteCatch = true;
     } else {
       s_catchTraceMap.insert(key, val);
     }
   }
+  if (overwroteCatch) {
+    // Flush the per-thread catch-trace caches, which may hold the old values.
+    s_catchCacheEpoch.fetch_add(1, std::memory_order_release);
+  }
   catches.clear();
 
   if (auto profData = jit::profData()) {
@@ -239,6 +288,28 @@ void CGMeta::process_only(
     Debug::DebugInfo::Get()->recordRelocMap(stub, nullptr, "NewStub");
   }
   reusedStubs.clear();
+
+  // Lazily-bound jumps were emitted against their target's anchor translation
+  // rather than a private bind stub (see Eval.JitLazyBindStubs), so register
+  // them as incoming branches here: translating the target will then smash
+  // them like any other chained jump.
+  for (auto const& pair : smashableJumpData) {
+    if (!pair.second.lazyBind) continue;
+    auto const sr = tc::findSrcRec(pair.second.sk);
+    always_assert(sr);
+    auto const srLock = sr->writelock();
+    switch (pair.second.kind) {
+      case JumpKind::Bindjmp:
+        sr->chainFrom(IncomingBranch::jmpFrom(pair.first));
+        break;
+      case JumpKind::Bindjcc:
+        sr->chainFrom(IncomingBranch::jccFrom(pair.first));
+        break;
+      case JumpKind::Fallback:
+      case JumpKind::Fallbackcc:
+        always_assert(false);
+    }
+  }
 }
 
 void CGMeta::clear() {
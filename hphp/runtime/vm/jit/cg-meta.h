@@ -179,6 +179,11 @@ struct CGMeta {
   struct JumpData {
     SrcKey   sk;
     JumpKind kind;
+    // The jump was emitted against its target's anchor translation instead
+    // of a private service-request stub (see Eval.JitLazyBindStubs), and
+    // still has to be registered as an incoming branch on the target's
+    // SrcRec when this metadata is published.
+    bool     lazyBind{false};
   };
   jit::fast_map<TCA,JumpData> smashableJumpData;
 
@@ -697,8 +697,11 @@ bool canDCE(IRInstruction* inst) {
   case EmptyElem:
   case ProfileArrayKind:
   case ProfileType:
+  case ProfileArgValue:
+  case ProfilePropClass:
   case ProfileFunc:
   case ProfileMethod:
+  case ProfileMethTargets:
   case ProfileSubClsCns:
   case CheckPackedArrayDataBounds:
   case LdVectorSize:
@@ -1684,8 +1684,11 @@ X(ProfileMixedArrayOffset,      RDSHandleData);
 X(ProfileDictOffset,            RDSHandleData);
 X(ProfileKeysetOffset,          RDSHandleData);
 X(ProfileType,                  RDSHandleData);
+X(ProfileArgValue,              RDSHandleData);
+X(ProfilePropClass,             RDSHandleData);
 X(ProfileFunc,                  ProfileCallTargetData);
 X(ProfileMethod,                ProfileCallTargetData);
+X(ProfileMethTargets,           ProfileCallTargetData);
 X(LdRDSAddr,                    RDSHandleData);
 X(CheckRDSInitialized,          RDSHandleData);
 X(MarkRDSInitialized,           RDSHandleData);
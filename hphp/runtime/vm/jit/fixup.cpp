@@ -73,6 +73,7 @@ struct IndirectFixup {
 };
 
 union FixupEntry {
+  FixupEntry() : firstElem(0) {}
   explicit FixupEntry(Fixup f) : fixup(f) {}
 
   /* Depends on the magic field in an IndirectFixup being -1. */
@@ -98,6 +99,60 @@ struct FixupHash {
 
 TreadHashMap<uint32_t,FixupEntry,FixupHash> s_fixups{kInitCapac};
 
+/*
+ * Two-level thread-local cache in front of `s_fixups'.  Unwinding and VM-regs
+ * sync do a fixup lookup for every native frame they walk, and the common
+ * single-frame throw-catch keeps looking up the same few return addresses, so
+ * we remember the most recent hit (L1) and a small direct-mapped table of
+ * recent ones (L2) before probing the shared TreadHashMap.
+ *
+ * recordFixup() only changes the value of an existing entry when a fixup is
+ * recorded over reused code, so a global epoch, bumped on those overwrites,
+ * suffices to invalidate the per-thread caches.
+ */
+constexpr size_t kFixupCacheSize = 2048; // slots; must be a power of two
+constexpr uint32_t kNoCachedOffset = ~0u;
+
+struct CachedFixup {
+  uint32_t offset;
+  FixupEntry ent;
+};
+
+std::atomic<uint64_t> s_fixupCacheEpoch{1};
+__thread uint64_t tl_fixupCacheEpoch;
+__thread CachedFixup tl_lastFixup;
+__thread CachedFixup* tl_fixupCache;
+
+FixupEntry* findFixupEntry(uint32_t offset) {
+  auto const epoch = s_fixupCacheEpoch.load(std::memory_order_acquire);
+  if (UNLIKELY(tl_fixupCacheEpoch != epoch)) {
+    if (!tl_fixupCache) {
+      tl_fixupCache = static_cast<CachedFixup*>(
+        malloc(kFixupCacheSize * sizeof(CachedFixup))
+      );
+    }
+    for (size_t i = 0; i < kFixupCacheSize; ++i) {
+      tl_fixupCache[i].offset = kNoCachedOffset;
+    }
+    tl_lastFixup.offset = kNoCachedOffset;
+    tl_fixupCacheEpoch = epoch;
+  }
+
+  if (tl_lastFixup.offset == offset) return &tl_lastFixup.ent;
+
+  auto& slot = tl_fixupCache[(offset >> 2) & (kFixupCacheSize - 1)];
+  if (slot.offset != offset) {
+    // Only positive lookups are cached: a miss may be filled in by a later
+    // recordFixup(), which doesn't bump the epoch for new entries.
+    auto const ent = s_fixups.find(offset);
+    if (!ent) return nullptr;
+    slot.offset = offset;
+    slot.ent = *ent;
+  }
+  tl_lastFixup = slot;
+  return &tl_lastFixup.ent;
+}
+
 PC pc(const ActRec* /*ar*/, const Func* f, const Fixup& fixup) {
   assertx(f);
   return f->getEntry() + fixup.pcOffset;
@@ -127,7 +182,7 @@ void regsFromActRec(TCA tca, const ActRec* ar, const Fixup& fixup,
 bool getFrameRegs(const ActRec* ar, VMRegs* outVMRegs) {
   TCA tca = (TCA)ar->m_savedRip;
 
-  auto ent = s_fixups.find(tc::addrToOffset(tca));
+  auto ent = findFixupEntry(tc::addrToOffset(tca));
   if (!ent) return false;
 
   // Note: If indirect fixups happen frequently enough, we could just compare
@@ -136,7 +191,7 @@ bool getFrameRegs(const ActRec* ar, VMRegs* outVMRegs) {
     auto savedRIPAddr = reinterpret_cast<uintptr_t>(ar) +
                         ent->indirect.returnIpDisp;
     tca = *reinterpret_cast<TCA*>(savedRIPAddr);
-    ent = s_fixups.find(tc::addrToOffset(tca));
+    ent = findFixupEntry(tc::addrToOffset(tca));
     assertx(ent && !ent->isIndirect());
   }
 
@@ -159,6 +214,9 @@ void recordFixup(CTCA tca, const Fixup& fixup) {
   auto const offset = tc::addrToOffset(tca);
   if (auto pos = s_fixups.find(offset)) {
     *pos = FixupEntry(fixup);
+    // The address was previously recorded, so the per-thread fixup caches may
+    // hold the old entry; invalidate them.
+    s_fixupCacheEpoch.fetch_add(1, std::memory_order_release);
   } else {
     s_fixups.insert(offset, FixupEntry(fixup));
   }
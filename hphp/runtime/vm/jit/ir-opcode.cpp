@@ -962,12 +962,15 @@ bool opcodeMayRaise(Opcode opc) {
   case OrInt:
   case PackMagicArgs:
   case PairIsset:
+  case ProfileArgValue:
   case ProfileArrayKind:
   case ProfileDictOffset:
   case ProfileInstanceCheck:
   case ProfileKeysetOffset:
   case ProfileFunc:
   case ProfileMethod:
+  case ProfileMethTargets:
+  case ProfilePropClass:
   case ProfileMixedArrayOffset:
   case ProfileSubClsCns:
   case ProfileSwitchDest:
@@ -19,6 +19,7 @@
 #include "hphp/runtime/base/collections.h"
 #include "hphp/runtime/base/externals.h"
 #include "hphp/runtime/base/file-util.h"
+#include "hphp/runtime/base/rds-util.h"
 #include "hphp/runtime/base/tv-refcount.h"
 #include "hphp/runtime/vm/repo.h"
 #include "hphp/runtime/vm/repo-global-data.h"
@@ -2434,14 +2435,54 @@ void emitMemoGet(IRGS& env, Offset relOffset, LocalRange keys) {
 
     /* Static (non-LSB) Memoization */
     if (keys.count > 0) {
-      return gen(
-        env,
-        MemoGetStaticCache,
-        MemoCacheStaticData { func, keys, types.data() },
-        taken,
-        retTy,
-        fp(env)
-      );
+      auto const getShared = [&] {
+        return gen(
+          env,
+          MemoGetStaticCache,
+          MemoCacheStaticData { func, keys, types.data() },
+          taken,
+          retTy,
+          fp(env)
+        );
+      };
+
+      /*
+       * With a single int key, consult the inline single-entry cache first:
+       * an init check and a key compare against the slot, falling back to
+       * the shared cache's hashed lookup on a mismatch.  The slot is kept up
+       * to date by emitMemoSet(), so an entry it holds always agrees with
+       * the shared cache.
+       */
+      if (RuntimeOption::EvalJitMemoInlineCache &&
+          keys.count == 1 && !types[0]) {
+        auto const link = rds::bindStaticMemoInlineCache(func);
+        auto const keyData = RDSHandleData { link.handle() };
+        auto const valData = RDSHandleData {
+          safe_cast<rds::Handle>(
+            link.handle() + rds::MemoInlineCache::value_offset()
+          )
+        };
+        auto const key = ldLoc(env, keys.first, nullptr, DataTypeSpecific);
+        return cond(
+          env,
+          [&] (Block* miss) {
+            gen(env, CheckRDSInitialized, miss, keyData);
+            auto const keyAddr =
+              gen(env, LdRDSAddr, keyData, TInt.ptr(Ptr::Other));
+            auto const cached = gen(env, LdMem, TInt, keyAddr);
+            auto const eq = gen(env, EqInt, cached, key);
+            gen(env, JmpZero, miss, eq);
+          },
+          [&] {
+            auto const valAddr =
+              gen(env, LdRDSAddr, valData, retTy.ptr(Ptr::Other));
+            return gen(env, LdMem, retTy, valAddr);
+          },
+          getShared
+        );
+      }
+
+      return getShared();
     }
     return gen(
       env,
@@ -2544,13 +2585,36 @@ void emitMemoSet(IRGS& env, LocalRange keys) {
   }
 
   if (keys.count > 0) {
+    auto const val = ldVal(DataTypeGeneric);
     gen(
       env,
       MemoSetStaticCache,
       MemoCacheStaticData { func, keys, types.data() },
       fp(env),
-      ldVal(DataTypeGeneric)
+      val
     );
+    /*
+     * Refresh the inline single-entry cache checked by emitMemoGet().  This
+     * must come after the shared-cache set: the slot only borrows the value,
+     * whose reference is owned by the shared cache.
+     */
+    if (RuntimeOption::EvalJitMemoInlineCache &&
+        keys.count == 1 && !types[0]) {
+      auto const link = rds::bindStaticMemoInlineCache(func);
+      auto const keyData = RDSHandleData { link.handle() };
+      auto const valData = RDSHandleData {
+        safe_cast<rds::Handle>(
+          link.handle() + rds::MemoInlineCache::value_offset()
+        )
+      };
+      auto const key = ldLoc(env, keys.first, nullptr, DataTypeSpecific);
+      auto const keyAddr = gen(env, LdRDSAddr, keyData, TInt.ptr(Ptr::Other));
+      gen(env, StMem, keyAddr, key);
+      auto const valAddr =
+        gen(env, LdRDSAddr, valData, TInitCell.ptr(Ptr::Other));
+      gen(env, StMem, valAddr, val);
+      gen(env, MarkRDSInitialized, keyData);
+    }
     return;
   }
 
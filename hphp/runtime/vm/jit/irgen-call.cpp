@@ -19,9 +19,11 @@
 #include "hphp/runtime/vm/reified-generics.h"
 #include "hphp/runtime/vm/runtime.h"
 
+#include "hphp/runtime/vm/jit/arg-value-profile.h"
 #include "hphp/runtime/vm/jit/call-target-profile.h"
 #include "hphp/runtime/vm/jit/guard-constraint.h"
 #include "hphp/runtime/vm/jit/meth-profile.h"
+#include "hphp/runtime/vm/jit/meth-target-profile.h"
 #include "hphp/runtime/vm/jit/normalized-instruction.h"
 #include "hphp/runtime/vm/jit/target-profile.h"
 #include "hphp/runtime/vm/jit/type.h"
@@ -450,6 +452,82 @@ bool optimizeProfiledPushMethod(IRGS& env,
   return false;
 }
 
+const StaticString methTargetProfileKey{ "MethTargetProfile-FPushObjMethod" };
+
+/*
+ * Emit a short chain of exact class checks covering the receivers seen while
+ * profiling, dispatching to each one's resolved method, in the style of a
+ * polymorphic inline cache.  Receivers that fall off the end of the chain
+ * side-exit.
+ *
+ * This only kicks in when optimizeProfiledPushMethod() failed, i.e. when the
+ * site is polymorphic and its targets don't share a base or interface
+ * method.  Sites whose profiled receivers don't cover at least
+ * Eval.JitPGOPolyMethodThreshold percent of the calls are considered
+ * megamorphic and left to generic dispatch.
+ */
+bool optimizePolyProfiledPushMethod(IRGS& env,
+                                    TargetProfile<MethTargetProfile>& profile,
+                                    SSATmp* obj,
+                                    Block* sideExit,
+                                    const StringData* methodName,
+                                    uint32_t numParams,
+                                    bool dynamic) {
+  assertx(obj->type() <= TObj);
+  if (!profile.optimizing()) return false;
+  if (env.transFlags.noProfiledFPush && env.firstBcInst) return false;
+
+  auto choices = profile.data().choose();
+
+  // Drop targets the chain can't dispatch to directly: magic calls (the
+  // invName in the ActRec would differ per class) and static methods (the
+  // context would).
+  choices.erase(
+    std::remove_if(
+      choices.begin(), choices.end(),
+      [&] (const MethTargetProfile::Choice& choice) {
+        return choice.meth->isStatic() ||
+               !choice.meth->name()->isame(methodName);
+      }),
+    choices.end()
+  );
+
+  // Monomorphic sites are better served by optimizeProfiledPushMethod().
+  if (choices.size() < 2) return false;
+
+  double coverage = 0;
+  for (auto const& choice : choices) coverage += choice.probability;
+  if (coverage * 100 < RuntimeOption::EvalJitPGOPolyMethodThreshold) {
+    return false;
+  }
+
+  // Emit the checks most-frequent first, with the last one falling through
+  // to the side exit, and join the matched methods with a phi.
+  auto const emitChain = [&] (auto const& self, size_t i) -> SSATmp* {
+    auto const& choice = choices[i];
+    if (i == choices.size() - 1) {
+      auto const refined = gen(env, CheckType, Type::ExactObj(choice.cls),
+                               sideExit, obj);
+      env.irb->constrainValue(refined, GuardConstraint(choice.cls));
+      return cns(env, choice.meth);
+    }
+    return cond(
+      env,
+      [&] (Block* taken) {
+        auto const refined = gen(env, CheckType, Type::ExactObj(choice.cls),
+                                 taken, obj);
+        env.irb->constrainValue(refined, GuardConstraint(choice.cls));
+      },
+      [&] { return cns(env, choice.meth); },
+      [&] { return self(self, i + 1); }
+    );
+  };
+
+  auto const meth = emitChain(emitChain, 0);
+  fpushActRec(env, meth, obj, numParams, nullptr, cns(env, dynamic));
+  return true;
+}
+
 void fpushObjMethod(IRGS& env,
                     SSATmp* obj,
                     const StringData* methodName,
@@ -478,14 +556,21 @@ void fpushObjMethod(IRGS& env,
   const bool usePGO = !knownClass || isInterface(knownClass);
 
   folly::Optional<TargetProfile<MethProfile>> profile;
+  folly::Optional<TargetProfile<MethTargetProfile>> targetProfile;
   if (usePGO && RuntimeOption::RepoAuthoritative) {
     profile.emplace(env.context, env.irb->curMarker(), methProfileKey.get());
+    targetProfile.emplace(env.context, env.irb->curMarker(),
+                          methTargetProfileKey.get());
 
     // If we know the class exactly without profiling, then we don't need PGO.
     if (optimizeProfiledPushMethod(env, *profile, obj, knownClass, sideExit,
                                    methodName, numParams, false)) {
       return;
     }
+    if (optimizePolyProfiledPushMethod(env, *targetProfile, obj, sideExit,
+                                       methodName, numParams, false)) {
+      return;
+    }
   }
 
   fpushObjMethodWithBaseClass(env, obj, knownClass, methodName, numParams,
@@ -500,10 +585,47 @@ void fpushObjMethod(IRGS& env,
         sp(env),
         cns(env, TNullptr));
   }
+  if (targetProfile && targetProfile->profiling()) {
+    gen(env,
+        ProfileMethTargets,
+        ProfileCallTargetData {
+          spOffBCFromIRSP(env), targetProfile->handle()
+        },
+        sp(env),
+        cns(env, TNullptr));
+  }
 }
 
 const StaticString s_funcProfileKey{"FuncProfile"};
 
+/*
+ * Profile key for the value of call argument `argIdx' at the current
+ * callsite.
+ */
+const StringData* callArgValueProfileKey(uint32_t argIdx) {
+  return makeStaticString(folly::sformat("CallArgValue{}", argIdx));
+}
+
+/*
+ * In profiling translations, record the values of the first
+ * Eval.JitSpecializeInlinedArgs arguments, which are still on the eval stack.
+ * specializeCallArgValue() consumes the profiles when the callee is inlined.
+ */
+void profileCallArgValues(IRGS& env, uint32_t numArgs) {
+  auto const numProf =
+    std::min<uint32_t>(numArgs, RuntimeOption::EvalJitSpecializeInlinedArgs);
+
+  for (uint32_t i = 0; i < numProf; ++i) {
+    TargetProfile<ArgValueProfile> profile(env.context, env.irb->curMarker(),
+                                           callArgValueProfileKey(i));
+    if (!profile.profiling()) return;
+
+    auto const off = BCSPRelOffset{safe_cast<int32_t>(numArgs - 1 - i)};
+    auto const arg = topF(env, off, DataTypeGeneric);
+    gen(env, ProfileArgValue, RDSHandleData{profile.handle()}, arg);
+  }
+}
+
 void profilePushedFunc(IRGS& env, TargetProfile<CallTargetProfile>& profile) {
   gen(env, ProfileFunc,
       ProfileCallTargetData{spOffBCFromIRSP(env), profile.handle()},
@@ -1645,6 +1767,34 @@ void emitCallerDynamicCallChecks(IRGS& env,
 
 //////////////////////////////////////////////////////////////////////
 
+SSATmp* specializeCallArgValue(IRGS& env, uint32_t argIdx, uint32_t numArgs) {
+  if (argIdx >= RuntimeOption::EvalJitSpecializeInlinedArgs) return nullptr;
+
+  TargetProfile<ArgValueProfile> profile(env.context, env.irb->curMarker(),
+                                         callArgValueProfileKey(argIdx));
+  if (!profile.optimizing()) return nullptr;
+
+  auto const data = profile.data();
+  if (!data.monomorphic()) return nullptr;
+
+  auto const off = BCSPRelOffset{safe_cast<int32_t>(numArgs - 1 - argIdx)};
+  auto const arg = topF(env, off, DataTypeGeneric);
+  if (arg->hasConstVal()) return nullptr;
+
+  auto const type = data.type() == KindOfBoolean ? TBool : TInt;
+  if (!arg->type().maybe(type)) return nullptr;
+
+  auto const exit = makeExit(env);
+  auto const refined = gen(env, CheckType, type, exit, arg);
+  auto const expected = type <= TBool
+    ? cns(env, data.value() != 0)
+    : cns(env, data.value());
+  auto const equal = gen(env, type <= TBool ? EqBool : EqInt,
+                         refined, expected);
+  gen(env, JmpZero, exit, equal);
+  return expected;
+}
+
 void emitFCall(IRGS& env,
                FCallArgs fca,
                const StringData*,
@@ -1676,6 +1826,8 @@ void emitFCall(IRGS& env,
     return;
   }
 
+  profileCallArgValues(env, fca.numArgs);
+
   auto const needsCallerFrame = callee
     ? funcNeedsCallerFrame(callee)
     : callNeedsCallerFrame(
@@ -51,6 +51,18 @@ void emitCallerDynamicCallChecks(IRGS& env,
 Type callReturnType(const Func* callee);
 Type awaitedCallReturnType(const Func* callee);
 
+/*
+ * If value profiling showed that this callsite always passes the same Bool or
+ * Int literal for argument `argIdx' (see Eval.JitSpecializeInlinedArgs),
+ * guard on that value---side-exiting to the current instruction on
+ * failure---and return it as a constant.  Returns nullptr when the argument
+ * wasn't profiled, isn't monomorphic, or is already a constant.
+ *
+ * Must be called while the arguments are still on the eval stack; argument
+ * `argIdx' of `numArgs' is expected at stack offset numArgs - 1 - argIdx.
+ */
+SSATmp* specializeCallArgValue(IRGS& env, uint32_t argIdx, uint32_t numArgs);
+
 //////////////////////////////////////////////////////////////////////
 
 }}}
@@ -401,6 +401,53 @@ StackCheck stack_check_kind(const Func* func, uint32_t argc) {
     : StackCheck::Early;
 }
 
+/*
+ * Return true if we can skip the surprise-flag check on entry to `func'.
+ *
+ * A function qualifies when its bytecode is short, makes no calls, and has
+ * no backward control flow: such a function runs for a bounded amount of
+ * time, so any pending surprise is still delivered promptly at one of the
+ * caller's own checks (every backward branch and every other prologue
+ * checks the flags).  Note that functions compiled this way never fire
+ * function-entry surprise hooks, which is why this is off by default.
+ */
+bool elideEntrySurpriseCheck(const Func* func) {
+  auto const maxSize = RuntimeOption::EvalJitLeafSurpriseCheckMaxSize;
+  if (maxSize == 0) return false;
+  if (func->isAsync() || func->isGenerator() || func->isPseudoMain()) {
+    return false;
+  }
+
+  auto const unit = func->unit();
+  auto const base = func->base();
+  auto const past = func->past();
+  if (uint32_t(past - base) > maxSize) return false;
+
+  for (auto off = base; off < past; ) {
+    auto const pc = unit->at(off);
+    auto const op = peek_op(pc);
+
+    // Calls of any kind can run for an unbounded amount of time (callee
+    // prologues check the flags themselves, but C++ builtins don't).
+    if (isFPush(op) || isFCallStar(op) ||
+        op == Op::FCallBuiltin || op == Op::NativeImpl ||
+        op == Op::ContEnter || op == Op::ContRaise ||
+        op == Op::Incl || op == Op::InclOnce ||
+        op == Op::Req || op == Op::ReqOnce || op == Op::ReqDoc ||
+        op == Op::Eval) {
+      return false;
+    }
+
+    // Any backward edge could form a loop that never checks the flags.
+    for (auto const succ : instrSuccOffsets(pc, func)) {
+      if (succ <= off) return false;
+    }
+
+    off += instrLen(pc);
+  }
+  return true;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 void emitPrologueEntry(IRGS& env, uint32_t argc) {
@@ -451,7 +498,7 @@ void emitPrologueBody(IRGS& env, uint32_t argc, TransID transID) {
   env.irb->exceptionStackBoundary();
   if (stack_check_kind(func, argc) == StackCheck::Combine) {
     gen(env, CheckSurpriseAndStack, FuncEntryData { func, argc }, fp(env));
-  } else {
+  } else if (!elideEntrySurpriseCheck(func)) {
     gen(env, CheckSurpriseFlagsEnter, FuncEntryData { func, argc }, fp(env));
   }
 
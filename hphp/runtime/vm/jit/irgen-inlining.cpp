@@ -306,10 +306,25 @@ bool beginInlining(IRGS& env,
   // will be a TCtx (= TObj | TCctx) read from the stack
   assertx(!ctx || (ctx->type() <= (TCtx | TCls) && target->implCls()));
 
+  // If value profiling showed that this callsite always passes the same
+  // literal for one of the leading arguments, guard on it now, while the
+  // arguments are still on the stack and we can still side-exit, and
+  // substitute the constant for the popped value below so that branches on
+  // the parameter fold away in the inlined body.
+  jit::vector<SSATmp*> constParams{numParams};
+  if (!conjure && RuntimeOption::EvalJitSpecializeInlinedArgs > 0) {
+    for (unsigned i = 0; i < numParams; ++i) {
+      constParams[i] = specializeCallArgValue(env, i, numParams);
+    }
+  }
+
   jit::vector<SSATmp*> params{numParams};
   for (unsigned i = 0; i < numParams; ++i) {
     params[numParams - i - 1] = popF(env);
   }
+  for (unsigned i = 0; i < numParams; ++i) {
+    if (constParams[i]) params[i] = constParams[i];
+  }
 
   // NB: Now that we've popped the callee's arguments off the stack
   // and thus modified the caller's frame state, we're committed to
@@ -27,6 +27,7 @@
 #include "hphp/runtime/vm/jit/guard-constraint.h"
 #include "hphp/runtime/vm/jit/normalized-instruction.h"
 #include "hphp/runtime/vm/jit/minstr-effects.h"
+#include "hphp/runtime/vm/jit/prop-class-profile.h"
 #include "hphp/runtime/vm/jit/target-profile.h"
 #include "hphp/runtime/vm/jit/type-array-elem.h"
 #include "hphp/runtime/vm/jit/type.h"
@@ -1381,6 +1382,64 @@ SSATmp* propGenericImpl(IRGS& env, MOpMode mode, SSATmp* base, SSATmp* key,
       : gen(env, PropX, modeData, base, key, tvRef);
 }
 
+/*
+ * Try to specialize an otherwise-generic property access on the dominant base
+ * class observed during profiling (see Eval.JitPGOPropSlotMinPercent).  The
+ * predicted class is checked inline, with the fully generic access as the
+ * fallback, so stable-but-unknown sites resolve their slot at JIT time.
+ *
+ * Returns nullptr if the site can't use a prediction, in which case the
+ * caller emits the generic access as usual.
+ */
+SSATmp* propProfiledImpl(IRGS& env, MOpMode mode, SSATmp* base,
+                         SSATmp* key, bool nullsafe) {
+  auto const minPercent = RuntimeOption::EvalJitPGOPropSlotMinPercent;
+  if (!minPercent) return nullptr;
+  // Only plain reads for now: define and unset need the base object for
+  // prop-state tracking, and the generic path handles their promotion rules.
+  if (mode != MOpMode::None && mode != MOpMode::Warn) return nullptr;
+  if (!base->isA(TObj)) return nullptr;
+  if (!key->hasConstVal(TStaticStr)) return nullptr;
+
+  static const StaticString s_PropClassProfile{"PropClassProfile"};
+  TargetProfile<PropClassProfile> prof(env.context, env.irb->curMarker(),
+                                       s_PropClassProfile.get());
+  if (prof.profiling()) {
+    gen(env, ProfilePropClass, RDSHandleData { prof.handle() },
+        gen(env, LdObjClass, base));
+    return nullptr;
+  }
+  if (!prof.optimizing()) return nullptr;
+
+  auto const cls = prof.data().predictedClass(minPercent);
+  if (!cls) return nullptr;
+
+  // Resolve the slot against the predicted class the same way the known-class
+  // path does; bail if the prediction doesn't give a clean declared-property
+  // access.
+  auto const propInfo = getPropertyOffset(env, cls, key->type(), false);
+  if (propInfo.offset == -1 ||
+      propInfo.immutable ||
+      mightCallMagicPropMethod(mode, propInfo)) {
+    return nullptr;
+  }
+
+  return cond(
+    env,
+    [&] (Block* taken) {
+      return gen(env, CheckType, Type::ExactObj(cls), taken, base);
+    },
+    [&] (SSATmp* obj) {
+      return emitPropSpecialized(env, obj, key, nullsafe, mode,
+                                 propInfo).first;
+    },
+    [&] {
+      hint(env, Block::Hint::Unlikely);
+      return propGenericImpl(env, mode, base, key, nullsafe);
+    }
+  );
+}
+
 SSATmp* propImpl(IRGS& env, MOpMode mode, SSATmp* key, bool nullsafe) {
   auto const baseType = predictedBaseType(env);
 
@@ -1397,6 +1456,9 @@ SSATmp* propImpl(IRGS& env, MOpMode mode, SSATmp* key, bool nullsafe) {
       propInfo.immutable ||
       mode == MOpMode::Unset ||
       mightCallMagicPropMethod(mode, propInfo)) {
+    if (auto const prop = propProfiledImpl(env, mode, base, key, nullsafe)) {
+      return prop;
+    }
     return propGenericImpl(env, mode, base, key, nullsafe);
   }
 
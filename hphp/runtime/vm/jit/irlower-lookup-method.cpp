@@ -38,6 +38,7 @@
 #include "hphp/runtime/vm/jit/ir-instruction.h"
 #include "hphp/runtime/vm/jit/ir-opcode.h"
 #include "hphp/runtime/vm/jit/meth-profile.h"
+#include "hphp/runtime/vm/jit/meth-target-profile.h"
 #include "hphp/runtime/vm/jit/ssa-tmp.h"
 #include "hphp/runtime/vm/jit/target-cache.h"
 #include "hphp/runtime/vm/jit/translator-inline.h"
@@ -209,6 +210,19 @@ void cgProfileMethod(IRLS& env, const IRInstruction* inst) {
                kVoidDest, SyncOptions::None, args);
 }
 
+void cgProfileMethTargets(IRLS& env, const IRInstruction* inst) {
+  auto const extra = inst->extra<ProfileCallTargetData>();
+  auto const sp = srcLoc(env, inst, 0).reg();
+
+  auto const args = argGroup(env, inst)
+    .addr(rvmtl(), safe_cast<int32_t>(extra->handle))
+    .addr(sp, cellsToBytes(extra->bcSPOff.offset))
+    .ssa(1);
+
+  cgCallHelper(vmain(env), env, CallSpec::method(&MethTargetProfile::report),
+               kVoidDest, SyncOptions::None, args);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 namespace {
@@ -34,6 +34,7 @@
 #include "hphp/runtime/vm/jit/code-gen-internal.h"
 #include "hphp/runtime/vm/jit/ir-instruction.h"
 #include "hphp/runtime/vm/jit/minstr-helpers.h"
+#include "hphp/runtime/vm/jit/prop-class-profile.h"
 #include "hphp/runtime/vm/jit/translator-inline.h"
 #include "hphp/runtime/vm/jit/translator-runtime.h"
 
@@ -133,6 +134,21 @@ void implIssetEmptyProp(IRLS& env, const IRInstruction* inst) {
 void cgPropX(IRLS& env, const IRInstruction* i)  { implProp(env, i); }
 void cgPropDX(IRLS& env, const IRInstruction* i) { implProp(env, i); }
 
+void profilePropClassHelper(PropClassProfile* profile, const Class* cls) {
+  profile->report(cls);
+}
+
+void cgProfilePropClass(IRLS& env, const IRInstruction* inst) {
+  auto const extra = inst->extra<RDSHandleData>();
+  assertx(!rds::isPersistentHandle(extra->handle));
+  auto& v = vmain(env);
+
+  auto const profile = v.makeReg();
+  v << lea{rvmtl()[extra->handle], profile};
+  cgCallHelper(v, env, CallSpec::direct(profilePropClassHelper), kVoidDest,
+               SyncOptions::None, argGroup(env, inst).reg(profile).ssa(0));
+}
+
 void cgPropQ(IRLS& env, const IRInstruction* inst) {
   using namespace MInstrHelpers;
 
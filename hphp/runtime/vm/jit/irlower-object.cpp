@@ -26,6 +26,7 @@
 #include "hphp/runtime/vm/jit/call-spec.h"
 #include "hphp/runtime/vm/jit/code-gen-cf.h"
 #include "hphp/runtime/vm/jit/code-gen-helpers.h"
+#include "hphp/runtime/vm/jit/code-gen-tls.h"
 #include "hphp/runtime/vm/jit/extra-data.h"
 #include "hphp/runtime/vm/jit/ir-instruction.h"
 #include "hphp/runtime/vm/jit/ir-opcode.h"
@@ -53,6 +54,84 @@ void cgLdObjClass(IRLS& env, const IRInstruction* inst) {
 IMPL_OPCODE_CALL(AllocObj)
 IMPL_OPCODE_CALL(AllocObjReified)
 
+namespace {
+
+/*
+ * Emit the MemoryManager small-allocation fast path inline: charge the
+ * allocation debt, pop the head of the size class's freelist, and initialize
+ * the header, class pointer, and object-id the same way ObjectData's InitRaw
+ * constructor would.  When the debt check or the pop fails, undo the debt
+ * charge and fall back to newInstanceRawSmall(), which redoes the allocation
+ * with the allocator's full accounting (including any pending GC check).
+ */
+void emitNewInstanceRawInline(IRLS& env, const IRInstruction* inst,
+                              const Class* cls, size_t index,
+                              size_t size_class) {
+  auto const dst = dstLoc(env, inst, 0).reg();
+  auto& v = vmain(env);
+  auto& vc = vcold(env);
+
+  auto const slow = vc.makeBlock();
+  auto const done = v.makeBlock();
+
+  auto const mm = emitTLSAddr(v, tls_datum(tl_heap));
+  auto const debt = mm + MemoryManager::debtOffset();
+
+  // Subtracting from the debt counter takes it negative (sign flag set) when
+  // the request has allocated enough since the last check that a GC trigger
+  // may be pending.
+  auto const sfDebt = v.makeReg();
+  v << addqim{-safe_cast<int32_t>(size_class), debt, sfDebt};
+  ifThen(v, CC_S, sfDebt, slow);
+
+  auto const list = mm + MemoryManager::freelistHeadOffset(index);
+  auto const head = v.makeReg();
+  auto const next = v.makeReg();
+  auto const sfHead = v.makeReg();
+  v << load{list, head};
+  v << testq{head, head, sfHead};
+  ifThen(v, CC_Z, sfHead, slow);
+  v << load{head[offsetof(FreeNode, next)], next};
+  v << store{next, list};
+
+  emitImmStoreq(v, HeapObject::buildHeader(HeaderKind::Object, OneReference,
+                                           ObjectData::DefaultAttrs),
+                head[0]);
+  emitStLowPtr(v, v.cns(cls), head[ObjectData::getVMClassOffset()],
+               sizeof(LowPtr<Class>));
+
+  auto const maxId = emitTLSAddr(v, tls_datum(ObjectData::os_max_id));
+  auto const oldId = v.makeReg();
+  auto const newId = v.makeReg();
+  v << loadl{maxId, oldId};
+  v << incl{oldId, newId, v.makeReg()};
+  v << storel{newId, maxId};
+  v << storel{newId, head[ObjectData::getIdOffset()]};
+  v << phijmp{done, v.makeTuple({head})};
+
+  // Slow path: repay the debt charge (the helper charges it again) and let
+  // the C++ allocator handle the GC check and freelist refill.
+  vc = slow;
+  vc << addqim{safe_cast<int32_t>(size_class), debt, vc.makeReg()};
+  auto const slowObj = vc.makeReg();
+  cgCallHelper(
+    vc,
+    env,
+    CallSpec::direct(&ObjectData::newInstanceRawSmall),
+    callDest(slowObj),
+    SyncOptions::Sync,
+    argGroup(env, inst).immPtr(cls).imm(size_class).imm(index)
+  );
+  vc << phijmp{done, vc.makeTuple({slowObj})};
+
+  v = done;
+  auto const obj = v.makeReg();
+  v << phidef{v.makeTuple({obj})};
+  v << copy{obj, dst};
+}
+
+}
+
 void cgNewInstanceRaw(IRLS& env, const IRInstruction* inst) {
   auto const dst = dstLoc(env, inst, 0).reg();
   auto const cls = inst->extra<NewInstanceRaw>()->cls;
@@ -67,6 +146,12 @@ void cgNewInstanceRaw(IRLS& env, const IRInstruction* inst) {
 
   auto const attrs = cls->getODAttrs();
 
+  if (!debug && RuntimeOption::EvalJitInlineObjAlloc &&
+      attrs == ObjectData::DefaultAttrs && memoSize == 0 &&
+      size <= kMaxSmallSize) {
+    return emitNewInstanceRawInline(env, inst, cls, index, size_class);
+  }
+
   auto const target = [&]{
     if (attrs != ObjectData::DefaultAttrs) {
       if (memoSize > 0) {
@@ -20,6 +20,7 @@
 #include "hphp/runtime/base/ref-data.h"
 
 #include "hphp/runtime/vm/jit/abi.h"
+#include "hphp/runtime/vm/jit/arg-value-profile.h"
 #include "hphp/runtime/vm/jit/code-gen-cf.h"
 #include "hphp/runtime/vm/jit/extra-data.h"
 #include "hphp/runtime/vm/jit/ir-instruction.h"
@@ -294,6 +295,17 @@ void cgProfileType(IRLS& env, const IRInstruction* inst) {
                kVoidDest, SyncOptions::None, args);
 }
 
+void cgProfileArgValue(IRLS& env, const IRInstruction* inst) {
+  auto const extra = inst->extra<RDSHandleData>();
+
+  auto const args = argGroup(env, inst)
+    .addr(rvmtl(), safe_cast<int32_t>(extra->handle))
+    .typedValue(0);
+
+  cgCallHelper(vmain(env), env, CallSpec::method(&ArgValueProfile::report),
+               kVoidDest, SyncOptions::None, args);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 }}}
@@ -50,8 +50,15 @@
 #include "hphp/util/logger.h"
 #include "hphp/util/managed-arena.h"
 #include "hphp/util/numa.h"
+#include "hphp/util/timer.h"
 #include "hphp/util/trace.h"
 
+#include <folly/portability/SysResource.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+
 TRACE_SET_MOD(mcg);
 
 namespace HPHP { namespace jit { namespace mcgen {
@@ -62,7 +69,35 @@ std::thread s_retranslateAllThread;
 std::atomic<bool> s_retranslateAllScheduled{false};
 std::atomic<bool> s_retranslateAllComplete{false};
 
-void optimize(tc::FuncMetaInfo& info) {
+/*
+ * Thread that periodically re-sorts the hot portion of the TC based on fresh
+ * perf samples, when Eval.PerfRelocateInterval is set.  Started at the end of
+ * retranslateAll() and joined in joinWorkerThreads().
+ */
+std::thread s_relocateWorkerThread;
+std::mutex s_relocateWorkerMutex;
+std::condition_variable s_relocateWorkerCV;
+bool s_relocateWorkerStop{false};
+
+/*
+ * FuncIds that have been handed to the background pipeline, so each
+ * threshold crossing in translated code enqueues at most one job per
+ * function.  Entries are only removed when a job is dropped without
+ * optimizing, to allow a retry.
+ */
+std::mutex s_backgroundOptLock;
+jit::fast_set<FuncId> s_backgroundOptQueued;
+
+// Initial size of the relocatable buffer each job translates into.  The
+// underlying DataBlocks grow on demand, so this only needs to cover the
+// common case.
+constexpr size_t kLocalTCBufInitialSize = 512;
+
+struct OptimizeData;
+void farmOutRegions(OptimizeData& d, std::vector<RegionDescPtr>&& regions,
+                    const std::string& transCFGAnnot);
+
+void optimize(tc::FuncMetaInfo& info, OptimizeData* job = nullptr) {
   auto const func = info.func;
 
   folly::Optional<Trace::BumpRelease> bumpRefcount;
@@ -86,8 +121,17 @@ void optimize(tc::FuncMetaInfo& info) {
 
   // Regionize func and translate all its regions.
   std::string transCFGAnnot;
-  auto const regions = includedBody ? std::vector<RegionDescPtr>{}
-                                    : regionizeFunc(func, transCFGAnnot);
+  auto regions = includedBody ? std::vector<RegionDescPtr>{}
+                              : regionizeFunc(func, transCFGAnnot);
+
+  // During retranslateAll, translate the regions of large functions as
+  // individual worker jobs, so one big function doesn't pin a single worker
+  // while the rest of the pool drains.
+  if (job && RuntimeOption::EvalJitParallelRegionThreshold > 0 &&
+      regions.size() >= RuntimeOption::EvalJitParallelRegionThreshold) {
+    farmOutRegions(*job, std::move(regions), transCFGAnnot);
+    return;
+  }
 
   auto optIndex = 0;
   for (auto region : regions) {
@@ -114,12 +158,53 @@ void optimize(tc::FuncMetaInfo& info) {
 struct OptimizeData {
   FuncId id;
   tc::FuncMetaInfo info;
+  // Publish the result as soon as this job is done, rather than leaving it
+  // for retranslateAll()'s sorted bulk relocation.  Implies the job was
+  // heap-allocated by enqueueRetranslateOpt().
+  bool publish{false};
+
+  // For a job that translates a single region of a large function: the
+  // region and its position in the function's region order.  The TransCFG
+  // annotation is only set on the function's first region job.
+  RegionDescPtr region{nullptr};
+  int regionIndex{-1};
+  std::string annotation;
+
+  // Backing storage for a region job's tcBuf, and the region jobs farmed
+  // out by a whole-function job.  The latter keeps the former alive until
+  // the merged translations have been relocated into the TC.
+  std::unique_ptr<uint8_t[]> buf;
+  std::vector<std::unique_ptr<OptimizeData>> regionJobs;
 };
 
+/*
+ * Translate the single region of a region job into its own buffer.  The
+ * result stays in the job's FuncMetaInfo until retranslateAll() merges it
+ * back into the parent's, in region order.
+ */
+void translateOptRegion(OptimizeData& d) {
+  auto transArgs = TransArgs{d.region->start()};
+  if (!d.annotation.empty()) {
+    transArgs.annotations.emplace_back("TransCFG", d.annotation);
+  }
+  transArgs.region = d.region;
+  transArgs.kind = TransKind::Optimize;
+  transArgs.optIndex = d.regionIndex;
+
+  auto const spOff = d.region->entry()->initialSpOffset();
+  tc::createSrcRec(transArgs.sk, spOff);
+  auto data = translate(transArgs, spOff, d.info.tcBuf.view());
+  if (data) d.info.add(std::move(*data));
+}
+
 struct TranslateWorker : JobQueueWorker<OptimizeData*, void*, true, true> {
   void doJob(OptimizeData* d) override {
     ProfileNonVMThread nonVM;
 
+    // Background jobs are owned by this worker; jobs from retranslateAll()
+    // are owned by its jobs vector.
+    std::unique_ptr<OptimizeData> owned{d->publish ? d : nullptr};
+
     hphp_session_init(Treadmill::SessionKind::TranslateWorker);
     SCOPE_EXIT {
       hphp_context_exit();
@@ -129,20 +214,54 @@ struct TranslateWorker : JobQueueWorker<OptimizeData*, void*, true, true> {
     // Check if the func was treadmilled before the job started
     if (!Func::isFuncIdValid(d->id)) return;
 
+    // Region jobs skip the optimized() bookkeeping below; their parent job
+    // already did it for the whole function.
+    if (d->region) {
+      VMProtect _;
+      translateOptRegion(*d);
+      return;
+    }
+
+    if (d->publish) {
+      if (profData() == nullptr) return;
+      VMProtect _;
+      // Mirror retranslateOpt(): hold the lease for the function across
+      // optimizing and publishing.  If we can't get it, drop the job; a
+      // later threshold crossing in translated code will enqueue it again.
+      LeaseHolder writer(d->info.func, TransKind::Optimize, false);
+      if (!writer) {
+        std::lock_guard<std::mutex> lock{s_backgroundOptLock};
+        s_backgroundOptQueued.erase(d->id);
+        return;
+      }
+      if (profData()->optimized(d->id)) return;
+      profData()->setOptimized(d->id);
+      optimize(d->info);
+      tc::publishOptFunc(std::move(d->info));
+      tc::checkFreeProfData();
+      return;
+    }
+
     if (profData()->optimized(d->id)) return;
     profData()->setOptimized(d->id);
 
     VMProtect _;
-    optimize(d->info);
+    optimize(d->info, d);
   }
 
-#if USE_JEMALLOC_EXTENT_HOOKS
   void onThreadEnter() override {
+#if USE_JEMALLOC_EXTENT_HOOKS
     if (auto arena = next_extra_arena(s_numaNode)) {
       arena->bindCurrentThread();
     }
-  }
 #endif
+    if (auto const nice = RuntimeOption::EvalJitWorkerThreadsNice) {
+      // On Linux, setpriority() adjusts the nice value of just this thread,
+      // so translation yields the CPU to request threads whenever the
+      // machine is saturated.
+      setpriority(PRIO_PROCESS, 0, nice);
+    }
+  }
 };
 
 using WorkerDispatcher = JobQueueDispatcher<TranslateWorker>;
@@ -156,6 +275,7 @@ WorkerDispatcher& dispatcher() {
     RuntimeOption::EvalJitWorkerThreads,
     RuntimeOption::EvalJitWorkerThreads, 0, false, nullptr
   );
+  dispatcher->setThreadGroup("jit-worker");
   dispatcher->start();
   s_dispatcher.store(dispatcher, std::memory_order_release);
   return *dispatcher;
@@ -165,6 +285,33 @@ void enqueueRetranslateOptRequest(OptimizeData* d) {
   dispatcher().enqueue(d);
 }
 
+/*
+ * Hand each of `regions' to the dispatcher as its own job.  This runs on a
+ * worker, so the new jobs just extend the queue that retranslateAll() drains
+ * with waitEmpty(); once it does, it merges the results back into `d' in
+ * region order.
+ */
+void farmOutRegions(OptimizeData& d, std::vector<RegionDescPtr>&& regions,
+                    const std::string& transCFGAnnot) {
+  d.regionJobs.reserve(regions.size());
+  auto optIndex = 0;
+  for (auto region : regions) {
+    always_assert(!region->empty());
+    auto job = std::make_unique<OptimizeData>();
+    job->id = d.id;
+    job->region = region;
+    job->regionIndex = optIndex++;
+    if (job->regionIndex == 0) job->annotation = transCFGAnnot;
+    job->buf = std::make_unique<uint8_t[]>(kLocalTCBufInitialSize);
+    job->info = tc::FuncMetaInfo(
+      d.info.func,
+      tc::LocalTCBuffer(job->buf.get(), kLocalTCBufInitialSize)
+    );
+    d.regionJobs.emplace_back(std::move(job));
+    enqueueRetranslateOptRequest(d.regionJobs.back().get());
+  }
+}
+
 hfsort::TargetGraph
 createCallGraph(jit::hash_map<hfsort::TargetId, FuncId>& funcID) {
   BootStats::Block timer("RTA_create_callgraph",
@@ -206,7 +353,13 @@ createCallGraph(jit::hash_map<hfsort::TargetId, FuncId>& funcID) {
                              TransID callerTransId,
                              uint32_t& totalCalls) {
     assertx(callerTransId != kInvalidTransID);
-    auto const callerFuncId = pd->transRec(callerTransId)->funcId();
+    // Deserializing with Eval.ProfDataBytecodeMatching can drop the
+    // translations of funcs whose bytecode changed, leaving gaps in the
+    // trans rec table that caller lists may still point into.
+    if (callerTransId >= pd->numTransRecs()) return;
+    auto const callerRec = pd->transRec(callerTransId);
+    if (!callerRec) return;
+    auto const callerFuncId = callerRec->funcId();
     if (!Func::isFuncIdValid(callerFuncId)) return;
     auto const callerTargetId = targetID[callerFuncId];
     auto const callCount = pd->transCounter(callerTransId);
@@ -278,6 +431,33 @@ void print(hfsort::TargetGraph& /*cg*/, const char* fileName,
   fclose(outfile);
 }
 
+/*
+ * Body of s_relocateWorkerThread.
+ *
+ * Each pass samples the running server with perf for
+ * Eval.PerfRelocateSampleTime seconds and relocates the translations that
+ * took samples into code.hot, in the call-affinity order computed by
+ * hfsort::jitsort().  Translations that stopped taking samples are left
+ * behind and eventually scrubbed, so the start of the TC (the part backed by
+ * huge pages; see CodeCache::TCNumHugeHotMB) keeps tracking the workload's
+ * current hot set.  liveRelocate() bails out on its own while a previous
+ * pass is still being scrubbed on the treadmill.
+ */
+void relocateWorker() {
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock{s_relocateWorkerMutex};
+      s_relocateWorkerCV.wait_for(
+        lock,
+        std::chrono::seconds(RuntimeOption::EvalPerfRelocateInterval),
+        [] { return s_relocateWorkerStop; }
+      );
+      if (s_relocateWorkerStop) return;
+    }
+    tc::liveRelocate(RuntimeOption::EvalPerfRelocateSampleTime);
+  }
+}
+
 /*
  * This is the main driver for the profile-guided retranslation of all the
  * functions being PGO'd, which enables controlling the order in which the
@@ -362,7 +542,7 @@ void retranslateAll() {
 
   // 2) Generate machine code for all the profiled functions.
 
-  auto const initialSize = 512;
+  auto const initialSize = kLocalTCBufInitialSize;
   auto const ntargets = cg.targets.size();
   std::vector<OptimizeData> jobs;
   jobs.reserve(ntargets);
@@ -389,6 +569,17 @@ void retranslateAll() {
     dispatcher().waitEmpty();
   }
 
+  // Fold the results of any farmed-out region jobs back into their
+  // function's FuncMetaInfo, in region order, so each function publishes
+  // its translations in the same order as with serial translation.
+  for (auto& job : jobs) {
+    for (auto& regionJob : job.regionJobs) {
+      for (auto& trans : regionJob->info.translations) {
+        job.info.add(std::move(trans));
+      }
+    }
+  }
+
   if (serverMode) {
     Logger::Info("retranslateAll: finished optimizing functions");
   }
@@ -460,6 +651,15 @@ void retranslateAll() {
       discardProfData();
     }
   }
+
+  // Now that the sorted Optimize translations are in place, optionally keep
+  // re-sorting them as the workload shifts.  This requires the relocation
+  // map, which is only recorded with Eval.PerfRelocate.
+  if (serverMode && RuntimeOption::EvalPerfRelocate > 0 &&
+      RuntimeOption::EvalPerfRelocateInterval > 0) {
+    Logger::Info("retranslateAll: starting periodic hot-code relocation");
+    s_relocateWorkerThread = std::thread([] { relocateWorker(); });
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -473,9 +673,21 @@ void joinWorkerThreads() {
     }
   }
 
+  {
+    std::lock_guard<std::mutex> lock{s_relocateWorkerMutex};
+    s_relocateWorkerStop = true;
+  }
+  s_relocateWorkerCV.notify_one();
+
   if (s_retranslateAllThread.joinable()) {
     s_retranslateAllThread.join();
   }
+
+  // s_relocateWorkerThread is started by the retranslateAll thread, so only
+  // look at it once that thread has been joined.
+  if (s_relocateWorkerThread.joinable()) {
+    s_relocateWorkerThread.join();
+  }
 }
 
 folly::Optional<tc::TransMetaInfo>
@@ -486,6 +698,18 @@ translate(TransArgs args, FPInvOffset spOff,
 
   if (!tc::shouldTranslate(args.sk.func(), args.kind)) return folly::none;
 
+  // Account the whole pipeline, including the emit below, to the function's
+  // compilation-cost ledger.
+  auto const wallStart = HPHP::Timer::GetCurrentTimeMicros();
+  auto const cpuStart = HPHP::Timer::GetThreadCPUTimeNanos();
+  SCOPE_EXIT {
+    tc::recordFuncCompileTime(
+      args.sk.func(),
+      HPHP::Timer::GetCurrentTimeMicros() - wallStart,
+      (HPHP::Timer::GetThreadCPUTimeNanos() - cpuStart) / 1000
+    );
+  };
+
   Timer timer(Timer::mcg_translate);
   WorkloadStats guard(WorkloadStats::InTrans);
 
@@ -590,7 +814,7 @@ TCA retranslate(TransArgs args, const RegionContext& ctx) {
   args.kind = kind();
   if (!writer.checkKind(args.kind)) return nullptr;
 
-  args.region = selectRegion(ctx, args.kind);
+  args.region = selectRegion(ctx, args.kind, args.flags.relaxGuards);
   auto data = translate(args, ctx.spOffset);
 
   TCA result = nullptr;
@@ -627,6 +851,21 @@ bool retranslateOpt(FuncId funcId) {
   return true;
 }
 
+void enqueueRetranslateOpt(FuncId funcId) {
+  assertx(RuntimeOption::EvalJitBackgroundRetranslateOpt);
+  if (profData() == nullptr || profData()->optimized(funcId)) return;
+  {
+    std::lock_guard<std::mutex> lock{s_backgroundOptLock};
+    if (!s_backgroundOptQueued.emplace(funcId).second) return;
+  }
+  auto const func = const_cast<Func*>(Func::fromFuncId(funcId));
+  enqueueRetranslateOptRequest(new OptimizeData{
+    funcId,
+    tc::FuncMetaInfo(func, tc::LocalTCBuffer()),
+    true /* publish */
+  });
+}
+
 bool retranslateAllEnabled() {
   return
     RuntimeOption::EvalJitPGO &&
@@ -663,7 +902,12 @@ void checkRetranslateAll(bool force) {
       retranslateAll();
     });
   }
-  if (!RuntimeOption::ServerExecutionMode()) { // script mode
+  // In script mode wait for retranslateAll to finish.  In server mode a
+  // forced retranslateAll (after deserializing profile data at startup) may
+  // also be configured to block, so the server only starts accepting
+  // requests once the optimized translations have been published.
+  if (!RuntimeOption::ServerExecutionMode() ||
+      (force && RuntimeOption::EvalJitRetranslateAllBlocking)) {
     s_retranslateAllThread.join();
   }
 }
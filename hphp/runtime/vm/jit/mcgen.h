@@ -113,6 +113,17 @@ TCA retranslate(TransArgs args, const RegionContext& ctx);
  */
 bool retranslateOpt(FuncId funcId);
 
+/*
+ * Hand `funcId' to the JIT worker threads to be regionized, optimized, and
+ * published once done, without blocking the calling request thread.  At most
+ * one job per function is in flight at a time; a dropped job (e.g. because
+ * the lease was contended) is re-enqueued by the next threshold crossing.
+ *
+ * Used instead of retranslateOpt() when Eval.JitBackgroundRetranslateOpt is
+ * set.
+ */
+void enqueueRetranslateOpt(FuncId funcId);
+
 /*
  * In JitPGO mode, run retranslateAll if its enabled, we haven't already run it,
  * and either force is true, or we've collected "enough" profile data.
@@ -1822,6 +1822,8 @@ MemEffects memory_effects_impl(const IRInstruction& inst) {
   case ExitPlaceholder:
   case CheckRange:
   case ProfileType:
+  case ProfileArgValue:
+  case ProfilePropClass:
   case LdIfaceMethod:
   case InstanceOfIfaceVtable:
   case CheckARMagicFlag:
@@ -2072,6 +2074,7 @@ MemEffects memory_effects_impl(const IRInstruction& inst) {
 
   case ProfileFunc:
   case ProfileMethod:
+  case ProfileMethTargets:
     {
       AliasClass effects =
         actrec(inst.src(0), inst.extra<ProfileCallTargetData>()->bcSPOff);
@@ -0,0 +1,191 @@
+/*
+   +----------------------------------------------------------------------+
+   | HipHop for PHP                                                       |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 2010-present Facebook, Inc. (http://www.facebook.com)  |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 3.01 of the PHP license,      |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.php.net/license/3_01.txt                                  |
+   | If you did not receive a copy of the PHP license and are unable to   |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@php.net so we can mail you a copy immediately.               |
+   +----------------------------------------------------------------------+
+*/
+
+#include "hphp/runtime/vm/jit/meth-target-profile.h"
+
+#include "hphp/runtime/vm/class.h"
+#include "hphp/runtime/vm/func.h"
+#include "hphp/runtime/vm/jit/prof-data-serialize.h"
+
+#include "hphp/util/trace.h"
+
+#include <folly/Format.h>
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+
+namespace HPHP { namespace jit {
+
+TRACE_SET_MOD(irlower);
+
+///////////////////////////////////////////////////////////////////////////////
+
+const size_t MethTargetProfile::kMaxEntries;
+
+void MethTargetProfile::init() {
+  if (m_init) return;
+  m_init = true;
+  for (size_t i = 0; i < kMaxEntries; i++) {
+    m_entries[i] = Entry{};
+  }
+}
+
+void MethTargetProfile::report(const ActRec* ar, const Class* cls) {
+  assertx(ar);
+  auto const meth = ar->func();
+  if (!cls) {
+    if (!meth->isMethod()) return;
+    cls = ar->hasThis() ? ar->getThis()->getVMClass() : ar->getClass();
+  }
+  if (!cls) return;
+  FTRACE(5, "MethTargetProfile::report: {} => {}\n", cls->name()->data(),
+         meth->fullName()->data());
+  init();
+  for (size_t i = 0; i < kMaxEntries; i++) {
+    auto& entry = m_entries[i];
+    if (entry.cls == nullptr) {
+      entry.cls = cls;
+      entry.meth = meth;
+      entry.count = 1;
+      return;
+    }
+    if (entry.cls == cls) {
+      entry.count++;
+      return;
+    }
+  }
+  m_untracked++;
+}
+
+void MethTargetProfile::reduce(MethTargetProfile& profile,
+                               const MethTargetProfile& other) {
+  Entry allEntries[kMaxEntries * 2];
+  size_t nEntries = 0;
+
+  profile.m_init |= other.m_init;
+
+  // Copy into `allEntries' all the valid entries from `profile'.
+  for (size_t i = 0; i < kMaxEntries; i++) {
+    auto const& entry = profile.m_entries[i];
+    if (entry.cls == nullptr) break;
+    allEntries[nEntries++] = entry;
+  }
+
+  // Handle the entries from `other', either by adding to matching entries
+  // from `profile' or by adding new entries to `allEntries'.
+  for (size_t o = 0; o < kMaxEntries; o++) {
+    auto const& otherEntry = other.m_entries[o];
+    if (otherEntry.cls == nullptr) break;
+    size_t p = 0;
+    for (; p < kMaxEntries; p++) {
+      auto& entry = allEntries[p];
+      if (entry.cls == otherEntry.cls) {
+        entry.count += otherEntry.count;
+        break;
+      }
+    }
+    if (p == kMaxEntries) {
+      // Didn't find `otherEntry' among the entries from `profile', so add a
+      // new entry.
+      allEntries[nEntries++] = otherEntry;
+    }
+  }
+
+  // Sort the entries in `allEntries' and select the top kMaxEntries.  The
+  // rest is put in m_untracked.
+  std::sort(allEntries, allEntries + nEntries,
+            [&] (const Entry& a, const Entry& b) {
+              // Sort in decreasing order of `count' while keeping invalid
+              // entries at the end.
+              if (b.cls == nullptr) return true;
+              return a.count >= b.count;
+            });
+  auto const nEntriesToCopy = std::min(kMaxEntries, nEntries);
+  memcpy(profile.m_entries, allEntries, nEntriesToCopy * sizeof(Entry));
+
+  // Update `profile's untracked count.
+  profile.m_untracked += other.m_untracked;
+  for (size_t i = kMaxEntries; i < nEntries; i++) {
+    auto const& entry = allEntries[i];
+    if (entry.cls == nullptr) break;
+    profile.m_untracked += entry.count;
+  }
+}
+
+jit::vector<MethTargetProfile::Choice> MethTargetProfile::choose() const {
+  jit::vector<Choice> choices;
+  if (!m_init) return choices;
+
+  uint64_t total = m_untracked;
+  for (size_t i = 0; i < kMaxEntries; i++) {
+    auto const& entry = m_entries[i];
+    if (entry.cls == nullptr) break;
+    total += entry.count;
+  }
+  if (total == 0) return choices;
+
+  for (size_t i = 0; i < kMaxEntries; i++) {
+    auto const& entry = m_entries[i];
+    if (entry.cls == nullptr) break;
+    choices.push_back(Choice{entry.cls.get(), entry.meth.get(),
+                             (double)entry.count / total});
+  }
+  std::sort(choices.begin(), choices.end(),
+            [] (const Choice& a, const Choice& b) {
+              return a.probability > b.probability;
+            });
+  return choices;
+}
+
+std::string MethTargetProfile::toString() const {
+  if (!m_init) return std::string("uninitialized");
+  std::ostringstream out;
+  for (auto const& entry : m_entries) {
+    if (entry.cls != nullptr) {
+      out << folly::format("{} => {}: {}, ",
+                           entry.cls->name()->data(),
+                           entry.meth->fullName()->data(),
+                           entry.count);
+    }
+  }
+  out << folly::format("Untracked: {}", m_untracked);
+  return out.str();
+}
+
+void MethTargetProfile::serialize(ProfDataSerializer& ser) const {
+  for (size_t i = 0; i < kMaxEntries; i++) {
+    write_class(ser, m_entries[i].cls.get());
+    write_func(ser, m_entries[i].meth.get());
+    write_raw(ser, m_entries[i].count);
+  }
+  write_raw(ser, m_untracked);
+  write_raw(ser, m_init);
+}
+
+void MethTargetProfile::deserialize(ProfDataDeserializer& ser) {
+  for (size_t i = 0; i < kMaxEntries; i++) {
+    m_entries[i].cls = read_class(ser);
+    m_entries[i].meth = read_func(ser);
+    read_raw(ser, m_entries[i].count);
+  }
+  read_raw(ser, m_untracked);
+  read_raw(ser, m_init);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+}}
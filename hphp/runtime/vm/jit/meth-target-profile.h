@@ -0,0 +1,98 @@
+/*
+   +----------------------------------------------------------------------+
+   | HipHop for PHP                                                       |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 2010-present Facebook, Inc. (http://www.facebook.com)  |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 3.01 of the PHP license,      |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.php.net/license/3_01.txt                                  |
+   | If you did not receive a copy of the PHP license and are unable to   |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@php.net so we can mail you a copy immediately.               |
+   +----------------------------------------------------------------------+
+*/
+
+#ifndef incl_HPHP_JIT_METH_TARGET_PROFILE_H_
+#define incl_HPHP_JIT_METH_TARGET_PROFILE_H_
+
+#include "hphp/runtime/base/object-data.h"
+#include "hphp/runtime/vm/act-rec.h"
+#include "hphp/runtime/vm/func.h"
+
+#include "hphp/runtime/vm/jit/containers.h"
+
+#include "hphp/util/low-ptr.h"
+
+namespace HPHP {
+
+struct Class;
+
+namespace jit {
+
+///////////////////////////////////////////////////////////////////////////////
+
+struct ProfDataSerializer;
+struct ProfDataDeserializer;
+
+/*
+ * Profiles the receiver classes at a method call site, along with the method
+ * each one resolved to.  Unlike MethProfile, which summarizes the site into a
+ * single common class, method, or interface, this keeps the individual
+ * receivers, so polymorphic-but-not-megamorphic sites can be dispatched with
+ * a short chain of class checks.
+ */
+struct MethTargetProfile {
+
+  struct Choice {
+    const Class* cls;
+    const Func*  meth;
+    double       probability;
+  };
+
+  /*
+   * Register a call to the callee frame `ar'.
+   *
+   * If `cls' is not provided (when it's not known statically), we peek in
+   * `ar' for the class context.
+   */
+  void report(const ActRec* ar, const Class* cls);
+
+  /*
+   * Return the receiver classes seen while profiling, most frequent first.
+   * Each one's probability is its fraction of all the profiled calls,
+   * including the untracked ones that overflowed the table.
+   */
+  jit::vector<Choice> choose() const;
+
+  static void reduce(MethTargetProfile& profile,
+                     const MethTargetProfile& other);
+
+  std::string toString() const;
+
+  void serialize(ProfDataSerializer&) const;
+
+  void deserialize(ProfDataDeserializer&);
+
+ private:
+  struct Entry {
+    LowPtr<const Class> cls{nullptr};
+    LowPtr<const Func>  meth{nullptr};
+    uint32_t            count{0};
+  };
+
+  void init();
+
+  static const size_t kMaxEntries = 4;
+
+  Entry    m_entries[kMaxEntries];
+  uint32_t m_untracked{0};
+  bool     m_init{false};
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+}}
+
+#endif
@@ -53,6 +53,7 @@
 
 #include "hphp/util/boot-stats.h"
 #include "hphp/util/build-info.h"
+#include "hphp/util/logger.h"
 #include "hphp/util/managed-arena.h"
 #include "hphp/util/numa.h"
 #include "hphp/util/process.h"
@@ -78,6 +79,21 @@ constexpr uint32_t k86pinitSlot = 0x80000000u;
 constexpr uint32_t k86sinitSlot = 0x80000001u;
 constexpr uint32_t k86linitSlot = 0x80000002u;
 
+/*
+ * Identify a Func by the contents of its bytecode, so that with
+ * Eval.ProfDataBytecodeMatching, profile data can be matched to functions
+ * whose body is unchanged even when the repo as a whole is not identical
+ * to the one the profile was collected against.
+ */
+uint64_t func_checksum(const Func* func) {
+  auto const len = func->past() - func->base();
+  auto const hash = hash_string_cs(
+    reinterpret_cast<const char*>(func->unit()->entry() + func->base()),
+    len
+  );
+  return (static_cast<uint64_t>(len) << 32) | static_cast<uint32_t>(hash);
+}
+
 template<typename F>
 auto deserialize(ProfDataDeserializer&ser, F&& f) -> decltype(f()) {
   using T = decltype(f());
@@ -236,14 +252,26 @@ void write_region_block(ProfDataSerializer& ser,
 RegionDesc::BlockPtr read_region_block(ProfDataDeserializer& ser) {
   auto const id = read_raw<RegionDesc::BlockId>(ser);
   auto const start = read_srckey(ser);
-  auto const length = read_raw<int>(ser);
+  auto length = read_raw<int>(ser);
   auto const initialSpOffset = read_raw<FPInvOffset>(ser);
 
+  // The recorded offsets of a stale func may not fall on instruction
+  // boundaries in its new bytecode, so don't let the Block constructor walk
+  // them.  Substitute a trivial block at the func entry instead; the whole
+  // translation gets dropped in read_prof_data, so all that matters is
+  // keeping the stream (and the deserializer's pointer tables) in sync.
+  auto const stale = ser.isStaleFunc(start.funcID());
+  auto startOffset = start.offset();
+  if (stale) {
+    startOffset = start.func()->base();
+    length = 0;
+  }
+
   auto const block = std::make_shared<RegionDesc::Block>(id,
                                                          start.func(),
                                                          start.resumeMode(),
                                                          start.hasThis(),
-                                                         start.offset(),
+                                                         startOffset,
                                                          length,
                                                          initialSpOffset);
 
@@ -263,6 +291,9 @@ RegionDesc::BlockPtr read_region_block(ProfDataDeserializer& ser) {
                  [&] {
                    auto const sk = read_srckey(ser);
                    auto const func = read_func(ser);
+                   // A trivial stale-func block doesn't contain the recorded
+                   // SrcKeys, so the reads above are only for stream sync.
+                   if (stale) return;
                    block->setKnownFunc(sk, func);
                  });
 
@@ -583,14 +614,24 @@ void write_profiled_funcs(ProfDataSerializer& ser, ProfData* pd) {
 
   for (FuncId fid = 0; fid <= maxFuncId; fid++) {
     if (!Func::isFuncIdValid(fid) || !pd->profiling(fid)) continue;
-    write_func(ser, Func::fromFuncId(fid));
+    auto const func = Func::fromFuncId(fid);
+    write_func(ser, func);
+    write_raw(ser, func_checksum(func));
   }
   write_raw(ser, uintptr_t{});
 }
 
 void read_profiled_funcs(ProfDataDeserializer& ser, ProfData* pd) {
   while (auto const func = read_func(ser)) {
-    pd->setProfiling(func->getFuncId());
+    auto const checksum = read_raw<uint64_t>(ser);
+    if (checksum == func_checksum(func)) {
+      pd->setProfiling(func->getFuncId());
+    } else {
+      // The function's bytecode changed since the profile was collected
+      // (only possible with Eval.ProfDataBytecodeMatching).  Drop its
+      // profile and let it be re-profiled from scratch.
+      ser.recordStaleFunc(func->getFuncId());
+    }
   }
 }
 
@@ -654,8 +695,13 @@ void read_prof_data(ProfDataDeserializer& ser, ProfData* pd) {
   while (true) {
     auto const transID = read_raw<TransID>(ser);
     if (transID == kInvalidTransID) break;
-    pd->addProfTrans(transID, read_prof_trans_rec(ser));
-    *pd->transCounterAddr(transID) = read_raw<int64_t>(ser);
+    auto rec = read_prof_trans_rec(ser);
+    auto const counter = read_raw<int64_t>(ser);
+    // Translations of stale funcs are fully read to keep the stream in
+    // sync, but not registered; the funcs will be re-profiled.
+    if (rec && ser.isStaleFunc(rec->func()->getFuncId())) continue;
+    pd->addProfTrans(transID, std::move(rec));
+    *pd->transCounterAddr(transID) = counter;
   }
 }
 
@@ -1258,6 +1304,13 @@ Func* read_func(ProfDataDeserializer& ser) {
             return f;
           }
         }
+        // With Eval.ProfDataBytecodeMatching the repo may differ from the
+        // one that was profiled, so a recorded func can be missing from its
+        // unit entirely.  Fail the whole deserialization; the caller falls
+        // back to profiling from scratch.
+        if (RuntimeOption::ProfDataBytecodeMatching) {
+          throw std::runtime_error("Func not found at recorded unit offset");
+        }
         not_reached();
       }();
       ser.recordFid(fid, func->getFuncId());
@@ -1324,7 +1377,15 @@ std::string deserializeProfData(const std::string& filename, int numWorkers) {
 
     auto signature = read_raw<decltype(Repo::get().global().Signature)>(ser);
     if (signature != Repo::get().global().Signature) {
-      throw std::runtime_error("Mismatched repo-schema");
+      // With bytecode matching enabled, a different repo is acceptable:
+      // funcs are verified individually against the per-func checksums in
+      // the profile (see read_profiled_funcs), and only the ones whose
+      // bytecode is unchanged keep their profile.
+      if (!RuntimeOption::ProfDataBytecodeMatching) {
+        throw std::runtime_error("Mismatched repo-schema");
+      }
+      Logger::Info("deserializeProfData: repo signature mismatch; "
+                   "matching funcs by bytecode checksum");
     }
     auto size = read_raw<size_t>(ser);
     std::string schema;
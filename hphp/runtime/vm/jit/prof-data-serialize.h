@@ -101,6 +101,16 @@ struct ProfDataDeserializer {
     return it->second;
   }
 
+  /*
+   * Record/query funcs whose bytecode no longer matches the checksum that
+   * was serialized with the profile.  This can only happen with
+   * Eval.ProfDataBytecodeMatching, which allows deserializing against a
+   * different repo; the profile of such funcs is dropped and they are
+   * re-profiled from scratch.
+   */
+  void recordStaleFunc(uint32_t fid) { staleFuncs.emplace(fid); }
+  bool isStaleFunc(uint32_t fid) const { return staleFuncs.count(fid); }
+
   void recordRat(const RepoAuthType::Array* origRat,
                  const RepoAuthType::Array* newRat) {
     auto const DEBUG_ONLY inserted = ratMap.emplace(
@@ -139,6 +149,7 @@ struct ProfDataDeserializer {
   EntMap<Class*>       classMap;
   EntMap<const RepoAuthType::Array*> ratMap;
   jit::fast_map<uint32_t, uint32_t> fidMap;
+  jit::fast_set<uint32_t> staleFuncs;
 
   static std::string s_buildHost;
   static int64_t s_buildTime;
@@ -0,0 +1,115 @@
+/*
+   +----------------------------------------------------------------------+
+   | HipHop for PHP                                                       |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 2010-present Facebook, Inc. (http://www.facebook.com)  |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 3.01 of the PHP license,      |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.php.net/license/3_01.txt                                  |
+   | If you did not receive a copy of the PHP license and are unable to   |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@php.net so we can mail you a copy immediately.               |
+   +----------------------------------------------------------------------+
+*/
+
+#ifndef incl_HPHP_JIT_PROP_CLASS_PROFILE_H_
+#define incl_HPHP_JIT_PROP_CLASS_PROFILE_H_
+
+#include "hphp/runtime/vm/class.h"
+#include "hphp/runtime/vm/jit/prof-data-serialize.h"
+
+#include "hphp/util/low-ptr.h"
+#include "hphp/util/type-scan.h"
+
+#include <folly/Format.h>
+
+#include <string>
+
+namespace HPHP { namespace jit {
+
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+ * PropClassProfile records the dominant base class observed at a property
+ * access whose class isn't statically known, so that optimized translations
+ * can specialize on the predicted class and resolve the property slot at JIT
+ * time (see Eval.JitPGOPropSlotMinPercent).
+ *
+ * The candidate is maintained with a majority-vote counter: a sample of the
+ * candidate gains a vote, any other class costs one, and a class observed
+ * with no votes left becomes the new candidate.  The vote count is therefore
+ * a lower bound on the candidate's sample count, which makes the percentage
+ * check conservative.
+ */
+struct PropClassProfile {
+  std::string toString() const {
+    if (!m_class) return "none";
+    return folly::sformat("{}:{}/{}", m_class->name(), m_count, m_total);
+  }
+
+  void report(const Class* cls) {
+    ++m_total;
+    if (m_class == cls) {
+      ++m_count;
+      return;
+    }
+    if (!m_count) {
+      m_class = cls;
+      m_count = 1;
+      return;
+    }
+    --m_count;
+  }
+
+  static void reduce(PropClassProfile& a, const PropClassProfile& b) {
+    a.m_total += b.m_total;
+    if (a.m_class == b.m_class) {
+      a.m_count += b.m_count;
+    } else if (b.m_count > a.m_count) {
+      a.m_class = b.m_class;
+      a.m_count = b.m_count - a.m_count;
+    } else {
+      a.m_count -= b.m_count;
+    }
+  }
+
+  /*
+   * The candidate class, if it accounts for at least minPercent of the
+   * profiled samples; nullptr otherwise.
+   */
+  const Class* predictedClass(uint32_t minPercent) const {
+    if (!m_class || !m_total) return nullptr;
+    if (uint64_t{m_count} * 100 < uint64_t{m_total} * minPercent) {
+      return nullptr;
+    }
+    return m_class;
+  }
+
+  void serialize(ProfDataSerializer& ser) const {
+    write_class(ser, m_class.get());
+    write_raw(ser, m_count);
+    write_raw(ser, m_total);
+  }
+
+  void deserialize(ProfDataDeserializer& ser) {
+    m_class = read_class(ser);
+    read_raw(ser, m_count);
+    read_raw(ser, m_total);
+  }
+
+private:
+  LowPtr<const Class> m_class{nullptr};
+  uint32_t m_count{0};
+  uint32_t m_total{0};
+
+  // In RDS, but can't contain pointers to request-allocated data.
+  TYPE_SCAN_IGNORE_ALL;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+}}
+
+#endif
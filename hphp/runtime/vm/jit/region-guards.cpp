@@ -559,7 +559,7 @@ void optimizeProfiledGuards(RegionDesc& region, const ProfData& profData) {
 
 //////////////////////////////////////////////////////////////////////
 
-void optimizeGuards(RegionDesc& region, bool simple) {
+void optimizeGuards(RegionDesc& region, bool simple, bool dropSpecialized) {
   for (auto block : region.blocks()) {
     bool relaxed = false;
     RegionDesc::Block::GuardedLocVec newPreConds;
@@ -571,6 +571,9 @@ void optimizeGuards(RegionDesc& region, bool simple) {
       if (simple && category > DataTypeGeneric && category < DataTypeSpecific) {
         category = DataTypeSpecific;
       }
+      if (dropSpecialized && category == DataTypeSpecialized) {
+        category = DataTypeSpecific;
+      }
       auto newType = relaxType(preCond.type, category);
 
       if (newType != TGen) {
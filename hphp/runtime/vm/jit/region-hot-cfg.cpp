@@ -66,6 +66,16 @@ struct DFS {
       m_minBlockWeight = minBlkPerc * m_cfg.weight(head) / 100.0;
       m_minArcProb = RuntimeOption::EvalJitPGOMinArcProbability;
     }
+    // When selecting a callee region for inlining, optionally restrict it to
+    // its hottest blocks, so that only the hot (typically early-return) path
+    // is inlined and the cold remainder side-exits instead of blowing the
+    // caller's budget.
+    auto const inlineMinPerc =
+      RuntimeOption::EvalJitPGOInlineMinBlockCountPercent;
+    if (m_inlining && inlineMinPerc != 0) {
+      m_minBlockWeight = std::max(m_minBlockWeight,
+                                  inlineMinPerc * m_cfg.weight(head) / 100.0);
+    }
     ITRACE(3, "formRegion: starting at head = {} (weight = {})\n"
            "   minBlockWeight = {:.2}\n"
            "   minArcProb = {:.2}\n",
@@ -802,7 +802,8 @@ void RegionDesc::Block::checkMetadata() const {
 }
 
 RegionDescPtr selectRegion(const RegionContext& context,
-                           TransKind kind) {
+                           TransKind kind,
+                           bool relaxGuards) {
   auto const mode = regionMode();
 
   FTRACE(1,
@@ -819,7 +820,8 @@ RegionDescPtr selectRegion(const RegionContext& context,
           return selectMethod(context);
         case RegionMode::Tracelet:
           return selectTracelet(
-            context, kind, RuntimeOption::EvalJitMaxRegionInstrs
+            context, kind, RuntimeOption::EvalJitMaxRegionInstrs,
+            false /* inlining */, relaxGuards
           );
       }
       not_reached();
@@ -432,7 +432,8 @@ void RegionDesc::forEachArc(Work w) const {
  * returning nullptr causes it to use the current level 0 tracelet
  * analyzer.  Eventually we'd like this to completely replace analyze.
  */
-RegionDescPtr selectRegion(const RegionContext& context, TransKind kind);
+RegionDescPtr selectRegion(const RegionContext& context, TransKind kind,
+                           bool relaxGuards = false);
 
 /*
  * Select a compilation region based on profiling information.  This
@@ -453,9 +454,14 @@ RegionDescPtr selectHotRegion(TransID transId);
  *
  * The `allowInlining' flag should be disabled when we are selecting a tracelet
  * whose shape will be analyzed by the InliningDecider.
+ *
+ * The `relaxGuards' flag forces guard relaxation for the selected region,
+ * additionally widening specialized guards; it is set when retranslating a
+ * SrcKey whose guards keep failing at runtime.
  */
 RegionDescPtr selectTracelet(const RegionContext& ctx, TransKind kind,
-                             int32_t maxBCInstrs, bool inlining = false);
+                             int32_t maxBCInstrs, bool inlining = false,
+                             bool relaxGuards = false);
 
 struct HotTransContext {
   TransID tid;
@@ -506,8 +512,14 @@ void optimizeProfiledGuards(RegionDesc& region, const ProfData& profData);
 /*
  * Optimize the guards of `region', optionally in `simple' mode (where
  * guards are only relaxed if they can be relaxed all the way to TGen).
+ *
+ * If `dropSpecialized' is set, guards on specialized types are additionally
+ * widened to their plain DataType checks.  This is used when retranslating a
+ * SrcKey whose guards have been observed to fail repeatedly at runtime (see
+ * Eval.JitGuardFailureRelaxThreshold).
  */
-void optimizeGuards(RegionDesc& region, bool simple);
+void optimizeGuards(RegionDesc& region, bool simple,
+                    bool dropSpecialized = false);
 
 /*
  * Returns the PGO region selector to be used for the given `func'.
@@ -61,7 +61,8 @@ struct Env {
       InterpSet& interp,
       SrcKey& breakAt,
       int32_t maxBCInstrs,
-      bool inlining)
+      bool inlining,
+      bool relaxGuards)
     : ctx(ctx)
     , interp(interp)
     , breakAt(breakAt)
@@ -81,7 +82,7 @@ struct Env {
     , profiling(kind == TransKind::Profile)
     , inlining(inlining)
   {
-    if (RuntimeOption::EvalRegionRelaxGuards) {
+    if (RuntimeOption::EvalRegionRelaxGuards || relaxGuards) {
       irgs.irb->enableConstrainGuards();
     }
   }
@@ -655,7 +656,8 @@ RegionDescPtr form_region(Env& env) {
 }
 
 RegionDescPtr selectTracelet(const RegionContext& ctx, TransKind kind,
-                             int32_t maxBCInstrs, bool inlining /* = false */) {
+                             int32_t maxBCInstrs, bool inlining /* = false */,
+                             bool relaxGuards /* = false */) {
   Timer _t(Timer::selectTracelet);
   InterpSet interp;
   SrcKey breakAt;
@@ -665,7 +667,7 @@ RegionDescPtr selectTracelet(const RegionContext& ctx, TransKind kind,
   FTRACE(1, "selectTracelet: starting with maxBCInstrs = {}\n", maxBCInstrs);
 
   do {
-    Env env{ctx, kind, interp, breakAt, maxBCInstrs, inlining};
+    Env env{ctx, kind, interp, breakAt, maxBCInstrs, inlining, relaxGuards};
     region = form_region(env);
     ++tries;
   } while (!region);
@@ -681,10 +683,10 @@ RegionDescPtr selectTracelet(const RegionContext& ctx, TransKind kind,
     region->deleteBlock(region->blocks().back()->id());
   }
 
-  if (RuntimeOption::EvalRegionRelaxGuards) {
+  if (RuntimeOption::EvalRegionRelaxGuards || relaxGuards) {
     FTRACE(1, "selectTracelet: before optimizeGuards:\n{}\n",
            show(*region));
-    optimizeGuards(*region, kind == TransKind::Profile);
+    optimizeGuards(*region, kind == TransKind::Profile, relaxGuards);
   }
 
   FTRACE(1, "selectTracelet returning, {}, {} tries:\n{}\n",
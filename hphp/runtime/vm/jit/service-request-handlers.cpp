@@ -27,6 +27,7 @@
 #include "hphp/runtime/vm/jit/smashable-instr.h"
 #include "hphp/runtime/vm/jit/stub-alloc.h"
 #include "hphp/runtime/vm/jit/tc.h"
+#include "hphp/runtime/vm/jit/tc-record.h"
 #include "hphp/runtime/vm/jit/translator-inline.h"
 #include "hphp/runtime/vm/jit/unwind-itanium.h"
 #include "hphp/runtime/vm/jit/write-lease.h"
@@ -293,6 +294,10 @@ TCA handleServiceRequest(ReqInfo& info) noexcept {
         liveFunc(), info.args[0].offset, liveResumeMode(), liveHasThis()
       };
       auto trflags = info.args[1].trflags;
+      // Each REQ_RETRANSLATE means every translation in sk's chain failed a
+      // guard.  If that keeps happening, form the next translation with its
+      // guards relaxed rather than minting yet another over-specialized one.
+      if (tc::recordGuardFailure(sk)) trflags.relaxGuards = true;
       auto args = TransArgs{sk};
       args.flags = trflags;
       start = mcgen::retranslate(args, getContext(args.sk));
@@ -302,6 +307,15 @@ TCA handleServiceRequest(ReqInfo& info) noexcept {
 
     case REQ_RETRANSLATE_OPT: {
       sk = SrcKey::fromAtomicInt(info.args[0].sk);
+      if (RuntimeOption::EvalJitBackgroundRetranslateOpt) {
+        // Hand the function off to the JIT worker threads and carry on in
+        // the Profile translation; execution switches over once the
+        // Optimize translation is published. Interpret a BB first (as in
+        // the failure case below) so we don't come right back here.
+        mcgen::enqueueRetranslateOpt(sk.funcID());
+        start = nullptr;
+        break;
+      }
       if (mcgen::retranslateOpt(sk.funcID())) {
         // Retranslation was successful. Resume execution at the new Optimize
         // translation.
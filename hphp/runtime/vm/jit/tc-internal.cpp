@@ -122,6 +122,16 @@ bool shouldTranslateNoSizeLimit(const Func* func, TransKind kind) {
     return false;
   }
 
+  // Demote functions that have used up their compilation-cost budget (see
+  // Eval.JitMaxFuncCompileTime) to interp-or-profile-only: refusing their
+  // Live and Optimize translations stops one pathological function from
+  // eating arbitrary compile time, without losing the profile data we've
+  // already gathered for it.
+  if ((kind == TransKind::Live || kind == TransKind::Optimize) &&
+      exceededFuncCompileBudget(func)) {
+    return false;
+  }
+
   return true;
 }
 
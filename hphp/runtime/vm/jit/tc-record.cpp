@@ -21,6 +21,7 @@
 
 #include "hphp/runtime/base/init-fini-node.h"
 #include "hphp/runtime/server/http-server.h"
+#include "hphp/runtime/vm/func.h"
 #include "hphp/runtime/vm/resumable.h"
 #include "hphp/runtime/vm/debug/debug.h"
 #include "hphp/runtime/vm/jit/cfg.h"
@@ -39,9 +40,15 @@
 #include "hphp/util/timer.h"
 #include "hphp/util/trace.h"
 
+#include <folly/AtomicHashMap.h>
+#include <folly/Bits.h>
+#include <folly/Format.h>
 #include <folly/gen/Base.h>
 #include <folly/json.h>
 
+#include <algorithm>
+#include <vector>
+
 TRACE_SET_MOD(mcg);
 
 namespace HPHP { namespace jit { namespace tc {
@@ -142,6 +149,145 @@ static ServiceData::CounterCallback s_warmedUpCounter(
   }
 );
 
+/*
+ * Export fragmentation statistics for each code block in the TC: the number
+ * of interior free bytes and holes, plus a histogram of hole sizes bucketed
+ * by powers of two.  These stay zero unless Eval.EnableReusableTC is
+ * reclaiming translations.
+ */
+static ServiceData::CounterCallback s_fragmentationCounters(
+  [](std::map<std::string, int64_t>& counters) {
+    if (!mcgen::initialized()) return;
+
+    auto codeLock = lockCode();
+    code().forEachBlock([&] (const char* name, const CodeBlock& cb) {
+      counters[folly::sformat("jit.code.{}.free-bytes", name)] =
+        cb.bytesFree();
+      counters[folly::sformat("jit.code.{}.free-blocks", name)] =
+        cb.blocksFree();
+      cb.forEachFreeSize([&] (size_t size, size_t count) {
+        counters[folly::sformat("jit.code.{}.free-holes.{}",
+                                name, folly::nextPowTwo(size))] += count;
+      });
+    });
+  }
+);
+
+bool recordGuardFailure(SrcKey sk) {
+  auto const threshold = RuntimeOption::EvalJitGuardFailureRelaxThreshold;
+  if (threshold == 0) return false;
+
+  static auto guardFailureCounter = ServiceData::createTimeSeries(
+    "jit.guard-failures",
+    {ServiceData::StatsType::RATE, ServiceData::StatsType::SUM}
+  );
+  guardFailureCounter->addValue(1);
+
+  static folly::AtomicHashMap<uint64_t, std::atomic<uint32_t>> s_counts{4096};
+  auto const pair = s_counts.emplace(sk.toAtomicInt(), 1);
+  auto const count = pair.second
+    ? 1
+    : pair.first->second.fetch_add(1, std::memory_order_relaxed) + 1;
+  if (count <= threshold) return false;
+
+  static auto relaxedCounter = ServiceData::createTimeSeries(
+    "jit.guard-failure-relaxations",
+    {ServiceData::StatsType::RATE, ServiceData::StatsType::SUM}
+  );
+  relaxedCounter->addValue(1);
+  return true;
+}
+
+namespace {
+
+/*
+ * Per-function compilation-cost ledger.  Updated once per translation, so a
+ * function with many translations accumulates the cost of all of them.
+ */
+struct FuncCompileCost {
+  explicit FuncCompileCost(int64_t wall, int64_t cpu)
+    : wallMicros{wall}, cpuMicros{cpu}, numTrans{1} {}
+
+  std::atomic<int64_t> wallMicros;
+  std::atomic<int64_t> cpuMicros;
+  std::atomic<int64_t> numTrans;
+};
+
+folly::AtomicHashMap<uint32_t, FuncCompileCost> s_compileCosts{32768};
+
+}
+
+void recordFuncCompileTime(const Func* func,
+                           int64_t wallMicros, int64_t cpuMicros) {
+  auto const pair =
+    s_compileCosts.emplace(func->getFuncId(), wallMicros, cpuMicros);
+  if (!pair.second) {
+    auto& cost = pair.first->second;
+    cost.wallMicros.fetch_add(wallMicros, std::memory_order_relaxed);
+    cost.cpuMicros.fetch_add(cpuMicros, std::memory_order_relaxed);
+    cost.numTrans.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+bool exceededFuncCompileBudget(const Func* func) {
+  auto const budget = RuntimeOption::EvalJitMaxFuncCompileTime;
+  if (budget <= 0) return false;
+
+  auto const it = s_compileCosts.find(func->getFuncId());
+  if (it == s_compileCosts.end()) return false;
+  if (it->second.wallMicros.load(std::memory_order_relaxed) < budget) {
+    return false;
+  }
+
+  static auto const counter = ServiceData::createTimeSeries(
+    "jit.func-compile-budget-exceeded",
+    {ServiceData::StatsType::RATE, ServiceData::StatsType::SUM}
+  );
+  counter->addValue(1);
+  return true;
+}
+
+std::string reportFuncCompileCosts() {
+  struct Row {
+    FuncId funcId;
+    int64_t wallMicros;
+    int64_t cpuMicros;
+    int64_t numTrans;
+    int64_t weight;
+  };
+  std::vector<Row> rows;
+
+  for (auto const& pair : s_compileCosts) {
+    auto weight = int64_t{0};
+    if (auto const pd = profData()) {
+      for (auto const tid : pd->funcProfTransIDs(pair.first)) {
+        weight += pd->transCounter(tid);
+      }
+    }
+    rows.push_back(Row {
+      pair.first,
+      pair.second.wallMicros.load(std::memory_order_relaxed),
+      pair.second.cpuMicros.load(std::memory_order_relaxed),
+      pair.second.numTrans.load(std::memory_order_relaxed),
+      weight
+    });
+  }
+  std::sort(rows.begin(), rows.end(), [] (const Row& a, const Row& b) {
+    return a.wallMicros > b.wallMicros;
+  });
+
+  std::string out;
+  folly::format(&out, "{:>12} {:>12} {:>8} {:>12}  {}\n",
+                "wall(us)", "cpu(us)", "trans", "weight", "func");
+  for (auto const& row : rows) {
+    auto const func = Func::fromFuncId(row.funcId);
+    folly::format(&out, "{:>12} {:>12} {:>8} {:>12}  {}\n",
+                  row.wallMicros, row.cpuMicros, row.numTrans, row.weight,
+                  func ? func->fullName()->data() : "<unknown>");
+  }
+  return out;
+}
+
 /*
  * If the jit maturity counter is enabled, update it with the current amount of
  * emitted code.
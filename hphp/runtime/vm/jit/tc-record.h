@@ -62,6 +62,35 @@ void recordBCInstr(uint32_t op, const TCA addr, const TCA end, bool cold);
  */
 void reportJitMaturity();
 
+/*
+ * Record that every translation in `sk's chain failed a guard (i.e. a
+ * REQ_RETRANSLATE was serviced for it).  Returns true once the failure count
+ * exceeds Eval.JitGuardFailureRelaxThreshold, indicating that retranslations
+ * of `sk' should be formed with relaxed guards.
+ */
+bool recordGuardFailure(SrcKey sk);
+
+/*
+ * Account `wallMicros'/`cpuMicros' of translation time to `func's
+ * compilation-cost ledger.  Covers the whole translate pipeline, from region
+ * lowering through emit.
+ */
+void recordFuncCompileTime(const Func* func,
+                           int64_t wallMicros, int64_t cpuMicros);
+
+/*
+ * Whether `func' has used up Eval.JitMaxFuncCompileTime worth of translation
+ * time.  Always false when the budget is disabled.
+ */
+bool exceededFuncCompileBudget(const Func* func);
+
+/*
+ * Report the compilation-cost ledger, ranked by wall-clock compile time, with
+ * each function's profile execution weight for comparison.  Used by the
+ * vm-compile-costs admin command.
+ */
+std::string reportFuncCompileCosts();
+
 /*
  * Get a code size counter for the named code block ("main", "cold", etc.)
  */
@@ -385,6 +385,34 @@ folly::Optional<FuncInfo> eraseFuncInfo(FuncId fid) {
   return std::move(data);
 }
 
+/*
+ * If interior fragmentation of the TC's code blocks has crossed
+ * Eval.TCFragmentationRelocateThreshold (a percentage of their used bytes),
+ * kick a live relocation pass to re-lay the hottest translations
+ * contiguously.  Relocation is driven by the maps recorded with
+ * Eval.PerfRelocate; without them the pass finds nothing to move.
+ */
+void maybeRelocateForFragmentation() {
+  auto const threshold = RuntimeOption::EvalTCFragmentationRelocateThreshold;
+  if (threshold == 0) return;
+
+  size_t used = 0;
+  size_t holeBytes = 0;
+  {
+    auto codeLock = lockCode();
+    code().forEachBlock([&] (const char*, const CodeBlock& cb) {
+      used += cb.used();
+      holeBytes += cb.bytesFree();
+    });
+  }
+
+  if (used == 0 || holeBytes * 100 < used * threshold) return;
+  // -2 relocates every translation in the map, which is what coalesces the
+  // survivors; passes are serialized by okToRelocate, so crossing the
+  // threshold repeatedly while one is pending is harmless.
+  liveRelocate(-2);
+}
+
 void reclaimFunctionSync(const StringData* fname, FuncId fid) {
   ITRACE(1, "Tearing down func {} (id={})\n", fname->data(), fid);
   Trace::Indent _i;
@@ -493,6 +521,7 @@ void recycleInit() {
         [] (const SrcRec* sr) { reclaimSrcRecSync(sr); },
         [] (FuncJob j) { reclaimFunctionSync(j.fname, j.fid); }
       );
+      maybeRelocateForFragmentation();
     }
   });
 }
@@ -239,6 +239,20 @@ void emitPredictionsAndPreConditions(irgen::IRGS& irgs,
     auto type = preCond.type;
     auto loc  = preCond.location;
     assertx(type <= TGen);
+
+    // When this unit has already proven a nontrivial type for the location
+    // --- e.g. the HHBBC return type asserted after a call in a preceding
+    // block --- a profile-derived precondition that merely narrows the
+    // proven type buys a side exit for little information.  With
+    // Eval.HHIRSkipProvenTypeGuards, trust the proven type instead and drop
+    // the guard; the rest of the translation is generated against the wider
+    // type.
+    if (RuntimeOption::EvalHHIRSkipProvenTypeGuards && !isEntry &&
+        irgs.context.kind == TransKind::Optimize) {
+      auto const known = irgs.irb->fs().typeOf(loc);
+      if (known < TInitCell && !(known <= type)) continue;
+    }
+
     irgen::checkType(irgs, loc, type, bcOff, checkOuterTypeOnly);
   }
 
@@ -1339,6 +1339,16 @@ void translateInstr(irgen::IRGS& irgs, const NormalizedInstruction& ni,
 
 //////////////////////////////////////////////////////////////////////
 
+/*
+ * This is the consumer end of HHBBC's devirtualization facts.  In
+ * RepoAuthoritative mode the whole-program analysis records everything it
+ * proves about call targets directly in the repo: AttrUnique/AttrPersistent
+ * on classes, AttrNoOverride on both classes and methods, and AssertRAT*
+ * instructions narrowing receiver types.  When the callee here (or its
+ * caller via Func::isImmutableFrom) carries those attributes we can emit a
+ * direct call with no profiling data at all, which is what makes cold
+ * callsites that never earn a CallTargetProfile still devirtualize.
+ */
 const Func* lookupImmutableMethod(const Class* cls, const StringData* name,
                                   bool& magicCall, bool staticLookup,
                                   const Func* ctxFunc,
@@ -152,6 +152,7 @@ struct TransFlags {
     struct {
       bool noinlineSingleton : 1;
       bool noProfiledFPush : 1;
+      bool relaxGuards : 1;
     };
     uint64_t packed;
   };
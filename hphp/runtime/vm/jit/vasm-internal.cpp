@@ -253,6 +253,35 @@ bool emit(Venv& env, const debugguardjmp& i) {
 
 ///////////////////////////////////////////////////////////////////////////////
 
+/*
+ * With Eval.JitLazyBindStubs, a bind{jmp,jcc} in an optimized translation
+ * whose target SrcKey already has a SrcRec borrows the target's anchor
+ * translation instead of materializing a private stub in frozen.  The jump
+ * is registered as an incoming branch on the target's SrcRec when this
+ * metadata is published (see CGMeta::process_only()), so translating the
+ * target smashes it like any other incoming branch; until then, a taken
+ * exit costs a REQ_RETRANSLATE service request through the anchor.
+ *
+ * Returns nullptr when a private stub is still required.
+ */
+TCA lazy_bind_stub(Venv& env, TCA jump, SrcKey target, TransFlags trflags) {
+  if (!RuntimeOption::EvalJitLazyBindStubs) return nullptr;
+  // The anchor can't carry TransFlags, and only optimized translations may
+  // skip the bind request: profiling translations need it to record the
+  // jump's TransID arc for region selection.
+  if (trflags.packed) return nullptr;
+  if (!env.unit.context || env.unit.context->kind != TransKind::Optimize) {
+    return nullptr;
+  }
+  auto const sr = tc::findSrcRec(target);
+  if (!sr) return nullptr;
+
+  auto const it = env.meta.smashableJumpData.find(jump);
+  assertx(it != env.meta.smashableJumpData.end());
+  it->second.lazyBind = true;
+  return sr->getFallbackTranslation();
+}
+
 void emit_svcreq_stub(Venv& env, const Venv::SvcReqPatch& p) {
   auto& frozen = env.text.frozen().code;
 
@@ -262,17 +291,23 @@ void emit_svcreq_stub(Venv& env, const Venv::SvcReqPatch& p) {
     case Vinstr::bindjmp:
       { auto const& i = p.svcreq.bindjmp_;
         assertx(p.jmp && !p.jcc);
-        stub = svcreq::emit_bindjmp_stub(frozen, env.text.data(),
-                                         env.meta, i.spOff, p.jmp,
-                                         i.target, i.trflags);
+        stub = lazy_bind_stub(env, p.jmp, i.target, i.trflags);
+        if (!stub) {
+          stub = svcreq::emit_bindjmp_stub(frozen, env.text.data(),
+                                           env.meta, i.spOff, p.jmp,
+                                           i.target, i.trflags);
+        }
       } break;
 
     case Vinstr::bindjcc:
       { auto const& i = p.svcreq.bindjcc_;
         assertx(!p.jmp && p.jcc);
-        stub = svcreq::emit_bindjmp_stub(frozen, env.text.data(),
-                                         env.meta, i.spOff, p.jcc,
-                                         i.target, i.trflags);
+        stub = lazy_bind_stub(env, p.jcc, i.target, i.trflags);
+        if (!stub) {
+          stub = svcreq::emit_bindjmp_stub(frozen, env.text.data(),
+                                           env.meta, i.spOff, p.jcc,
+                                           i.target, i.trflags);
+        }
       } break;
 
     case Vinstr::bindaddr:
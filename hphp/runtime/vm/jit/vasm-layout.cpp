@@ -16,12 +16,16 @@
 
 #include "hphp/util/trace.h"
 
+#include "hphp/runtime/base/rds.h"
+
+#include "hphp/runtime/vm/jit/abi.h"
 #include "hphp/runtime/vm/jit/containers.h"
 #include "hphp/runtime/vm/jit/prof-data.h"
 #include "hphp/runtime/vm/jit/timer.h"
 #include "hphp/runtime/vm/jit/vasm.h"
 #include "hphp/runtime/vm/jit/vasm-instr.h"
 #include "hphp/runtime/vm/jit/vasm-print.h"
+#include "hphp/runtime/vm/jit/vasm-prof.h"
 #include "hphp/runtime/vm/jit/vasm-text.h"
 #include "hphp/runtime/vm/jit/vasm-unit.h"
 #include "hphp/runtime/vm/jit/vasm-visit.h"
@@ -49,7 +53,9 @@
  *     implementation uses estimated arc weights derived from a combination of
  *     profile counters inserted at the bytecode-level blocks (in Profile
  *     translations) and the JIT-time Likely/Unlikely/Unused hints (encoded in
- *     the "area" field of Vblocks).
+ *     the "area" field of Vblocks).  With Eval.ProfBranchGuidedLayout, arc
+ *     weights that can't be inferred from the block weights are taken from
+ *     the branch samples recorded by vasm-prof-branch instead of estimated.
  */
 
 namespace HPHP { namespace jit {
@@ -124,6 +130,7 @@ struct Scale {
   static const int64_t kUnknownWeight = std::numeric_limits<int64_t>::max();
 
   void    computeArcWeights();
+  int64_t measuredArcWeight(Vlabel src, Vlabel dst) const;
   TransID findProfTransID(Vlabel blk) const;
   int64_t findProfCount(Vlabel blk)   const;
 
@@ -162,6 +169,41 @@ int64_t Scale::findProfCount(Vlabel blk) const {
   return 1;
 }
 
+/*
+ * Weight for the arc `src' -> `dst' based on the branch samples that
+ * vasm-prof-branch recorded while earlier translations of this code were
+ * running (see Eval.ProfBranchGuidedLayout).  The samples only establish the
+ * relative frequency of `src's outgoing arcs, so `src's weight is apportioned
+ * among its successors in the measured ratio, which keeps the result in the
+ * same scale as the block weights.  Returns kUnknownWeight when the option is
+ * off or no samples were recorded for `src's branch.
+ */
+int64_t Scale::measuredArcWeight(Vlabel src, Vlabel dst) const {
+  if (!RuntimeOption::EvalProfBranchGuidedLayout) return kUnknownWeight;
+
+  auto const& code = m_unit.blocks[src].code;
+  if (code.empty() || !code.back().origin) return kUnknownWeight;
+  auto const fromOff = code.back().origin->marker().bcOff();
+
+  // The samples are keyed the way vasm-prof-branch keys them: by the function
+  // and bytecode offset of the first profiled instruction of each successor.
+  uint64_t arcSamples = 0;
+  uint64_t totalSamples = 0;
+  for (auto s : succs(m_unit.blocks[src])) {
+    for (auto& i : m_unit.blocks[s].code) {
+      if (!i.origin) continue;
+      auto const& marker = i.origin->marker();
+      auto const samples =
+        prof_branch_samples(marker.func(), fromOff, marker.bcOff());
+      totalSamples += samples;
+      if (s == dst) arcSamples = samples;
+      break;
+    }
+  }
+  if (totalSamples == 0) return kUnknownWeight;
+  return weight(src) * (arcSamples / double(totalSamples));
+}
+
 void Scale::computeArcWeights() {
   FTRACE(3, "[vasm-layout] computeArcWeights:\n");
 
@@ -238,14 +280,21 @@ void Scale::computeArcWeights() {
     }
   } while (inferred);
 
-  // Finally, for each arc whose weight is still unknown at this point, we
-  // currently just approximate it as half of the smallest weight of its
-  // incident blocks.
+  // Finally, for each arc whose weight is still unknown at this point, use
+  // the branch samples recorded at runtime if we have any; otherwise just
+  // approximate it as half of the smallest weight of its incident blocks.
   for (auto b : m_blocks) {
     auto succSet = succs(m_unit.blocks[b]);
     for (auto s : succSet) {
       auto arcid = arcId(b, s);
       if (m_arcWgts[arcid] == kUnknownWeight) {
+        auto const measured = measuredArcWeight(b, s);
+        if (measured != kUnknownWeight) {
+          m_arcWgts[arcid] = measured;
+          FTRACE(3, "  - arc({} -> {}) [measured] => weight = {}\n",
+                 b, s, m_arcWgts[arcid]);
+          continue;
+        }
         m_arcWgts[arcid] = std::min(weight(b), weight(s)) / 2;
         FTRACE(3, "  - arc({} -> {}) [guessed] => weight = {}\n",
                b, s, m_arcWgts[arcid]);
@@ -509,10 +558,40 @@ void Clusterizer::splitHotColdClusters() {
 
 ///////////////////////////////////////////////////////////////////////////////
 
+/*
+ * Accumulate, for each RDS handle referenced by this unit, the profile weight
+ * of the blocks that access it (see Eval.ProfileRDSHeat).  RDS accesses are
+ * recognized as memory operands based on rvmtl().
+ */
+void recordRDSHeat(const Vunit& unit) {
+  struct Visitor {
+    template<class T> void imm(const T&) {}
+    template<class T> void def(const T&) {}
+    template<class T, class H> void defHint(const T&, const H&) {}
+    template<class T, class H> void useHint(const T& u, const H&) { use(u); }
+    template<class T> void across(const T& u) { use(u); }
+    template<class T> void use(const T&) {}
+    void use(const Vptr& ptr) {
+      if (ptr.base == rvmtl() && ptr.disp >= 0) handles.push_back(ptr.disp);
+    }
+    jit::vector<int32_t> handles;
+  };
+
+  for (auto const& block : unit.blocks) {
+    Visitor v;
+    for (auto const& inst : block.code) visitOperands(inst, v);
+    for (auto const h : v.handles) {
+      rds::recordAccess(rds::Handle(h), block.weight);
+    }
+  }
+}
+
 jit::vector<Vlabel> pgoLayout(Vunit& unit) {
   // Make sure block weights are consistent.
   fixBlockWeights(unit);
 
+  if (RuntimeOption::EvalProfileRDSHeat) recordRDSHeat(unit);
+
   // Compute arc weights.
   Scale scale(unit);
   FTRACE(1, "profileGuidedLayout: Weighted CFG:\n{}\n", scale.toString());
@@ -134,6 +134,7 @@ struct FormatVisitor {
   }
   void imm(TransFlags f) {
     if (f.noinlineSingleton) str << sep() << "noinlineSingleton";
+    if (f.relaxGuards) str << sep() << "relaxGuards";
   }
   void imm(DestType dt) {
     str << sep() << destTypeName(dt);
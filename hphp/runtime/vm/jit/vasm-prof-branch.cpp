@@ -48,6 +48,10 @@
 #include <boost/dynamic_bitset.hpp>
 #include <boost/range/adaptor/reversed.hpp>
 
+#include <folly/AtomicHashMap.h>
+#include <folly/Hash.h>
+
+#include <atomic>
 #include <string>
 #include <vector>
 
@@ -72,6 +76,28 @@ void reset_counter() {
   *s_counter = RuntimeOption::EvalProfBranchSampleFreq;
 }
 
+/*
+ * In-process sample counts for branch arcs, keyed by function and bytecode
+ * offsets (see prof_branch_samples()).  Only populated when
+ * Eval.ProfBranchGuidedLayout is set.
+ */
+folly::AtomicHashMap<uint64_t, std::atomic<uint64_t>> s_branch_samples{65536};
+
+uint64_t branch_sample_key(FuncId func, Offset fromOff, Offset toOff) {
+  return folly::hash::hash_combine(func, fromOff, toOff);
+}
+
+/*
+ * Count a sampled hit to the arc `fromOff' -> `toOff' in `func'.
+ */
+void count_branch_sample(const Func* func, Offset fromOff, Offset toOff) {
+  auto const key = branch_sample_key(func->getFuncId(), fromOff, toOff);
+  auto const pair = s_branch_samples.emplace(key, 1);
+  if (!pair.second) {
+    pair.first->second.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 /*
@@ -173,6 +199,14 @@ void record_branch_hit(const BranchID* branch,
 
   auto const& b = *branch;
 
+  if (RuntimeOption::EvalProfBranchGuidedLayout &&
+      !(b.from.taken && b.from.imm)) {
+    // Immediate taken targets have no bytecode offset to key on, so only
+    // arcs between profiled instructions are counted.
+    auto const toOff = b.from.taken ? b.taken.vasm_id.bcoff : b.next.bcoff;
+    count_branch_sample(func, b.from.bcoff, toOff);
+  }
+
   auto record = StructuredLogEntry{};
   record.setInt("version", kVersion);
   record.setStr("side", b.from.taken ? "taken" : "next");
@@ -233,6 +267,14 @@ void record_branch_hit(const BranchID* branch,
   StructuredLog::log("hhvm_tc_branches", record);
 }
 
+uint64_t prof_branch_samples(const Func* func, Offset fromOff, Offset toOff) {
+  auto const key = branch_sample_key(func->getFuncId(), fromOff, toOff);
+  auto const it = s_branch_samples.find(key);
+  return it != s_branch_samples.end()
+    ? it->second.load(std::memory_order_relaxed)
+    : 0;
+}
+
 namespace {
 
 ///////////////////////////////////////////////////////////////////////////////
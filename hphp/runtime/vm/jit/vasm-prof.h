@@ -17,7 +17,13 @@
 #ifndef incl_HPHP_JIT_VASM_PROF_H_
 #define incl_HPHP_JIT_VASM_PROF_H_
 
-namespace HPHP { namespace jit {
+#include "hphp/runtime/base/types.h"
+
+namespace HPHP {
+
+struct Func;
+
+namespace jit {
 
 struct Vunit;
 
@@ -28,6 +34,18 @@ struct Vunit;
  */
 void profile_branches(Vunit& unit);
 
+/*
+ * Number of samples recorded for the branch arc from the instruction at
+ * `fromOff' to the instruction at `toOff'.
+ *
+ * The counts are keyed by function and bytecode offset rather than by
+ * translation, so samples recorded while one translation of the code was
+ * running can be looked up when a later translation of it is compiled.  Only
+ * populated when Eval.ProfBranchGuidedLayout is set; returns 0 when no
+ * samples were recorded.
+ */
+uint64_t prof_branch_samples(const Func* func, Offset fromOff, Offset toOff);
+
 ///////////////////////////////////////////////////////////////////////////////
 
 }}
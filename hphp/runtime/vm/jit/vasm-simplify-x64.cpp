@@ -177,6 +177,45 @@ bool simplify(Env& env, const cmpqi& inst, Vlabel b, size_t i) {
     ? cmp_zero_impl<testq>(env, inst, inst.s1, b, i) : false;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+/*
+ * SIMD stores.
+ */
+
+/*
+ * Combine a pair of stores of doubles to adjacent memory locations into a
+ * single 16-byte unaligned SIMD store:
+ *
+ *  storesd{s0, m}; storesd{s1, m + 8} -> unpcklpd{s1, s0, tmp};
+ *                                        storeups{tmp, m}
+ *
+ * Since the locations are exactly adjacent, the pair can't overlap, so the
+ * combined store is observationally equivalent.  We only do this for
+ * immediately consecutive instructions, so there's no need to check for
+ * clobbers of the address registers in between.
+ */
+bool simplify(Env& env, const storesd& store, Vlabel b, size_t i) {
+  return if_inst<Vinstr::storesd>(env, b, i + 1, [&] (const storesd& next) {
+    auto const& m0 = store.m;
+    auto const& m1 = next.m;
+    if (m0.seg != m1.seg ||
+        m0.base != m1.base ||
+        m0.index != m1.index ||
+        (m0.index.isValid() && m0.scale != m1.scale) ||
+        static_cast<int64_t>(m1.disp) != static_cast<int64_t>(m0.disp) + 8) {
+      return false;
+    }
+
+    return simplify_impl(env, b, i, [&] (Vout& v) {
+      auto const tmp = v.makeReg();
+      // unpcklpd{}'s first source supplies the high lane of its result.
+      v << unpcklpd{next.s, store.s, tmp};
+      v << storeups{tmp, Vptr128{m0}};
+      return 2;
+    });
+  });
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 }
@@ -1082,12 +1082,17 @@ void optimizeX64(Vunit& unit, const Abi& abi, bool regalloc) {
 
   assertx(checkWidths(unit));
 
-  if (unit.context && !isProfiling(unit.context->kind) && abi.canSpill &&
-      RuntimeOption::EvalProfBranchSampleFreq > 0) {
-    // Even when branch profiling is on, we still only want to profile
-    // non-profiling translations of PHP functions.  We also require that we
-    // can spill, so that we can generate arbitrary profiling code, and also to
-    // ensure we don't profile unique stubs and such.
+  if (unit.context && abi.canSpill &&
+      RuntimeOption::EvalProfBranchSampleFreq > 0 &&
+      (!isProfiling(unit.context->kind) ||
+       RuntimeOption::EvalProfBranchGuidedLayout)) {
+    // Even when branch profiling is on, we normally only want to profile
+    // non-profiling translations of PHP functions---but when the samples
+    // feed back into code layout, profiling translations are sampled too, so
+    // that the counts are available when the optimized translations are laid
+    // out.  We also require that we can spill, so that we can generate
+    // arbitrary profiling code, and also to ensure we don't profile unique
+    // stubs and such.
     profile_branches(unit);
   }
 
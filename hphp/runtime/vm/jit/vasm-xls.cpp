@@ -1795,6 +1795,20 @@ void Vxls::allocate(Interval* current) {
     }
 
     auto ret = InvalidReg;
+
+    // When a caller-saved register covers all of `current', prefer it over a
+    // callee-saved one, so that callee-saved registers---the only ones that
+    // survive native calls---stay free for intervals that span a call and
+    // would otherwise have to be spilled around it.
+    if (RuntimeOption::EvalJitXlsPreferCallerSaved) {
+      auto const callerSaved = allow - ctx.abi.calleeSaved;
+      callerSaved.forEach([&] (PhysReg r) {
+        if (free_until[r] < current->end()) return;
+        ret = choose_closest_after(current->end(), free_until, ret, r);
+      });
+      if (ret != InvalidReg) return ret;
+    }
+
     for (auto const r : free_until) {
       ret = choose_closest_after(current->end(), free_until, ret, r);
     }
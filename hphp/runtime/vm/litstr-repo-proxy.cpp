@@ -14,23 +14,42 @@
    +----------------------------------------------------------------------+
 */
 
+#include <algorithm>
 #include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
 
+#include "hphp/util/process.h"
+
+#include "hphp/runtime/base/runtime-option.h"
+#include "hphp/runtime/base/static-string-table.h"
 #include "hphp/runtime/vm/unit.h"
 #include "hphp/runtime/vm/repo.h"
 
 namespace HPHP {
 
+namespace {
+// The repo the global litstr table was loaded from, or -1 if none.  Set once
+// during load(); read by every thread's proxy when lazily loading ids, since
+// only the loading thread's proxy ever runs load().
+std::atomic<int> s_litstrRepoId{-1};
+}
+
 LitstrRepoProxy::LitstrRepoProxy(Repo& repo)
     : RepoProxy(repo)
     , m_insertLitstrLocal(repo, RepoIdLocal)
     , m_insertLitstrCentral(repo, RepoIdCentral)
     , m_getLitstrsLocal(repo, RepoIdLocal)
-    , m_getLitstrsCentral(repo, RepoIdCentral) {
+    , m_getLitstrsCentral(repo, RepoIdCentral)
+    , m_getOneLitstrLocal(repo, RepoIdLocal)
+    , m_getOneLitstrCentral(repo, RepoIdCentral) {
   m_insertLitstr[RepoIdLocal] = &m_insertLitstrLocal;
   m_insertLitstr[RepoIdCentral] = &m_insertLitstrCentral;
   m_getLitstrs[RepoIdLocal] = &m_getLitstrsLocal;
   m_getLitstrs[RepoIdCentral] = &m_getLitstrsCentral;
+  m_getOneLitstr[RepoIdLocal] = &m_getOneLitstrLocal;
+  m_getOneLitstr[RepoIdCentral] = &m_getOneLitstrCentral;
 }
 
 void LitstrRepoProxy::createSchema(int repoId, RepoTxn& txn) {
@@ -53,6 +72,12 @@ void LitstrRepoProxy::load() {
   // No repos were loadable.  This is normal for non-repo-authoritative repos.
 }
 
+StringData* LitstrRepoProxy::loadOne(Id litstrId) {
+  auto const repoId = s_litstrRepoId.load(std::memory_order_acquire);
+  if (repoId < 0) return nullptr;
+  return getOneLitstr(repoId).get(litstrId);
+}
+
 void LitstrRepoProxy::InsertLitstrStmt::insert(RepoTxn& txn,
                                                Id litstrId,
                                                const StringData* litstr) {
@@ -71,6 +96,40 @@ void LitstrRepoProxy::InsertLitstrStmt::insert(RepoTxn& txn,
 RepoStatus LitstrRepoProxy::GetLitstrsStmt::get() {
   try {
     RepoTxn txn(m_repo);
+
+    // Interning the litstrs below is the first heavy use of the static
+    // string table; size it for them up front so the inserts don't have
+    // to grow the table while every loading thread hammers it.
+    int numLitstrs = 0;
+    {
+      std::stringstream ssCount;
+      ssCount << "SELECT COUNT(*) FROM " << m_repo.table(m_repoId, "Litstr");
+      RepoStmt countStmt(m_repo);
+      countStmt.prepare(ssCount.str());
+      RepoTxnQuery countQuery(txn, countStmt);
+      countQuery.step();
+      if (countQuery.row()) countQuery.getInt(0, numLitstrs);
+      if (!RuntimeOption::RepoLitstrLazyLoad &&
+          numLitstrs > 0 &&
+          uint32_t(numLitstrs) >
+            RuntimeOption::EvalInitialStaticStringTableSize) {
+        RuntimeOption::EvalInitialStaticStringTableSize = numLitstrs;
+        refineStaticStringTableSize();
+      }
+    }
+
+    // With Repo.LitstrLazyLoad, only size the global table here; ids get
+    // faulted in from the repo on first lookup instead of all being
+    // interned up front.
+    if (RuntimeOption::RepoLitstrLazyLoad) {
+      txn.commit();
+      NamedEntityPairTable namedInfo;
+      namedInfo.resize(numLitstrs);
+      LitstrTable::get().setNamedEntityPairTable(std::move(namedInfo));
+      s_litstrRepoId.store(m_repoId, std::memory_order_release);
+      return RepoStatus::success;
+    }
+
     if (!prepared()) {
       std::stringstream ssSelect;
       ssSelect << "SELECT litstrId,litstr FROM "
@@ -78,21 +137,71 @@ RepoStatus LitstrRepoProxy::GetLitstrsStmt::get() {
       txn.prepare(*this, ssSelect.str());
     }
     RepoTxnQuery query(txn, *this);
-    NamedEntityPairTable namedInfo;
+    std::vector<std::string> litstrs;
+    if (numLitstrs > 0) litstrs.reserve(numLitstrs);
     do {
       query.step();
       if (query.row()) {
-        StringData* litstr; /**/ query.getStaticString(1, litstr);
-        namedInfo.emplace_back(litstr);
+        litstrs.emplace_back();
+        query.getStdString(1, litstrs.back());
       }
     } while (!query.done());
-    namedInfo.shrink_to_fit();
-    LitstrTable::get().setNamedEntityPairTable(std::move(namedInfo));
     txn.commit();
+
+    // Interning the litstrs dominates repo startup, and sqlite can't be
+    // read concurrently anyway -- so pull the raw bytes out first
+    // (above) and spread the makeStaticString calls across a few
+    // threads, each owning a contiguous slice of the id table.
+    NamedEntityPairTable namedInfo;
+    namedInfo.resize(litstrs.size());
+    auto const intern = [&](size_t begin, size_t end) {
+      for (auto i = begin; i < end; ++i) {
+        namedInfo[i] = makeStaticString(litstrs[i]);
+      }
+    };
+    auto const nThreads = std::min(
+      {size_t(Process::GetCPUCount()), litstrs.size() / 65536 + 1, size_t(8)}
+    );
+    if (nThreads > 1) {
+      std::vector<std::thread> workers;
+      auto const chunk = litstrs.size() / nThreads + 1;
+      for (size_t t = 1; t < nThreads; ++t) {
+        workers.emplace_back(intern, t * chunk,
+                             std::min((t + 1) * chunk, litstrs.size()));
+      }
+      intern(0, std::min(chunk, litstrs.size()));
+      for (auto& w : workers) w.join();
+    } else {
+      intern(0, litstrs.size());
+    }
+    LitstrTable::get().setNamedEntityPairTable(std::move(namedInfo));
+    s_litstrRepoId.store(m_repoId, std::memory_order_release);
   } catch (RepoExc& re) {
     return RepoStatus::error;
   }
   return RepoStatus::success;
 }
 
+StringData* LitstrRepoProxy::GetOneLitstrStmt::get(Id litstrId) {
+  try {
+    RepoTxn txn(m_repo);
+    if (!prepared()) {
+      std::stringstream ssSelect;
+      ssSelect << "SELECT litstr FROM " << m_repo.table(m_repoId, "Litstr")
+               << " WHERE litstrId == @litstrId;";
+      txn.prepare(*this, ssSelect.str());
+    }
+    RepoTxnQuery query(txn, *this);
+    query.bindInt64("@litstrId", litstrId);
+    query.step();
+    if (!query.row()) return nullptr;
+    std::string litstr;
+    query.getStdString(0, litstr);
+    txn.commit();
+    return makeStaticString(litstr);
+  } catch (RepoExc& re) {
+    return nullptr;
+  }
+}
+
 }
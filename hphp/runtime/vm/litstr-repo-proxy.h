@@ -30,6 +30,14 @@ struct LitstrRepoProxy : RepoProxy {
   void createSchema(int repoId, RepoTxn& txn); // throws(RepoExc)
   void load();
 
+  /*
+   * Load the single litstr `litstrId' from the repo the global table was
+   * loaded from, interning it as a static string.  Returns nullptr if no
+   * litstr table has been loaded.  Used with Repo.LitstrLazyLoad, where
+   * load() only sizes the global table and ids are faulted in on first use.
+   */
+  StringData* loadOne(Id litstrId);
+
   struct InsertLitstrStmt : RepoProxy::Stmt {
     InsertLitstrStmt(Repo& repo, int repoId) : Stmt(repo, repoId) {}
     void insert(RepoTxn& txn, Id litstrId, const StringData* litstr);
@@ -41,9 +49,17 @@ struct LitstrRepoProxy : RepoProxy {
     RepoStatus get();
   };
 
+  struct GetOneLitstrStmt : RepoProxy::Stmt {
+    GetOneLitstrStmt(Repo& repo, int repoId) : Stmt(repo, repoId) {}
+    StringData* get(Id litstrId);
+  };
+
 public:
   InsertLitstrStmt& insertLitstr(int repoId) { return *m_insertLitstr[repoId]; }
   GetLitstrsStmt& getLitstrs(int repoId) { return *m_getLitstrs[repoId]; }
+  GetOneLitstrStmt& getOneLitstr(int repoId) {
+    return *m_getOneLitstr[repoId];
+  }
 
 private:
   InsertLitstrStmt m_insertLitstrLocal;
@@ -53,6 +69,10 @@ private:
   GetLitstrsStmt m_getLitstrsLocal;
   GetLitstrsStmt m_getLitstrsCentral;
   GetLitstrsStmt* m_getLitstrs[RepoIdCount];
+
+  GetOneLitstrStmt m_getOneLitstrLocal;
+  GetOneLitstrStmt m_getOneLitstrCentral;
+  GetOneLitstrStmt* m_getOneLitstr[RepoIdCount];
 };
 
 }
@@ -51,16 +51,19 @@ inline bool LitstrTable::contains(Id id) const {
 
 inline StringData* LitstrTable::lookupLitstrId(Id id) const {
   assertx(m_safeToRead);
-  return m_namedInfo.lookupLitstr(id);
+  if (auto const litstr = m_namedInfo.lookupLitstr(id)) return litstr;
+  // Null entries only occur with Repo.LitstrLazyLoad, where the table starts
+  // out sized but unpopulated.
+  return loadLitstrId(id);
 }
 
 inline const NamedEntity* LitstrTable::lookupNamedEntityId(Id id) const {
-  assertx(m_safeToRead);
-  return m_namedInfo.lookupNamedEntity(id);
+  return lookupNamedEntityPairId(id).second;
 }
 
 inline NamedEntityPair LitstrTable::lookupNamedEntityPairId(Id id) const {
   assertx(m_safeToRead);
+  if (!m_namedInfo.lookupLitstr(id)) loadLitstrId(id);
   return m_namedInfo.lookupNamedEntityPair(id);
 }
 
@@ -16,8 +16,11 @@
 
 #include "hphp/runtime/vm/litstr-table.h"
 
+#include "hphp/runtime/vm/repo.h"
 #include "hphp/runtime/vm/unit.h"
 
+#include "hphp/util/assertions.h"
+
 namespace HPHP {
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -42,6 +45,16 @@ Id LitstrTable::mergeLitstr(const StringData* litstr) {
   return acc->second;
 }
 
+StringData* LitstrTable::loadLitstrId(Id id) const {
+  assertx(m_namedInfo.contains(id));
+  auto const litstr = Repo::get().lsrp().loadOne(id);
+  always_assert_flog(litstr, "litstr id {} missing from repo", id);
+  // Any thread racing us here loaded the same litstr and interned the same
+  // static string, so blindly storing the entry is fine.
+  const_cast<LitstrTable*>(this)->m_namedInfo[id] = litstr;
+  return litstr;
+}
+
 void LitstrTable::setReading() {
   always_assert(!m_safeToRead);
   always_assert(!m_namedInfo.size());
@@ -124,6 +124,12 @@ struct LitstrTable {
 private:
   LitstrTable() {}
 
+  /*
+   * Slow path for lookups under Repo.LitstrLazyLoad: fault `id' in from the
+   * repo, fill its table entry, and return it.
+   */
+  StringData* loadLitstrId(Id id) const;
+
 
   /////////////////////////////////////////////////////////////////////////////
   // Data members.
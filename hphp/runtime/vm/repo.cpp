@@ -27,6 +27,7 @@
 
 #include "hphp/util/assertions.h"
 #include "hphp/util/async-func.h"
+#include "hphp/util/boot-stats.h"
 #include "hphp/util/build-info.h"
 #include "hphp/util/hugetlb.h"
 #include "hphp/util/logger.h"
@@ -137,6 +138,8 @@ size_t Repo::stringLengthLimit() const {
 
 void Repo::loadGlobalData(bool allowFailure /* = false */,
                           bool readArrayTable /* = true */) {
+  BootStats::Block timer("Repo::loadGlobalData",
+                         RuntimeOption::ServerExecutionMode());
   if (readArrayTable) m_lsrp.load();
 
   if (!RuntimeOption::RepoAuthoritative) return;
@@ -934,6 +937,17 @@ void Repo::pragmas(int repoId) {
   setIntPragma(repoId, "cache_size", 20);
   // Valid journal_mode values: delete, truncate, persist, memory, wal, off.
   setTextPragma(repoId, "journal_mode", RuntimeOption::RepoJournal.c_str());
+  if (RuntimeOption::RepoMmapSize > 0) {
+    // Read database pages via mmap(2) rather than read(2), so unit blob
+    // accesses are zero-copy and every process serving the same repo shares
+    // one OS page cache.  SQLite may silently cap the value (e.g. at its
+    // compile-time maximum), so don't verify the readback like the pragma
+    // setters above do.
+    std::stringstream ssPragma;
+    ssPragma << "PRAGMA " << dbName(repoId) << ".mmap_size = "
+             << RuntimeOption::RepoMmapSize << ";";
+    exec(ssPragma.str());
+  }
 }
 
 void Repo::getIntPragma(int repoId, const char* name, int& val) {
@@ -1098,8 +1112,10 @@ bool Repo::writable(int repoId) {
 void batchCommit(const std::vector<std::unique_ptr<UnitEmitter>>& ues) {
   auto& repo = Repo::get();
 
-  // Attempt batch commit.  This can legitimately fail due to multiple input
-  // files having identical contents.
+  // Attempt batch commit.  Identical input files dedup against the
+  // already-stored unit with the same md5 (including units inserted
+  // earlier in this transaction), so duplicates no longer abort the
+  // batch; the fallback below only matters for genuine repo errors.
   bool err = false;
   {
     RepoTxn txn(repo);
@@ -16,6 +16,7 @@
 #include "hphp/runtime/vm/ringbuffer-print.h"
 
 #include <iostream>
+#include <sstream>
 
 #include <folly/Format.h>
 
@@ -24,12 +25,12 @@
 
 namespace HPHP { namespace Trace {
 
-void dumpEntry(const RingBufferEntry* e) {
+static void dumpEntry(std::ostream& out, const RingBufferEntry* e) {
   if (e->type == RBTypeUninit) return;
 
-  std::cerr <<
-    folly::format("{:#x} {:10} {:20}",
-                  e->threadId, e->seq, ringbufferName(e->type));
+  out <<
+    folly::format("{:#x} {:10} {:16} {:20}",
+                  e->threadId, e->seq, e->tsc, ringbufferName(e->type));
   auto const msgFormat = "{:50} {:#16x}\n";
 
   switch (e->type) {
@@ -43,7 +44,7 @@ void dumpEntry(const RingBufferEntry* e) {
 
       // We append our own newline so ignore any newlines in the msg.
       while (len > 0 && info.msg[len - 1] == '\n') --len;
-      std::cerr <<
+      out <<
         folly::format(msgFormat,
                       folly::StringPiece(info.msg, info.msg + len),
                       info.truncatedRip);
@@ -68,26 +69,26 @@ void dumpEntry(const RingBufferEntry* e) {
       if (indentDepth < 0) indentDepth = 0;
       auto const indentedName =
         folly::sformat("{}{}", std::string(indentDepth * 4, ' '), info.msg);
-      std::cerr << folly::format(msgFormat,
-                                 indentedName, info.truncatedRip);
+      out << folly::format(msgFormat,
+                           indentedName, info.truncatedRip);
       indentDepth += e->type == RBTypeFuncEntry;
       break;
     }
     case RBTypeServiceReq: {
       auto& info = e->vmPoint;
       auto req = static_cast<jit::ServiceRequest>(info.sk);
-      std::cerr << folly::format(msgFormat,
-                                 jit::svcreq::to_name(req), info.data);
+      out << folly::format(msgFormat,
+                           jit::svcreq::to_name(req), info.data);
       break;
     }
     case RBTypeGeneric: {
       auto& info = e->generic;
-      std::cerr << folly::format(msgFormat, info.name, info.data);
+      out << folly::format(msgFormat, info.name, info.data);
       break;
     }
     default: {
       auto& info = e->vmPoint;
-      std::cerr <<
+      out <<
         folly::format(msgFormat,
                       showShort(SrcKey::fromAtomicInt(info.sk)),
                       info.data);
@@ -104,7 +105,8 @@ void dumpEntry(const RingBufferEntry* e) {
 //
 //    (gdb) call HPHP::Trace::dumpRingBufferMasked(100,
 //       (1 << HPHP::Trace::RBTypeFuncEntry))
-void dumpRingBufferMasked(int numEntries, uint32_t types, uint32_t threadId) {
+static void dumpRingBufferMasked(std::ostream& out, int numEntries,
+                                 uint32_t types, uint32_t threadId) {
   if (!g_ring_ptr) return;
   int startIdx = (g_ringIdx.load() - numEntries) % kMaxRBEntries;
   while (startIdx < 0) {
@@ -117,14 +119,24 @@ void dumpRingBufferMasked(int numEntries, uint32_t types, uint32_t threadId) {
     if ((1 << rb->type) & types &&
         (!threadId || threadId == rb->threadId)) {
       numDumped++;
-      dumpEntry(rb);
+      dumpEntry(out, rb);
     }
   }
 }
 
+void dumpRingBufferMasked(int numEntries, uint32_t types, uint32_t threadId) {
+  dumpRingBufferMasked(std::cerr, numEntries, types, threadId);
+}
+
 KEEP_SECTION
 void dumpRingBuffer(int numEntries, uint32_t threadId) {
   dumpRingBufferMasked(numEntries, -1u, threadId);
 }
 
+std::string dumpRingBufferToString(int numEntries, uint32_t threadId) {
+  std::ostringstream out;
+  dumpRingBufferMasked(out, numEntries, -1u, threadId);
+  return out.str();
+}
+
 } }
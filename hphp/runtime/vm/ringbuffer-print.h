@@ -16,12 +16,23 @@
 #ifndef incl_HPHP_VM_RINGBUFFER_H_
 #define incl_HPHP_VM_RINGBUFFER_H_
 
+#include <iosfwd>
+#include <string>
+
 #include "hphp/util/ringbuffer.h"
 
 namespace HPHP { namespace Trace {
 
 void dumpRingBuffer(int numEntries, uint32_t threadId);
 
+/*
+ * Format the most recent `numEntries' entries of the global ring buffer
+ * (optionally restricted to one thread) into a string, for consumption by
+ * the /vm-dump-rb admin endpoint. Unlike the gdb-oriented dumpRingBuffer()
+ * this doesn't write to stderr, so it can be used on a live server.
+ */
+std::string dumpRingBufferToString(int numEntries, uint32_t threadId = 0);
+
 } }
 
 #endif
@@ -67,6 +67,16 @@ void print_boolean(bool val) {
  * and decref its first argument
  */
 StringData* concat_ss(StringData* v1, StringData* v2) {
+  // Empty operands are common in template rendering; dodge the
+  // allocation-and-copy entirely.  The refcount contract holds: returning
+  // v1 keeps the caller's reference, and returning v2 pairs the incref of
+  // the output with the decref of v1.
+  if (v2->empty()) return v1;
+  if (v1->empty()) {
+    v2->incRefCount();
+    v1->decRefAndRelease();
+    return v2;
+  }
   if (v1->cowCheck()) {
     FOLLY_SDT(hhvm, hhvm_cow_concat, v1->size(), v2->size());
     StringData* ret = StringData::Make(v1, v2);
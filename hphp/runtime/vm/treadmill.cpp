@@ -30,6 +30,7 @@
 #include <folly/portability/SysTime.h>
 
 #include "hphp/runtime/base/runtime-option.h"
+#include "hphp/runtime/base/surprise-flags.h"
 #include "hphp/runtime/base/thread-info.h"
 #include "hphp/util/logger.h"
 #include "hphp/util/process.h"
@@ -52,6 +53,8 @@ TRACE_SET_MOD(treadmill);
 std::atomic<int64_t> g_nextThreadIdx{0};
 __thread int64_t tl_thisThreadIdx{kInvalidThreadIdx};
 
+char const* getSessionKindName(SessionKind);
+
 namespace {
 
 //////////////////////////////////////////////////////////////////////
@@ -62,6 +65,12 @@ struct RequestInfo {
   GenCount  startTime;
   pthread_t pthreadId;
   SessionKind sessionKind;
+  // The request thread's ThreadInfo, so a laggard can be timed out from
+  // another thread; nullptr for sessions without one.
+  ThreadInfo* threadInfo;
+  // Whether we've already timed this request out for exceeding the
+  // treadmill-lag budget, so it's only flagged (and logged) once.
+  bool timedOut;
 };
 
 pthread_mutex_t s_genLock = PTHREAD_MUTEX_INITIALIZER;
@@ -140,10 +149,51 @@ void checkOldest() {
   }
 }
 
+/*
+ * If the oldest request in flight has been pinning the treadmill for longer
+ * than Server.TreadmillLagBudgetSeconds, time it out via its surprise flags.
+ * This frees the memory retired behind it once the request unwinds, without
+ * taking the whole server down the way Server.MaxRequestAgeFactor does.
+ *
+ * Must be called while holding the GenCountGuard.
+ */
+void enforceLagBudget() {
+  auto const budget = RuntimeOption::TreadmillLagBudgetSeconds;
+  if (!budget) return;
+
+  auto const ageOldest = getAgeOldestRequest();
+  if (ageOldest <= budget) return;
+
+  auto const oldestStart =
+    s_oldestRequestInFlight.load(std::memory_order_relaxed);
+  for (auto& req : s_inflightRequests) {
+    if (req.startTime != oldestStart || req.timedOut) continue;
+    if (!req.threadInfo) continue;
+    auto msg = folly::format("Oldest request ({}) has pinned the treadmill "
+                             "for {} seconds; timing it out.",
+                             getSessionKindName(req.sessionKind),
+                             ageOldest).str();
+    Logger::Warning(msg);
+    req.threadInfo->m_reqInjectionData.setFlag(TimedOutFlag);
+    req.timedOut = true;
+    static auto s_lagTimeoutCounter = ServiceData::createTimeSeries(
+      "treadmill.lag_timeouts", {ServiceData::StatsType::COUNT}
+    );
+    s_lagTimeoutCounter->addValue(1);
+  }
+}
+
 void refreshStats() {
   static ServiceData::ExportedCounter* s_oldestRequestAgeStat =
     ServiceData::createCounter("treadmill.age");
+  static ServiceData::ExportedCounter* s_inflightRequestsStat =
+    ServiceData::createCounter("treadmill.inflight");
   s_oldestRequestAgeStat->setValue(getAgeOldestRequest());
+  int64_t inflight = 0;
+  for (auto const& req : s_inflightRequests) {
+    if (req.startTime != kIdleGenCount) ++inflight;
+  }
+  s_inflightRequestsStat->setValue(inflight);
 }
 
 }
@@ -177,15 +227,19 @@ void startRequest(SessionKind session_kind) {
     GenCountGuard g;
     refreshStats();
     checkOldest();
+    enforceLagBudget();
     if (threadIdx >= s_inflightRequests.size()) {
       s_inflightRequests.resize(
-        threadIdx + 1, {kIdleGenCount, 0, SessionKind::None});
+        threadIdx + 1, {kIdleGenCount, 0, SessionKind::None, nullptr, false});
     } else {
       assertx(s_inflightRequests[threadIdx].startTime == kIdleGenCount);
     }
     s_inflightRequests[threadIdx].startTime = correctTime(startTime);
     s_inflightRequests[threadIdx].pthreadId = Process::GetThreadId();
     s_inflightRequests[threadIdx].sessionKind = session_kind;
+    s_inflightRequests[threadIdx].threadInfo =
+      ThreadInfo::s_threadInfo.isNull() ? nullptr : &TI();
+    s_inflightRequests[threadIdx].timedOut = false;
     FTRACE(1, "threadIdx {} pthreadId {} start @gen {}\n", threadIdx,
            s_inflightRequests[threadIdx].pthreadId,
            s_inflightRequests[threadIdx].startTime);
@@ -209,6 +263,7 @@ void finishRequest() {
     assertx(s_inflightRequests[threadIdx].startTime != kIdleGenCount);
     GenCount finishedRequest = s_inflightRequests[threadIdx].startTime;
     s_inflightRequests[threadIdx].startTime = kIdleGenCount;
+    s_inflightRequests[threadIdx].threadInfo = nullptr;
 
     // After finishing a request, check to see if we've allowed any triggers
     // to fire and update the time of the oldest request in flight.
@@ -339,14 +394,17 @@ std::string dumpTreadmillInfo() {
       s_inflightRequests.size()
   );
 
+  auto const now = getTime();
   for (auto& req : s_inflightRequests) {
     if (req.startTime != kIdleGenCount) {
       folly::format(
           &out,
-          "{} {} {}{}\n",
+          "{} {} {} AgeSeconds: {}{}{}\n",
           req.pthreadId,
           req.startTime,
           getSessionKindName(req.sessionKind),
+          (now - req.startTime) / ONE_SEC_IN_MICROSEC,
+          req.timedOut ? " TIMED-OUT" : "",
           req.startTime == oldestStart ? " OLDEST" : ""
       );
     }
@@ -63,6 +63,8 @@ namespace {
 
 bool warmingUp;
 std::atomic<int64_t> numRequests;
+std::atomic<int64_t> numProfiledRequests;
+std::atomic<int64_t> profileTickets;
 std::atomic<bool> singleJitLock;
 __thread bool acquiredSingleJit = false;
 std::atomic<int> singleJitConcurrentCount;
@@ -199,7 +201,8 @@ int singleJitRequestCount() {
 }
 
 static inline bool doneProfiling() {
-  return requestCount() >= RuntimeOption::EvalJitProfileInterpRequests ||
+  return numProfiledRequests.load(std::memory_order_relaxed) >=
+    RuntimeOption::EvalJitProfileInterpRequests ||
     (!RuntimeOption::ServerExecutionMode() &&
      !RuntimeOption::EvalJitProfileRecord);
 }
@@ -209,7 +212,19 @@ static inline RequestKind getRequestKind() {
   if (warmingUp) return RequestKind::Warmup;
   if (doneProfiling()) return RequestKind::Standard;
   if (RuntimeOption::ServerExecutionMode() ||
-      RuntimeOption::EvalJitProfileRecord) return RequestKind::Profile;
+      RuntimeOption::EvalJitProfileRecord) {
+    // With a stride of N, only every Nth eligible request is actually
+    // profiled; the rest run as standard requests at full speed.  Since
+    // doneProfiling() counts profiled requests, the same number of requests
+    // feed the profile either way -- they're just spread across N times as
+    // many total requests.
+    auto const stride = RuntimeOption::EvalJitProfileRequestStride;
+    if (stride > 1 &&
+        profileTickets.fetch_add(1, std::memory_order_relaxed) % stride != 0) {
+      return RequestKind::Standard;
+    }
+    return RequestKind::Profile;
+  }
   return RequestKind::Standard;
 }
 
@@ -310,6 +325,9 @@ static void checkRFH(int64_t finished) {
 
 void profileRequestEnd() {
   if (warmingUp || requestKind == RequestKind::NonVM) return;
+  if (requestKind == RequestKind::Profile) {
+    numProfiledRequests.fetch_add(1, std::memory_order_relaxed);
+  }
   auto const finished = numRequests.fetch_add(1, std::memory_order_relaxed) + 1;
   static auto const requestSeries = ServiceData::createTimeSeries(
     "vm.requests",
@@ -75,7 +75,8 @@ using MergeKind = Unit::MergeKind;
 ///////////////////////////////////////////////////////////////////////////////
 
 static ReadOnlyArena& get_readonly_arena() {
-  static ReadOnlyArena arena(RuntimeOption::EvalHHBCArenaChunkSize);
+  static ReadOnlyArena arena(RuntimeOption::EvalHHBCArenaChunkSize,
+                             RuntimeOption::EvalHHBCArenaHugePages);
   return arena;
 }
 
@@ -417,6 +418,16 @@ void UnitEmitter::insertMergeableTypeAlias(int ix, Unit::MergeKind kind,
 ///////////////////////////////////////////////////////////////////////////////
 // Initialization and execution.
 
+void UnitEmitter::preserializeArrays() {
+  assertx(m_serializedArrays.empty());
+  m_serializedArrays.reserve(m_arrays.size());
+  for (auto const arr : m_arrays) {
+    m_serializedArrays.emplace_back(
+      internal_serialize(VarNR(const_cast<ArrayData*>(arr))).toCppString()
+    );
+  }
+}
+
 void UnitEmitter::commit(UnitOrigin unitOrigin) {
   Repo& repo = Repo::get();
   try {
@@ -446,6 +457,17 @@ RepoStatus UnitEmitter::insert(UnitOrigin unitOrigin, RepoTxn& txn) {
 
   try {
     {
+      // The unit is content-addressed: if a unit with the same md5 (and
+      // hence byte-identical source) is already stored -- common with
+      // generated files -- reuse it instead of storing a second copy.
+      // The FileMd5 row aliasing our path to the md5 is inserted by the
+      // caller either way, so loads by path find the shared unit.
+      int64_t unitSn = -1;
+      if (urp.getUnitSnByMd5[repoId].get(txn, m_md5, unitSn) ==
+          RepoStatus::success) {
+        m_sn = unitSn;
+        return RepoStatus::success;
+      }
       if (!m_sourceLocTab.empty()) {
         m_lineTable = createLineTable(m_sourceLocTab, m_bclen);
       }
@@ -457,13 +479,9 @@ RepoStatus UnitEmitter::insert(UnitOrigin unitOrigin, RepoTxn& txn) {
     for (unsigned i = 0; i < m_litstrs.size(); ++i) {
       urp.insertUnitLitstr[repoId].insert(txn, usn, i, m_litstrs[i]);
     }
+    if (m_serializedArrays.size() != m_arrays.size()) preserializeArrays();
     for (unsigned i = 0; i < m_arrays.size(); ++i) {
-      urp.insertUnitArray[repoId].insert(
-        txn, usn, i,
-        internal_serialize(
-          VarNR(const_cast<ArrayData*>(m_arrays[i]))
-        ).toCppString()
-      );
+      urp.insertUnitArray[repoId].insert(txn, usn, i, m_serializedArrays[i]);
     }
     urp.insertUnitArrayTypeTable[repoId].insert(txn, usn, m_arrayTypeTable);
     for (auto& fe : m_fes) {
@@ -642,6 +660,17 @@ std::unique_ptr<Unit> UnitEmitter::create(bool saveLineTable) const {
   Unit::MergeInfo *mi = Unit::MergeInfo::alloc(ix);
   u->m_mergeInfo.store(mi, std::memory_order_relaxed);
   ix = 0;
+  /*
+   * Every Func in the unit is materialized here, even though most are never
+   * called in a given process.  We can't currently defer this: MergeInfo
+   * stores raw Func* entries that per-request merging walks to define
+   * hoistable functions, and getMain() needs the pseudomain immediately.
+   * What is deferred is the expensive global registration -- methods don't
+   * get FuncIds until their Class is created (see Func::init), and the
+   * source-loc table is demand-loaded.  Making the Funcs themselves lazy
+   * would mean keeping the FuncEmitters (or their repo blobs) alive past
+   * this point and teaching the merge path to work from a name index.
+   */
   for (auto& fe : m_fes) {
     auto const func = fe->create(*u);
     if (func->top()) {
@@ -977,6 +1006,25 @@ void UnitRepoProxy::InsertUnitStmt
   unitSn = query.getInsertedRowid();
 }
 
+RepoStatus UnitRepoProxy::GetUnitSnByMd5Stmt::get(RepoTxn& txn,
+                                                  const MD5& md5,
+                                                  int64_t& unitSn) {
+  if (!prepared()) {
+    std::stringstream ssSelect;
+    ssSelect << "SELECT unitSn FROM " << m_repo.table(m_repoId, "Unit")
+             << " WHERE md5 == @md5;";
+    txn.prepare(*this, ssSelect.str());
+  }
+  RepoTxnQuery query(txn, *this);
+  query.bindMd5("@md5", md5);
+  query.step();
+  if (!query.row()) {
+    return RepoStatus::error;
+  }
+  query.getInt64(0, unitSn);
+  return RepoStatus::success;
+}
+
 RepoStatus UnitRepoProxy::GetUnitStmt::get(UnitEmitter& ue, const MD5& md5) {
   try {
     RepoTxn txn(m_repo);
@@ -83,6 +83,15 @@ struct UnitEmitter {
    */
   RepoStatus insert(UnitOrigin unitOrigin, RepoTxn& txn);
 
+  /*
+   * Serialize the unit's scalar arrays ahead of insert().  This is the
+   * CPU-heavy part of committing a unit, and it doesn't touch the repo, so
+   * callers with many units to write can run it on other threads while a
+   * single writer performs the sqlite transactions.  insert() runs it
+   * on demand if it hasn't happened yet.
+   */
+  void preserializeArrays();
+
   /*
    * Instatiate a runtime Unit*.
    */
@@ -417,6 +426,11 @@ private:
   hphp_hash_map<const ArrayData*, Id> m_array2id;
   std::vector<const ArrayData*> m_arrays;
 
+  /*
+   * Serialized forms of m_arrays, filled in by preserializeArrays().
+   */
+  std::vector<std::string> m_serializedArrays;
+
   /*
    * Unit local array type table.
    */
@@ -504,6 +518,14 @@ struct UnitRepoProxy : public RepoProxy {
     GetUnitStmt(Repo& repo, int repoId) : Stmt(repo, repoId) {}
     RepoStatus get(UnitEmitter& ue, const MD5& md5);
   };
+  struct GetUnitSnByMd5Stmt : public RepoProxy::Stmt {
+    GetUnitSnByMd5Stmt(Repo& repo, int repoId) : Stmt(repo, repoId) {}
+    // Returns success and sets `unitSn' iff a unit with this md5 is
+    // already stored; runs inside the caller's transaction so it sees
+    // units inserted earlier in the same batch.
+    RepoStatus get(RepoTxn& txn, const MD5& md5, int64_t& unitSn);
+    // throws(RepoExc)
+  };
   struct InsertUnitLitstrStmt : public RepoProxy::Stmt {
     InsertUnitLitstrStmt(Repo& repo, int repoId) : Stmt(repo, repoId) {}
     void insert(RepoTxn& txn, int64_t unitSn, Id litstrId,
@@ -556,6 +578,7 @@ struct UnitRepoProxy : public RepoProxy {
 #define URP_OPS \
   URP_IOP(Unit) \
   URP_GOP(Unit) \
+  URP_GOP(UnitSnByMd5) \
   URP_IOP(UnitLitstr) \
   URP_GOP(UnitLitstrs) \
   URP_IOP(UnitArrayTypeTable) \
@@ -0,0 +1,17 @@
+<?php
+
+
+<<__EntryPoint>>
+function main_bulk() {
+var_dump(apc_store_bulk(array("bk_a" => 1, "bk_b" => "two", "bk_c" => array(3))));
+
+$got = apc_fetch_bulk(array("bk_a", "bk_missing", "bk_c", "bk_b"));
+var_dump($got);
+
+// Bulk stores overwrite like apc_store.
+var_dump(apc_store_bulk(array("bk_a" => 10)));
+var_dump(apc_fetch_bulk(array("bk_a")));
+
+// Empty input round-trips.
+var_dump(apc_fetch_bulk(array()));
+}
@@ -0,0 +1,31 @@
+<?php
+
+
+<<__EntryPoint>>
+function main_fetch_stale() {
+// Missing key: miss, never stale.
+$v = apc_fetch_stale("fs_missing", 60, $success, $stale);
+var_dump($v, $success, $stale);
+
+// Key with no TTL: plain hit, never inside a grace window.
+apc_store("fs_forever", "v0");
+$v = apc_fetch_stale("fs_forever", 60, $success, $stale);
+var_dump($v, $success, $stale);
+
+// Key whose TTL is entirely inside the grace window: the value is still
+// served, and only the first caller is told to refresh it.
+apc_store("fs_soon", "v1", 5);
+$v = apc_fetch_stale("fs_soon", 60, $success, $stale);
+var_dump($v, $success, $stale);
+$v = apc_fetch_stale("fs_soon", 60, $success, $stale);
+var_dump($v, $success, $stale);
+
+// Storing a new value re-arms the window for the next refresher.
+apc_store("fs_soon", "v2", 5);
+$v = apc_fetch_stale("fs_soon", 60, $success, $stale);
+var_dump($v, $success, $stale);
+
+// A zero grace window behaves like apc_fetch.
+$v = apc_fetch_stale("fs_soon", 0, $success, $stale);
+var_dump($v, $success, $stale);
+}
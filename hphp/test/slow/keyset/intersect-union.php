@@ -0,0 +1,32 @@
+<?hh
+
+echo "intersect: ";
+var_dump(HH\keyset_intersect(keyset[1, 2, 3, 'a'], keyset['a', 3, 5]));
+echo "intersect empty lhs: ";
+var_dump(HH\keyset_intersect(keyset[], keyset[1, 2]));
+echo "intersect empty rhs: ";
+var_dump(HH\keyset_intersect(keyset[1, 2], keyset[]));
+echo "intersect disjoint: ";
+var_dump(HH\keyset_intersect(keyset[1, 2], keyset[3, 4]));
+echo "intersect int/str keys stay distinct: ";
+var_dump(HH\keyset_intersect(keyset[1, '1'], keyset['1']));
+
+echo "union: ";
+var_dump(HH\keyset_union(keyset[1, 2, 'a'], keyset['a', 3, 1]));
+echo "union empty lhs: ";
+var_dump(HH\keyset_union(keyset[], keyset[1, 2]));
+echo "union empty rhs: ";
+var_dump(HH\keyset_union(keyset[1, 2], keyset[]));
+echo "union both empty: ";
+var_dump(HH\keyset_union(keyset[], keyset[]));
+
+try {
+  HH\keyset_intersect(vec[1], keyset[1]);
+} catch (InvalidArgumentException $e) {
+  echo "intersect exception: ", $e->getMessage(), "\n";
+}
+try {
+  HH\keyset_union(keyset[1], dict[1 => 1]);
+} catch (InvalidArgumentException $e) {
+  echo "union exception: ", $e->getMessage(), "\n";
+}
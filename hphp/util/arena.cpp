@@ -50,6 +50,7 @@ ArenaImpl<kChunkBytes>::ArenaImpl() {
 
 template<size_t kChunkBytes>
 ArenaImpl<kChunkBytes>::~ArenaImpl() {
+  runDtors(nullptr);
   for (size_t i = 0, sz = m_ptrs.size(); i < sz; ++i) {
     free(m_ptrs[i]);
   }
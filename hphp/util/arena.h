@@ -19,6 +19,8 @@
 #include <vector>
 #include <cstdlib>
 #include <cstring>
+#include <new>
+#include <utility>
 
 #include "hphp/util/pointer-list.h"
 
@@ -29,7 +31,8 @@ namespace HPHP {
 /**
  * Arena/ArenaImpl is an allocator that frees all memory when the
  * arena instance is destroyed.  No destructors of allocated objects
- * will be called!  It is a bump-pointer allocator.
+ * will be called unless they are registered with onFrameEnd() or the
+ * objects are created with allocD()!  It is a bump-pointer allocator.
  *
  * At various points in the lifetime of the arena, you can introduce a
  * new `frame' by calling beginFrame.  This is essentially a marker of
@@ -89,14 +92,38 @@ struct ArenaImpl {
   void beginFrame();
   void endFrame();
 
+  /*
+   * Register a callback to run when the innermost open frame ends (or,
+   * if no frame is open, when the arena is destroyed).  Callbacks run
+   * in reverse registration order.  Both beginFrame/endFrame and
+   * registration are O(1); endFrame pays only for the callbacks
+   * registered inside the frame it closes.
+   */
+  void onFrameEnd(void (*fn)(void*), void* obj);
+
+  /*
+   * Allocate and construct a T whose destructor runs at the end of the
+   * innermost open frame (or at arena destruction).  Use this for
+   * speculative scratch objects that own real resources; plain alloc()
+   * remains destructor-free.
+   */
+  template<class T, class... Args> T* allocD(Args&&... args);
+
  private:
   // copying Arenas will end badly.
   ArenaImpl(const ArenaImpl&);
   ArenaImpl& operator=(const ArenaImpl&);
 
  private:
+  struct Dtor {
+    Dtor* prev;
+    void (*fn)(void*);
+    void* obj;
+  };
+
   struct Frame {
     Frame*   prev;
+    Dtor*    dtors;
     uint32_t index;
     uint32_t offset;
   };
@@ -106,6 +133,7 @@ struct ArenaImpl {
  private:
   void* allocSlow(size_t nbytes);
   void createSlab();
+  void runDtors(Dtor* until);
 
  private:
   char* m_current;
@@ -143,14 +171,65 @@ inline void ArenaImpl<kChunkBytes>::beginFrame() {
 template<size_t kChunkBytes>
 inline void ArenaImpl<kChunkBytes>::endFrame() {
   assert(m_frame.prev);
-  m_frame = *m_frame.prev;
+  Frame saved = *m_frame.prev;
+  runDtors(saved.dtors);
+  m_frame = saved;
   m_current = m_ptrs[m_frame.index];
 }
 
+template<size_t kChunkBytes>
+inline void ArenaImpl<kChunkBytes>::runDtors(Dtor* until) {
+  for (Dtor* d = m_frame.dtors; d != until; d = d->prev) {
+    d->fn(d->obj);
+  }
+  m_frame.dtors = until;
+}
+
+template<size_t kChunkBytes>
+inline void ArenaImpl<kChunkBytes>::onFrameEnd(void (*fn)(void*), void* obj) {
+  auto rec = static_cast<Dtor*>(alloc(sizeof(Dtor)));
+  rec->prev = m_frame.dtors;
+  rec->fn = fn;
+  rec->obj = obj;
+  m_frame.dtors = rec;
+}
+
+template<size_t kChunkBytes>
+template<class T, class... Args>
+inline T* ArenaImpl<kChunkBytes>::allocD(Args&&... args) {
+  auto obj = new (alloc(sizeof(T))) T(std::forward<Args>(args)...);
+  onFrameEnd([] (void* o) { static_cast<T*>(o)->~T(); }, obj);
+  return obj;
+}
+
 void SetArenaSlabAllocBypass(bool f);
 
 //////////////////////////////////////////////////////////////////////
 
+/*
+ * RAII checkpoint for framed arena allocation.  Opens a frame on
+ * construction and closes it (running destructors registered inside
+ * the frame) when the scope exits, so speculative passes can roll back
+ * all of their scratch allocations wholesale on failure.
+ */
+template<size_t kChunkBytes>
+struct ArenaFrameGuard {
+  explicit ArenaFrameGuard(ArenaImpl<kChunkBytes>& arena)
+    : m_arena(arena)
+  {
+    m_arena.beginFrame();
+  }
+  ~ArenaFrameGuard() { m_arena.endFrame(); }
+
+  ArenaFrameGuard(const ArenaFrameGuard&) = delete;
+  ArenaFrameGuard& operator=(const ArenaFrameGuard&) = delete;
+
+ private:
+  ArenaImpl<kChunkBytes>& m_arena;
+};
+
+//////////////////////////////////////////////////////////////////////
+
 } // HPHP
 
 // These global-operator-new declarations cannot be in a namespace,
@@ -29,6 +29,7 @@
 #include "hphp/util/hugetlb.h"
 #include "hphp/util/maphuge.h"
 #include "hphp/util/numa.h"
+#include "hphp/util/thread-registry.h"
 
 namespace HPHP {
 ///////////////////////////////////////////////////////////////////////////////
@@ -73,7 +74,9 @@ void *AsyncFuncImpl::ThreadFunc(void *obj) {
 
   set_numa_binding(self->m_node);
   self->setThreadName();
+  ThreadRegistry::registerSelf(self->m_threadGroup);
   self->threadFuncImpl();
+  ThreadRegistry::unregisterSelf();
   return nullptr;
 }
 
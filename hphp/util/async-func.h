@@ -168,6 +168,12 @@ struct AsyncFuncImpl {
 
   void setNoInitFini() { m_noInitFini = true; }
 
+  /**
+   * Names the group this thread is accounted under in ThreadRegistry.
+   * `group` must have static storage duration. Call before start().
+   */
+  void setThreadGroup(const char* group) { m_threadGroup = group; }
+
   void setThreadName();
 
   static uint32_t count() { return s_count; }
@@ -195,6 +201,7 @@ private:
   Exception* m_exception{nullptr};
   bool m_stopped{false};
   bool m_noInitFini{false};
+  const char* m_threadGroup{"async-func"};
   /**
    * Called by ThreadFunc() to delegate the work.
    */
@@ -28,11 +28,17 @@ template<size_t NBITS> struct BloomFilter {
   static size_t h1(size_t h) { return h % NBITS; }
   static size_t h2(size_t h) { return (h / NBITS) % NBITS; }
   void insert(T x) {
-    auto h = hash_int64(intptr_t(x));
-    bits_.set(h1(h)).set(h2(h));
+    insertHash(hash_int64(intptr_t(x)));
   }
   bool test(T x) const {
-    auto h = hash_int64(intptr_t(x));
+    return testHash(hash_int64(intptr_t(x)));
+  }
+  // For keys that aren't pointers, callers can hash them however is
+  // appropriate and insert/test the hash directly.
+  void insertHash(size_t h) {
+    bits_.set(h1(h)).set(h2(h));
+  }
+  bool testHash(size_t h) const {
     return bits_.test(h1(h)) & bits_.test(h2(h));
   }
   void clear() {
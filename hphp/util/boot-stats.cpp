@@ -21,6 +21,12 @@
 #include "hphp/util/timer.h"
 #include "hphp/util/trace.h"
 
+#include <folly/dynamic.h>
+#include <folly/json.h>
+
+#include <cstdio>
+#include <vector>
+
 namespace HPHP {
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -67,12 +73,23 @@ struct BootStats::Impl {
   Impl() : m_last(ResourceUsage::sinceEpoch()) {}
 
   void add(const std::string& info, ResourceUsage value);
+  void addSpan(const std::string& name, ResourceUsage start, ResourceUsage end);
   void dumpMarks();
+  void writeTrace(const std::string& file);
   ResourceUsage computeDeltaFromLast();
 
   friend struct BootStats;
 
 private:
+  // One timed interval during boot.  Offsets are relative to s_start, so
+  // spans from different threads line up on a common timeline.
+  struct Span {
+    std::string name;
+    pid_t tid;
+    int64_t startUs;
+    int64_t durUs;
+  };
+
   // Must hold when updating m_last
   std::mutex m_last_guard_;
   ResourceUsage m_last;
@@ -80,6 +97,8 @@ private:
   std::map<std::string, ResourceUsage> m_marks;
   std::map<std::string, std::string> m_strs;
   std::map<std::string, int64_t> m_ints;
+  std::mutex m_spans_guard_;
+  std::vector<Span> m_spans;
 };
 
 void BootStats::Impl::add(const std::string& info, ResourceUsage value) {
@@ -87,12 +106,55 @@ void BootStats::Impl::add(const std::string& info, ResourceUsage value) {
   m_marks[info] = m_marks[info] + value;
 }
 
+void BootStats::Impl::addSpan(const std::string& name,
+                              ResourceUsage start, ResourceUsage end) {
+  Span span;
+  span.name = name;
+  span.tid = Process::GetThreadPid();
+  span.startUs = std::chrono::duration_cast<std::chrono::microseconds>(
+    (start - BootStats::s_start).wall()).count();
+  span.durUs = std::chrono::duration_cast<std::chrono::microseconds>(
+    (end - start).wall()).count();
+  std::lock_guard<std::mutex> lock(m_spans_guard_);
+  m_spans.push_back(std::move(span));
+}
+
 void BootStats::Impl::dumpMarks() {
   for (const auto& it : m_marks) {
     Logger::FInfo("BootStats: {} = {}", it.first, it.second.toString());
   }
 }
 
+// Chrome-trace format: {"traceEvents": [{"ph": "X", ...}, ...]}, one
+// complete event per span.  Trace viewers nest overlapping events on the
+// same tid by containment, so nested Blocks come out as a flame profile
+// without us tracking parent/child explicitly.
+void BootStats::Impl::writeTrace(const std::string& file) {
+  folly::dynamic events = folly::dynamic::array;
+  {
+    std::lock_guard<std::mutex> lock(m_spans_guard_);
+    for (auto const& span : m_spans) {
+      events.push_back(folly::dynamic::object
+        ("name", span.name)
+        ("ph", "X")
+        ("pid", getpid())
+        ("tid", span.tid)
+        ("ts", span.startUs)
+        ("dur", span.durUs));
+    }
+  }
+  folly::dynamic trace = folly::dynamic::object("traceEvents", events);
+  auto const json = folly::toJson(trace);
+  auto f = fopen(file.c_str(), "w");
+  if (f == nullptr) {
+    Logger::FError("BootStats: could not write startup trace to {}", file);
+    return;
+  }
+  fwrite(json.data(), 1, json.size(), f);
+  fclose(f);
+  Logger::FInfo("BootStats: wrote startup trace to {}", file);
+}
+
 ResourceUsage BootStats::Impl::computeDeltaFromLast() {
   std::lock_guard<std::mutex> lock(m_last_guard_);
   auto now = ResourceUsage::sinceEpoch();
@@ -113,9 +175,11 @@ BootStats::Block::Block(const std::string& name, bool enabled) {
 
 BootStats::Block::~Block() {
   if (!m_enabled) return;
-  auto total = ResourceUsage::sinceEpoch() - m_start;
+  auto now = ResourceUsage::sinceEpoch();
+  auto total = now - m_start;
   Logger::FInfo("BootStats: {} block done, took {}", m_name, total.toString());
   BootStats::add(m_name, total);
+  BootStats::addSpan(m_name, m_start, now);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -123,6 +187,7 @@ BootStats::Block::~Block() {
 bool BootStats::s_started;
 ResourceUsage BootStats::s_start;
 std::unique_ptr<BootStats::Impl> BootStats::s_instance;
+std::string BootStats::ProfileFile;
 
 void BootStats::start() {
   BootStats::s_started = true;
@@ -160,6 +225,12 @@ void BootStats::done() {
     }
     StructuredLog::log("hhvm_boot_memory", cols);
   }
+
+  if (!ProfileFile.empty()) {
+    // An enclosing span for the whole boot gives the trace a root frame.
+    s_instance->addSpan("TOTAL", s_start, s_start + total);
+    s_instance->writeTrace(ProfileFile);
+  }
 }
 
 void BootStats::mark(const std::string& info) {
@@ -167,6 +238,8 @@ void BootStats::mark(const std::string& info) {
   auto elapsed = BootStats::s_instance->computeDeltaFromLast();
   Logger::FInfo("BootStats: {} done, took {}", info, elapsed.toString());
   BootStats::s_instance->add(info, elapsed);
+  auto const now = ResourceUsage::sinceEpoch();
+  BootStats::s_instance->addSpan(info, now - elapsed, now);
 }
 
 void BootStats::add(const std::string& info, const ResourceUsage value) {
@@ -174,6 +247,12 @@ void BootStats::add(const std::string& info, const ResourceUsage value) {
   BootStats::s_instance->add(info, value);
 }
 
+void BootStats::addSpan(const std::string& name,
+                        ResourceUsage start, ResourceUsage end) {
+  if (!s_started) return;
+  BootStats::s_instance->addSpan(name, start, end);
+}
+
 void BootStats::set(const std::string& name, const std::string& value) {
   if (!s_started) return;
   BootStats::s_instance->m_strs[name] = value;
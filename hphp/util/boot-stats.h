@@ -66,6 +66,11 @@ struct ResourceUsage {
  *   start or from the last call to mark();
  * - using an instance of the BootStats::Block class during startup
  *   automatically collects a sample.
+ *
+ * Besides the flat per-name totals, every sample is also kept as a span
+ * (name, thread, start offset, duration).  When ProfileFile is set, done()
+ * writes the spans out in chrome-trace format, so nested Blocks render as a
+ * startup flame profile in a trace viewer and can be diffed across releases.
  */
 struct BootStats {
   // Creates a new instance and starts the timer
@@ -86,6 +91,11 @@ struct BootStats {
   // Add a column with name and int value.
   static void set(const std::string& name, int64_t value);
 
+  // If non-empty, done() writes every recorded span to this path as a
+  // chrome-trace JSON file ("traceEvents" of complete events, with thread
+  // attribution).  Set from the Stats.BootProfileFile runtime option.
+  static std::string ProfileFile;
+
   struct Block {
     explicit Block(const std::string& name, bool enabled);
     ~Block();
@@ -98,6 +108,8 @@ struct BootStats {
 
  private:
   static void add(const std::string& name, const ResourceUsage value);
+  static void addSpan(const std::string& name,
+                      ResourceUsage start, ResourceUsage end);
 
   struct Impl;
 
@@ -47,41 +47,33 @@ CacheManager::~CacheManager() {}
 bool CacheManager::getFileContents(const std::string& name, const char** data,
                                    uint64_t* data_len,
                                    bool* compressed) const {
-  const auto it = m_cache_map.find(name);
+  auto cd = findEntry(name);
 
-  if (it == m_cache_map.end()) {
+  if (cd == nullptr) {
     return false;
   }
 
-  if (s_logger && !it->second->dataFetched()) {
+  if (s_logger && !cd->dataFetched()) {
     s_logger(false, name);
   }
 
-  const CacheData& cd = *it->second;
-  return cd.getDataPointer(data, data_len, compressed);
+  return cd->getDataPointer(data, data_len, compressed);
 }
 
 bool CacheManager::getDecompressed(const std::string& name,
                                    std::string* data) const {
-  const auto it = m_cache_map.find(name);
+  auto cd = findEntry(name);
 
-  if (it == m_cache_map.end()) {
+  if (cd == nullptr) {
     return false;
   }
 
-  const CacheData& cd = *it->second;
-  return cd.getDecompressedData(data);
+  return cd->getDecompressedData(data);
 }
 
 bool CacheManager::isCompressed(const std::string& name) const {
-  const auto it = m_cache_map.find(name);
-
-  if (it == m_cache_map.end()) {
-    return false;
-  }
-
-  const CacheData& cd = *it->second;
-  return cd.isCompressed();
+  auto cd = findEntry(name);
+  return cd != nullptr && cd->isCompressed();
 }
 
 bool CacheManager::addFileContents(const std::string& name,
@@ -96,7 +88,7 @@ bool CacheManager::addFileContents(const std::string& name,
     return false;
   }
 
-  m_cache_map[name] = std::move(cd);
+  addEntry(name, std::move(cd));
 
   addDirectories(name);
 
@@ -111,7 +103,7 @@ bool CacheManager::addEmptyEntry(const std::string& name) {
   std::unique_ptr<CacheData> cd(new CacheData);
   cd->createEmpty(name, m_entry_counter++);
 
-  m_cache_map[name] = std::move(cd);
+  addEntry(name, std::move(cd));
 
   addDirectories(name);
 
@@ -120,10 +112,8 @@ bool CacheManager::addEmptyEntry(const std::string& name) {
 
 template<class F>
 bool CacheManager::existsHelper(const std::string& name, F fn) const {
-  auto it = m_cache_map.find(name);
-  if (it == m_cache_map.end()) return false;
-
-  auto cd = it->second.get();
+  auto cd = findEntry(name);
+  if (cd == nullptr) return false;
 
   if (!fn(cd)) return false;
 
@@ -158,26 +148,20 @@ bool CacheManager::emptyEntryExists(const std::string& name) const {
 
 bool CacheManager::getUncompressedFileSize(const std::string& name,
                                            uint64_t* size) const {
-  const auto it = m_cache_map.find(name);
+  auto cd = findEntry(name);
 
-  if (it == m_cache_map.end()) {
+  if (cd == nullptr || !cd->isRegularFile()) {
     return false;
   }
 
-  const CacheData& cd = *it->second;
-
-  if (!cd.isRegularFile()) {
-    return false;
-  }
-
-  if (!cd.isCompressed()) {
-    *size = cd.fileSize();
+  if (!cd->isCompressed()) {
+    *size = cd->fileSize();
     return true;
   }
 
   std::string data;
 
-  if (!cd.getDecompressedData(&data)) {
+  if (!cd->getDecompressedData(&data)) {
     return false;
   }
 
@@ -209,6 +193,8 @@ bool CacheManager::loadCache(const std::string& path) {
     return false;
   }
 
+  m_cache_index.reserve(dirlen);
+
   for (uint64_t i = 0; i < dirlen; ++i) {
     std::unique_ptr<CacheData> cd(new CacheData);
 
@@ -217,7 +203,7 @@ bool CacheManager::loadCache(const std::string& path) {
       return false;
     }
 
-    m_cache_map[name] = std::move(cd);
+    addEntry(name, std::move(cd));
   }
 
   uint64_t dirterm;
@@ -286,6 +272,17 @@ void CacheManager::getEntryNames(std::set<std::string>* names) const {
 
 // --- Private functions.
 
+CacheData* CacheManager::findEntry(const std::string& name) const {
+  const auto it = m_cache_index.find(name);
+  return it == m_cache_index.end() ? nullptr : it->second;
+}
+
+void CacheManager::addEntry(const std::string& name,
+                            std::unique_ptr<CacheData> cd) {
+  m_cache_index[name] = cd.get();
+  m_cache_map[name] = std::move(cd);
+}
+
 void CacheManager::addDirectories(const std::string& path) {
 
   if (path.empty()) {
@@ -298,16 +295,16 @@ void CacheManager::addDirectories(const std::string& path) {
       auto pathdir = path.substr(start, i);
       std::unique_ptr<CacheData> cd(new CacheData);
       cd->createDirectory(pathdir, m_entry_counter++);
-      m_cache_map[pathdir] = std::move(cd);
+      addEntry(pathdir, std::move(cd));
     }
   }
 }
 
 VFileType CacheManager::getFileType(const std::string& name) const {
-  auto file = m_cache_map.find(name);
+  auto cd = findEntry(name);
 
-  if (file == m_cache_map.end()) return VFileType::NotFound;
-  if (file->second->isDirectory()) return VFileType::Directory;
+  if (cd == nullptr) return VFileType::NotFound;
+  if (cd->isDirectory()) return VFileType::Directory;
   return VFileType::PlainFile;
 }
 
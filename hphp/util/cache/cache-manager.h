@@ -37,6 +37,8 @@
 #include <vector>
 #include <functional>
 
+#include "hphp/util/hash-map.h"
+
 namespace HPHP {
 
 struct CacheData;
@@ -126,16 +128,25 @@ struct CacheManager {
   }
  private:
   using CacheMap = std::map<std::string, std::unique_ptr<CacheData>>;
+  using CacheIndex = hphp_fast_map<std::string, CacheData*, string_hash>;
 
   template<class F>
   bool existsHelper(const std::string& name, F fn) const;
 
+  // Hash-indexed lookup for the serving hot path.  Returns nullptr if
+  // no entry exists under <name>.
+  CacheData* findEntry(const std::string& name) const;
+
+  void addEntry(const std::string& name, std::unique_ptr<CacheData> cd);
   void addDirectories(const std::string& name);
 
   std::unique_ptr<MmapFile> m_mmap_file;
   uint64_t m_entry_counter{ 0 };
 
+  // The ordered map owns the entries and backs directory iteration and
+  // serialization; the hash index shadows it for O(1) per-request lookups.
   CacheMap m_cache_map;
+  CacheIndex m_cache_index;
 
   static std::function<void(bool, const std::string&)> s_logger;
 };
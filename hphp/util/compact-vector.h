@@ -25,6 +25,10 @@
 #include "hphp/util/assertions.h"
 #include "hphp/util/safe-cast.h"
 
+#ifdef HHVM_TRACK_CONTAINER_STATS
+#include "hphp/util/container-stats.h"
+#endif
+
 namespace HPHP {
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -219,6 +223,12 @@ bool CompactVector<T, A>::operator==(const CompactVector& other) const {
 
 template <typename T, typename A>
 CompactVector<T, A>::~CompactVector() {
+#ifdef HHVM_TRACK_CONTAINER_STATS
+  // Sample at end of life, when the vector has reached its final size and
+  // any slack between size and capacity is permanent.
+  ContainerStats::record("compact_vector.size", size());
+  ContainerStats::record("compact_vector.capacity", capacity());
+#endif
   clear();
 }
 
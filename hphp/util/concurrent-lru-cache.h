@@ -18,6 +18,7 @@
 #define incl_HPHP_UTIL_LRU_CACHE_H
 
 #include <atomic>
+#include <chrono>
 #include <mutex>
 #include <new>
 #include <thread>
@@ -65,14 +66,18 @@ private:
       : m_prev(OutOfListMarker), m_next(nullptr)
     {}
 
-    explicit ListNode(const TKey& key)
-      : m_key(key), m_prev(OutOfListMarker), m_next(nullptr)
+    explicit ListNode(const TKey& key, size_t cost = 1)
+      : m_key(key), m_prev(OutOfListMarker), m_next(nullptr), m_cost(cost)
     {}
 
     TKey m_key;
     ListNode* m_prev;
     ListNode* m_next;
 
+    // The cost charged against the cache's cost budget (e.g. an estimate
+    // of the entry's size in bytes). Immutable after construction.
+    size_t m_cost{1};
+
     bool isInList() const {
       return m_prev != OutOfListMarker;
     }
@@ -89,12 +94,16 @@ private:
       : m_listNode(nullptr)
     {}
 
-    HashMapValue(const TValue& value, ListNode* node)
-      : m_value(value), m_listNode(node)
+    HashMapValue(const TValue& value, ListNode* node,
+                 int64_t deadline = 0)
+      : m_value(value), m_listNode(node), m_deadline(deadline)
     {}
 
     TValue m_value;
     ListNode* m_listNode;
+
+    // Steady-clock second at which the entry expires; 0 means never.
+    int64_t m_deadline{0};
   };
 
   typedef tbb::concurrent_hash_map<TKey, HashMapValue, THash> HashMap;
@@ -134,9 +143,12 @@ public:
   };
 
   /**
-   * Create a container with a given maximum size
+   * Create a container with a given maximum size. If maxCost is non-zero,
+   * the container additionally evicts (one entry per insert, like the
+   * overfill path) whenever the total cost of its entries exceeds the
+   * budget, so callers can bound bytes rather than just entry counts.
    */
-  explicit ConcurrentLRUCache(size_t maxSize);
+  explicit ConcurrentLRUCache(size_t maxSize, size_t maxCost = 0);
 
   ConcurrentLRUCache(const ConcurrentLRUCache& other) = delete;
   ConcurrentLRUCache& operator=(const ConcurrentLRUCache&) = delete;
@@ -149,7 +161,8 @@ public:
    * Find a value by key, and return it by filling the ConstAccessor, which
    * can be default-constructed. Returns true if the element was found, false
    * otherwise. Updates the eviction list, making the element the
-   * most-recently used.
+   * most-recently used. Entries whose TTL has elapsed are treated as
+   * misses and removed.
    */
   bool find(ConstAccessor& ac, const TKey& key);
 
@@ -158,11 +171,17 @@ public:
    * The new element will put into the eviction list as the most-recently
    * used.
    *
+   * `cost' is the amount charged against the cost budget while the entry is
+   * resident (only meaningful when the container was built with a non-zero
+   * maxCost). A non-zero `ttl' makes the entry expire that many seconds
+   * from now; expired entries are reclaimed lazily on lookup.
+   *
    * If there was already an element in the container with the same key, it
    * will not be updated, and false will be returned. Otherwise, true will be
    * returned.
    */
-  bool insert(const TKey& key, const TValue& value);
+  bool insert(const TKey& key, const TValue& value, size_t cost = 1,
+              std::chrono::seconds ttl = std::chrono::seconds::zero());
 
   /**
    * Clear the container. NOT THREAD SAFE -- do not use while other threads
@@ -186,6 +205,13 @@ public:
     return m_size.load();
   }
 
+  /**
+   * Get the approximate total cost of the container's entries.
+   */
+  size_t costSize() const {
+    return m_costSize.load();
+  }
+
 private:
   /**
    * Unlink a node from the list. The caller must lock the list mutex while
@@ -205,11 +231,32 @@ private:
    */
   void evict();
 
+  /**
+   * Remove an entry whose TTL has elapsed. Called from find() when a lookup
+   * hits an expired entry; safe against concurrent eviction of the same
+   * node.
+   */
+  void expire(const TKey& key);
+
+  /**
+   * The current steady-clock time, in seconds. Deadlines are compared
+   * against this, so TTLs are unaffected by wall-clock adjustments.
+   */
+  static int64_t clockSeconds() {
+    return std::chrono::duration_cast<std::chrono::seconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+  }
+
   /**
    * The maximum number of elements in the container.
    */
   size_t m_maxSize;
 
+  /**
+   * The cost budget; zero means cost-based eviction is disabled.
+   */
+  size_t m_maxCost;
+
   /**
    * This atomic variable is used to signal to all threads whether or not
    * eviction should be done on insert. It is approximately equal to the
@@ -217,6 +264,11 @@ private:
    */
   std::atomic<size_t> m_size;
 
+  /**
+   * Approximate total cost of resident entries.
+   */
+  std::atomic<size_t> m_costSize;
+
   /**
    * The underlying TBB hash map.
    */
@@ -239,8 +291,8 @@ ConcurrentLRUCache<TKey, TValue, THash>::OutOfListMarker = (ListNode*)-1;
 
 template <class TKey, class TValue, class THash>
 ConcurrentLRUCache<TKey, TValue, THash>::
-ConcurrentLRUCache(size_t maxSize)
-  : m_maxSize(maxSize), m_size(0),
+ConcurrentLRUCache(size_t maxSize, size_t maxCost)
+  : m_maxSize(maxSize), m_maxCost(maxCost), m_size(0), m_costSize(0),
   m_map(std::thread::hardware_concurrency() * 4) // it will automatically grow
 {
   m_head.m_prev = nullptr;
@@ -256,6 +308,13 @@ find(ConstAccessor& ac, const TKey& key) {
     return false;
   }
 
+  auto const deadline = hashAccessor->second.m_deadline;
+  if (deadline != 0 && clockSeconds() >= deadline) {
+    hashAccessor.release();
+    expire(key);
+    return false;
+  }
+
   // Acquire the lock, but don't block if it is already held
   std::unique_lock<ListMutex> lock(m_listMutex, std::try_to_lock);
   if (lock) {
@@ -274,11 +333,14 @@ find(ConstAccessor& ac, const TKey& key) {
 
 template <class TKey, class TValue, class THash>
 bool ConcurrentLRUCache<TKey, TValue, THash>::
-insert(const TKey& key, const TValue& value) {
+insert(const TKey& key, const TValue& value, size_t cost,
+       std::chrono::seconds ttl) {
   // Insert into the CHM
-  ListNode* node = new ListNode(key);
+  ListNode* node = new ListNode(key, cost);
+  auto const deadline =
+    ttl == std::chrono::seconds::zero() ? 0 : clockSeconds() + ttl.count();
   HashMapAccessor hashAccessor;
-  HashMapValuePair hashMapValue(key, HashMapValue(value, node));
+  HashMapValuePair hashMapValue(key, HashMapValue(value, node, deadline));
   if (!m_map.insert(hashAccessor, hashMapValue)) {
     delete node;
     return false;
@@ -319,6 +381,15 @@ insert(const TKey& key, const TValue& value) {
       evict();
     }
   }
+  m_costSize.fetch_add(cost, std::memory_order_relaxed);
+  if (m_maxCost != 0 && m_costSize.load(std::memory_order_relaxed) > m_maxCost) {
+    // Over the cost budget: evict one entry per insert, mirroring the
+    // count-overfill strategy above, so a burst of threads can't drain the
+    // container below its budget. Unlike the count paths, these evictions
+    // really do shrink the entry count, so keep m_size honest.
+    evict();
+    m_size.fetch_sub(1, std::memory_order_relaxed);
+  }
   return true;
 }
 
@@ -336,6 +407,7 @@ clear() {
   m_head.m_next = &m_tail;
   m_tail.m_prev = &m_head;
   m_size = 0;
+  m_costSize = 0;
 }
 
 template <class TKey, class TValue, class THash>
@@ -386,9 +458,38 @@ evict() {
     return;
   }
   m_map.erase(hashAccessor);
+  m_costSize.fetch_sub(moribund->m_cost, std::memory_order_relaxed);
   delete moribund;
 }
 
+template <class TKey, class TValue, class THash>
+void ConcurrentLRUCache<TKey, TValue, THash>::
+expire(const TKey& key) {
+  HashMapAccessor hashAccessor;
+  if (!m_map.find(hashAccessor, key)) {
+    return;
+  }
+  auto const deadline = hashAccessor->second.m_deadline;
+  if (deadline == 0 || clockSeconds() < deadline) {
+    // Raced with a re-insert of a fresh entry.
+    return;
+  }
+  ListNode* node = hashAccessor->second.m_listNode;
+  {
+    std::lock_guard<ListMutex> lock(m_listMutex);
+    if (!node->isInList()) {
+      // A concurrent evict() already delinked this node and will erase and
+      // free it once we release the hash accessor.
+      return;
+    }
+    delink(node);
+  }
+  m_map.erase(hashAccessor);
+  m_size--;
+  m_costSize.fetch_sub(node->m_cost, std::memory_order_relaxed);
+  delete node;
+}
+
 } // namespace HPHP
 
 #endif
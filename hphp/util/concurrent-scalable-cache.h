@@ -48,8 +48,11 @@ struct ConcurrentScalableCache {
    *   - numShards: the number of child containers. If this is zero, the
    *     "hardware concurrency" will be used (typically the logical processor
    *     count).
+   *   - maxCost: optional total cost budget (e.g. bytes), split evenly
+   *     across the shards like maxSize. Zero disables cost-based eviction.
    */
-  explicit ConcurrentScalableCache(size_t maxSize, size_t numShards = 0);
+  explicit ConcurrentScalableCache(size_t maxSize, size_t numShards = 0,
+                                   size_t maxCost = 0);
 
   ConcurrentScalableCache(const ConcurrentScalableCache&) = delete;
   ConcurrentScalableCache& operator=(const ConcurrentScalableCache&) = delete;
@@ -70,8 +73,15 @@ struct ConcurrentScalableCache {
    * If there was already an element in the container with the same key, it
    * will not be updated, and false will be returned. Otherwise, true will be
    * returned.
+   *
+   * `cost' and `ttl' behave as in ConcurrentLRUCache::insert(): the cost is
+   * charged against the owning shard's budget, and a non-zero ttl expires
+   * the entry that many seconds from insertion. Each shard expires and
+   * evicts independently, so there is no cross-shard synchronization on
+   * either path.
    */
-  bool insert(const TKey& key, const TValue& value);
+  bool insert(const TKey& key, const TValue& value, size_t cost = 1,
+              std::chrono::seconds ttl = std::chrono::seconds::zero());
 
   /**
    * Clear the container. NOT THREAD SAFE -- do not use while other threads
@@ -121,7 +131,7 @@ using ThreadSafeStringCache = ConcurrentScalableCache<
 
 template <class TKey, class TValue, class THash>
 ConcurrentScalableCache<TKey, TValue, THash>::
-ConcurrentScalableCache(size_t maxSize, size_t numShards)
+ConcurrentScalableCache(size_t maxSize, size_t numShards, size_t maxCost)
   : m_maxSize(maxSize), m_numShards(numShards)
 {
   if (m_numShards == 0) {
@@ -129,10 +139,12 @@ ConcurrentScalableCache(size_t maxSize, size_t numShards)
   }
   for (size_t i = 0; i < m_numShards; i++) {
     size_t s = maxSize / m_numShards;
+    size_t c = maxCost / m_numShards;
     if (i == 0) {
       s += maxSize % m_numShards;
+      c += maxCost % m_numShards;
     }
-    m_shards.emplace_back(std::make_shared<Shard>(s));
+    m_shards.emplace_back(std::make_shared<Shard>(s, c));
   }
 }
 
@@ -154,8 +166,9 @@ find(ConstAccessor& ac, const TKey& key) {
 
 template <class TKey, class TValue, class THash>
 bool ConcurrentScalableCache<TKey, TValue, THash>::
-insert(const TKey& key, const TValue& value) {
-  return getShard(key).insert(key, value);
+insert(const TKey& key, const TValue& value, size_t cost,
+       std::chrono::seconds ttl) {
+  return getShard(key).insert(key, value, cost, ttl);
 }
 
 template <class TKey, class TValue, class THash>
@@ -0,0 +1,59 @@
+/*
+   +----------------------------------------------------------------------+
+   | HipHop for PHP                                                       |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 2010-present Facebook, Inc. (http://www.facebook.com)  |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 3.01 of the PHP license,      |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.php.net/license/3_01.txt                                  |
+   | If you did not receive a copy of the PHP license and are unable to   |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@php.net so we can mail you a copy immediately.               |
+   +----------------------------------------------------------------------+
+*/
+
+#include "hphp/util/container-stats.h"
+
+#include "hphp/util/hash-map.h"
+#include "hphp/util/service-data.h"
+
+#include <algorithm>
+#include <mutex>
+#include <string>
+
+namespace HPHP { namespace ContainerStats {
+///////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+constexpr int64_t kMaxValue = 1024;
+
+std::mutex s_lock;
+
+ServiceData::ExportedHistogram* histogramFor(const char* name) {
+  // Leaked deliberately: samples can arrive from static destructors.
+  static auto& histograms =
+    *new hphp_string_map<ServiceData::ExportedHistogram*>();
+
+  std::lock_guard<std::mutex> guard(s_lock);
+  auto& histogram = histograms[name];
+  if (!histogram) {
+    histogram = ServiceData::createHistogram(
+      std::string("container.") + name, 1, 0, kMaxValue,
+      {0.5, 0.9, 0.99, 1.0}
+    );
+  }
+  return histogram;
+}
+
+}
+
+void record(const char* name, int64_t value) {
+  histogramFor(name)->addValue(std::min(std::max(value, int64_t{0}),
+                                        kMaxValue));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+}}
@@ -0,0 +1,46 @@
+/*
+   +----------------------------------------------------------------------+
+   | HipHop for PHP                                                       |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 2010-present Facebook, Inc. (http://www.facebook.com)  |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 3.01 of the PHP license,      |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.php.net/license/3_01.txt                                  |
+   | If you did not receive a copy of the PHP license and are unable to   |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@php.net so we can mail you a copy immediately.               |
+   +----------------------------------------------------------------------+
+*/
+
+#ifndef incl_HPHP_UTIL_CONTAINER_STATS_H_
+#define incl_HPHP_UTIL_CONTAINER_STATS_H_
+
+#include <cstdint>
+
+namespace HPHP { namespace ContainerStats {
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+ * Record one sample for the named container metric.  Samples feed a
+ * ServiceData histogram called "container.<name>", created on first use,
+ * so the size/capacity/probe-length distributions of hot containers can
+ * be aggregated across a whole tier from the normal counters export.
+ *
+ * This only exists in builds with HHVM_TRACK_CONTAINER_STATS defined;
+ * call sites in hot container code must guard their hooks with that
+ * macro so that normal builds carry no overhead at all.  Instrumented
+ * builds trade some throughput for the data -- record() takes a short
+ * lock to look up the histogram, and the write itself is the usual
+ * lock-free ServiceData path.
+ *
+ * Values are clamped to the histogram's range (currently [0, 1024]);
+ * for a slack audit everything past the top bucket is equally "large".
+ */
+void record(const char* name, int64_t value);
+
+///////////////////////////////////////////////////////////////////////////////
+}}
+
+#endif
@@ -277,6 +277,16 @@ struct DataBlock {
   size_t bytesFree()  const { return m_bytesFree; }
   size_t blocksFree() const { return m_freeRanges.size(); }
 
+  // Iterate the interior free ranges, calling f(size, count) for each
+  // distinct hole size. Frees at the frontier simply retract it and are not
+  // included.
+  template <typename F>
+  void forEachFreeSize(F f) const {
+    for (auto const& list : m_freeLists) {
+      f(static_cast<size_t>(list.first), list.second.size());
+    }
+  }
+
   void sync(Address begin = nullptr,  Address end = nullptr) {
     if (!begin) begin = m_base;
     if (!end) end = m_frontier;
@@ -17,8 +17,34 @@
 #ifndef incl_HPHP_UTIL_FAST_STRTOLL_BASE10_H_
 #define incl_HPHP_UTIL_FAST_STRTOLL_BASE10_H_
 
+#include <cstdint>
+#include <cstring>
+
+#include <folly/Portability.h>
+
 namespace HPHP {
 
+namespace fast_strtoll_detail {
+
+// True iff all eight bytes of chunk are ASCII digits.
+inline bool allDigits8(uint64_t chunk) {
+  return (((chunk & 0xf0f0f0f0f0f0f0f0ull) |
+           (((chunk + 0x0606060606060606ull) & 0xf0f0f0f0f0f0f0f0ull) >> 4)) ==
+          0x3333333333333333ull);
+}
+
+// SWAR conversion of eight ASCII digits (first digit in the low byte):
+// fold adjacent digits into 2-, 4-, then 8-digit groups, one multiply
+// per level.
+inline uint32_t convertDigits8(uint64_t chunk) {
+  chunk -= 0x3030303030303030ull;
+  chunk = ((chunk * ((10ull << 8) + 1)) >> 8) & 0x00ff00ff00ff00ffull;
+  chunk = ((chunk * ((100ull << 16) + 1)) >> 16) & 0x0000ffff0000ffffull;
+  return uint32_t((chunk * ((10000ull << 32) + 1)) >> 32);
+}
+
+}
+
 // This a fast version of strtoll() specialized for base 10. This version
 // does not skip leading white space. It does not check for overflow/underflow,
 // in which case the return value becomes different from strtoll(3c) that
@@ -46,6 +72,38 @@ inline int64_t fast_strtoll_base10(const char* p) {
   return x;
 }
 
+// Bounded flavor of the above for callers that know where the buffer
+// ends: takes digits eight at a time with a SWAR check/convert, so long
+// digit runs don't pay a dependent loop iteration per character.
+inline int64_t fast_strtoll_base10(const char* p, const char* const end) {
+  uint64_t x = 0;
+  bool neg = false;
+
+  if (p < end) {
+    if (*p == '-') {
+      neg = true;
+      ++p;
+    } else if (*p == '+') {
+      ++p;
+    }
+  }
+  if (folly::kIsLittleEndian) {
+    while (p + 8 <= end) {
+      uint64_t chunk;
+      memcpy(&chunk, p, 8);
+      if (!fast_strtoll_detail::allDigits8(chunk)) break;
+      x = x * 100000000 + fast_strtoll_detail::convertDigits8(chunk);
+      p += 8;
+    }
+  }
+  while (p < end && *p >= '0' && *p <= '9') {
+    x = x * 10 + uint64_t(*p - '0');
+    ++p;
+  }
+
+  return neg ? -int64_t(x) : int64_t(x);
+}
+
 }
 
 #endif
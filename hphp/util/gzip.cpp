@@ -165,8 +165,27 @@ bool is_compressible_file(const char *filename) {
 ///////////////////////////////////////////////////////////////////////////////
 // GzipCompressor
 
+namespace {
+/*
+ * deflateInit2 allocates a few hundred KB of window and hash state per
+ * stream, which is pure overhead when compressing many small responses.
+ * Each worker thread caches the state of its last completed stream;
+ * deflateReset makes it reusable as long as the init parameters match.
+ */
+struct CachedDeflateState {
+  ~CachedDeflateState() {
+    if (valid) deflateEnd(&stream);
+  }
+  z_stream stream;
+  int level;
+  int encoding;
+  bool valid{false};
+};
+thread_local CachedDeflateState tl_deflate_cache;
+}
+
 GzipCompressor::GzipCompressor(int level, int encoding_mode, bool header)
-  : m_encoding(encoding_mode), m_header(header),
+  : m_level(level), m_encoding(encoding_mode), m_header(header),
     m_ended(false) {
   if (level < -1 || level > 9) {
     throw Exception("compression level(%d) must be within -1..9", level);
@@ -175,6 +194,18 @@ GzipCompressor::GzipCompressor(int level, int encoding_mode, bool header)
     throw Exception("encoding mode must be FORCE_GZIP or FORCE_DEFLATE");
   }
 
+  m_crc = crc32(0L, Z_NULL, 0);
+
+  auto& cache = tl_deflate_cache;
+  if (cache.valid && cache.level == level && cache.encoding == encoding_mode) {
+    m_stream = cache.stream;
+    cache.valid = false;
+    if (deflateReset(&m_stream) == Z_OK) {
+      return;
+    }
+    deflateEnd(&m_stream);
+  }
+
   m_stream.zalloc = Z_NULL;
   m_stream.zfree = Z_NULL;
   m_stream.opaque = Z_NULL;
@@ -184,8 +215,6 @@ GzipCompressor::GzipCompressor(int level, int encoding_mode, bool header)
   m_stream.avail_out = 0;
   m_stream.next_out = Z_NULL;
 
-  m_crc = crc32(0L, Z_NULL, 0);
-
   int status;
   switch (encoding_mode) {
   case CODING_GZIP:
@@ -205,8 +234,21 @@ GzipCompressor::GzipCompressor(int level, int encoding_mode, bool header)
 
 GzipCompressor::~GzipCompressor() {
   if (!m_ended) {
+    releaseStream();
+  }
+}
+
+void GzipCompressor::releaseStream() {
+  auto& cache = tl_deflate_cache;
+  if (!cache.valid) {
+    cache.stream = m_stream;
+    cache.level = m_level;
+    cache.encoding = m_encoding;
+    cache.valid = true;
+  } else {
     deflateEnd(&m_stream);
   }
+  m_ended = true;
 }
 
 char *GzipCompressor::compress(const char *data, int &len, bool trailer) {
@@ -238,7 +280,10 @@ char *GzipCompressor::compress(const char *data, int &len, bool trailer) {
   }
 
   int status = deflate(&m_stream, trailer ? Z_FINISH : Z_SYNC_FLUSH);
-  if (status == Z_BUF_ERROR || status == Z_STREAM_END) {
+  if (status == Z_STREAM_END) {
+    releaseStream();
+    status = Z_OK;
+  } else if (status == Z_BUF_ERROR) {
     status = deflateEnd(&m_stream);
     m_ended = true;
   }
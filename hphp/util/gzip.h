@@ -46,6 +46,12 @@ struct GzipCompressor {
   char *compress(const char *data, int &len, bool trailer);
 
 private:
+  // Hand the deflate state back to the per-thread cache (or free it if the
+  // cache is occupied). Only valid once the stream has fully ended or has
+  // never produced output.
+  void releaseStream();
+
+  int m_level;
   int m_encoding;
   bool m_header;
   z_stream m_stream;
@@ -52,6 +52,7 @@ static bool s_recordSubprocessTimes = false;
 static bool s_excludeKernel = false;
 static bool s_profileHWEnable;
 static bool s_fastReads = false;
+static bool s_groupedEvents = false;
 static int s_exportInterval = -1;
 static std::string s_profileHWEvents;
 
@@ -388,8 +389,158 @@ private:
   }
 };
 
+/*
+ * A fixed set of events opened as a single kernel perf event group, so the
+ * PMU schedules them together: their counts cover the same time slices,
+ * which makes ratios between them (most importantly IPC) meaningful even
+ * when the group is multiplexed against other users of the PMU.  A group
+ * also reads out in one read() syscall, returning every member's count
+ * atomically, so keeping it armed on every request is cheap.
+ *
+ * Members are exported under "grp-" names to keep them apart from the
+ * individually-scheduled counters above, whose counts come from different
+ * scheduling windows and don't form valid ratios with the group's.
+ */
+struct HardwareCounterGroup {
+  static constexpr PerfTable kMembers[] = {
+    { "cycles",        PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+    { "instructions",  PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+    { "cache-misses",  PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+    { "branch-misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+  };
+  static constexpr size_t kNumMembers =
+    sizeof(kMembers) / sizeof(kMembers[0]);
+
+  HardwareCounterGroup() {
+    for (size_t i = 0; i < kNumMembers; ++i) {
+      m_descs[i] = std::string("grp-") + kMembers[i].name;
+      m_timeSeries[i] = createTimeSeries(m_descs[i]);
+      m_timeSeriesNonPsp[i] = createTimeSeries(m_descs[i] + "-nonpsp");
+    }
+  }
+
+  ~HardwareCounterGroup() {
+    close();
+  }
+
+  void init_if_not() {
+    if (inited) return;
+    inited = true;
+    for (size_t i = 0; i < kNumMembers; ++i) {
+      struct perf_event_attr pe{};
+      pe.type = kMembers[i].type;
+      pe.size = sizeof(pe);
+      pe.config = kMembers[i].config;
+      pe.inherit = s_recordSubprocessTimes;
+      // Only the leader is born disabled; enabling it starts the group.
+      pe.disabled = i == 0;
+      pe.exclude_kernel = s_excludeKernel;
+      pe.exclude_hv = 1;
+      pe.read_format = PERF_FORMAT_GROUP |
+        PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+      auto const group_fd = i == 0 ? -1 : m_fds[0];
+      m_fds[i] = syscall(__NR_perf_event_open, &pe, 0, -1, group_fd, 0);
+      if (m_fds[i] < 0) {
+        Logger::FWarning("HardwareCounterGroup: perf_event_open {} "
+                         "failed with: {}",
+                         kMembers[i].name, folly::errnoStr(errno));
+        m_err = -1;
+        close();
+        return;
+      }
+      fcntl(m_fds[i], F_SETFD, O_CLOEXEC);
+    }
+    if (ioctl(m_fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP) < 0) {
+      Logger::FWarning("HardwareCounterGroup: failed to enable: {}",
+                       folly::errnoStr(errno));
+      m_err = -1;
+      close();
+      return;
+    }
+    reset();
+  }
+
+  void reset() {
+    if (m_err || !useCounters()) return;
+    init_if_not();
+    if (m_err) return;
+    if (!readRaw(m_base)) {
+      Logger::FWarning("HardwareCounterGroup: failed to read baseline: {}",
+                       folly::errnoStr(errno));
+      m_err = -1;
+    }
+  }
+
+  void updateServiceData(StructuredLogEntry* entry, bool includingPsp) {
+    uint64_t now[kReadBufWords];
+    if (m_err || !readRaw(now)) return;
+    auto const enabled = now[1] - m_base[1];
+    auto const running = now[2] - m_base[2];
+    for (size_t i = 0; i < kNumMembers; ++i) {
+      auto const value = scaledDelta(now, i, enabled, running);
+      if (value == 0) continue;
+      if (entry) entry->setInt(m_descs[i], value);
+      auto series = includingPsp ? m_timeSeries[i] : m_timeSeriesNonPsp[i];
+      if (series) series->addValue(value);
+    }
+  }
+
+  void getPerfEvents(HardwareCounter::PerfEventCallback f, void* data) {
+    uint64_t now[kReadBufWords];
+    if (m_err || !readRaw(now)) return;
+    auto const enabled = now[1] - m_base[1];
+    auto const running = now[2] - m_base[2];
+    for (size_t i = 0; i < kNumMembers; ++i) {
+      f(m_descs[i], scaledDelta(now, i, enabled, running), data);
+    }
+  }
+
+private:
+  // Layout of a PERF_FORMAT_GROUP read without PERF_FORMAT_ID:
+  // { nr, time_enabled, time_running, values[nr] }.
+  static constexpr size_t kReadBufWords = 3 + kNumMembers;
+
+  bool readRaw(uint64_t* buf) {
+    if (m_fds[0] < 0) return false;
+    auto const want = sizeof(uint64_t) * kReadBufWords;
+    if (::read(m_fds[0], buf, want) != want) return false;
+    assertx(buf[0] == kNumMembers);
+    return true;
+  }
+
+  int64_t scaledDelta(const uint64_t* now, size_t i,
+                      uint64_t enabled, uint64_t running) const {
+    auto const delta = now[3 + i] - m_base[3 + i];
+    if (running == enabled) return delta;
+    if (!running) return 0;
+    return (double)delta * enabled / running;
+  }
+
+  void close() {
+    for (auto& fd : m_fds) {
+      if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+      }
+    }
+  }
+
+  int m_fds[kNumMembers] = { -1, -1, -1, -1 };
+  int m_err{0};
+  bool inited{false};
+  uint64_t m_base[kReadBufWords] = {};
+  std::string m_descs[kNumMembers];
+  ServiceData::ExportedTimeSeries* m_timeSeries[kNumMembers];
+  ServiceData::ExportedTimeSeries* m_timeSeriesNonPsp[kNumMembers];
+};
+
+constexpr PerfTable HardwareCounterGroup::kMembers[];
+
 HardwareCounter::HardwareCounter()
   : m_countersSet(false) {
+  if (s_groupedEvents) {
+    m_group = std::make_unique<HardwareCounterGroup>();
+  }
   m_instructionCounter = std::make_unique<HardwareCounterImpl>(
     PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, "instructions"
   );
@@ -425,12 +576,14 @@ void HardwareCounter::Init(bool enable, const std::string& events,
                            bool subProc,
                            bool excludeKernel,
                            bool fastReads,
-                           int exportInterval) {
+                           int exportInterval,
+                           bool groupedEvents) {
   s_profileHWEnable = enable;
   s_profileHWEvents = events;
   s_recordSubprocessTimes = subProc;
   s_excludeKernel = excludeKernel;
   s_fastReads = fastReads,
+  s_groupedEvents = groupedEvents;
   s_exportInterval = exportInterval;
 }
 
@@ -439,6 +592,7 @@ void HardwareCounter::Reset() {
 }
 
 void HardwareCounter::reset() {
+  if (m_group) m_group->reset();
   m_instructionCounter->reset();
   if (!m_countersSet) {
     m_storeCounter->reset();
@@ -662,6 +816,7 @@ void HardwareCounter::ClearPerfEvents() {
 
 void HardwareCounter::updateServiceData(StructuredLogEntry* entry,
                                         bool includingPsp) {
+  if (m_group) m_group->updateServiceData(entry, includingPsp);
   forEachCounter([entry,includingPsp](HardwareCounterImpl& counter) {
     counter.updateServiceData(entry, includingPsp);
   });
@@ -708,6 +863,7 @@ void HardwareCounter::getPerfEvents(PerfEventCallback f, void* data) {
   forEachCounter([f, data](HardwareCounterImpl& counter) {
     f(counter.m_desc, counter.read(), data);
   });
+  if (m_group) m_group->getPerfEvents(f, data);
 }
 
 template<typename F>
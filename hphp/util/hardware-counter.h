@@ -36,6 +36,7 @@ struct PerfTable {
 };
 
 struct HardwareCounterImpl;
+struct HardwareCounterGroup;
 struct StructuredLogEntry;
 
 /* If you change the public interface, remember to update the stubs below. */
@@ -64,7 +65,8 @@ struct HardwareCounter {
                    bool subProc,
                    bool excludeKernel,
                    bool fastReads,
-                   int exportInterval);
+                   int exportInterval,
+                   bool groupedEvents = false);
   static void RecordSubprocessTimes();
   static void ExcludeKernel();
   static THREAD_LOCAL_NO_CHECK(HardwareCounter, s_counter);
@@ -87,6 +89,7 @@ private:
   std::unique_ptr<HardwareCounterImpl> m_loadCounter;
   std::unique_ptr<HardwareCounterImpl> m_storeCounter;
   std::vector<std::unique_ptr<HardwareCounterImpl>> m_counters;
+  std::unique_ptr<HardwareCounterGroup> m_group;
 };
 
 #else // NO_HARDWARE_COUNTERS
@@ -122,7 +125,8 @@ struct HardwareCounter {
                    bool subProc,
                    bool excludeKernel,
                    bool fastReads,
-                   int exportInterval) {}
+                   int exportInterval,
+                   bool groupedEvents = false) {}
   static void RecordSubprocessTimes() {}
   static void ExcludeKernel() {}
 
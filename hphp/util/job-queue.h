@@ -128,16 +128,36 @@ public:
 
   /**
    * Put a job into the queue and notify a worker to pick it up.
+   *
+   * maxQueuingMs optionally gives this job its own queuing budget,
+   * measured from enqueue time.  A job whose budget has elapsed before a
+   * worker picks it up is handed back with *expired set, so the caller
+   * can fail it instead of executing it pointlessly.  A negative value
+   * (the default) falls back to the queue-wide maxJobQueuingMs.
    */
-  void enqueue(TJob job, int priority=0) {
+  void enqueue(TJob job, int priority = 0, int maxQueuingMs = -1) {
     assertx(priority >= 0);
     assertx(priority < m_jobQueues.size());
     timespec enqueueTime;
     Timer::GetMonotonicTime(enqueueTime);
     Lock lock(this);
-    m_jobQueues[priority].emplace_back(job, enqueueTime);
+    m_jobQueues[priority].push_back({job, enqueueTime, maxQueuingMs});
     ++m_jobCount;
-    notify();
+    if (m_groupAffinity) {
+      notifyOnGroup(s_numaNode);
+    } else {
+      notify();
+    }
+  }
+
+  /**
+   * When enabled, enqueue() prefers waking a worker on the enqueuing
+   * thread's numa node over plain round-robin, so related jobs (e.g.,
+   * the pagelets of one page) tend to run near the thread that spawned
+   * them.
+   */
+  void setGroupAffinity(bool b) {
+    m_groupAffinity = b;
   }
 
   /**
@@ -202,6 +222,21 @@ public:
 
  private:
   friend class JobQueue_Expiration_Test;
+
+  struct JobEntry {
+    TJob job;
+    timespec enqueueTime;
+    int maxQueuingMs;  // per-job budget; negative means use the queue's
+  };
+
+  /*
+   * The effective queuing budget for a job, in milliseconds.  Zero or
+   * negative means the job never expires.
+   */
+  int maxQueuingMsFor(const JobEntry& entry) const {
+    return entry.maxQueuingMs >= 0 ? entry.maxQueuingMs : m_maxJobQueuingMs;
+  }
+
   TJob dequeueMaybeExpiredImpl(int id, int q, bool inc, const timespec& now,
                                bool* expired, bool highPri = false) {
     *expired = false;
@@ -260,21 +295,22 @@ public:
 
       // peek at the beginning of the queue to see if the request has already
       // timed out.
-      if (m_maxJobQueuingMs > 0 &&
-          gettime_diff_us(jobs.front().second, now) >
-          m_maxJobQueuingMs * 1000) {
+      auto const budgetMs = maxQueuingMsFor(jobs.front());
+      if (budgetMs > 0 &&
+          gettime_diff_us(jobs.front().enqueueTime, now) >
+          budgetMs * 1000) {
         *expired = true;
-        TJob job = jobs.front().first;
+        TJob job = jobs.front().job;
         jobs.pop_front();
         return job;
       }
 
       if (m_jobCount >= m_lifoSwitchThreshold) {
-        TJob job = jobs.back().first;
+        TJob job = jobs.back().job;
         jobs.pop_back();
         return job;
       }
-      TJob job = jobs.front().first;
+      TJob job = jobs.front().job;
       jobs.pop_front();
       return job;
     }
@@ -299,19 +335,21 @@ public:
 
       for (auto& jobs : boost::adaptors::reverse(m_jobQueues)) {
         if (!jobs.empty()) {
+          auto const budgetMs = maxQueuingMsFor(jobs.front());
+          if (budgetMs <= 0) continue;
           timespec now;
           Timer::GetMonotonicTime(now);
-          int64_t queuedTimeUs = gettime_diff_us(jobs.front().second, now);
-          if (queuedTimeUs > m_maxJobQueuingMs * 1000) {
+          int64_t queuedTimeUs = gettime_diff_us(jobs.front().enqueueTime, now);
+          if (queuedTimeUs > budgetMs * 1000) {
             if (inc) incActiveWorker();
             --m_jobCount;
 
-            TJob job = jobs.front().first;
+            TJob job = jobs.front().job;
             jobs.pop_front();
             return job;
           }
           // oldest job hasn't expired yet. wake us up when it will.
-          long waitTimeForQueue = m_maxJobQueuingMs * 1000 - queuedTimeUs;
+          long waitTimeForQueue = budgetMs * 1000 - queuedTimeUs;
           waitTimeUs = ((waitTimeUs < waitTimeForQueue) ?
                         waitTimeUs :
                         waitTimeForQueue);
@@ -329,8 +367,9 @@ public:
   }
 
   int m_jobCount{0};
-  folly::small_vector<std::deque<std::pair<TJob, timespec>>, 2> m_jobQueues;
+  folly::small_vector<std::deque<JobEntry>, 2> m_jobQueues;
   bool m_stopped{false};
+  bool m_groupAffinity{false};
   std::atomic<int> m_workerCount{0};
   const int m_dropCacheTimeout;
   const bool m_dropStack;
@@ -577,10 +616,14 @@ struct JobQueueDispatcher : IHostHealthObserver {
   }
 
   /**
-   * Enqueue a new job.
+   * Enqueue a new job, optionally with its own queuing budget (in
+   * milliseconds, e.g., a latency budget the transport attached to the
+   * request).  The job is handed to its worker with expired set if the
+   * budget elapsed while the job was still queued.
    */
-  void enqueue(typename TWorker::JobType job, int priority = 0) {
-    m_queue.enqueue(job, priority);
+  void enqueue(typename TWorker::JobType job, int priority = 0,
+               int maxQueuingMs = -1) {
+    m_queue.enqueue(job, priority, maxQueuingMs);
 
     // Spin up another worker thread if appropriate.
     auto const target = getTargetNumWorkers();
@@ -623,6 +666,22 @@ struct JobQueueDispatcher : IHostHealthObserver {
     }
   }
 
+  /*
+   * Eagerly spawn every worker thread up to the maximum, regardless of
+   * demand.  For workers that count active jobs, threads are otherwise
+   * only created as jobs arrive; servers that want warm threads before
+   * the first burst of jobs can use this after start().
+   */
+  void startAllWorkers() {
+    Lock lock(m_mutex);
+    if (m_stopped) return;
+
+    m_currThreadCountLimit = m_maxThreadCount.load(std::memory_order_acquire);
+    while (numActiveThreads() < m_currThreadCountLimit) {
+      addWorkerImpl(true);
+    }
+  }
+
   std::vector<TWorker*> getWorkers() {
     Lock lock(m_mutex);
     std::vector<TWorker*> ret{m_workers};
@@ -706,6 +765,19 @@ struct JobQueueDispatcher : IHostHealthObserver {
     m_hugeStackKb = stackKb;
   }
 
+  void setGroupAffinity(bool b) {
+    m_queue.setGroupAffinity(b);
+  }
+
+  /**
+   * Names the ThreadRegistry group this dispatcher's worker threads are
+   * accounted under. `group` must have static storage duration; call
+   * before any workers are started.
+   */
+  void setThreadGroup(const char* group) {
+    m_threadGroup = group;
+  }
+
   /*
    * Change the maximum thread count.
    *
@@ -760,6 +832,7 @@ private:
   int m_hugeThreadCount{0};
   unsigned m_hugeStackKb;
   unsigned m_tlExtraKb;
+  const char* m_threadGroup{"jobqueue"};
   JobQueue<typename TWorker::JobType,
            TWorker::Waitable,
            typename TWorker::DropCachePolicy> m_queue;
@@ -812,6 +885,7 @@ private:
     m_reaper = std::make_unique<TWorker>();
     m_reaperFunc = std::make_unique<AsyncFunc<TWorker>>(m_reaper.get(),
                                                         &TWorker::start);
+    m_reaperFunc->setThreadGroup(m_threadGroup);
     m_reaper->create(m_maxThreadCount, &m_queue, m_reaperFunc.get(), m_context);
     m_reaperFunc->start();
     return m_maxThreadCount;
@@ -832,6 +906,7 @@ private:
                                        next_numa_node(m_prevNode),
                                        hugeStackKb,
                                        m_tlExtraKb);
+    func->setThreadGroup(m_threadGroup);
     int id = m_workers.size();
     m_workers.push_back(worker);
     m_funcs.insert(func);
@@ -301,6 +301,7 @@ folly::Optional<perf_event_handle> enable_event(const char* event_name,
                    | PERF_SAMPLE_TID
                    | PERF_SAMPLE_ADDR
                    | PERF_SAMPLE_CALLCHAIN
+                   | PERF_SAMPLE_WEIGHT
                    | PERF_SAMPLE_DATA_SRC
                    ;
 
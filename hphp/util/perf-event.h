@@ -54,6 +54,8 @@ struct perf_event_sample {
 };
 
 struct perf_event_sample_tail {
+  uint64_t weight;   // cost of the event; for loads, the access latency
+                     // in core cycles
   uint64_t data_src;
 };
 
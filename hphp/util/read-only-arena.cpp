@@ -21,6 +21,7 @@
 #include <folly/portability/SysMman.h>
 
 #include "hphp/util/assertions.h"
+#include "hphp/util/maphuge.h"
 
 namespace HPHP {
 
@@ -48,8 +49,9 @@ void checked_mprotect(void* addr, size_t size, int prot) {
 
 //////////////////////////////////////////////////////////////////////
 
-ReadOnlyArena::ReadOnlyArena(size_t minChunkSize)
+ReadOnlyArena::ReadOnlyArena(size_t minChunkSize, bool hugePages)
   : m_minChunkSize((minChunkSize + (s_pageSize - 1)) & ~(s_pageSize - 1))
+  , m_hugePages(hugePages)
   , m_frontier(nullptr)
   , m_end(nullptr)
 {
@@ -108,6 +110,7 @@ void ReadOnlyArena::ensureFree(size_t bytes) {
     folly::throwSystemError(err, "failed to posix_memalign in "
                             "ReadOnlyArena");
   }
+  if (m_hugePages) hintHuge(vp, bytes);
   checked_mprotect(vp, bytes, PROT_READ);
 
   auto uc = static_cast<unsigned char*>(vp);
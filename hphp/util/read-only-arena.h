@@ -51,10 +51,13 @@ struct ReadOnlyArena {
    * call to the allocator.  `minChunkSize' will be rounded up to the nearest
    * multiple of the system page size (s_pageSize).
    *
+   * If `hugePages' is true, each chunk is hinted to the kernel as a
+   * candidate for transparent huge pages when it is mapped.
+   *
    * Note: s_pageSize is a dynamically initialized static, so do not
    * create global ReadOnlyArenas.
    */
-  explicit ReadOnlyArena(size_t minChunkSize);
+  explicit ReadOnlyArena(size_t minChunkSize, bool hugePages = false);
 
   /*
    * Destroying a ReadOnlyArena will munmap all the chunks it allocated, but
@@ -83,6 +86,7 @@ private:
 
 private:
   size_t const m_minChunkSize;
+  bool const m_hugePages;
 
   mutable std::mutex m_mutex;
   unsigned char* m_frontier;
@@ -26,6 +26,7 @@
 #include <folly/portability/Unistd.h>
 
 #include "hphp/util/assertions.h"
+#include "hphp/util/cycles.h"
 
 namespace HPHP {
 namespace Trace {
@@ -106,6 +107,7 @@ RingBufferEntry* allocEntry(RingBufferType t) {
   } while (!g_ringIdx.compare_exchange_weak(oldRingPos, newRingPos,
                                             std::memory_order_acq_rel));
   rb->seq = g_seqnum.fetch_add(1, std::memory_order_relaxed);
+  rb->tsc = cpuCycles();
   rb->type = t;
   rb->threadId = (uint32_t)((int64_t)pthread_self() & 0xFFFFFFFF);
   return rb;
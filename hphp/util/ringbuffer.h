@@ -84,12 +84,17 @@ struct RingBufferEntry {
   uint32_t threadId;
   uint32_t seq; // sequence number
 
-  // 24 - 31
+  // 24-31: machine cycle counter (rdtsc or equivalent) at append time, so
+  // entries from different threads can be ordered and latency between
+  // entries estimated when the buffer is dumped after the fact.
+  uint64_t tsc;
+
+  // 32-39
   RingBufferType type;
 };
 
-static_assert(sizeof(RingBufferEntry) == 32,
-              "RingBufferEntry expected to be 32 bytes");
+static_assert(sizeof(RingBufferEntry) == 40,
+              "RingBufferEntry expected to be 40 bytes");
 
 constexpr unsigned kMaxRBEntries = (1 << 20); // Must exceed number of threads
 
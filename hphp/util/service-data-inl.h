@@ -30,25 +30,47 @@ inline std::chrono::seconds nowAsSeconds() {
 
 } // namespace detail
 
+inline uint32_t ExportedTimeSeries::pendingStripe() {
+  static std::atomic<uint32_t> nextStripe{0};
+  static thread_local uint32_t stripe =
+    nextStripe.fetch_add(1, std::memory_order_relaxed);
+  return stripe % kPendingStripes;
+}
+
 inline void ExportedTimeSeries::addValue(int64_t value) {
-  m_timeseries->addValue(detail::nowAsSeconds(), value);
+  addValueAggregated(value, 1);
 }
 
 inline void ExportedTimeSeries::addValue(int64_t value, int64_t times) {
-  m_timeseries->addValue(detail::nowAsSeconds(), value, times);
+  addValueAggregated(value * times, times);
 }
 
 inline void ExportedTimeSeries::addValueAggregated(int64_t sum,
                                                    int64_t nsamples) {
-  m_timeseries->addValueAggregated(detail::nowAsSeconds(), sum, nsamples);
+  auto& stripe = m_pending[pendingStripe()];
+  stripe.sum.fetch_add(sum, std::memory_order_relaxed);
+  stripe.count.fetch_add(nsamples, std::memory_order_relaxed);
+  maybeFlushPending();
+}
+
+inline size_t ExportedHistogram::bucketFor(int64_t value) const {
+  // Mirrors folly::detail::HistogramBuckets: bucket 0 catches values below
+  // min, the last bucket catches values at or above max.
+  if (value < m_min) return 0;
+  if (value >= m_max) return m_numPendingBuckets - 1;
+  return (value - m_min) / m_bucketSize + 1;
 }
 
 inline void ExportedHistogram::addValue(int64_t value) {
-  m_histogram->addValue(value);
+  auto& bucket = m_pending[bucketFor(value)];
+  bucket.count.fetch_add(1, std::memory_order_relaxed);
+  bucket.sum.fetch_add(value, std::memory_order_relaxed);
 }
 
 inline void ExportedHistogram::removeValue(int64_t value) {
-  m_histogram->removeValue(value);
+  auto& bucket = m_pending[bucketFor(value)];
+  bucket.count.fetch_sub(1, std::memory_order_relaxed);
+  bucket.sum.fetch_sub(value, std::memory_order_relaxed);
 }
 
 }  // namespace ServiceData
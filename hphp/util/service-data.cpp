@@ -44,9 +44,38 @@ ExportedTimeSeries::ExportedTimeSeries(
       m_exportTypes(exportTypes) {
 }
 
+void ExportedTimeSeries::maybeFlushPending() {
+  auto const now = detail::nowAsSeconds().count();
+  auto last = m_pendingSecond.load(std::memory_order_relaxed);
+  if (now == last) return;
+  // Only the writer that wins the race folds the pending cells for this
+  // second; everyone else stays lock-free.
+  if (!m_pendingSecond.compare_exchange_strong(last, now,
+                                               std::memory_order_relaxed)) {
+    return;
+  }
+  SYNCHRONIZED(m_timeseries) {
+    flushPending(m_timeseries);
+  }
+}
+
+void ExportedTimeSeries::flushPending(
+    folly::MultiLevelTimeSeries<int64_t>& ts) {
+  int64_t sum = 0;
+  int64_t count = 0;
+  for (auto& stripe : m_pending) {
+    sum += stripe.sum.exchange(0, std::memory_order_relaxed);
+    count += stripe.count.exchange(0, std::memory_order_relaxed);
+  }
+  if (count != 0) {
+    ts.addValueAggregated(detail::nowAsSeconds(), sum, count);
+  }
+}
+
 void ExportedTimeSeries::exportAll(const std::string& prefix,
                                    std::map<std::string, int64_t>& statsMap) {
   SYNCHRONIZED(m_timeseries) {
+    flushPending(m_timeseries);
     // must first call update to flush data.
     m_timeseries.update(detail::nowAsSeconds());
 
@@ -86,6 +115,7 @@ void ExportedTimeSeries::exportAll(const std::string& prefix,
 int64_t ExportedTimeSeries::getSum() {
   int64_t sum = 0;
   SYNCHRONIZED(m_timeseries) {
+    flushPending(m_timeseries);
     m_timeseries.update(detail::nowAsSeconds());
 
     for (int i = 0; i < m_timeseries.numLevels(); ++i) {
@@ -103,6 +133,7 @@ int64_t ExportedTimeSeries::getSum() {
 int64_t ExportedTimeSeries::getRateByDuration(std::chrono::seconds duration) {
   int64_t rate = 0;
   SYNCHRONIZED(m_timeseries) {
+    flushPending(m_timeseries);
     m_timeseries.update(detail::nowAsSeconds());
     rate = m_timeseries.rate(duration);
   }
@@ -115,12 +146,52 @@ ExportedHistogram::ExportedHistogram(
   int64_t max,
   const std::vector<double>& exportPercentiles)
     : m_histogram(folly::Histogram<int64_t>(bucketSize, min, max)),
-      m_exportPercentiles(exportPercentiles) {
+      m_exportPercentiles(exportPercentiles),
+      m_bucketSize(bucketSize),
+      m_min(min),
+      m_max(max),
+      m_numPendingBuckets((max - min + bucketSize - 1) / bucketSize + 2),
+      m_pending(new PendingBucket[m_numPendingBuckets]) {
+}
+
+void ExportedHistogram::flushPending(folly::Histogram<int64_t>& hist) {
+  for (size_t i = 0; i < m_numPendingBuckets; ++i) {
+    auto const count = m_pending[i].count.exchange(0,
+                                                   std::memory_order_relaxed);
+    auto const sum = m_pending[i].sum.exchange(0, std::memory_order_relaxed);
+    // count == 0 with sum != 0 can only happen when adds and removes of
+    // different values in the same bucket cancel out; the count is exact
+    // and the residual sum is too small to represent without samples.
+    if (count == 0) continue;
+
+    auto const nsamples = count > 0 ? count : -count;
+    auto const total = count > 0 ? sum : -sum;
+
+    // Replay the cell as `rem' samples of q+1 and `nsamples - rem' samples
+    // of q, where q = floor(total / nsamples). This lands every sample in
+    // the same bucket the original values hit (q and, when rem > 0, q+1
+    // are both within the bucket's range) and reproduces the bucket's
+    // count and sum exactly, so percentile estimates are unchanged.
+    auto q = total / nsamples;
+    auto rem = total % nsamples;
+    if (rem < 0) {
+      q -= 1;
+      rem += nsamples;
+    }
+    if (count > 0) {
+      if (rem) hist.addRepeatedValue(q + 1, rem);
+      if (nsamples - rem) hist.addRepeatedValue(q, nsamples - rem);
+    } else {
+      if (rem) hist.removeRepeatedValue(q + 1, rem);
+      if (nsamples - rem) hist.removeRepeatedValue(q, nsamples - rem);
+    }
+  }
 }
 
 void ExportedHistogram::exportAll(const std::string& prefix,
                                   std::map<std::string, int64_t>& statsMap) {
   SYNCHRONIZED(m_histogram) {
+    flushPending(m_histogram);
     for (double percentile : m_exportPercentiles) {
       statsMap.insert(
         std::make_pair(
@@ -17,9 +17,11 @@
 #ifndef incl_HPHP_SERVICE_DATA_H_
 #define incl_HPHP_SERVICE_DATA_H_
 
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -57,7 +59,10 @@ namespace HPHP {
  *
  * All objects returned by returned by the various create...() calls are thread
  * safe. It is okay to add data points to it from multiple threads concurrently.
- * These objects are internally synchronized with spin locks.
+ * The write paths (addValue() and friends) are lock-free: samples land in
+ * striped atomic cells and are folded into the underlying folly structures
+ * when the data is read (or, for timeseries, when the clock ticks over a
+ * second), so it is fine to instrument hot paths shared by many threads.
  *
  * Example Usage:
  * ==============
@@ -273,9 +278,29 @@ struct ExportedTimeSeries {
   friend struct detail::FriendDeleter<ExportedTimeSeries>;
   ~ExportedTimeSeries() {}
 
+  /*
+   * Writers add samples to one of these cache-line-sized cells with relaxed
+   * atomic adds; the cells are folded into m_timeseries (under its lock)
+   * when stats are read or when a writer notices the wall clock has moved
+   * to a new second. This keeps addValue() lock-free at the cost of up to a
+   * second of timestamp granularity, which is already the finest bucket
+   * width we track.
+   */
+  struct alignas(64) PendingStripe {
+    std::atomic<int64_t> sum{0};
+    std::atomic<int64_t> count{0};
+  };
+  static constexpr uint32_t kPendingStripes = 16;
+
+  static uint32_t pendingStripe();
+  void maybeFlushPending();
+  void flushPending(folly::MultiLevelTimeSeries<int64_t>& ts);
+
   folly::Synchronized<folly::MultiLevelTimeSeries<int64_t>,
                       folly::RWSpinLock > m_timeseries;
   const std::vector<ServiceData::StatsType> m_exportTypes;
+  std::array<PendingStripe, kPendingStripes> m_pending;
+  std::atomic<int64_t> m_pendingSecond{0};
 };
 
 // Interface for histogram data. All methods are thread safe.
@@ -291,8 +316,29 @@ struct ExportedHistogram {
   friend struct detail::FriendDeleter<ExportedHistogram>;
   ~ExportedHistogram() {}
 
+  /*
+   * One pending (count, sum) cell per histogram bucket, mirroring the
+   * fixed bucket layout of m_histogram. addValue()/removeValue() touch only
+   * their bucket's cell with relaxed atomic adds; exportAll() folds the
+   * cells into m_histogram in a way that preserves each bucket's count and
+   * sum exactly, so percentile estimates are identical to the locked
+   * implementation.
+   */
+  struct PendingBucket {
+    std::atomic<int64_t> count{0};
+    std::atomic<int64_t> sum{0};
+  };
+
+  size_t bucketFor(int64_t value) const;
+  void flushPending(folly::Histogram<int64_t>& hist);
+
   folly::Synchronized<folly::Histogram<int64_t>, folly::RWSpinLock> m_histogram;
   const std::vector<double> m_exportPercentiles;
+  const int64_t m_bucketSize;
+  const int64_t m_min;
+  const int64_t m_max;
+  const size_t m_numPendingBuckets;
+  const std::unique_ptr<PendingBucket[]> m_pending;
 };
 
 };  // namespace ServiceData
@@ -63,6 +63,7 @@ const char* const s_defaultBlacklist[] = {
 };
 
 bool StackTraceBase::Enabled = true;
+bool StackTraceBase::UseFramePointers = false;
 
 const char* const* StackTraceBase::FunctionBlacklist = s_defaultBlacklist;
 unsigned StackTraceBase::FunctionBlacklistCount = 2;
@@ -194,9 +195,42 @@ void translateFromPerfMap(StackFrameExtra* frame) {
   }
 }
 
+/*
+ * Walk the frame-pointer chain of the current thread.  Async-signal-safe:
+ * touches nothing but the stack.  Each hop is sanity-checked -- the chain
+ * must grow monotonically up the stack, by a bounded amount, and stay
+ * pointer-aligned -- so a frame built without a frame pointer ends the
+ * walk instead of chasing garbage.
+ */
+NEVER_INLINE int get_fp_backtrace(void** frame, int max) {
+  int n = 0;
+#if defined(__x86_64__) || defined(__aarch64__)
+  constexpr uintptr_t kMaxFrameBytes = 1u << 20;
+  auto fp = static_cast<void**>(__builtin_frame_address(0));
+  while (n < max && fp) {
+    auto const next = static_cast<void**>(fp[0]);
+    auto const ret = fp[1];
+    if (!ret) break;
+    frame[n++] = ret;
+    if (next <= fp ||
+        uintptr_t(next) - uintptr_t(fp) > kMaxFrameBytes ||
+        (uintptr_t(next) & (sizeof(void*) - 1))) {
+      break;
+    }
+    fp = next;
+  }
+#endif
+  return n;
+}
+
 template <bool safe>
 int ALWAYS_INLINE get_backtrace(void** frame, int max) {
   int ret = 0;
+  if (StackTraceBase::UseFramePointers) {
+    ret = get_fp_backtrace(frame, max);
+    if (ret > 0) return ret;
+    // Fall through to the unwinder if the walk produced nothing.
+  }
 #if defined USE_FOLLY_SYMBOLIZER
   if (safe) {
     ret = folly::symbolizer::getStackTraceSafe((uintptr_t*)frame, max);
@@ -223,6 +257,10 @@ THREAD_LOCAL(StackTraceLog, StackTraceLog::s_logData);
 
 ////////////////////////////////////////////////////////////////////////////////
 
+int StackTraceBase::CaptureFramePointers(void** frames, int max) {
+  return get_fp_backtrace(frames, max);
+}
+
 StackTraceBase::StackTraceBase() {
 #if !defined USE_FOLLY_SYMBOLIZER && defined HAVE_LIBBFD
   bfd_init();
@@ -474,8 +512,8 @@ void StackTraceNoHeap::printStackTrace(int fd) const {
   }
 }
 
-std::shared_ptr<StackFrameExtra> StackTrace::Translate(void* frame_addr,
-                                                       PerfMap* pm) {
+static std::shared_ptr<StackFrameExtra> translateImpl(
+    void* frame_addr, StackTrace::PerfMap* pm, bool& cacheable) {
   folly::symbolizer::Symbolizer symbolizer;
   folly::symbolizer::SymbolizedFrame sf;
   symbolizer.symbolize((uintptr_t*)&frame_addr, &sf, 1);
@@ -501,6 +539,7 @@ std::shared_ptr<StackFrameExtra> StackTrace::Translate(void* frame_addr,
 
   frame->funcname = sf.name ? demangle(sf.name) : "";
 
+  cacheable = true;
   return frame;
 }
 
@@ -782,8 +821,8 @@ bool translate(int fd, void* frame_addr, int frame_num, NamedBfdRange bfds) {
 ////////////////////////////////////////////////////////////////////////////////
 }
 
-std::shared_ptr<StackFrameExtra> StackTrace::Translate(void* frame_addr,
-                                                       PerfMap* pm) {
+static std::shared_ptr<StackFrameExtra> translateImpl(
+    void* frame_addr, StackTrace::PerfMap* pm, bool& cacheable) {
   Dl_info dlInfo;
   Addr2lineData adata;
 
@@ -812,6 +851,7 @@ std::shared_ptr<StackFrameExtra> StackTrace::Translate(void* frame_addr,
     frame->funcname = demangle(dlInfo.dli_sname);
   }
 
+  cacheable = true;
   return frame;
 }
 
@@ -857,7 +897,8 @@ void printHex(int fd, uint64_t val) {
 
 }
 
-std::shared_ptr<StackFrameExtra> StackTrace::Translate(void* bt, PerfMap* pm) {
+static std::shared_ptr<StackFrameExtra> translateImpl(
+    void* bt, StackTrace::PerfMap* /*pm*/, bool& /*cacheable*/) {
   return std::make_shared<StackFrameExtra>(bt);
 }
 
@@ -873,5 +914,38 @@ void StackTraceNoHeap::printStackTrace(int fd) const {
 
 #endif
 
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/*
+ * Per-thread cache of symbolized frames.  Samplers see the same program
+ * counters over and over, and symbolization dwarfs capture cost.  Only
+ * translations the symbolizer resolved get cached: anything that fell
+ * through to the perf map may be jitted code whose address can be
+ * recycled across retranslation.
+ */
+using TranslateCache = hphp_hash_map<void*,
+                                     std::shared_ptr<StackFrameExtra>,
+                                     pointer_hash<void>>;
+THREAD_LOCAL(TranslateCache, s_translateCache);
+constexpr size_t kMaxTranslateCache = 8192;
+
+}
+
+std::shared_ptr<StackFrameExtra> StackTrace::Translate(void* frame_addr,
+                                                       PerfMap* pm) {
+  auto& cache = *s_translateCache;
+  auto const it = cache.find(frame_addr);
+  if (it != cache.end()) return it->second;
+
+  bool cacheable = false;
+  auto frame = translateImpl(frame_addr, pm, cacheable);
+  if (cacheable && cache.size() < kMaxTranslateCache) {
+    cache[frame_addr] = frame;
+  }
+  return frame;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 }
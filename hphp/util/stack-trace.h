@@ -70,6 +70,23 @@ struct StackTraceBase {
   static const char* const* FunctionBlacklist;
   static unsigned FunctionBlacklistCount;
 
+  /*
+   * Prefer an async-signal-safe frame-pointer walk over the symbolizer's
+   * unwinder when capturing.  Sound because we build with
+   * -fno-omit-frame-pointer; configured by Debug.StackTraceFramePointers.
+   */
+  static bool UseFramePointers;
+
+  /*
+   * Capture up to `max' return addresses from the current thread's stack
+   * into `frames' by walking the frame-pointer chain.  Async-signal-safe:
+   * no heap, no locks, no syscalls.  Returns the number of frames
+   * captured, 0 when no chain is available.  High-frequency samplers
+   * should capture with this and symbolize later, e.g. by constructing a
+   * StackTrace from the raw addresses.
+   */
+  static int CaptureFramePointers(void** frames, int max);
+
  protected:
   StackTraceBase();
 };
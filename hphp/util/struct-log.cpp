@@ -16,7 +16,12 @@
 
 #include "hphp/util/struct-log.h"
 
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <mutex>
 #include <sstream>
+#include <thread>
 
 #include <folly/Random.h>
 
@@ -104,6 +109,156 @@ void log(const std::string& tableName, const StructuredLogEntry& cols) {
 void recordRequestGlobals(StructuredLogEntry& cols) {
   if (enabled()) s_recordGlobals(cols);
 }
+
+namespace {
+
+// Per-thread buffer bound; full buffers drop rather than block.
+constexpr size_t kBufferCapacity = 512;
+
+// One buffered event: either a flat schema record, or a deferred
+// pre-built entry when `schema' is null.
+struct Record {
+  Schema* schema{nullptr};
+  std::vector<int64_t> ints;
+  std::vector<std::string> strs;
+  std::string table;
+  std::unique_ptr<StructuredLogEntry> entry;
+};
+
+struct ThreadBuffer {
+  std::mutex lock;
+  std::vector<Record> records;
+};
+
+// Schemas are handed out by pointer, so keep them in a deque and never
+// remove them.
+std::mutex s_schemaLock;
+std::deque<Schema> s_schemas;
+
+std::mutex s_buffersLock;
+std::vector<ThreadBuffer*> s_buffers;
+// Undrained records inherited from exited threads.
+std::vector<Record> s_orphans;
+
+ThreadBuffer& threadBuffer() {
+  struct Owner {
+    ThreadBuffer buf;
+    Owner() {
+      std::lock_guard<std::mutex> g(s_buffersLock);
+      s_buffers.push_back(&buf);
+    }
+    ~Owner() {
+      std::lock_guard<std::mutex> g(s_buffersLock);
+      s_buffers.erase(std::remove(s_buffers.begin(), s_buffers.end(), &buf),
+                      s_buffers.end());
+      std::move(buf.records.begin(), buf.records.end(),
+                std::back_inserter(s_orphans));
+    }
+  };
+  thread_local Owner owner;
+  return owner.buf;
+}
+
+void push(Record rec, std::atomic<uint64_t>* dropped) {
+  auto& buf = threadBuffer();
+  std::lock_guard<std::mutex> g(buf.lock);
+  if (buf.records.size() >= kBufferCapacity) {
+    if (dropped) ++*dropped;
+    return;
+  }
+  buf.records.push_back(std::move(rec));
+}
+
+void emit(Record& rec) {
+  if (!enabled()) return;
+  if (!rec.schema) {
+    s_log(rec.table, *rec.entry);
+    return;
+  }
+  auto& schema = *rec.schema;
+  StructuredLogEntry entry;
+  for (size_t i = 0; i < schema.intKeys.size(); ++i) {
+    entry.setInt(schema.intKeys[i], rec.ints[i]);
+  }
+  for (size_t i = 0; i < schema.strKeys.size(); ++i) {
+    entry.setStr(schema.strKeys[i], rec.strs[i]);
+  }
+  if (auto const dropped = schema.dropped.exchange(0)) {
+    entry.setInt("dropped", dropped);
+  }
+  s_log(schema.table, entry);
+}
+
+void drainOnce() {
+  std::vector<Record> batch;
+  {
+    std::lock_guard<std::mutex> g(s_buffersLock);
+    for (auto* buf : s_buffers) {
+      std::lock_guard<std::mutex> g2(buf->lock);
+      std::move(buf->records.begin(), buf->records.end(),
+                std::back_inserter(batch));
+      buf->records.clear();
+    }
+    std::move(s_orphans.begin(), s_orphans.end(), std::back_inserter(batch));
+    s_orphans.clear();
+  }
+  for (auto& rec : batch) emit(rec);
+}
+
+std::once_flag s_drainerOnce;
+
+void startDrainer() {
+  std::call_once(s_drainerOnce, [] {
+    std::thread([] {
+      for (;;) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        drainOnce();
+      }
+    }).detach();
+  });
+}
+
+}
+
+Schema* registerSchema(const std::string& table,
+                       std::vector<std::string> intKeys,
+                       std::vector<std::string> strKeys) {
+  startDrainer();
+  std::lock_guard<std::mutex> g(s_schemaLock);
+  s_schemas.emplace_back();
+  auto& schema = s_schemas.back();
+  schema.table = table;
+  schema.intKeys = std::move(intKeys);
+  schema.strKeys = std::move(strKeys);
+  return &schema;
+}
+
+void logBuffered(Schema& schema,
+                 const int64_t* ints,
+                 const folly::StringPiece* strs) {
+  Record rec;
+  rec.schema = &schema;
+  rec.ints.assign(ints, ints + schema.intKeys.size());
+  rec.strs.reserve(schema.strKeys.size());
+  for (size_t i = 0; i < schema.strKeys.size(); ++i) {
+    rec.strs.emplace_back(strs[i].data(), strs[i].size());
+  }
+  push(std::move(rec), &schema.dropped);
+}
+
+void logDeferred(const std::string& table,
+                 std::unique_ptr<StructuredLogEntry> entry) {
+  if (!entry) return;
+  startDrainer();
+  Record rec;
+  rec.table = table;
+  rec.entry = std::move(entry);
+  push(std::move(rec), nullptr);
+}
+
+void flushBuffered() {
+  drainOnce();
+}
 }
 
 std::string show(const StructuredLogEntry& cols) {
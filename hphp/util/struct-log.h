@@ -17,6 +17,8 @@
 #ifndef incl_HPHP_UTIL_STRUCT_LOG_H_
 #define incl_HPHP_UTIL_STRUCT_LOG_H_
 
+#include <atomic>
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -61,6 +63,55 @@ bool coinflip(uint32_t rate);
 void enable(LogFn log, RecordGlobalsFn globals);
 void log(const std::string&, const StructuredLogEntry&);
 void recordRequestGlobals(StructuredLogEntry&);
+
+/*
+ * Buffered logging for high-frequency events.
+ *
+ * A Schema fixes an event's column layout up front, so recording it is a
+ * flat copy of values in schema order -- no per-event dynamic maps.
+ * Records land in a per-thread buffer, and a background drainer converts
+ * them and hands them to the registered sink, so the producing thread
+ * never pays for serialization or the sink itself.  When a buffer fills
+ * faster than it drains, new records are dropped and counted; the count
+ * is attached to the next drained record of the same schema as a
+ * "dropped" column.
+ */
+struct Schema {
+  std::string table;
+  std::vector<std::string> intKeys;
+  std::vector<std::string> strKeys;
+  std::atomic<uint64_t> dropped{0};
+};
+
+/*
+ * Compile a schema once, at startup or on first use.  The returned
+ * pointer is process-lived.
+ */
+Schema* registerSchema(const std::string& table,
+                       std::vector<std::string> intKeys,
+                       std::vector<std::string> strKeys);
+
+/*
+ * Record one event; `ints' and `strs' follow the schema's key order and
+ * lengths.  Constant work plus the string copies; never blocks on the
+ * sink.
+ */
+void logBuffered(Schema& schema,
+                 const int64_t* ints,
+                 const folly::StringPiece* strs);
+
+/*
+ * Queue a fully built entry for the drainer, so the calling thread skips
+ * the synchronous sink call.  Used for per-request telemetry whose
+ * column set is not fixed enough for a Schema.
+ */
+void logDeferred(const std::string& table,
+                 std::unique_ptr<StructuredLogEntry> entry);
+
+/*
+ * Synchronously drain everything buffered so far, e.g. at shutdown.
+ */
+void flushBuffered();
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -100,6 +100,24 @@ void SynchronizableMulti::notify() {
   }
 }
 
+void SynchronizableMulti::notifyOnGroup(int q) {
+  assert(q >= 0);
+  const uint32_t num_lists = m_cond_list_vec.size();
+  uint32_t list_index = 0;
+  if (num_lists == 2) list_index = q & 1;
+  else if (num_lists > 2) list_index = q % num_lists;
+  for (uint32_t i = 0; i < num_lists; i++) {
+    auto& cond_list = m_cond_list_vec[list_index];
+    if (!cond_list.empty()) {
+      auto& cond = cond_list.front();
+      pthread_cond_signal(cond);
+      cond_list.pop_front();
+      break;
+    }
+    if (++list_index == num_lists) list_index = 0;
+  }
+}
+
 void SynchronizableMulti::notifyAll() {
   for (auto& cond_list : m_cond_list_vec) {
     while (!cond_list.empty()) {
@@ -52,6 +52,10 @@ struct SynchronizableMulti {
   bool wait(int id, int q, Priority pri, long seconds); // false if timed out
   bool wait(int id, int q, Priority pri, long seconds, long long nanosecs);
   void notify();
+  // Like notify(), but prefer waking a thread that waited with the given
+  // "q" (using the same list mapping wait() applies), falling back to the
+  // other lists when none is waiting there.
+  void notifyOnGroup(int q);
   void notifyAll();
   void setNumGroups(int num_groups);
 
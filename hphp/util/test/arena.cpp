@@ -0,0 +1,98 @@
+/*
+   +----------------------------------------------------------------------+
+   | HipHop for PHP                                                       |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 2010-present Facebook, Inc. (http://www.facebook.com)  |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 3.01 of the PHP license,      |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.php.net/license/3_01.txt                                  |
+   | If you did not receive a copy of the PHP license and are unable to   |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@php.net so we can mail you a copy immediately.               |
+   +----------------------------------------------------------------------+
+*/
+#include "hphp/util/arena.h"
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace HPHP {
+
+//////////////////////////////////////////////////////////////////////
+
+TEST(Arena, framesReleaseMemory) {
+  Arena arena;
+
+  arena.alloc(16);
+  auto const baseline = arena.size();
+
+  arena.beginFrame();
+  for (int i = 0; i < 1000; ++i) {
+    arena.alloc(64);
+  }
+  EXPECT_GT(arena.size(), baseline);
+  arena.endFrame();
+
+  // Rolling a frame back returns the allocator to its checkpointed
+  // state (modulo the frame marker itself).
+  EXPECT_LE(arena.size(), baseline + 2 * sizeof(void*) + 16);
+}
+
+TEST(Arena, frameEndCallbacks) {
+  Arena arena;
+  std::vector<int> order;
+
+  auto push = [] (void* obj) {
+    static_cast<std::vector<int>*>(obj)->push_back(0);
+  };
+
+  arena.beginFrame();
+  arena.onFrameEnd([] (void* obj) {
+    static_cast<std::vector<int>*>(obj)->push_back(1);
+  }, &order);
+  arena.onFrameEnd([] (void* obj) {
+    static_cast<std::vector<int>*>(obj)->push_back(2);
+  }, &order);
+
+  arena.beginFrame();
+  arena.onFrameEnd(push, &order);
+  EXPECT_TRUE(order.empty());
+  arena.endFrame();
+
+  // Inner frame ran only its own callback.
+  EXPECT_EQ(order, (std::vector<int>{0}));
+
+  arena.endFrame();
+
+  // Outer callbacks run in reverse registration order.
+  EXPECT_EQ(order, (std::vector<int>{0, 2, 1}));
+}
+
+TEST(Arena, allocDRunsDestructors) {
+  struct Tracked {
+    explicit Tracked(int* counter) : counter(counter) {}
+    ~Tracked() { ++*counter; }
+    int* counter;
+  };
+
+  int destroyed = 0;
+  {
+    Arena arena;
+    arena.allocD<Tracked>(&destroyed);
+    {
+      ArenaFrameGuard<4096> guard(arena);
+      arena.allocD<Tracked>(&destroyed);
+      arena.allocD<Tracked>(&destroyed);
+      EXPECT_EQ(destroyed, 0);
+    }
+    EXPECT_EQ(destroyed, 2);
+  }
+  // Objects registered outside any frame are destroyed with the arena.
+  EXPECT_EQ(destroyed, 3);
+}
+
+//////////////////////////////////////////////////////////////////////
+
+}
@@ -116,6 +116,33 @@ TEST(JobQueue, Expiration) {
     EXPECT_FALSE(expired);
   }
 
+  {
+    // per-job budgets override the queue-wide one.
+    JobQueue<int> fifo_queue(1, 0, false, INT_MAX, 30000);
+    fifo_queue.enqueue(1, 0, 60000);
+    fifo_queue.enqueue(2, 0, 10000);
+    fifo_queue.enqueue(3);
+
+    timespec time31s = timeOk;
+    time31s.tv_sec += 31;
+    timespec time11s = timeOk;
+    time11s.tv_sec += 11;
+
+    bool expired = false;
+    // 31s exceeds the queue-wide budget but not job 1's own 60s budget.
+    EXPECT_EQ(1, fifo_queue.dequeueMaybeExpiredImpl(0, 0, true,
+                                                    time31s, &expired));
+    EXPECT_FALSE(expired);
+    // 11s is within the queue-wide budget but blows job 2's 10s budget.
+    EXPECT_EQ(2, fifo_queue.dequeueMaybeExpiredImpl(0, 0, true,
+                                                    time11s, &expired));
+    EXPECT_TRUE(expired);
+    // job 3 falls back to the queue-wide budget.
+    EXPECT_EQ(3, fifo_queue.dequeueMaybeExpiredImpl(0, 0, true,
+                                                    time31s, &expired));
+    EXPECT_TRUE(expired);
+  }
+
   {
     // job reaper.
     JobQueue<int> lifo_queue(1, 0, false, 0, 30000);
@@ -126,8 +153,8 @@ TEST(JobQueue, Expiration) {
     lifo_queue.enqueue(5);
 
     // manipulate m_jobs timestamp to simulate time passing.
-    lifo_queue.m_jobQueues[0][0].second.tv_sec -= 32;
-    lifo_queue.m_jobQueues[0][1].second.tv_sec -= 31;
+    lifo_queue.m_jobQueues[0][0].enqueueTime.tv_sec -= 32;
+    lifo_queue.m_jobQueues[0][1].enqueueTime.tv_sec -= 31;
 
     // having job reaper should not affect anything other threads are doing.
     {
@@ -157,7 +184,7 @@ TEST(JobQueue, Expiration) {
     }
 
     // now set the first job to be expired.
-    lifo_queue.m_jobQueues[0][0].second.tv_sec -= 32;
+    lifo_queue.m_jobQueues[0][0].enqueueTime.tv_sec -= 32;
     lifo_queue.notify();
 
     // busy wait until value is updated.
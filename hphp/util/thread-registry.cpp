@@ -0,0 +1,179 @@
+/*
+   +----------------------------------------------------------------------+
+   | HipHop for PHP                                                       |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 2010-present Facebook, Inc. (http://www.facebook.com)  |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 3.01 of the PHP license,      |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.php.net/license/3_01.txt                                  |
+   | If you did not receive a copy of the PHP license and are unable to   |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@php.net so we can mail you a copy immediately.               |
+   +----------------------------------------------------------------------+
+*/
+
+#include "hphp/util/thread-registry.h"
+
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <folly/Format.h>
+#include <folly/portability/Unistd.h>
+
+#include "hphp/util/alloc.h"
+#include "hphp/util/process.h"
+#include "hphp/util/service-data.h"
+
+namespace HPHP { namespace ThreadRegistry {
+///////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+struct LiveThread {
+  pid_t tid;
+  // Points at jemalloc's per-thread allocation counter; stable for the
+  // thread's lifetime and safe to read without synchronization.
+  const uint64_t* allocated{nullptr};
+};
+
+// Usage folded in from threads that have unregistered.
+struct RetiredTotals {
+  int64_t cpuMs{0};
+  int64_t schedDelayMs{0};
+  int64_t allocatedBytes{0};
+};
+
+struct Group {
+  std::unordered_map<pid_t, LiveThread> live;
+  RetiredTotals retired;
+};
+
+std::mutex s_lock;
+std::map<std::string, Group>& groups() {
+  static std::map<std::string, Group> s_groups;
+  return s_groups;
+}
+
+thread_local const char* t_group{nullptr};
+
+/*
+ * Sample CPU time and runqueue delay for a sibling thread from procfs.
+ * Returns false (leaving the outputs untouched) off Linux or once the
+ * thread is gone.
+ */
+bool sampleTask(pid_t tid, int64_t& cpuMs, int64_t& schedDelayMs) {
+#ifdef __linux__
+  char path[64];
+  snprintf(path, sizeof(path), "/proc/self/task/%d/stat", tid);
+  auto* f = fopen(path, "r");
+  if (!f) return false;
+  char buf[1024];
+  auto const nread = fread(buf, 1, sizeof(buf) - 1, f);
+  fclose(f);
+  if (nread == 0) return false;
+  buf[nread] = '\0';
+  // The comm field may contain spaces; skip past its closing paren before
+  // tokenizing.  utime and stime are fields 14 and 15, i.e. the 12th and
+  // 13th tokens after the paren.
+  auto* p = strrchr(buf, ')');
+  if (!p) return false;
+  unsigned long utime = 0, stime = 0;
+  int field = 2;
+  for (char* tok = strtok(p + 1, " "); tok; tok = strtok(nullptr, " ")) {
+    ++field;
+    if (field == 14) utime = strtoul(tok, nullptr, 10);
+    if (field == 15) { stime = strtoul(tok, nullptr, 10); break; }
+  }
+  static const long ticks = sysconf(_SC_CLK_TCK);
+  if (ticks > 0) {
+    cpuMs = static_cast<int64_t>(utime + stime) * 1000 / ticks;
+  }
+
+  snprintf(path, sizeof(path), "/proc/self/task/%d/schedstat", tid);
+  f = fopen(path, "r");
+  if (f) {
+    unsigned long long runNs = 0, waitNs = 0;
+    if (fscanf(f, "%llu %llu", &runNs, &waitNs) == 2) {
+      schedDelayMs = static_cast<int64_t>(waitNs / 1000000);
+    }
+    fclose(f);
+  }
+  return true;
+#else
+  return false;
+#endif
+}
+
+ServiceData::CounterCallback s_counters(
+  [](std::map<std::string, int64_t>& counters) {
+    std::lock_guard<std::mutex> g(s_lock);
+    for (auto const& kv : groups()) {
+      auto const& group = kv.second;
+      int64_t cpuMs = group.retired.cpuMs;
+      int64_t delayMs = group.retired.schedDelayMs;
+      int64_t allocated = group.retired.allocatedBytes;
+      for (auto const& lv : group.live) {
+        int64_t threadCpu = 0, threadDelay = 0;
+        if (sampleTask(lv.second.tid, threadCpu, threadDelay)) {
+          cpuMs += threadCpu;
+          delayMs += threadDelay;
+        }
+        if (lv.second.allocated) {
+          allocated += static_cast<int64_t>(*lv.second.allocated);
+        }
+      }
+      auto const prefix = folly::sformat("threads.{}.", kv.first);
+      counters[prefix + "count"] = group.live.size();
+      counters[prefix + "cpu-ms"] = cpuMs;
+      counters[prefix + "sched-delay-ms"] = delayMs;
+      counters[prefix + "allocated-bytes"] = allocated;
+    }
+  }
+);
+
+}
+
+void registerSelf(const char* group) {
+  if (t_group) unregisterSelf();
+  t_group = group;
+  LiveThread self;
+  self.tid = Process::GetThreadPid();
+#ifdef USE_JEMALLOC
+  uint64_t* allocated = nullptr;
+  if (mallctlRead<uint64_t*, true>("thread.allocatedp", &allocated) == 0) {
+    self.allocated = allocated;
+  }
+#endif
+  std::lock_guard<std::mutex> g(s_lock);
+  groups()[group].live[self.tid] = self;
+}
+
+void unregisterSelf() {
+  if (!t_group) return;
+  auto const tid = Process::GetThreadPid();
+  int64_t cpuMs = 0, schedDelayMs = 0;
+  sampleTask(tid, cpuMs, schedDelayMs);
+  std::lock_guard<std::mutex> g(s_lock);
+  auto& group = groups()[t_group];
+  auto const it = group.live.find(tid);
+  if (it != group.live.end()) {
+    group.retired.cpuMs += cpuMs;
+    group.retired.schedDelayMs += schedDelayMs;
+    if (it->second.allocated) {
+      group.retired.allocatedBytes +=
+        static_cast<int64_t>(*it->second.allocated);
+    }
+    group.live.erase(it);
+  }
+  t_group = nullptr;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+}}
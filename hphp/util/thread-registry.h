@@ -0,0 +1,55 @@
+/*
+   +----------------------------------------------------------------------+
+   | HipHop for PHP                                                       |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 2010-present Facebook, Inc. (http://www.facebook.com)  |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 3.01 of the PHP license,      |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.php.net/license/3_01.txt                                  |
+   | If you did not receive a copy of the PHP license and are unable to   |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@php.net so we can mail you a copy immediately.               |
+   +----------------------------------------------------------------------+
+*/
+
+#ifndef incl_HPHP_UTIL_THREAD_REGISTRY_H_
+#define incl_HPHP_UTIL_THREAD_REGISTRY_H_
+
+namespace HPHP { namespace ThreadRegistry {
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+ * Process-wide registry of named thread groups, so "which subsystem is
+ * using the CPU" can be answered without perf.  Threads spawned through
+ * AsyncFunc register automatically under their pool's group (see
+ * AsyncFuncImpl::setThreadGroup); other threads may register themselves
+ * directly.  Per-group totals are exported through ServiceData and are
+ * visible wherever counters are (e.g. the admin server's status pages):
+ *
+ *   threads.<group>.count            live threads in the group
+ *   threads.<group>.cpu-ms           user+system CPU, live plus exited
+ *   threads.<group>.sched-delay-ms   runqueue wait, live plus exited
+ *   threads.<group>.allocated-bytes  malloc'd bytes (jemalloc builds only)
+ *
+ * Live-thread CPU and scheduling delay are sampled from
+ * /proc/self/task/<tid> only when the counters are read, so registered
+ * threads pay nothing between reads; allocation is read from a per-thread
+ * jemalloc counter without synchronization.
+ *
+ * `group` must have static storage duration.
+ */
+void registerSelf(const char* group);
+
+/*
+ * Fold the calling thread's usage into its group's exited-thread totals
+ * and drop it from the registry.  Must be called on the registered thread,
+ * before it exits.
+ */
+void unregisterSelf();
+
+///////////////////////////////////////////////////////////////////////////////
+}}
+
+#endif // incl_HPHP_UTIL_THREAD_REGISTRY_H_
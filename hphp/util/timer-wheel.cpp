@@ -0,0 +1,116 @@
+/*
+   +----------------------------------------------------------------------+
+   | HipHop for PHP                                                       |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 2010-present Facebook, Inc. (http://www.facebook.com)  |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 3.01 of the PHP license,      |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.php.net/license/3_01.txt                                  |
+   | If you did not receive a copy of the PHP license and are unable to   |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@php.net so we can mail you a copy immediately.               |
+   +----------------------------------------------------------------------+
+*/
+
+#include "hphp/util/timer-wheel.h"
+
+#include <chrono>
+#include <thread>
+
+namespace HPHP {
+///////////////////////////////////////////////////////////////////////////////
+
+TimerWheel& TimerWheel::get() {
+  // Deliberately leaked: the deadline thread runs for the life of the
+  // process.
+  static TimerWheel* wheel = new TimerWheel();
+  return *wheel;
+}
+
+TimerWheel::TimerWheel()
+  : m_lastTick(nowSeconds())
+  , m_thread(this, &TimerWheel::deadlineThread)
+{
+  m_thread.start();
+}
+
+int64_t TimerWheel::nowSeconds() {
+  return std::chrono::duration_cast<std::chrono::seconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+TimerWheel::Shard& TimerWheel::shardFor(const Timer& timer) const {
+  // Shard by the timer's address, which is stable for its lifetime.  Skip
+  // the low bits, which are mostly alignment.
+  auto const h = reinterpret_cast<uintptr_t>(&timer);
+  return const_cast<Shard&>(m_shards[(h >> 4) % kNumShards]);
+}
+
+void TimerWheel::unlinkLocked(Shard& shard, Timer& timer) noexcept {
+  auto const deadline = timer.m_deadline.load(std::memory_order_relaxed);
+  if (!deadline) return;
+  if (timer.m_prev) {
+    timer.m_prev->m_next = timer.m_next;
+  } else {
+    shard.slots[deadline % kSlotsPerShard] = timer.m_next;
+  }
+  if (timer.m_next) timer.m_next->m_prev = timer.m_prev;
+  timer.m_prev = timer.m_next = nullptr;
+  timer.m_deadline.store(0, std::memory_order_relaxed);
+}
+
+void TimerWheel::arm(Timer& timer, int seconds) {
+  assert(seconds > 0);
+  auto& shard = shardFor(timer);
+  Lock lock(shard.mutex);
+  unlinkLocked(shard, timer);
+  auto const deadline = nowSeconds() + seconds;
+  auto& head = shard.slots[deadline % kSlotsPerShard];
+  timer.m_prev = nullptr;
+  timer.m_next = head;
+  if (head) head->m_prev = &timer;
+  head = &timer;
+  timer.m_deadline.store(deadline, std::memory_order_release);
+}
+
+void TimerWheel::disarm(Timer& timer) noexcept {
+  auto& shard = shardFor(timer);
+  Lock lock(shard.mutex);
+  unlinkLocked(shard, timer);
+}
+
+int TimerWheel::remaining(const Timer& timer) const {
+  auto const deadline = timer.m_deadline.load(std::memory_order_acquire);
+  if (!deadline) return 0;
+  auto const delta = deadline - nowSeconds();
+  // An armed timer that is due but has not fired yet reads as one second.
+  return delta > 0 ? static_cast<int>(delta) : 1;
+}
+
+void TimerWheel::deadlineThread() {
+  while (true) {
+    /* sleep override */
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+    auto const now = nowSeconds();
+    // Process every tick since the last one, in case we overslept.
+    for (auto tick = m_lastTick + 1; tick <= now; ++tick) {
+      for (auto& shard : m_shards) {
+        Lock lock(shard.mutex);
+        Timer* next;
+        for (auto t = shard.slots[tick % kSlotsPerShard]; t; t = next) {
+          next = t->m_next;
+          if (t->m_deadline.load(std::memory_order_relaxed) <= tick) {
+            unlinkLocked(shard, *t);
+            t->m_fn(t->m_arg);
+          }
+        }
+      }
+    }
+    m_lastTick = now;
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+}
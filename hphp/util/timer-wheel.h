@@ -0,0 +1,121 @@
+/*
+   +----------------------------------------------------------------------+
+   | HipHop for PHP                                                       |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 2010-present Facebook, Inc. (http://www.facebook.com)  |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 3.01 of the PHP license,      |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.php.net/license/3_01.txt                                  |
+   | If you did not receive a copy of the PHP license and are unable to   |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@php.net so we can mail you a copy immediately.               |
+   +----------------------------------------------------------------------+
+*/
+
+#ifndef incl_HPHP_UTIL_TIMER_WHEEL_H_
+#define incl_HPHP_UTIL_TIMER_WHEEL_H_
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+
+#include "hphp/util/async-func.h"
+#include "hphp/util/lock.h"
+
+namespace HPHP {
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A process-wide hashed timer wheel with one-second resolution.
+ *
+ * Consumers embed a Timer, registering a callback at construction, then
+ * arm() and disarm() it as deadlines come and go.  Both operations are an
+ * uncontended shard-local lock and a few pointer updates -- no syscalls --
+ * so they are cheap enough to run on every request, unlike a
+ * timer_settime() pair.
+ *
+ * A single deadline thread ticks once per second and runs the callbacks of
+ * timers that have expired.  Callbacks run on that thread with the owning
+ * shard's lock held: they should do no more than flag another thread (e.g.
+ * set a surprise flag), and they must not call arm() or disarm().  Once
+ * disarm() returns the callback is guaranteed to not be running and to
+ * never run for that arming.
+ */
+struct TimerWheel {
+  struct Timer {
+    friend struct TimerWheel;
+
+    Timer(void (*fn)(void*), void* arg) : m_fn(fn), m_arg(arg) {}
+    ~Timer() { assert(m_deadline.load(std::memory_order_relaxed) == 0); }
+
+    Timer(const Timer&) = delete;
+    Timer& operator=(const Timer&) = delete;
+
+   private:
+    void (*m_fn)(void*);
+    void* m_arg;
+    Timer* m_prev{nullptr};
+    Timer* m_next{nullptr};
+    // Absolute deadline in seconds on the wheel's clock.  Nonzero iff the
+    // timer is linked into a slot; all transitions happen under the owning
+    // shard's lock.
+    std::atomic<int64_t> m_deadline{0};
+  };
+
+  /*
+   * The process-wide instance.  The deadline thread is started the first
+   * time this is called; the instance is never destroyed.
+   */
+  static TimerWheel& get();
+
+  /*
+   * (Re)arm `timer' to fire `seconds' from now.  `seconds' must be
+   * positive.
+   */
+  void arm(Timer& timer, int seconds);
+
+  /*
+   * Cancel `timer'.  No-op if it is not armed.
+   */
+  void disarm(Timer& timer) noexcept;
+
+  /*
+   * Seconds until `timer' fires, or 0 if it is not armed.
+   */
+  int remaining(const Timer& timer) const;
+
+  TimerWheel(const TimerWheel&) = delete;
+  TimerWheel& operator=(const TimerWheel&) = delete;
+
+ private:
+  TimerWheel();
+
+  struct Shard;
+  static int64_t nowSeconds();
+  Shard& shardFor(const Timer&) const;
+  static void unlinkLocked(Shard&, Timer&) noexcept;
+  void deadlineThread();
+
+ private:
+  static constexpr uint32_t kNumShards = 8;
+  static constexpr uint32_t kSlotsPerShard = 512;
+
+  struct Shard {
+    Mutex mutex;
+    // Each slot holds the timers whose deadline is congruent to the slot
+    // index mod kSlotsPerShard.  Entries keep their absolute deadline, so
+    // a tick fires only the due ones and leaves later rotations alone.
+    Timer* slots[kSlotsPerShard] = {};
+  };
+
+  Shard m_shards[kNumShards];
+  int64_t m_lastTick;
+  AsyncFunc<TimerWheel> m_thread;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+}
+
+#endif
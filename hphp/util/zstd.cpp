@@ -22,9 +22,17 @@
 namespace HPHP {
 ///////////////////////////////////////////////////////////////////////////////
 
+thread_local ZstdCompressor::ZSTD_CCtx_Ptr ZstdCompressor::tl_cctx_cache;
+
 ZstdCompressor::ZstdCompressor(int compression_level)
     : compression_level_(compression_level) {}
 
+ZstdCompressor::~ZstdCompressor() {
+  if (ctx_) {
+    release_zstd_cctx(std::move(ctx_));
+  }
+}
+
 void ZstdCompressor::zstd_cctx_deleter(ZSTD_CCtx* ctx) {
   size_t err = ZSTD_freeCCtx(ctx);
   if (ZSTD_isError(err)) {
@@ -41,6 +49,19 @@ ZstdCompressor::ZSTD_CCtx_Ptr ZstdCompressor::make_zstd_cctx() {
   return ptr;
 }
 
+ZstdCompressor::ZSTD_CCtx_Ptr ZstdCompressor::acquire_zstd_cctx() {
+  if (tl_cctx_cache) {
+    return std::move(tl_cctx_cache);
+  }
+  return make_zstd_cctx();
+}
+
+void ZstdCompressor::release_zstd_cctx(ZSTD_CCtx_Ptr ctx) {
+  if (!tl_cctx_cache) {
+    tl_cctx_cache = std::move(ctx);
+  }
+}
+
 const char* ZstdCompressor::compress(const void* data,
                                      size_t& len,
                                      bool last) {
@@ -50,12 +71,15 @@ const char* ZstdCompressor::compress(const void* data,
   if (!ctx_) {
     if (last) {
       // optimize single segment (avoid copying into intermediate buffers)
-      auto ret = ZSTD_compress(out.get(), outSize, data, len, compression_level_);
+      auto ctx = acquire_zstd_cctx();
+      auto ret = ZSTD_compressCCtx(ctx.get(), out.get(), outSize,
+                                   data, len, compression_level_);
+      release_zstd_cctx(std::move(ctx));
       if (ZSTD_isError(ret)) return nullptr;
       len = ret;
       return out.release();
     } else {
-      ctx_ = make_zstd_cctx();
+      ctx_ = acquire_zstd_cctx();
       ZSTD_initCStream(ctx_.get(), compression_level_);
     }
   }
@@ -74,7 +98,7 @@ const char* ZstdCompressor::compress(const void* data,
 
   if (last) {
     ret = ZSTD_endStream(ctx_.get(), &outBuf);
-    ctx_.reset();
+    release_zstd_cctx(std::move(ctx_));
   } else {
     ret = ZSTD_flushStream(ctx_.get(), &outBuf);
   }
@@ -30,6 +30,7 @@ namespace HPHP {
 struct ZstdCompressor {
  public:
   explicit ZstdCompressor(int compression_level);
+  ~ZstdCompressor();
 
   const char* compress(const void* data,
                        size_t& len,
@@ -44,6 +45,14 @@ struct ZstdCompressor {
 
   static ZSTD_CCtx_Ptr make_zstd_cctx();
 
+  // Compression contexts are expensive to allocate and cheap to reuse (both
+  // ZSTD_compressCCtx and ZSTD_initCStream fully reset the context), so each
+  // thread keeps one context cached across streams.
+  static ZSTD_CCtx_Ptr acquire_zstd_cctx();
+  static void release_zstd_cctx(ZSTD_CCtx_Ptr ctx);
+
+  static thread_local ZSTD_CCtx_Ptr tl_cctx_cache;
+
   int compression_level_;
   ZSTD_CCtx_Ptr ctx_;
 };
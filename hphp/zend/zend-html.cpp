@@ -23,6 +23,10 @@
 #include "hphp/util/functional.h"
 #include "hphp/util/hash-map.h"
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 namespace HPHP {
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -670,6 +674,37 @@ char *string_html_encode(const char *input, int &len,
   }
   char *q = ret;
   for (const char *p = input, *end = input + len; p < end; p++) {
+#ifdef __SSE2__
+    /*
+     * Bulk-copy runs that can't need escaping: any ASCII byte other than
+     * the five markup characters is emitted verbatim by the switch below,
+     * so scan 16 bytes at a time and only drop to the per-byte code at the
+     * first special or non-ASCII byte (the high-bit movemask catches the
+     * \xc2 and UTF-8 cases).
+     */
+    while (p + 16 <= end) {
+      auto const v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+      auto const special =
+        _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('"')),
+        _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\'')),
+        _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('<')),
+        _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('>')),
+                     _mm_cmpeq_epi8(v, _mm_set1_epi8('&'))))));
+      auto const mask = _mm_movemask_epi8(special) | _mm_movemask_epi8(v);
+      if (mask == 0) {
+        memcpy(q, p, 16);
+        q += 16;
+        p += 16;
+        continue;
+      }
+      auto const clean = __builtin_ctz(mask);
+      memcpy(q, p, clean);
+      q += clean;
+      p += clean;
+      break;
+    }
+    if (p >= end) break;
+#endif
     unsigned char c = *p;
     char entity[5];
     int codeLength = 0;